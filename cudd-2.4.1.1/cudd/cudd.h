@@ -797,6 +797,14 @@ extern int Cudd_ReadPopulationSize (DdManager *dd);
 extern void Cudd_SetPopulationSize (DdManager *dd, int populationSize);
 extern int Cudd_ReadNumberXovers (DdManager *dd);
 extern void Cudd_SetNumberXovers (DdManager *dd, int numberXovers);
+/* NuSMV: add begin */
+extern int Cudd_HugePagesEnabled (DdManager *dd);
+extern int Cudd_EnableHugePages (DdManager *dd);
+extern void Cudd_DisableHugePages (DdManager *dd);
+extern unsigned long Cudd_ReadRegionSize (DdManager *dd);
+extern void Cudd_SetRegionSize (DdManager *dd, unsigned long size);
+extern int Cudd_CompactNodes (DdManager *dd);
+/* NuSMV: add end */
 
 /* NuSMV: added begin */
 extern ptruint Cudd_ReadMemoryInUse (DdManager *dd);
@@ -806,6 +814,7 @@ extern ptruint Cudd_ReadMemoryInUse (DdManager *dd);
 extern int Cudd_PrintInfo (DdManager *dd, FILE *fp);
 extern long Cudd_ReadPeakNodeCount (DdManager *dd);
 extern int Cudd_ReadPeakLiveNodeCount (DdManager * dd);
+extern void Cudd_SetPeakLiveNodeCount (DdManager * dd, unsigned int peak);
 extern long Cudd_ReadNodeCount (DdManager *dd);
 extern long Cudd_zddReadNodeCount (DdManager *dd);
 extern int Cudd_AddHook (DdManager *dd, DD_HFP f, Cudd_HookType where);
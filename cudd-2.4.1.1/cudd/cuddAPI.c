@@ -102,10 +102,16 @@
 		<li> Cudd_SetPopulationSize()
 		<li> Cudd_ReadNumberXovers()
 		<li> Cudd_SetNumberXovers()
+		<li> Cudd_HugePagesEnabled()
+		<li> Cudd_EnableHugePages()
+		<li> Cudd_DisableHugePages()
+		<li> Cudd_ReadRegionSize()
+		<li> Cudd_SetRegionSize()
 		<li> Cudd_ReadMemoryInUse()
 		<li> Cudd_PrintInfo()
 		<li> Cudd_ReadPeakNodeCount()
 		<li> Cudd_ReadPeakLiveNodeCount()
+		<li> Cudd_SetPeakLiveNodeCount()
 		<li> Cudd_ReadNodeCount()
 		<li> Cudd_zddReadNodeCount()
 		<li> Cudd_AddHook()
@@ -3000,6 +3006,130 @@ Cudd_SetNumberXovers(
 
 } /* end of Cudd_SetNumberXovers */
 
+
+/* NuSMV: add begin */
+/**Function********************************************************************
+
+  Synopsis    [Tells whether node memory is taken from huge page regions.]
+
+  Description [Returns 1 if new node blocks are carved from large
+  memory regions backed by transparent huge pages; 0 otherwise.]
+
+  SideEffects [None]
+
+  SeeAlso     [Cudd_EnableHugePages Cudd_DisableHugePages]
+
+******************************************************************************/
+int
+Cudd_HugePagesEnabled(
+  DdManager * dd)
+{
+    return(dd->hugePages);
+
+} /* end of Cudd_HugePagesEnabled */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Enables the huge page backend for node memory.]
+
+  Description [Enables the huge page backend for node memory. From now
+  on node blocks are carved from large anonymous memory mappings that
+  are advised for transparent huge pages, and mappings that hold no
+  live node are returned to the system after garbage collection (which
+  seldom happens, see cuddReleaseFreeRegions). Large unique subtables
+  and the computed table are advised for huge pages as well when they
+  are resized. Returns 1 if successful; 0 if anonymous memory mappings
+  are not supported on this platform.]
+
+  SideEffects [None]
+
+  SeeAlso     [Cudd_DisableHugePages Cudd_SetRegionSize]
+
+******************************************************************************/
+int
+Cudd_EnableHugePages(
+  DdManager * dd)
+{
+#ifdef DD_HAVE_MMAP
+    dd->hugePages = 1;
+    return(1);
+#else
+    return(0);
+#endif
+
+} /* end of Cudd_EnableHugePages */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Disables the huge page backend for node memory.]
+
+  Description [Disables the huge page backend for node memory. New node
+  blocks are obtained from the ordinary allocator. Regions already
+  mapped are kept until they hold no live node or the manager is
+  destroyed.]
+
+  SideEffects [None]
+
+  SeeAlso     [Cudd_EnableHugePages]
+
+******************************************************************************/
+void
+Cudd_DisableHugePages(
+  DdManager * dd)
+{
+    dd->hugePages = 0;
+
+} /* end of Cudd_DisableHugePages */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the size of the regions mapped for node memory.]
+
+  Description [Reads the size in bytes of the regions mapped for node
+  memory when the huge page backend is enabled.]
+
+  SideEffects [None]
+
+  SeeAlso     [Cudd_SetRegionSize]
+
+******************************************************************************/
+unsigned long
+Cudd_ReadRegionSize(
+  DdManager * dd)
+{
+    return((unsigned long) dd->regionSize);
+
+} /* end of Cudd_ReadRegionSize */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Sets the size of the regions mapped for node memory.]
+
+  Description [Sets the size in bytes of the regions mapped for node
+  memory when the huge page backend is enabled. The size is rounded up
+  to a multiple of the huge page size and affects only the regions
+  mapped from now on.]
+
+  SideEffects [None]
+
+  SeeAlso     [Cudd_ReadRegionSize]
+
+******************************************************************************/
+void
+Cudd_SetRegionSize(
+  DdManager * dd,
+  unsigned long size)
+{
+    if (size < (unsigned long) DD_REGION_ALIGN) size = DD_REGION_ALIGN;
+    dd->regionSize = (size_t) size;
+
+} /* end of Cudd_SetRegionSize */
+/* NuSMV: add end */
+
 /**Function********************************************************************
 
   Synopsis    [Returns the memory in use by the manager measured in bytes.]
@@ -3105,6 +3235,14 @@ Cudd_PrintInfo(
     retval = fprintf(fp,"Next reordering threshold: %u\n",
 		     Cudd_ReadNextReordering(dd));
     if (retval == EOF) return(0);
+    /* NuSMV: add begin */
+    retval = fprintf(fp,"Huge page node memory enabled: %s\n",
+		     Cudd_HugePagesEnabled(dd) ? "yes" : "no");
+    if (retval == EOF) return(0);
+    retval = fprintf(fp,"Huge page region size in MB: %lu\n",
+		     Cudd_ReadRegionSize(dd) >> 20);
+    if (retval == EOF) return(0);
+    /* NuSMV: add end */
 
     /* Non-modifiable parameters. */
     retval = fprintf(fp,"**** CUDD non-modifiable parameters ****\n");
@@ -3195,6 +3333,17 @@ Cudd_PrintInfo(
     retval = fprintf(fp,"Time for garbage collection: %.2f sec\n",
 		     ((double)Cudd_ReadGarbageCollectionTime(dd)/1000.0));
     if (retval == EOF) return(0);
+    /* NuSMV: add begin */
+    retval = fprintf(fp,"Huge page regions mapped so far: %d\n",
+		     dd->regionsMapped);
+    if (retval == EOF) return(0);
+    retval = fprintf(fp,"Huge page regions released so far: %d\n",
+		     dd->regionsReleased);
+    if (retval == EOF) return(0);
+    retval = fprintf(fp,"Memory mapped in huge page regions: %lu\n",
+		     (unsigned long) dd->regionMem);
+    if (retval == EOF) return(0);
+    /* NuSMV: add end */
     retval = fprintf(fp,"Reorderings so far: %d\n", dd->reorderings);
     if (retval == EOF) return(0);
     retval = fprintf(fp,"Time for reordering: %.2f sec\n",
@@ -3267,6 +3416,30 @@ Cudd_ReadPeakLiveNodeCount(
 } /* end of Cudd_ReadPeakLiveNodeCount */
 
 
+/**Function********************************************************************
+
+  Synopsis    [Sets the peak number of live nodes.]
+
+  Description [Sets the peak number of live nodes, e.g. to measure the
+  peak within a phase of the computation. Since
+  Cudd_ReadPeakLiveNodeCount never reports less than the current number
+  of live nodes, setting the peak to 0 resets it to that number.]
+
+  SideEffects [None]
+
+  SeeAlso     [Cudd_ReadPeakLiveNodeCount]
+
+******************************************************************************/
+void
+Cudd_SetPeakLiveNodeCount(
+  DdManager * dd,
+  unsigned int peak)
+{
+    dd->peakLiveNodes = peak;
+
+} /* end of Cudd_SetPeakLiveNodeCount */
+
+
 /**Function********************************************************************
 
   Synopsis    [Reports the number of nodes in BDDs and ADDs.]
@@ -934,6 +934,9 @@ cuddCacheResize(
     MMoutOfMemory = Cudd_OutOfMem;
     table->acache = cache = ALLOC(DdCache,slots+1);
     MMoutOfMemory = saveHandler;
+    /* NuSMV: add begin */
+    cuddAdviseHugePages(table, cache, (slots + 1) * sizeof(DdCache));
+    /* NuSMV: add end */
     /* If we fail to allocate the new table we just give up. */
     if (cache == NULL) {
 #ifdef DD_VERBOSE
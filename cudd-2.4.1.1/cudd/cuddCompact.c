@@ -0,0 +1,425 @@
+/**CFile***********************************************************************
+
+  FileName    [cuddCompact.c]
+
+  PackageName [cudd]
+
+  Synopsis    [Relocation of BDD nodes into contiguous per-level blocks.]
+
+  Description [External procedures included in this module:
+		<ul>
+		<li> Cudd_CompactNodes()
+		</ul>
+	Static procedures included in this module:
+		<ul>
+		<li> ddCompactForward()
+		<li> ddCompactInsert()
+		<li> ddCompactRebuildFreeList()
+		</ul>
+  After many reorderings and garbage collections the nodes of a level
+  end up scattered over the whole node memory. Cudd_CompactNodes copies
+  the nodes into freshly allocated blocks, one level after the other,
+  so that operations that proceed level by level walk through memory
+  sequentially. Only the nodes that are referenced exclusively by other
+  nodes are moved: nodes carrying references from the application
+  (including the projection functions) keep their address, so that
+  every DdNode pointer owned by the application stays valid.]
+
+  SeeAlso     [cuddTable.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [Copyright (C) 2010 by FBK-irst
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+  Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  Neither the name of the University of Colorado nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.]
+
+******************************************************************************/
+
+#include    "util.h"
+#include    "cuddInt.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+#ifndef lint
+static char rcsid[] DD_UNUSED = "$Id: cuddCompact.c,v 1.1.2.1 2010-02-04 10:41:15 nusmv Exp $";
+#endif
+
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/* A node that has been moved has its else child set to the address of
+** the sentinel (which is never a child) and its then child set to the
+** new location of the node. */
+#define ddCompactIsForwarded(dd,node) \
+    (!cuddIsConstant(node) && cuddE(node) == &((dd)->sentinel))
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+static DdNode * ddCompactForward (DdManager *dd, DdNode *f);
+static void ddCompactInsert (DdManager *dd, int level, DdNode *node);
+static void ddCompactRebuildFreeList (DdManager *dd);
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Relocates the BDD and ADD nodes into contiguous blocks by
+  level.]
+
+  Description [Garbage collects the manager, then copies every BDD and
+  ADD node that is referenced only by other nodes into newly allocated
+  node blocks, laid out level by level from the top of the order to the
+  bottom. Nodes that carry references from outside the unique table are
+  not moved, but their children are updated. Blocks left without any
+  live node are returned to the system. The computed table is flushed.
+  ZDD nodes are not affected.<p>
+  Must not be called while a decision diagram operation is in progress
+  (e.g. from a hook), since the operation may hold unreferenced nodes.
+  Returns the number of nodes moved if successful; -1 otherwise.]
+
+  SideEffects [The addresses of nodes with no external reference change.]
+
+  SeeAlso     [Cudd_ReduceHeap cuddGarbageCollect]
+
+******************************************************************************/
+int
+Cudd_CompactNodes(
+  DdManager * dd)
+{
+    DdNode *sentinel = &(dd->sentinel);
+    DdNodePtr *nodelist, *mem;
+    DdNode **blocks;
+    DdNode *node, *next, *list, *dst, *T, *E;
+    int *first;
+    int i, j, nblocks, moved, total;
+    unsigned int slots;
+    ptruint offset;
+
+    if (dd->size == 0) return(0);
+
+    /* Make sure all nodes in the BDD unique table are alive and that
+    ** no cache holds pointers to nodes that are going to move. */
+    cuddCacheFlush(dd);
+    cuddLocalCacheClearAll(dd);
+    (void) cuddGarbageCollect(dd,0);
+
+    first = ALLOC(int,dd->size + 1);
+    if (first == NULL) {
+	dd->errorCode = CUDD_MEMORY_OUT;
+	return(-1);
+    }
+
+    /* Remove the references coming from the parents: afterwards the
+    ** reference count of a node is the number of external references. */
+    for (i = 0; i < dd->size; i++) {
+	nodelist = dd->subtables[i].nodelist;
+	slots = dd->subtables[i].slots;
+	for (j = 0; (unsigned) j < slots; j++) {
+	    for (node = nodelist[j]; node != sentinel; node = node->next) {
+		cuddSatDec(cuddT(node)->ref);
+		cuddSatDec(Cudd_Regular(cuddE(node))->ref);
+	    }
+	}
+    }
+
+    /* Count the nodes to be moved and assign each level its range. */
+    total = 0;
+    for (i = 0; i < dd->size; i++) {
+	first[i] = total;
+	nodelist = dd->subtables[i].nodelist;
+	slots = dd->subtables[i].slots;
+	for (j = 0; (unsigned) j < slots; j++) {
+	    for (node = nodelist[j]; node != sentinel; node = node->next) {
+		if (node->ref == 0) total++;
+	    }
+	}
+    }
+    first[dd->size] = total;
+
+    /* Allocate the destination blocks. They are linked into the memory
+    ** list right away, so that they are accounted for even on failure. */
+    nblocks = (total + DD_MEM_CHUNK - 1) / DD_MEM_CHUNK;
+    blocks = ALLOC(DdNode *,nblocks + 1);
+    if (blocks == NULL) nblocks = -1;
+    for (i = 0; i < nblocks; i++) {
+	mem = cuddAllocNodeChunk(dd);
+	if (mem == NULL) {
+	    nblocks = -1;
+	    break;
+	}
+	dd->memused += (DD_MEM_CHUNK + 1) * sizeof(DdNode);
+	mem[0] = (DdNodePtr) dd->memoryList;
+	dd->memoryList = mem;
+	offset = (ptruint) mem & (sizeof(DdNode) - 1);
+	mem += (sizeof(DdNode) - offset) / sizeof(DdNodePtr);
+	list = (DdNode *) mem;
+	for (j = 0; j < DD_MEM_CHUNK; j++) {
+	    list[j].ref = 0;
+	    list[j].next = NULL;
+	}
+	blocks[i] = list;
+    }
+
+    /* Move the nodes bottom-up, so that the children of a node have
+    ** already reached their final address when the node is visited.
+    ** Each level is rehashed, since the hash function depends on the
+    ** addresses of the children. */
+    moved = 0;
+    for (i = dd->size - 1; nblocks >= 0 && i >= 0; i--) {
+	nodelist = dd->subtables[i].nodelist;
+	slots = dd->subtables[i].slots;
+	list = NULL;
+	for (j = 0; (unsigned) j < slots; j++) {
+	    node = nodelist[j];
+	    while (node != sentinel) {
+		next = node->next;
+		node->next = list;
+		list = node;
+		node = next;
+	    }
+	    nodelist[j] = sentinel;
+	}
+	j = first[i];
+	for (node = list; node != NULL; node = next) {
+	    next = node->next;
+	    T = ddCompactForward(dd, cuddT(node));
+	    E = ddCompactForward(dd, cuddE(node));
+	    if (node->ref == 0) {
+		dst = &(blocks[j / DD_MEM_CHUNK][j % DD_MEM_CHUNK]);
+		j++;
+		dst->index = node->index;
+		dst->ref = 0;
+		cuddT(dst) = T;
+		cuddE(dst) = E;
+		cuddT(node) = dst;
+		cuddE(node) = sentinel;
+		ddCompactInsert(dd, i, dst);
+		moved++;
+	    } else {
+		cuddT(node) = T;
+		cuddE(node) = E;
+		ddCompactInsert(dd, i, node);
+	    }
+	}
+    }
+
+    /* Give back the references of the parents. */
+    for (i = 0; i < dd->size; i++) {
+	nodelist = dd->subtables[i].nodelist;
+	slots = dd->subtables[i].slots;
+	for (j = 0; (unsigned) j < slots; j++) {
+	    for (node = nodelist[j]; node != sentinel; node = node->next) {
+		cuddSatInc(cuddT(node)->ref);
+		cuddSatInc(Cudd_Regular(cuddE(node))->ref);
+	    }
+	}
+    }
+
+    /* The old copies of the moved nodes now have null reference count
+    ** and are thus free. */
+    if (dd->regions != NULL) cuddReleaseFreeRegions(dd);
+    ddCompactRebuildFreeList(dd);
+
+    FREE(first);
+    if (blocks != NULL) FREE(blocks);
+    if (nblocks < 0) {
+	dd->errorCode = CUDD_MEMORY_OUT;
+	return(-1);
+    }
+    return(moved);
+
+} /* end of Cudd_CompactNodes */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the current address of a possibly moved child.]
+
+  Description [Returns the current address of a possibly moved child,
+  preserving the complement attribute of the given pointer.]
+
+  SideEffects [None]
+
+  SeeAlso     [Cudd_CompactNodes]
+
+******************************************************************************/
+static DdNode *
+ddCompactForward(
+  DdManager * dd,
+  DdNode * f)
+{
+    DdNode *F = Cudd_Regular(f);
+
+    if (ddCompactIsForwarded(dd,F)) {
+	return(Cudd_NotCond(cuddT(F),Cudd_IsComplement(f)));
+    }
+    return(f);
+
+} /* end of ddCompactForward */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Inserts a node in the unique subtable of a level.]
+
+  Description [Inserts a node in the unique subtable of a level,
+  keeping the collision lists ordered as cuddUniqueInter expects.]
+
+  SideEffects [None]
+
+  SeeAlso     [cuddUniqueInter]
+
+******************************************************************************/
+static void
+ddCompactInsert(
+  DdManager * dd,
+  int level,
+  DdNode * node)
+{
+    DdSubtable *subtable = &(dd->subtables[level]);
+    DdNode *T = cuddT(node);
+    DdNode *E = cuddE(node);
+    DdNodePtr *previousP;
+    DdNode *looking;
+    int pos;
+
+    pos = ddHash(T, E, subtable->shift);
+    previousP = &(subtable->nodelist[pos]);
+    looking = *previousP;
+    while (T < cuddT(looking)) {
+	previousP = &(looking->next);
+	looking = *previousP;
+    }
+    while (T == cuddT(looking) && E < cuddE(looking)) {
+	previousP = &(looking->next);
+	looking = *previousP;
+    }
+    node->next = *previousP;
+    *previousP = node;
+
+} /* end of ddCompactInsert */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Rebuilds the free list from the memory list.]
+
+  Description [Frees the node blocks obtained from the ordinary
+  allocator that no longer contain any node in use, then threads all
+  the nodes with null reference count into a new free list, in address
+  order.]
+
+  SideEffects [None]
+
+  SeeAlso     [cuddGarbageCollect]
+
+******************************************************************************/
+static void
+ddCompactRebuildFreeList(
+  DdManager * dd)
+{
+    DdNodePtr *mem, *next, **memP;
+    DdNode *list, *last;
+    DdMemRegion *region;
+    ptruint offset;
+    int k, used;
+
+    memP = &(dd->memoryList);
+    last = NULL;
+    dd->nextFree = NULL;
+    for (mem = dd->memoryList; mem != NULL; mem = next) {
+	next = (DdNodePtr *) mem[0];
+	offset = (ptruint) mem & (sizeof(DdNode) - 1);
+	list = (DdNode *) (mem + (sizeof(DdNode) - offset) / sizeof(DdNodePtr));
+	used = 0;
+	for (k = 0; k < DD_MEM_CHUNK && !used; k++) {
+	    used = list[k].ref != 0;
+	}
+	for (region = dd->regions; region != NULL; region = region->next) {
+	    if ((char *) mem >= region->base &&
+		(char *) mem < region->base + region->size) break;
+	}
+	if (!used && region == NULL) {
+	    *memP = next;
+	    dd->memused -= (DD_MEM_CHUNK + 1) * sizeof(DdNode);
+	    FREE(mem);
+	    continue;
+	}
+	memP = (DdNodePtr **) &(mem[0]);
+	for (k = 0; k < DD_MEM_CHUNK; k++) {
+	    if (list[k].ref == 0) {
+		if (last == NULL) {
+		    dd->nextFree = &list[k];
+		} else {
+		    last->next = &list[k];
+		}
+		last = &list[k];
+	    }
+	}
+    }
+    if (last != NULL) last->next = NULL;
+
+} /* end of ddCompactRebuildFreeList */
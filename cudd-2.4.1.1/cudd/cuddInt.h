@@ -73,6 +73,20 @@
 #include "cudd.h"
 #include "st.h"
 
+/* NuSMV: add begin */
+/* DD_HAVE_MMAP is defined if node regions can be mapped, see
+   cuddAllocNodeChunk */
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <sys/mman.h>
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifdef MAP_ANONYMOUS
+#define DD_HAVE_MMAP
+#endif
+#endif
+/* NuSMV: add end */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -103,6 +117,10 @@ extern "C" {
 #define DD_DEFAULT_RESIZE	10	/* how many extra variables */
 					/* should be added when resizing */
 #define DD_MEM_CHUNK		1022
+/* NuSMV: add begin */
+#define DD_REGION_SIZE		(32 << 20) /* default size of a node region */
+#define DD_REGION_ALIGN		(2 << 20)  /* alignment of regions (huge page) */
+/* NuSMV: add end */
 
 /* These definitions work for CUDD_VALUE_TYPE == double */
 #define DD_TRUE_VAL		(1.0)
@@ -248,6 +266,20 @@ typedef struct DdHook {		/* hook list element */
     struct DdHook *next;	/* next element in the list */
 } DdHook;
 
+/* NuSMV: add begin */
+/* Large anonymous mappings from which node chunks are carved when the
+** huge page backend is enabled. Regions whose nodes are all free after a
+** garbage collection are given back to the operating system.
+*/
+typedef struct DdMemRegion {
+    char *base;			/* start of the mapping */
+    size_t size;		/* number of bytes mapped */
+    size_t used;		/* bytes already handed out as node chunks */
+    int busy;			/* scratch flag used during release */
+    struct DdMemRegion *next;	/* next region in the list */
+} DdMemRegion;
+/* NuSMV: add end */
+
 #ifdef __osf__
 #pragma pointer_size save
 #pragma pointer_size short
@@ -387,6 +419,15 @@ struct DdManager {	/* specialized DD symbol table */
     DdNode **memoryList;	/* memory manager for symbol table */
     DdNode *nextFree;		/* list of free nodes */
     char *stash;		/* memory reserve */
+    /* NuSMV: add begin */
+    int hugePages;		/* carve node chunks from huge page regions */
+    size_t regionSize;		/* size of a newly mapped region */
+    DdMemRegion *regions;	/* regions currently mapped */
+    DdMemRegion *currentRegion;	/* region chunks are carved from */
+    ptruint regionMem;		/* bytes currently mapped in regions */
+    int regionsMapped;		/* number of regions mapped so far */
+    int regionsReleased;	/* number of regions released so far */
+    /* NuSMV: add end */
 #ifndef DD_NO_DEATH_ROW
     DdNode **deathRow;		/* queue for dereferencing */
     int deathRowDepth;		/* number of slots in the queue */
@@ -1220,6 +1261,11 @@ extern int cuddSymmCheck (DdManager *table, int x, int y);
 extern int cuddSymmSifting (DdManager *table, int lower, int upper);
 extern int cuddSymmSiftingConv (DdManager *table, int lower, int upper);
 extern DdNode * cuddAllocNode (DdManager *unique);
+/* NuSMV: add begin */
+extern DdNodePtr * cuddAllocNodeChunk (DdManager *unique);
+extern void cuddReleaseFreeRegions (DdManager *unique);
+extern void cuddAdviseHugePages (DdManager *unique, void *p, size_t size);
+/* NuSMV: add end */
 extern DdManager * cuddInitTable (unsigned int numVars, unsigned int numVarsZ, unsigned int numSlots, unsigned int looseUpTo);
 extern void cuddFreeTable (DdManager *unique);
 extern int cuddGarbageCollect (DdManager *unique, int clearCache);
@@ -425,7 +425,10 @@ cuddDynamicAllocNode(
 	/* Try to allocate a new block. */
 	saveHandler = MMoutOfMemory;
 	MMoutOfMemory = Cudd_OutOfMem;
-	mem = (DdNodePtr *) ALLOC(DdNode, DD_MEM_CHUNK + 1);
+	/* NuSMV: add begin */
+	mem = cuddAllocNodeChunk(table);
+	  /* WAS: mem = (DdNodePtr *) ALLOC(DdNode, DD_MEM_CHUNK + 1); */
+	/* NuSMV: add end */
 	MMoutOfMemory = saveHandler;
 	if (mem == NULL && table->stash != NULL) {
 	    FREE(table->stash);
@@ -436,7 +439,10 @@ cuddDynamicAllocNode(
 	    for (i = 0; i < table->size; i++) {
 		table->subtables[i].maxKeys <<= 2;
 	    }
-	    mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1);
+	    /* NuSMV: add begin */
+	    mem = cuddAllocNodeChunk(table);
+	      /* WAS: mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1); */
+	    /* NuSMV: add end */
 	}
 	if (mem == NULL) {
 	    /* Out of luck. Call the default handler to do
@@ -13,6 +13,9 @@
 	Internal procedures included in this module:
 		<ul>
 		<li> cuddAllocNode()
+		<li> cuddAllocNodeChunk()
+		<li> cuddReleaseFreeRegions()
+		<li> cuddAdviseHugePages()
 		<li> cuddInitTable()
 		<li> cuddFreeTable()
 		<li> cuddGarbageCollect()
@@ -33,6 +36,8 @@
 		<ul>
 		<li> ddRehashZdd()
 		<li> ddResizeTable()
+		<li> ddMapRegion()
+		<li> ddFindRegion()
 		<li> cuddFindParent()
 		<li> cuddOrderedInsert()
 		<li> cuddOrderedThread()
@@ -148,6 +153,10 @@ static char rcsid[] DD_UNUSED = "$Id: cuddTable.c,v 1.1.2.1 2010-02-04 10:41:16
 
 static void ddRehashZdd (DdManager *unique, int i);
 static int ddResizeTable (DdManager *unique, int index);
+/* NuSMV: add begin */
+static DdMemRegion * ddMapRegion (DdManager *unique);
+static DdMemRegion * ddFindRegion (DdManager *unique, DdMemRegion *hint, void *p);
+/* NuSMV: add end */
 static int cuddFindParent (DdManager *table, DdNode *node);
 DD_INLINE static void ddFixLimits (DdManager *unique);
 #ifdef DD_RED_BLACK_FREE_LIST
@@ -256,7 +265,10 @@ cuddAllocNode(
 	    /* Try to allocate a new block. */
 	    saveHandler = MMoutOfMemory;
 	    MMoutOfMemory = Cudd_OutOfMem;
-	    mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1);
+	    /* NuSMV: add begin */
+	    mem = cuddAllocNodeChunk(unique);
+	      /* WAS: mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1); */
+	    /* NuSMV: add end */
 	    MMoutOfMemory = saveHandler;
 	    if (mem == NULL) {
 		/* No more memory: Try collecting garbage. If this succeeds,
@@ -272,7 +284,10 @@ cuddAllocNode(
 			/* Inhibit resizing of tables. */
 			cuddSlowTableGrowth(unique);
 			/* Now try again. */
-			mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1);
+			/* NuSMV: add begin */
+			mem = cuddAllocNodeChunk(unique);
+			  /* WAS: mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1); */
+			/* NuSMV: add end */
 		    }
 		    if (mem == NULL) {
 			/* Out of luck. Call the default handler to do
@@ -325,6 +340,176 @@ cuddAllocNode(
 } /* end of cuddAllocNode */
 
 
+/* NuSMV: add begin */
+/**Function********************************************************************
+
+  Synopsis    [Allocates a block of memory for DD_MEM_CHUNK DdNodes.]
+
+  Description [Allocates a block of memory large enough for
+  DD_MEM_CHUNK DdNodes plus the link to the next block. If the huge
+  page backend is enabled the block is carved from a large anonymous
+  mapping, which is advised for transparent huge pages; otherwise (or if
+  mapping fails) the block is obtained from the ordinary allocator.
+  Returns a pointer to the block if successful; NULL otherwise.]
+
+  SideEffects [May map a new region.]
+
+  SeeAlso     [cuddAllocNode cuddDynamicAllocNode cuddReleaseFreeRegions]
+
+******************************************************************************/
+DdNodePtr *
+cuddAllocNodeChunk(
+  DdManager * unique)
+{
+    size_t chunkSize = (DD_MEM_CHUNK + 1) * sizeof(DdNode);
+    DdMemRegion *region;
+    DdNodePtr *mem;
+
+    if (unique->hugePages) {
+	region = unique->currentRegion;
+	if (region == NULL || region->used + chunkSize > region->size) {
+	    region = ddMapRegion(unique);
+	}
+	if (region != NULL) {
+	    mem = (DdNodePtr *) (region->base + region->used);
+	    region->used += chunkSize;
+	    return(mem);
+	}
+    }
+    return((DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1));
+
+} /* end of cuddAllocNodeChunk */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns to the system the regions that hold no live node.]
+
+  Description [Scans the node blocks carved from huge page regions and
+  unmaps every region, other than the one chunks are currently carved
+  from, whose nodes all have a null reference count. The blocks of the
+  released regions are removed from the memory list. Must be called
+  only when all nodes with null reference count are free, that is,
+  right after the dead nodes have been removed from the unique tables
+  and before the free list is rebuilt from the memory list.
+
+  Regions are released as a whole: a single live node in any of its
+  blocks keeps a region mapped. Since live nodes are usually scattered
+  over all the blocks, in practice few regions (often none) are
+  released, and the memory of dead nodes is reused through the free
+  list instead.]
+
+  SideEffects [The free list is no longer valid if some region is
+  released.]
+
+  SeeAlso     [cuddGarbageCollect cuddAllocNodeChunk]
+
+******************************************************************************/
+void
+cuddReleaseFreeRegions(
+  DdManager * unique)
+{
+#ifdef DD_HAVE_MMAP
+    size_t chunkSize = (DD_MEM_CHUNK + 1) * sizeof(DdNode);
+    DdMemRegion *region, *hint, **regionP;
+    DdNodePtr *mem, *next, **memP;
+    DdNode *list;
+    ptruint offset;
+    int k, releasable;
+
+    for (region = unique->regions; region != NULL; region = region->next) {
+	region->busy = region == unique->currentRegion;
+    }
+
+    hint = NULL;
+    for (mem = unique->memoryList; mem != NULL; mem = (DdNodePtr *) mem[0]) {
+	region = ddFindRegion(unique, hint, mem);
+	if (region == NULL) continue;
+	hint = region;
+	if (region->busy) continue;
+	offset = (ptruint) mem & (sizeof(DdNode) - 1);
+	list = (DdNode *) (mem + (sizeof(DdNode) - offset) / sizeof(DdNodePtr));
+	for (k = 0; k < DD_MEM_CHUNK; k++) {
+	    if (list[k].ref != 0) {
+		region->busy = 1;
+		break;
+	    }
+	}
+    }
+
+    releasable = 0;
+    for (region = unique->regions; region != NULL; region = region->next) {
+	if (!region->busy) releasable++;
+    }
+    if (releasable == 0) return;
+
+    /* Unlink the blocks of the released regions from the memory list. */
+    hint = NULL;
+    memP = &(unique->memoryList);
+    for (mem = unique->memoryList; mem != NULL; mem = next) {
+	next = (DdNodePtr *) mem[0];
+	region = ddFindRegion(unique, hint, mem);
+	if (region != NULL && !region->busy) {
+	    hint = region;
+	    *memP = next;
+	    unique->memused -= chunkSize;
+	} else {
+	    memP = (DdNodePtr **) &(mem[0]);
+	}
+    }
+
+    regionP = &(unique->regions);
+    while ((region = *regionP) != NULL) {
+	if (!region->busy) {
+	    *regionP = region->next;
+	    (void) munmap(region->base, region->size);
+	    unique->regionMem -= region->size;
+	    unique->regionsReleased++;
+	    FREE(region);
+	} else {
+	    regionP = &(region->next);
+	}
+    }
+#endif
+
+} /* end of cuddReleaseFreeRegions */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Advises the system to back a large table with huge pages.]
+
+  Description [If the huge page backend is enabled, asks the system to
+  back the page-aligned interior of the given memory block with
+  transparent huge pages. This is only a hint: the block keeps being
+  owned by the ordinary allocator.]
+
+  SideEffects [None]
+
+  SeeAlso     [cuddAllocNodeChunk]
+
+******************************************************************************/
+void
+cuddAdviseHugePages(
+  DdManager * unique,
+  void * p,
+  size_t size)
+{
+#if defined(DD_HAVE_MMAP) && defined(MADV_HUGEPAGE)
+    ptruint start, end;
+
+    if (!unique->hugePages || p == NULL) return;
+    start = ((ptruint) p + DD_REGION_ALIGN - 1) & ~((ptruint) DD_REGION_ALIGN - 1);
+    end = ((ptruint) p + size) & ~((ptruint) DD_REGION_ALIGN - 1);
+    if (end > start) {
+	(void) madvise((void *) start, (size_t) (end - start), MADV_HUGEPAGE);
+    }
+#endif
+
+} /* end of cuddAdviseHugePages */
+/* NuSMV: add end */
+
+
 /**Function********************************************************************
 
   Synopsis    [Creates and initializes the unique table.]
@@ -504,6 +689,15 @@ cuddInitTable(
 
     unique->memoryList = NULL;
     unique->nextFree = NULL;
+    /* NuSMV: add begin */
+    unique->hugePages = 0;
+    unique->regionSize = DD_REGION_SIZE;
+    unique->regions = NULL;
+    unique->currentRegion = NULL;
+    unique->regionMem = 0;
+    unique->regionsMapped = 0;
+    unique->regionsReleased = 0;
+    /* NuSMV: add end */
 
     unique->memused = sizeof(DdManager) + (unique->maxSize + unique->maxSizeZ)
 	* (sizeof(DdSubtable) + 2 * sizeof(int)) + (numVars + 1) *
@@ -598,15 +792,38 @@ cuddFreeTable(
     DdNodePtr *next;
     DdNodePtr *memlist = unique->memoryList;
     int i;
+    /* NuSMV: add begin */
+    DdMemRegion *region, *hint = NULL;
+    /* NuSMV: add end */
 
     if (unique->univ != NULL) cuddZddFreeUniv(unique);
     while (memlist != NULL) {
         next = (DdNodePtr *) memlist[0];	/* link to next block */
-	FREE(memlist);
+	/* NuSMV: add begin */
+	region = ddFindRegion(unique, hint, memlist);
+	if (region == NULL) {
+	    FREE(memlist);
+	} else {
+	    hint = region;
+	}
+	  /* WAS: FREE(memlist); */
+	/* NuSMV: add end */
 	memlist = next;
     }
     unique->nextFree = NULL;
     unique->memoryList = NULL;
+    /* NuSMV: add begin */
+    while (unique->regions != NULL) {
+	region = unique->regions;
+	unique->regions = region->next;
+#ifdef DD_HAVE_MMAP
+	(void) munmap(region->base, region->size);
+#endif
+	FREE(region);
+    }
+    unique->currentRegion = NULL;
+    unique->regionMem = 0;
+    /* NuSMV: add end */
 
     for (i = 0; i < unique->size; i++) {
 	FREE(unique->subtables[i].nodelist);
@@ -913,6 +1130,9 @@ cuddGarbageCollect(
 #ifdef DD_RED_BLACK_FREE_LIST
     unique->nextFree = cuddOrderedThread(tree,unique->nextFree);
 #else
+    /* NuSMV: add begin */
+    if (unique->regions != NULL) cuddReleaseFreeRegions(unique);
+    /* NuSMV: add end */
     memListTrav = unique->memoryList;
     sentry = NULL;
     while (memListTrav != NULL) {
@@ -935,7 +1155,14 @@ cuddGarbageCollect(
 	} while (++k < DD_MEM_CHUNK);
 	memListTrav = nxtNode;
     }
-    sentry->next = NULL;
+    /* NuSMV: add begin */
+    if (sentry != NULL) {
+	sentry->next = NULL;
+    } else {
+	unique->nextFree = NULL;
+    }
+      /* WAS: sentry->next = NULL; */
+    /* NuSMV: add end */
 #endif
 #endif
 
@@ -1548,6 +1775,9 @@ cuddRehash(
 	    }
 	    return;
 	}
+	/* NuSMV: add begin */
+	cuddAdviseHugePages(unique, nodelist, slots * sizeof(DdNodePtr));
+	/* NuSMV: add end */
 	unique->subtables[i].nodelist = nodelist;
 	unique->subtables[i].slots = slots;
 	unique->subtables[i].shift = shift;
@@ -3170,3 +3400,105 @@ See the CUDD Programmer's Guide for additional details.");
     abort();
 
 } /* end of ddReportRefMess */
+
+
+/* NuSMV: add begin */
+/**Function********************************************************************
+
+  Synopsis    [Maps a new region for node blocks.]
+
+  Description [Maps a new anonymous region of unique->regionSize bytes,
+  aligned to the huge page size, and advises the system to back it with
+  transparent huge pages. The region becomes the one node blocks are
+  carved from. Returns a pointer to the region descriptor if
+  successful; NULL otherwise.]
+
+  SideEffects [None]
+
+  SeeAlso     [cuddAllocNodeChunk]
+
+******************************************************************************/
+static DdMemRegion *
+ddMapRegion(
+  DdManager * unique)
+{
+#ifdef DD_HAVE_MMAP
+    DdMemRegion *region;
+    size_t size, mapped;
+    char *raw, *base;
+
+    size = (unique->regionSize + DD_REGION_ALIGN - 1) &
+	~((size_t) DD_REGION_ALIGN - 1);
+    mapped = size + DD_REGION_ALIGN;
+    raw = (char *) mmap(NULL, mapped, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == (char *) MAP_FAILED) return(NULL);
+
+    /* Trim the mapping so that it starts on a huge page boundary. */
+    base = (char *) (((ptruint) raw + DD_REGION_ALIGN - 1) &
+		     ~((ptruint) DD_REGION_ALIGN - 1));
+    if (base > raw) (void) munmap(raw, (size_t) (base - raw));
+    if (base + size < raw + mapped) {
+	(void) munmap(base + size, (size_t) ((raw + mapped) - (base + size)));
+    }
+#ifdef MADV_HUGEPAGE
+    (void) madvise(base, size, MADV_HUGEPAGE);
+#endif
+
+    region = ALLOC(DdMemRegion,1);
+    if (region == NULL) {
+	(void) munmap(base, size);
+	return(NULL);
+    }
+    region->base = base;
+    region->size = size;
+    region->used = 0;
+    region->busy = 0;
+    region->next = unique->regions;
+    unique->regions = region;
+    unique->currentRegion = region;
+    unique->regionMem += size;
+    unique->regionsMapped++;
+    return(region);
+#else
+    return(NULL);
+#endif
+
+} /* end of ddMapRegion */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Finds the region a node block belongs to.]
+
+  Description [Returns the region containing the given address, or NULL
+  if the address was not carved from any region. The hint is checked
+  first, since consecutive blocks on the memory list usually come from
+  the same region.]
+
+  SideEffects [None]
+
+  SeeAlso     [cuddReleaseFreeRegions cuddFreeTable]
+
+******************************************************************************/
+static DdMemRegion *
+ddFindRegion(
+  DdManager * unique,
+  DdMemRegion * hint,
+  void * p)
+{
+    DdMemRegion *region;
+    char *addr = (char *) p;
+
+    if (hint != NULL && addr >= hint->base && addr < hint->base + hint->size) {
+	return(hint);
+    }
+    for (region = unique->regions; region != NULL; region = region->next) {
+	if (addr >= region->base && addr < region->base + region->size) {
+	    return(region);
+	}
+    }
+    return(NULL);
+
+} /* end of ddFindRegion */
+/* NuSMV: add end */
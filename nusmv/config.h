@@ -107,7 +107,7 @@
 #define HAVE_REGEX_H 1
 
 /* No sat solvers available */
-#define HAVE_SAT_SOLVER 0
+#define HAVE_SAT_SOLVER 1
 
 /* Define to 1 if you have the `setvbuf' function. */
 #define HAVE_SETVBUF 1
@@ -115,6 +115,9 @@
 /* Define to 1 if you have the <signal.h> header file. */
 #define HAVE_SIGNAL_H 1
 
+/* Disables the in-tree CDCL sat solver */
+#define HAVE_SOLVER_CDCL 1
+
 /* Disables Minisat */
 #define HAVE_SOLVER_MINISAT 0
 
@@ -172,7 +172,7 @@
 
 /* No sat solvers available */
 #ifndef NUSMV_HAVE_SAT_SOLVER
-#define NUSMV_HAVE_SAT_SOLVER 0
+#define NUSMV_HAVE_SAT_SOLVER 1
 #endif
 
 /* Define to 1 if you have the `setvbuf' function. */
@@ -185,6 +185,11 @@
 #define NUSMV_HAVE_SIGNAL_H 1
 #endif
 
+/* Disables the in-tree CDCL sat solver */
+#ifndef NUSMV_HAVE_SOLVER_CDCL
+#define NUSMV_HAVE_SOLVER_CDCL 1
+#endif
+
 /* Disables Minisat */
 #ifndef NUSMV_HAVE_SOLVER_MINISAT
 #define NUSMV_HAVE_SOLVER_MINISAT 0
@@ -76,6 +76,31 @@ typedef struct Be_Manager_TAG* Be_Manager_ptr; /* generic be manger */
 typedef struct Be_Cnf_TAG* Be_Cnf_ptr; /* cnf representation */
 
 
+/**Struct**********************************************************************
+
+  Synopsis    [A Boolean Expression flattened for repeated shifting]
+
+  Description [See Be_ShiftTemplate_Create]
+
+  SeeAlso     []
+
+******************************************************************************/
+typedef struct Be_ShiftTemplate_TAG* Be_ShiftTemplate_ptr;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [A set of Boolean Expressions compiled for bit-parallel
+  simulation]
+
+  Description [See Be_Sim_Create]
+
+  SeeAlso     []
+
+******************************************************************************/
+typedef struct Be_Sim_TAG* Be_Sim_ptr;
+
+
 /**Struct**********************************************************************
 
   Synopsis    [The Boolean Expression type]
@@ -116,6 +141,43 @@ typedef be_ptr (*Be_Spec2Be_fun)(Be_Manager_ptr self, void* spec_be);
 typedef void*  (*Be_Be2Spec_fun)(Be_Manager_ptr self, be_ptr be);
 
 
+/**Struct**********************************************************************
+
+  Synopsis    [CNF clause sink type]
+
+  Description [This is the function type of the receivers of the
+  clauses produced by Be_ConvertToCnfSink. 'clause' holds 'size'
+  literals (it is not terminated by 0), and is valid only for the
+  duration of the call.]
+
+  SeeAlso     [Be_ConvertToCnfSink]
+
+******************************************************************************/
+typedef void (*Be_CnfClauseSink)(void* data, const int* clause, int size);
+
+
+/**Enum************************************************************************
+
+  Synopsis    [Which clauses Be_ConvertToCnfSink has to produce]
+
+  Description [The manager remembers the sub-formulae whose clauses
+  have already been given to a (single) incremental SAT solver.
+  BE_CNF_EMIT_ALL ignores this information, BE_CNF_EMIT_NEW produces
+  the clauses of the sub-formulae not given yet, and
+  BE_CNF_EMIT_NEW_MARK also records the sub-formulae whose clauses are
+  produced. Only clauses that will never be removed from the solver
+  can be recorded.]
+
+  SeeAlso     [Be_ConvertToCnfSink, Be_ResetCnfEmitted]
+
+******************************************************************************/
+typedef enum Be_CnfEmitMode_TAG {
+  BE_CNF_EMIT_ALL,
+  BE_CNF_EMIT_NEW,
+  BE_CNF_EMIT_NEW_MARK
+} Be_CnfEmitMode;
+
+
 #include <limits.h>
 /* ================================================== */
 /* Put here any specific boolean expression manager
@@ -124,6 +186,20 @@ typedef void*  (*Be_Be2Spec_fun)(Be_Manager_ptr self, be_ptr be);
 /* ================================================== */
 
 #include "utils/utils.h" /* for EXTERN and ARGS */
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [Equivalence prover type]
+
+  Description [This is the function type of the provers used by
+  Be_Sweep. It must return true only if a and b are equivalent.]
+
+  SeeAlso     [Be_Sweep]
+
+******************************************************************************/
+typedef boolean (*Be_EquivProver)(Be_Manager_ptr mgr, be_ptr a, be_ptr b,
+                                  void* data);
 #include "utils/Slist.h"
 
 /*---------------------------------------------------------------------------*/
@@ -246,6 +322,24 @@ Be_LogicalVarSubst ARGS((Be_Manager_ptr manager, be_ptr f,
                          const int* log2phy, 
                          const int* phy2log));
 
+EXTERN Be_ShiftTemplate_ptr
+Be_ShiftTemplate_Create ARGS((Be_Manager_ptr manager, be_ptr f,
+                              const int* phy2log));
+
+EXTERN void Be_ShiftTemplate_Delete ARGS((Be_ShiftTemplate_ptr tmpl));
+
+EXTERN int Be_ShiftTemplate_GetSize ARGS((const Be_ShiftTemplate_ptr tmpl));
+
+EXTERN be_ptr
+Be_ShiftTemplate_Shift ARGS((Be_Manager_ptr manager,
+                             Be_ShiftTemplate_ptr tmpl, int shift,
+                             const int* log2phy));
+
+EXTERN be_ptr
+Be_ShiftTemplate_Subst ARGS((Be_Manager_ptr manager,
+                             Be_ShiftTemplate_ptr tmpl, int* subst,
+                             const int* log2phy));
+
 
 /* ================================================== */
 
@@ -255,9 +349,24 @@ Be_LogicalVarSubst ARGS((Be_Manager_ptr manager, be_ptr f,
 EXTERN Be_Cnf_ptr 
 Be_ConvertToCnf ARGS((Be_Manager_ptr manager, be_ptr f, int polarity));
 
+EXTERN Be_Cnf_ptr
+Be_ConvertToCnfSink ARGS((Be_Manager_ptr manager, be_ptr f, int polarity,
+                          Be_CnfEmitMode mode,
+                          Be_CnfClauseSink sink, void* data));
+
+EXTERN void Be_ResetCnfEmitted ARGS((Be_Manager_ptr manager));
+
+EXTERN void Be_GetCnfStats ARGS((Be_Manager_ptr manager,
+                                 int* clauses, int* reused));
+
 EXTERN int Be_CnfLiteral2BeLiteral ARGS((const Be_Manager_ptr self,
                                          int cnfLiteral));
 
+EXTERN be_ptr Be_CnfLiteral2Be ARGS((const Be_Manager_ptr self,
+                                    int cnfLiteral));
+
+EXTERN int Be_NewCnfVar ARGS((const Be_Manager_ptr self));
+
 EXTERN int Be_BeLiteral2CnfLiteral ARGS((const Be_Manager_ptr self,
                                          int beLiteral));
 
@@ -304,6 +413,23 @@ EXTERN int Be_BeLiteral_Negate ARGS((const Be_Manager_ptr self,
 EXTERN be_ptr 
 Be_apply_inlining ARGS((Be_Manager_ptr self, be_ptr f, boolean add_conj));
 
+EXTERN be_ptr Be_Rewrite ARGS((Be_Manager_ptr self, be_ptr f));
+
+EXTERN void
+Be_Sweep ARGS((Be_Manager_ptr self, be_ptr* fs, int num, int words,
+               Be_EquivProver prover, void* data, int* merged));
+
+EXTERN be_ptr
+Be_ExtractDefinitions ARGS((Be_Manager_ptr manager, be_ptr f,
+                            const int* vars, int num, be_ptr* defs));
+
+EXTERN Be_Sim_ptr
+Be_Sim_Create ARGS((Be_Manager_ptr manager, be_ptr* fs, int num));
+EXTERN void Be_Sim_Delete ARGS((Be_Sim_ptr sim));
+EXTERN int Be_Sim_GetWords ARGS((void));
+EXTERN void Be_Sim_Run ARGS((Be_Sim_ptr sim, const unsigned long long* vars,
+                             unsigned long long* out));
+
 EXTERN void
 Be_Cnf_PrintStat ARGS((const Be_Cnf_ptr self, FILE* outFile, char* prefix));
 
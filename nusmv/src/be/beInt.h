@@ -51,39 +51,8 @@
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
-/**Variable********************************************************************
-  Synopsis     [shift hash table]
-
-  Description  [(:TODO: this variable should be a Be_RbcManager's member, 
-  and any associated service should be a Be_RbcManager's method.)]
-
-  SeeAlso      []
-******************************************************************************/
-EXTERN st_table* htShift_ptr; 
-
 EXTERN FILE* nusmv_stderr;
 EXTERN FILE* nusmv_stdout;
 
 
-/*---------------------------------------------------------------------------*/
-/* Structures declarations                                                   */
-/*---------------------------------------------------------------------------*/
-
-/**Struct**********************************************************************
-
-  Synopsis    [shift_memoize_key is a private struct used in shift memoizing]
-
-  Description [Used in order to contain the key values in hash operation 
-  involved in shift memoizing]
-
-  SeeAlso     []
-
-******************************************************************************/
-typedef struct shift_memoize_key_TAG
-{
-  be_ptr  be;
-  int     shift;
-} shift_memoize_key; 
-
-
 #endif /* _BE_INT_H */
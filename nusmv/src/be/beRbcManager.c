@@ -47,6 +47,7 @@
 
 #include "opt/opt.h"
 #include "utils/defs.h"
+#include "utils/error.h"
 
 /*---------------------------------------------------------------------------*/
 /* Constant declarations                                                     */
@@ -61,6 +62,21 @@ const int BE_INVALID_SUBST_VALUE = RBC_INVALID_SUBST_VALUE;
 /* Structure declarations                                                    */
 /*---------------------------------------------------------------------------*/
 
+/**Struct**********************************************************************
+
+  Synopsis    [Adapts a be equivalence prover to the rbc layer]
+
+  Description [Used by Be_Sweep.]
+
+  SeeAlso     []
+
+******************************************************************************/
+typedef struct BeRbcSweepProver_TAG {
+  Be_Manager_ptr mgr;
+  Be_EquivProver prover;
+  void* data;
+} BeRbcSweepProver;
+
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -128,6 +144,7 @@ const int BE_INVALID_SUBST_VALUE = RBC_INVALID_SUBST_VALUE;
 /*---------------------------------------------------------------------------*/
 static void* beRbc_Be2Rbc(Be_Manager_ptr mgr, be_ptr be);
 static be_ptr beRbc_Rbc2Be(Be_Manager_ptr mgr, void* rbc);
+static boolean beRbc_sweep_prover(Rbc_t* a, Rbc_t* b, void* data);
 
 
 /**AutomaticEnd***************************************************************/
@@ -522,6 +539,115 @@ be_ptr Be_LogicalVarSubst(Be_Manager_ptr manager, be_ptr f, int* subst,
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Flattens the be f for repeated logical shifting and
+  substitution]
+
+  Description [The returned template produces the same results as
+               Be_LogicalShiftVar and Be_LogicalVarSubst on f, but
+               every application is a linear sweep over a flat array
+               instead of a visit of f. This pays off when f is
+               shifted at many times, as the transition relation is
+               in unrollings.
+
+               Variables are stored at logical level: the template
+               must be deleted as soon as phy2log changes. The caller
+               is responsible for deleting the template.]
+
+  SideEffects []
+
+  SeeAlso     [Be_ShiftTemplate_Shift, Be_ShiftTemplate_Subst,
+               Be_ShiftTemplate_Delete]
+
+******************************************************************************/
+Be_ShiftTemplate_ptr Be_ShiftTemplate_Create(Be_Manager_ptr manager,
+                                             be_ptr f, const int* phy2log)
+{
+  return (Be_ShiftTemplate_ptr)
+    Rbc_ShiftTemplateCreate(GET_RBC_MGR(manager), RBC(manager, f), phy2log);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Deletes a template created by Be_ShiftTemplate_Create]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Be_ShiftTemplate_Create]
+
+******************************************************************************/
+void Be_ShiftTemplate_Delete(Be_ShiftTemplate_ptr tmpl)
+{
+  Rbc_ShiftTemplateDestroy((Rbc_ShiftTemplate_t*) tmpl);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of nodes of a template]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Be_ShiftTemplate_GetSize(const Be_ShiftTemplate_ptr tmpl)
+{
+  return Rbc_ShiftTemplateGetSize((const Rbc_ShiftTemplate_t*) tmpl);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Shifts the be the template was created from]
+
+  Description [Same as Be_LogicalShiftVar]
+
+  SideEffects []
+
+  SeeAlso     [Be_LogicalShiftVar]
+
+******************************************************************************/
+be_ptr Be_ShiftTemplate_Shift(Be_Manager_ptr manager,
+                              Be_ShiftTemplate_ptr tmpl, int shift,
+                              const int* log2phy)
+{
+  return BE(manager,
+            Rbc_ShiftTemplateApply(GET_RBC_MGR(manager),
+                                   (Rbc_ShiftTemplate_t*) tmpl,
+                                   shift, log2phy));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Substitutes the variables of the be the template was
+  created from]
+
+  Description [Same as Be_LogicalVarSubst]
+
+  SideEffects []
+
+  SeeAlso     [Be_LogicalVarSubst]
+
+******************************************************************************/
+be_ptr Be_ShiftTemplate_Subst(Be_Manager_ptr manager,
+                              Be_ShiftTemplate_ptr tmpl, int* subst,
+                              const int* log2phy)
+{
+  return BE(manager,
+            Rbc_ShiftTemplateApplySubst(GET_RBC_MGR(manager),
+                                        (Rbc_ShiftTemplate_t*) tmpl,
+                                        subst, log2phy));
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Converts the given be into the corresponding CNF-ed be]
@@ -583,6 +709,117 @@ Be_Cnf_ptr Be_ConvertToCnf(Be_Manager_ptr manager, be_ptr f, int polarity)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Converts the given be into CNF, handing the clauses to a
+  sink]
+
+  Description [Same as Be_ConvertToCnf, but the clauses are passed to
+  'sink' (along with 'data') as soon as they are generated, instead of
+  being stored into the returned Be_Cnf. This is the way to load a
+  problem into a SAT solver without keeping the CNF in memory.
+
+  The returned Be_Cnf carries the original problem, the maximum
+  variable index and the formula literal, but no clause and no
+  variable, so it cannot be dumped. The only exception are the
+  constants, which are returned as Be_ConvertToCnf does, without
+  calling 'sink'. The caller is responsible for deleting the returned
+  Be_Cnf (via Be_Cnf_Delete).
+
+  'mode' allows to feed an incremental SAT solver only with the
+  clauses of the sub-formulae it has not received yet, see
+  Be_CnfEmitMode.]
+
+  SideEffects []
+
+  SeeAlso     [Be_ConvertToCnf, Be_Cnf_Delete, Be_ResetCnfEmitted]
+
+******************************************************************************/
+Be_Cnf_ptr Be_ConvertToCnfSink(Be_Manager_ptr manager, be_ptr f,
+                               int polarity, Be_CnfEmitMode mode,
+                               Be_CnfClauseSink sink, void* data)
+{
+  Rbc_CnfEmitMode rbc_mode;
+  Be_Cnf_ptr cnf;
+  int max_var_idx;
+  int literalAssignedToWholeFormula = INT_MIN;
+
+  /* constants are kept as clause lists (see Be_Cnf_ptr) */
+  if (Be_IsConstant(manager, f)) return Be_ConvertToCnf(manager, f, polarity);
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    fprintf(nusmv_stderr, "\nConverting the BE problem into CNF problem...\n");
+  }
+
+  switch (mode) {
+  case BE_CNF_EMIT_ALL: rbc_mode = RBC_CNF_EMIT_ALL; break;
+  case BE_CNF_EMIT_NEW: rbc_mode = RBC_CNF_EMIT_NEW; break;
+  case BE_CNF_EMIT_NEW_MARK: rbc_mode = RBC_CNF_EMIT_NEW_MARK; break;
+  default: error_unreachable_code();
+  }
+
+  cnf = Be_Cnf_Create(f);
+  max_var_idx = Rbc_Convert2CnfSink(GET_RBC_MGR(manager),
+                                    RBC(manager, f),
+                                    polarity, rbc_mode,
+                                    (Rbc_ClauseSink_t) sink, data,
+                                    (Slist_ptr) NULL,
+                                    &literalAssignedToWholeFormula);
+
+  nusmv_assert(literalAssignedToWholeFormula >= INT_MIN);
+
+  Be_Cnf_SetMaxVarIndex(cnf, max_var_idx);
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 1)) {
+    fprintf(nusmv_stderr, " Conversion returned maximum variable index = %d\n",
+            Be_Cnf_GetMaxVarIndex(cnf));
+  }
+
+  Be_Cnf_SetFormulaLiteral(cnf, literalAssignedToWholeFormula);
+  return cnf;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Forgets the sub-formulae whose clauses have been
+  recorded by Be_ConvertToCnfSink]
+
+  Description [Must be called when the incremental SAT solver fed with
+  BE_CNF_EMIT_NEW_MARK conversions is destroyed, as well as before
+  feeding a new one.]
+
+  SideEffects []
+
+  SeeAlso     [Be_ConvertToCnfSink]
+
+******************************************************************************/
+void Be_ResetCnfEmitted(Be_Manager_ptr manager)
+{
+  Rbc_ResetCnfEmitted(GET_RBC_MGR(manager));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the statistics of the CNF conversions]
+
+  Description [The number of clauses produced so far, and the number of
+  sub-formulae whose clauses were not produced again as already
+  recorded, are returned in *clauses and *reused respectively. The
+  values are cumulative.]
+
+  SideEffects [*clauses and *reused are set]
+
+  SeeAlso     [Be_ConvertToCnfSink]
+
+******************************************************************************/
+void Be_GetCnfStats(Be_Manager_ptr manager, int* clauses, int* reused)
+{
+  Rbc_GetCnfStats(GET_RBC_MGR(manager), clauses, reused);
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Converts the given CNF model into BE model]
@@ -645,6 +882,56 @@ int Be_CnfLiteral2BeLiteral(const Be_Manager_ptr self, int cnfLiteral)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Converts a CNF literal into the BE it stands for]
+
+  Description [Differently from Be_CnfLiteral2BeLiteral, the CNF
+  variables of internal nodes are converted as well, into the
+  sub-formula they represent. This is used when reading formulae
+  built by the SAT solver on CNF variables, like interpolants, back
+  into the BE world. Returns NULL if the variable has no associated
+  BE.]
+
+  SideEffects []
+
+  SeeAlso     [Be_CnfLiteral2BeLiteral]
+
+******************************************************************************/
+be_ptr Be_CnfLiteral2Be(const Be_Manager_ptr self, int cnfLiteral)
+{
+  Rbc_t* rbc;
+
+  nusmv_assert(0 != cnfLiteral);
+
+  rbc = Rbc_CnfVar2Rbc(GET_RBC_MGR(self), abs(cnfLiteral));
+  if (NIL(Rbc_t) == rbc) return (be_ptr) NULL;
+
+  if (cnfLiteral < 0) rbc = Rbc_MakeNot(GET_RBC_MGR(self), rbc);
+  return BE(self, rbc);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Allocates a fresh CNF variable]
+
+  Description [The variable does not stand for any BE, and is never
+  produced by the CNF conversions: it can be used as activation
+  literal in the clauses given to a SAT solver with
+  SatSolver_add_clause.]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_add_clause]
+
+******************************************************************************/
+int Be_NewCnfVar(const Be_Manager_ptr self)
+{
+  return Rbc_NewCnfVar(GET_RBC_MGR(self));
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Converts a BE literal into a CNF literal (sign is taken into
@@ -942,6 +1229,183 @@ be_ptr Be_apply_inlining(Be_Manager_ptr mgr, be_ptr f, boolean add_conj)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis [Balances and locally rewrites f]
+
+  Description [Returns a formula equivalent to f, usually smaller and
+  shallower. See Rbc_Rewrite for the details.]
+
+  SideEffects []
+
+  SeeAlso     [Rbc_Rewrite]
+
+******************************************************************************/
+be_ptr Be_Rewrite(Be_Manager_ptr mgr, be_ptr f)
+{
+  /* lazy evaluation: */
+  if (Be_IsConstant(mgr, f)) return f;
+
+  return BE(mgr, Rbc_Rewrite(GET_RBC_MGR(mgr), RBC(mgr, f)));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis [Merges the functionally equivalent sub-formulae of the
+  given formulae]
+
+  Description [Each of the num formulae in fs is replaced by an
+  equivalent one, in which the sub-formulae that simulate the same on
+  words * 64 random patterns, and that prover shows to be equivalent,
+  are merged. The number of merged sub-formulae is stored into merged,
+  if not NULL. See Rbc_Sweep for the details.]
+
+  SideEffects [fs is changed]
+
+  SeeAlso     [Rbc_Sweep]
+
+******************************************************************************/
+void Be_Sweep(Be_Manager_ptr mgr, be_ptr* fs, int num, int words,
+              Be_EquivProver prover, void* data, int* merged)
+{
+  BeRbcSweepProver sp;
+  Rbc_t** roots = ALLOC(Rbc_t*, num);
+  int i;
+
+  for (i = 0; i < num; ++i) roots[i] = RBC(mgr, fs[i]);
+
+  sp.mgr = mgr;
+  sp.prover = prover;
+  sp.data = data;
+  Rbc_Sweep(GET_RBC_MGR(mgr), roots, num, words, beRbc_sweep_prover,
+            (void*) &sp, merged);
+
+  for (i = 0; i < num; ++i) fs[i] = BE(mgr, roots[i]);
+  FREE(roots);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Extracts the functional definitions of variables from a
+  formula]
+
+  Description [vars holds the indices of num variables. Every top-level
+  conjunct of f of the form v, !v or (v <-> g), with v in vars not
+  defined yet and g not depending on any variable in vars, stores the
+  function of v into defs at the position of v in vars (the other
+  positions are set to NULL). Returns the conjunction of the remaining
+  conjuncts. See Rbc_ExtractDefinitions for the details.]
+
+  SideEffects [defs is filled]
+
+  SeeAlso     [Be_Sim_Create]
+
+******************************************************************************/
+be_ptr Be_ExtractDefinitions(Be_Manager_ptr manager, be_ptr f,
+                             const int* vars, int num, be_ptr* defs)
+{
+  Rbc_t** rbc_defs = ALLOC(Rbc_t*, (num > 0) ? num : 1);
+  Rbc_t* rest;
+  int i;
+
+  rest = Rbc_ExtractDefinitions(GET_RBC_MGR(manager), RBC(manager, f),
+                                vars, num, rbc_defs);
+
+  for (i = 0; i < num; ++i) {
+    defs[i] = (rbc_defs[i] != (Rbc_t*) NULL) ?
+      BE(manager, rbc_defs[i]) : (be_ptr) NULL;
+  }
+
+  FREE(rbc_defs);
+  return BE(manager, rest);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Compiles the given formulae for bit-parallel simulation]
+
+  Description [The returned structure evaluates the num formulae in fs
+  on Be_Sim_GetWords() * 64 patterns at a time (see Be_Sim_Run), and
+  must be deleted with Be_Sim_Delete.]
+
+  SideEffects []
+
+  SeeAlso     [Be_Sim_Run, Be_Sim_Delete]
+
+******************************************************************************/
+Be_Sim_ptr Be_Sim_Create(Be_Manager_ptr manager, be_ptr* fs, int num)
+{
+  Rbc_t** roots = ALLOC(Rbc_t*, (num > 0) ? num : 1);
+  Rbc_Sim_t* sim;
+  int i;
+
+  for (i = 0; i < num; ++i) roots[i] = RBC(manager, fs[i]);
+  sim = Rbc_SimCreate(GET_RBC_MGR(manager), roots, num);
+  FREE(roots);
+
+  return (Be_Sim_ptr) sim;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Deletes a structure created by Be_Sim_Create]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Be_Sim_Create]
+
+******************************************************************************/
+void Be_Sim_Delete(Be_Sim_ptr sim)
+{
+  Rbc_SimDestroy((Rbc_Sim_t*) sim);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of 64-bit words Be_Sim_Run evaluates
+  at a time]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Be_Sim_Run]
+
+******************************************************************************/
+int Be_Sim_GetWords()
+{
+  return RBC_SIM_WORDS;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Evaluates formulae compiled by Be_Sim_Create]
+
+  Description [vars holds Be_Sim_GetWords() words for every variable
+  index, the words of the variable of index i starting at
+  vars[i * Be_Sim_GetWords()]. The words of the k-th formula are stored
+  at out[k * Be_Sim_GetWords()].]
+
+  SideEffects [out is filled]
+
+  SeeAlso     [Be_Sim_Create]
+
+******************************************************************************/
+void Be_Sim_Run(Be_Sim_ptr sim, const unsigned long long* vars,
+                unsigned long long* out)
+{
+  Rbc_SimRun((Rbc_Sim_t*) sim, vars, out);
+}
+
+
 /*---------------------------------------------------------------------------*/
 /* Definitions of internal functions                                         */
 /*---------------------------------------------------------------------------*/
@@ -985,3 +1449,22 @@ static be_ptr beRbc_Rbc2Be(Be_Manager_ptr mgr, void* rbc)
 {
   return (be_ptr) rbc;
 }
+
+
+/**Function********************************************************************
+
+  Synopsis    [Calls the be prover of a sweeping on rbcs]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Be_Sweep]
+
+******************************************************************************/
+static boolean beRbc_sweep_prover(Rbc_t* a, Rbc_t* b, void* data)
+{
+  BeRbcSweepProver* sp = (BeRbcSweepProver*) data;
+
+  return sp->prover(sp->mgr, BE(sp->mgr, a), BE(sp->mgr, b), sp->data);
+}
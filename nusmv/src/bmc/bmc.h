@@ -72,9 +72,13 @@
 #define BMC_PB_LENGTH      "bmc_length"
 #define BMC_PB_LOOP        "bmc_loopback"
 #define BMC_INVAR_ALG        "bmc_invar_alg"
+#define BMC_PARALLEL_BOUNDS  "bmc_parallel_bounds"
 
 #if NUSMV_HAVE_INCREMENTAL_SAT
 #define BMC_INC_INVAR_ALG        "bmc_inc_invar_alg"
+#define BMC_PORTFOLIO_SIZE       "bmc_portfolio_size"
+#define BMC_PORTFOLIO_SHARE_UNITS "bmc_portfolio_share_units"
+#define BMC_SWEEPING             "bmc_sweeping"
 #endif
 
 #define BMC_OPTIMIZED_TABLEAU "bmc_optimized_tableau"
@@ -154,9 +158,19 @@ EXTERN void set_bmc_pb_loop  ARGS((OptsHandler_ptr opt, const char* loop));
 EXTERN const char* get_bmc_pb_loop ARGS((OptsHandler_ptr));
 EXTERN void set_bmc_invar_alg ARGS((OptsHandler_ptr opt, const char* loop));
 EXTERN const char* get_bmc_invar_alg ARGS((OptsHandler_ptr));
+EXTERN void set_bmc_parallel_bounds ARGS((OptsHandler_ptr opt, const int n));
+EXTERN int get_bmc_parallel_bounds ARGS((OptsHandler_ptr));
 #if NUSMV_HAVE_INCREMENTAL_SAT
 EXTERN void set_bmc_inc_invar_alg ARGS((OptsHandler_ptr opt, const char* loop));
 EXTERN const char* get_bmc_inc_invar_alg ARGS((OptsHandler_ptr));
+EXTERN void set_bmc_portfolio_size ARGS((OptsHandler_ptr opt, const int size));
+EXTERN int get_bmc_portfolio_size ARGS((OptsHandler_ptr));
+EXTERN void set_bmc_portfolio_share_units ARGS((OptsHandler_ptr));
+EXTERN void unset_bmc_portfolio_share_units ARGS((OptsHandler_ptr));
+EXTERN boolean opt_bmc_portfolio_share_units ARGS((OptsHandler_ptr));
+EXTERN void set_bmc_sweeping ARGS((OptsHandler_ptr));
+EXTERN void unset_bmc_sweeping ARGS((OptsHandler_ptr));
+EXTERN boolean opt_bmc_sweeping ARGS((OptsHandler_ptr));
 #endif
 EXTERN void set_bmc_optimized_tableau ARGS((OptsHandler_ptr));
 EXTERN void unset_bmc_optimized_tableau ARGS((OptsHandler_ptr));
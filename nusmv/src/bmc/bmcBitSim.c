@@ -0,0 +1,780 @@
+/**CFile***********************************************************************
+
+  FileName    [bmcBitSim.c]
+
+  PackageName [bmc]
+
+  Synopsis    [Bit-parallel random simulation]
+
+  Description [The boolean encoding of the model (the BE fsm) is
+  compiled once into flat programs (see Be_Sim_Create), which compute
+  Be_Sim_GetWords() * 64 random runs of the model (the lanes) at a
+  time.
+
+  The transition relation is split by Be_ExtractDefinitions into the
+  functions of the next state variables it defines, and a residual
+  constraint. At every step the input variables and the next state
+  variables which are not defined are chosen at random, the defined
+  ones are computed, and the lanes that violate the residual
+  constraint or the invariants are dropped. The initial states are
+  generated the same way out of the init formula.
+
+  The unchecked invariants of the property database are evaluated on
+  every state reached by a live lane. When an invariant is violated,
+  the run of the first violating lane is played again to build the
+  counterexample: runs are generated out of a seed, so they need not
+  be recorded.]
+
+  SeeAlso     [bmcSimulate.c, rbcSim.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``bmc'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#include "bmcBitSim.h"
+#include "bmcInt.h"
+#include "bmcConv.h"
+
+#include "wff/wff.h"
+#include "wff/w2w/w2w.h"
+
+#include "enc/be/BeEnc.h"
+#include "enc/enc.h"
+#include "be/be.h"
+
+#include "mc/mc.h" /* for print_invar */
+#include "prop/propPkg.h"
+
+#include "trace/Trace.h"
+#include "trace/TraceManager.h"
+
+#include "utils/error.h"
+#include "utils/Slist.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: bmcBitSim.c,v 1.1.2.1 2011-03-08 10:00:00 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+#define BMC_BITSIM_TRACE_DESCRIPTION "Bit-parallel Simulation Counterexample"
+
+/* The seed of the first pass */
+#define BMC_BITSIM_SEED 0x2545F4914F6CDD1DULL
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+typedef struct BmcBitSim_TAG* BmcBitSim_ptr;
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [The compiled model]
+
+  Description [vals holds the words of every untimed variable, indexed
+  by variable index. state[i] and next[i] are the indices of the i-th
+  state variable and of its next. init_def_vars and trans_def_vars are
+  the variables computed by the programs init_defs and trans_defs, in
+  the order of their roots. state_check computes the invariant
+  followed by the properties. found_step and found_lane tell where
+  every property has been violated during the last pass (-1 if it has
+  not).]
+
+******************************************************************************/
+typedef struct BmcBitSim_TAG {
+  BeEnc_ptr be_enc;
+  Be_Manager_ptr be_mgr;
+  int words;
+
+  int vars_num;
+  unsigned long long* vals;
+  unsigned long long* out;
+  unsigned long long* alive;
+
+  int* state;
+  int* next;
+  int state_num;
+  int* frozen;
+  int frozen_num;
+  int* inputs;
+  int inputs_num;
+
+  Be_Sim_ptr init_defs;
+  int* init_def_vars;
+  int init_defs_num;
+  Be_Sim_ptr init_check;
+
+  Be_Sim_ptr trans_defs;
+  int* trans_def_vars;
+  int trans_defs_num;
+  Be_Sim_ptr trans_check;
+
+  Be_Sim_ptr state_check;
+  int props_num;
+  boolean* done;
+  int* found_step;
+  int* found_lane;
+
+  unsigned long long seed;
+} BmcBitSim;
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+#define BITSIM_VAL(bs, idx) ((bs)->vals + (bs)->words * (idx))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static BmcBitSim_ptr
+bmc_bitsim_create ARGS((BeFsm_ptr be_fsm, be_ptr* props, int props_num));
+
+static void bmc_bitsim_destroy ARGS((BmcBitSim_ptr self));
+
+static int
+bmc_bitsim_collect_vars ARGS((BeEnc_ptr be_enc, BeVarType type,
+                              int** vars));
+
+static Be_Sim_ptr
+bmc_bitsim_compile_defs ARGS((BmcBitSim_ptr self, be_ptr* f,
+                              const int* vars, int num,
+                              int** def_vars, int* defs_num));
+
+static int
+bmc_bitsim_run ARGS((BmcBitSim_ptr self, unsigned long long seed,
+                     int steps, int lane, Slist_ptr model));
+
+static void
+bmc_bitsim_randomize ARGS((BmcBitSim_ptr self, const int* vars, int num));
+
+static void
+bmc_bitsim_assign ARGS((BmcBitSim_ptr self, Be_Sim_ptr defs,
+                        const int* vars, int num));
+
+static boolean bmc_bitsim_filter ARGS((BmcBitSim_ptr self));
+
+static void
+bmc_bitsim_record ARGS((BmcBitSim_ptr self, const int* vars, int num,
+                        int time, int lane, Slist_ptr model));
+
+static unsigned long long bmc_bitsim_random ARGS((BmcBitSim_ptr self));
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Looks for violations of the invariants by bit-parallel
+  random simulation]
+
+  Description [Performs the given number of passes, each of them
+  simulating Be_Sim_GetWords() * 64 random runs of at most steps steps
+  from random initial states. The unchecked invariants of the property
+  database which do not need rewriting are checked on every reached
+  state: the ones that are violated are reported false, with a
+  counterexample when counterexamples are enabled. Nothing is said
+  about the other ones. Returns 0.]
+
+  SideEffects [The status and the trace of the violated invariants are
+  set]
+
+  SeeAlso     []
+
+******************************************************************************/
+int Bmc_BitSimulate(BeFsm_ptr be_fsm, int steps, int passes)
+{
+  PropDb_ptr db = PropPkg_get_prop_database();
+  BeEnc_ptr be_enc = BeFsm_get_be_encoding(be_fsm);
+  BddEnc_ptr bdd_enc = Enc_get_bdd_encoding();
+  BmcBitSim_ptr bs;
+  lsList props;
+  lsGen iterator;
+  Prop_ptr prop;
+  Prop_ptr* checked;
+  be_ptr* exprs;
+  int checked_num, falsified, pass, i;
+  double lane_steps = 0.0;
+  long start_time = util_cpu_time();
+
+  /* collects the invariants that can be checked on single states */
+  props = PropDb_get_props_of_type(db, Prop_Invar);
+  nusmv_assert(props != LS_NIL);
+
+  checked = ALLOC(Prop_ptr, lsLength(props) + 1);
+  exprs = ALLOC(be_ptr, lsLength(props) + 1);
+  checked_num = 0;
+  lsForEachItem(props, iterator, prop) {
+    node_ptr binvarspec;
+
+    if (Prop_get_status(prop) != Prop_Unchecked ||
+        Prop_needs_rewriting(prop)) continue;
+
+    binvarspec = Wff2Nnf(Compile_detexpr2bexpr(bdd_enc,
+                                               Prop_get_expr_core(prop)));
+    checked[checked_num] = prop;
+    exprs[checked_num] = Bmc_Conv_Bexp2Be(be_enc, binvarspec);
+    ++checked_num;
+  }
+  lsDestroy(props, NULL);
+
+  bs = bmc_bitsim_create(be_fsm, exprs, checked_num);
+
+  fprintf(nusmv_stdout,
+          "********  Bit-parallel Simulation: %d passes of %d runs "
+          "of %d steps  ********\n", passes, bs->words * 64, steps);
+
+  falsified = 0;
+  for (pass = 0; pass < passes && falsified < checked_num; ++pass) {
+    const unsigned long long seed =
+      BMC_BITSIM_SEED ^ ((unsigned long long) pass * 0x9E3779B97F4A7C15ULL);
+    int done_steps = bmc_bitsim_run(bs, seed, steps, -1, SLIST(NULL));
+
+    lane_steps += (double) done_steps * bs->words * 64;
+
+    for (i = 0; i < checked_num; ++i) {
+      if (bs->found_step[i] < 0) continue;
+
+      bs->done[i] = true;
+      ++falsified;
+
+      fprintf(nusmv_stdout, "-- ");
+      print_invar(nusmv_stdout, checked[i]);
+      fprintf(nusmv_stdout, "  is false\n");
+      Prop_set_status(checked[i], Prop_False);
+
+      if (opt_counter_examples(OptsHandler_get_instance())) {
+        BoolSexpFsm_ptr bsexp_fsm = PropDb_master_get_bool_sexp_fsm(db);
+        Slist_ptr model = Slist_create();
+        Trace_ptr trace;
+
+        BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
+
+        /* the run of the violating lane is played again */
+        bmc_bitsim_run(bs, seed, bs->found_step[i], bs->found_lane[i], model);
+        trace = Bmc_create_trace_from_be_model(be_enc,
+                    SexpFsm_get_symbols_list(SEXP_FSM(bsexp_fsm)),
+                    BMC_BITSIM_TRACE_DESCRIPTION, TRACE_TYPE_CNTEXAMPLE,
+                    model, bs->found_step[i]);
+        Slist_destroy(model);
+
+        fprintf(nusmv_stdout,
+                "-- as demonstrated by the following execution sequence\n");
+
+        TraceManager_register_trace(global_trace_manager, trace);
+        TraceManager_execute_plugin(global_trace_manager, TRACE_OPT(NULL),
+                                    TRACE_MANAGER_DEFAULT_PLUGIN,
+                                    TRACE_MANAGER_LAST_TRACE);
+
+        Prop_set_trace(checked[i], Trace_get_id(trace));
+      }
+    }
+  }
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    const double secs = (double) (util_cpu_time() - start_time) / 1000.0;
+
+    fprintf(nusmv_stderr,
+            "Bit-parallel simulation: %d passes, %.0f steps of single runs "
+            "in %.2f s", pass, lane_steps, secs);
+    if (secs > 0.0) {
+      fprintf(nusmv_stderr, " (%.0f steps/s)", lane_steps / secs);
+    }
+    fprintf(nusmv_stderr, ", %d of %d invariants violated\n",
+            falsified, checked_num);
+  }
+
+  bmc_bitsim_destroy(bs);
+  FREE(exprs);
+  FREE(checked);
+
+  return 0;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Compiles the given BE fsm and properties]
+
+  Description [props are untimed expressions over the current state
+  variables]
+
+  SideEffects []
+
+  SeeAlso     [bmc_bitsim_destroy]
+
+******************************************************************************/
+static BmcBitSim_ptr bmc_bitsim_create(BeFsm_ptr be_fsm, be_ptr* props,
+                                       int props_num)
+{
+  BmcBitSim_ptr self = ALLOC(BmcBitSim, 1);
+  be_ptr init = BeFsm_get_init(be_fsm);
+  be_ptr trans = BeFsm_get_trans(be_fsm);
+  be_ptr* roots;
+  int* init_vars;
+  int i, max_index;
+
+  nusmv_assert(self != (BmcBitSim_ptr) NULL);
+
+  self->be_enc = BeFsm_get_be_encoding(be_fsm);
+  self->be_mgr = BeEnc_get_be_manager(self->be_enc);
+  self->words = Be_Sim_GetWords();
+
+  self->state_num = bmc_bitsim_collect_vars(self->be_enc, BE_VAR_TYPE_CURR,
+                                            &self->state);
+  self->frozen_num = bmc_bitsim_collect_vars(self->be_enc, BE_VAR_TYPE_FROZEN,
+                                             &self->frozen);
+  self->inputs_num = bmc_bitsim_collect_vars(self->be_enc, BE_VAR_TYPE_INPUT,
+                                             &self->inputs);
+
+  max_index = 0;
+  self->next = ALLOC(int, self->state_num + 1);
+  for (i = 0; i < self->state_num; ++i) {
+    be_ptr next =
+      BeEnc_var_curr_to_next(self->be_enc,
+                             BeEnc_index_to_var(self->be_enc, self->state[i]));
+    self->next[i] = Be_Var2Index(self->be_mgr, next);
+    if (self->next[i] > max_index) max_index = self->next[i];
+    if (self->state[i] > max_index) max_index = self->state[i];
+  }
+  for (i = 0; i < self->frozen_num; ++i) {
+    if (self->frozen[i] > max_index) max_index = self->frozen[i];
+  }
+  for (i = 0; i < self->inputs_num; ++i) {
+    if (self->inputs[i] > max_index) max_index = self->inputs[i];
+  }
+
+  self->vars_num = max_index + 1;
+  self->vals = ALLOC(unsigned long long, self->vars_num * self->words);
+  for (i = 0; i < self->vars_num * self->words; ++i) self->vals[i] = 0ULL;
+  self->alive = ALLOC(unsigned long long, self->words);
+
+  /* initial states: both state and frozen variables can be defined */
+  init_vars = ALLOC(int, self->state_num + self->frozen_num + 1);
+  for (i = 0; i < self->state_num; ++i) init_vars[i] = self->state[i];
+  for (i = 0; i < self->frozen_num; ++i) {
+    init_vars[self->state_num + i] = self->frozen[i];
+  }
+  self->init_defs =
+    bmc_bitsim_compile_defs(self, &init, init_vars,
+                            self->state_num + self->frozen_num,
+                            &self->init_def_vars, &self->init_defs_num);
+  FREE(init_vars);
+  self->init_check = Be_Sim_Create(self->be_mgr, &init, 1);
+
+  /* transitions: next state variables can be defined */
+  self->trans_defs =
+    bmc_bitsim_compile_defs(self, &trans, self->next, self->state_num,
+                            &self->trans_def_vars, &self->trans_defs_num);
+  self->trans_check = Be_Sim_Create(self->be_mgr, &trans, 1);
+
+  /* states: the invariant, followed by the properties */
+  self->props_num = props_num;
+  roots = ALLOC(be_ptr, props_num + 1);
+  roots[0] = BeFsm_get_invar(be_fsm);
+  for (i = 0; i < props_num; ++i) roots[i + 1] = props[i];
+  self->state_check = Be_Sim_Create(self->be_mgr, roots, props_num + 1);
+  FREE(roots);
+
+  {
+    int out_num = props_num + 1;
+    if (self->init_defs_num > out_num) out_num = self->init_defs_num;
+    if (self->trans_defs_num > out_num) out_num = self->trans_defs_num;
+    self->out = ALLOC(unsigned long long, out_num * self->words);
+  }
+
+  self->done = ALLOC(boolean, props_num + 1);
+  self->found_step = ALLOC(int, props_num + 1);
+  self->found_lane = ALLOC(int, props_num + 1);
+  for (i = 0; i < props_num; ++i) self->done[i] = false;
+
+  return self;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Frees a structure built by bmc_bitsim_create]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [bmc_bitsim_create]
+
+******************************************************************************/
+static void bmc_bitsim_destroy(BmcBitSim_ptr self)
+{
+  Be_Sim_Delete(self->state_check);
+  Be_Sim_Delete(self->trans_check);
+  Be_Sim_Delete(self->trans_defs);
+  Be_Sim_Delete(self->init_check);
+  Be_Sim_Delete(self->init_defs);
+
+  FREE(self->found_lane);
+  FREE(self->found_step);
+  FREE(self->done);
+  FREE(self->trans_def_vars);
+  FREE(self->init_def_vars);
+  FREE(self->out);
+  FREE(self->alive);
+  FREE(self->vals);
+  FREE(self->inputs);
+  FREE(self->frozen);
+  FREE(self->next);
+  FREE(self->state);
+  FREE(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Collects the indices of the untimed variables of the
+  given type]
+
+  Description [Returns their number. *vars must be freed by the
+  caller.]
+
+  SideEffects [*vars is allocated]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int bmc_bitsim_collect_vars(BeEnc_ptr be_enc, BeVarType type,
+                                   int** vars)
+{
+  int num = 0;
+  int capacity = 16;
+  int idx;
+
+  *vars = ALLOC(int, capacity);
+  for (idx = BeEnc_get_first_untimed_var_index(be_enc, type);
+       BeEnc_is_var_index_valid(be_enc, idx);
+       idx = BeEnc_get_next_var_index(be_enc, idx, type)) {
+    if (num == capacity) {
+      capacity *= 2;
+      *vars = REALLOC(int, *vars, capacity);
+    }
+    (*vars)[num++] = idx;
+  }
+
+  return num;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Compiles the definitions of the given variables]
+
+  Description [The definitions are extracted from *f, which is replaced
+  by the residual constraint. The defined variables are stored into
+  *def_vars (to be freed by the caller), in the order of the roots of
+  the returned program.]
+
+  SideEffects [*f is changed, *def_vars is allocated]
+
+  SeeAlso     [Be_ExtractDefinitions]
+
+******************************************************************************/
+static Be_Sim_ptr bmc_bitsim_compile_defs(BmcBitSim_ptr self, be_ptr* f,
+                                          const int* vars, int num,
+                                          int** def_vars, int* defs_num)
+{
+  be_ptr* defs = ALLOC(be_ptr, num + 1);
+  Be_Sim_ptr sim;
+  int i, n;
+
+  *f = Be_ExtractDefinitions(self->be_mgr, *f, vars, num, defs);
+
+  *def_vars = ALLOC(int, num + 1);
+  for (i = 0, n = 0; i < num; ++i) {
+    if (defs[i] == (be_ptr) NULL) continue;
+    (*def_vars)[n] = vars[i];
+    defs[n] = defs[i];
+    ++n;
+  }
+  *defs_num = n;
+
+  sim = Be_Sim_Create(self->be_mgr, defs, n);
+  FREE(defs);
+
+  return sim;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Performs a pass of simulation]
+
+  Description [The pass is fully determined by seed. If lane is -1,
+  the runs go on for at most steps steps, or until all of them are
+  dropped or all the properties have been violated; found_step and
+  found_lane are set. Otherwise they are left untouched, and the
+  literals of the variables of the given lane up to the given step are
+  appended to model, as BE literals of timed (and frozen) variables.
+  Returns the number of performed steps.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int bmc_bitsim_run(BmcBitSim_ptr self, unsigned long long seed,
+                          int steps, int lane, Slist_ptr model)
+{
+  int t, i, w, left;
+
+  self->seed = seed;
+  if (lane < 0) {
+    for (i = 0; i < self->props_num; ++i) {
+      self->found_step[i] = -1;
+      self->found_lane[i] = -1;
+    }
+  }
+  for (w = 0; w < self->words; ++w) self->alive[w] = ~0ULL;
+
+  /* the initial states */
+  bmc_bitsim_randomize(self, self->state, self->state_num);
+  bmc_bitsim_randomize(self, self->frozen, self->frozen_num);
+  bmc_bitsim_assign(self, self->init_defs, self->init_def_vars,
+                    self->init_defs_num);
+  Be_Sim_Run(self->init_check, self->vals, self->out);
+  bmc_bitsim_filter(self);
+
+  if (lane >= 0) {
+    bmc_bitsim_record(self, self->frozen, self->frozen_num, -1, lane, model);
+  }
+
+  left = 0;
+  for (i = 0; i < self->props_num; ++i) if (!self->done[i]) ++left;
+
+  for (t = 0; ; ++t) {
+    Be_Sim_Run(self->state_check, self->vals, self->out);
+    if (!bmc_bitsim_filter(self)) break;
+
+    if (lane >= 0) {
+      bmc_bitsim_record(self, self->state, self->state_num, t, lane, model);
+    }
+    else {
+      for (i = 0; i < self->props_num; ++i) {
+        const unsigned long long* p = self->out + (i + 1) * self->words;
+
+        if (self->done[i] || self->found_step[i] >= 0) continue;
+
+        for (w = 0; w < self->words; ++w) {
+          const unsigned long long bad = self->alive[w] & ~p[w];
+
+          if (bad != 0ULL) {
+            int b = 0;
+            while (((bad >> b) & 1ULL) == 0ULL) ++b;
+            self->found_step[i] = t;
+            self->found_lane[i] = 64 * w + b;
+            --left;
+            break;
+          }
+        }
+      }
+      if (self->props_num > 0 && left == 0) break;
+    }
+
+    if (t == steps) break;
+
+    /* the transition */
+    bmc_bitsim_randomize(self, self->inputs, self->inputs_num);
+    bmc_bitsim_randomize(self, self->next, self->state_num);
+    bmc_bitsim_assign(self, self->trans_defs, self->trans_def_vars,
+                      self->trans_defs_num);
+    Be_Sim_Run(self->trans_check, self->vals, self->out);
+    if (!bmc_bitsim_filter(self)) break;
+
+    if (lane >= 0) {
+      bmc_bitsim_record(self, self->inputs, self->inputs_num, t, lane, model);
+    }
+
+    for (i = 0; i < self->state_num; ++i) {
+      const unsigned long long* n = BITSIM_VAL(self, self->next[i]);
+      unsigned long long* s = BITSIM_VAL(self, self->state[i]);
+      for (w = 0; w < self->words; ++w) s[w] = n[w];
+    }
+  }
+
+  return t;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Assigns random values to the given variables]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void bmc_bitsim_randomize(BmcBitSim_ptr self, const int* vars, int num)
+{
+  int i, w;
+
+  for (i = 0; i < num; ++i) {
+    unsigned long long* v = BITSIM_VAL(self, vars[i]);
+    for (w = 0; w < self->words; ++w) v[w] = bmc_bitsim_random(self);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Assigns the variables computed by the given definitions]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void bmc_bitsim_assign(BmcBitSim_ptr self, Be_Sim_ptr defs,
+                              const int* vars, int num)
+{
+  int i, w;
+
+  if (num == 0) return;
+
+  Be_Sim_Run(defs, self->vals, self->out);
+  for (i = 0; i < num; ++i) {
+    unsigned long long* v = BITSIM_VAL(self, vars[i]);
+    for (w = 0; w < self->words; ++w) v[w] = self->out[i * self->words + w];
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Drops the lanes which falsify the first output of the last
+  evaluated program]
+
+  Description [Returns false if no lane is left]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean bmc_bitsim_filter(BmcBitSim_ptr self)
+{
+  const unsigned long long* r = self->out;
+  unsigned long long any = 0ULL;
+  int w;
+
+  for (w = 0; w < self->words; ++w) {
+    self->alive[w] &= r[w];
+    any |= self->alive[w];
+  }
+
+  return any != 0ULL;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Appends the values of the given variables in the given
+  lane to model]
+
+  Description [time is -1 for frozen variables]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void bmc_bitsim_record(BmcBitSim_ptr self, const int* vars, int num,
+                              int time, int lane, Slist_ptr model)
+{
+  int i;
+
+  for (i = 0; i < num; ++i) {
+    const unsigned long long* v = BITSIM_VAL(self, vars[i]);
+    be_ptr var = (time < 0) ? BeEnc_index_to_var(self->be_enc, vars[i])
+      : BeEnc_index_to_timed(self->be_enc, vars[i], time);
+    int lit = Be_BeIndex2BeLiteral(self->be_mgr,
+                                   Be_Var2Index(self->be_mgr, var));
+
+    if (((v[lane / 64] >> (lane % 64)) & 1ULL) == 0ULL) {
+      lit = Be_BeLiteral_Negate(self->be_mgr, lit);
+    }
+    Slist_push(model, (void*) (nusmv_ptrint) lit);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the next pseudo-random number]
+
+  Description [xorshift64*]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static unsigned long long bmc_bitsim_random(BmcBitSim_ptr self)
+{
+  self->seed ^= self->seed >> 12;
+  self->seed ^= self->seed << 25;
+  self->seed ^= self->seed >> 27;
+  return self->seed * 2685821657736338717ULL;
+}
@@ -0,0 +1,85 @@
+/**CHeaderFile*****************************************************************
+
+  FileName    [bmcBitSim.h]
+
+  PackageName [bmc]
+
+  Synopsis    [Bit-parallel random simulation]
+
+  Description [Bit-parallel random simulation of the boolean encoding
+  of the model]
+
+  SeeAlso     [bmcBitSim.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``bmc'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+  Revision    [$Id: bmcBitSim.h,v 1.1.2.1 2011-03-08 10:00:00 nusmv Exp $]
+
+******************************************************************************/
+
+#ifndef _BMC_BIT_SIM__H
+#define _BMC_BIT_SIM__H
+
+#include "utils/utils.h"
+#include "fsm/be/BeFsm.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+EXTERN int Bmc_BitSimulate ARGS((BeFsm_ptr be_fsm, int steps, int passes));
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* _BMC_BIT_SIM__H */
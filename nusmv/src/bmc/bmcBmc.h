@@ -148,6 +148,11 @@ EXTERN int Bmc_GenSolveInvarDual ARGS((Prop_ptr invarprop, const int max_k,
 EXTERN int Bmc_GenSolveInvarFalsification ARGS((Prop_ptr invarprop,
                                                 const int max_k));
 
+EXTERN int Bmc_GenSolveInvarItp ARGS((Prop_ptr invarprop, const int max_k));
+
+EXTERN int Bmc_GenSolveInvarIc3 ARGS((Prop_ptr invarprop, const int max_k,
+                                      const char* invar_file));
+
 EXTERN int Bmc_check_psl_property ARGS((Prop_ptr prop,
                                         boolean dump_prob,
                                         boolean inc_sat,
@@ -67,6 +67,7 @@
 #include "sat/sat.h" /* for solver and result */
 #include "sat/SatSolver.h"
 #include "sat/SatIncSolver.h"
+#include "utils/Profile.h"
 
 static char rcsid[] UTIL_UNUSED = "$Id: bmcBmcInc.c,v 1.1.2.17.2.14.4.19 2010-02-18 10:00:02 nusmv Exp $";
 
@@ -111,10 +112,34 @@ bmc_add_be_into_solver_positively ARGS((SatSolver_ptr solver,
                                         SatSolverGroup group,
                                         be_ptr prob, BeEnc_ptr be_enc));
 
+inline static void
+bmc_add_new_be_into_solver_positively ARGS((SatSolver_ptr solver,
+                                            SatSolverGroup group,
+                                            be_ptr prob, BeEnc_ptr be_enc));
+
 static be_ptr
 bmc_build_uniqueness(const BeFsm_ptr be_fsm, const lsList state_vars,
                      const int init_state, const int last_state);
 
+static int bmc_gen_solve_ltl_inc ARGS((Prop_ptr ltlprop,
+                                       const int k,
+                                       const int relative_loop,
+                                       const boolean must_inc_length));
+static int bmc_gen_solve_invar_zigzag ARGS((Prop_ptr invarprop,
+                                            const int max_k));
+static int bmc_gen_solve_invar_dual ARGS((Prop_ptr invarprop,
+                                          const int max_k,
+                                          bmc_invar_closure_strategy strategy));
+static int bmc_gen_solve_invar_falsification ARGS((Prop_ptr invarprop,
+                                                   const int max_k));
+
+static SatSolverResult
+bmc_inc_solve_all_groups ARGS((SatIncSolver_ptr solver));
+static SatSolverResult
+bmc_inc_solve_without_groups ARGS((SatIncSolver_ptr solver,
+                                   Olist_ptr groups));
+static void bmc_inc_portfolio_report ARGS((void));
+
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -140,10 +165,39 @@ bmc_build_uniqueness(const BeFsm_ptr be_fsm, const lsList state_vars,
 int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
                        const int k, const int relative_loop,
                        const boolean must_inc_length)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_ltl_inc");
+  Sat_PortfolioResetStats();
+  res = bmc_gen_solve_ltl_inc(ltlprop, k, relative_loop, must_inc_length);
+  bmc_inc_portfolio_report();
+  Profile_end("bmc_gen_solve_ltl_inc");
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveLtlInc]
+
+  Description        [See Bmc_GenSolveLtlInc]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveLtlInc]
+
+******************************************************************************/
+static int bmc_gen_solve_ltl_inc(Prop_ptr ltlprop,
+                                 const int k,
+                                 const int relative_loop,
+                                 const boolean must_inc_length)
 {
   node_ptr bltlspec;  /* Its booleanization */
   BeFsm_ptr be_fsm = BE_FSM(NULL); /* The corresponding be fsm */
   BeEnc_ptr be_enc;
+  Be_Manager_ptr be_mgr;
   /* sat solver instance */
   SatIncSolver_ptr solver;
   be_ptr beProb; /* A problem in BE format */
@@ -182,6 +236,11 @@ int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
   BE_FSM_CHECK_INSTANCE(be_fsm);
 
   be_enc = BeFsm_get_be_encoding(be_fsm);
+  be_mgr = BeEnc_get_be_manager(be_enc);
+
+  /* The clauses of a sub-formula are given to the solver only once along
+     the bounds: nothing is known about this new solver */
+  Be_ResetCnfEmitted(be_mgr);
 
   /* Booleanizes, negates and NNFs the LTL formula: */
   bltlspec =
@@ -190,7 +249,7 @@ int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
 
   /* insert initial conditions into the sat solver permanently */
   beInit = Bmc_Model_GetInit0(be_fsm);
-  bmc_add_be_into_solver_positively(SAT_SOLVER(solver),
+  bmc_add_new_be_into_solver_positively(SAT_SOLVER(solver),
                            SatSolver_get_permanent_group(SAT_SOLVER(solver)),
                            beInit, be_enc);
 
@@ -202,6 +261,7 @@ int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
      /* additional group in sat solver */
     SatSolverGroup additionalGroup = SatIncSolver_create_group(solver);
     SatSolverResult satResult;
+    int clauses0, reused0, clauses1, reused1; /* conversion statistics */
 
     /* the loopback value could be depending on the length
        if it were relative: */
@@ -240,13 +300,15 @@ int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
       continue;
     }
 
+    Be_GetCnfStats(be_mgr, &clauses0, &reused0);
+
     /* Unroll the transition relation to the fixed frame 0 */
     if (previousIncreasingK < increasingK) {
       beProb = Bmc_Model_GetUnrolling(be_fsm,
                                       previousIncreasingK,
                                       increasingK);
 
-      bmc_add_be_into_solver_positively(SAT_SOLVER(solver),
+      bmc_add_new_be_into_solver_positively(SAT_SOLVER(solver),
                          SatSolver_get_permanent_group(SAT_SOLVER(solver)),
                                         beProb, be_enc);
       previousIncreasingK = increasingK;
@@ -254,11 +316,19 @@ int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
 
     /* add LTL tableau to an additional group of a solver */
     beProb = Bmc_Tableau_GetLtlTableau(be_fsm, bltlspec, increasingK, l);
-    bmc_add_be_into_solver_positively(SAT_SOLVER(solver),
-                                       additionalGroup,
-                                       beProb, be_enc);
+    bmc_add_new_be_into_solver_positively(SAT_SOLVER(solver),
+                                          additionalGroup,
+                                          beProb, be_enc);
 
-    satResult = SatSolver_solve_all_groups(SAT_SOLVER(solver));
+    Be_GetCnfStats(be_mgr, &clauses1, &reused1);
+    if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+      fprintf(nusmv_stderr,
+              "Clauses emitted for bound %d: %d "
+              "(%d sub-formulae already emitted were reused)\n",
+              increasingK, clauses1 - clauses0, reused1 - reused0);
+    }
+
+    satResult = bmc_inc_solve_all_groups(solver);
 
 
     /* Processes the result: */
@@ -354,6 +424,7 @@ int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
 
   /* destroy the sat solver instance */
   SatIncSolver_destroy(solver);
+  Be_ResetCnfEmitted(be_mgr);
   return 0;
 }
 
@@ -372,7 +443,34 @@ int Bmc_GenSolveLtlInc(Prop_ptr ltlprop,
 
 ******************************************************************************/
 
-int Bmc_GenSolveInvarZigzag(Prop_ptr invarprop, const int max_k)
+int Bmc_GenSolveInvarZigzag(Prop_ptr invarprop,
+                            const int max_k)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_invar_zigzag");
+  Sat_PortfolioResetStats();
+  res = bmc_gen_solve_invar_zigzag(invarprop, max_k);
+  bmc_inc_portfolio_report();
+  Profile_end("bmc_gen_solve_invar_zigzag");
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveInvarZigzag]
+
+  Description        [See Bmc_GenSolveInvarZigzag]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveInvarZigzag]
+
+******************************************************************************/
+static int bmc_gen_solve_invar_zigzag(Prop_ptr invarprop,
+                                      const int max_k)
 {
   node_ptr binvarspec;  /* Its booleanization */
   BeFsm_ptr be_fsm; /* The corresponding be fsm */
@@ -530,7 +628,7 @@ int Bmc_GenSolveInvarZigzag(Prop_ptr invarprop, const int max_k)
                              additionalGroup);
 
       /* SOLVE (withtout the initial state) */
-      satResult = SatIncSolver_solve_without_groups(solver, group_list_init);
+      satResult = bmc_inc_solve_without_groups(solver, group_list_init);
 
       /* Result processing: */
       switch (satResult) {
@@ -579,7 +677,7 @@ int Bmc_GenSolveInvarZigzag(Prop_ptr invarprop, const int max_k)
       }
 
       /* SOLVE with initial states CNF */
-      satResult = SatSolver_solve_all_groups(SAT_SOLVER(solver));
+      satResult = bmc_inc_solve_all_groups(solver);
 
       /* Processes the result: */
       switch (satResult) {
@@ -731,8 +829,36 @@ int Bmc_GenSolveInvarZigzag(Prop_ptr invarprop, const int max_k)
   SeeAlso            []
 
 ******************************************************************************/
-int Bmc_GenSolveInvarDual(Prop_ptr invarprop, const int max_k,
+int Bmc_GenSolveInvarDual(Prop_ptr invarprop,
+                          const int max_k,
                           bmc_invar_closure_strategy strategy)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_invar_dual");
+  Sat_PortfolioResetStats();
+  res = bmc_gen_solve_invar_dual(invarprop, max_k, strategy);
+  bmc_inc_portfolio_report();
+  Profile_end("bmc_gen_solve_invar_dual");
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveInvarDual]
+
+  Description        [See Bmc_GenSolveInvarDual]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveInvarDual]
+
+******************************************************************************/
+static int bmc_gen_solve_invar_dual(Prop_ptr invarprop,
+                                    const int max_k,
+                                    bmc_invar_closure_strategy strategy)
 {
   node_ptr binvarspec;  /* Its booleanization */
   be_ptr be_invar;  /* Its BE representation */
@@ -961,7 +1087,7 @@ int Bmc_GenSolveInvarDual(Prop_ptr invarprop, const int max_k,
       SatSolver_set_polarity(SAT_SOLVER(solver_base), cnf, -1, additionalGroup);
 
       /* SOLVE (base) */
-      satResult = SatSolver_solve_all_groups(SAT_SOLVER(solver_base));
+      satResult = bmc_inc_solve_all_groups(solver_base);
 
       /* Result processing: */
       switch (satResult) {
@@ -1061,7 +1187,7 @@ int Bmc_GenSolveInvarDual(Prop_ptr invarprop, const int max_k,
              state stepN */
 
           /* SAT problem solving (backward step) */
-          satResult = SatSolver_solve_all_groups(SAT_SOLVER(solver_step));
+          satResult = bmc_inc_solve_all_groups(solver_step);
 
           /* Processes the result: */
           switch (satResult) {
@@ -1193,7 +1319,7 @@ int Bmc_GenSolveInvarDual(Prop_ptr invarprop, const int max_k,
             SatSolver_set_polarity(SAT_SOLVER(solver_step), cnf, -1, bugGroup);
 
             /* SAT problem solving (forward step) */
-            satResult = SatSolver_solve_all_groups(SAT_SOLVER(solver_step));
+            satResult = bmc_inc_solve_all_groups(solver_step);
 
             /* Processes the result: */
             switch (satResult) {
@@ -1320,7 +1446,34 @@ int Bmc_GenSolveInvarDual(Prop_ptr invarprop, const int max_k,
   SeeAlso            []
 
 ******************************************************************************/
-int Bmc_GenSolveInvarFalsification(Prop_ptr invarprop, const int max_k)
+int Bmc_GenSolveInvarFalsification(Prop_ptr invarprop,
+                                   const int max_k)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_invar_falsification");
+  Sat_PortfolioResetStats();
+  res = bmc_gen_solve_invar_falsification(invarprop, max_k);
+  bmc_inc_portfolio_report();
+  Profile_end("bmc_gen_solve_invar_falsification");
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveInvarFalsification]
+
+  Description        [See Bmc_GenSolveInvarFalsification]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveInvarFalsification]
+
+******************************************************************************/
+static int bmc_gen_solve_invar_falsification(Prop_ptr invarprop,
+                                             const int max_k)
 {
   node_ptr binvarspec;  /* Its booleanization */
   be_ptr be_invar;  /* Its BE representation */
@@ -1472,7 +1625,7 @@ int Bmc_GenSolveInvarFalsification(Prop_ptr invarprop, const int max_k)
       SatSolver_set_polarity(SAT_SOLVER(solver_base), cnf, -1, additionalGroup);
 
       /* SOLVE (base) */
-      satResult = SatSolver_solve_all_groups(SAT_SOLVER(solver_base));
+      satResult = bmc_inc_solve_all_groups(solver_base);
 
       /* Result processing: */
       switch (satResult) {
@@ -1600,7 +1753,9 @@ int Bmc_GenSolveInvarFalsification(Prop_ptr invarprop, const int max_k)
   Synopsis      [Converts Be into CNF, and adds it into a group of a solver.]
 
   Description        [Outputs into nusmv_stdout the total time
-  of conversion and adding BE to solver. It is resposibility of the invoker
+  of conversion and adding BE to solver. The clauses are loaded into the
+  solver while they are generated, so the returned CNF holds only the
+  formula literal (see SatSolver_add_be). It is resposibility of the invoker
   to destroy returned CNF (with Be_Cnf_Delete)]
 
   SideEffects        [creates an instance of CNF formula. (do not forget to
@@ -1627,8 +1782,7 @@ inline static Be_Cnf_ptr bmc_add_be_into_solver(SatSolver_ptr solver,
   /* We force inclusion of the conjunct set to guarantee soundness */
   inprob = Bmc_Utils_apply_inlining4inc(be_mgr, prob);
 
-  cnf = Be_ConvertToCnf(be_mgr, inprob, polarity);
-  SatSolver_add(solver, cnf, group);
+  cnf = SatSolver_add_be(solver, be_mgr, inprob, polarity, group);
   return cnf;
 }
 
@@ -1658,6 +1812,100 @@ inline static void  bmc_add_be_into_solver_positively(SatSolver_ptr solver,
   Be_Cnf_Delete(cnf);
 }
 
+/**Function********************************************************************
+
+  Synopsis      [Same as bmc_add_be_into_solver_positively, but only the
+  clauses the solver has not received yet are added]
+
+  Description        [The sub-formulae whose clauses are already in the
+  permanent group of the solver are not converted again (see
+  SatSolver_add_be_new). This is meant for a single solver fed bound
+  after bound: the records of the BE manager must be reset when the
+  solver is created and when it is destroyed.]
+
+  SideEffects        []
+
+  SeeAlso            [Be_ResetCnfEmitted]
+
+******************************************************************************/
+inline static void bmc_add_new_be_into_solver_positively(SatSolver_ptr solver,
+                                                          SatSolverGroup group,
+                                                          be_ptr prob,
+                                                          BeEnc_ptr be_enc)
+{
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
+  Be_Cnf_ptr cnf;
+
+  /* We force inclusion of the conjunct set to guarantee soundness */
+  cnf = SatSolver_add_be_new(solver, be_mgr,
+                             Bmc_Utils_apply_inlining4inc(be_mgr, prob),
+                             1, group);
+  SatSolver_set_polarity(solver, cnf, 1, group);
+  Be_Cnf_Delete(cnf);
+}
+
+/**Function********************************************************************
+
+  Synopsis           [Solves all the groups of the given solver, possibly
+                      racing a portfolio of diversified solvers]
+
+  Description        [When bmc_portfolio_size is greater than one, the
+                      call is dispatched to Sat_PortfolioSolveAllGroups,
+                      otherwise the solver is used directly]
+
+  SideEffects        []
+
+  SeeAlso            [Sat_PortfolioSolveAllGroups]
+
+******************************************************************************/
+static SatSolverResult bmc_inc_solve_all_groups(SatIncSolver_ptr solver)
+{
+  return Sat_PortfolioSolveAllGroups(solver,
+                                     get_bmc_portfolio_size(OptsHandler_get_instance()),
+                                     opt_bmc_portfolio_share_units(OptsHandler_get_instance()));
+}
+
+/**Function********************************************************************
+
+  Synopsis           [Solves all the groups of the given solver but the
+                      given ones, possibly racing a portfolio of solvers]
+
+  Description        [See bmc_inc_solve_all_groups]
+
+  SideEffects        []
+
+  SeeAlso            [Sat_PortfolioSolveWithoutGroups]
+
+******************************************************************************/
+static SatSolverResult bmc_inc_solve_without_groups(SatIncSolver_ptr solver,
+                                                    Olist_ptr groups)
+{
+  return Sat_PortfolioSolveWithoutGroups(solver, groups,
+                                         get_bmc_portfolio_size(OptsHandler_get_instance()),
+                                         opt_bmc_portfolio_share_units(OptsHandler_get_instance()));
+}
+
+/**Function********************************************************************
+
+  Synopsis           [Prints the statistics of the portfolio races run by
+                      the last incremental BMC check]
+
+  Description        [Nothing is printed when the portfolio is disabled]
+
+  SideEffects        []
+
+  SeeAlso            [Sat_PortfolioPrintStats]
+
+******************************************************************************/
+static void bmc_inc_portfolio_report(void)
+{
+  if (get_bmc_portfolio_size(OptsHandler_get_instance()) > 1) {
+    /* the verdict must not be interleaved with the statistics */
+    fflush(nusmv_stdout);
+    Sat_PortfolioPrintStats(nusmv_stderr);
+  }
+}
+
 /**Function********************************************************************
 
   Synopsis           [Builds the uniqueness contraint for dual and zigzag
@@ -69,6 +69,7 @@
 #include "dag/dag.h"
 #include "node/node.h"
 #include "utils/error.h"
+#include "utils/Profile.h"
 
 
 #ifdef BENCHMARKING
@@ -107,6 +108,43 @@ static char rcsid[] UTIL_UNUSED = "$Id: bmcBmcNonInc.c,v 1.1.2.13.2.8.4.18 2010-
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 
+static int bmc_gen_solve_ltl ARGS((Prop_ptr ltlprop,
+                                   const int k,
+                                   const int relative_loop,
+                                   const boolean must_inc_length,
+                                   const boolean must_solve,
+                                   const Bmc_DumpType dump_type,
+                                   const char* dump_fname_template));
+static be_ptr bmc_gen_ltl_bound_problem ARGS((BeFsm_ptr be_fsm,
+                                              node_ptr bltlspec,
+                                              const int k,
+                                              const int relative_loop,
+                                              int* l));
+static boolean bmc_gen_ltl_process_result ARGS((Prop_ptr ltlprop,
+                                                BeEnc_ptr be_enc,
+                                                SatSolver_ptr solver,
+                                                be_ptr prob,
+                                                const int k,
+                                                const int relative_loop,
+                                                SatSolverResult sat_res));
+static int bmc_gen_solve_ltl_parallel ARGS((Prop_ptr ltlprop,
+                                            BeFsm_ptr be_fsm,
+                                            node_ptr bltlspec,
+                                            const int k_min,
+                                            const int k_max,
+                                            const int relative_loop,
+                                            const Bmc_DumpType dump_type,
+                                            const char* dump_fname_template));
+static int bmc_gen_solve_invar ARGS((Prop_ptr invarprop,
+                                     const boolean must_solve,
+                                     const Bmc_DumpType dump_type,
+                                     const char* dump_fname_template));
+static int bmc_gen_solve_invar_een_sorensson ARGS((Prop_ptr invarprop,
+                                                   const int max_k,
+                                                   const Bmc_DumpType dump_type,
+                                                   const char* dump_fname_template,
+                                                   boolean use_extra_step));
+
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -137,6 +175,36 @@ int Bmc_GenSolveLtl(Prop_ptr ltlprop,
                     const boolean must_solve,
                     const Bmc_DumpType dump_type,
                     const char* dump_fname_template)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_ltl");
+  res = bmc_gen_solve_ltl(ltlprop, k, relative_loop, must_inc_length,
+                          must_solve, dump_type, dump_fname_template);
+  Profile_end("bmc_gen_solve_ltl");
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveLtl]
+
+  Description        [See Bmc_GenSolveLtl]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveLtl]
+
+******************************************************************************/
+static int bmc_gen_solve_ltl(Prop_ptr ltlprop,
+                             const int k,
+                             const int relative_loop,
+                             const boolean must_inc_length,
+                             const boolean must_solve,
+                             const Bmc_DumpType dump_type,
+                             const char* dump_fname_template)
 {
   node_ptr bltlspec;  /* Its booleanization */
   BeFsm_ptr be_fsm; /* The corresponding be fsm */
@@ -183,64 +251,22 @@ int Bmc_GenSolveLtl(Prop_ptr ltlprop,
   be_mgr = BeEnc_get_be_manager(be_enc);
 
   /* Start problems generations: */
+  if (must_solve && (k_min < k_max) &&
+      (get_bmc_parallel_bounds(OptsHandler_get_instance()) > 1)) {
+    return bmc_gen_solve_ltl_parallel(ltlprop, be_fsm, bltlspec,
+                                      k_min, k_max, relative_loop,
+                                      dump_type, dump_fname_template);
+  }
+
   for (increasingK = k_min; (increasingK <= k_max) && ! found_solution;
        ++increasingK) {
     int l;
-    char szLoop[16]; /* to keep loopback string */
     be_ptr prob; /* The problem in BE format */
     Be_Cnf_ptr cnf; /* The CNFed be problem */
 
-    /* the loopback value could be depending on the length
-       if it were relative: */
-    l = Bmc_Utils_RelLoop2AbsLoop(relative_loop, increasingK);
-
-    /* this is for verbose messages */
-    Bmc_Utils_ConvertLoopFromInteger(relative_loop, szLoop, sizeof(szLoop));
-
-    /* prints a verbose message: */
-    if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
-      if (Bmc_Utils_IsNoLoopback(l)) {
-        fprintf(nusmv_stderr,
-                "\nGenerating problem with bound %d, no loopback...\n",
-                increasingK);
-      }
-      else if (Bmc_Utils_IsAllLoopbacks(l)) {
-        fprintf(nusmv_stderr,
-                "\nGenerating problem with bound %d, all possible loopbacks...\n",
-                increasingK);
-      }
-      else {
-        /* l can be negative iff loopback from the user pov is < -length */
-        if ((l < increasingK) && (l >= 0)) {
-          fprintf(nusmv_stderr,
-                  "\nGenerating problem with bound %d, loopback %s...\n",
-                  increasingK, szLoop);
-        }
-      }
-    } /* verbose message */
-
-    /* checks for loopback vs k compatibility */
-    if (Bmc_Utils_IsSingleLoopback(l) && ((l >= increasingK) || (l < 0))) {
-      fprintf(nusmv_stderr,
-              "\nWarning: problem with bound %d and loopback %s is not allowed: skipped\n",
-              increasingK, szLoop);
-      continue;
-    }
-
-    /* generates the problem: */
-#ifdef BENCHMARKING
-    fprintf(nusmv_stdout,":START:benchmarking Generation\n");
-    start_time = clock();
-#endif
-
-    prob = Bmc_Gen_LtlProblem(be_fsm, bltlspec, increasingK, l);
-    prob = Bmc_Utils_apply_inlining(be_mgr, prob); /* inline if needed */
-
-#ifdef BENCHMARKING
-    fprintf(nusmv_stdout,":UTIME = %.4f secs.\n",
-            ((double)(clock()-start_time))/CLOCKS_PER_SEC);
-    fprintf(nusmv_stdout,":STOP:benchmarking Generation\n");
-#endif
+    prob = bmc_gen_ltl_bound_problem(be_fsm, bltlspec, increasingK,
+                                     relative_loop, &l);
+    if (prob == (be_ptr) NULL) continue;
 
     /* Problem is cnf-ed */
     cnf = (Be_Cnf_ptr) NULL;
@@ -268,10 +294,13 @@ int Bmc_GenSolveLtl(Prop_ptr ltlprop,
         return 1;
       }
 
-      /* Cnf construction (if needed): */
+      /* Cnf construction (if needed): the clauses are streamed into
+         the solver, unless they have been built for dumping */
       if (cnf == (Be_Cnf_ptr) NULL) {
-        cnf = Be_ConvertToCnf(be_mgr, prob, 1);
+        cnf = SatSolver_add_be(solver, be_mgr, prob, 1,
+                               SatSolver_get_permanent_group(solver));
       }
+      else SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
 
 #ifdef BENCHMARKING
       fprintf(nusmv_stdout, ":START:benchmarking Solving\n");
@@ -279,7 +308,6 @@ int Bmc_GenSolveLtl(Prop_ptr ltlprop,
 #endif
 
       /* SAT invokation */
-      SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
       SatSolver_set_polarity(solver, cnf, 1,
                              SatSolver_get_permanent_group(solver));
       sat_res = SatSolver_solve_all_groups(solver);
@@ -291,92 +319,367 @@ int Bmc_GenSolveLtl(Prop_ptr ltlprop,
 #endif
 
       /* Processes the result: */
-      switch (sat_res) {
+      found_solution = bmc_gen_ltl_process_result(ltlprop, be_enc, solver,
+                                                  prob, increasingK,
+                                                  relative_loop, sat_res);
 
-      case SAT_SOLVER_UNSATISFIABLE_PROBLEM:
-        {
-          char szLoopMsg[16]; /* for loopback part of message */
-          memset(szLoopMsg, 0, sizeof(szLoopMsg));
+      SatSolver_destroy(solver);
+    } /* must solve */
 
-          if (Bmc_Utils_IsAllLoopbacks(l)) {
-            strncpy(szLoopMsg, "", sizeof(szLoopMsg)-1);
-          }
-          else if (Bmc_Utils_IsNoLoopback(l)) {
-            strncpy(szLoopMsg, " and no loop", sizeof(szLoopMsg)-1);
-          }
-          else {
-            /* loop is Natural: */
-            strncpy(szLoopMsg, " and loop at ", sizeof(szLoopMsg)-1);
-            strncat(szLoopMsg, szLoop, sizeof(szLoopMsg)-1-strlen(szLoopMsg));
-          }
+    if (cnf != (Be_Cnf_ptr) NULL) {
+      Be_Cnf_Delete(cnf);
+      cnf = (Be_Cnf_ptr) NULL;
+    }
 
-          fprintf(nusmv_stdout,
-                  "-- no counterexample found with bound %d%s",
-                  increasingK, szLoopMsg);
-          if (opt_verbose_level_gt(OptsHandler_get_instance(), 2)) {
-            fprintf(nusmv_stdout, " for ");
-            print_spec(nusmv_stdout, ltlprop);
-          }
-          fprintf(nusmv_stdout, "\n");
+  } /* for all problems length */
 
-          break;
-        }
+  return 0;
+}
 
-      case SAT_SOLVER_SATISFIABLE_PROBLEM:
-        fprintf(nusmv_stdout, "-- ");
+
+/**Function********************************************************************
+
+  Synopsis           [Generates the LTL problem of the given bound]
+
+  Description        [Returns NULL if the loopback is not compatible with
+  the bound, in which case the bound must be skipped. The absolute
+  loopback is returned in l.]
+
+  SideEffects        [Prints verbose messages and warnings]
+
+  SeeAlso            [bmc_gen_solve_ltl]
+
+******************************************************************************/
+static be_ptr bmc_gen_ltl_bound_problem(BeFsm_ptr be_fsm,
+                                        node_ptr bltlspec,
+                                        const int k,
+                                        const int relative_loop,
+                                        int* l)
+{
+  Be_Manager_ptr be_mgr =
+    BeEnc_get_be_manager(BeFsm_get_be_encoding(be_fsm));
+  char szLoop[16]; /* to keep loopback string */
+  be_ptr prob; /* The problem in BE format */
+
+  /* the loopback value could be depending on the length
+     if it were relative: */
+  *l = Bmc_Utils_RelLoop2AbsLoop(relative_loop, k);
+
+  /* this is for verbose messages */
+  Bmc_Utils_ConvertLoopFromInteger(relative_loop, szLoop, sizeof(szLoop));
+
+  /* prints a verbose message: */
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    if (Bmc_Utils_IsNoLoopback(*l)) {
+      fprintf(nusmv_stderr,
+              "\nGenerating problem with bound %d, no loopback...\n", k);
+    }
+    else if (Bmc_Utils_IsAllLoopbacks(*l)) {
+      fprintf(nusmv_stderr,
+              "\nGenerating problem with bound %d, all possible loopbacks...\n",
+              k);
+    }
+    else {
+      /* l can be negative iff loopback from the user pov is < -length */
+      if ((*l < k) && (*l >= 0)) {
+        fprintf(nusmv_stderr,
+                "\nGenerating problem with bound %d, loopback %s...\n",
+                k, szLoop);
+      }
+    }
+  } /* verbose message */
+
+  /* checks for loopback vs k compatibility */
+  if (Bmc_Utils_IsSingleLoopback(*l) && ((*l >= k) || (*l < 0))) {
+    fprintf(nusmv_stderr,
+            "\nWarning: problem with bound %d and loopback %s is not allowed: skipped\n",
+            k, szLoop);
+    return (be_ptr) NULL;
+  }
+
+  /* generates the problem: */
+#ifdef BENCHMARKING
+  fprintf(nusmv_stdout,":START:benchmarking Generation\n");
+  start_time = clock();
+#endif
+
+  prob = Bmc_Gen_LtlProblem(be_fsm, bltlspec, k, *l);
+  prob = Bmc_Utils_apply_inlining(be_mgr, prob); /* inline if needed */
+
+#ifdef BENCHMARKING
+  fprintf(nusmv_stdout,":UTIME = %.4f secs.\n",
+          ((double)(clock()-start_time))/CLOCKS_PER_SEC);
+  fprintf(nusmv_stdout,":STOP:benchmarking Generation\n");
+#endif
+
+  return prob;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Processes the answer of the solver to the LTL
+  problem of the given bound]
+
+  Description        [Prints the outcome and, when the problem is
+  satisfiable, sets the property to false and builds the counterexample
+  from the model of the solver. Returns true iff a counterexample has
+  been found.]
+
+  SideEffects        [The status and the trace of the property may change]
+
+  SeeAlso            [bmc_gen_solve_ltl]
+
+******************************************************************************/
+static boolean bmc_gen_ltl_process_result(Prop_ptr ltlprop,
+                                          BeEnc_ptr be_enc,
+                                          SatSolver_ptr solver,
+                                          be_ptr prob,
+                                          const int k,
+                                          const int relative_loop,
+                                          SatSolverResult sat_res)
+{
+  const int l = Bmc_Utils_RelLoop2AbsLoop(relative_loop, k);
+  char szLoop[16]; /* to keep loopback string */
+
+  Bmc_Utils_ConvertLoopFromInteger(relative_loop, szLoop, sizeof(szLoop));
+
+  switch (sat_res) {
+
+  case SAT_SOLVER_UNSATISFIABLE_PROBLEM:
+    {
+      char szLoopMsg[16]; /* for loopback part of message */
+      memset(szLoopMsg, 0, sizeof(szLoopMsg));
+
+      if (Bmc_Utils_IsAllLoopbacks(l)) {
+        strncpy(szLoopMsg, "", sizeof(szLoopMsg)-1);
+      }
+      else if (Bmc_Utils_IsNoLoopback(l)) {
+        strncpy(szLoopMsg, " and no loop", sizeof(szLoopMsg)-1);
+      }
+      else {
+        /* loop is Natural: */
+        strncpy(szLoopMsg, " and loop at ", sizeof(szLoopMsg)-1);
+        strncat(szLoopMsg, szLoop, sizeof(szLoopMsg)-1-strlen(szLoopMsg));
+      }
+
+      fprintf(nusmv_stdout,
+              "-- no counterexample found with bound %d%s",
+              k, szLoopMsg);
+      if (opt_verbose_level_gt(OptsHandler_get_instance(), 2)) {
+        fprintf(nusmv_stdout, " for ");
         print_spec(nusmv_stdout, ltlprop);
-        fprintf(nusmv_stdout, "  is false\n");
-        Prop_set_status(ltlprop, Prop_False);
+      }
+      fprintf(nusmv_stdout, "\n");
 
-        found_solution = true;
+      return false;
+    }
 
-        if (opt_counter_examples(OptsHandler_get_instance())) {
-          BoolSexpFsm_ptr bsexp_fsm; /* needed for trace language */
+  case SAT_SOLVER_SATISFIABLE_PROBLEM:
+    fprintf(nusmv_stdout, "-- ");
+    print_spec(nusmv_stdout, ltlprop);
+    fprintf(nusmv_stdout, "  is false\n");
+    Prop_set_status(ltlprop, Prop_False);
 
-          bsexp_fsm = Prop_get_bool_sexp_fsm(ltlprop);
-          if (BOOL_SEXP_FSM(NULL) == bsexp_fsm) {
-            bsexp_fsm = \
-              PropDb_master_get_bool_sexp_fsm(PropPkg_get_prop_database());
-            BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
-          }
+    if (opt_counter_examples(OptsHandler_get_instance())) {
+      BoolSexpFsm_ptr bsexp_fsm; /* needed for trace language */
 
-          Trace_ptr trace = \
-            Bmc_Utils_generate_and_print_cntexample(be_enc,
-                                                    solver,
-                                                    prob, increasingK,
-                                                    "BMC Counterexample",
-                             SexpFsm_get_symbols_list(SEXP_FSM(bsexp_fsm)));
+      bsexp_fsm = Prop_get_bool_sexp_fsm(ltlprop);
+      if (BOOL_SEXP_FSM(NULL) == bsexp_fsm) {
+        bsexp_fsm = \
+          PropDb_master_get_bool_sexp_fsm(PropPkg_get_prop_database());
+        BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
+      }
 
-          Prop_set_trace(ltlprop, Trace_get_id(trace));
-        }
+      Trace_ptr trace = \
+        Bmc_Utils_generate_and_print_cntexample(be_enc,
+                                                solver,
+                                                prob, k,
+                                                "BMC Counterexample",
+                         SexpFsm_get_symbols_list(SEXP_FSM(bsexp_fsm)));
+
+      Prop_set_trace(ltlprop, Trace_get_id(trace));
+    }
+
+    return true;
+
+  case SAT_SOLVER_INTERNAL_ERROR:
+    internal_error("Sorry, solver answered with a fatal Internal "
+                   "Failure during problem solving.\n");
+
+  case SAT_SOLVER_TIMEOUT:
+  case SAT_SOLVER_MEMOUT:
+    internal_error("Sorry, solver ran out of resources and aborted "
+                   "the execution.\n");
+
+  default:
+    internal_error("Bmc_GenSolveLtl: Unexpected value in sat result");
+
+  } /* switch */
+
+  return false;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Solves the LTL problems of bounds k_min..k_max
+  concurrently]
+
+  Description        [Up to bmc_parallel_bounds problems are solved at
+  the same time, each by its own solver in background. Problems are
+  generated and dispatched by increasing bound, and results are
+  reported in the same order, so that the output is the same as when
+  solving one bound after the other. As soon as a bound is found
+  satisfiable, the longer bounds still running are cancelled and no
+  further bound is dispatched, while the shorter ones are waited for:
+  the counterexample found is always the shortest one.
+
+  Returns 1 if solver could not be created, 0 if everything went
+  smooth]
 
+  SideEffects        []
+
+  SeeAlso            [bmc_gen_solve_ltl, Sat_SolveJobStart]
+
+******************************************************************************/
+static int bmc_gen_solve_ltl_parallel(Prop_ptr ltlprop,
+                                      BeFsm_ptr be_fsm,
+                                      node_ptr bltlspec,
+                                      const int k_min,
+                                      const int k_max,
+                                      const int relative_loop,
+                                      const Bmc_DumpType dump_type,
+                                      const char* dump_fname_template)
+{
+  BeEnc_ptr be_enc = BeFsm_get_be_encoding(be_fsm);
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
+  const int size = get_bmc_parallel_bounds(OptsHandler_get_instance());
+
+  /* running jobs, sorted by increasing bound */
+  SatSolveJob_ptr* jobs = ALLOC(SatSolveJob_ptr, size);
+  be_ptr* probs = ALLOC(be_ptr, size);
+  int* bounds = ALLOC(int, size);
+  int running = 0;
+
+  int next_k = k_min;
+  int cut_k = k_max + 1; /* bounds from this on are useless */
+  boolean found_solution = false;
+  int res = 0;
+  int i;
+
+  while (!found_solution) {
+
+    /* dispatches the next bounds */
+    while ((running < size) && (next_k <= k_max) && (next_k < cut_k)) {
+      SatSolver_ptr solver;
+      be_ptr prob;
+      Be_Cnf_ptr cnf;
+      int l;
+
+      prob = bmc_gen_ltl_bound_problem(be_fsm, bltlspec, next_k,
+                                       relative_loop, &l);
+      if (prob == (be_ptr) NULL) {
+        ++next_k;
+        continue;
+      }
+
+      solver = Sat_CreateNonIncSolver(get_sat_solver(OptsHandler_get_instance()));
+      if (solver == SAT_SOLVER(NULL)) {
+        fprintf(nusmv_stderr,
+                "Non-incremental sat solver '%s' is not available.\n",
+                get_sat_solver(OptsHandler_get_instance()));
+        res = 1;
         break;
+      }
 
-      case SAT_SOLVER_INTERNAL_ERROR:
-        internal_error("Sorry, solver answered with a fatal Internal "
-                       "Failure during problem solving.\n");
+      if (dump_type != BMC_DUMP_NONE) {
+        cnf = Be_ConvertToCnf(be_mgr, prob, 1);
+        Bmc_Dump_WriteProblem(be_enc, cnf, ltlprop, next_k, l,
+                              dump_type, dump_fname_template);
+        SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
+      }
+      else {
+        /* the clauses are streamed into the solver */
+        cnf = SatSolver_add_be(solver, be_mgr, prob, 1,
+                               SatSolver_get_permanent_group(solver));
+      }
 
-      case SAT_SOLVER_TIMEOUT:
-      case SAT_SOLVER_MEMOUT:
-        internal_error("Sorry, solver ran out of resources and aborted "
-                       "the execution.\n");
+      SatSolver_set_polarity(solver, cnf, 1,
+                             SatSolver_get_permanent_group(solver));
+      Be_Cnf_Delete(cnf);
 
-      default:
-        internal_error("Bmc_GenSolveLtl: Unexpected value in sat result");
+      if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+        fprintf(nusmv_stderr, "Dispatching problem with bound %d\n", next_k);
+      }
 
-      } /* switch */
+      jobs[running] = Sat_SolveJobStart(solver);
+      probs[running] = prob;
+      bounds[running] = next_k;
+      ++running;
+      ++next_k;
+    }
+
+    if ((res != 0) || (running == 0)) break;
+
+    /* reports the shortest bounds which are done, in order */
+    while ((running > 0) && Sat_SolveJobIsDone(jobs[0]) && !found_solution) {
+      SatSolver_ptr solver = Sat_SolveJobGetSolver(jobs[0]);
+
+      found_solution =
+        bmc_gen_ltl_process_result(ltlprop, be_enc, solver, probs[0],
+                                   bounds[0], relative_loop,
+                                   Sat_SolveJobGetResult(jobs[0]));
 
+      Sat_SolveJobDestroy(jobs[0]);
       SatSolver_destroy(solver);
-    } /* must solve */
 
-    if (cnf != (Be_Cnf_ptr) NULL) {
-      Be_Cnf_Delete(cnf);
-      cnf = (Be_Cnf_ptr) NULL;
+      --running;
+      for (i = 0; i < running; ++i) {
+        jobs[i] = jobs[i+1];
+        probs[i] = probs[i+1];
+        bounds[i] = bounds[i+1];
+      }
     }
 
-  } /* for all problems length */
+    if (found_solution || (running == 0)) continue;
 
-  return 0;
+    /* waits for any bound to be done */
+    {
+      SatSolveJob_ptr job = Sat_SolveJobWaitAny(jobs, running);
+      SatSolver_ptr solver;
+
+      if ((job != SAT_SOLVE_JOB(NULL)) &&
+          (Sat_SolveJobGetResult(job) == SAT_SOLVER_SATISFIABLE_PROBLEM)) {
+        for (i = 0; jobs[i] != job; ++i);
+
+        /* longer bounds are cancelled */
+        cut_k = bounds[i] + 1;
+        while (running > i + 1) {
+          --running;
+          if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+            fprintf(nusmv_stderr, "Cancelling problem with bound %d\n",
+                    bounds[running]);
+          }
+          solver = Sat_SolveJobGetSolver(jobs[running]);
+          Sat_SolveJobDestroy(jobs[running]);
+          SatSolver_destroy(solver);
+        }
+      }
+    }
+  } /* while !found_solution */
+
+  for (i = 0; i < running; ++i) {
+    SatSolver_ptr solver = Sat_SolveJobGetSolver(jobs[i]);
+    Sat_SolveJobDestroy(jobs[i]);
+    SatSolver_destroy(solver);
+  }
+
+  FREE(bounds);
+  FREE(probs);
+  FREE(jobs);
+
+  return res;
 }
 
 
@@ -398,6 +701,33 @@ int Bmc_GenSolveInvar(Prop_ptr invarprop,
                       const boolean must_solve,
                       const Bmc_DumpType dump_type,
                       const char* dump_fname_template)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_invar");
+  res = bmc_gen_solve_invar(invarprop, must_solve, dump_type,
+                            dump_fname_template);
+  Profile_end("bmc_gen_solve_invar");
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveInvar]
+
+  Description        [See Bmc_GenSolveInvar]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveInvar]
+
+******************************************************************************/
+static int bmc_gen_solve_invar(Prop_ptr invarprop,
+                               const boolean must_solve,
+                               const Bmc_DumpType dump_type,
+                               const char* dump_fname_template)
 {
   node_ptr binvarspec;  /* Its booleanization */
   BeFsm_ptr be_fsm; /* The corresponding be fsm */
@@ -607,13 +937,15 @@ Bmc_result Bmc_induction_algorithm(BeFsm_ptr be_fsm,
     return 1;
   }
 
-  /* Cnf construction (if needed): */
+  /* Cnf construction (if needed): the clauses are streamed into
+     the solver, unless they have been built for dumping */
   if (cnf == (Be_Cnf_ptr) NULL) {
-    cnf = Be_ConvertToCnf(be_mgr, prob, 1);
+    cnf = SatSolver_add_be(solver, be_mgr, prob, 1,
+                           SatSolver_get_permanent_group(solver));
   }
+  else SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
 
   /* SAT invokation */
-  SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
   SatSolver_set_polarity(solver, cnf, 1,
                          SatSolver_get_permanent_group(solver));
   sat_res = SatSolver_solve_all_groups(solver);
@@ -679,6 +1011,34 @@ int Bmc_GenSolveInvar_EenSorensson(Prop_ptr invarprop,
                                    const Bmc_DumpType dump_type,
                                    const char* dump_fname_template,
                                    boolean use_extra_step)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_invar_een_sorensson");
+  res = bmc_gen_solve_invar_een_sorensson(invarprop, max_k, dump_type,
+                                          dump_fname_template, use_extra_step);
+  Profile_end("bmc_gen_solve_invar_een_sorensson");
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveInvar_EenSorensson]
+
+  Description        [See Bmc_GenSolveInvar_EenSorensson]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveInvar_EenSorensson]
+
+******************************************************************************/
+static int bmc_gen_solve_invar_een_sorensson(Prop_ptr invarprop,
+                                             const int max_k,
+                                             const Bmc_DumpType dump_type,
+                                             const char* dump_fname_template,
+                                             boolean use_extra_step)
 {
   node_ptr binvarspec;  /* Its booleanization */
   BeFsm_ptr be_fsm; /* The corresponding be fsm */
@@ -959,13 +1319,15 @@ Bmc_result Bmc_een_sorensson_algorithm(BeFsm_ptr be_fsm,
         return BMC_ERROR;
       }
 
-      /* Cnf construction (if needed): */
+      /* Cnf construction (if needed): the clauses are streamed into
+         the solver, unless they have been built for dumping */
       if (cnf == (Be_Cnf_ptr) NULL) {
-        cnf = Be_ConvertToCnf(be_mgr, be_base, 1);
+        cnf = SatSolver_add_be(solver, be_mgr, be_base, 1,
+                               SatSolver_get_permanent_group(solver));
       }
+      else SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
 
       /* SAT invokation */
-      SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
       SatSolver_set_polarity(solver, cnf, 1,
                              SatSolver_get_permanent_group(solver));
       sat_res = SatSolver_solve_all_groups(solver);
@@ -1124,13 +1486,15 @@ Bmc_result Bmc_een_sorensson_algorithm(BeFsm_ptr be_fsm,
           return BMC_ERROR;
         }
 
-        /* Cnf construction (if needed): */
+        /* Cnf construction (if needed): the clauses are streamed into
+           the solver, unless they have been built for dumping */
         if (cnf == (Be_Cnf_ptr) NULL) {
-          cnf = Be_ConvertToCnf(be_mgr, be_steps[i], 1);
+          cnf = SatSolver_add_be(solver, be_mgr, be_steps[i], 1,
+                                 SatSolver_get_permanent_group(solver));
         }
+        else SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
 
         /* SAT invokation */
-        SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
         SatSolver_set_polarity(solver, cnf, 1,
                                SatSolver_get_permanent_group(solver));
         sat_res = SatSolver_solve_all_groups(solver);
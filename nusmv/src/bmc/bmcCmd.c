@@ -98,6 +98,8 @@ static int UsageBmcCheckLtlSpec       ARGS((void));
 static int UsageBmcCheckLtlSpecOnePb  ARGS((void));
 static int UsageBmcGenInvar           ARGS((void));
 static int UsageBmcCheckInvar         ARGS((void));
+static int UsageBmcCheckInvarItp      ARGS((void));
+static int UsageBmcCheckInvarIc3      ARGS((void));
 
 #if NUSMV_HAVE_INCREMENTAL_SAT
 static int UsageBmcCheckLtlSpecInc    ARGS((void));
@@ -2474,6 +2476,286 @@ static int UsageBmcCheckInvar(void)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis           [Solves the given invariant, or all invariants if
+  no formula is given, using interpolation]
+
+  Description        []
+
+  SideEffects        [Property database may change]
+
+  SeeAlso            [Bmc_CommandCheckInvarBmc]
+
+  CommandName        [check_invar_itp]
+
+  CommandSynopsis    [Checks the given invariant, or all invariants if
+  no formula is given, using interpolation]
+
+  CommandArguments   [\[-h | -n idx | -p "formula" \[IN context\] | -P "name"\]
+  \[-k max_length\] ]
+
+  CommandDescription [<p>
+  The reachable states are over-approximated with the interpolants of
+  bounded unrollings of the model (McMillan's algorithm). The property
+  is proved true when the over-approximation is closed under the
+  transition relation, and false when a counterexample is found.
+  A proof logging SAT solver is required.<p>
+  Command options:<p>
+  <dl>
+    <dt> <tt>-n <i>index</i></tt>
+       <dd> <i>index</i> is the numeric index of a valid INVAR specification
+       formula actually located in the properties database. <BR>
+       The validity of <i>index</i> value is checked out by the system.
+    <dt> <tt>-p "formula \[IN context\]"</tt>
+       <dd> Checks the <tt>formula</tt> specified on the command-line. <BR>
+            <tt>context</tt> is the module instance name which the variables
+            in <tt>formula</tt> must be evaluated in.
+    <dt> <tt>-P name</tt>
+       <dd> Checks the INVARSPEC property with name <tt>name</tt> in the property
+            database.
+    <dt> <tt>-k <i>max_length</i></tt>
+       <dd> Use to specify the maximal length of the unrollings. If not
+            specified, the value assigned to the system variable
+            <i>bmc_length</i> is taken.
+  </dl>]
+
+******************************************************************************/
+int Bmc_CommandCheckInvarItp(int argc, char** argv)
+{
+  Prop_ptr invarprop = PROP(NULL);   /* The property being processed */
+  Outcome opt_handling_res;
+  int res = 0;
+  int max_k = get_bmc_pb_length(OptsHandler_get_instance());
+
+  /* ----------------------------------------------------------------------- */
+  /* Options handling: */
+  opt_handling_res = Bmc_cmd_options_handling(argc, argv,
+                                              Prop_Invar, &invarprop,
+                                              &max_k, NULL, NULL, NULL,
+                                              NULL, NULL);
+
+  if (opt_handling_res == OUTCOME_SUCCESS_REQUIRED_HELP) {
+    return UsageBmcCheckInvarItp();
+  }
+
+  if (opt_handling_res != OUTCOME_SUCCESS) return 1;
+
+  /* makes sure bmc has been set up */
+  if (Bmc_check_if_model_was_built(nusmv_stderr, false)) return 1;
+
+  /* prepare the list of properties if no property was selected: */
+  if (invarprop == PROP(NULL)) {
+    lsList props;
+    lsGen  iterator;
+    Prop_ptr prop;
+
+    if (opt_use_coi_size_sorting(OptsHandler_get_instance()))
+      props = PropDb_get_ordered_props_of_type(PropPkg_get_prop_database(),
+                                               mainFlatHierarchy,
+                                               Prop_Invar);
+    else props = PropDb_get_props_of_type(PropPkg_get_prop_database(),
+                                          Prop_Invar);
+
+    nusmv_assert(props != LS_NIL);
+
+    lsForEachItem(props, iterator, prop) {
+      res = Bmc_GenSolveInvarItp(prop, max_k);
+      if (res != 0) break;
+    }
+
+    lsDestroy(props, NULL); /* the list is no longer needed */
+  }
+  else {
+    res = Bmc_GenSolveInvarItp(invarprop, max_k);
+  }
+
+  return res;
+}
+
+/**Function********************************************************************
+
+  Synopsis           [Usage string for command check_invar_itp]
+
+  Description        []
+
+  SideEffects        [None]
+
+  SeeAlso            [Bmc_CommandCheckInvarItp]
+
+******************************************************************************/
+static int UsageBmcCheckInvarItp(void)
+{
+  fprintf(nusmv_stderr,
+          "\nusage: check_invar_itp [-h | -n idx | -p \"formula\" | "
+          "-P \"name\"] [-k max_len]\n");
+  fprintf(nusmv_stderr, "  -h \t\tPrints the command usage.\n");
+  fprintf(nusmv_stderr,
+          "  -n idx\tChecks the INVAR property specified with <idx>.\n");
+  fprintf(nusmv_stderr,
+          "  -p \"formula\"\tChecks the specified INVAR propositional property.\n");
+  fprintf(nusmv_stderr,
+          "  -P name\tChecks the INVAR property specified with <name>.\n");
+  fprintf(nusmv_stderr,
+          "\t\tIf no property is specified, checks all INVAR properties.\n");
+  fprintf(nusmv_stderr,
+          "  -k max_len\tUpper bound for the length of the unrollings."
+          "\n\t\tIf not specified, variable bmc_length is taken.\n");
+
+  return 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Solves the given invariant, or all invariants if
+  no formula is given, using IC3]
+
+  Description        []
+
+  SideEffects        [Property database may change]
+
+  SeeAlso            [Bmc_CommandCheckInvarItp]
+
+  CommandName        [check_invar_ic3]
+
+  CommandSynopsis    [Checks the given invariant, or all invariants if
+  no formula is given, using IC3]
+
+  CommandArguments   [\[-h | -n idx | -p "formula" \[IN context\] | -P "name"\]
+  \[-k max_frames\] \[-o filename\] ]
+
+  CommandDescription [<p>
+  The reachable states are over-approximated by a sequence of frames,
+  which are strengthened with clauses blocking the states that can
+  reach a violation of the property (Bradley's IC3, also known as
+  property directed reachability). The property is proved true when
+  two consecutive frames are equal, and false when a counterexample
+  is found. Unlike <tt>check_invar_bmc</tt>, no unrolling longer than
+  one transition is ever built.<p>
+  Command options:<p>
+  <dl>
+    <dt> <tt>-n <i>index</i></tt>
+       <dd> <i>index</i> is the numeric index of a valid INVAR specification
+       formula actually located in the properties database. <BR>
+       The validity of <i>index</i> value is checked out by the system.
+    <dt> <tt>-p "formula \[IN context\]"</tt>
+       <dd> Checks the <tt>formula</tt> specified on the command-line. <BR>
+            <tt>context</tt> is the module instance name which the variables
+            in <tt>formula</tt> must be evaluated in.
+    <dt> <tt>-P name</tt>
+       <dd> Checks the INVARSPEC property with name <tt>name</tt> in the property
+            database.
+    <dt> <tt>-k <i>max_frames</i></tt>
+       <dd> Use to specify the maximal number of frames. If not
+            specified, the value assigned to the system variable
+            <i>bmc_length</i> is taken.
+    <dt> <tt>-o <i>filename</i></tt>
+       <dd> When the property is proved true, the inductive invariant
+            found is written to <i>filename</i> as an <tt>INVAR</tt>
+            declaration over the boolean encoding of the model (see
+            <tt>write_boolean_model</tt>), so that the proof can be
+            certified independently.
+  </dl>]
+
+******************************************************************************/
+int Bmc_CommandCheckInvarIc3(int argc, char** argv)
+{
+  Prop_ptr invarprop = PROP(NULL);   /* The property being processed */
+  Outcome opt_handling_res;
+  int res = 0;
+  int max_k = get_bmc_pb_length(OptsHandler_get_instance());
+  char* fname = (char*) NULL;
+
+  /* ----------------------------------------------------------------------- */
+  /* Options handling: */
+  opt_handling_res = Bmc_cmd_options_handling(argc, argv,
+                                              Prop_Invar, &invarprop,
+                                              &max_k, NULL, NULL, NULL,
+                                              &fname, NULL);
+
+  if (opt_handling_res == OUTCOME_SUCCESS_REQUIRED_HELP) {
+    if (fname != (char*) NULL) FREE(fname);
+    return UsageBmcCheckInvarIc3();
+  }
+
+  if (opt_handling_res != OUTCOME_SUCCESS) {
+    if (fname != (char*) NULL) FREE(fname);
+    return 1;
+  }
+
+  /* makes sure bmc has been set up */
+  if (Bmc_check_if_model_was_built(nusmv_stderr, false)) {
+    if (fname != (char*) NULL) FREE(fname);
+    return 1;
+  }
+
+  /* prepare the list of properties if no property was selected: */
+  if (invarprop == PROP(NULL)) {
+    lsList props;
+    lsGen  iterator;
+    Prop_ptr prop;
+
+    if (opt_use_coi_size_sorting(OptsHandler_get_instance()))
+      props = PropDb_get_ordered_props_of_type(PropPkg_get_prop_database(),
+                                               mainFlatHierarchy,
+                                               Prop_Invar);
+    else props = PropDb_get_props_of_type(PropPkg_get_prop_database(),
+                                          Prop_Invar);
+
+    nusmv_assert(props != LS_NIL);
+
+    lsForEachItem(props, iterator, prop) {
+      res = Bmc_GenSolveInvarIc3(prop, max_k, fname);
+      if (res != 0) break;
+    }
+
+    lsDestroy(props, NULL); /* the list is no longer needed */
+  }
+  else {
+    res = Bmc_GenSolveInvarIc3(invarprop, max_k, fname);
+  }
+
+  if (fname != (char*) NULL) FREE(fname);
+  return res;
+}
+
+/**Function********************************************************************
+
+  Synopsis           [Usage string for command check_invar_ic3]
+
+  Description        []
+
+  SideEffects        [None]
+
+  SeeAlso            [Bmc_CommandCheckInvarIc3]
+
+******************************************************************************/
+static int UsageBmcCheckInvarIc3(void)
+{
+  fprintf(nusmv_stderr,
+          "\nusage: check_invar_ic3 [-h | -n idx | -p \"formula\" | "
+          "-P \"name\"] [-k max_frames]\n"
+          "\t\t       [-o filename]\n");
+  fprintf(nusmv_stderr, "  -h \t\tPrints the command usage.\n");
+  fprintf(nusmv_stderr,
+          "  -n idx\tChecks the INVAR property specified with <idx>.\n");
+  fprintf(nusmv_stderr,
+          "  -p \"formula\"\tChecks the specified INVAR propositional property.\n");
+  fprintf(nusmv_stderr,
+          "  -P name\tChecks the INVAR property specified with <name>.\n");
+  fprintf(nusmv_stderr,
+          "\t\tIf no property is specified, checks all INVAR properties.\n");
+  fprintf(nusmv_stderr,
+          "  -k max_frames\tUpper bound for the number of frames."
+          "\n\t\tIf not specified, variable bmc_length is taken.\n");
+  fprintf(nusmv_stderr,
+          "  -o filename\tWrites the inductive invariant found to <filename>.\n");
+
+  return 1;
+}
+
+
 #if NUSMV_HAVE_INCREMENTAL_SAT
 /**Function********************************************************************
 
@@ -83,6 +83,9 @@ EXTERN int Bmc_CommandGenInvarBmc ARGS((int argc, char** argv));
 
 EXTERN int Bmc_CommandCheckInvarBmc ARGS((int argc, char** argv));
 
+EXTERN int Bmc_CommandCheckInvarItp ARGS((int argc, char** argv));
+EXTERN int Bmc_CommandCheckInvarIc3 ARGS((int argc, char** argv));
+
 EXTERN int Bmc_check_if_model_was_built ARGS((FILE* err, boolean forced));
 
 EXTERN Outcome
@@ -0,0 +1,1421 @@
+/**CFile***********************************************************************
+
+  FileName    [bmcIc3.c]
+
+  PackageName [bmc]
+
+  Synopsis    [IC3/PDR invariant checking]
+
+  Description [Implements the IC3 (a.k.a. property directed
+  reachability) algorithm over the BE fsm.
+
+  A single SAT solver holds the transition relation and the clauses of
+  all the frames. Every frame, the initial states, the transition
+  relation and the bad states are guarded by activation literals,
+  which are CNF variables allocated with Be_NewCnfVar: a query
+  activates the parts it needs through the assumptions of the solver.
+  Frames are delta-encoded: the lemmas of frame i hold in frames 1..i,
+  so frame i is activated together with all the following ones.
+
+  Cubes are sorted arrays of literals over the state (and frozen)
+  variables of the encoding: the literal of the j-th variable is j+1
+  or -(j+1). The first element of the array is its size.
+
+  Lemmas are generalized with the unsat cores given by the failed
+  assumptions of the solver, and then by dropping literals one at a
+  time.]
+
+  SeeAlso     [bmcItp.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``bmc'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#if HAVE_CONFIG_H
+#include "nusmv-config.h"
+#endif
+
+#include "bmcBmc.h"
+#include "bmcInt.h"
+#include "bmcConv.h"
+#include "bmcModel.h"
+#include "bmcUtils.h"
+
+#include "wff/wff.h"
+#include "wff/w2w/w2w.h"
+
+#include "enc/enc.h"
+#include "enc/be/BeEnc.h"
+#include "be/be.h"
+
+#include "prop/propPkg.h"
+#include "mc/mc.h" /* for print_invar */
+
+#include "sat/sat.h"
+#include "sat/SatSolver.h"
+#include "utils/Slist.h"
+#include "utils/heap.h"
+#include "utils/Profile.h"
+#include "utils/error.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: bmcIc3.c,v 1.1.2.1 2011-03-22 10:00:00 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* The name of the layer rewritten invariants are declared in */
+#define BMC_IC3_REWRITE_INVARSPEC_LAYER_NAME "bmc_ic3_invarspec_rewrite_layer"
+
+/* The initial capacity of the frames and of the lemmas of a frame */
+#define BMC_IC3_INITIAL_CAPACITY 16
+
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [A lemma, i.e. the negation of a blocked cube]
+
+  Description [level is the last frame the lemma holds in, or 0 if
+  the lemma has been subsumed by another one. When a lemma is pushed
+  to the next frame it is left in the array of the previous frame,
+  which is compacted later.]
+
+******************************************************************************/
+typedef struct BmcIc3Lemma_TAG
+{
+  int* cube;
+  int level;
+} BmcIc3Lemma;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [The lemmas of a frame]
+
+  Description []
+
+******************************************************************************/
+typedef struct BmcIc3Frame_TAG
+{
+  BmcIc3Lemma** lemmas;
+  int num;
+  int capacity;
+} BmcIc3Frame;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [A proof obligation]
+
+  Description [The cube has to be blocked at the given level. next is
+  the obligation of the successor of the cube, down to the bad state
+  the chain started from.]
+
+******************************************************************************/
+typedef struct BmcIc3Obligation_TAG
+{
+  int* cube;
+  int level;
+  struct BmcIc3Obligation_TAG* next;
+} BmcIc3Obligation;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [The state of the IC3 engine]
+
+  Description []
+
+******************************************************************************/
+typedef struct BmcIc3_TAG
+{
+  BeFsm_ptr be_fsm;
+  BeEnc_ptr be_enc;
+  Be_Manager_ptr be_mgr;
+  SatSolver_ptr solver;
+
+  /* state and frozen variables */
+  int vars_num;
+  int* vars;            /* their untimed indices */
+  int* cnf_curr;        /* their CNF variables at time 0 */
+  int* cnf_next;        /* their CNF variables at time 1 */
+  hash_ptr curr2pos;    /* CNF var at time 0 -> position + 1 */
+  hash_ptr next2pos;    /* CNF var at time 1 -> position + 1 */
+  char* marks;          /* one per variable, used by cores */
+
+  /* activation literals */
+  int act_init;
+  int act_trans;
+  int act_bad;
+  int* acts;            /* one per frame */
+
+  BmcIc3Frame* frames;  /* frame 0 (the initial states) is not used */
+  int frames_num;
+  int frames_capacity;
+
+  Slist_ptr lemmas;      /* all the lemmas, for deletion */
+  Slist_ptr obligations; /* all the obligations, for deletion */
+
+  long queries;
+} BmcIc3;
+
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static int bmc_gen_solve_invar_ic3 ARGS((Prop_ptr invarprop,
+                                         const int max_k,
+                                         const char* invar_file));
+
+static BmcIc3* bmc_ic3_create ARGS((BeFsm_ptr be_fsm, be_ptr be_invar));
+static void bmc_ic3_destroy ARGS((BmcIc3* self));
+
+static void bmc_ic3_add_guarded ARGS((BmcIc3* self, be_ptr prob, int act));
+static void bmc_ic3_new_frame ARGS((BmcIc3* self));
+static int bmc_ic3_top ARGS((const BmcIc3* self));
+
+static SatSolverResult
+bmc_ic3_solve ARGS((BmcIc3* self, int level, boolean trans, int act,
+                    const int* cube, boolean next));
+
+static int* bmc_ic3_model_cube ARGS((BmcIc3* self));
+static boolean bmc_ic3_intersects_init ARGS((BmcIc3* self, const int* cube));
+
+static boolean
+bmc_ic3_is_relative_inductive ARGS((BmcIc3* self, const int* cube,
+                                    int level, int** core, int** pred));
+
+static int* bmc_ic3_generalize ARGS((BmcIc3* self, const int* cube,
+                                     int* core, int level));
+
+static void bmc_ic3_add_lemma ARGS((BmcIc3* self, int* cube, int level));
+static boolean bmc_ic3_is_blocked ARGS((BmcIc3* self, const int* cube,
+                                        int level));
+
+static BmcIc3Obligation*
+bmc_ic3_new_obligation ARGS((BmcIc3* self, int* cube, int level,
+                             BmcIc3Obligation* next));
+
+static BmcIc3Obligation* bmc_ic3_block ARGS((BmcIc3* self, int* cube));
+static int bmc_ic3_propagate ARGS((BmcIc3* self));
+
+static Trace_ptr
+bmc_ic3_print_counterexample ARGS((BmcIc3* self, BmcIc3Obligation* chain,
+                                   be_ptr be_invar, Prop_ptr invarprop));
+
+static be_ptr bmc_ic3_cube_to_be ARGS((BmcIc3* self, const int* cube,
+                                       int time));
+
+static void bmc_ic3_print_invariant ARGS((BmcIc3* self, FILE* out,
+                                          int level, Prop_ptr invarprop));
+
+static int* bmc_ic3_cube_copy ARGS((const int* cube));
+static boolean bmc_ic3_cube_subsumes ARGS((const int* c, const int* d));
+
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [Solves the given invariant with IC3]
+
+  Description        [Frames are added up to max_k. If the property is
+  proved true and invar_file is not NULL, the inductive invariant
+  found is written to invar_file as an INVAR declaration.
+
+  Returns 1 if the solver is not available or the invariant cannot be
+  written, 0 otherwise.]
+
+  SideEffects        [The status of the property is set]
+
+  SeeAlso            [Bmc_GenSolveInvarItp]
+
+******************************************************************************/
+int Bmc_GenSolveInvarIc3(Prop_ptr invarprop, const int max_k,
+                         const char* invar_file)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_invar_ic3");
+  res = bmc_gen_solve_invar_ic3(invarprop, max_k, invar_file);
+  Profile_end("bmc_gen_solve_invar_ic3");
+
+  return res;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveInvarIc3]
+
+  Description        [See Bmc_GenSolveInvarIc3]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveInvarIc3]
+
+******************************************************************************/
+static int bmc_gen_solve_invar_ic3(Prop_ptr invarprop, const int max_k,
+                                   const char* invar_file)
+{
+  node_ptr binvarspec;  /* Its booleanization */
+  be_ptr be_invar;  /* Its BE representation */
+  BeFsm_ptr be_fsm; /* The corresponding be fsm */
+  BeEnc_ptr be_enc;
+
+  /* Used in rewriting */
+  Prop_ptr newprop = PROP(NULL);
+  Prop_ptr oldprop;
+  boolean was_rewritten;
+  SymbLayer_ptr layer = SYMB_LAYER(NULL);
+  SymbTable_ptr st;
+
+  BmcIc3* ic3;
+  BmcIc3Obligation* cex = (BmcIc3Obligation*) NULL;
+  int fixpoint = 0;
+  int res = 0;
+
+  /* checks that a property was selected: */
+  nusmv_assert(invarprop != PROP(NULL));
+
+  /* checks if it has already been checked: */
+  if (Prop_get_status(invarprop) != Prop_Unchecked) {
+    /* aborts this check */
+    return 0;
+  }
+
+  be_fsm = Prop_compute_ground_be_fsm(invarprop, global_fsm_builder);
+  BE_FSM_CHECK_INSTANCE(be_fsm);
+
+  /* save the original property in case of rewrite */
+  oldprop = invarprop;
+
+  st = BaseEnc_get_symb_table(BASE_ENC(BeFsm_get_be_encoding(be_fsm)));
+
+  was_rewritten = false;
+  if (Prop_needs_rewriting(invarprop)) {
+    /* Create a new temporary layer */
+    layer = SymbTable_get_layer(st, BMC_IC3_REWRITE_INVARSPEC_LAYER_NAME);
+
+    if (SYMB_LAYER(NULL) == layer) {
+      layer = SymbTable_create_layer(st,
+                                     BMC_IC3_REWRITE_INVARSPEC_LAYER_NAME,
+                                     SYMB_LAYER_POS_BOTTOM);
+
+      /* Set the layer in artifacts calss to avoid new symbols to appear
+         in traces */
+      SymbTable_layer_add_to_class(st, SymbLayer_get_name(layer),
+                                   ARTIFACTS_LAYERS_CLASS);
+    }
+
+    /* Rewrite the property */
+    newprop = Bmc_rewrite_invar(invarprop, Enc_get_bdd_encoding(), layer);
+
+    /* Assign the rewritten property to invarprop */
+    invarprop = newprop;
+
+    be_fsm = Prop_get_be_fsm(invarprop);
+
+    /* Remember that we are performing a rewrite */
+    was_rewritten = true;
+  }
+
+  be_enc = BeFsm_get_be_encoding(be_fsm);
+
+  /* Booleanizes and NNFs the invariant formula: */
+  binvarspec = Wff2Nnf(Compile_detexpr2bexpr(Enc_get_bdd_encoding(),
+                                             Prop_get_expr_core(invarprop)));
+  be_invar = Bmc_Conv_Bexp2Be(be_enc, binvarspec);
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    fprintf(nusmv_stderr, "\nSolving invariant problem (IC3)\n");
+  }
+
+  ic3 = bmc_ic3_create(be_fsm, be_invar);
+  if ((BmcIc3*) NULL == ic3) {
+    fprintf(nusmv_stderr, "Sat solver '%s' is not available.\n",
+            get_sat_solver(OptsHandler_get_instance()));
+    res = 1;
+  }
+  else {
+    /* counterexamples of length 0 */
+    if (bmc_ic3_solve(ic3, 0, false, ic3->act_bad, (int*) NULL, false) ==
+        SAT_SOLVER_SATISFIABLE_PROBLEM) {
+      cex = bmc_ic3_new_obligation(ic3, bmc_ic3_model_cube(ic3), 0,
+                                   (BmcIc3Obligation*) NULL);
+    }
+
+    bmc_ic3_new_frame(ic3);
+
+    while ((BmcIc3Obligation*) NULL == cex && 0 == fixpoint) {
+      int k = bmc_ic3_top(ic3);
+
+      if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+        fprintf(nusmv_stderr, "\nBlocking the bad states in frame %d\n", k);
+      }
+
+      /* blocks the bad states in the last frame */
+      while ((BmcIc3Obligation*) NULL == cex &&
+             bmc_ic3_solve(ic3, k, false, ic3->act_bad, (int*) NULL, false)
+             == SAT_SOLVER_SATISFIABLE_PROBLEM) {
+        cex = bmc_ic3_block(ic3, bmc_ic3_model_cube(ic3));
+      }
+      if ((BmcIc3Obligation*) NULL != cex) break;
+
+      /* pushes the lemmas forward into a new frame */
+      bmc_ic3_new_frame(ic3);
+      fixpoint = bmc_ic3_propagate(ic3);
+
+      if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+        int i;
+        fprintf(nusmv_stderr, "Lemmas per frame:");
+        for (i = 1; i <= bmc_ic3_top(ic3); ++i) {
+          int j, num = 0;
+          for (j = 0; j < ic3->frames[i].num; ++j) {
+            if (ic3->frames[i].lemmas[j]->level == i) ++num;
+          }
+          fprintf(nusmv_stderr, " %d", num);
+        }
+        fprintf(nusmv_stderr, " (%ld queries)\n", ic3->queries);
+      }
+
+      if (0 == fixpoint && k >= max_k) {
+        fprintf(nusmv_stdout,
+                "-- no proof or counterexample found with %d frames\n", k);
+        break;
+      }
+    }
+
+    if ((BmcIc3Obligation*) NULL != cex) {
+      fprintf(nusmv_stdout, "-- ");
+      print_invar(nusmv_stdout, oldprop);
+      fprintf(nusmv_stdout, "  is false\n");
+      Prop_set_status(invarprop, Prop_False);
+
+      if (opt_counter_examples(OptsHandler_get_instance())) {
+        Trace_ptr trace = bmc_ic3_print_counterexample(ic3, cex, be_invar,
+                                                       invarprop);
+        Prop_set_trace(invarprop, Trace_get_id(trace));
+      }
+    }
+    else if (0 != fixpoint) {
+      fprintf(nusmv_stdout, "-- ");
+      print_invar(nusmv_stdout, oldprop);
+      fprintf(nusmv_stdout, "  is true\n");
+      Prop_set_status(invarprop, Prop_True);
+
+      if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+        fprintf(nusmv_stderr, "Frame %d is an inductive invariant\n",
+                fixpoint + 1);
+      }
+
+      if ((char*) NULL != invar_file) {
+        FILE* out = fopen(invar_file, "w");
+
+        if ((FILE*) NULL == out) {
+          fprintf(nusmv_stderr, "Unable to open file \"%s\".\n", invar_file);
+          res = 1;
+        }
+        else {
+          bmc_ic3_print_invariant(ic3, out, fixpoint, oldprop);
+          fclose(out);
+        }
+      }
+    }
+
+    bmc_ic3_destroy(ic3);
+  }
+
+  if (was_rewritten) {
+    SYMB_LAYER_CHECK_INSTANCE(layer);
+
+    /* Save the results in the original property */
+    Prop_set_trace(oldprop, Prop_get_trace(invarprop));
+    Prop_set_status(oldprop, Prop_get_status(newprop));
+
+    /* Perform cleanup */
+    Bmc_rewrite_cleanup(newprop, Enc_get_bdd_encoding(), layer);
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Creates the IC3 engine]
+
+  Description        [The initial states, the transition relation and
+  the bad states are given to the solver, each one guarded by its
+  activation literal. The invariants of the fsm hold at time 0
+  permanently. No frame is created.
+
+  Returns NULL if the SAT solver is not available.]
+
+  SideEffects        []
+
+  SeeAlso            [bmc_ic3_destroy]
+
+******************************************************************************/
+static BmcIc3* bmc_ic3_create(BeFsm_ptr be_fsm, be_ptr be_invar)
+{
+  BmcIc3* self;
+  SatSolver_ptr solver;
+  BeEnc_ptr be_enc = BeFsm_get_be_encoding(be_fsm);
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
+  BeVarType type = BE_VAR_TYPE_CURR | BE_VAR_TYPE_FROZEN;
+  be_ptr trans;
+  Be_Cnf_ptr cnf;
+  int idx, capacity;
+
+  solver = Sat_CreateNonIncSolver(get_sat_solver(OptsHandler_get_instance()));
+  if (SAT_SOLVER(NULL) == solver) return (BmcIc3*) NULL;
+
+  self = ALLOC(BmcIc3, 1);
+  nusmv_assert((BmcIc3*) NULL != self);
+
+  self->be_fsm = be_fsm;
+  self->be_enc = be_enc;
+  self->be_mgr = be_mgr;
+  self->solver = solver;
+  self->queries = 0;
+
+  /* builds the transition relation first, so that time 1 exists */
+  trans = Bmc_Model_GetUnrolling(be_fsm, 0, 1);
+
+  /* the state variables */
+  capacity = BMC_IC3_INITIAL_CAPACITY;
+  self->vars = ALLOC(int, capacity);
+  self->vars_num = 0;
+  for (idx = BeEnc_get_first_untimed_var_index(be_enc, type);
+       BeEnc_is_var_index_valid(be_enc, idx);
+       idx = BeEnc_get_next_var_index(be_enc, idx, type)) {
+    if (self->vars_num == capacity) {
+      capacity *= 2;
+      self->vars = REALLOC(int, self->vars, capacity);
+    }
+    self->vars[self->vars_num++] = idx;
+  }
+
+  self->cnf_curr = ALLOC(int, self->vars_num + 1);
+  self->cnf_next = ALLOC(int, self->vars_num + 1);
+  self->marks = ALLOC(char, self->vars_num + 1);
+  self->curr2pos = new_assoc();
+  self->next2pos = new_assoc();
+
+  /* the conversion associates the variables with their CNF variables,
+     which may differ from the literals of the (trivial) formulae */
+  for (idx = 0; idx < self->vars_num; ++idx) {
+    be_ptr var;
+
+    var = BeEnc_index_to_timed(be_enc, self->vars[idx], 0);
+    cnf = Be_ConvertToCnf(be_mgr, var, 1);
+    self->cnf_curr[idx] = Be_BeIndex2CnfLiteral(be_mgr,
+                                              Be_Var2Index(be_mgr, var));
+    Be_Cnf_Delete(cnf);
+
+    var = BeEnc_index_to_timed(be_enc, self->vars[idx], 1);
+    cnf = Be_ConvertToCnf(be_mgr, var, 1);
+    self->cnf_next[idx] = Be_BeIndex2CnfLiteral(be_mgr,
+                                              Be_Var2Index(be_mgr, var));
+    Be_Cnf_Delete(cnf);
+
+    nusmv_assert(self->cnf_curr[idx] > 0 && self->cnf_next[idx] > 0);
+
+    insert_assoc(self->curr2pos, NODE_FROM_INT(self->cnf_curr[idx]),
+                 NODE_FROM_INT(idx + 1));
+    insert_assoc(self->next2pos, NODE_FROM_INT(self->cnf_next[idx]),
+                 NODE_FROM_INT(idx + 1));
+    self->marks[idx] = 0;
+  }
+
+  /* the invariants at time 0 hold in every query */
+  cnf = SatSolver_add_be(solver, be_mgr, Bmc_Model_GetInvarAtTime(be_fsm, 0),
+                         1, SatSolver_get_permanent_group(solver));
+  SatSolver_set_polarity(solver, cnf, 1, SatSolver_get_permanent_group(solver));
+  Be_Cnf_Delete(cnf);
+
+  self->act_init = Be_NewCnfVar(be_mgr);
+  self->act_trans = Be_NewCnfVar(be_mgr);
+  self->act_bad = Be_NewCnfVar(be_mgr);
+
+  bmc_ic3_add_guarded(self,
+                      BeEnc_untimed_expr_to_timed(be_enc,
+                                                  BeFsm_get_init(be_fsm), 0),
+                      self->act_init);
+  bmc_ic3_add_guarded(self, trans, self->act_trans);
+  bmc_ic3_add_guarded(self,
+                      BeEnc_untimed_expr_to_timed(be_enc,
+                                         Be_Not(be_mgr, be_invar), 0),
+                      self->act_bad);
+
+  /* frame 0 stands for the initial states */
+  self->frames_capacity = BMC_IC3_INITIAL_CAPACITY;
+  self->frames = ALLOC(BmcIc3Frame, self->frames_capacity);
+  self->acts = ALLOC(int, self->frames_capacity);
+  self->frames[0].lemmas = (BmcIc3Lemma**) NULL;
+  self->frames[0].num = 0;
+  self->frames[0].capacity = 0;
+  self->acts[0] = self->act_init;
+  self->frames_num = 1;
+
+  self->lemmas = Slist_create();
+  self->obligations = Slist_create();
+
+  return self;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Destroys the IC3 engine]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            [bmc_ic3_create]
+
+******************************************************************************/
+static void bmc_ic3_destroy(BmcIc3* self)
+{
+  Siter iter;
+  int i;
+
+  SLIST_FOREACH(self->lemmas, iter) {
+    BmcIc3Lemma* lemma = (BmcIc3Lemma*) Siter_element(iter);
+    FREE(lemma->cube);
+    FREE(lemma);
+  }
+  Slist_destroy(self->lemmas);
+
+  SLIST_FOREACH(self->obligations, iter) {
+    BmcIc3Obligation* ob = (BmcIc3Obligation*) Siter_element(iter);
+    FREE(ob->cube);
+    FREE(ob);
+  }
+  Slist_destroy(self->obligations);
+
+  for (i = 1; i < self->frames_num; ++i) FREE(self->frames[i].lemmas);
+  FREE(self->frames);
+  FREE(self->acts);
+
+  free_assoc(self->curr2pos);
+  free_assoc(self->next2pos);
+  FREE(self->marks);
+  FREE(self->cnf_next);
+  FREE(self->cnf_curr);
+  FREE(self->vars);
+
+  SatSolver_destroy(self->solver);
+  FREE(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Adds prob to the solver, guarded by the given
+  activation literal]
+
+  Description        [prob holds whenever act is assumed]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void bmc_ic3_add_guarded(BmcIc3* self, be_ptr prob, int act)
+{
+  SatSolverGroup group = SatSolver_get_permanent_group(self->solver);
+  Be_Cnf_ptr cnf;
+  int clause[2];
+
+  if (Be_IsTrue(self->be_mgr, prob)) return;
+
+  clause[0] = -act;
+  if (Be_IsFalse(self->be_mgr, prob)) {
+    SatSolver_add_clause(self->solver, clause, 1, group);
+    return;
+  }
+
+  cnf = SatSolver_add_be(self->solver, self->be_mgr, prob, 1, group);
+  clause[1] = Be_Cnf_GetFormulaLiteral(cnf);
+  SatSolver_add_clause(self->solver, clause, 2, group);
+  Be_Cnf_Delete(cnf);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Appends a new empty frame]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void bmc_ic3_new_frame(BmcIc3* self)
+{
+  BmcIc3Frame* frame;
+
+  if (self->frames_num == self->frames_capacity) {
+    self->frames_capacity *= 2;
+    self->frames = REALLOC(BmcIc3Frame, self->frames, self->frames_capacity);
+    self->acts = REALLOC(int, self->acts, self->frames_capacity);
+  }
+
+  frame = &(self->frames[self->frames_num]);
+  frame->capacity = BMC_IC3_INITIAL_CAPACITY;
+  frame->lemmas = ALLOC(BmcIc3Lemma*, frame->capacity);
+  frame->num = 0;
+
+  self->acts[self->frames_num] = Be_NewCnfVar(self->be_mgr);
+  self->frames_num += 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Returns the index of the last frame]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static int bmc_ic3_top(const BmcIc3* self)
+{
+  return self->frames_num - 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Solves a query]
+
+  Description        [Frame level (0 for the initial states) is
+  activated. If trans is true the transition relation is activated,
+  if act is not 0 it is assumed as well. The literals of cube, if any,
+  are assumed at time 1 if next is true, at time 0 otherwise.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static SatSolverResult bmc_ic3_solve(BmcIc3* self, int level, boolean trans,
+                                     int act, const int* cube, boolean next)
+{
+  Slist_ptr assumptions = Slist_create();
+  SatSolverResult res;
+  int i;
+
+  if (0 == level) Slist_push(assumptions, PTR_FROM_INT(void*, self->act_init));
+  for (i = (0 == level) ? 1 : level; i < self->frames_num; ++i) {
+    Slist_push(assumptions, PTR_FROM_INT(void*, self->acts[i]));
+  }
+  if (trans) Slist_push(assumptions, PTR_FROM_INT(void*, self->act_trans));
+  if (0 != act) Slist_push(assumptions, PTR_FROM_INT(void*, act));
+
+  if ((int*) NULL != cube) {
+    const int* cnf = next ? self->cnf_next : self->cnf_curr;
+
+    for (i = 1; i <= cube[0]; ++i) {
+      int lit = cnf[abs(cube[i]) - 1];
+      Slist_push(assumptions, PTR_FROM_INT(void*, (cube[i] > 0) ? lit : -lit));
+    }
+  }
+
+  self->queries += 1;
+  res = SatSolver_solve_all_groups_assume(self->solver, assumptions);
+  Slist_destroy(assumptions);
+
+  if (SAT_SOLVER_SATISFIABLE_PROBLEM != res &&
+      SAT_SOLVER_UNSATISFIABLE_PROBLEM != res) {
+    internal_error("Sorry, solver answered with a fatal Internal "
+                   "Failure during problem solving.\n");
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Returns the cube of the state at time 0 in the
+  model of the last query]
+
+  Description        [The returned cube must be freed by the caller]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static int* bmc_ic3_model_cube(BmcIc3* self)
+{
+  int* cube = ALLOC(int, self->vars_num + 1);
+  Slist_ptr model = SatSolver_get_model(self->solver);
+  Siter iter;
+  int i, num;
+
+  for (i = 0; i < self->vars_num; ++i) self->marks[i] = 0;
+
+  SLIST_FOREACH(model, iter) {
+    int lit = PTR_TO_INT(Siter_element(iter));
+    int pos = NODE_TO_INT(find_assoc(self->curr2pos, NODE_FROM_INT(abs(lit))));
+
+    if (0 != pos) self->marks[pos - 1] = (lit > 0) ? 1 : -1;
+  }
+
+  /* variables not occurring in the solver are not constrained */
+  num = 0;
+  for (i = 0; i < self->vars_num; ++i) {
+    if (0 != self->marks[i]) {
+      cube[++num] = self->marks[i] * (i + 1);
+      self->marks[i] = 0;
+    }
+  }
+  cube[0] = num;
+
+  return cube;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Checks whether the cube contains initial states]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static boolean bmc_ic3_intersects_init(BmcIc3* self, const int* cube)
+{
+  return bmc_ic3_solve(self, 0, false, 0, cube, false) ==
+    SAT_SOLVER_SATISFIABLE_PROBLEM;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Checks whether the cube is inductive relative to
+  the given frame]
+
+  Description        [Solves F(level) & !cube & T & cube'. If the query
+  is unsatisfiable and core is not NULL, *core is set to the literals
+  of the cube occurring in the failed assumptions. If the query is
+  satisfiable and pred is not NULL, *pred is set to the predecessor
+  found. The returned cubes must be freed by the caller.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static boolean bmc_ic3_is_relative_inductive(BmcIc3* self, const int* cube,
+                                             int level, int** core,
+                                             int** pred)
+{
+  SatSolverGroup group = SatSolver_get_permanent_group(self->solver);
+  int* clause = ALLOC(int, cube[0] + 1);
+  int act = Be_NewCnfVar(self->be_mgr);
+  boolean res;
+  int i;
+
+  /* the temporary clause !cube, guarded by its own activation literal */
+  clause[0] = -act;
+  for (i = 1; i <= cube[0]; ++i) {
+    int lit = self->cnf_curr[abs(cube[i]) - 1];
+    clause[i] = (cube[i] > 0) ? -lit : lit;
+  }
+  SatSolver_add_clause(self->solver, clause, cube[0] + 1, group);
+
+  res = (bmc_ic3_solve(self, level, true, act, cube, true) ==
+         SAT_SOLVER_UNSATISFIABLE_PROBLEM);
+
+  if (res && (int**) NULL != core) {
+    Slist_ptr conflict = SatSolver_get_conflicts(self->solver);
+    Siter iter;
+    int num = 0;
+
+    SLIST_FOREACH(conflict, iter) {
+      int lit = PTR_TO_INT(Siter_element(iter));
+      int pos = NODE_TO_INT(find_assoc(self->next2pos,
+                                       NODE_FROM_INT(abs(lit))));
+      if (0 != pos) self->marks[pos - 1] = 1;
+    }
+
+    *core = ALLOC(int, cube[0] + 1);
+    for (i = 1; i <= cube[0]; ++i) {
+      if (self->marks[abs(cube[i]) - 1]) (*core)[++num] = cube[i];
+    }
+    (*core)[0] = num;
+
+    for (i = 1; i <= cube[0]; ++i) self->marks[abs(cube[i]) - 1] = 0;
+  }
+  else if (!res && (int**) NULL != pred) {
+    *pred = bmc_ic3_model_cube(self);
+  }
+
+  /* retires the temporary clause */
+  clause[0] = -act;
+  SatSolver_add_clause(self->solver, clause, 1, group);
+  FREE(clause);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Generalizes a cube which is inductive relative to
+  the given frame]
+
+  Description        [core is the unsat core of the query on cube, and
+  is taken by the function. The result is a sub-cube of cube which
+  contains no initial state and is still inductive relative to the
+  frame. Literals are dropped one at a time.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static int* bmc_ic3_generalize(BmcIc3* self, const int* cube, int* core,
+                               int level)
+{
+  int* res;
+  int i;
+
+  if (0 == core[0] || bmc_ic3_intersects_init(self, core)) {
+    FREE(core);
+    res = bmc_ic3_cube_copy(cube);
+  }
+  else res = core;
+
+  i = 1;
+  while (i <= res[0] && res[0] > 1) {
+    int* cand = ALLOC(int, res[0]);
+    int* cand_core = (int*) NULL;
+    int j, num = 0;
+
+    for (j = 1; j <= res[0]; ++j) {
+      if (j != i) cand[++num] = res[j];
+    }
+    cand[0] = num;
+
+    if (!bmc_ic3_intersects_init(self, cand) &&
+        bmc_ic3_is_relative_inductive(self, cand, level, &cand_core,
+                                      (int**) NULL)) {
+      FREE(res);
+      if (0 < cand_core[0] && cand_core[0] < cand[0] &&
+          !bmc_ic3_intersects_init(self, cand_core)) {
+        FREE(cand);
+        res = cand_core;
+      }
+      else {
+        FREE(cand_core);
+        res = cand;
+      }
+      /* the literal at position i has been dropped: tries the next
+         one, which now is at position i */
+    }
+    else {
+      if ((int*) NULL != cand_core) FREE(cand_core);
+      FREE(cand);
+      ++i;
+    }
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Adds the lemma !cube to frames 1..level]
+
+  Description        [The cube is taken by the function. The lemmas of
+  frames 1..level subsumed by the new one are discarded.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void bmc_ic3_add_lemma(BmcIc3* self, int* cube, int level)
+{
+  SatSolverGroup group = SatSolver_get_permanent_group(self->solver);
+  BmcIc3Lemma* lemma;
+  BmcIc3Frame* frame;
+  int* clause;
+  int i, j;
+
+  /* discards the subsumed lemmas */
+  for (i = 1; i <= level; ++i) {
+    for (j = 0; j < self->frames[i].num; ++j) {
+      BmcIc3Lemma* old = self->frames[i].lemmas[j];
+      if (old->level == i && bmc_ic3_cube_subsumes(cube, old->cube)) {
+        old->level = 0;
+      }
+    }
+  }
+
+  lemma = ALLOC(BmcIc3Lemma, 1);
+  lemma->cube = cube;
+  lemma->level = level;
+  Slist_push(self->lemmas, lemma);
+
+  frame = &(self->frames[level]);
+  if (frame->num == frame->capacity) {
+    frame->capacity *= 2;
+    frame->lemmas = REALLOC(BmcIc3Lemma*, frame->lemmas, frame->capacity);
+  }
+  frame->lemmas[frame->num++] = lemma;
+
+  clause = ALLOC(int, cube[0] + 1);
+  clause[0] = -self->acts[level];
+  for (i = 1; i <= cube[0]; ++i) {
+    int lit = self->cnf_curr[abs(cube[i]) - 1];
+    clause[i] = (cube[i] > 0) ? -lit : lit;
+  }
+  SatSolver_add_clause(self->solver, clause, cube[0] + 1, group);
+  FREE(clause);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Checks whether the cube is already blocked in the
+  given frame by a lemma]
+
+  Description        [The check is syntactic]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static boolean bmc_ic3_is_blocked(BmcIc3* self, const int* cube, int level)
+{
+  int i, j;
+
+  for (i = level; i < self->frames_num; ++i) {
+    for (j = 0; j < self->frames[i].num; ++j) {
+      BmcIc3Lemma* lemma = self->frames[i].lemmas[j];
+      if (lemma->level == i && bmc_ic3_cube_subsumes(lemma->cube, cube)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Creates a proof obligation]
+
+  Description        [The cube is taken by the obligation]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static BmcIc3Obligation* bmc_ic3_new_obligation(BmcIc3* self, int* cube,
+                                                int level,
+                                                BmcIc3Obligation* next)
+{
+  BmcIc3Obligation* ob = ALLOC(BmcIc3Obligation, 1);
+
+  ob->cube = cube;
+  ob->level = level;
+  ob->next = next;
+  Slist_push(self->obligations, ob);
+
+  return ob;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Blocks a bad state in the last frame]
+
+  Description        [The cube is taken by the function. Obligations are
+  handled lowest level first. Returns NULL if the cube has been
+  blocked, otherwise the obligation of an initial state which reaches
+  it.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static BmcIc3Obligation* bmc_ic3_block(BmcIc3* self, int* cube)
+{
+  BmcIc3Obligation* res = (BmcIc3Obligation*) NULL;
+  int top = bmc_ic3_top(self);
+  heap queue = heap_create();
+
+  heap_add(queue, (float) -top,
+           bmc_ic3_new_obligation(self, cube, top, (BmcIc3Obligation*) NULL));
+
+  while (!heap_isempty(queue)) {
+    BmcIc3Obligation* ob = (BmcIc3Obligation*) heap_getmax(queue);
+    int* core = (int*) NULL;
+    int* pred = (int*) NULL;
+
+    if ((BmcIc3Obligation*) NULL != res) continue; /* drains the queue */
+
+    nusmv_assert(ob->level > 0);
+    if (bmc_ic3_is_blocked(self, ob->cube, ob->level)) continue;
+
+    if (bmc_ic3_is_relative_inductive(self, ob->cube, ob->level - 1,
+                                      &core, &pred)) {
+      int* lemma = bmc_ic3_generalize(self, ob->cube, core, ob->level - 1);
+      int level = ob->level;
+
+      /* pushes the lemma as far as possible */
+      while (level < top &&
+             bmc_ic3_is_relative_inductive(self, lemma, level,
+                                           (int**) NULL, (int**) NULL)) {
+        ++level;
+      }
+
+      if (opt_verbose_level_gt(OptsHandler_get_instance(), 2)) {
+        fprintf(nusmv_stderr, "Lemma of %d literals (out of %d) "
+                "added to frame %d\n", lemma[0], ob->cube[0], level);
+      }
+
+      bmc_ic3_add_lemma(self, lemma, level);
+
+      /* looks for longer counterexamples through the same cube */
+      if (level < top) {
+        ob->level = level + 1;
+        heap_add(queue, (float) -ob->level, ob);
+      }
+    }
+    else {
+      BmcIc3Obligation* pob =
+        bmc_ic3_new_obligation(self, pred, ob->level - 1, ob);
+
+      if (0 == pob->level || bmc_ic3_intersects_init(self, pred)) {
+        res = pob;
+      }
+      else {
+        heap_add(queue, (float) -pob->level, pob);
+        heap_add(queue, (float) -ob->level, ob);
+      }
+    }
+  }
+
+  heap_destroy(queue);
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Pushes the lemmas to the following frames]
+
+  Description        [A lemma of frame i is moved to frame i+1 when it
+  is inductive relative to frame i. Returns the first frame i which
+  has no lemmas left, i.e. such that frame i+1 is an inductive
+  invariant, or 0 if there is no such frame.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static int bmc_ic3_propagate(BmcIc3* self)
+{
+  SatSolverGroup group = SatSolver_get_permanent_group(self->solver);
+  int top = bmc_ic3_top(self);
+  int i;
+
+  for (i = 1; i < top; ++i) {
+    BmcIc3Frame* frame = &(self->frames[i]);
+    int j, num = 0;
+
+    for (j = 0; j < frame->num; ++j) {
+      BmcIc3Lemma* lemma = frame->lemmas[j];
+
+      if (lemma->level != i) continue;
+
+      if (bmc_ic3_solve(self, i, true, 0, lemma->cube, true) ==
+          SAT_SOLVER_UNSATISFIABLE_PROBLEM) {
+        BmcIc3Frame* next = &(self->frames[i + 1]);
+        int* clause = ALLOC(int, lemma->cube[0] + 1);
+        int k;
+
+        lemma->level = i + 1;
+        if (next->num == next->capacity) {
+          next->capacity *= 2;
+          next->lemmas = REALLOC(BmcIc3Lemma*, next->lemmas, next->capacity);
+        }
+        next->lemmas[next->num++] = lemma;
+
+        clause[0] = -self->acts[i + 1];
+        for (k = 1; k <= lemma->cube[0]; ++k) {
+          int lit = self->cnf_curr[abs(lemma->cube[k]) - 1];
+          clause[k] = (lemma->cube[k] > 0) ? -lit : lit;
+        }
+        SatSolver_add_clause(self->solver, clause, lemma->cube[0] + 1,
+                             group);
+        FREE(clause);
+      }
+    }
+
+    /* compacts the frame */
+    for (j = 0; j < frame->num; ++j) {
+      if (frame->lemmas[j]->level == i) frame->lemmas[num++] = frame->lemmas[j];
+    }
+    frame->num = num;
+
+    if (0 == num) return i;
+  }
+
+  return 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Prints the counterexample of the given chain of
+  obligations]
+
+  Description        [The chain starts from an initial state and ends
+  into a bad state. Since each obligation contains a whole state, the
+  trace is built by solving the bounded problem constrained by the
+  states of the chain.]
+
+  SideEffects        [The trace is registered into the trace manager]
+
+  SeeAlso            []
+
+******************************************************************************/
+static Trace_ptr bmc_ic3_print_counterexample(BmcIc3* self,
+                                              BmcIc3Obligation* chain,
+                                              be_ptr be_invar,
+                                              Prop_ptr invarprop)
+{
+  BoolSexpFsm_ptr bsexp_fsm; /* needed for trace language */
+  SatSolver_ptr solver;
+  Be_Cnf_ptr cnf;
+  BmcIc3Obligation* ob;
+  Trace_ptr trace;
+  be_ptr prob;
+  int k;
+
+  prob = Bmc_Model_GetInit0(self->be_fsm);
+  for (ob = chain, k = 0; (BmcIc3Obligation*) NULL != ob; ob = ob->next, ++k) {
+    prob = Be_And(self->be_mgr, prob, bmc_ic3_cube_to_be(self, ob->cube, k));
+  }
+  k -= 1;
+
+  prob = Be_And(self->be_mgr, prob,
+                Be_And(self->be_mgr, Bmc_Model_GetUnrolling(self->be_fsm, 0, k),
+                       BeEnc_untimed_expr_to_timed(self->be_enc,
+                                      Be_Not(self->be_mgr, be_invar), k)));
+
+  solver = Sat_CreateNonIncSolver(get_sat_solver(OptsHandler_get_instance()));
+  nusmv_assert(SAT_SOLVER(NULL) != solver);
+
+  cnf = SatSolver_add_be(solver, self->be_mgr, prob, 1,
+                         SatSolver_get_permanent_group(solver));
+  SatSolver_set_polarity(solver, cnf, 1, SatSolver_get_permanent_group(solver));
+  Be_Cnf_Delete(cnf);
+
+  if (SatSolver_solve_all_groups(solver) != SAT_SOLVER_SATISFIABLE_PROBLEM) {
+    internal_error("%s:%d:%s: the counterexample cannot be reproduced",
+                   __FILE__, __LINE__, __func__);
+  }
+
+  bsexp_fsm = Prop_get_bool_sexp_fsm(invarprop);
+  if (BOOL_SEXP_FSM(NULL) == bsexp_fsm) {
+    bsexp_fsm = PropDb_master_get_bool_sexp_fsm(PropPkg_get_prop_database());
+    BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
+  }
+
+  trace = Bmc_Utils_generate_and_print_cntexample(self->be_enc, solver,
+                               prob, k, "IC3 Counterexample",
+                               SexpFsm_get_symbols_list(SEXP_FSM(bsexp_fsm)));
+  SatSolver_destroy(solver);
+
+  return trace;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Converts a cube into a BE at the given time]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static be_ptr bmc_ic3_cube_to_be(BmcIc3* self, const int* cube, int time)
+{
+  be_ptr res = Be_Truth(self->be_mgr);
+  int i;
+
+  for (i = 1; i <= cube[0]; ++i) {
+    be_ptr var = BeEnc_index_to_timed(self->be_enc,
+                                      self->vars[abs(cube[i]) - 1], time);
+    if (cube[i] < 0) var = Be_Not(self->be_mgr, var);
+    res = Be_And(self->be_mgr, res, var);
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Prints the inductive invariant as an INVAR
+  declaration]
+
+  Description        [The invariant is the conjunction of the lemmas of
+  the frames following the given one. Variables are those of the
+  boolean encoding of the model, as printed by write_boolean_model.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void bmc_ic3_print_invariant(BmcIc3* self, FILE* out, int level,
+                                    Prop_ptr invarprop)
+{
+  Siter iter;
+  boolean first = true;
+
+  fprintf(out, "-- inductive invariant proving ");
+  print_invar(out, invarprop);
+  fprintf(out, "\n-- over the boolean encoding of the model\n");
+  fprintf(out, "INVAR\n");
+
+  SLIST_FOREACH(self->lemmas, iter) {
+    BmcIc3Lemma* lemma = (BmcIc3Lemma*) Siter_element(iter);
+    int i;
+
+    if (lemma->level <= level) continue;
+
+    fprintf(out, first ? "  (" : "  & (");
+    first = false;
+
+    for (i = 1; i <= lemma->cube[0]; ++i) {
+      int lit = lemma->cube[i];
+
+      if (i > 1) fprintf(out, " | ");
+      /* the clause is the negation of the cube */
+      if (lit > 0) fprintf(out, "!");
+      print_node(out, BeEnc_index_to_name(self->be_enc,
+                                          self->vars[abs(lit) - 1]));
+    }
+    fprintf(out, ")\n");
+  }
+
+  if (first) fprintf(out, "  TRUE\n");
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Returns a copy of the cube]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static int* bmc_ic3_cube_copy(const int* cube)
+{
+  int* res = ALLOC(int, cube[0] + 1);
+  int i;
+
+  for (i = 0; i <= cube[0]; ++i) res[i] = cube[i];
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Checks whether the literals of c are contained
+  in d]
+
+  Description        [Both cubes are sorted by variable]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static boolean bmc_ic3_cube_subsumes(const int* c, const int* d)
+{
+  int i = 1, j = 1;
+
+  if (c[0] > d[0]) return false;
+
+  while (i <= c[0]) {
+    while (j <= d[0] && abs(d[j]) < abs(c[i])) ++j;
+    if (j > d[0] || d[j] != c[i]) return false;
+    ++i; ++j;
+  }
+
+  return true;
+}
@@ -85,6 +85,10 @@
 #define DEFAULT_BMC_PB_LOOP         Bmc_Utils_GetAllLoopbacksString()
 #define DEFAULT_BMC_INVAR_ALG       "classic"
 #define DEFAULT_BMC_INC_INVAR_ALG   "dual"
+#define DEFAULT_BMC_PARALLEL_BOUNDS 1
+#define DEFAULT_BMC_PORTFOLIO_SIZE  1
+#define DEFAULT_BMC_PORTFOLIO_SHARE_UNITS 1
+#define DEFAULT_BMC_SWEEPING 0
 #define DEFAULT_BMC_OPTIMIZED_TABLEAU 1
 #define DEFAULT_BMC_FORCE_PLTL_TABLEAU 0
 
@@ -277,6 +281,14 @@ Bmc_fill_trace_from_cnf_model ARGS((const BeEnc_ptr be_enc,
                                     const Slist_ptr cnf_model,
                                     int k, Trace_ptr trace));
 
+EXTERN Trace_ptr
+Bmc_create_trace_from_be_model ARGS((const BeEnc_ptr be_enc,
+                                     const NodeList_ptr symbols,
+                                     const char* desc,
+                                     const TraceType type,
+                                     const Slist_ptr be_model,
+                                     int k));
+
 /* internal bmc/trace utils */
 EXTERN void
 bmc_trace_utils_complete_trace ARGS((Trace_ptr trace,
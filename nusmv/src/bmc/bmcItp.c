@@ -0,0 +1,651 @@
+/**CFile***********************************************************************
+
+  FileName    [bmcItp.c]
+
+  PackageName [bmc]
+
+  Synopsis    [Interpolation based invariant checking]
+
+  Description [Implements McMillan's interpolation based reachability
+  over the BE fsm. The set of reached states is over-approximated by
+  the interpolants of bounded unrollings, and the fixpoint is checked
+  with SAT.]
+
+  SeeAlso     [bmcBmcInc.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``bmc'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#if HAVE_CONFIG_H
+#include "nusmv-config.h"
+#endif
+
+#include "bmcBmc.h"
+#include "bmcInt.h"
+#include "bmcConv.h"
+#include "bmcModel.h"
+#include "bmcUtils.h"
+
+#include "wff/wff.h"
+#include "wff/w2w/w2w.h"
+
+#include "enc/enc.h"
+#include "enc/be/BeEnc.h"
+#include "be/be.h"
+
+#include "prop/propPkg.h"
+#include "mc/mc.h" /* for print_invar */
+
+#include "sat/sat.h"
+#include "sat/SatSolver.h"
+#include "utils/Profile.h"
+#include "utils/error.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: bmcItp.c,v 1.1.2.1 2011-03-15 10:00:00 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* The name of the layer rewritten invariants are declared in */
+#define BMC_ITP_REWRITE_INVARSPEC_LAYER_NAME "bmc_itp_invarspec_rewrite_layer"
+
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [The user data of the interpolant term factory]
+
+  Description [Interpolants are built as BEs. The solver is needed to
+  map its variables back to CNF variables.]
+
+******************************************************************************/
+typedef struct BmcItpFactory_TAG
+{
+  SatSolver_ptr solver;
+  Be_Manager_ptr be_mgr;
+} BmcItpFactory;
+
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static int bmc_gen_solve_invar_itp ARGS((Prop_ptr invarprop,
+                                         const int max_k));
+
+static void bmc_itp_add_be ARGS((SatSolver_ptr solver,
+                                 Be_Manager_ptr be_mgr, be_ptr prob));
+
+static SatSolverResult
+bmc_itp_check_implication ARGS((BeEnc_ptr be_enc,
+                                be_ptr image, be_ptr reached));
+
+static Term bmc_itp_make_false ARGS((TermFactoryCallbacksUserData_ptr data));
+static Term bmc_itp_make_true ARGS((TermFactoryCallbacksUserData_ptr data));
+static Term bmc_itp_make_and ARGS((Term t1, Term t2,
+                                   TermFactoryCallbacksUserData_ptr data));
+static Term bmc_itp_make_or ARGS((Term t1, Term t2,
+                                  TermFactoryCallbacksUserData_ptr data));
+static Term bmc_itp_make_not ARGS((Term t,
+                                   TermFactoryCallbacksUserData_ptr data));
+static Term bmc_itp_make_var ARGS((int var,
+                                   TermFactoryCallbacksUserData_ptr data));
+
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [Solves the given invariant with interpolation]
+
+  Description        [For each bound k from 1 to max_k, the states
+  reached from the initial states are over-approximated by the
+  interpolants of the problems
+
+    R(0) & Unroll(0, 1)  and  Unroll(1, k) & (!P(1) | ... | !P(k))
+
+  where R is the set of states computed so far. If such a problem is
+  unsatisfiable, its interpolant (moved back to time 0) is added to R,
+  unless it is already contained in R, in which case R is an inductive
+  invariant and the property is true. If the problem is satisfiable
+  when R is exactly the initial states, the property is false and a
+  counterexample of length k is printed, otherwise k is increased.
+
+  A proof logging SAT solver is required.
+
+  Returns 1 if the solver is not available, 0 otherwise.]
+
+  SideEffects        [The status of the property is set]
+
+  SeeAlso            [Bmc_GenSolveInvarFalsification]
+
+******************************************************************************/
+int Bmc_GenSolveInvarItp(Prop_ptr invarprop, const int max_k)
+{
+  int res;
+
+  Profile_begin("bmc_gen_solve_invar_itp");
+  res = bmc_gen_solve_invar_itp(invarprop, max_k);
+  Profile_end("bmc_gen_solve_invar_itp");
+
+  return res;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [The body of Bmc_GenSolveInvarItp]
+
+  Description        [See Bmc_GenSolveInvarItp]
+
+  SideEffects        []
+
+  SeeAlso            [Bmc_GenSolveInvarItp]
+
+******************************************************************************/
+static int bmc_gen_solve_invar_itp(Prop_ptr invarprop, const int max_k)
+{
+  node_ptr binvarspec;  /* Its booleanization */
+  be_ptr be_invar;  /* Its BE representation */
+  BeFsm_ptr be_fsm; /* The corresponding be fsm */
+
+  BeEnc_ptr be_enc;
+  Be_Manager_ptr be_mgr;
+
+  /* Used in rewriting */
+  Prop_ptr newprop = PROP(NULL);
+  Prop_ptr oldprop;
+  boolean was_rewritten;
+  SymbLayer_ptr layer = SYMB_LAYER(NULL);
+  SymbTable_ptr st;
+
+  SatSolver_ptr solver;
+  SatSolverResult sat_res;
+  boolean solved = false;
+  int res = 0;
+  int k;
+
+  /* checks that a property was selected: */
+  nusmv_assert(invarprop != PROP(NULL));
+
+  /* checks if it has already been checked: */
+  if (Prop_get_status(invarprop) != Prop_Unchecked) {
+    /* aborts this check */
+    return 0;
+  }
+
+  be_fsm = Prop_compute_ground_be_fsm(invarprop, global_fsm_builder);
+  BE_FSM_CHECK_INSTANCE(be_fsm);
+
+  /* save the original property in case of rewrite */
+  oldprop = invarprop;
+
+  st = BaseEnc_get_symb_table(BASE_ENC(BeFsm_get_be_encoding(be_fsm)));
+
+  was_rewritten = false;
+  if (Prop_needs_rewriting(invarprop)) {
+    /* Create a new temporary layer */
+    layer = SymbTable_get_layer(st, BMC_ITP_REWRITE_INVARSPEC_LAYER_NAME);
+
+    if (SYMB_LAYER(NULL) == layer) {
+      layer = SymbTable_create_layer(st,
+                                     BMC_ITP_REWRITE_INVARSPEC_LAYER_NAME,
+                                     SYMB_LAYER_POS_BOTTOM);
+
+      /* Set the layer in artifacts calss to avoid new symbols to appear
+         in traces */
+      SymbTable_layer_add_to_class(st, SymbLayer_get_name(layer),
+                                   ARTIFACTS_LAYERS_CLASS);
+    }
+
+    /* Rewrite the property */
+    newprop = Bmc_rewrite_invar(invarprop, Enc_get_bdd_encoding(), layer);
+
+    /* Assign the rewritten property to invarprop */
+    invarprop = newprop;
+
+    be_fsm = Prop_get_be_fsm(invarprop);
+
+    /* Remember that we are performing a rewrite */
+    was_rewritten = true;
+  }
+
+  be_enc = BeFsm_get_be_encoding(be_fsm);
+  be_mgr = BeEnc_get_be_manager(be_enc);
+
+  /* Booleanizes and NNFs the invariant formula: */
+  binvarspec = Wff2Nnf(Compile_detexpr2bexpr(Enc_get_bdd_encoding(),
+                                             Prop_get_expr_core(invarprop)));
+  be_invar = Bmc_Conv_Bexp2Be(be_enc, binvarspec);
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    fprintf(nusmv_stderr, "\nSolving invariant problem (Interpolation)\n");
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /* Counterexamples of length 0                                            */
+  /* ---------------------------------------------------------------------- */
+  solver = Sat_CreateNonIncProofSolver(get_sat_solver(OptsHandler_get_instance()));
+  if (solver == SAT_SOLVER(NULL)) {
+    fprintf(nusmv_stderr,
+            "Proof logging sat solver '%s' is not available.\n",
+            get_sat_solver(OptsHandler_get_instance()));
+    res = 1;
+    solved = true;
+  }
+  else {
+    be_ptr prob = Be_And(be_mgr, Bmc_Model_GetInit0(be_fsm),
+                         BeEnc_untimed_expr_to_timed(be_enc,
+                                          Be_Not(be_mgr, be_invar), 0));
+
+    bmc_itp_add_be(solver, be_mgr, prob);
+    sat_res = SatSolver_solve_all_groups(solver);
+
+    if (sat_res == SAT_SOLVER_SATISFIABLE_PROBLEM) {
+      fprintf(nusmv_stdout, "-- ");
+      print_invar(nusmv_stdout, oldprop);
+      fprintf(nusmv_stdout, "  is false\n");
+      Prop_set_status(invarprop, Prop_False);
+
+      if (opt_counter_examples(OptsHandler_get_instance())) {
+        BoolSexpFsm_ptr bsexp_fsm; /* needed for trace language */
+        Trace_ptr trace;
+
+        bsexp_fsm = Prop_get_bool_sexp_fsm(invarprop);
+        if (BOOL_SEXP_FSM(NULL) == bsexp_fsm) {
+          bsexp_fsm = \
+            PropDb_master_get_bool_sexp_fsm(PropPkg_get_prop_database());
+          BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
+        }
+
+        trace = Bmc_Utils_generate_and_print_cntexample(be_enc, solver,
+                                   prob, 0, "BMC Counterexample",
+                                   SexpFsm_get_symbols_list(SEXP_FSM(bsexp_fsm)));
+        Prop_set_trace(invarprop, Trace_get_id(trace));
+      }
+      solved = true;
+    }
+    else if (sat_res != SAT_SOLVER_UNSATISFIABLE_PROBLEM) {
+      internal_error("Sorry, solver answered with a fatal Internal "
+                     "Failure during problem solving.\n");
+    }
+
+    SatSolver_destroy(solver);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /* Interpolation                                                          */
+  /* ---------------------------------------------------------------------- */
+  for (k = 1; k <= max_k && !solved; ++k) {
+    /* the states reached so far, and whether they are exactly the
+       initial states */
+    be_ptr reached = BeFsm_get_init(be_fsm);
+    boolean exact = true;
+    be_ptr suffix;
+    int iteration = 0;
+
+    /* the part of the problem which does not change within bound k */
+    suffix = Be_And(be_mgr, Bmc_Model_GetUnrolling(be_fsm, 1, k),
+                    BeEnc_untimed_to_timed_or_interval(be_enc,
+                                     Be_Not(be_mgr, be_invar), 1, k));
+
+    if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+      fprintf(nusmv_stderr, "\nInterpolating with bound k=%d\n", k);
+    }
+
+    while (true) {
+      SatSolverItpGroup ga;
+      be_ptr prefix;
+
+      solver = Sat_CreateNonIncProofSolver(
+                             get_sat_solver(OptsHandler_get_instance()));
+      nusmv_assert(solver != SAT_SOLVER(NULL));
+
+      prefix = Be_And(be_mgr,
+                      BeEnc_untimed_expr_to_timed(be_enc, reached, 0),
+                      Bmc_Model_GetUnrolling(be_fsm, 0, 1));
+
+      /* the groups must be opened before the clauses are added */
+      ga = SatSolver_new_itp_group(solver);
+      bmc_itp_add_be(solver, be_mgr, prefix);
+      (void) SatSolver_new_itp_group(solver);
+      bmc_itp_add_be(solver, be_mgr, suffix);
+
+      sat_res = SatSolver_solve_all_groups(solver);
+      ++iteration;
+
+      if (sat_res == SAT_SOLVER_SATISFIABLE_PROBLEM) {
+        if (exact) {
+          /* a real counterexample */
+          fprintf(nusmv_stdout, "-- ");
+          print_invar(nusmv_stdout, oldprop);
+          fprintf(nusmv_stdout, "  is false\n");
+          Prop_set_status(invarprop, Prop_False);
+
+          if (opt_counter_examples(OptsHandler_get_instance())) {
+            BoolSexpFsm_ptr bsexp_fsm; /* needed for trace language */
+            Trace_ptr trace;
+
+            bsexp_fsm = Prop_get_bool_sexp_fsm(invarprop);
+            if (BOOL_SEXP_FSM(NULL) == bsexp_fsm) {
+              bsexp_fsm = \
+                PropDb_master_get_bool_sexp_fsm(PropPkg_get_prop_database());
+              BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
+            }
+
+            trace = Bmc_Utils_generate_and_print_cntexample(be_enc, solver,
+                                   Be_And(be_mgr, prefix, suffix), k,
+                                   "BMC Counterexample",
+                                   SexpFsm_get_symbols_list(SEXP_FSM(bsexp_fsm)));
+            Prop_set_trace(invarprop, Trace_get_id(trace));
+          }
+          solved = true;
+        }
+        else if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+          /* the over-approximation is too coarse: increases k */
+          fprintf(nusmv_stderr,
+                  "Spurious counterexample after %d iterations\n",
+                  iteration);
+        }
+
+        SatSolver_destroy(solver);
+        break;
+      }
+      else if (sat_res == SAT_SOLVER_UNSATISFIABLE_PROBLEM) {
+        TermFactoryCallbacks callbacks;
+        BmcItpFactory factory;
+        be_ptr itp;
+        be_ptr image;
+
+        callbacks.make_false = bmc_itp_make_false;
+        callbacks.make_true = bmc_itp_make_true;
+        callbacks.make_and = bmc_itp_make_and;
+        callbacks.make_or = bmc_itp_make_or;
+        callbacks.make_not = bmc_itp_make_not;
+        callbacks.make_var = bmc_itp_make_var;
+
+        factory.solver = solver;
+        factory.be_mgr = be_mgr;
+
+        itp = (be_ptr) SatSolver_extract_interpolant(solver, 1, &ga,
+                                                     &callbacks,
+                                                     (void*) &factory);
+        SatSolver_destroy(solver);
+
+        /* the interpolant is over the states at time 1 */
+        image = BeEnc_timed_expr_to_untimed(be_enc, itp, 1);
+
+        if (opt_verbose_level_gt(OptsHandler_get_instance(), 1)) {
+          fprintf(nusmv_stderr, "Iteration %d: interpolant computed\n",
+                  iteration);
+        }
+
+        sat_res = bmc_itp_check_implication(be_enc, image, reached);
+        if (sat_res == SAT_SOLVER_UNSATISFIABLE_PROBLEM) {
+          /* fixpoint: reached is an inductive invariant */
+          fprintf(nusmv_stdout, "-- ");
+          print_invar(nusmv_stdout, oldprop);
+          fprintf(nusmv_stdout, "  is true\n");
+          Prop_set_status(invarprop, Prop_True);
+
+          if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+            fprintf(nusmv_stderr,
+                    "Fixpoint reached with bound %d after %d iterations\n",
+                    k, iteration);
+          }
+          solved = true;
+          break;
+        }
+        else if (sat_res != SAT_SOLVER_SATISFIABLE_PROBLEM) {
+          internal_error("Sorry, solver answered with a fatal Internal "
+                         "Failure during problem solving.\n");
+        }
+
+        reached = Be_Or(be_mgr, reached, image);
+        exact = false;
+      }
+      else {
+        internal_error("Sorry, solver answered with a fatal Internal "
+                       "Failure during problem solving.\n");
+      }
+    } /* while */
+
+    if (!solved) {
+      fprintf(nusmv_stdout,
+              "-- no proof or counterexample found with bound %d\n", k);
+    }
+  } /* for */
+
+  if (was_rewritten) {
+    SYMB_LAYER_CHECK_INSTANCE(layer);
+
+    /* Save the results in the original property */
+    Prop_set_trace(oldprop, Prop_get_trace(invarprop));
+    Prop_set_status(oldprop, Prop_get_status(newprop));
+
+    /* Perform cleanup */
+    Bmc_rewrite_cleanup(newprop, Enc_get_bdd_encoding(), layer);
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Adds the given BE positively to the permanent group
+  of the solver]
+
+  Description        [Clauses are added to the current interpolation
+  group of the solver]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void bmc_itp_add_be(SatSolver_ptr solver,
+                           Be_Manager_ptr be_mgr, be_ptr prob)
+{
+  Be_Cnf_ptr cnf;
+
+  cnf = SatSolver_add_be(solver, be_mgr, prob, 1,
+                         SatSolver_get_permanent_group(solver));
+  SatSolver_set_polarity(solver, cnf, 1,
+                         SatSolver_get_permanent_group(solver));
+  Be_Cnf_Delete(cnf);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Checks whether image implies reached]
+
+  Description        [Both BEs are untimed. Returns
+  SAT_SOLVER_UNSATISFIABLE_PROBLEM if image implies reached,
+  SAT_SOLVER_SATISFIABLE_PROBLEM otherwise.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static SatSolverResult bmc_itp_check_implication(BeEnc_ptr be_enc,
+                                                 be_ptr image, be_ptr reached)
+{
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
+  SatSolver_ptr solver;
+  SatSolverResult sat_res;
+  be_ptr prob;
+
+  prob = BeEnc_untimed_expr_to_timed(be_enc,
+                    Be_And(be_mgr, image, Be_Not(be_mgr, reached)), 0);
+
+  if (Be_IsFalse(be_mgr, prob)) return SAT_SOLVER_UNSATISFIABLE_PROBLEM;
+
+  solver = Sat_CreateNonIncSolver(get_sat_solver(OptsHandler_get_instance()));
+  nusmv_assert(solver != SAT_SOLVER(NULL));
+
+  bmc_itp_add_be(solver, be_mgr, prob);
+  sat_res = SatSolver_solve_all_groups(solver);
+  SatSolver_destroy(solver);
+
+  return sat_res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Interpolant factory: the constant false]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static Term bmc_itp_make_false(TermFactoryCallbacksUserData_ptr data)
+{
+  return (Term) Be_Falsity(((BmcItpFactory*) data)->be_mgr);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Interpolant factory: the constant true]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static Term bmc_itp_make_true(TermFactoryCallbacksUserData_ptr data)
+{
+  return (Term) Be_Truth(((BmcItpFactory*) data)->be_mgr);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Interpolant factory: conjunction]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static Term bmc_itp_make_and(Term t1, Term t2,
+                             TermFactoryCallbacksUserData_ptr data)
+{
+  return (Term) Be_And(((BmcItpFactory*) data)->be_mgr,
+                       (be_ptr) t1, (be_ptr) t2);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Interpolant factory: disjunction]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static Term bmc_itp_make_or(Term t1, Term t2,
+                            TermFactoryCallbacksUserData_ptr data)
+{
+  return (Term) Be_Or(((BmcItpFactory*) data)->be_mgr,
+                      (be_ptr) t1, (be_ptr) t2);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Interpolant factory: negation]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static Term bmc_itp_make_not(Term t, TermFactoryCallbacksUserData_ptr data)
+{
+  return (Term) Be_Not(((BmcItpFactory*) data)->be_mgr, (be_ptr) t);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Interpolant factory: a variable of the solver]
+
+  Description        [The variable is mapped back to its CNF variable,
+  which is either a variable of the model or a sub-formula shared by
+  the two parts of the problem. In the latter case the sub-formula is
+  returned.]
+
+  SideEffects        []
+
+  SeeAlso            [Be_CnfLiteral2Be]
+
+******************************************************************************/
+static Term bmc_itp_make_var(int var, TermFactoryCallbacksUserData_ptr data)
+{
+  BmcItpFactory* factory = (BmcItpFactory*) data;
+  be_ptr res;
+
+  res = Be_CnfLiteral2Be(factory->be_mgr,
+                         SatSolver_get_cnf_var(factory->solver, var));
+  if ((be_ptr) NULL == res) {
+    internal_error("%s:%d:%s: unknown variable %d in the interpolant",
+                   __FILE__, __LINE__, __func__, var);
+  }
+
+  return (Term) res;
+}
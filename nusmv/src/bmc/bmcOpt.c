@@ -90,12 +90,16 @@ static boolean opt_check_bmc_invar_alg ARGS((OptsHandler_ptr opts,
                                              const char* val));
 static void* opt_get_bmc_invar_alg ARGS((OptsHandler_ptr opts,
                                          const char* val));
+static boolean opt_check_bmc_parallel_bounds ARGS((OptsHandler_ptr opts,
+                                                   const char* val));
 
 #if NUSMV_HAVE_INCREMENTAL_SAT
 static boolean opt_check_bmc_inc_invar_alg ARGS((OptsHandler_ptr opts,
                                                  const char* val));
 static void* opt_get_bmc_inc_invar_alg ARGS((OptsHandler_ptr opts,
                                              const char* val));
+static boolean opt_check_bmc_portfolio_size ARGS((OptsHandler_ptr opts,
+                                                  const char* val));
 #endif
 
 
@@ -154,6 +158,17 @@ void Bmc_init_opt()
                                     true, GENERIC_OPTION);
   nusmv_assert(res);
 
+  {
+    char def[20];
+    int chars = snprintf(def, 20, "%d", DEFAULT_BMC_PARALLEL_BOUNDS);
+    SNPRINTF_CHECK(chars, 20);
+    res = OptsHandler_register_option(opts, BMC_PARALLEL_BOUNDS, def,
+                              (Opts_CheckFnType)opt_check_bmc_parallel_bounds,
+                              (Opts_ReturnFnType)opt_get_integer,
+                              true, INTEGER_OPTION);
+    nusmv_assert(res);
+  }
+
 #if NUSMV_HAVE_INCREMENTAL_SAT
   res = OptsHandler_register_option(opts, BMC_INC_INVAR_ALG,
                                     DEFAULT_BMC_INC_INVAR_ALG,
@@ -161,6 +176,26 @@ void Bmc_init_opt()
                                     (Opts_ReturnFnType)opt_get_bmc_inc_invar_alg,
                                     true, GENERIC_OPTION);
   nusmv_assert(res);
+
+  {
+    char def[20];
+    int chars = snprintf(def, 20, "%d", DEFAULT_BMC_PORTFOLIO_SIZE);
+    SNPRINTF_CHECK(chars, 20);
+    res = OptsHandler_register_option(opts, BMC_PORTFOLIO_SIZE, def,
+                               (Opts_CheckFnType)opt_check_bmc_portfolio_size,
+                               (Opts_ReturnFnType)opt_get_integer,
+                               true, INTEGER_OPTION);
+    nusmv_assert(res);
+  }
+
+  res = OptsHandler_register_bool_option(opts, BMC_PORTFOLIO_SHARE_UNITS,
+                                         DEFAULT_BMC_PORTFOLIO_SHARE_UNITS,
+                                         true);
+  nusmv_assert(res);
+
+  res = OptsHandler_register_bool_option(opts, BMC_SWEEPING,
+                                         DEFAULT_BMC_SWEEPING, true);
+  nusmv_assert(res);
 #endif
 
   res = OptsHandler_register_bool_option(opts, BMC_OPTIMIZED_TABLEAU,
@@ -263,6 +298,17 @@ void set_bmc_invar_alg(OptsHandler_ptr opt, const char* alg)
   nusmv_assert(res);
 }
 
+int get_bmc_parallel_bounds(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_int_option_value(opt, BMC_PARALLEL_BOUNDS);
+}
+
+void set_bmc_parallel_bounds(OptsHandler_ptr opt, const int n)
+{
+  boolean res = OptsHandler_set_int_option_value(opt, BMC_PARALLEL_BOUNDS, n);
+  nusmv_assert(res);
+}
+
 #if NUSMV_HAVE_INCREMENTAL_SAT
 const char* get_bmc_inc_invar_alg(OptsHandler_ptr opt)
 {
@@ -274,6 +320,56 @@ void set_bmc_inc_invar_alg(OptsHandler_ptr opt, const char* alg)
   boolean res = OptsHandler_set_option_value(opt, BMC_INC_INVAR_ALG, alg);
   nusmv_assert(res);
 }
+
+int get_bmc_portfolio_size(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_int_option_value(opt, BMC_PORTFOLIO_SIZE);
+}
+
+void set_bmc_portfolio_size(OptsHandler_ptr opt, const int size)
+{
+  boolean res = OptsHandler_set_int_option_value(opt, BMC_PORTFOLIO_SIZE,
+                                                 size);
+  nusmv_assert(res);
+}
+
+void set_bmc_portfolio_share_units(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt,
+                                                  BMC_PORTFOLIO_SHARE_UNITS,
+                                                  true);
+  nusmv_assert(res);
+}
+
+void unset_bmc_portfolio_share_units(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt,
+                                                  BMC_PORTFOLIO_SHARE_UNITS,
+                                                  false);
+  nusmv_assert(res);
+}
+
+boolean opt_bmc_portfolio_share_units(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_bool_option_value(opt, BMC_PORTFOLIO_SHARE_UNITS);
+}
+
+void set_bmc_sweeping(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt, BMC_SWEEPING, true);
+  nusmv_assert(res);
+}
+
+void unset_bmc_sweeping(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt, BMC_SWEEPING, false);
+  nusmv_assert(res);
+}
+
+boolean opt_bmc_sweeping(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_bool_option_value(opt, BMC_SWEEPING);
+}
 #endif
 
 void set_bmc_optimized_tableau(OptsHandler_ptr opt)
@@ -490,6 +586,31 @@ static void* opt_get_bmc_invar_alg(OptsHandler_ptr opts, const char* val)
   return OPTS_VALUE_ERROR;
 }
 
+/**Function********************************************************************
+
+   Synopsis    [Check function for the bmc_parallel_bounds option]
+
+   Description [The number of bounds must be a positive integer]
+
+   SideEffects []
+
+   SeeAlso     []
+
+******************************************************************************/
+static boolean opt_check_bmc_parallel_bounds(OptsHandler_ptr opts,
+                                             const char* val)
+{
+  void* res = opt_get_integer(opts, val);
+
+  if (OPTS_VALUE_ERROR == res || PTR_TO_INT(res) < 1) {
+    fprintf(nusmv_stderr,
+            "The number of parallel bounds must be a positive integer.\n");
+    return false;
+  }
+
+  return true;
+}
+
 #if NUSMV_HAVE_INCREMENTAL_SAT
 /**Function********************************************************************
 
@@ -541,6 +662,31 @@ static void* opt_get_bmc_inc_invar_alg(OptsHandler_ptr opts, const char* val)
   }
   return OPTS_VALUE_ERROR;
 }
+
+/**Function********************************************************************
+
+   Synopsis    [Check function for the bmc_portfolio_size option]
+
+   Description [The size must be a positive integer]
+
+   SideEffects []
+
+   SeeAlso     []
+
+******************************************************************************/
+static boolean opt_check_bmc_portfolio_size(OptsHandler_ptr opts,
+                                            const char* val)
+{
+  void* res = opt_get_integer(opts, val);
+
+  if (OPTS_VALUE_ERROR == res || PTR_TO_INT(res) < 1) {
+    fprintf(nusmv_stderr,
+            "The portfolio size must be a positive integer.\n");
+    return false;
+  }
+
+  return true;
+}
 #endif
 
 /**Function********************************************************************
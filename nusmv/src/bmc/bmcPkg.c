@@ -281,6 +281,8 @@ void Bmc_AddCmd()
 
   Cmd_CommandAdd("gen_invar_bmc",     Bmc_CommandGenInvarBmc, 0, true);
   Cmd_CommandAdd("check_invar_bmc",   Bmc_CommandCheckInvarBmc, 0, true);
+  Cmd_CommandAdd("check_invar_itp",   Bmc_CommandCheckInvarItp, 0, true);
+  Cmd_CommandAdd("check_invar_ic3",   Bmc_CommandCheckInvarIc3, 0, true);
 #if NUSMV_HAVE_INCREMENTAL_SAT
   Cmd_CommandAdd("check_invar_bmc_inc",   Bmc_CommandCheckInvarBmcInc,
                  0, true);
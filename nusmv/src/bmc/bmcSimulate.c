@@ -222,9 +222,8 @@ int Bmc_Simulate(const BeFsm_ptr be_fsm, BddEnc_ptr bdd_enc,
   }
 
   prob = Bmc_Utils_apply_inlining(be_mgr, prob);
-  cnf = Be_ConvertToCnf(be_mgr, prob, 1);
-
-  SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
+  cnf = SatSolver_add_be(solver, be_mgr, prob, 1,
+                         SatSolver_get_permanent_group(solver));
   SatSolver_set_polarity(solver, cnf, 1,
                          SatSolver_get_permanent_group(solver));
   sat_res = SatSolver_solve_all_groups(solver);
@@ -772,11 +771,8 @@ bmc_simulate_add_be_into_inc_solver_positively(SatIncSolver_ptr solver,
   /* We force inclusion of the conjunct set to guarantee soundness */
   inprob = Bmc_Utils_apply_inlining4inc(be_mgr, prob);
 
-  /* Convert the problem into CNF */
-  cnf = Be_ConvertToCnf(be_mgr, inprob, polarity);
-
-  /* Add the problem into the solver */
-  SatSolver_add(SAT_SOLVER(solver), cnf, group);
+  /* Convert the problem into CNF, and add it into the solver */
+  cnf = SatSolver_add_be(SAT_SOLVER(solver), be_mgr, inprob, polarity, group);
 
   /* Force the added group to be considered positively */
   SatSolver_set_polarity(SAT_SOLVER(solver), cnf, polarity, group);
@@ -816,11 +812,9 @@ bmc_simulate_add_be_into_non_inc_solver_positively(SatSolver_ptr solver,
   /* We force inclusion of the conjunct set to guarantee soundness */
   inprob = Bmc_Utils_apply_inlining(be_mgr, prob);
 
-  /* Convert the problem into CNF */
-  cnf = Be_ConvertToCnf(be_mgr, inprob, polarity);
-
-  /* Add the problem into the solver */
-  SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
+  /* Convert the problem into CNF, and add it into the solver */
+  cnf = SatSolver_add_be(solver, be_mgr, inprob, polarity,
+                         SatSolver_get_permanent_group(solver));
 
   /* Force the added group to be considered positively */
   SatSolver_set_polarity(solver, cnf, polarity,
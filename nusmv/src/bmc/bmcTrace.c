@@ -79,6 +79,10 @@ static char rcsid[] UTIL_UNUSED = "$Id: $";
 static enum st_retval trace_utils_release_bv ARGS((char* key, char* data,
                                                    char* arg));
 
+static Trace_ptr
+bmc_fill_trace_from_model ARGS((const BeEnc_ptr be_enc, const Slist_ptr model,
+                                boolean is_cnf, int k, Trace_ptr trace));
+
 static void bmc_model_trace_step_print ARGS((const Trace_ptr trace,
                                              const TraceIter step,
                                              TraceIteratorType it_type,
@@ -140,147 +144,36 @@ Bmc_fill_trace_from_cnf_model(const BeEnc_ptr be_enc,
                               const Slist_ptr cnf_model,
                               int k, Trace_ptr trace)
 {
-  TraceIter first;
-  /* local refs */
-  const BoolEnc_ptr bool_enc = \
-    BoolEncClient_get_bool_enc(BOOL_ENC_CLIENT(be_enc));
-
-  const Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
-  const SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(be_enc));
-
-  hash_ptr tvar_2_bval = new_assoc();
-  hash_ptr time_2_step = new_assoc();
-
-  Siter genLiteral;
-  nusmv_ptrint cnfLiteral;
-  nusmv_ptrint beLiteral;
-
-  int i;
-
-  TRACE_CHECK_INSTANCE(trace);
-  nusmv_assert(Trace_is_empty(trace));
-
-  first = Trace_first_iter(trace);
-
-  /* phase 0: setup trace iterators for all times */
-  insert_assoc(time_2_step, NODE_FROM_INT(0), (node_ptr)(first));
-  for (i = 1; i <= k; ++ i) {
-    TraceIter step = Trace_append_step(trace);
-    insert_assoc(time_2_step, NODE_FROM_INT(i), (node_ptr)(step));
-  }
-
-  /* phase 1: we consider only the cnf variables corresponding to BE
-     variables in the range [0, k].
-
-     Thus we ignore the cnf variables that are not corresponding to
-     the encoding of the:
-     - model variables;
-     - encoding variables (sub formulas, loop variables, ...)
-  */
-  SLIST_FOREACH(cnf_model, genLiteral) {
-    int var_idx, ut_index, vtime;
-    node_ptr var, key;
-
-    cnfLiteral = (nusmv_ptrint) Siter_element(genLiteral);
-    beLiteral = (nusmv_ptrint) Be_CnfLiteral2BeLiteral(be_mgr, cnfLiteral);
-
-    /* if there is no corresponding rbc variable skip this */
-    if (0 == beLiteral) continue;
-
-    /* get timed var */
-    var_idx = Be_BeLiteral2BeIndex(be_mgr, beLiteral);
-    ut_index = BeEnc_index_to_untimed_index(be_enc, var_idx);
-    vtime = BeEnc_index_to_time(be_enc, var_idx);
-    var = BeEnc_index_to_name(be_enc, ut_index);
-
-    /* needed to adapt to new trace timing format, input is stored
-     in the next step */
-    if (SymbTable_is_symbol_input_var(st, var)) { ++ vtime; }
-
-    if (vtime > k) continue;
-
-    /* if it's a bit get/create a BitValues structure for
-       the scalar variable which this bit belongs */
-    if (BoolEnc_is_var_bit(bool_enc, var)) {
-      node_ptr scalar_var = BoolEnc_get_scalar_var_from_bit(bool_enc, var);
-      BitValues_ptr bv;
-      key = find_node(ATTIME, scalar_var, NODE_FROM_INT(vtime));
-
-      bv = BIT_VALUES(find_assoc(tvar_2_bval, key));
-      if (BIT_VALUES(NULL) == bv) {
-        bv = BitValues_create(bool_enc, scalar_var);
-        insert_assoc(tvar_2_bval, key, (node_ptr)(bv));
-      }
-
-      /* set the bit value */
-      BitValues_set(bv, BoolEnc_get_index_from_bit(bool_enc, var),
-                    (beLiteral >= 0) ? BIT_VALUE_TRUE : BIT_VALUE_FALSE);
-
-    }
-    else { /* boolean variables do not require any further processing */
-
-      TraceIter timed_step = (-1 != vtime) /* frozenvars */
-        ? TRACE_ITER(find_assoc(time_2_step, NODE_FROM_INT(vtime)))
-        : first ;
-
-      nusmv_assert(TRACE_END_ITER != timed_step);
-      Trace_step_put_value(trace, timed_step, var, beLiteral >= 0
-                           ? Expr_true () : Expr_false());
-    }
-
-  } /* SLIST_FOREACH (phase 1) */
-
-  { /* phase 2: iterate over elements of the hash table (i.e. scalar
-      vars) and populate the trace accordingly. */
-
-    node_ptr ts_var;
-    BitValues_ptr bitValues;
-    assoc_iter aiter;
-
-    ASSOC_FOREACH(tvar_2_bval, aiter, &ts_var, &bitValues) {
-      int vtime = NODE_TO_INT(cdr(ts_var)); /* its time */
-      node_ptr value = BoolEnc_get_value_from_var_bits(bool_enc, bitValues);
-
-      TraceIter timed_step = (-1 != vtime) /* frozenvars */
-        ? TRACE_ITER(find_assoc(time_2_step, NODE_FROM_INT(vtime)))
-        : first ;
-
-      nusmv_assert(TRACE_END_ITER != timed_step);
-      Trace_step_put_value(trace, timed_step, car(ts_var), value);
+  return bmc_fill_trace_from_model(be_enc, cnf_model, true, k, trace);
+}
 
-      BitValues_destroy(bitValues);
-    }
-  } /* phase 2: */
+/**Function********************************************************************
 
-  /* phase 3: some assignments may be missing, complete the trace */
-  bmc_trace_utils_complete_trace(trace, bool_enc);
+  Synopsis     [Creates a trace out of a BE model]
 
-#if BMC_MODEL_DEBUG
-  {
-    TraceIter step;
-    int i=0;
+  Description  [Creates a complete, k steps long trace in the language
+                of \"symbols\" out of a BE model, i.e. a list of BE
+                literals of timed (and frozen) variables. The returned
+                trace is non-volatile.]
 
-    fprintf(nusmv_stderr, "\n--- BMC Model extraction ---\n");
-    TRACE_FOREACH(trace, step) {
-      ++ i;
+  SideEffects  [none]
 
-      if (1 != i) {
-        bmc_model_trace_step_print(trace, step, TRACE_ITER_I_VARS,"I", i);
-      }
+  SeeAlso      [Bmc_create_trace_from_cnf_model]
 
-      bmc_model_trace_step_print(trace, step, (1 == i) ? TRACE_ITER_SF_VARS
-                                 : TRACE_ITER_S_VARS, "S", i);
-    }
-  }
-  fprintf(nusmv_stderr, "\n\n");
-#endif
+******************************************************************************/
+Trace_ptr Bmc_create_trace_from_be_model(const BeEnc_ptr be_enc,
+                                         const NodeList_ptr symbols,
+                                         const char* desc,
+                                         const TraceType type,
+                                         const Slist_ptr be_model,
+                                         int k)
+{
+  Trace_ptr trace = Trace_create(BaseEnc_get_symb_table(BASE_ENC(be_enc)),
+                                 desc, type, symbols, false);
 
-  /* cleanup */
-  free_assoc(tvar_2_bval);
-  free_assoc(time_2_step);
+  return bmc_fill_trace_from_model(be_enc, be_model, false, k, trace);
+}
 
-  return trace;
-} /* Bmc_create_trace_from_cnf_model */
 
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
@@ -505,6 +398,167 @@ void bmc_trace_utils_append_input_state(Trace_ptr trace, BeEnc_ptr be_enc,
 /* Definition of static functions                                            */
 /*---------------------------------------------------------------------------*/
 
+/**Function********************************************************************
+
+  Synopsis     [Fills the given trace out of a cnf or BE model]
+
+  Description  [The body of Bmc_fill_trace_from_cnf_model and
+                Bmc_create_trace_from_be_model. model is a list of cnf
+                literals if is_cnf is true, of BE literals otherwise.]
+
+  SideEffects  [none]
+
+  SeeAlso      [Bmc_fill_trace_from_cnf_model]
+
+******************************************************************************/
+static Trace_ptr
+bmc_fill_trace_from_model(const BeEnc_ptr be_enc, const Slist_ptr model,
+                          boolean is_cnf, int k, Trace_ptr trace)
+{
+  TraceIter first;
+  /* local refs */
+  const BoolEnc_ptr bool_enc = \
+    BoolEncClient_get_bool_enc(BOOL_ENC_CLIENT(be_enc));
+
+  const Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
+  const SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(be_enc));
+
+  hash_ptr tvar_2_bval = new_assoc();
+  hash_ptr time_2_step = new_assoc();
+
+  Siter genLiteral;
+  nusmv_ptrint beLiteral;
+
+  int i;
+
+  TRACE_CHECK_INSTANCE(trace);
+  nusmv_assert(Trace_is_empty(trace));
+
+  first = Trace_first_iter(trace);
+
+  /* phase 0: setup trace iterators for all times */
+  insert_assoc(time_2_step, NODE_FROM_INT(0), (node_ptr)(first));
+  for (i = 1; i <= k; ++ i) {
+    TraceIter step = Trace_append_step(trace);
+    insert_assoc(time_2_step, NODE_FROM_INT(i), (node_ptr)(step));
+  }
+
+  /* phase 1: we consider only the cnf variables corresponding to BE
+     variables in the range [0, k].
+
+     Thus we ignore the cnf variables that are not corresponding to
+     the encoding of the:
+     - model variables;
+     - encoding variables (sub formulas, loop variables, ...)
+  */
+  SLIST_FOREACH(model, genLiteral) {
+    int var_idx, ut_index, vtime;
+    node_ptr var, key;
+
+    beLiteral = (nusmv_ptrint) Siter_element(genLiteral);
+    if (is_cnf) {
+      beLiteral = (nusmv_ptrint) Be_CnfLiteral2BeLiteral(be_mgr, beLiteral);
+    }
+
+    /* if there is no corresponding rbc variable skip this */
+    if (0 == beLiteral) continue;
+
+    /* get timed var */
+    var_idx = Be_BeLiteral2BeIndex(be_mgr, beLiteral);
+    ut_index = BeEnc_index_to_untimed_index(be_enc, var_idx);
+    vtime = BeEnc_index_to_time(be_enc, var_idx);
+    var = BeEnc_index_to_name(be_enc, ut_index);
+
+    /* needed to adapt to new trace timing format, input is stored
+     in the next step */
+    if (SymbTable_is_symbol_input_var(st, var)) { ++ vtime; }
+
+    if (vtime > k) continue;
+
+    /* if it's a bit get/create a BitValues structure for
+       the scalar variable which this bit belongs */
+    if (BoolEnc_is_var_bit(bool_enc, var)) {
+      node_ptr scalar_var = BoolEnc_get_scalar_var_from_bit(bool_enc, var);
+      BitValues_ptr bv;
+      key = find_node(ATTIME, scalar_var, NODE_FROM_INT(vtime));
+
+      bv = BIT_VALUES(find_assoc(tvar_2_bval, key));
+      if (BIT_VALUES(NULL) == bv) {
+        bv = BitValues_create(bool_enc, scalar_var);
+        insert_assoc(tvar_2_bval, key, (node_ptr)(bv));
+      }
+
+      /* set the bit value */
+      BitValues_set(bv, BoolEnc_get_index_from_bit(bool_enc, var),
+                    (beLiteral >= 0) ? BIT_VALUE_TRUE : BIT_VALUE_FALSE);
+
+    }
+    else { /* boolean variables do not require any further processing */
+
+      TraceIter timed_step = (-1 != vtime) /* frozenvars */
+        ? TRACE_ITER(find_assoc(time_2_step, NODE_FROM_INT(vtime)))
+        : first ;
+
+      nusmv_assert(TRACE_END_ITER != timed_step);
+      Trace_step_put_value(trace, timed_step, var, beLiteral >= 0
+                           ? Expr_true () : Expr_false());
+    }
+
+  } /* SLIST_FOREACH (phase 1) */
+
+  { /* phase 2: iterate over elements of the hash table (i.e. scalar
+      vars) and populate the trace accordingly. */
+
+    node_ptr ts_var;
+    BitValues_ptr bitValues;
+    assoc_iter aiter;
+
+    ASSOC_FOREACH(tvar_2_bval, aiter, &ts_var, &bitValues) {
+      int vtime = NODE_TO_INT(cdr(ts_var)); /* its time */
+      node_ptr value = BoolEnc_get_value_from_var_bits(bool_enc, bitValues);
+
+      TraceIter timed_step = (-1 != vtime) /* frozenvars */
+        ? TRACE_ITER(find_assoc(time_2_step, NODE_FROM_INT(vtime)))
+        : first ;
+
+      nusmv_assert(TRACE_END_ITER != timed_step);
+      Trace_step_put_value(trace, timed_step, car(ts_var), value);
+
+      BitValues_destroy(bitValues);
+    }
+  } /* phase 2: */
+
+  /* phase 3: some assignments may be missing, complete the trace */
+  bmc_trace_utils_complete_trace(trace, bool_enc);
+
+#if BMC_MODEL_DEBUG
+  {
+    TraceIter step;
+    int i=0;
+
+    fprintf(nusmv_stderr, "\n--- BMC Model extraction ---\n");
+    TRACE_FOREACH(trace, step) {
+      ++ i;
+
+      if (1 != i) {
+        bmc_model_trace_step_print(trace, step, TRACE_ITER_I_VARS,"I", i);
+      }
+
+      bmc_model_trace_step_print(trace, step, (1 == i) ? TRACE_ITER_SF_VARS
+                                 : TRACE_ITER_S_VARS, "S", i);
+    }
+  }
+  fprintf(nusmv_stderr, "\n\n");
+#endif
+
+  /* cleanup */
+  free_assoc(tvar_2_bval);
+  free_assoc(time_2_step);
+
+  return trace;
+} /* bmc_fill_trace_from_model */
+
+
 static void bmc_model_trace_step_print(const Trace_ptr trace,
                                        const TraceIter step,
                                        TraceIteratorType it_type,
@@ -38,12 +38,20 @@
 
 ******************************************************************************/
 
+#if HAVE_CONFIG_H
+#include "nusmv-config.h"
+#endif
+
+#include "bmc.h"
 #include "bmcInt.h"
 #include "bmcUtils.h"
 #include "bmcConv.h"
 
 #include "parser/parser.h"
 #include "parser/symbols.h"
+#include "sat/sat.h"
+#include "sat/SatSolver.h"
+#include "sat/SatIncSolver.h"
 
 #include <limits.h>
 
@@ -61,6 +69,10 @@ static char rcsid[] UTIL_UNUSED = "$Id: bmcUtils.c,v 1.19.12.3.2.5.6.15 2010-02-
 #define BMC_NO_LOOP_USERSIDE_SYMBOL   "X"
 /* ---------------------------------------------------------------------- */
 
+/* Words of random simulation used to find the candidate equivalences
+   of the sweeping */
+#define BMC_SWEEPING_SIM_WORDS 4
+
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
@@ -69,6 +81,22 @@ static char rcsid[] UTIL_UNUSED = "$Id: bmcUtils.c,v 1.19.12.3.2.5.6.15 2010-02-
 /* Structure declarations                                                    */
 /*---------------------------------------------------------------------------*/
 
+#if NUSMV_HAVE_INCREMENTAL_SAT
+/**Struct**********************************************************************
+
+  Synopsis    [The equivalence prover of the sweeping]
+
+  Description [calls counts the SAT problems solved.]
+
+  SeeAlso     [Bmc_Utils_apply_sweeping]
+
+******************************************************************************/
+typedef struct BmcSweepProver_TAG {
+  SatIncSolver_ptr solver;
+  int calls;
+} BmcSweepProver;
+#endif
+
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -91,6 +119,12 @@ bmc_utils_costraint_from_string ARGS((BeEnc_ptr be_enc,
                                       boolean accept_next_expr,
                                       Expr_ptr* node_expr));
 
+#if NUSMV_HAVE_INCREMENTAL_SAT
+static boolean
+bmc_utils_sweep_prove ARGS((Be_Manager_ptr be_mgr, be_ptr a, be_ptr b,
+                            void* data));
+#endif
+
 /**AutomaticEnd***************************************************************/
 
 
@@ -653,23 +687,83 @@ lsList Bmc_Utils_get_vars_list_for_uniqueness_fsm(BeEnc_ptr be_enc,
 
 /**Function********************************************************************
 
-  Synopsis    [Applies inlining taking into account of current user
-               settings]
+  Synopsis    [Applies inlining and rewriting taking into account of
+               current user settings]
 
-  Description []
+  Description [Rewriting is applied to the inlined formula.]
 
   SideEffects []
 
-  SeeAlso     []
+  SeeAlso     [Be_Rewrite]
 
 ******************************************************************************/
 be_ptr Bmc_Utils_apply_inlining(Be_Manager_ptr be_mgr, be_ptr f)
 {
-  if (!opt_rbc_inlining(OptsHandler_get_instance())) return f;
+  if (opt_rbc_inlining(OptsHandler_get_instance())) {
+    f = Be_apply_inlining(be_mgr, f,
+                          (!opt_rbc_inlining_lazy(OptsHandler_get_instance()) &&
+                           opt_counter_examples(OptsHandler_get_instance())));
+  }
+
+  if (opt_rbc_rewriting(OptsHandler_get_instance())) {
+    f = Be_Rewrite(be_mgr, f);
+  }
 
-  return Be_apply_inlining(be_mgr, f,
-                           (!opt_rbc_inlining_lazy(OptsHandler_get_instance()) &&
-                            opt_counter_examples(OptsHandler_get_instance())));
+  return f;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Applies SAT sweeping taking into account of current user
+               settings]
+
+  Description [When the option bmc_sweeping is set, each of the num
+               formulae in fs is replaced by an equivalent formula in
+               which the sub-formulae proved equivalent are merged (see
+               Be_Sweep). The proofs are carried out by a single
+               incremental SAT solver, which keeps the clauses of the
+               sub-formulae across the proofs.
+
+               The formulae are meant to be the untimed ones of a BeFsm:
+               the merging is done once, and every unrolling of the
+               formulae benefits from it.]
+
+  SideEffects [fs is changed]
+
+  SeeAlso     [Be_Sweep]
+
+******************************************************************************/
+void Bmc_Utils_apply_sweeping(Be_Manager_ptr be_mgr, be_ptr* fs, int num)
+{
+#if NUSMV_HAVE_INCREMENTAL_SAT
+  BmcSweepProver prover;
+  int merged;
+
+  if (!opt_bmc_sweeping(OptsHandler_get_instance())) return;
+
+  prover.solver =
+    Sat_CreateIncSolver(get_sat_solver(OptsHandler_get_instance()));
+  if (prover.solver == SAT_INC_SOLVER(NULL)) {
+    fprintf(nusmv_stderr, "Incremental sat solver '%s' is not available, "
+            "sweeping is skipped.\n",
+            get_sat_solver(OptsHandler_get_instance()));
+    return;
+  }
+  prover.calls = 0;
+
+  /* the clauses of the proofs are recorded as emitted */
+  Be_ResetCnfEmitted(be_mgr);
+  Be_Sweep(be_mgr, fs, num, BMC_SWEEPING_SIM_WORDS, bmc_utils_sweep_prove,
+           (void*) &prover, &merged);
+  SatIncSolver_destroy(prover.solver);
+  Be_ResetCnfEmitted(be_mgr);
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    fprintf(nusmv_stderr, "Sweeping merged %d sub-formulae "
+            "(%d SAT problems solved)\n", merged, prover.calls);
+  }
+#endif
 }
 
 
@@ -679,18 +773,25 @@ be_ptr Bmc_Utils_apply_inlining(Be_Manager_ptr be_mgr, be_ptr f)
                set. Useful in the incremental SAT applications to
                guarantee soundness]
 
-  Description []
+  Description [Rewriting is applied to the inlined formula, as in
+               Bmc_Utils_apply_inlining.]
 
   SideEffects []
 
-  SeeAlso     []
+  SeeAlso     [Be_Rewrite]
 
 ******************************************************************************/
 be_ptr Bmc_Utils_apply_inlining4inc(Be_Manager_ptr be_mgr, be_ptr f)
 {
-  if (!opt_rbc_inlining(OptsHandler_get_instance())) return f;
+  if (opt_rbc_inlining(OptsHandler_get_instance())) {
+    f = Be_apply_inlining(be_mgr, f, true);
+  }
 
-  return Be_apply_inlining(be_mgr, f, true);
+  if (opt_rbc_rewriting(OptsHandler_get_instance())) {
+    f = Be_Rewrite(be_mgr, f);
+  }
+
+  return f;
 }
 
 
@@ -810,3 +911,45 @@ bmc_utils_costraint_from_string(BeEnc_ptr be_enc,
 
   return result;
 }
+
+
+#if NUSMV_HAVE_INCREMENTAL_SAT
+/**Function********************************************************************
+
+  Synopsis    [Proves the equivalence of two formulae for the sweeping]
+
+  Description [The clauses of a xor b are added to the permanent group,
+               while a xor b is asserted in a temporary group only. The
+               formulae are equivalent if the problem is unsatisfiable.]
+
+  SideEffects []
+
+  SeeAlso     [Bmc_Utils_apply_sweeping]
+
+******************************************************************************/
+static boolean bmc_utils_sweep_prove(Be_Manager_ptr be_mgr,
+                                     be_ptr a, be_ptr b, void* data)
+{
+  BmcSweepProver* prover = (BmcSweepProver*) data;
+  SatSolver_ptr solver = SAT_SOLVER(prover->solver);
+  be_ptr diff = Be_Xor(be_mgr, a, b);
+  SatSolverGroup group;
+  SatSolverResult res;
+  Be_Cnf_ptr cnf;
+
+  if (Be_IsFalse(be_mgr, diff)) return true;
+  if (Be_IsTrue(be_mgr, diff)) return false;
+
+  ++(prover->calls);
+
+  cnf = SatSolver_add_be_new(solver, be_mgr, diff, 1,
+                             SatSolver_get_permanent_group(solver));
+  group = SatIncSolver_create_group(prover->solver);
+  SatSolver_set_polarity(solver, cnf, 1, group);
+  res = SatSolver_solve_all_groups(solver);
+  SatIncSolver_destroy_group(prover->solver, group);
+  Be_Cnf_Delete(cnf);
+
+  return (res == SAT_SOLVER_UNSATISFIABLE_PROBLEM);
+}
+#endif
@@ -164,6 +164,8 @@ EXTERN be_ptr
 Bmc_Utils_apply_inlining ARGS((Be_Manager_ptr be_mgr, be_ptr f));
 EXTERN be_ptr 
 Bmc_Utils_apply_inlining4inc ARGS((Be_Manager_ptr be_mgr, be_ptr f));
+EXTERN void
+Bmc_Utils_apply_sweeping ARGS((Be_Manager_ptr be_mgr, be_ptr* fs, int num));
 
 
 EXTERN be_ptr 
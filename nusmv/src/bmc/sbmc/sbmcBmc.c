@@ -274,10 +274,13 @@ int Bmc_SBMCGenSolveLtl(Prop_ptr ltlprop,
         return 1;
       }
 
-      /* Cnf construction (if needed): */
+      /* Cnf construction (if needed): the clauses are streamed into
+         the solver, unless they have been built for dumping */
       if (cnf == (Be_Cnf_ptr) NULL) {
-        cnf = Be_ConvertToCnf(be_mgr, prob, 1);
+        cnf = SatSolver_add_be(solver, be_mgr, prob, 1,
+                               SatSolver_get_permanent_group(solver));
       }
+      else SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
 
 #ifdef BENCHMARKING
       fprintf(nusmv_stdout, ":START:benchmarking Solving\n");
@@ -285,7 +288,6 @@ int Bmc_SBMCGenSolveLtl(Prop_ptr ltlprop,
 #endif      
       
       /* SAT invokation */
-      SatSolver_add(solver, cnf, SatSolver_get_permanent_group(solver));
       SatSolver_set_polarity(solver, cnf, 1, 
                              SatSolver_get_permanent_group(solver));
       sat_res = SatSolver_solve_all_groups(solver);
@@ -820,8 +820,8 @@ int Sbmc_zigzag_incr(Prop_ptr ltlprop, const int max_k,
 /**Function********************************************************************
 
   Synopsis           [High level function that performs incremental
-  sbmc under assumptions. Currently this routine requires MiniSAT being
-  used as SAT solver.]
+  sbmc under assumptions. Currently this routine requires MiniSAT or
+  Cdcl being used as SAT solver.]
 
   Description        [optional]
 
@@ -848,7 +848,8 @@ int Sbmc_zigzag_incr_assume(Prop_ptr ltlprop, const int max_k,
   int ass_SimplePath_cnflit;
 #endif
 
-  nusmv_assert(!strcmp(get_sat_solver(OptsHandler_get_instance()), "MiniSat"));
+  nusmv_assert(!strcmp(get_sat_solver(OptsHandler_get_instance()), "MiniSat") ||
+               !strcmp(get_sat_solver(OptsHandler_get_instance()), "Cdcl"));
 
   /* Structure for holding state variable information */
   state_vars_struct *state_vars = (state_vars_struct *)NULL;
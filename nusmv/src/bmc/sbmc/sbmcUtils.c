@@ -1218,14 +1218,12 @@ void sbmc_MS_force_true(sbmc_MetaSolver *ms, be_ptr be_constraint)
   /* We force inclusion of the conjunct set to guarantee soundness */
   inconstr = Bmc_Utils_apply_inlining4inc(be_mgr, be_constraint);
 
-  cnf = Be_ConvertToCnf(be_mgr, inconstr, 1);
-
   if (ms->using_volatile_group) {
-    SatSolver_add(solver, cnf, ms->volatile_group);
+    cnf = SatSolver_add_be(solver, be_mgr, inconstr, 1, ms->volatile_group);
     SatSolver_set_polarity(solver, cnf, 1, ms->volatile_group);
   }
   else {
-    SatSolver_add(solver, cnf, ms->permanent_group);
+    cnf = SatSolver_add_be(solver, be_mgr, inconstr, 1, ms->permanent_group);
     SatSolver_set_polarity(solver, cnf, 1, ms->permanent_group);
   }
   Be_Cnf_Delete(cnf);
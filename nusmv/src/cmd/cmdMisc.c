@@ -42,6 +42,7 @@
 #include "cmdInt.h"
 #include "utils/error.h"
 #include "cinit/cinit.h"
+#include "utils/Profile.h"
 
 #include <stdio.h>
 
@@ -90,6 +91,7 @@ EXTERN rl_completion_func_t *rl_attempted_completion_function;
 /*---------------------------------------------------------------------------*/
 
 static int CommandTime ARGS((int argc, char ** argv));
+static int CommandPrintProfile ARGS((int argc, char ** argv));
 static int CommandEcho ARGS((int argc, char ** argv));
 static int CommandMemoryProfile ARGS((int argc, char ** argv));
 static int CommandQuit ARGS((int argc, char ** argv));
@@ -142,6 +144,7 @@ void Cmd_Init()
   Cmd_CommandAdd("source", CommandSource, 0, true);
   Cmd_CommandAdd("unalias", CommandUnalias, 0, true);
   Cmd_CommandAdd("time", CommandTime, 0, true);
+  Cmd_CommandAdd("print_profile", CommandPrintProfile, 0, true);
   Cmd_CommandAdd("usage", CommandUsage, 0, true);
   Cmd_CommandAdd("history", CommandHistory, 0, true);
   Cmd_CommandAdd("which", CommandWhich, 0, true);
@@ -426,6 +429,103 @@ usage:
   return 1;
 }
 
+/**Function********************************************************************
+
+  Synopsis          [Implements the print_profile command.]
+
+  CommandName       [print_profile]
+
+  CommandSynopsis   [Prints the time and the BDD statistics spent in the
+  main phases of the verification]
+
+  CommandArguments [\[-h\] \[-j\] \[-r\] \[-o output-file\]]
+
+  CommandDescription [Prints, for each of the main phases executed so
+  far (flattening, BDD encoding, partitioning, reachability, fair
+  states, CTL evaluation, counterexample explanation, BMC problem
+  generation and solving, SAT solving), the number of times the phase
+  was executed and the CPU time spent in it. Nested phases are printed
+  indented under the enclosing phase.<p>
+
+  When BDDs are used, each phase also reports the variation of the
+  number of live BDD nodes (bdd_nodes), the peak number of live nodes
+  reached within the phase (peak_live_nodes) and the hit rate of the
+  BDD computed table (cache_hit_rate).<p>
+
+  Command options:<p>
+  <dl>
+    <dt> <tt>-j</tt>
+       <dd> Prints the profile in JSON format instead of a table.
+    <dt> <tt>-r</tt>
+       <dd> Resets the collected data after printing it.
+    <dt> <tt>-o output-file</tt>
+       <dd> Writes the profile to the given file.
+  </dl>]
+
+  SideEffects        []
+
+******************************************************************************/
+static int CommandPrintProfile(int  argc, char ** argv)
+{
+  ProfileFormat format = PROFILE_FORMAT_TABLE;
+  boolean reset = false;
+  char* fname = NIL(char);
+  FILE* file = nusmv_stdout;
+  int c;
+
+  util_getopt_reset();
+  while ((c = util_getopt(argc,argv,"hjro:")) != EOF){
+    switch(c){
+      case 'h':
+        goto usage;
+      case 'j':
+        format = PROFILE_FORMAT_JSON;
+        break;
+      case 'r':
+        reset = true;
+        break;
+      case 'o':
+        if (fname != NIL(char)) FREE(fname);
+        fname = util_strsav(util_optarg);
+        break;
+      default:
+        goto usage;
+    }
+  }
+
+  if (argc != util_optind) {
+    goto usage;
+  }
+
+  if (fname != NIL(char)) {
+    file = fopen(fname, "w");
+    if (file == (FILE*) NULL) {
+      fprintf(nusmv_stderr, "print_profile: unable to open file \"%s\".\n",
+              fname);
+      FREE(fname);
+      return 1;
+    }
+  }
+
+  Profile_print(file, format);
+  if (reset) Profile_reset();
+
+  if (fname != NIL(char)) {
+    fclose(file);
+    FREE(fname);
+  }
+  return 0;
+
+usage:
+  if (fname != NIL(char)) FREE(fname);
+  fprintf(nusmv_stderr, "usage: print_profile [-h] [-j] [-r] [-o file]\n");
+  fprintf(nusmv_stderr, "   -h \t\tPrints the command usage.\n");
+  fprintf(nusmv_stderr, "   -j \t\tPrints the profile in JSON format.\n");
+  fprintf(nusmv_stderr, "   -r \t\tResets the profile after printing it.\n");
+  fprintf(nusmv_stderr, "   -o file\tWrites the profile to the given file.\n");
+  return 1;
+}
+
 /**Function********************************************************************
 
   Synopsis           [Implements the echo command.]
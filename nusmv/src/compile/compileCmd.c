@@ -200,7 +200,6 @@ void Compile_init()
   init_consts_hash();
   init_dependencies_hash();
   init_define_dep_hash();
-  init_coi_hash();
   init_coi0_hash();
 
   /* the global fsm builder creation */
@@ -294,7 +293,7 @@ void Compile_quit()
   }
 
   clear_coi0_hash();
-  clear_coi_hash();
+  clear_coi_graph();
   clear_define_dep_hash();
   clear_dependencies_hash();
   clear_consts_hash();
@@ -1236,6 +1235,10 @@ int CommandBuildModel(int argc, char ** argv)
 
   compile_build_model(force_build); /* does the work */
 
+  if (opt_bdd_compaction(OptsHandler_get_instance())) {
+    dd_compact(dd_manager);
+  }
+
   if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
     fprintf(nusmv_stderr,
             "\nThe model has been built from file %s.\n", get_input_file(OptsHandler_get_instance()));
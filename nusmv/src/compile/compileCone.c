@@ -151,6 +151,27 @@ const int _UNTIMED_NEXT = -1;
   }
 
 
+/**Macro***********************************************************************
+
+  Synopsis     [Bitset helpers used by the COI computation]
+
+  Description  [Bitsets are arrays of unsigned long, COI_BITSET_WORDS(n)
+  words long for n elements.]
+
+  SeeAlso      [ComputeCOI]
+
+******************************************************************************/
+#define COI_BITS_PER_WORD (8 * sizeof(unsigned long))
+#define COI_BITSET_WORDS(n) \
+  (((n) + COI_BITS_PER_WORD - 1) / COI_BITS_PER_WORD)
+#define COI_BIT_TEST(bs, i) \
+  (0 != ((bs)[(i) / COI_BITS_PER_WORD] & (1UL << ((i) % COI_BITS_PER_WORD))))
+#define COI_BIT_SET(bs, i) \
+  ((bs)[(i) / COI_BITS_PER_WORD] |= (1UL << ((i) % COI_BITS_PER_WORD)))
+#define COI_BIT_CLEAR(bs, i) \
+  ((bs)[(i) / COI_BITS_PER_WORD] &= ~(1UL << ((i) % COI_BITS_PER_WORD)))
+
+
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
@@ -160,6 +181,40 @@ const int _UNTIMED_NEXT = -1;
 /* Structure declarations                                                    */
 /*---------------------------------------------------------------------------*/
 
+/**Struct**********************************************************************
+
+  Synopsis    [Variable dependency graph]
+
+  Description [Symbols are mapped to dense ids through sym2id (which
+  stores id + 1). The successors of the symbol with id i are
+  col[row[i]] ... col[row[i+1] - 1], in the same order they occur in
+  the cone at depth 0 of the symbol. Ids below num_vars are the
+  variables of the symbol table; the remaining ones are symbols only
+  occurring within cones, which have no successors.
+
+  queue, closed and in_coi are working areas of ComputeCOI. The two
+  bitsets are kept cleared between calls.]
+
+******************************************************************************/
+typedef struct CoiGraph_TAG {
+  hash_ptr sym2id;
+  node_ptr* syms;
+  int num_vars;
+  int size;
+  int capacity;
+
+  int* row;
+  int* col;
+
+  int* queue;
+  unsigned long* closed;
+  unsigned long* in_coi;
+} CoiGraph;
+
+typedef CoiGraph* CoiGraph_ptr;
+
+#define COI_GRAPH(x) ((CoiGraph_ptr) x)
+
 
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
@@ -167,47 +222,29 @@ const int _UNTIMED_NEXT = -1;
 
 /**Variable********************************************************************
 
-  Synopsis    [The hash of cone for a variable]
+  Synopsis    [The variable dependency graph used to compute cones]
 
-  Description [This hash associates to a variable the corresponding
-  cone of influence, once it has been computes.]
+  Description [Built by coiInit from the cones at depth 0 of all the
+  variables, and released by clear_coi_graph.]
 
-  SeeAlso     []
+  SeeAlso     [ComputeCOI]
 
 ******************************************************************************/
-static hash_ptr coi_hash = (hash_ptr) NULL;
-void init_coi_hash() {
-  if (coi_hash == (hash_ptr) NULL) {
-    coi_hash = new_assoc();
-    nusmv_assert(coi_hash != (hash_ptr) NULL);
+static CoiGraph_ptr coi_graph = COI_GRAPH(NULL);
+
+void clear_coi_graph() {
+  if (COI_GRAPH(NULL) != coi_graph) {
+    free_assoc(coi_graph->sym2id);
+    FREE(coi_graph->syms);
+    FREE(coi_graph->row);
+    FREE(coi_graph->col);
+    FREE(coi_graph->queue);
+    FREE(coi_graph->closed);
+    FREE(coi_graph->in_coi);
+    FREE(coi_graph);
+    coi_graph = COI_GRAPH(NULL);
   }
 }
-void insert_coi_hash(node_ptr key, Set_t value) {
-  nusmv_assert(coi_hash != (hash_ptr)NULL);
-  if (value != BUILDING_DEP_SET && value != NO_DEP_SET && value != NULL) {
-    value = Set_Freeze(value);
-    value = Set_Copy(value);
-  }
-  insert_assoc(coi_hash, key, (node_ptr)value);
-}
-Set_t lookup_coi_hash(node_ptr key) {
-  nusmv_assert(coi_hash != (hash_ptr)NULL);
-  return (Set_t) find_assoc(coi_hash, key);
-}
-
-static assoc_retval coi_hash_free(char *key, char *data, char * arg)
-{
-  Set_t element = (Set_t) data;
-
-  if (((Set_t)NULL != element) && (NO_DEP_SET != element)) {
-    Set_ReleaseSet(element);
-  }
-  return ASSOC_DELETE;
-}
-
-void clear_coi_hash() {
-  FREE_HASH_ENTRIES(coi_hash, coi_hash_free);
-}
 
 
 /**Variable********************************************************************
@@ -443,8 +480,10 @@ _coi_get_var_coi0 ARGS((SymbTable_ptr st,
                         boolean use_cache));
 
 
-static Set_t
-computeCoiVar ARGS((SymbTable_ptr st, FlatHierarchy_ptr fh, node_ptr var));
+static void coi_graph_build ARGS((const SymbTable_ptr symb_table));
+
+static int
+coi_graph_get_id ARGS((CoiGraph_ptr self, node_ptr sym, boolean create));
 
 /**AutomaticEnd***************************************************************/
 
@@ -678,13 +717,63 @@ Set_t ComputeCOI(const SymbTable_ptr symb_table, Set_t base)
     }
   }
 
-  SET_FOREACH(base, iter) {
-    node_ptr var = Set_GetMember(base, iter);
+  /* The cone of each variable of base is visited breadth first, in
+     the order base lists them. Nodes reached by a previous visit are
+     closed: their cones have been entirely added already, so they are
+     not entered again. The variables are added to coi in the same
+     order the layered fixpoint on the cones at depth 0 would find
+     them. */
+  {
+    CoiGraph_ptr g = coi_graph;
+    int head = 0, tail = 0;
+    int i;
 
+    nusmv_assert(COI_GRAPH(NULL) != g);
+
+    SET_FOREACH(base, iter) {
+      int id = coi_graph_get_id(g, Set_GetMember(base, iter), false);
+      if (id >= 0) COI_BIT_SET(g->in_coi, id);
+    }
 
-    /*   [MR2??]: by making it explicit on which hierarchy it operates. */
-    Set_t varcoi = computeCoiVar(symb_table, mainFlatHierarchy, var);
-    coi = Set_Union(coi, varcoi);
+    SET_FOREACH(base, iter) {
+      int id = coi_graph_get_id(g, Set_GetMember(base, iter), false);
+
+      /* Variables declared after the initialization have no cone */
+      if (id < 0 || id >= g->num_vars || COI_BIT_TEST(g->closed, id)) {
+        continue;
+      }
+
+      COI_BIT_SET(g->closed, id);
+      g->queue[tail++] = id;
+
+      while (head < tail) {
+        int v = g->queue[head++];
+        int e;
+
+        if (!COI_BIT_TEST(g->in_coi, v)) {
+          COI_BIT_SET(g->in_coi, v);
+          coi = Set_AddMember(coi, (Set_Element_t) g->syms[v]);
+        }
+
+        for (e = g->row[v]; e < g->row[v+1]; ++e) {
+          int u = g->col[e];
+          if (!COI_BIT_TEST(g->closed, u)) {
+            COI_BIT_SET(g->closed, u);
+            g->queue[tail++] = u;
+          }
+        }
+      }
+    }
+
+    /* clears the working bitsets */
+    for (i = 0; i < tail; ++i) {
+      COI_BIT_CLEAR(g->closed, g->queue[i]);
+      COI_BIT_CLEAR(g->in_coi, g->queue[i]);
+    }
+    SET_FOREACH(base, iter) {
+      int id = coi_graph_get_id(g, Set_GetMember(base, iter), false);
+      if (id >= 0) COI_BIT_CLEAR(g->in_coi, id);
+    }
   }
 
   return coi;
@@ -1476,8 +1565,6 @@ static void coiInit(const SymbTable_ptr symb_table, FlatHierarchy_ptr hierarchy)
 {
   SymbTableIter iter;
 
-  init_coi_hash(); /* no action is taken here if already initialized */
-
   if (COI_VERBOSE) { fprintf(nusmv_stdout,"*** INIT COI ***\n"); }
 
   SYMB_TABLE_FOREACH(symb_table, iter, STT_VAR) {
@@ -1491,9 +1578,6 @@ static void coiInit(const SymbTable_ptr symb_table, FlatHierarchy_ptr hierarchy)
 
     base = _coi_get_var_coi0(symb_table, hierarchy, var, &nonassign, true);
 
-    /* We associate to the var no set */
-    insert_coi_hash(var, NO_DEP_SET);
-
     if (COI_VERBOSE) {
       fprintf(nusmv_stdout,"Variable  ");
       print_node(nusmv_stdout, var);
@@ -1510,6 +1594,8 @@ static void coiInit(const SymbTable_ptr symb_table, FlatHierarchy_ptr hierarchy)
 
     Set_ReleaseSet(base);
   } /* vars iteration */
+
+  coi_graph_build(symb_table);
 }
 
 
@@ -1952,57 +2038,111 @@ formulaGetConstantsRecur(const SymbTable_ptr symb_table,
 
 /**Function********************************************************************
 
-  Synopsis           [Computes the complete cone for a given variable.]
+  Synopsis           [Builds the variable dependency graph]
 
-  Description        [optional]
+  Description        [The graph is built from the cones at depth 0
+  memoized by coiInit, for all the variables of the given symbol
+  table. A previously built graph is released.]
 
-  SideEffects        [required]
+  SideEffects        [coi_graph is rebuilt]
 
-  SeeAlso            [optional]
+  SeeAlso            [coiInit, ComputeCOI]
 
 ******************************************************************************/
-static Set_t
-computeCoiVar(SymbTable_ptr st, FlatHierarchy_ptr fh, node_ptr var)
+static void coi_graph_build(const SymbTable_ptr symb_table)
 {
-  Set_t result;
+  CoiGraph_ptr g;
+  SymbTableIter iter;
+  int edges_cap, num_edges;
+  int i;
 
-  result = lookup_coi_hash(var);
+  clear_coi_graph();
 
-  if (NO_DEP_SET != result) return result;
+  g = ALLOC(CoiGraph, 1);
+  nusmv_assert(COI_GRAPH(NULL) != g);
 
-  result = Set_MakeSingleton(var);
+  g->sym2id = new_assoc();
+  g->syms = (node_ptr*) NULL;
+  g->num_vars = 0;
+  g->size = 0;
+  g->capacity = 0;
 
-  {
-    Set_t vars_left = Set_Copy(result);
-    Set_Iterator_t iter;
-    Set_t new_vars, vdeps;
-    boolean nonassign = false;
-    node_ptr v;
+  /* Variables come first, so that their ids are contiguous */
+  SYMB_TABLE_FOREACH(symb_table, iter, STT_VAR) {
+    coi_graph_get_id(g, SymbTable_iter_get_symbol(symb_table, &iter), true);
+  }
+  g->num_vars = g->size;
+
+  g->row = ALLOC(int, g->num_vars + 1);
+  edges_cap = g->num_vars + 1;
+  g->col = ALLOC(int, edges_cap);
+  num_edges = 0;
 
-    while (!Set_IsEmpty(vars_left)) {
+  for (i = 0; i < g->num_vars; ++i) {
+    Set_t coi0 = lookup_coi0_hash(g->syms[i]);
+    Set_Iterator_t siter;
 
-      new_vars = Set_MakeEmpty();
+    g->row[i] = num_edges;
+    if (NO_DEP_SET == coi0) continue;
 
-      SET_FOREACH(vars_left, iter) {
-        v = NODE_PTR(Set_GetMember(vars_left, iter));
-        vdeps = _coi_get_var_coi0(st, fh, v, &nonassign, true);
-        new_vars = Set_Union(new_vars, vdeps);
-        Set_ReleaseSet(vdeps);
+    SET_FOREACH(coi0, siter) {
+      if (num_edges == edges_cap) {
+        edges_cap *= 2;
+        g->col = REALLOC(int, g->col, edges_cap);
       }
-      /* Put in vars_left the new fresh variables */
-      Set_ReleaseSet(vars_left);
-      vars_left = Set_Copy(new_vars);
-      vars_left = Set_Difference(vars_left, result);
-      result = Set_Union(result, new_vars);
-      Set_ReleaseSet(new_vars);
+      g->col[num_edges++] = coi_graph_get_id(g, Set_GetMember(coi0, siter),
+                                             true);
     }
+  }
 
-    Set_ReleaseSet(vars_left);
+  /* Symbols which are not variables have no successors */
+  g->row = REALLOC(int, g->row, g->size + 1);
+  for (i = g->num_vars; i <= g->size; ++i) g->row[i] = num_edges;
+
+  g->queue = ALLOC(int, g->size + 1);
+  g->closed = ALLOC(unsigned long, COI_BITSET_WORDS(g->size + 1));
+  g->in_coi = ALLOC(unsigned long, COI_BITSET_WORDS(g->size + 1));
+  memset(g->closed, 0,
+         COI_BITSET_WORDS(g->size + 1) * sizeof(unsigned long));
+  memset(g->in_coi, 0,
+         COI_BITSET_WORDS(g->size + 1) * sizeof(unsigned long));
+
+  if (COI_VERBOSE) {
+    fprintf(nusmv_stdout, "COI graph: %d variables, %d symbols, %d edges\n",
+            g->num_vars, g->size, num_edges);
   }
 
-  insert_coi_hash(var, result);
+  coi_graph = g;
+}
 
-  return result;
+
+/**Function********************************************************************
+
+  Synopsis           [Returns the id of the given symbol in the graph]
+
+  Description        [Returns -1 if the symbol is not part of the
+  graph, unless create is true. In that case a fresh id is assigned
+  to the symbol.]
+
+  SideEffects        [The graph may grow when create is true]
+
+  SeeAlso            [coi_graph_build]
+
+******************************************************************************/
+static int coi_graph_get_id(CoiGraph_ptr self, node_ptr sym, boolean create)
+{
+  node_ptr id = find_assoc(self->sym2id, sym);
+
+  if (Nil != id) return PTR_TO_INT(id) - 1;
+  if (!create) return -1;
+
+  if (self->size == self->capacity) {
+    self->capacity = (0 == self->capacity) ? 64 : 2 * self->capacity;
+    self->syms = REALLOC(node_ptr, self->syms, self->capacity);
+  }
+  self->syms[self->size] = sym;
+  insert_assoc(self->sym2id, sym, PTR_FROM_INT(node_ptr, self->size + 1));
+  return self->size++;
 }
 
 
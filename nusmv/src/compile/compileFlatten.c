@@ -80,6 +80,7 @@
 #include "utils/assoc.h"
 #include "utils/error.h"
 #include "utils/range.h"
+#include "utils/Profile.h"
 
 #include "hrc/hrc.h"
 
@@ -512,6 +513,8 @@ Compile_FlattenHierarchy(
   /* Take care of redefinitions of module instances. */
   hash_ptr instances = new_assoc();
 
+  Profile_begin("flatten_hierarchy");
+
   /* creation of hrc structure */
   /* warning The way hrc structure is instatiated will be refactored. The
      actual implementation is not definitive */
@@ -558,6 +561,8 @@ Compile_FlattenHierarchy(
   }
 
   free_assoc(instances);
+
+  Profile_end("flatten_hierarchy");
   return result;
 }
 
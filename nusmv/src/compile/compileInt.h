@@ -93,10 +93,7 @@ EXTERN int CommandCPPrintClusterInfo ARGS((int argc, char ** argv));
 EXTERN cmp_struct_ptr cmp_struct_init ARGS((void));
 EXTERN void cmp_struct_quit ARGS((cmp_struct_ptr));
 
-EXTERN void init_coi_hash ARGS((void));
-EXTERN void clear_coi_hash ARGS((void));
-EXTERN void insert_coi_hash ARGS((node_ptr, Set_t));
-EXTERN Set_t lookup_coi_hash ARGS((node_ptr));
+EXTERN void clear_coi_graph ARGS((void));
 
 EXTERN void init_coi0_hash ARGS((void));
 EXTERN void clear_coi0_hash ARGS((void));
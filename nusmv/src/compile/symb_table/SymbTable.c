@@ -91,6 +91,7 @@ typedef struct SymbTable_TAG
   TypeChecker_ptr tc; /* this is the type checker owned by the ST */
 
   hash_ptr expr_simplify_hash; /* hash for function Expr_simplify */
+  hash_ptr expr_rewrite_hash; /* hash for the Expr_* constructors */
 
   ResolveSymbol_ptr resolver;
 } SymbTable;
@@ -331,6 +332,8 @@ void SymbTable_remove_layer(SymbTable_ptr self, SymbLayer_ptr layer)
       SymbLayer_destroy(layer);
       /* free the expression simplification hash. See info in Expr_simplify*/
       clear_assoc(self->expr_simplify_hash);
+      /* the same holds for the constructors memo, see Expr_equal */
+      clear_assoc(self->expr_rewrite_hash);
       return;
     }
 
@@ -1975,6 +1978,28 @@ hash_ptr SymbTable_get_simplification_hash(SymbTable_ptr self)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis           [Returns a hash which can be used only by the
+  simplifying Expr_* constructors.]
+
+  Description        [The hash memoizes the results of the constructors
+  whose simplifications depend on the types of the operands (like
+  Expr_equal). It is reset when any layer is removed. See function
+  Expr_equal for more details. ]
+
+  SideEffects        []
+
+  SeeAlso            [SymbTable_get_simplification_hash]
+
+******************************************************************************/
+hash_ptr SymbTable_get_rewrite_hash(SymbTable_ptr self)
+{
+  SYMB_TABLE_CHECK_INSTANCE(self);
+  return self->expr_rewrite_hash;
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Create a new SymbolTable which contains the same info
@@ -2562,6 +2587,7 @@ static void symb_table_init(SymbTable_ptr self)
   self->tc = TypeChecker_create_with_default_checkers(self);
 
   self->expr_simplify_hash = new_assoc();
+  self->expr_rewrite_hash = new_assoc();
 
   self->resolver = ResolveSymbol_create();
 }
@@ -2607,6 +2633,8 @@ static void symb_table_deinit(SymbTable_ptr self)
 
   free_assoc(self->expr_simplify_hash);
   self->expr_simplify_hash = NULL;
+  free_assoc(self->expr_rewrite_hash);
+  self->expr_rewrite_hash = NULL;
 
   TypeChecker_destroy(self->tc);
   self->tc = TYPE_CHECKER(NULL);
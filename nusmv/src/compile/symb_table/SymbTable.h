@@ -545,6 +545,9 @@ SymbTable_get_fresh_symbol_name ARGS((SymbTable_ptr self,
 EXTERN hash_ptr
 SymbTable_get_simplification_hash ARGS((SymbTable_ptr self));
 
+EXTERN hash_ptr
+SymbTable_get_rewrite_hash ARGS((SymbTable_ptr self));
+
 EXTERN const char*
 SymbTable_get_class_of_layer ARGS((const SymbTable_ptr self,
                                    const char* layer_name));
@@ -55,6 +55,7 @@
 #include "ddInt.h"
 #include "enc/operators.h"
 #include "parser/symbols.h" /* for FAILURE value */
+#include "utils/Profile.h"
 
 static char rcsid[] UTIL_UNUSED = "$Id: dd.c,v 1.7.6.12.2.1.2.6.4.20 2010-02-08 12:25:27 nusmv Exp $";
 
@@ -89,6 +90,11 @@ node_ptr boolean_range = Nil;
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 static void InvalidType(FILE *file, char *field, char *expected);
+static double dd_profile_live_nodes(void* arg);
+static double dd_profile_peak_live_nodes(void* arg);
+static void dd_profile_set_peak_live_nodes(void* arg, double value);
+static double dd_profile_cache_hits(void* arg);
+static double dd_profile_cache_lookups(void* arg);
 
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
@@ -126,6 +132,16 @@ DdManager* init_dd_package()
   dd = Cudd_Init(0, 0, UNIQUE_SLOTS, CACHE_SLOTS, 0,
                  zero_number, one_number, false_const, true_const);
   common_error(dd, "init_dd_package: Unable to initialize the manager.");
+
+  /* BDD statistics collected for each profiled phase */
+  Profile_register_probe("bdd_nodes", PROFILE_PROBE_DELTA,
+                         dd_profile_live_nodes, NULL, NULL, dd);
+  Profile_register_probe("peak_live_nodes", PROFILE_PROBE_PEAK,
+                         dd_profile_peak_live_nodes, NULL,
+                         dd_profile_set_peak_live_nodes, dd);
+  Profile_register_probe("cache_hit_rate", PROFILE_PROBE_RATIO,
+                         dd_profile_cache_hits, dd_profile_cache_lookups,
+                         NULL, dd);
   return(dd);
 }
 
@@ -144,6 +160,10 @@ DdManager* init_dd_package()
 ******************************************************************************/
 void quit_dd_package(DdManager * dd)
 {
+  Profile_unregister_probe("bdd_nodes");
+  Profile_unregister_probe("peak_live_nodes");
+  Profile_unregister_probe("cache_hit_rate");
+
   Cudd_Quit(dd);
 }
 
@@ -500,6 +520,36 @@ int dd_reorder(DdManager *dd, int method, int minsize)
 } /* end of dd_reorder */
 
 
+/**Function********************************************************************
+
+  Synopsis    [Relocates the BDD nodes into contiguous blocks by level.]
+
+  Description [Copies the nodes that are referenced only by other nodes
+  into freshly allocated memory, level by level, so that operations
+  proceeding level by level access memory sequentially. Nodes owned
+  directly by NuSMV (i.e. referenced through bdd_ref, bdd_dup, add_dup
+  and similar) keep their address, thus no pointer held outside the
+  DD package is invalidated. Returns the number of relocated nodes.<p>
+  Must be called only when no DD operation is in progress.]
+
+  SideEffects [Garbage collects and flushes the computed table.]
+
+  SeeAlso     [dd_reorder]
+
+******************************************************************************/
+int dd_compact(DdManager *dd)
+{
+  int result;
+
+  result = Cudd_CompactNodes(dd);
+  if (result < 0) {
+    rpterr("dd_compact: compaction of ADD/BDD fails.");
+    nusmv_exit(1);
+  }
+  return(result);
+} /* end of dd_compact */
+
+
 /**Function********************************************************************
 
   Synopsis    [Returns the number of times reordering has occurred.]
@@ -949,6 +999,29 @@ int dd_set_parameters(DdManager *mgr, OptsHandler_ptr opt, FILE *file)
         Cudd_SetNumberXovers(mgr, uvalue);
       }
     }
+    else if (strcmp(paramName, "Huge page node memory enabled") == 0) {
+      if (strcmp(paramValue, "yes") == 0) {
+        if (Cudd_EnableHugePages(mgr) == 0) {
+          fprintf(file, "Warning: huge page node memory is not supported ");
+          fprintf(file, "on this platform.\n");
+        }
+      }
+      else if (strcmp(paramValue, "no") == 0) {
+        Cudd_DisableHugePages(mgr);
+      }
+      else {
+        InvalidType(file, "Huge page node memory enabled", "(yes,no)");
+      }
+    }
+    else if (strcmp(paramName, "Huge page region size in MB") == 0) {
+      uvalue = (unsigned int) strtol(paramValue, &invalidChar, 10);
+      if (*invalidChar || uvalue == 0) {
+        InvalidType(file, "Huge page region size in MB", "positive integer");
+      }
+      else {
+        Cudd_SetRegionSize(mgr, ((unsigned long) uvalue) << 20);
+      }
+    }
     else {
       fprintf(file, "Warning: Parameter %s not recognized.", paramName);
       fprintf(file, " Ignored.\n");
@@ -3588,3 +3661,74 @@ static void InvalidType(FILE *file, char *field, char *expected)
     fprintf(file, "Illegal type detected. %s expected\n", expected);
 
 } /* end of InvalidType */
+
+
+/**Function********************************************************************
+
+  Synopsis           [Profiling probe: number of live nodes]
+
+  SideEffects        []
+
+******************************************************************************/
+static double dd_profile_live_nodes(void* arg)
+{
+  DdManager* dd = (DdManager*) arg;
+  return (double) (Cudd_ReadKeys(dd) - Cudd_ReadDead(dd));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Profiling probe: peak number of live nodes]
+
+  SideEffects        []
+
+******************************************************************************/
+static double dd_profile_peak_live_nodes(void* arg)
+{
+  return (double) Cudd_ReadPeakLiveNodeCount((DdManager*) arg);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Profiling probe: sets the peak number of live
+  nodes]
+
+  Description        [Used to make the peak local to a profiled phase.
+  Cudd_ReadPeakLiveNodeCount never returns less than the current number
+  of live nodes, so 0 resets the peak to the current value.]
+
+  SideEffects        []
+
+******************************************************************************/
+static void dd_profile_set_peak_live_nodes(void* arg, double value)
+{
+  Cudd_SetPeakLiveNodeCount((DdManager*) arg, (unsigned int) value);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Profiling probe: computed table hits]
+
+  SideEffects        []
+
+******************************************************************************/
+static double dd_profile_cache_hits(void* arg)
+{
+  return Cudd_ReadCacheHits((DdManager*) arg);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Profiling probe: computed table lookups]
+
+  SideEffects        []
+
+******************************************************************************/
+static double dd_profile_cache_lookups(void* arg)
+{
+  return Cudd_ReadCacheLookUps((DdManager*) arg);
+}
@@ -190,6 +190,7 @@ EXTERN void     dd_autodyn_enable       ARGS((DdManager *, dd_reorderingtype));
 EXTERN void     dd_autodyn_disable      ARGS((DdManager *));
 EXTERN int      dd_reordering_status    ARGS((DdManager *, dd_reorderingtype *));
 EXTERN int      dd_reorder              ARGS((DdManager *, int, int));
+EXTERN int      dd_compact              ARGS((DdManager *));
 EXTERN int      dd_get_reorderings      ARGS((DdManager *));
 EXTERN dd_reorderingtype dd_get_ordering_method  ARGS((DdManager *));
 EXTERN int      StringConvertToDynOrderType  ARGS((char *string));
@@ -46,6 +46,7 @@ static char rcsid[] UTIL_UNUSED = "$Id: ddCmd.c,v 1.6.16.2 2006-05-15 09:06:16 n
 int CommandDynamicVarOrdering ARGS((int argc, char **argv));
 int CommandSetBddParameters ARGS((int argc, char ** argv));
 int CommandPrintBddStats ARGS((int argc, char ** argv));
+int CommandCompactBdds ARGS((int argc, char ** argv));
 
 /*---------------------------------------------------------------------------*/
 /* Static function prototypes                                                */
@@ -61,6 +62,7 @@ void dd_AddCmd(void)
   Cmd_CommandAdd("dynamic_var_ordering", CommandDynamicVarOrdering, 0, true);
   Cmd_CommandAdd("set_bdd_parameters" , CommandSetBddParameters, 0, true);
   Cmd_CommandAdd("print_bdd_stats" , CommandPrintBddStats, 0, true);
+  Cmd_CommandAdd("compact_bdds" , CommandCompactBdds, 0, true);
 
 }
 
@@ -157,6 +159,8 @@ void dd_AddCmd(void)
     <dt> <tt>-f &lt;method&gt;</tt>
      <dd> Force dynamic ordering to be invoked immediately. The values for
           <tt>&lt;method&gt;</tt> are the same as in option <tt>-e</tt>.
+          If the variable <tt>bdd_compaction</tt> is set, the BDD nodes
+          are also compacted afterwards (see <tt>compact_bdds</tt>).
   </dl>]  
 
   SideEffects        []
@@ -261,6 +265,9 @@ int CommandDynamicVarOrdering(int argc, char **argv)
     fprintf(nusmv_stdout, "with method %s....\n",
                    DynOrderTypeConvertToString(dynOrderingMethod));
     dd_reorder(dd_manager, dynOrderingMethod, DEFAULT_MINSIZE);
+    if (opt_bdd_compaction(OptsHandler_get_instance())) {
+      dd_compact(dd_manager);
+    }
   }
 
   return 0;
@@ -410,3 +417,80 @@ usage:
 
   return 1;
 }
+
+/**Function********************************************************************
+
+  Synopsis    [Implements the compact_bdds command.]
+
+  SideEffects []
+
+  CommandName [compact_bdds]
+
+  CommandSynopsis [Relocates the BDD nodes into contiguous memory by level]
+
+  CommandArguments [\[-h\] \[-v\]]
+
+  CommandDescription [After many variable reorderings and garbage
+  collections the nodes belonging to the same variable are scattered
+  over the whole memory of the BDD package. This command copies the
+  nodes into freshly allocated memory one level after the other, so
+  that operations like image computation access memory sequentially,
+  and gives back to the system the memory that is left unused.
+  Only internal nodes are relocated: the BDDs held by the encodings,
+  FSMs and caches keep their address.<p>
+
+  If the variable <tt>bdd_compaction</tt> is set, compaction is also
+  performed after each forced reordering (<tt>dynamic_var_ordering
+  -f</tt>) and at the end of <tt>build_model</tt>.<p>
+
+  Command options:<p>
+  <dl>
+    <dt> -v
+       <dd> Prints the number of relocated nodes and the memory in use
+       before and after the compaction.
+  </dl>
+  ]
+
+******************************************************************************/
+int CommandCompactBdds(int argc, char ** argv)
+{
+  boolean verbose = false;
+  long mem_before;
+  int moved;
+  int c;
+
+  util_getopt_reset();
+  while ((c = util_getopt(argc, argv, "hv")) != EOF) {
+    switch (c) {
+      case 'h':
+        goto usage;
+        break;
+      case 'v':
+        verbose = true;
+        break;
+      default:
+        goto usage;
+    }
+  }
+
+  if (dd_manager == NIL(DdManager)) {
+    fprintf(nusmv_stderr, "The DD Manager has not been created yet.\n");
+    return 1;
+  }
+
+  mem_before = Cudd_ReadMemoryInUse(dd_manager);
+  moved = dd_compact(dd_manager);
+  if (verbose) {
+    fprintf(nusmv_stdout, "Relocated BDD nodes: %d\n", moved);
+    fprintf(nusmv_stdout, "Memory in use: %ld bytes (was %ld bytes)\n",
+            (long) Cudd_ReadMemoryInUse(dd_manager), mem_before);
+  }
+  return 0;  /* Everything okay */
+
+usage:
+  fprintf(nusmv_stderr, "usage: compact_bdds [-h] [-v]\n");
+  fprintf(nusmv_stderr, "   -h  Prints the command usage.\n");
+  fprintf(nusmv_stderr, "   -v  Prints the number of relocated nodes.\n");
+
+  return 1;
+}
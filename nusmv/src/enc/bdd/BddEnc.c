@@ -53,6 +53,7 @@
 #include "compile/symb_table/ResolveSymbol.h"
 #include "compile/symb_table/SymbTable.h"
 #include "enc/operators.h"
+#include "fsm/sexp/Expr.h"
 
 #include "parser/ord/ParserOrd.h"
 
@@ -63,6 +64,7 @@
 #include "utils/ustring.h"
 #include "utils/utils_io.h"
 #include "utils/ucmd.h"
+#include "utils/Profile.h"
 #include "utils/array.h"
 #include "utils/defs.h"
 #include "cinit/cinit.h"
@@ -3470,6 +3472,25 @@ void BddEnc_clean_evaluation_cache(BddEnc_ptr self)
 }
 
 
+/**Function********************************************************************
+
+   Synopsis           [Prints statistics about the internal cache which
+   contains the results of evaluation of expressions to ADD or BDD form.]
+
+   Description        [See BddEncCache_print_stats]
+
+   SideEffects        []
+
+   SeeAlso            [BddEnc_clean_evaluation_cache]
+
+******************************************************************************/
+void BddEnc_print_evaluation_cache_stats(BddEnc_ptr self, FILE* file)
+{
+  BDD_ENC_CHECK_INSTANCE(self);
+  BddEncCache_print_stats(self->cache, file);
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Dumps the given AddArray in DOT format]
@@ -3810,6 +3831,8 @@ void bdd_enc_commit_layer(BaseEnc_ptr enc_base, const char* layer_name)
   self = BDD_ENC(enc_base);
   symbTable = BASE_ENC(self)->symb_table;
 
+  Profile_begin("bdd_encoding");
+
   /* Calls the base method to add this layer */
   bool_enc_client_commit_layer(enc_base, layer_name);
 
@@ -3999,6 +4022,7 @@ void bdd_enc_commit_layer(BaseEnc_ptr enc_base, const char* layer_name)
     OrdGroups_destroy(groups);
   }
 
+  Profile_end("bdd_encoding");
 }
 
 
@@ -6374,7 +6398,8 @@ static AddArray_ptr bdd_enc_eval(BddEnc_ptr self, Expr_ptr expr,
 
   if (expr == Nil) return AddArray_from_add(add_true(self->dd));
 
-  hash_entry = find_node(CONTEXT, context, expr);
+  /* a op b and b op a share the entry for commutative operators */
+  hash_entry = find_node(CONTEXT, context, Expr_get_lookup_key(expr));
   res = BddEncCache_get_evaluation(self->cache, hash_entry);
 
   if ((res == (AddArray_ptr) NULL) || (res == BDD_ENC_EVALUATING)) {
@@ -392,6 +392,9 @@ BddEnc_bdd_to_wff ARGS ((BddEnc_ptr self, bdd_ptr bdd, NodeList_ptr vars));
 EXTERN void
 BddEnc_clean_evaluation_cache ARGS((BddEnc_ptr self));
 
+EXTERN void
+BddEnc_print_evaluation_cache_stats ARGS((BddEnc_ptr self, FILE* file));
+
 EXTERN BddVarSet_ptr BddEnc_get_vars_cube ARGS((const BddEnc_ptr self,
                                                 Set_t vars,
                                                 SymbFilterType vt));
@@ -56,6 +56,29 @@ static char rcsid[] UTIL_UNUSED = "$Id: BddEncCache.c,v 1.1.2.12.4.6.6.10 2009-0
 /*---------------------------------------------------------------------------*/
 
 
+/**Struct**********************************************************************
+
+  Synopsis    [An entry of the evaluation cache]
+
+  Description [Entries are kept in a doubly linked list ordered by
+  recency of use (most recently used first), which is used to evict
+  entries when the evaluation cache exceeds its budget. Size is the
+  number of ADD nodes of the array, 0 if it has not been computed yet.]
+
+******************************************************************************/
+typedef struct BddEncCacheEntry_TAG
+{
+  node_ptr expr;
+  AddArray_ptr add_array;
+  size_t size;
+
+  struct BddEncCacheEntry_TAG* prev;
+  struct BddEncCacheEntry_TAG* next;
+} BddEncCacheEntry;
+
+typedef BddEncCacheEntry* BddEncCacheEntry_ptr;
+
+
 /**Struct**********************************************************************
 
   Synopsis    [The BddEncCache class]
@@ -81,9 +104,28 @@ typedef struct BddEncCache_TAG
   /* associates var names with corresponding ADDs */
   hash_ptr vars_hash;
 
-  /* hash table used by the evaluator */
+  /* hash table used by the evaluator. It associates expressions to
+  BDD_ENC_EVALUATING or to entries of the LRU list */
   hash_ptr eval_hash;  
 
+  /* the evaluation LRU list, and the overall number of ADD nodes of
+  its entries (meaningful only if eval_sized is true) */
+  BddEncCacheEntry_ptr eval_first;
+  BddEncCacheEntry_ptr eval_last;
+  size_t eval_nodes;
+  boolean eval_sized;
+
+  /* counts the misses of each expression, used when only shared
+  expressions have to be kept (option sexp2bdd_cache_shared_only) */
+  hash_ptr miss_hash;
+
+  /* statistics */
+  long entries;
+  long hits;
+  long misses;
+  long evictions;
+  long rejections;
+
 } BddEncCache;
 
 
@@ -109,12 +151,27 @@ static void bdd_enc_cache_deinit ARGS((BddEncCache_ptr self));
 static assoc_retval 
 hash_free_add ARGS((char* key, char* data, char* arg));
 
-static assoc_retval 
-hash_free_add_array ARGS((char* key, char* data, char* arg));
-
 static assoc_retval 
 hash_free_add_counted ARGS((char* key, char* data, char* arg));
 
+static void 
+bdd_enc_cache_unlink_entry ARGS((BddEncCache_ptr self,
+                                 BddEncCacheEntry_ptr entry));
+
+static void 
+bdd_enc_cache_push_entry ARGS((BddEncCache_ptr self,
+                               BddEncCacheEntry_ptr entry));
+
+static void 
+bdd_enc_cache_free_entry ARGS((BddEncCache_ptr self,
+                               BddEncCacheEntry_ptr entry));
+
+static void 
+bdd_enc_cache_free_evaluations ARGS((BddEncCache_ptr self));
+
+static void 
+bdd_enc_cache_evict ARGS((BddEncCache_ptr self, size_t budget));
+
 
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
@@ -407,8 +464,18 @@ add_ptr BddEncCache_lookup_boolean_var(const BddEncCache_ptr self,
   and its ADD representation.]
 
   Description [The provided array of ADD will belong to "self"
-  and will be freed during destruction of the class or setting a new 
-  value for the same node_ptr.
+  and will be freed during destruction of the class, setting a new 
+  value for the same node_ptr or when the entry is evicted.
+
+  If NuSMV option "sexp2bdd_cache_size" is set to a positive value,
+  the least recently used entries are evicted as soon as the overall
+  number of ADD nodes held by the cache exceeds that value. Entries
+  being evaluated (BDD_ENC_EVALUATING) are never evicted.
+
+  If NuSMV option "sexp2bdd_cache_shared_only" is set, the result is
+  kept only if expr has been looked up without success at least
+  twice, i.e. if expr occurs more than once. Otherwise the given
+  add_array is immediately freed.
 
   NOTE: if NuSMV option "enable_sexp2bdd_caching" is unset to 0 then no
   result is kept and the provided add_array is immediately freed]
@@ -421,22 +488,47 @@ add_ptr BddEncCache_lookup_boolean_var(const BddEncCache_ptr self,
 void BddEncCache_set_evaluation(BddEncCache_ptr self, node_ptr expr,
                                 AddArray_ptr add_array)
 {
-  AddArray_ptr old_array;
+  OptsHandler_ptr opts = OptsHandler_get_instance();
+  BddEncCacheEntry_ptr entry;
+  int budget;
+
   BDD_ENC_CACHE_CHECK_INSTANCE(self);
 
-  if (!opt_enable_sexp2bdd_caching(OptsHandler_get_instance())) { /* caching is disabled */
+  if (!opt_enable_sexp2bdd_caching(opts)) { /* caching is disabled */
     if (add_array != BDD_ENC_EVALUATING && add_array != ADD_ARRAY(NULL)) {
       AddArray_destroy(self->dd, add_array);
     }
     return;
   }
 
-  old_array = ADD_ARRAY(find_assoc(self->eval_hash, expr));
-  if ((old_array != BDD_ENC_EVALUATING) && (old_array != ADD_ARRAY(NULL))){
-    nusmv_assert(old_array != add_array);
-    AddArray_destroy(self->dd, old_array);
+  /* the previous value (if any) is replaced */
+  BddEncCache_remove_evaluation(self, expr);
+
+  if (add_array == BDD_ENC_EVALUATING || add_array == ADD_ARRAY(NULL)) {
+    insert_assoc(self->eval_hash, expr, (node_ptr) add_array); 
+    return;
+  }
+
+  if (opt_sexp2bdd_cache_shared_only(opts) &&
+      NODE_TO_INT(find_assoc(self->miss_hash, expr)) < 2) {
+    AddArray_destroy(self->dd, add_array);
+    self->rejections += 1;
+    return;
   }
-  insert_assoc(self->eval_hash, expr, (node_ptr) add_array); 
+
+  budget = get_sexp2bdd_cache_size(opts);
+
+  entry = ALLOC(BddEncCacheEntry, 1);
+  nusmv_assert(entry != (BddEncCacheEntry_ptr) NULL);
+  entry->expr = expr;
+  entry->add_array = add_array;
+  entry->size = (budget > 0) ? AddArray_get_add_size(add_array, self->dd) : 0;
+
+  bdd_enc_cache_push_entry(self, entry);
+  insert_assoc(self->eval_hash, expr, (node_ptr) entry); 
+
+  if (budget > 0) bdd_enc_cache_evict(self, (size_t) budget);
+  else self->eval_sized = false;
 }
 
 
@@ -455,12 +547,14 @@ void BddEncCache_set_evaluation(BddEncCache_ptr self, node_ptr expr,
 ******************************************************************************/
 void BddEncCache_remove_evaluation(BddEncCache_ptr self, node_ptr expr)
 {
-  AddArray_ptr old_array;
+  BddEncCacheEntry_ptr entry;
   BDD_ENC_CACHE_CHECK_INSTANCE(self);
 
-  old_array = ADD_ARRAY(remove_assoc(self->eval_hash, expr));
-  if ((old_array != BDD_ENC_EVALUATING) && (old_array != ADD_ARRAY(NULL))){
-    AddArray_destroy(self->dd, old_array);
+  entry = (BddEncCacheEntry_ptr) remove_assoc(self->eval_hash, expr);
+  if ((ADD_ARRAY(entry) != BDD_ENC_EVALUATING) &&
+      (entry != (BddEncCacheEntry_ptr) NULL)) {
+    bdd_enc_cache_unlink_entry(self, entry);
+    bdd_enc_cache_free_entry(self, entry);
   }
 }
 
@@ -479,21 +573,42 @@ void BddEncCache_remove_evaluation(BddEncCache_ptr self, node_ptr expr)
   NB: For all expressions except of the Word type the returned 
   array can contain only one element.
   NB: If NuSMV option enable_sexp2bdd_caching is unset to 0 then the hash
-  may be empty.]
+  may be empty. Entries may be missing also because of the options
+  sexp2bdd_cache_size and sexp2bdd_cache_shared_only.]
 
-  SideEffects        []
+  SideEffects        [Hit and miss counters are updated]
 
   SeeAlso            []
 
 ******************************************************************************/
 AddArray_ptr BddEncCache_get_evaluation(BddEncCache_ptr self, node_ptr expr)
 {
-  AddArray_ptr res;
+  BddEncCacheEntry_ptr entry;
   BDD_ENC_CACHE_CHECK_INSTANCE(self);
-  res = ADD_ARRAY(find_assoc(self->eval_hash, expr));
-  /* create a duplicate, if it is possible */
-  if (ADD_ARRAY(NULL) == res || BDD_ENC_EVALUATING == res) return res;
-  return AddArray_duplicate(res);
+
+  entry = (BddEncCacheEntry_ptr) find_assoc(self->eval_hash, expr);
+
+  if (BDD_ENC_EVALUATING == ADD_ARRAY(entry)) return BDD_ENC_EVALUATING;
+
+  if ((BddEncCacheEntry_ptr) NULL == entry) {
+    self->misses += 1;
+    if (opt_sexp2bdd_cache_shared_only(OptsHandler_get_instance())) {
+      int count = NODE_TO_INT(find_assoc(self->miss_hash, expr));
+      if (count < 2) insert_assoc(self->miss_hash, expr, NODE_FROM_INT(count+1));
+    }
+    return ADD_ARRAY(NULL);
+  }
+
+  self->hits += 1;
+
+  /* the entry becomes the most recently used */
+  if (self->eval_first != entry) {
+    bdd_enc_cache_unlink_entry(self, entry);
+    bdd_enc_cache_push_entry(self, entry);
+  }
+
+  /* create a duplicate */
+  return AddArray_duplicate(entry->add_array);
 }
 
 
@@ -557,7 +672,48 @@ void BddEncCache_clean_evaluation_about(BddEncCache_ptr self,
 ******************************************************************************/
 void BddEncCache_clean_evaluation(BddEncCache_ptr self)
 {
-  st_foreach(self->eval_hash, &hash_free_add_array, (char*) self->dd);
+  bdd_enc_cache_free_evaluations(self);
+  clear_assoc(self->miss_hash);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Prints statistics about the evaluation cache]
+
+  Description [Prints the number of cached entries, the number of ADD
+  nodes they hold (when a budget is set), and the number of hits,
+  misses, evictions and rejected entries since the creation of the
+  cache]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void BddEncCache_print_stats(BddEncCache_ptr self, FILE* file)
+{
+  long lookups;
+
+  BDD_ENC_CACHE_CHECK_INSTANCE(self);
+
+  lookups = self->hits + self->misses;
+
+  fprintf(file, "Evaluation cache entries: %ld\n", self->entries);
+  if (get_sexp2bdd_cache_size(OptsHandler_get_instance()) > 0) {
+    fprintf(file, "Evaluation cache ADD nodes: %" PRIuPTR " (budget %d)\n",
+            self->eval_nodes,
+            get_sexp2bdd_cache_size(OptsHandler_get_instance()));
+  }
+  fprintf(file, "Evaluation cache lookups: %ld\n", lookups);
+  fprintf(file, "Evaluation cache hits: %ld", self->hits);
+  if (lookups > 0) {
+    fprintf(file, " (%.2f%%)", 100.0 * (double) self->hits / (double) lookups);
+  }
+  fprintf(file, "\n");
+  fprintf(file, "Evaluation cache misses: %ld\n", self->misses);
+  fprintf(file, "Evaluation cache evictions: %ld\n", self->evictions);
+  fprintf(file, "Evaluation cache rejected entries: %ld\n", self->rejections);
 }
 
 
@@ -590,6 +746,20 @@ static void bdd_enc_cache_init(BddEncCache_ptr self,
 
   self->eval_hash = new_assoc();
   nusmv_assert(self->eval_hash != (hash_ptr) NULL);
+
+  self->eval_first = (BddEncCacheEntry_ptr) NULL;
+  self->eval_last = (BddEncCacheEntry_ptr) NULL;
+  self->eval_nodes = 0;
+  self->eval_sized = true;
+
+  self->miss_hash = new_assoc();
+  nusmv_assert(self->miss_hash != (hash_ptr) NULL);
+
+  self->entries = 0;
+  self->hits = 0;
+  self->misses = 0;
+  self->evictions = 0;
+  self->rejections = 0;
 }
 
 
@@ -614,8 +784,10 @@ static void bdd_enc_cache_deinit(BddEncCache_ptr self)
   st_foreach(self->vars_hash, &hash_free_add, (char*) self->dd);
   free_assoc(self->vars_hash);  
 
-  st_foreach(self->eval_hash, &hash_free_add_array, (char*) self->dd);
+  bdd_enc_cache_free_evaluations(self);
   free_assoc(self->eval_hash);  
+
+  free_assoc(self->miss_hash);
 }
 
 
@@ -647,7 +819,8 @@ hash_free_add(char* key, char* data, char* arg)
   adds]
 
   Description        [Called when pushing the status, and during
-  deinitialization]
+  deinitialization. The kind of nodes that must be removed here is 
+  CONS(integer, add). Of course it is the add that must be freed.]
 
   SideEffects        []
 
@@ -655,38 +828,163 @@ hash_free_add(char* key, char* data, char* arg)
 
 ******************************************************************************/
 static assoc_retval 
-hash_free_add_array(char* key, char* data, char* arg) 
+hash_free_add_counted(char* key, char* data, char* arg) 
 {
-  if ((data != (char*) NULL) && (ADD_ARRAY(data) != BDD_ENC_EVALUATING)) {
-    AddArray_destroy((DdManager*) arg, ADD_ARRAY(data));
+  node_ptr cons = (node_ptr) data;
+  if ((cons != (node_ptr)NULL)) {
+    nusmv_assert(node_get_type(cons) == CONS);
+    add_free((DdManager*) arg, (add_ptr) cdr(cons));
+    free_node(cons);
   }
+
   return ASSOC_DELETE;
 }
 
 
 /**Function********************************************************************
 
-  Synopsis           [Private micro function used when destroying caches of
-  adds]
+  Synopsis           [Removes the given entry from the LRU list]
 
-  Description        [Called when pushing the status, and during
-  deinitialization. The kind of nodes that must be removed here is 
-  CONS(integer, add). Of course it is the add that must be freed.]
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            [bdd_enc_cache_push_entry]
+
+******************************************************************************/
+static void bdd_enc_cache_unlink_entry(BddEncCache_ptr self,
+                                       BddEncCacheEntry_ptr entry)
+{
+  if (entry->prev != (BddEncCacheEntry_ptr) NULL) {
+    entry->prev->next = entry->next;
+  }
+  else self->eval_first = entry->next;
+
+  if (entry->next != (BddEncCacheEntry_ptr) NULL) {
+    entry->next->prev = entry->prev;
+  }
+  else self->eval_last = entry->prev;
+
+  self->eval_nodes -= entry->size;
+  self->entries -= 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Inserts the given entry as the most recently used
+  one]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            [bdd_enc_cache_unlink_entry]
+
+******************************************************************************/
+static void bdd_enc_cache_push_entry(BddEncCache_ptr self,
+                                     BddEncCacheEntry_ptr entry)
+{
+  entry->prev = (BddEncCacheEntry_ptr) NULL;
+  entry->next = self->eval_first;
+
+  if (self->eval_first != (BddEncCacheEntry_ptr) NULL) {
+    self->eval_first->prev = entry;
+  }
+  else self->eval_last = entry;
+
+  self->eval_first = entry;
+  self->eval_nodes += entry->size;
+  self->entries += 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Frees an (already unlinked) entry and its ADDs]
+
+  Description        []
 
   SideEffects        []
 
   SeeAlso            []
 
 ******************************************************************************/
-static assoc_retval 
-hash_free_add_counted(char* key, char* data, char* arg) 
+static void bdd_enc_cache_free_entry(BddEncCache_ptr self,
+                                     BddEncCacheEntry_ptr entry)
 {
-  node_ptr cons = (node_ptr) data;
-  if ((cons != (node_ptr)NULL)) {
-    nusmv_assert(node_get_type(cons) == CONS);
-    add_free((DdManager*) arg, (add_ptr) cdr(cons));
-    free_node(cons);
+  AddArray_destroy(self->dd, entry->add_array);
+  FREE(entry);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Frees all the evaluated expressions]
+
+  Description        [Both the LRU list and the evaluation hash are
+  emptied]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void bdd_enc_cache_free_evaluations(BddEncCache_ptr self)
+{
+  BddEncCacheEntry_ptr entry = self->eval_first;
+
+  while (entry != (BddEncCacheEntry_ptr) NULL) {
+    BddEncCacheEntry_ptr next = entry->next;
+    bdd_enc_cache_free_entry(self, entry);
+    entry = next;
   }
 
-  return ASSOC_DELETE;
+  self->eval_first = (BddEncCacheEntry_ptr) NULL;
+  self->eval_last = (BddEncCacheEntry_ptr) NULL;
+  self->eval_nodes = 0;
+  self->eval_sized = true;
+  self->entries = 0;
+
+  clear_assoc(self->eval_hash);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Evicts the least recently used entries, until the
+  number of ADD nodes held by the cache is within the given budget]
+
+  Description        [The most recently used entry is never evicted. If
+  entries were inserted when no budget was set, their size is computed
+  here first.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void bdd_enc_cache_evict(BddEncCache_ptr self, size_t budget)
+{
+  if (!self->eval_sized) {
+    BddEncCacheEntry_ptr entry;
+
+    for (entry = self->eval_first; entry != (BddEncCacheEntry_ptr) NULL;
+         entry = entry->next) {
+      if (0 == entry->size) {
+        entry->size = AddArray_get_add_size(entry->add_array, self->dd);
+        self->eval_nodes += entry->size;
+      }
+    }
+    self->eval_sized = true;
+  }
+
+  while (self->eval_nodes > budget && self->eval_last != self->eval_first) {
+    BddEncCacheEntry_ptr victim = self->eval_last;
+
+    bdd_enc_cache_unlink_entry(self, victim);
+    remove_assoc(self->eval_hash, victim->expr);
+    bdd_enc_cache_free_entry(self, victim);
+    self->evictions += 1;
+  }
 }
@@ -118,4 +118,6 @@ EXTERN void BddEncCache_clean_evaluation_about ARGS((BddEncCache_ptr self,
                                                      NodeList_ptr symbs));
 EXTERN void BddEncCache_clean_evaluation ARGS((BddEncCache_ptr self));
 
+EXTERN void BddEncCache_print_stats ARGS((BddEncCache_ptr self, FILE* file));
+
 #endif /* __BDD_ENC_CACHE_H__ */
@@ -106,6 +106,10 @@ typedef struct be_enc_shift_memoize_key_TAG
 #define BE_ENC_NO_TIME                 BE_ENC_NEXT_UNTIMED_TIME-2
 #define BE_ENC_INVALID_TIME            BE_ENC_NEXT_UNTIMED_TIME-3
 
+/* The number of entries of the young generation of the shifting
+   memoizing cache. At most twice as many entries are kept. */
+#define BE_ENC_SHIFT_HASH_MAX_SIZE     (1 << 16)
+
 
 /**AutomaticStart*************************************************************/
 
@@ -175,6 +179,23 @@ be_enc_shift_exp_at_times ARGS((BeEnc_ptr self, const be_ptr exp,
 
 static void be_enc_clean_shift_hash ARGS((BeEnc_ptr self));
 
+static boolean
+be_enc_shift_hash_lookup ARGS((BeEnc_ptr self,
+                               be_enc_shift_memoize_key* key,
+                               be_ptr* result));
+
+static void
+be_enc_shift_hash_insert ARGS((BeEnc_ptr self,
+                               const be_enc_shift_memoize_key* key,
+                               be_ptr result));
+
+static Be_ShiftTemplate_ptr
+be_enc_get_shift_template ARGS((BeEnc_ptr self, const be_ptr exp));
+
+static enum st_retval
+be_enc_shift_templates_callback_del_entry ARGS((char* key, char* record,
+                                                char* dummy));
+
 static int be_enc_shift_hash_key_cmp ARGS((const char* _key1,
                                            const char* _key2));
 
@@ -1392,6 +1413,64 @@ be_ptr BeEnc_untimed_expr_to_times(BeEnc_ptr self, const be_ptr exp,
 }
 
 
+/**Function********************************************************************
+
+Synopsis           [Given an expression over variables at the given
+time, returns the corresponding untimed expression]
+
+Description        [This is the inverse of BeEnc_untimed_expr_to_timed:
+state and input variables at the given time are mapped to the
+corresponding untimed current state and input variables, while frozen
+variables are kept. The expression must not contain variables at
+other times, or next state variables.
+
+The result is not memoized, as this is meant to read back formulae
+built at the timed level, like interpolants.]
+
+SideEffects        []
+
+SeeAlso            [BeEnc_untimed_expr_to_timed]
+
+******************************************************************************/
+be_ptr BeEnc_timed_expr_to_untimed(BeEnc_ptr self, const be_ptr exp,
+                                   const int time)
+{
+  int untimed_size, timed_size, log_size;
+  int* subst;
+  int idx;
+  be_ptr res;
+
+  BE_ENC_CHECK_INSTANCE(self);
+  nusmv_assert(time >= 0 && time <= self->max_allocated_time);
+
+  if (Be_IsConstant(self->be_mgr, exp)) return exp;
+
+  untimed_size = be_enc_get_untimed_block_size(self);
+  timed_size = be_enc_get_timed_block_size(self);
+  log_size = untimed_size + timed_size * (self->max_allocated_time + 1);
+
+  subst = ALLOC(int, log_size);
+  nusmv_assert((int*) NULL != subst);
+
+  for (idx = 0; idx < log_size; ++idx) {
+    if (be_enc_is_log_index_untimed_curr_state_frozen_input(self, idx)) {
+      subst[idx] = idx;
+    }
+    else if (be_enc_is_log_index_timed(self, idx) &&
+             be_enc_index_log_to_time(self, idx) == time) {
+      subst[idx] = be_enc_index_log_timed_to_untimed(self, idx);
+    }
+    else subst[idx] = BE_INVALID_SUBST_VALUE;
+  }
+
+  res = Be_LogicalVarSubst(self->be_mgr, exp, subst,
+                           self->log2phy, self->phy2log);
+  FREE(subst);
+
+  return res;
+}
+
+
 /**Function********************************************************************
 
 Synopsis           [<b>Makes an AND interval</b> of given expression using
@@ -1520,6 +1599,12 @@ void be_enc_init(BeEnc_ptr self,
   self->shift_hash =
     st_init_table(&be_enc_shift_hash_key_cmp, &be_enc_shift_hash_key_hash);
   nusmv_assert(self->shift_hash != (st_table*) NULL);
+  self->shift_hash_old =
+    st_init_table(&be_enc_shift_hash_key_cmp, &be_enc_shift_hash_key_hash);
+  nusmv_assert(self->shift_hash_old != (st_table*) NULL);
+
+  self->shift_templates = st_init_table(st_ptrcmp, st_ptrhash);
+  nusmv_assert(self->shift_templates != (st_table*) NULL);
 
   /* virtual methods settings */
   OVERRIDE(Object, finalize) = be_enc_finalize;
@@ -1546,6 +1631,8 @@ void be_enc_deinit(BeEnc_ptr self)
   /* members deinitialization */
   be_enc_clean_shift_hash(self);
   st_free_table(self->shift_hash);
+  st_free_table(self->shift_hash_old);
+  st_free_table(self->shift_templates);
 
   if (self->subst_array != (int*) NULL) FREE(self->subst_array);
   if (self->phy2log != (int*) NULL) FREE(self->phy2log);
@@ -2738,26 +2825,16 @@ be_enc_shift_exp_at_time(BeEnc_ptr self, const be_ptr exp, int time)
   key.i_time = time;
   key.n_time = time+1; /* next is to be brought to further step */
 
-  if ( !st_lookup(self->shift_hash, (char*) &key, (char**) &result) ) {
-    /* Duplicates the key. This ALLOC will be undone by the BeEnc destroyer */
-    int delta;
-    be_enc_shift_memoize_key* key_copy = ALLOC(be_enc_shift_memoize_key, 1);
-    nusmv_assert(key_copy != (be_enc_shift_memoize_key*) NULL);
-
-    key_copy->be = key.be;
-    key_copy->c_time = key.c_time;
-    key_copy->f_time = key.f_time;
-    key_copy->i_time = key.i_time;
-    key_copy->n_time = key.n_time;
-
+  if (!be_enc_shift_hash_lookup(self, &key, &result)) {
     if (!Be_IsConstant(self->be_mgr, exp)) {
-      delta = be_enc_index_log_untimed_to_timed(self, 0, time);
-      result =  Be_LogicalShiftVar(self->be_mgr, exp, delta,
-                                   self->log2phy, self->phy2log);
+      int delta = be_enc_index_log_untimed_to_timed(self, 0, time);
+      result = Be_ShiftTemplate_Shift(self->be_mgr,
+                                      be_enc_get_shift_template(self, exp),
+                                      delta, self->log2phy);
     }
     else result = exp;
 
-    st_insert(self->shift_hash, (char*) key_copy, (char*) result );
+    be_enc_shift_hash_insert(self, &key, result);
   }
 
   return result;
@@ -2806,17 +2883,7 @@ be_enc_shift_exp_at_times(BeEnc_ptr self, const be_ptr exp,
   key.i_time = i_time;
   key.n_time = n_time;
 
-  if ( !st_lookup(self->shift_hash, (char*) &key, (char**) &result) ) {
-    /* Duplicates the key. This ALLOC will be undone by the BeEnc destroyer */
-    be_enc_shift_memoize_key* key_copy = ALLOC(be_enc_shift_memoize_key, 1);
-    nusmv_assert(key_copy != (be_enc_shift_memoize_key*) NULL);
-
-    key_copy->be = key.be;
-    key_copy->c_time = key.c_time;
-    key_copy->f_time = key.f_time;
-    key_copy->i_time = key.i_time;
-    key_copy->n_time = key.n_time;
-
+  if (!be_enc_shift_hash_lookup(self, &key, &result)) {
     /* lazy evaluation */
     if (Be_IsConstant(self->be_mgr, exp)) result = exp;
     else {
@@ -2912,12 +2979,13 @@ be_enc_shift_exp_at_times(BeEnc_ptr self, const be_ptr exp,
       }
 
       /* performs the substitution */
-      result = Be_LogicalVarSubst(self->be_mgr, exp, self->subst_array,
-                                  self->log2phy, self->phy2log);
+      result = Be_ShiftTemplate_Subst(self->be_mgr,
+                                      be_enc_get_shift_template(self, exp),
+                                      self->subst_array, self->log2phy);
     } /* if */
 
     /* memoize */
-    st_insert(self->shift_hash, (char*) key_copy, (char*) result );
+    be_enc_shift_hash_insert(self, &key, result);
   }
 
   return result;
@@ -2946,6 +3014,111 @@ static void be_enc_clean_shift_hash(BeEnc_ptr self)
 
   st_foreach(self->shift_hash, &be_enc_shift_hash_callback_del_entry_and_key,
              NULL /*unused*/);
+  st_foreach(self->shift_hash_old,
+             &be_enc_shift_hash_callback_del_entry_and_key, NULL /*unused*/);
+
+  /* templates refer to the logical level, which may have changed */
+  st_foreach(self->shift_templates,
+             &be_enc_shift_templates_callback_del_entry, NULL /*unused*/);
+}
+
+
+/**Function********************************************************************
+
+Synopsis           [Searches the shifting cache]
+
+Description        [Both generations are searched. An entry found in
+the old generation is moved to the young one, so that the entries in
+use survive the next generation change.]
+
+SideEffects        [result is set if the entry is found]
+
+SeeAlso            [be_enc_shift_hash_insert]
+
+******************************************************************************/
+static boolean be_enc_shift_hash_lookup(BeEnc_ptr self,
+                                        be_enc_shift_memoize_key* key,
+                                        be_ptr* result)
+{
+  char* key_copy = (char*) key;
+
+  if (st_lookup(self->shift_hash, (char*) key, (char**) result)) return true;
+
+  if (st_delete(self->shift_hash_old, &key_copy, (char**) result)) {
+    st_insert(self->shift_hash, key_copy, (char*) *result);
+    return true;
+  }
+
+  return false;
+}
+
+
+/**Function********************************************************************
+
+Synopsis           [Adds an entry to the shifting cache]
+
+Description        [The entry is added to the young generation. When
+this has BE_ENC_SHIFT_HASH_MAX_SIZE entries, the old generation is
+dropped and the young one becomes the old one.]
+
+SideEffects        []
+
+SeeAlso            [be_enc_shift_hash_lookup]
+
+******************************************************************************/
+static void be_enc_shift_hash_insert(BeEnc_ptr self,
+                                     const be_enc_shift_memoize_key* key,
+                                     be_ptr result)
+{
+  /* Duplicates the key. This ALLOC will be undone by the BeEnc destroyer */
+  be_enc_shift_memoize_key* key_copy = ALLOC(be_enc_shift_memoize_key, 1);
+  nusmv_assert(key_copy != (be_enc_shift_memoize_key*) NULL);
+
+  *key_copy = *key;
+
+  if (st_count(self->shift_hash) >= BE_ENC_SHIFT_HASH_MAX_SIZE) {
+    st_table* old = self->shift_hash_old;
+
+    if (opt_verbose_level_gt(OptsHandler_get_instance(), 4)) {
+      fprintf(nusmv_stderr,
+              "BeEnc: Dropping %d entries of the shifting memoizing cache.\n",
+              st_count(old));
+    }
+
+    st_foreach(old, &be_enc_shift_hash_callback_del_entry_and_key,
+               NULL /*unused*/);
+    self->shift_hash_old = self->shift_hash;
+    self->shift_hash = old;
+  }
+
+  st_insert(self->shift_hash, (char*) key_copy, (char*) result);
+}
+
+
+/**Function********************************************************************
+
+Synopsis           [Returns the shifting template of the given untimed
+expression]
+
+Description        [The template is created the first time the
+expression is shifted, and is kept until the logical level changes]
+
+SideEffects        []
+
+SeeAlso            [Be_ShiftTemplate_Create]
+
+******************************************************************************/
+static Be_ShiftTemplate_ptr be_enc_get_shift_template(BeEnc_ptr self,
+                                                      const be_ptr exp)
+{
+  Be_ShiftTemplate_ptr tmpl;
+
+  if (!st_lookup(self->shift_templates, (char*) exp, (char**) &tmpl)) {
+    tmpl = Be_ShiftTemplate_Create(self->be_mgr, exp, self->phy2log);
+    st_insert(self->shift_templates, (char*) exp, (char*) tmpl);
+  }
+
+  return tmpl;
 }
 
 
@@ -2981,4 +3154,11 @@ be_enc_shift_hash_callback_del_entry_and_key(char* key, char* record, char* dumm
   return ST_DELETE; /* removes associated element */
 }
 
+static enum st_retval
+be_enc_shift_templates_callback_del_entry(char* key, char* record, char* dummy)
+{
+  Be_ShiftTemplate_Delete((Be_ShiftTemplate_ptr) record);
+  return ST_DELETE; /* removes associated element */
+}
+
 /**AutomaticEnd***************************************************************/
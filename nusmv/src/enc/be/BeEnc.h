@@ -216,6 +216,10 @@ BeEnc_untimed_expr_to_times ARGS((BeEnc_ptr self, const be_ptr exp,
                                   const int itime, 
                                   const int ntime));
 
+EXTERN be_ptr 
+BeEnc_timed_expr_to_untimed ARGS((BeEnc_ptr self, const be_ptr exp, 
+                                  const int time));
+
 EXTERN be_ptr 
 BeEnc_untimed_to_timed_and_interval ARGS((BeEnc_ptr self, 
                                           const be_ptr exp, 
@@ -316,7 +316,15 @@ typedef struct BeEnc_TAG
   int* subst_array; /* Used by substitution operations */
   int subst_array_size; 
 
-  st_table* shift_hash; /* used to memoize shifting operations */
+  /* used to memoize shifting operations: when shift_hash gets full
+     it becomes shift_hash_old, and the previous shift_hash_old is
+     dropped. Entries found in shift_hash_old are moved back to
+     shift_hash. */
+  st_table* shift_hash;
+  st_table* shift_hash_old;
+
+  /* untimed expression to its shifting template */
+  st_table* shift_templates;
 
   /* -------------------------------------------------- */
   /*                  Virtual methods                   */
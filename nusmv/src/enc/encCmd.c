@@ -59,6 +59,9 @@ static char rcsid[] UTIL_UNUSED = "$Id nusmv Exp$";
 static int CommandCleanSexp2BDDCache ARGS((int argc, char **argv));
 static int UsageCleanSexp2BDDCache ARGS((void));
 
+static int CommandPrintSexp2BDDCacheStats ARGS((int argc, char** argv));
+static int UsagePrintSexp2BDDCacheStats ARGS((void));
+
 static int CommandPrintFormula ARGS((int argc, char** argv));
 static int UsagePrintFormula ARGS((void));
 
@@ -73,6 +76,8 @@ static int UsageDumpExpr ARGS((void));
 void enc_add_commands()
 {
   Cmd_CommandAdd("clean_sexp2bdd_cache", CommandCleanSexp2BDDCache, 0, true);
+  Cmd_CommandAdd("print_sexp2bdd_cache_stats",
+                 CommandPrintSexp2BDDCacheStats, 0, true);
   Cmd_CommandAdd("print_formula", CommandPrintFormula, 0, true);
   Cmd_CommandAdd("dump_expr", CommandDumpExpr, 0, true);
 }
@@ -97,6 +102,11 @@ void enc_add_commands()
   evaluations are normally cached (see additionally NuSMV option
   enable_sexp2bdd_caching). This allows to save time by avoid the
   construction of BDD for the same expression several time.
+
+  The amount of ADD nodes kept by the cache can be bounded with the
+  option sexp2bdd_cache_size: least recently used results are freed
+  when the budget is exceeded. Setting sexp2bdd_cache_shared_only
+  keeps only results of expressions which are evaluated more than once.
   
   In some situations it  may be preferable to clean the cache and
   free collected ADD and BDD. This operation can be done, for example,
@@ -158,6 +168,70 @@ static int UsageCleanSexp2BDDCache(void)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis           [Prints statistics of the BDD evaluation cache]
+
+  CommandName        [print_sexp2bdd_cache_stats]
+
+  CommandSynopsis    [Prints statistics about the cache used during
+  evaluation of expressions to ADD and BDD representations.]  
+
+  CommandArguments   [\[-h\] ]  
+
+  CommandDescription [Prints the number of entries of the cache of
+  the exp-to-bdd evaluator (see command clean_sexp2bdd_cache), the
+  number of ADD nodes they hold when a budget is set by the option
+  sexp2bdd_cache_size, and the number of hits, misses, evictions and
+  rejected entries since the encoding has been created.]
+
+  SideEffects        []
+
+******************************************************************************/
+static int CommandPrintSexp2BDDCacheStats(int argc, char **argv)
+{
+  BddEnc_ptr enc;
+  int c;
+  extern cmp_struct_ptr cmps;
+
+  /* Parse the options. */
+  util_getopt_reset();
+  while ((c = util_getopt(argc, argv, "h")) != EOF) {
+    switch (c) {
+    case 'h': return(UsagePrintSexp2BDDCacheStats());
+    default:
+      return(UsagePrintSexp2BDDCacheStats());
+    }
+  }
+
+  if (argc != util_optind) return(UsagePrintSexp2BDDCacheStats());
+
+  /* pre-conditions: */
+  if (!cmp_struct_get_encode_variables(cmps)) {
+    fprintf(nusmv_stderr, "ERROR: BDD encoding has to be created before. "
+            "Use \"encode_variables\" command.\n\n");
+    return UsagePrintSexp2BDDCacheStats();
+  }
+
+  enc = Enc_get_bdd_encoding();
+  nusmv_assert(enc != NULL);
+
+  BddEnc_print_evaluation_cache_stats(enc, nusmv_stdout);
+
+  return 0;
+}
+
+
+static int UsagePrintSexp2BDDCacheStats(void)
+{
+  fprintf(nusmv_stderr, "usage: print_sexp2bdd_cache_stats [-h]\n");
+  fprintf(nusmv_stderr, "   -h \t\tPrints the command usage\n"
+          "The command prints statistics about the cache of BDDs constructed\n"
+          "during evaluation of symbolic expressions into ADD and BDD form\n");
+  return 1;
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Prints a formula in canonical format.]
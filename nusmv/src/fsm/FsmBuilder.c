@@ -83,11 +83,17 @@ typedef struct FsmBuilder_TAG
   hash_ptr bdd_fsm_hash;
   hash_ptr sexp_fsm_hash;
   hash_ptr bool_fsm_hash;
+
+  /* the transition atoms of single variables, shared among the BDD
+     FSMs of the cones of influence. See fsm_builder_get_var_atoms */
+  hash_ptr var_atoms_hash;
+  BddEnc_ptr var_atoms_enc;
 } FsmBuilder;
 
 /* This structure contains all data needed for memoizing BDD FSMs */
 typedef struct BddFsmMemoize_TAG {
   SexpFsm_ptr sexp_fsm;
+  Expr_ptr sexp_fsm_id; /* computed once, when memoizing */
   Set_t vars;
   TransType trans_type;
   BddVarSet_ptr state_cube;
@@ -95,6 +101,23 @@ typedef struct BddFsmMemoize_TAG {
   BddVarSet_ptr next_cube;
 } BddFsmMemoize;
 
+/* This structure contains all data needed for memoizing scalar and
+   boolean Sexp FSMs */
+typedef struct SexpFsmMemoize_TAG {
+  FlatHierarchy_ptr hierarchy;
+  Expr_ptr hierarchy_id; /* computed once, when memoizing */
+  Set_t vars;
+} SexpFsmMemoize;
+
+/* This structure contains the transition atoms of a single variable,
+   along with the constraints and the next assignment they were
+   built from */
+typedef struct VarAtomsMemoize_TAG {
+  node_ptr constrs;
+  node_ptr assign;
+  ClusterList_ptr atoms;
+} VarAtomsMemoize;
+
 /*---------------------------------------------------------------------------*/
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
@@ -124,6 +147,36 @@ static void fsm_builder_init ARGS((FsmBuilder_ptr self, DdManager* dd));
 
 static void fsm_builder_deinit ARGS((FsmBuilder_ptr self));
 
+static BddFsm_ptr
+fsm_builder_create_bdd_fsm_aux ARGS((const FsmBuilder_ptr self,
+                                     const SexpFsm_ptr sexp_fsm,
+                                     const TransType trans_type,
+                                     BddEnc_ptr enc,
+                                     BddVarSet_ptr state_vars_cube,
+                                     BddVarSet_ptr input_vars_cube,
+                                     BddVarSet_ptr next_state_vars_cube,
+                                     FlatHierarchy_ptr cone_hierarchy));
+
+static ClusterList_ptr
+fsm_builder_clusterize_cone ARGS((FsmBuilder_ptr self,
+                                  BddEnc_ptr enc,
+                                  FlatHierarchy_ptr flat_hierarchy,
+                                  const SexpFsm_ptr sexp_fsm));
+
+static ClusterList_ptr
+fsm_builder_get_var_atoms ARGS((FsmBuilder_ptr self,
+                                BddEnc_ptr enc,
+                                FlatHierarchy_ptr flat_hierarchy,
+                                node_ptr var));
+
+static void
+fsm_builder_append_atoms ARGS((FsmBuilder_ptr self,
+                               ClusterList_ptr clusters,
+                               const ClusterList_ptr atoms,
+                               hash_ptr h));
+
+static void fsm_builder_clear_var_atoms ARGS((FsmBuilder_ptr self));
+
 static ClusterList_ptr
 fsm_builder_clusterize_expr ARGS((FsmBuilder_ptr self,
                                   BddEnc_ptr enc, Expr_ptr expr));
@@ -199,6 +252,10 @@ fsm_builder_insert_bool_sexp_fsm ARGS((const FsmBuilder_ptr self,
 static Expr_ptr
 fsm_builder_compute_scalar_fsm_id ARGS((const SexpFsm_ptr sexp));
 
+static SexpFsmMemoize*
+fsm_builder_sexp_fsm_memoize_create ARGS((const FlatHierarchy_ptr fh,
+                                          const Set_t vars));
+
 static Expr_ptr
 fsm_builder_compute_hierarchy_id ARGS((const FlatHierarchy_ptr fh));
 
@@ -412,104 +469,138 @@ BddFsm_ptr FsmBuilder_create_bdd_fsm_of_vars(const FsmBuilder_ptr self,
                                              BddVarSet_ptr input_vars_cube,
                                              BddVarSet_ptr next_state_vars_cube)
 {
-  /* to construct Bdd Fsm: */
-  BddFsm_ptr bddfsm = BDD_FSM(NULL);
-  BddTrans_ptr trans;
-  JusticeList_ptr justice;
-  CompassionList_ptr compassion;
-  bdd_ptr init_bdd, invar_bdd, input_bdd;
-  SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(enc));
-  Set_t vars = SexpFsm_get_vars(sexp_fsm);
+  return fsm_builder_create_bdd_fsm_aux(self, sexp_fsm, trans_type, enc,
+                                        state_vars_cube, input_vars_cube,
+                                        next_state_vars_cube,
+                                        FLAT_HIERARCHY(NULL));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Creates the BddFsm of a cone of influence]
+
+  Description        [It is the same as FsmBuilder_create_bdd_fsm, but
+  the given sexp_fsm must have been built by
+  FsmBuilder_create_scalar_sexp_fsm out of the given flat_hierarchy
+  and a set of variables, typically a cone of influence.
+
+  The transition relation is not encoded from the expressions of
+  sexp_fsm. Instead, it is assembled out of the transition atoms of
+  every single variable, which are encoded and memoized within self
+  the first time a cone containing the variable is built. The BDD
+  FSMs of cones which share most of their variables are this way
+  views over the same set of atoms, and so are the supports of the
+  atoms, that are then propagated through the clusters and reused
+  when building the quantification schedules. The resulting
+  transition relation is the same that FsmBuilder_create_bdd_fsm
+  would build.
+
+  When symbols inlining is enabled the trans of sexp_fsm is not the
+  conjunction of the trans of its variables, and this falls back to
+  FsmBuilder_create_bdd_fsm.]
+
+  SideEffects        [The atoms of the variables of the cone are
+  memoized within self]
+
+  SeeAlso            [FsmBuilder_create_bdd_fsm]
+
+******************************************************************************/
+BddFsm_ptr FsmBuilder_create_bdd_fsm_of_cone(const FsmBuilder_ptr self,
+                                             BddEnc_ptr enc,
+                                             FlatHierarchy_ptr flat_hierarchy,
+                                             const SexpFsm_ptr sexp_fsm,
+                                             const TransType trans_type)
+{
+  BddFsm_ptr bddfsm;
+  BddVarSet_ptr state_vars_cube, input_vars_cube, next_state_vars_cube;
+  FlatHierarchy_ptr cone_hierarchy = flat_hierarchy;
 
   FSM_BUILDER_CHECK_INSTANCE(self);
+  FLAT_HIERARCHY_CHECK_INSTANCE(flat_hierarchy);
 
-  if (fsm_builder_set_contains_infinite_variables(st, vars)) {
-    rpterr("Impossible to build a BDD FSM"
-           " with infinite precision variables");
+  if (opt_symb_inlining(OptsHandler_get_instance())) {
+    cone_hierarchy = FLAT_HIERARCHY(NULL);
   }
 
-  bddfsm = fsm_builder_lookup_bdd_fsm(self, sexp_fsm, vars, trans_type,
-                                      state_vars_cube, input_vars_cube,
-                                      next_state_vars_cube);
-  if (BDD_FSM(NULL) != bddfsm) {
-    return bddfsm;
-  }
+  state_vars_cube = BddEnc_get_state_vars_cube(enc);
+  input_vars_cube = BddEnc_get_input_vars_cube(enc);
+  next_state_vars_cube = BddEnc_get_next_state_vars_cube(enc);
 
+  bddfsm = fsm_builder_create_bdd_fsm_aux(self, sexp_fsm, trans_type, enc,
+                                          state_vars_cube, input_vars_cube,
+                                          next_state_vars_cube,
+                                          cone_hierarchy);
 
-  /* ---------------------------------------------------------------------- */
-  /* Trans construction                                                     */
-  /* ---------------------------------------------------------------------- */
-  { /* here the trans is constructed out of the vars fsm, to make
-       it ordered wrt the obtained ordered vars set */
-    ClusterList_ptr clusters;
-    ClusterOptions_ptr cluster_options;
-    Set_t sorted_vars;
-    Expr_ptr trans_expr;
-    Set_Iterator_t iter;
-
-    sorted_vars = fsm_builder_order_vars_list(self, enc,
-                                              SexpFsm_get_vars_list(sexp_fsm));
-
-    trans_expr = SexpFsm_get_trans(sexp_fsm);
-    SET_FOREACH(sorted_vars, iter) {
-      Expr_ptr vtrans = SexpFsm_get_var_trans(sexp_fsm,
-                           (node_ptr) Set_GetMember(sorted_vars, iter));
-      trans_expr = Expr_and_nil(trans_expr, vtrans);
-    }
+  bdd_free(self->dd, (bdd_ptr) state_vars_cube);
+  bdd_free(self->dd, (bdd_ptr) input_vars_cube);
+  bdd_free(self->dd, (bdd_ptr) next_state_vars_cube);
 
-    Set_ReleaseSet(sorted_vars); /* no longer needed */
+  return bddfsm;
+}
 
-    /* clusters construction */
-    clusters = fsm_builder_clusterize_expr(self, enc, trans_expr);
-    cluster_options = ClusterOptions_create(OptsHandler_get_instance());
 
-    trans = BddTrans_create(self->dd,
-                            clusters,
-                            (bdd_ptr) state_vars_cube,
-                            (bdd_ptr) input_vars_cube,
-                            (bdd_ptr) next_state_vars_cube,
-                            trans_type,
-                            cluster_options);
+/**Function********************************************************************
 
-    ClusterList_destroy(clusters);
-    ClusterOptions_destroy(cluster_options); /* this is no longer needed */
-  }
+  Synopsis           [Returns the size of the transition relation of
+  the given set of variables]
 
+  Description        [The size is the sum of the sizes of the distinct
+  atoms the transition relation of vars is made of, and estimates
+  how hard it is to work on the cone of influence made of vars. The
+  atoms are the ones FsmBuilder_create_bdd_fsm_of_cone assembles the
+  BDD FSMs of the cones out of, so the work is not lost when the FSM
+  of the cone is built later.
 
-  /* ---------------------------------------------------------------------- */
-  /* Bdd Fsm construction                                                   */
-  /* ---------------------------------------------------------------------- */
-  justice = fsm_builder_justice_sexp_to_bdd(self, enc,
-                                            SexpFsm_get_justice(sexp_fsm));
+  Constraints which are not attributed to any variable are not
+  taken into account.]
 
-  compassion = fsm_builder_compassion_sexp_to_bdd(self, enc,
-                                        SexpFsm_get_compassion(sexp_fsm));
+  SideEffects        [The atoms of the variables are memoized within
+  self]
 
-  /* init */
-  init_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_init(sexp_fsm), Nil);
-  /* invar */
-  invar_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_invar(sexp_fsm), Nil);
-  /* input */
-  input_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_input(sexp_fsm), Nil);
+  SeeAlso            [FsmBuilder_create_bdd_fsm_of_cone]
 
-  bddfsm = BddFsm_create(enc,
-                         BDD_STATES(init_bdd),
-                         BDD_INVAR_STATES(invar_bdd),
-                         BDD_INVAR_INPUTS(input_bdd),
-                         trans,
-                         justice, compassion);
+******************************************************************************/
+int FsmBuilder_get_trans_size_of_vars(const FsmBuilder_ptr self,
+                                      BddEnc_ptr enc,
+                                      FlatHierarchy_ptr flat_hierarchy,
+                                      const Set_t vars)
+{
+  Set_Iterator_t iter;
+  hash_ptr h;
+  int res = 0;
 
-  bdd_free(self->dd, input_bdd);
-  bdd_free(self->dd, invar_bdd);
-  bdd_free(self->dd, init_bdd);
+  FSM_BUILDER_CHECK_INSTANCE(self);
+  FLAT_HIERARCHY_CHECK_INSTANCE(flat_hierarchy);
 
-  fsm_builder_insert_bdd_fsm(self, sexp_fsm,
-                             SexpFsm_get_vars(sexp_fsm),
-                             trans_type,
-                             state_vars_cube, input_vars_cube,
-                             next_state_vars_cube, bddfsm);
+  /* atoms shared among variables are counted once */
+  h = new_assoc();
 
-  return bddfsm;
+  SET_FOREACH(vars, iter) {
+    ClusterList_ptr atoms =
+      fsm_builder_get_var_atoms(self, enc, flat_hierarchy,
+                                Set_GetMember(vars, iter));
+    ClusterListIterator_ptr aiter = ClusterList_begin(atoms);
+
+    while (!ClusterListIterator_is_end(aiter)) {
+      Cluster_ptr atom = ClusterList_get_cluster(atoms, aiter);
+      bdd_ptr tmp = Cluster_get_trans(atom);
+
+      /* atoms are kept alive by the memoization, so h needs no
+         reference */
+      if (!bdd_is_true(self->dd, tmp) &&
+          (Nil == find_assoc(h, (node_ptr) tmp))) {
+        insert_assoc(h, (node_ptr) tmp, PTR_FROM_INT(node_ptr, 1));
+        res += bdd_size(self->dd, tmp);
+      }
+
+      bdd_free(self->dd, tmp);
+      aiter = ClusterListIterator_next(aiter);
+    }
+  }
+
+  free_assoc(h);
+  return res;
 }
 
 
@@ -562,6 +653,8 @@ static void fsm_builder_init(FsmBuilder_ptr self, DdManager* dd)
   self->bdd_fsm_hash = new_assoc();
   self->sexp_fsm_hash = new_assoc();
   self->bool_fsm_hash = new_assoc();
+  self->var_atoms_hash = new_assoc();
+  self->var_atoms_enc = BDD_ENC(NULL);
 }
 
 
@@ -598,35 +691,174 @@ static void fsm_builder_deinit(FsmBuilder_ptr self)
 
   /* Clear the Sexp Fsm cache */
   {
-    node_ptr tmp;
+    SexpFsmMemoize* mem;
     SexpFsm_ptr sexp;
 
-    ASSOC_FOREACH(self->sexp_fsm_hash, aiter, &tmp, &sexp) {
-      Set_ReleaseSet((Set_t)cdr(tmp));
-      FlatHierarchy_destroy(FLAT_HIERARCHY(car(tmp)));
+    ASSOC_FOREACH(self->sexp_fsm_hash, aiter, &mem, &sexp) {
+      Set_ReleaseSet(mem->vars);
+      FlatHierarchy_destroy(mem->hierarchy);
       SexpFsm_destroy(sexp);
-      free_node(tmp);
+      FREE(mem);
     }
   }
 
   /* Clear the Boolean Sexp Fsm cache */
   {
-    node_ptr tmp;
+    SexpFsmMemoize* mem;
     BoolSexpFsm_ptr se;
-    ASSOC_FOREACH(self->bool_fsm_hash, aiter, &tmp, &se) {
-      Set_ReleaseSet((Set_t)cdr(tmp));
-      FlatHierarchy_destroy(FLAT_HIERARCHY(car(tmp)));
+    ASSOC_FOREACH(self->bool_fsm_hash, aiter, &mem, &se) {
+      Set_ReleaseSet(mem->vars);
+      FlatHierarchy_destroy(mem->hierarchy);
       BoolSexpFsm_destroy(se);
-      free_node(tmp);
+      FREE(mem);
     }
   }
 
+  /* Clear the variables atoms cache */
+  fsm_builder_clear_var_atoms(self);
+  free_assoc(self->var_atoms_hash);
+
   free_assoc(self->bool_fsm_hash);
   free_assoc(self->bdd_fsm_hash);
   free_assoc(self->sexp_fsm_hash);
 }
 
 
+/**Function********************************************************************
+
+  Synopsis           [Creates a BddFsm instance from a given SexpFsm]
+
+  Description        [Implements FsmBuilder_create_bdd_fsm_of_vars and
+  FsmBuilder_create_bdd_fsm_of_cone. If cone_hierarchy is not NULL,
+  sexp_fsm must have been built out of it by
+  FsmBuilder_create_scalar_sexp_fsm, and the transition relation is
+  assembled out of the memoized atoms of the variables.]
+
+  SideEffects        []
+
+******************************************************************************/
+static BddFsm_ptr
+fsm_builder_create_bdd_fsm_aux(const FsmBuilder_ptr self,
+                               const SexpFsm_ptr sexp_fsm,
+                               const TransType trans_type,
+                               BddEnc_ptr enc,
+                               BddVarSet_ptr state_vars_cube,
+                               BddVarSet_ptr input_vars_cube,
+                               BddVarSet_ptr next_state_vars_cube,
+                               FlatHierarchy_ptr cone_hierarchy)
+{
+  /* to construct Bdd Fsm: */
+  BddFsm_ptr bddfsm = BDD_FSM(NULL);
+  BddTrans_ptr trans;
+  JusticeList_ptr justice;
+  CompassionList_ptr compassion;
+  bdd_ptr init_bdd, invar_bdd, input_bdd;
+  SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(enc));
+  Set_t vars = SexpFsm_get_vars(sexp_fsm);
+
+  FSM_BUILDER_CHECK_INSTANCE(self);
+
+  if (fsm_builder_set_contains_infinite_variables(st, vars)) {
+    rpterr("Impossible to build a BDD FSM"
+           " with infinite precision variables");
+  }
+
+  bddfsm = fsm_builder_lookup_bdd_fsm(self, sexp_fsm, vars, trans_type,
+                                      state_vars_cube, input_vars_cube,
+                                      next_state_vars_cube);
+  if (BDD_FSM(NULL) != bddfsm) {
+    return bddfsm;
+  }
+
+
+  /* ---------------------------------------------------------------------- */
+  /* Trans construction                                                     */
+  /* ---------------------------------------------------------------------- */
+  {
+    ClusterList_ptr clusters;
+    ClusterOptions_ptr cluster_options;
+
+    if (FLAT_HIERARCHY(NULL) != cone_hierarchy) {
+      /* the clusters are assembled out of the memoized atoms of the
+         vars of the cone */
+      clusters = fsm_builder_clusterize_cone(self, enc, cone_hierarchy,
+                                             sexp_fsm);
+    }
+    else {
+      /* here the trans is constructed out of the vars fsm, to make
+         it ordered wrt the obtained ordered vars set */
+      Set_t sorted_vars;
+      Expr_ptr trans_expr;
+      Set_Iterator_t iter;
+
+      sorted_vars = fsm_builder_order_vars_list(self, enc,
+                                             SexpFsm_get_vars_list(sexp_fsm));
+
+      trans_expr = SexpFsm_get_trans(sexp_fsm);
+      SET_FOREACH(sorted_vars, iter) {
+        Expr_ptr vtrans = SexpFsm_get_var_trans(sexp_fsm,
+                             (node_ptr) Set_GetMember(sorted_vars, iter));
+        trans_expr = Expr_and_nil(trans_expr, vtrans);
+      }
+
+      Set_ReleaseSet(sorted_vars); /* no longer needed */
+
+      /* clusters construction */
+      clusters = fsm_builder_clusterize_expr(self, enc, trans_expr);
+    }
+
+    cluster_options = ClusterOptions_create(OptsHandler_get_instance());
+
+    trans = BddTrans_create(self->dd,
+                            clusters,
+                            (bdd_ptr) state_vars_cube,
+                            (bdd_ptr) input_vars_cube,
+                            (bdd_ptr) next_state_vars_cube,
+                            trans_type,
+                            cluster_options);
+
+    ClusterList_destroy(clusters);
+    ClusterOptions_destroy(cluster_options); /* this is no longer needed */
+  }
+
+
+  /* ---------------------------------------------------------------------- */
+  /* Bdd Fsm construction                                                   */
+  /* ---------------------------------------------------------------------- */
+  justice = fsm_builder_justice_sexp_to_bdd(self, enc,
+                                            SexpFsm_get_justice(sexp_fsm));
+
+  compassion = fsm_builder_compassion_sexp_to_bdd(self, enc,
+                                        SexpFsm_get_compassion(sexp_fsm));
+
+  /* init */
+  init_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_init(sexp_fsm), Nil);
+  /* invar */
+  invar_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_invar(sexp_fsm), Nil);
+  /* input */
+  input_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_input(sexp_fsm), Nil);
+
+  bddfsm = BddFsm_create(enc,
+                         BDD_STATES(init_bdd),
+                         BDD_INVAR_STATES(invar_bdd),
+                         BDD_INVAR_INPUTS(input_bdd),
+                         trans,
+                         justice, compassion);
+
+  bdd_free(self->dd, input_bdd);
+  bdd_free(self->dd, invar_bdd);
+  bdd_free(self->dd, init_bdd);
+
+  fsm_builder_insert_bdd_fsm(self, sexp_fsm,
+                             SexpFsm_get_vars(sexp_fsm),
+                             trans_type,
+                             state_vars_cube, input_vars_cube,
+                             next_state_vars_cube, bddfsm);
+
+  return bddfsm;
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Converts an expression into a list of clusters.
@@ -809,6 +1041,215 @@ fsm_builder_clusterize_expr_aux(const FsmBuilder_ptr self,
 
 
 
+/**Function********************************************************************
+
+  Synopsis           [Builds the list of clusters of a cone of influence]
+
+  Description        [The returned list contains the atoms of the
+  constant TRANS constraints, followed by the atoms of the variables
+  of sexp_fsm, taken in the order of the variables set of
+  sexp_fsm. Atoms which are true or which occur more than once are
+  dropped, and if no atom is left a single true cluster is
+  returned. This is the same list fsm_builder_clusterize_expr
+  builds out of the trans of sexp_fsm, but the atoms of the
+  variables are not encoded again.
+
+  sexp_fsm must have been built out of flat_hierarchy by
+  FsmBuilder_create_scalar_sexp_fsm. Returned list must be destroyed
+  by the caller.]
+
+  SideEffects        []
+
+  SeeAlso            [fsm_builder_get_var_atoms]
+
+******************************************************************************/
+static ClusterList_ptr fsm_builder_clusterize_cone(FsmBuilder_ptr self,
+                                                   BddEnc_ptr enc,
+                                                   FlatHierarchy_ptr flat_hierarchy,
+                                                   const SexpFsm_ptr sexp_fsm)
+{
+  Set_t vars = SexpFsm_get_vars(sexp_fsm);
+  ClusterList_ptr clusters;
+  Set_Iterator_t iter;
+  node_ptr const_trans;
+  hash_ptr h;
+
+  h = new_assoc();
+  clusters = ClusterList_create(self->dd);
+
+  /* constant constraints are not attributed to any variable, and are
+     not memoized */
+  const_trans = FlatHierarchy_lookup_constant_constrains(flat_hierarchy,
+                                                         TRANS);
+  if (Nil != const_trans) {
+    ClusterList_ptr atoms = fsm_builder_clusterize_expr(self, enc,
+                                                        const_trans);
+    fsm_builder_append_atoms(self, clusters, atoms, h);
+    ClusterList_destroy(atoms);
+  }
+
+  SET_FOREACH(vars, iter) {
+    node_ptr var = Set_GetMember(vars, iter);
+    fsm_builder_append_atoms(self, clusters,
+                    fsm_builder_get_var_atoms(self, enc, flat_hierarchy, var),
+                    h);
+  }
+
+  clear_assoc_and_free_entries_arg(h, hash_bdd_key_free, (char*) self->dd);
+  free_assoc(h);
+
+  if (ClusterList_length(clusters) == 0) {
+    bdd_ptr one = bdd_true(self->dd);
+    Cluster_ptr cluster = Cluster_create(self->dd);
+    Cluster_set_trans(cluster, self->dd, one);
+    ClusterList_append_cluster(clusters, cluster);
+    bdd_free(self->dd, one);
+  }
+
+  return clusters;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Returns the transition atoms of the given variable]
+
+  Description        [The atoms are the clusters
+  fsm_builder_clusterize_expr builds out of the TRANS constraints of
+  the variable and of its next assignment, as they are found in
+  flat_hierarchy. This is the trans SexpFsm associates to the
+  variable, before duplicates among different variables are
+  removed. The atoms are memoized within self along with the
+  constraints and the assignment they were built from, and their
+  supports are computed once here. The memoized atoms are dropped
+  when a different encoding is used.
+
+  Returned list belongs to self.]
+
+  SideEffects        [The atoms are memoized within self]
+
+  SeeAlso            [fsm_builder_clusterize_cone]
+
+******************************************************************************/
+static ClusterList_ptr fsm_builder_get_var_atoms(FsmBuilder_ptr self,
+                                                 BddEnc_ptr enc,
+                                                 FlatHierarchy_ptr flat_hierarchy,
+                                                 node_ptr var)
+{
+  SymbTable_ptr st = FlatHierarchy_get_symb_table(flat_hierarchy);
+  node_ptr var_n = Expr_next(var, st);
+  node_ptr constrs = FlatHierarchy_lookup_constrains(flat_hierarchy, var_n);
+  node_ptr assign = FlatHierarchy_lookup_assign(flat_hierarchy, var_n);
+  VarAtomsMemoize* mem;
+  Expr_ptr trans;
+  ClusterListIterator_ptr iter;
+
+  if (enc != self->var_atoms_enc) {
+    fsm_builder_clear_var_atoms(self);
+    self->var_atoms_enc = enc;
+  }
+
+  mem = (VarAtomsMemoize*) find_assoc(self->var_atoms_hash, var);
+  if ((VarAtomsMemoize*) NULL != mem) {
+    if ((mem->constrs == constrs) && (mem->assign == assign)) {
+      return mem->atoms;
+    }
+    ClusterList_destroy(mem->atoms);
+  }
+  else {
+    mem = ALLOC(VarAtomsMemoize, 1);
+    nusmv_assert((VarAtomsMemoize*) NULL != mem);
+    insert_assoc(self->var_atoms_hash, var, (node_ptr) mem);
+  }
+
+  /* see sexp_fsm_hash_var_fsm_init */
+  trans = Expr_true();
+  if (Nil != constrs) trans = Expr_and(trans, EXPR(constrs));
+  if (Nil != assign) {
+    trans = Expr_and(trans, EXPR(find_node(EQDEF, var_n, assign)));
+  }
+
+  mem->constrs = constrs;
+  mem->assign = assign;
+  mem->atoms = fsm_builder_clusterize_expr(self, enc, trans);
+
+  iter = ClusterList_begin(mem->atoms);
+  while (!ClusterListIterator_is_end(iter)) {
+    Cluster_ptr atom = ClusterList_get_cluster(mem->atoms, iter);
+    bdd_free(self->dd, Cluster_get_support(atom, self->dd));
+    iter = ClusterListIterator_next(iter);
+  }
+
+  return mem->atoms;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Appends copies of the given atoms to clusters]
+
+  Description        [Atoms which are true or whose bdd is already in h
+  are skipped. The bdds of the appended atoms are added to h, which
+  holds a reference to them. The copies share the supports memoized
+  within the atoms.]
+
+  SideEffects        [clusters and h change]
+
+  SeeAlso            [fsm_builder_clusterize_cone]
+
+******************************************************************************/
+static void fsm_builder_append_atoms(FsmBuilder_ptr self,
+                                     ClusterList_ptr clusters,
+                                     const ClusterList_ptr atoms,
+                                     hash_ptr h)
+{
+  ClusterListIterator_ptr iter = ClusterList_begin(atoms);
+
+  while (!ClusterListIterator_is_end(iter)) {
+    Cluster_ptr atom = ClusterList_get_cluster(atoms, iter);
+    bdd_ptr tmp = Cluster_get_trans(atom);
+
+    if (bdd_is_true(self->dd, tmp) || (Nil != find_assoc(h, (node_ptr) tmp))) {
+      bdd_free(self->dd, tmp);
+    }
+    else {
+      ClusterList_append_cluster(clusters,
+                                 CLUSTER(Object_copy(OBJECT(atom))));
+      insert_assoc(h, (node_ptr) tmp, PTR_FROM_INT(node_ptr, 1));
+    }
+
+    iter = ClusterListIterator_next(iter);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Drops all the memoized atoms of variables]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            [fsm_builder_get_var_atoms]
+
+******************************************************************************/
+static void fsm_builder_clear_var_atoms(FsmBuilder_ptr self)
+{
+  assoc_iter aiter;
+  node_ptr var;
+  VarAtomsMemoize* mem;
+
+  ASSOC_FOREACH(self->var_atoms_hash, aiter, &var, &mem) {
+    ClusterList_destroy(mem->atoms);
+    FREE(mem);
+  }
+
+  clear_assoc(self->var_atoms_hash);
+  self->var_atoms_enc = BDD_ENC(NULL);
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Converts a list of expressions into a list of
@@ -1057,16 +1498,12 @@ static SexpFsm_ptr fsm_builder_lookup_sexp_fsm(const FsmBuilder_ptr self,
   node_ptr fh_id = fsm_builder_compute_hierarchy_id(fh);
 
   assoc_iter aiter;
-  node_ptr couple;
+  SexpFsmMemoize* mem;
   boolean _break = false;
 
-  ASSOC_FOREACH(self->sexp_fsm_hash, aiter, &couple, NULL) {
-    FlatHierarchy_ptr scalar = FLAT_HIERARCHY(car(couple));
-    node_ptr scalar_id = fsm_builder_compute_hierarchy_id(scalar);
-    Set_t cone = (Set_t)cdr(couple);
-
-    if ((fh_id == scalar_id) && Set_Equals(cone, vars)) {
-      result = SEXP_FSM(find_assoc(self->sexp_fsm_hash, couple));
+  ASSOC_FOREACH(self->sexp_fsm_hash, aiter, &mem, NULL) {
+    if ((fh_id == mem->hierarchy_id) && Set_Equals(mem->vars, vars)) {
+      result = SEXP_FSM(find_assoc(self->sexp_fsm_hash, NODE_PTR(mem)));
       _break = true;
       break;
     }
@@ -1104,14 +1541,13 @@ static void fsm_builder_insert_sexp_fsm(const FsmBuilder_ptr self,
                                         const Set_t vars,
                                         const SexpFsm_ptr sexp_fsm)
 {
-  node_ptr couple = cons(NODE_PTR(FlatHierarchy_copy(fh)),
-                         NODE_PTR(Set_Copy(vars)));
+  SexpFsmMemoize* mem = fsm_builder_sexp_fsm_memoize_create(fh, vars);
 
   if (opt_verbose_level_ge(OptsHandler_get_instance(), 2)) {
     fprintf(nusmv_stderr, "FsmBuilder: Create scalar fsm -> Caching new FSM\n");
   }
 
-  insert_assoc(self->sexp_fsm_hash, couple,
+  insert_assoc(self->sexp_fsm_hash, NODE_PTR(mem),
                NODE_PTR(SexpFsm_copy(sexp_fsm)));
 }
 
@@ -1136,17 +1572,13 @@ fsm_builder_lookup_bool_sexp_fsm(const FsmBuilder_ptr self,
 {
   BoolSexpFsm_ptr result = BOOL_SEXP_FSM(NULL);
   assoc_iter aiter;
-  node_ptr couple;
+  SexpFsmMemoize* mem;
   node_ptr fh_id = fsm_builder_compute_hierarchy_id(fh);
   boolean _break = false;
 
-  ASSOC_FOREACH(self->bool_fsm_hash, aiter, &couple, NULL) {
-    FlatHierarchy_ptr scalar = FLAT_HIERARCHY(car(couple));
-    node_ptr scalar_id = fsm_builder_compute_hierarchy_id(scalar);
-    Set_t cone = (Set_t)cdr(couple);
-
-    if ((fh_id == scalar_id) && Set_Equals(cone, vars)) {
-      result = BOOL_SEXP_FSM(find_assoc(self->bool_fsm_hash, couple));
+  ASSOC_FOREACH(self->bool_fsm_hash, aiter, &mem, NULL) {
+    if ((fh_id == mem->hierarchy_id) && Set_Equals(mem->vars, vars)) {
+      result = BOOL_SEXP_FSM(find_assoc(self->bool_fsm_hash, NODE_PTR(mem)));
       _break = true;
       break;
     }
@@ -1184,14 +1616,13 @@ static void fsm_builder_insert_bool_sexp_fsm(const FsmBuilder_ptr self,
                                              const Set_t vars,
                                              const BoolSexpFsm_ptr sexp_fsm)
 {
-  node_ptr couple = cons(NODE_PTR(FlatHierarchy_copy(fh)),
-                         NODE_PTR(Set_Copy(vars)));
+  SexpFsmMemoize* mem = fsm_builder_sexp_fsm_memoize_create(fh, vars);
 
   if (opt_verbose_level_ge(OptsHandler_get_instance(), 2)) {
     fprintf(nusmv_stderr, "FsmBuilder: Create boolean fsm -> Caching new FSM\n");
   }
 
-  insert_assoc(self->bool_fsm_hash, couple,
+  insert_assoc(self->bool_fsm_hash, NODE_PTR(mem),
                NODE_PTR(BoolSexpFsm_copy(sexp_fsm)));
 }
 
@@ -1224,10 +1655,7 @@ static BddFsm_ptr fsm_builder_lookup_bdd_fsm(const FsmBuilder_ptr self,
   assoc_iter aiter;
 
   ASSOC_FOREACH(self->bdd_fsm_hash, aiter, &mem, NULL) {
-    node_ptr scalar_fsm_id =
-      fsm_builder_compute_scalar_fsm_id(mem->sexp_fsm);
-
-    if ((sexp_fsm_id == scalar_fsm_id) &&
+    if ((sexp_fsm_id == mem->sexp_fsm_id) &&
         Set_Equals(mem->vars, vars) &&
         (trans_type == mem->trans_type) &&
         (state_vars_cube == mem->state_cube) &&
@@ -1284,6 +1712,7 @@ static void fsm_builder_insert_bdd_fsm(const FsmBuilder_ptr self,
   }
 
   mem->sexp_fsm = SexpFsm_copy(sexp_fsm);
+  mem->sexp_fsm_id = fsm_builder_compute_scalar_fsm_id(sexp_fsm);
   mem->vars = Set_Copy(vars);
   mem->state_cube = bdd_dup(state_cube);
   mem->input_cube = bdd_dup(input_cube);
@@ -1298,6 +1727,34 @@ static void fsm_builder_insert_bdd_fsm(const FsmBuilder_ptr self,
                NODE_PTR(BddFsm_copy(bdd_fsm)));
 }
 
+/**Function********************************************************************
+
+   Synopsis           [Creates an entry for the sexp fsm caches]
+
+   Description        [The entry holds copies of the given hierarchy and
+                       set of variables, and the id of the hierarchy,
+                       which is computed once here instead of at each
+                       lookup]
+
+   SideEffects        []
+
+   SeeAlso            [fsm_builder_compute_hierarchy_id]
+
+******************************************************************************/
+static SexpFsmMemoize*
+fsm_builder_sexp_fsm_memoize_create(const FlatHierarchy_ptr fh,
+                                    const Set_t vars)
+{
+  SexpFsmMemoize* mem = ALLOC(SexpFsmMemoize, 1);
+  nusmv_assert((SexpFsmMemoize*) NULL != mem);
+
+  mem->hierarchy = FlatHierarchy_copy(fh);
+  mem->hierarchy_id = fsm_builder_compute_hierarchy_id(fh);
+  mem->vars = Set_Copy(vars);
+
+  return mem;
+}
+
 /**Function********************************************************************
 
    Synopsis           [Computes the id for the given Flat Hierarchy]
@@ -99,6 +99,19 @@ FsmBuilder_create_bdd_fsm_of_vars ARGS((const FsmBuilder_ptr self,
                                         BddVarSet_ptr input_vars_cube,
                                         BddVarSet_ptr next_state_vars_cube));
 
+EXTERN BddFsm_ptr 
+FsmBuilder_create_bdd_fsm_of_cone ARGS((const FsmBuilder_ptr self, 
+                                        BddEnc_ptr enc, 
+                                        FlatHierarchy_ptr flat_hierarchy,
+                                        const SexpFsm_ptr sexp_fsm, 
+                                        const TransType trans_type));
+
+EXTERN int 
+FsmBuilder_get_trans_size_of_vars ARGS((const FsmBuilder_ptr self, 
+                                        BddEnc_ptr enc, 
+                                        FlatHierarchy_ptr flat_hierarchy,
+                                        const Set_t vars));
+
 EXTERN ClusterList_ptr 
 FsmBuilder_clusterize_expr ARGS((FsmBuilder_ptr self, 
                                  BddEnc_ptr enc, Expr_ptr expr));
@@ -54,6 +54,7 @@
 #include "enc/enc.h"
 #include "utils/utils_io.h"
 #include "utils/error.h"
+#include "utils/Profile.h"
 
 
 static char rcsid[] UTIL_UNUSED = "$Id: BddFsm.c,v 1.1.2.44.4.12.4.29 2010-03-02 08:45:22 nusmv Exp $";
@@ -1819,12 +1820,17 @@ BddStates BddFsm_get_fair_states(BddFsm_ptr self)
   BDD_FSM_CHECK_INSTANCE(self);
 
   if ( CACHE_IS_EQUAL(fair_states, BDD_STATES(NULL)) ) {
-    BddStatesInputs si = BddFsm_get_fair_states_inputs(self);
-    BddStates fs = BddFsm_states_inputs_to_states(self, si);
+    BddStatesInputs si;
+    BddStates fs;
+
+    Profile_begin("fair_states");
+    si = BddFsm_get_fair_states_inputs(self);
+    fs = BddFsm_states_inputs_to_states(self, si);
 
     CACHE_SET_BDD(fair_states, fs);
 
     bdd_free(self->dd, fs);
+    Profile_end("fair_states");
   }
 
   res = CACHE_GET_BDD(fair_states);
@@ -2649,9 +2655,13 @@ static void bdd_fsm_compute_reachable_states(BddFsm_ptr self)
 {
   boolean res;
 
+  Profile_begin("reachable_states");
+
   /* Expand cacked reachable states until fixpoint without time limitations */
   res = BddFsm_expand_cached_reachable_states(self, -1, -1);
 
+  Profile_end("reachable_states");
+
   /* Assert that we completed the reachability analysis */
   nusmv_assert(res);
 }
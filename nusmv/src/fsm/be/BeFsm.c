@@ -42,7 +42,9 @@
 
 #include "bmc/bmcCheck.h"
 #include "bmc/bmcConv.h"
+#include "bmc/bmcUtils.h"
 
+#include "opt/opt.h"
 #include "utils/error.h"
 
 static char rcsid[] UTIL_UNUSED = "$Id: BeFsm.c,v 1.1.2.5.6.5 2009-09-04 09:22:47 nusmv Exp $";
@@ -112,7 +114,11 @@ static void be_fsm_deinit ARGS((BeFsm_ptr self));
   Synopsis           [Class BeFsm constructor]
 
   Description        [Creates a new instance of the BeFsm class, getting 
-  information from an instance of a boolean Fsm_Sexp type.]
+  information from an instance of a boolean Fsm_Sexp type. When the
+  option rbc_rewriting is set, init, invar and the transition relation
+  are rewritten once here, see Be_Rewrite. Then, when the option
+  bmc_sweeping is set, their equivalent sub-formulae are merged, see
+  Bmc_Utils_apply_sweeping.]
 
   SideEffects        []
 
@@ -125,16 +131,34 @@ BeFsm_ptr BeFsm_create_from_sexp_fsm(BeEnc_ptr be_enc,
     BeFsm_ptr self;
     SexpFsm_ptr _bfsm = SEXP_FSM(bfsm);
     node_ptr list_of_valid_fairness;
+    be_ptr init, invar, trans;
 
     nusmv_assert(SexpFsm_is_boolean(_bfsm));
 
     list_of_valid_fairness = 
      Bmc_CheckFairnessListForPropositionalFormulae(SexpFsm_get_justice(_bfsm));
+
+    init = Bmc_Conv_Bexp2Be(be_enc, SexpFsm_get_init(_bfsm));
+    invar = Bmc_Conv_Bexp2Be(be_enc, SexpFsm_get_invar(_bfsm));
+    trans = Bmc_Conv_Bexp2Be(be_enc, SexpFsm_get_trans(_bfsm));
+
+    if (opt_rbc_rewriting(OptsHandler_get_instance())) {
+      Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
+
+      init = Be_Rewrite(be_mgr, init);
+      invar = Be_Rewrite(be_mgr, invar);
+      trans = Be_Rewrite(be_mgr, trans);
+    }
+
+    {
+      be_ptr fs[3];
+
+      fs[0] = init; fs[1] = invar; fs[2] = trans;
+      Bmc_Utils_apply_sweeping(BeEnc_get_be_manager(be_enc), fs, 3);
+      init = fs[0]; invar = fs[1]; trans = fs[2];
+    }
   
-    self = BeFsm_create(be_enc, 
-                 Bmc_Conv_Bexp2Be(be_enc, SexpFsm_get_init(_bfsm)),
-                 Bmc_Conv_Bexp2Be(be_enc, SexpFsm_get_invar(_bfsm)),
-                 Bmc_Conv_Bexp2Be(be_enc, SexpFsm_get_trans(_bfsm)),
+    self = BeFsm_create(be_enc, init, invar, trans,
                  Bmc_Conv_BexpList2BeList(be_enc, list_of_valid_fairness));
   
   free_list(list_of_valid_fairness);
@@ -75,9 +75,7 @@
 ******************************************************************************/
 void Fsm_init()
 {
-#ifdef SYMB_TABLE_STATIC
   fsm_sexp_expr_init();
-#endif
 }
 
 
@@ -92,9 +90,7 @@ void Fsm_init()
 ******************************************************************************/
 void Fsm_quit()
 {
-#ifdef SYMB_TABLE_STATIC
   fsm_sexp_expr_quit();
-#endif
 }
 
 
@@ -51,7 +51,9 @@
 #include "compile/compile.h"
 #include "compile/symb_table/ResolveSymbol.h"
 #include "utils/WordNumber.h"
+#include "utils/ustring.h"
 #include "utils/error.h"
+#include "utils/Stack.h"
 
 /*---------------------------------------------------------------------------*/
 /* Macro declarations                                                        */
@@ -82,11 +84,46 @@
 ******************************************************************************/
 #ifdef SYMB_TABLE_STATIC
 static SymbTable_ptr expr_st = SYMB_TABLE(NULL);
-
-void fsm_sexp_expr_init() { expr_st = SYMB_TABLE(NULL); }
-void fsm_sexp_expr_quit() { expr_st = SYMB_TABLE(NULL); }
 #endif
 
+/**Variable********************************************************************
+
+  Synopsis           [Memoization of the simplifying constructors]
+
+  Description [Associates find_node(op, a, b) to the result of the
+  simplifying constructor of op (e.g. Expr_and, Expr_or) applied to a
+  and b. Results of constructors whose simplification depend on a
+  symbol table are instead memoized within the symbol table (see
+  SymbTable_get_rewrite_hash). The hash is allocated on demand and
+  freed when the package is deinitialized.
+
+  Only find_node-ed operands are memoized, as the address of a node
+  created by new_node can be reused once the node is freed. Hashes are
+  cleared when they reach EXPR_MEMOIZATION_MAX_SIZE entries.
+
+  Memoization can be disabled by defining the macro
+  DISABLE_EXPR_REWRITE_MEMOIZATION.]
+
+******************************************************************************/
+static hash_ptr expr_rewrite_hash = (hash_ptr) NULL;
+
+/**Variable********************************************************************
+
+  Synopsis           [Structural keys of expressions]
+
+  Description [Associates each find_node-ed expression to a key
+  computed out of its structure (i.e. not out of its address). Keys
+  are used to sort the operands of commutative operators within the
+  memoization keys, see expr_compare. The hash is allocated on demand,
+  cleared when it reaches EXPR_MEMOIZATION_MAX_SIZE entries and freed
+  when the package is deinitialized.]
+
+******************************************************************************/
+static hash_ptr expr_order_hash = (hash_ptr) NULL;
+
+/* The number of entries after which memoization hashes are cleared */
+#define EXPR_MEMOIZATION_MAX_SIZE (1 << 20)
+
 /* Don't change these values (used to handle NEXT untimed case and FROZEN) */
 const int UNTIMED_CURRENT = -2;
 const int UNTIMED_NEXT = -1;
@@ -116,6 +153,31 @@ static boolean expr_is_timed_aux ARGS((Expr_ptr expr, hash_ptr cache));
 
 static boolean expr_is_bool ARGS((const Expr_ptr a));
 
+static hash_ptr expr_get_rewrite_hash ARGS((SymbTable_ptr st));
+
+static boolean expr_are_hashed ARGS((const Expr_ptr a, const Expr_ptr b));
+
+static void expr_memoize ARGS((hash_ptr hash, node_ptr key, node_ptr value));
+
+static boolean expr_is_order_leaf ARGS((node_ptr expr));
+
+static int expr_get_leaf_order_key ARGS((node_ptr expr));
+
+static int expr_find_order_key ARGS((hash_ptr keys, node_ptr expr));
+
+static int expr_get_order_key ARGS((node_ptr expr));
+
+static int expr_compare ARGS((node_ptr a, node_ptr b));
+
+static node_ptr expr_get_lookup_key ARGS((int op, node_ptr a, node_ptr b));
+
+static Expr_ptr expr_and ARGS((const Expr_ptr a, const Expr_ptr b));
+
+static Expr_ptr expr_or ARGS((const Expr_ptr a, const Expr_ptr b));
+
+static Expr_ptr expr_equal ARGS((const Expr_ptr a, const Expr_ptr b,
+                                 SymbTable_ptr st));
+
 /**AutomaticEnd***************************************************************/
 
 
@@ -123,6 +185,55 @@ static boolean expr_is_bool ARGS((const Expr_ptr a));
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
 
+/**Function********************************************************************
+
+  Synopsis           [Initializes the Expr module]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            [fsm_sexp_expr_quit]
+
+******************************************************************************/
+void fsm_sexp_expr_init()
+{
+#ifdef SYMB_TABLE_STATIC
+  expr_st = SYMB_TABLE(NULL);
+#endif
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Deinitializes the Expr module]
+
+  Description        [Frees the memoization hashes. Must be called
+  before the node package is deinitialized.]
+
+  SideEffects        []
+
+  SeeAlso            [fsm_sexp_expr_init]
+
+******************************************************************************/
+void fsm_sexp_expr_quit()
+{
+#ifdef SYMB_TABLE_STATIC
+  expr_st = SYMB_TABLE(NULL);
+#endif
+
+  if ((hash_ptr) NULL != expr_rewrite_hash) {
+    free_assoc(expr_rewrite_hash);
+    expr_rewrite_hash = (hash_ptr) NULL;
+  }
+
+  if ((hash_ptr) NULL != expr_order_hash) {
+    free_assoc(expr_order_hash);
+    expr_order_hash = (hash_ptr) NULL;
+  }
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Returns the true expression value]
@@ -195,7 +306,8 @@ boolean Expr_is_false(const Expr_ptr expr)
 
   Synopsis           [Builds the logical/bitwise AND of given operators]
 
-  Description        [Performs local syntactic simplification]
+  Description        [Performs local syntactic simplification. Results
+  are memoized when both operands are find_node-ed]
 
   SideEffects        [None]
 
@@ -204,48 +316,149 @@ boolean Expr_is_false(const Expr_ptr expr)
 ******************************************************************************/
 Expr_ptr Expr_and(const Expr_ptr a, const Expr_ptr b)
 {
-  /* boolean */
-  if (a == EXPR(NULL) && b == EXPR(NULL)) return Expr_true();
-  if (a == EXPR(NULL) || Expr_is_true(a))  return b;
-  if (b == EXPR(NULL) || Expr_is_true(b))  return a;
-  if (Expr_is_false(a)) return a;
-  if (Expr_is_false(b)) return b;
-  if (a == b)           return a;
-  {
-    int ta = node_get_type(NODE_PTR(a)); int tb = node_get_type(NODE_PTR(b));
-    if ((ta == NOT && EXPR(car(NODE_PTR(a))) == b) ||
-        (tb == NOT && EXPR(car(NODE_PTR(b))) == a)) return Expr_false();
+#ifndef DISABLE_EXPR_REWRITE_MEMOIZATION
+  if (expr_are_hashed(a, b)) {
+    hash_ptr hash = expr_get_rewrite_hash(SYMB_TABLE(NULL));
+    node_ptr key = expr_get_lookup_key(AND, NODE_PTR(a), NODE_PTR(b));
+    Expr_ptr res = EXPR(find_assoc(hash, key));
+
+    if (EXPR(NULL) == res) {
+      res = expr_and(a, b);
+      expr_memoize(hash, key, NODE_PTR(res));
+    }
+    return res;
+  }
+#endif
 
-    /* bitwise */
-    if ((ta == NUMBER_UNSIGNED_WORD && tb == NUMBER_UNSIGNED_WORD) ||
-        (ta == NUMBER_SIGNED_WORD && tb == NUMBER_SIGNED_WORD)) {
+  return expr_and(a, b);
+}
 
-#ifndef DISABLE_EXPR_POINTERS_ORDERING
-      /* Take in count pointers to increment node sharing */
-      if (car(NODE_PTR(a)) > car(NODE_PTR(b))) {
-        return EXPR(find_node(ta,
-                              NODE_PTR(WordNumber_and(WORD_NUMBER(car(b)),
-                                                      WORD_NUMBER(car(a)))),
-                              Nil));
-      }
-#endif
 
-      return EXPR(find_node(ta,
-                            NODE_PTR(WordNumber_and(WORD_NUMBER(car(a)),
-                                                    WORD_NUMBER(car(b)))),
-                            Nil));
+/**Function********************************************************************
+
+  Synopsis           [Builds the logical/bitwise OR of given operators]
+
+  Description        [Performs local syntactic simplification. Results
+  are memoized when both operands are find_node-ed]
+
+  SideEffects        [None]
+
+  SeeAlso            []
+
+******************************************************************************/
+Expr_ptr Expr_or(const Expr_ptr a, const Expr_ptr b)
+{
+#ifndef DISABLE_EXPR_REWRITE_MEMOIZATION
+  if (expr_are_hashed(a, b)) {
+    hash_ptr hash = expr_get_rewrite_hash(SYMB_TABLE(NULL));
+    node_ptr key = expr_get_lookup_key(OR, NODE_PTR(a), NODE_PTR(b));
+    Expr_ptr res = EXPR(find_assoc(hash, key));
+
+    if (EXPR(NULL) == res) {
+      res = expr_or(a, b);
+      expr_memoize(hash, key, NODE_PTR(res));
     }
+    return res;
   }
+#endif
 
-#ifndef DISABLE_EXPR_POINTERS_ORDERING
-  /* no simplification is possible, but take in count pointers for
-     better node sharing */
-  if (a > b) {
-    return EXPR(find_node(AND, NODE_PTR(b), NODE_PTR(a)));
+  return expr_or(a, b);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Builds the logical EQUAL of given operators]
+
+  Description [Works with boolean, scalar and words. Performs local
+  syntactic simplification.
+
+  When a symbol table is given, results are memoized within the
+  hash returned by SymbTable_get_rewrite_hash, which is reset when
+  any layer is removed. As for Expr_and and Expr_or, results are
+  memoized only when both operands are find_node-ed]
+
+  SideEffects        [None]
+
+  SeeAlso            []
+
+******************************************************************************/
+#ifdef SYMB_TABLE_STATIC
+Expr_ptr Expr_equal(const Expr_ptr a,
+                    const Expr_ptr b,
+                    SymbTable_ptr st)
+#else
+Expr_ptr Expr_equal(const Expr_ptr a,
+                    const Expr_ptr b,
+                    const SymbTable_ptr st)
+#endif
+{
+#ifndef DISABLE_EXPR_REWRITE_MEMOIZATION
+  hash_ptr hash;
+  node_ptr key;
+  Expr_ptr res;
+#endif
+
+#ifdef SYMB_TABLE_STATIC
+  st = expr_st;
+#endif
+
+#ifndef DISABLE_EXPR_REWRITE_MEMOIZATION
+  if (expr_are_hashed(a, b)) {
+    hash = expr_get_rewrite_hash(st);
+    key = expr_get_lookup_key(EQUAL, NODE_PTR(a), NODE_PTR(b));
+    res = EXPR(find_assoc(hash, key));
+
+    if (EXPR(NULL) == res) {
+      res = expr_equal(a, b, st);
+      expr_memoize(hash, key, NODE_PTR(res));
+    }
+    return res;
   }
 #endif
 
-  return EXPR(find_node(AND, NODE_PTR(a), NODE_PTR(b)));
+  return expr_equal(a, b, st);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Returns the key under which expr can be memoized]
+
+  Description [The constructors order the operands of commutative
+  operators by address, so the same formula can be built with
+  different operand orders. If expr is a find_node-ed application of
+  a commutative operator, the returned key has its operands sorted by
+  the structural order of expr_compare, so that a op b and b op a
+  share the same key. Otherwise expr itself is returned.
+
+  The key must be used only for lookups (as in the BddEnc evaluation
+  cache), since the order of its operands can differ from the one the
+  constructors would choose.]
+
+  SideEffects        [None]
+
+  SeeAlso            [expr_get_lookup_key]
+
+******************************************************************************/
+node_ptr Expr_get_lookup_key(const Expr_ptr expr)
+{
+  node_ptr e = NODE_PTR(expr);
+
+  if (Nil == e || !node_is_hashed(e)) return e;
+
+  switch (node_get_type(e)) {
+  case AND: case OR: case XOR: case XNOR: case IFF:
+  case EQUAL: case NOTEQUAL: case PLUS: case TIMES:
+    if (expr_are_hashed(car(e), cdr(e)) &&
+        expr_compare(car(e), cdr(e)) > 0) {
+      return find_node(node_get_type(e), cdr(e), car(e));
+    }
+    return e;
+
+  default:
+    return e;
+  }
 }
 
 
@@ -350,7 +563,7 @@ Expr_ptr Expr_not(const Expr_ptr expr)
 
 /**Function********************************************************************
 
-  Synopsis           [Builds the logical/bitwise OR of given operators]
+  Synopsis           [Builds the logical/bitwise XOR of given operators]
 
   Description        [Performs local syntactic simplification]
 
@@ -359,97 +572,53 @@ Expr_ptr Expr_not(const Expr_ptr expr)
   SeeAlso            []
 
 ******************************************************************************/
-Expr_ptr Expr_or(const Expr_ptr a, const Expr_ptr b)
+Expr_ptr Expr_xor(const Expr_ptr a, const Expr_ptr b)
 {
   /* boolean */
-  if (Expr_is_true(a)) return a;
-  if (Expr_is_true(b)) return b;
+  if (Expr_is_true(a)) return Expr_not(b);
+  if (Expr_is_true(b)) return Expr_not(a);
   if (Expr_is_false(a)) return b;
   if (Expr_is_false(b)) return a;
-  if (a==b) return a;
-  {
-    int ta = node_get_type(NODE_PTR(a)); int tb = node_get_type(NODE_PTR(b));
-
-    if ((ta == NOT && EXPR(car(NODE_PTR(a))) == b) ||
-        (tb == NOT && EXPR(car(NODE_PTR(b))) == a)) return Expr_true();
-
-    if ((ta == AND) && (tb == AND)) {
-      /* ((A & B) || (A & !B)) ---> A */
-      /* ((A & !B) || (A & B)) ---> A */
-      if ((car(NODE_PTR(a)) == car(NODE_PTR(b))) &&
-          (((node_get_type(cdr(NODE_PTR(b))) == NOT) &&
-            (car(cdr(NODE_PTR(b))) == cdr(a))) ||
-           ((node_get_type(cdr(NODE_PTR(a))) == NOT) &&
-            (car(cdr(NODE_PTR(a))) == cdr(NODE_PTR(b)))))) {
-        return car(a);
-      }
-
-      /* ((A & B) || (!A & B)) ---> B */
-      /* ((!A & B) || ( A & B)) ---> B */
-      if ((cdr(a) == cdr(b)) &&
-          (((node_get_type(car(b)) == NOT) &&
-            (car(car(b)) == car(a))) ||
-           ((node_get_type(car(a)) == NOT) &&
-            (car(car(a)) == car(b))))) {
-        return cdr(a);
-      }
-
-      /* (( A & B) || (B & !A)) ---> B */
-      /* ((!A & B) || (B & A)) ---> B */
-      if ((cdr(a) == car(b)) &&
-          (((node_get_type(cdr(b)) == NOT) &&
-            (car(cdr(b)) == car(a))) ||
-           ((node_get_type(car(a)) == NOT) &&
-            (car(car(a)) == cdr(b))))) {
-        return cdr(a);
-      }
 
-      /* ((A & B) || (!B & A)) ---> A */
-      /* ((A & !B) || ( B & A)) ---> A */
-      if ((car(a) == cdr(b)) &&
-          (((node_get_type(car(b)) == NOT) &&
-            (car(car(b)) == cdr(a))) ||
-           (((node_get_type(cdr(a)) == NOT) &&
-             (car(cdr(a)) == car(b)))))) {
-        return car(a);
-      }
-    }
+  {
+    int ta = node_get_type(a); int tb = node_get_type(b);
+    if ((ta == NOT && car(a) == b) ||
+        (tb == NOT && car(b) == a)) return Expr_true();
 
     /* bitwise */
     if ((ta == NUMBER_UNSIGNED_WORD && tb == NUMBER_UNSIGNED_WORD) ||
         (ta == NUMBER_SIGNED_WORD && tb == NUMBER_SIGNED_WORD)) {
 
 #ifndef DISABLE_EXPR_POINTERS_ORDERING
-      /* Swap if needed, for better sharing */
       if (car(a) > car(b)) {
         return find_node(ta,
-                         (node_ptr) WordNumber_or(WORD_NUMBER(car(b)),
-                                                  WORD_NUMBER(car(a))),
+                         (node_ptr) WordNumber_xor(WORD_NUMBER(car(b)),
+                                                   WORD_NUMBER(car(a))),
                          Nil);
       }
 #endif
       return find_node(ta,
-                       (node_ptr) WordNumber_or(WORD_NUMBER(car(a)),
-                                                WORD_NUMBER(car(b))),
+                       (node_ptr) WordNumber_xor(WORD_NUMBER(car(a)),
+                                                 WORD_NUMBER(car(b))),
                        Nil);
     }
   }
 
 #ifndef DISABLE_EXPR_POINTERS_ORDERING
-  /* no simplification is possible, but improve node sharing by
-     ordering the children */
+  /* no simplification is possible, order children by pointer for
+     better node sharing */
   if (a > b) {
-    return EXPR( find_node(OR, NODE_PTR(b), NODE_PTR(a)) );
+    return EXPR( find_node(XOR, NODE_PTR(b), NODE_PTR(a)) );
   }
 #endif
 
-  return EXPR( find_node(OR, NODE_PTR(a), NODE_PTR(b)) );
+  return EXPR( find_node(XOR, NODE_PTR(a), NODE_PTR(b)) );
 }
 
 
 /**Function********************************************************************
 
-  Synopsis           [Builds the logical/bitwise XOR of given operators]
+  Synopsis           [Builds the logical/bitwise XNOR of given operators]
 
   Description        [Performs local syntactic simplification]
 
@@ -458,68 +627,13 @@ Expr_ptr Expr_or(const Expr_ptr a, const Expr_ptr b)
   SeeAlso            []
 
 ******************************************************************************/
-Expr_ptr Expr_xor(const Expr_ptr a, const Expr_ptr b)
+Expr_ptr Expr_xnor(const Expr_ptr a, const Expr_ptr b)
 {
   /* boolean */
-  if (Expr_is_true(a)) return Expr_not(b);
-  if (Expr_is_true(b)) return Expr_not(a);
-  if (Expr_is_false(a)) return b;
-  if (Expr_is_false(b)) return a;
-
-  {
-    int ta = node_get_type(a); int tb = node_get_type(b);
-    if ((ta == NOT && car(a) == b) ||
-        (tb == NOT && car(b) == a)) return Expr_true();
-
-    /* bitwise */
-    if ((ta == NUMBER_UNSIGNED_WORD && tb == NUMBER_UNSIGNED_WORD) ||
-        (ta == NUMBER_SIGNED_WORD && tb == NUMBER_SIGNED_WORD)) {
-
-#ifndef DISABLE_EXPR_POINTERS_ORDERING
-      if (car(a) > car(b)) {
-        return find_node(ta,
-                         (node_ptr) WordNumber_xor(WORD_NUMBER(car(b)),
-                                                   WORD_NUMBER(car(a))),
-                         Nil);
-      }
-#endif
-      return find_node(ta,
-                       (node_ptr) WordNumber_xor(WORD_NUMBER(car(a)),
-                                                 WORD_NUMBER(car(b))),
-                       Nil);
-    }
-  }
-
-#ifndef DISABLE_EXPR_POINTERS_ORDERING
-  /* no simplification is possible, order children by pointer for
-     better node sharing */
-  if (a > b) {
-    return EXPR( find_node(XOR, NODE_PTR(b), NODE_PTR(a)) );
-  }
-#endif
-
-  return EXPR( find_node(XOR, NODE_PTR(a), NODE_PTR(b)) );
-}
-
-
-/**Function********************************************************************
-
-  Synopsis           [Builds the logical/bitwise XNOR of given operators]
-
-  Description        [Performs local syntactic simplification]
-
-  SideEffects        [None]
-
-  SeeAlso            []
-
-******************************************************************************/
-Expr_ptr Expr_xnor(const Expr_ptr a, const Expr_ptr b)
-{
-  /* boolean */
-  if (Expr_is_true(a)) return b;
-  if (Expr_is_true(b)) return a;
-  if (Expr_is_false(a)) return Expr_not(b);
-  if (Expr_is_false(b)) return Expr_not(a);
+  if (Expr_is_true(a)) return b;
+  if (Expr_is_true(b)) return a;
+  if (Expr_is_false(a)) return Expr_not(b);
+  if (Expr_is_false(b)) return Expr_not(a);
 
   {
     int ta = node_get_type(a); int tb = node_get_type(b);
@@ -920,118 +1034,6 @@ Expr_ptr Expr_next(const Expr_ptr a, const SymbTable_ptr symb_table)
   return EXPR( find_node(NEXT, NODE_PTR(a), Nil)  );
 }
 
-/**Function********************************************************************
-
-  Synopsis           [Builds the logical EQUAL of given operators]
-
-  Description [Works with boolean, scalar and words. Performs local
-  syntactic simplification]
-
-  SideEffects        [None]
-
-  SeeAlso            []
-
-******************************************************************************/
-#ifdef SYMB_TABLE_STATIC
-Expr_ptr Expr_equal(const Expr_ptr a,
-                    const Expr_ptr b,
-                    SymbTable_ptr st)
-#else
-Expr_ptr Expr_equal(const Expr_ptr a,
-                    const Expr_ptr b,
-                    const SymbTable_ptr st)
-#endif
-{
-#ifdef SYMB_TABLE_STATIC
-  st = expr_st;
-#endif
-
-  if (a == b) return Expr_true();
-  if (Expr_is_true(a) && Expr_is_true(b)) return Expr_true();
-  if (Expr_is_true(a) && Expr_is_false(b)) return Expr_false();
-  if (Expr_is_false(a) && Expr_is_false(b)) return Expr_true();
-  if (Expr_is_false(a) && Expr_is_true(b)) return Expr_false();
-
-  {
-    int ta, tb;
-    ta = node_get_type(a); tb = node_get_type(b);
-
-    if ((ta == NOT && car(a) == b) ||
-        (tb == NOT && car(b) == a)) return Expr_false();
-
-    /* scalar constants */
-    if (NUMBER == ta && NUMBER == tb) {
-      int va = node_get_int(a);
-      int vb = node_get_int(b);
-      return (va == vb) ? Expr_true() : Expr_false();
-    }
-    /* words */
-    else if (NUMBER_UNSIGNED_WORD == ta || NUMBER_UNSIGNED_WORD == tb ||
-             NUMBER_SIGNED_WORD == ta || NUMBER_SIGNED_WORD == tb) {
-      WordNumber_ptr va =
-        (NUMBER_UNSIGNED_WORD == ta || NUMBER_SIGNED_WORD == ta)
-        ? WORD_NUMBER(car(a)) : WORD_NUMBER(NULL);
-      WordNumber_ptr vb =
-        (NUMBER_UNSIGNED_WORD == tb || NUMBER_SIGNED_WORD == tb)
-        ? WORD_NUMBER(car(b)) : WORD_NUMBER(NULL);
-
-      if (va != WORD_NUMBER(NULL) && vb != (WORD_NUMBER(NULL)))
-        return WordNumber_equal(va, vb)
-          ? Expr_true() : Expr_false();
-    }
-  }
-
-  /* additional simplifications */
-  if (SYMB_TABLE(NULL) != st) {
-    SymbType_ptr ta, tb;
-    TypeChecker_ptr tc = SymbTable_get_type_checker(st);
-
-    /* enumerative? */
-    if (SymbTable_is_symbol_constant(st, a) &&
-        SymbTable_is_symbol_constant(st, b)) {
-      return (a == b) ? Expr_true() : Expr_false();
-    }
-
-    /* TRUE = B --------> B */
-    if (Expr_is_true(a)) {
-      tb = TypeChecker_get_expression_type(tc, b, Nil);
-      if (SymbType_is_boolean(tb)) {
-        return b;
-      }
-    }
-    /* A = TRUE --------> A */
-    else if (Expr_is_true(b)) {
-      ta = TypeChecker_get_expression_type(tc, a, Nil);
-      if (SymbType_is_boolean(ta)) {
-        return a;
-      }
-    }
-    /* FALSE = B --------> !B */
-    else if (Expr_is_false(a)) {
-      tb = TypeChecker_get_expression_type(tc, b, Nil);
-      if (SymbType_is_boolean(tb)) {
-        return Expr_not(b);
-      }
-    }
-    /* A = FALSE --------> !A */
-    else if (Expr_is_false(b)) {
-      ta = TypeChecker_get_expression_type(tc, a, Nil);
-      if (SymbType_is_boolean(ta)) {
-        return Expr_not(a);
-      }
-    }
-  }
-
-#ifndef DISABLE_EXPR_POINTERS_ORDERING
-  /* no simplification is possible, remember ordering */
-  if (a > b) {
-    return EXPR( find_node(EQUAL, NODE_PTR(b), NODE_PTR(a)) );
-  }
-#endif
-
-  return EXPR( find_node(EQUAL, NODE_PTR(a), NODE_PTR(b)) );
-}
-
 /**Function********************************************************************
 
   Synopsis           [Builds the logical NOTEQUAL of given operators]
@@ -3852,3 +3854,623 @@ static boolean expr_is_bool(const Expr_ptr a)
   return (Expr_is_true(a) || Expr_is_false(a));
 }
 
+
+/**Function********************************************************************
+
+   Synopsis           [Returns the hash used to memoize the simplifying
+   constructors]
+
+   Description        [If st is not NULL, the hash owned by st is
+   returned, otherwise the module hash (allocated on demand)]
+
+   SideEffects        [expr_rewrite_hash may be allocated]
+
+   SeeAlso            [SymbTable_get_rewrite_hash]
+
+******************************************************************************/
+static hash_ptr expr_get_rewrite_hash(SymbTable_ptr st)
+{
+  if (SYMB_TABLE(NULL) != st) return SymbTable_get_rewrite_hash(st);
+
+  if ((hash_ptr) NULL == expr_rewrite_hash) {
+    expr_rewrite_hash = new_assoc();
+  }
+  return expr_rewrite_hash;
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Checks whether the results of a constructor
+   applied to a and b can be memoized]
+
+   Description        [Nil operands are allowed]
+
+   SideEffects        []
+
+   SeeAlso            [node_is_hashed]
+
+******************************************************************************/
+static boolean expr_are_hashed(const Expr_ptr a, const Expr_ptr b)
+{
+  return (Nil == NODE_PTR(a) || node_is_hashed(NODE_PTR(a))) &&
+    (Nil == NODE_PTR(b) || node_is_hashed(NODE_PTR(b)));
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Inserts an entry into a memoization hash]
+
+   Description        [The hash is cleared when it is full]
+
+   SideEffects        [hash is updated]
+
+   SeeAlso            []
+
+******************************************************************************/
+static void expr_memoize(hash_ptr hash, node_ptr key, node_ptr value)
+{
+  if (st_count(hash) >= EXPR_MEMOIZATION_MAX_SIZE) clear_assoc(hash);
+  insert_assoc(hash, key, value);
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Checks whether the structural key of an
+   expression does not depend on its children]
+
+   Description        []
+
+   SideEffects        []
+
+   SeeAlso            [expr_get_leaf_order_key]
+
+******************************************************************************/
+static boolean expr_is_order_leaf(node_ptr expr)
+{
+  switch (node_get_type(expr)) {
+  case ATOM:
+  case NUMBER_FRAC:
+  case NUMBER_REAL:
+  case NUMBER_EXP:
+  case NUMBER:
+  case NUMBER_UNSIGNED_WORD:
+  case NUMBER_SIGNED_WORD:
+  case FAILURE:
+  case TRUEEXP:
+  case FALSEEXP:
+  case BOOLEAN:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Returns the structural key of a leaf]
+
+   Description        [See expr_is_order_leaf]
+
+   SideEffects        []
+
+   SeeAlso            [expr_get_order_key]
+
+******************************************************************************/
+static int expr_get_leaf_order_key(node_ptr expr)
+{
+  unsigned int key = (unsigned int) node_get_type(expr);
+
+  switch (node_get_type(expr)) {
+  case ATOM:
+  case NUMBER_FRAC:
+  case NUMBER_REAL:
+  case NUMBER_EXP:
+    {
+      const char* str = get_text((string_ptr) car(expr));
+      for (; *str != '\0'; ++str) key = key * 31 + (unsigned char) *str;
+      break;
+    }
+
+  case NUMBER:
+    key = key * 31 + (unsigned int) node_get_int(expr);
+    break;
+
+  case NUMBER_UNSIGNED_WORD:
+  case NUMBER_SIGNED_WORD:
+    {
+      WordNumber_ptr num = WORD_NUMBER(car(expr));
+      WordNumberValue val = WordNumber_get_unsigned_value(num);
+      key = key * 31 + (unsigned int) WordNumber_get_width(num);
+      key = key * 31 + (unsigned int) (val ^ (val >> 32));
+      break;
+    }
+
+  default:
+    break;
+  }
+
+  /* 0 is reserved to Nil, and can not be stored in hashes */
+  return (0 == key) ? 1 : (int) key;
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Returns the structural key of an expression, if
+   already known]
+
+   Description        [Keys are looked for in expr_order_hash, then in
+   keys. Returns 0 if the key is not known yet (or expr is Nil)]
+
+   SideEffects        []
+
+   SeeAlso            [expr_get_order_key]
+
+******************************************************************************/
+static int expr_find_order_key(hash_ptr keys, node_ptr expr)
+{
+  node_ptr tmp;
+
+  if (Nil == expr) return 0;
+  if (expr_is_order_leaf(expr)) return expr_get_leaf_order_key(expr);
+
+  tmp = find_assoc(expr_order_hash, expr);
+  if (Nil == tmp && (hash_ptr) NULL != keys) tmp = find_assoc(keys, expr);
+
+  return (Nil != tmp) ? NODE_TO_INT(tmp) : 0;
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Returns the structural key of an expression]
+
+   Description        [The key only depends on the structure of the
+   expression (node types, names and values of leaves), and not on the
+   addresses of its nodes. Keys of find_node-ed expressions are
+   memoized in expr_order_hash.
+
+   The expression is visited iteratively, so that long chains of
+   operators do not exhaust the stack.]
+
+   SideEffects        [expr_order_hash is updated]
+
+   SeeAlso            [expr_compare]
+
+******************************************************************************/
+static int expr_get_order_key(node_ptr expr)
+{
+  hash_ptr keys;
+  Stack_ptr stack;
+  int res;
+
+  if ((hash_ptr) NULL == expr_order_hash) {
+    expr_order_hash = new_assoc();
+  }
+
+  res = expr_find_order_key((hash_ptr) NULL, expr);
+  if (0 != res || Nil == expr) return res;
+
+  /* keys of the expressions which are not find_node-ed */
+  keys = new_assoc();
+  stack = Stack_create();
+  Stack_push(stack, expr);
+
+  while (!Stack_is_empty(stack)) {
+    node_ptr e = NODE_PTR(Stack_top(stack));
+    node_ptr left = car(e);
+    node_ptr right = (BIT == node_get_type(e)) ? Nil : cdr(e);
+    int kl, kr;
+    unsigned int key;
+
+    /* an expression can be pushed more than once */
+    if (0 != expr_find_order_key(keys, e)) {
+      Stack_pop(stack);
+      continue;
+    }
+
+    kl = expr_find_order_key(keys, left);
+    kr = expr_find_order_key(keys, right);
+
+    if ((Nil != left && 0 == kl) || (Nil != right && 0 == kr)) {
+      if (Nil != left && 0 == kl) Stack_push(stack, left);
+      if (Nil != right && 0 == kr) Stack_push(stack, right);
+      continue;
+    }
+
+    key = (unsigned int) node_get_type(e);
+    key = key * 31 + (unsigned int) kl;
+    if (BIT == node_get_type(e)) {
+      key = key * 31 + (unsigned int) NODE_TO_INT(cdr(e));
+    }
+    else key = key * 31 + (unsigned int) kr;
+
+    /* 0 is reserved to Nil, and can not be stored in the hashes */
+    if (0 == key) key = 1;
+
+    if (node_is_hashed(e)) {
+      expr_memoize(expr_order_hash, e, NODE_FROM_INT((int) key));
+    }
+    insert_assoc(keys, e, NODE_FROM_INT((int) key));
+    Stack_pop(stack);
+  }
+
+  res = NODE_TO_INT(find_assoc(keys, expr));
+
+  Stack_destroy(stack);
+  free_assoc(keys);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Compares two expressions structurally]
+
+   Description        [Returns a negative number, zero or a positive
+   number if a is respectively smaller than, structurally equal to or
+   greater than b. The order does not depend on the addresses of the
+   nodes, so the memoization keys of commutative operators are the same
+   independently on the order expressions are built. Structural
+   keys are compared first, so the recursive comparison is only
+   performed for colliding keys.]
+
+   SideEffects        [expr_order_hash is updated]
+
+   SeeAlso            [expr_get_order_key]
+
+******************************************************************************/
+static int expr_compare(node_ptr a, node_ptr b)
+{
+  int ka, kb, ta, tb;
+
+  if (a == b) return 0;
+  if (Nil == a) return -1;
+  if (Nil == b) return 1;
+
+  ka = expr_get_order_key(a); kb = expr_get_order_key(b);
+  if (ka != kb) return (ka < kb) ? -1 : 1;
+
+  ta = node_get_type(a); tb = node_get_type(b);
+  if (ta != tb) return (ta < tb) ? -1 : 1;
+
+  switch (ta) {
+  case ATOM:
+  case NUMBER_FRAC:
+  case NUMBER_REAL:
+  case NUMBER_EXP:
+    return strcmp(get_text((string_ptr) car(a)),
+                  get_text((string_ptr) car(b)));
+
+  case NUMBER:
+    {
+      int va = node_get_int(a); int vb = node_get_int(b);
+      return (va == vb) ? 0 : ((va < vb) ? -1 : 1);
+    }
+
+  case NUMBER_UNSIGNED_WORD:
+  case NUMBER_SIGNED_WORD:
+    {
+      WordNumber_ptr wa = WORD_NUMBER(car(a));
+      WordNumber_ptr wb = WORD_NUMBER(car(b));
+      int sa = WordNumber_get_width(wa); int sb = WordNumber_get_width(wb);
+      WordNumberValue va, vb;
+
+      if (sa != sb) return (sa < sb) ? -1 : 1;
+      va = WordNumber_get_unsigned_value(wa);
+      vb = WordNumber_get_unsigned_value(wb);
+      return (va == vb) ? 0 : ((va < vb) ? -1 : 1);
+    }
+
+  case BIT:
+    {
+      int res = expr_compare(car(a), car(b));
+      int va, vb;
+
+      if (0 != res) return res;
+      va = NODE_TO_INT(cdr(a)); vb = NODE_TO_INT(cdr(b));
+      return (va == vb) ? 0 : ((va < vb) ? -1 : 1);
+    }
+
+  case FAILURE:
+  case TRUEEXP:
+  case FALSEEXP:
+  case BOOLEAN:
+    return 0;
+
+  default:
+    {
+      int res = expr_compare(car(a), car(b));
+      if (0 != res) return res;
+      return expr_compare(cdr(a), cdr(b));
+    }
+  }
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Returns the memoization key of a op b]
+
+   Description        [a and b must be find_node-ed. The operands of
+   the key are sorted structurally (see expr_compare), so that a op b and
+   b op a share the same key. The key is never returned as a result,
+   so the operands of the built expressions keep the address order.]
+
+   SideEffects        [expr_order_hash is updated]
+
+   SeeAlso            [Expr_get_lookup_key]
+
+******************************************************************************/
+static node_ptr expr_get_lookup_key(int op, node_ptr a, node_ptr b)
+{
+  if (expr_compare(a, b) > 0) return find_node(op, b, a);
+  return find_node(op, a, b);
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Builds the logical/bitwise AND of given operators]
+
+   Description        [Private service of Expr_and, performing the local
+   syntactic simplification]
+
+   SideEffects        [None]
+
+   SeeAlso            [Expr_and]
+
+******************************************************************************/
+static Expr_ptr expr_and(const Expr_ptr a, const Expr_ptr b)
+{
+  /* boolean */
+  if (a == EXPR(NULL) && b == EXPR(NULL)) return Expr_true();
+  if (a == EXPR(NULL) || Expr_is_true(a))  return b;
+  if (b == EXPR(NULL) || Expr_is_true(b))  return a;
+  if (Expr_is_false(a)) return a;
+  if (Expr_is_false(b)) return b;
+  if (a == b)           return a;
+  {
+    int ta = node_get_type(NODE_PTR(a)); int tb = node_get_type(NODE_PTR(b));
+    if ((ta == NOT && EXPR(car(NODE_PTR(a))) == b) ||
+        (tb == NOT && EXPR(car(NODE_PTR(b))) == a)) return Expr_false();
+
+    /* bitwise */
+    if ((ta == NUMBER_UNSIGNED_WORD && tb == NUMBER_UNSIGNED_WORD) ||
+        (ta == NUMBER_SIGNED_WORD && tb == NUMBER_SIGNED_WORD)) {
+
+#ifndef DISABLE_EXPR_POINTERS_ORDERING
+      /* Take in count pointers to increment node sharing */
+      if (car(NODE_PTR(a)) > car(NODE_PTR(b))) {
+        return EXPR(find_node(ta,
+                              NODE_PTR(WordNumber_and(WORD_NUMBER(car(b)),
+                                                      WORD_NUMBER(car(a)))),
+                              Nil));
+      }
+#endif
+
+      return EXPR(find_node(ta,
+                            NODE_PTR(WordNumber_and(WORD_NUMBER(car(a)),
+                                                    WORD_NUMBER(car(b)))),
+                            Nil));
+    }
+  }
+
+#ifndef DISABLE_EXPR_POINTERS_ORDERING
+  /* no simplification is possible, but take in count pointers for
+     better node sharing */
+  if (a > b) {
+    return EXPR(find_node(AND, NODE_PTR(b), NODE_PTR(a)));
+  }
+#endif
+
+  return EXPR(find_node(AND, NODE_PTR(a), NODE_PTR(b)));
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Builds the logical/bitwise OR of given operators]
+
+   Description        [Private service of Expr_or, performing the local
+   syntactic simplification]
+
+   SideEffects        [None]
+
+   SeeAlso            [Expr_or]
+
+******************************************************************************/
+static Expr_ptr expr_or(const Expr_ptr a, const Expr_ptr b)
+{
+  /* boolean */
+  if (Expr_is_true(a)) return a;
+  if (Expr_is_true(b)) return b;
+  if (Expr_is_false(a)) return b;
+  if (Expr_is_false(b)) return a;
+  if (a==b) return a;
+  {
+    int ta = node_get_type(NODE_PTR(a)); int tb = node_get_type(NODE_PTR(b));
+
+    if ((ta == NOT && EXPR(car(NODE_PTR(a))) == b) ||
+        (tb == NOT && EXPR(car(NODE_PTR(b))) == a)) return Expr_true();
+
+    if ((ta == AND) && (tb == AND)) {
+      /* ((A & B) || (A & !B)) ---> A */
+      /* ((A & !B) || (A & B)) ---> A */
+      if ((car(NODE_PTR(a)) == car(NODE_PTR(b))) &&
+          (((node_get_type(cdr(NODE_PTR(b))) == NOT) &&
+            (car(cdr(NODE_PTR(b))) == cdr(a))) ||
+           ((node_get_type(cdr(NODE_PTR(a))) == NOT) &&
+            (car(cdr(NODE_PTR(a))) == cdr(NODE_PTR(b)))))) {
+        return car(a);
+      }
+
+      /* ((A & B) || (!A & B)) ---> B */
+      /* ((!A & B) || ( A & B)) ---> B */
+      if ((cdr(a) == cdr(b)) &&
+          (((node_get_type(car(b)) == NOT) &&
+            (car(car(b)) == car(a))) ||
+           ((node_get_type(car(a)) == NOT) &&
+            (car(car(a)) == car(b))))) {
+        return cdr(a);
+      }
+
+      /* (( A & B) || (B & !A)) ---> B */
+      /* ((!A & B) || (B & A)) ---> B */
+      if ((cdr(a) == car(b)) &&
+          (((node_get_type(cdr(b)) == NOT) &&
+            (car(cdr(b)) == car(a))) ||
+           ((node_get_type(car(a)) == NOT) &&
+            (car(car(a)) == cdr(b))))) {
+        return cdr(a);
+      }
+
+      /* ((A & B) || (!B & A)) ---> A */
+      /* ((A & !B) || ( B & A)) ---> A */
+      if ((car(a) == cdr(b)) &&
+          (((node_get_type(car(b)) == NOT) &&
+            (car(car(b)) == cdr(a))) ||
+           (((node_get_type(cdr(a)) == NOT) &&
+             (car(cdr(a)) == car(b)))))) {
+        return car(a);
+      }
+    }
+
+    /* bitwise */
+    if ((ta == NUMBER_UNSIGNED_WORD && tb == NUMBER_UNSIGNED_WORD) ||
+        (ta == NUMBER_SIGNED_WORD && tb == NUMBER_SIGNED_WORD)) {
+
+#ifndef DISABLE_EXPR_POINTERS_ORDERING
+      /* Swap if needed, for better sharing */
+      if (car(a) > car(b)) {
+        return find_node(ta,
+                         (node_ptr) WordNumber_or(WORD_NUMBER(car(b)),
+                                                  WORD_NUMBER(car(a))),
+                         Nil);
+      }
+#endif
+      return find_node(ta,
+                       (node_ptr) WordNumber_or(WORD_NUMBER(car(a)),
+                                                WORD_NUMBER(car(b))),
+                       Nil);
+    }
+  }
+
+#ifndef DISABLE_EXPR_POINTERS_ORDERING
+  /* no simplification is possible, but improve node sharing by
+     ordering the children */
+  if (a > b) {
+    return EXPR( find_node(OR, NODE_PTR(b), NODE_PTR(a)) );
+  }
+#endif
+
+  return EXPR( find_node(OR, NODE_PTR(a), NODE_PTR(b)) );
+}
+
+
+/**Function********************************************************************
+
+   Synopsis           [Builds the logical EQUAL of given operators]
+
+   Description        [Private service of Expr_equal, performing the
+   local syntactic simplification]
+
+   SideEffects        [None]
+
+   SeeAlso            [Expr_equal]
+
+******************************************************************************/
+static Expr_ptr expr_equal(const Expr_ptr a, const Expr_ptr b,
+                           SymbTable_ptr st)
+{
+  if (a == b) return Expr_true();
+  if (Expr_is_true(a) && Expr_is_true(b)) return Expr_true();
+  if (Expr_is_true(a) && Expr_is_false(b)) return Expr_false();
+  if (Expr_is_false(a) && Expr_is_false(b)) return Expr_true();
+  if (Expr_is_false(a) && Expr_is_true(b)) return Expr_false();
+
+  {
+    int ta, tb;
+    ta = node_get_type(a); tb = node_get_type(b);
+
+    if ((ta == NOT && car(a) == b) ||
+        (tb == NOT && car(b) == a)) return Expr_false();
+
+    /* scalar constants */
+    if (NUMBER == ta && NUMBER == tb) {
+      int va = node_get_int(a);
+      int vb = node_get_int(b);
+      return (va == vb) ? Expr_true() : Expr_false();
+    }
+    /* words */
+    else if (NUMBER_UNSIGNED_WORD == ta || NUMBER_UNSIGNED_WORD == tb ||
+             NUMBER_SIGNED_WORD == ta || NUMBER_SIGNED_WORD == tb) {
+      WordNumber_ptr va =
+        (NUMBER_UNSIGNED_WORD == ta || NUMBER_SIGNED_WORD == ta)
+        ? WORD_NUMBER(car(a)) : WORD_NUMBER(NULL);
+      WordNumber_ptr vb =
+        (NUMBER_UNSIGNED_WORD == tb || NUMBER_SIGNED_WORD == tb)
+        ? WORD_NUMBER(car(b)) : WORD_NUMBER(NULL);
+
+      if (va != WORD_NUMBER(NULL) && vb != (WORD_NUMBER(NULL)))
+        return WordNumber_equal(va, vb)
+          ? Expr_true() : Expr_false();
+    }
+  }
+
+  /* additional simplifications */
+  if (SYMB_TABLE(NULL) != st) {
+    SymbType_ptr ta, tb;
+    TypeChecker_ptr tc = SymbTable_get_type_checker(st);
+
+    /* enumerative? */
+    if (SymbTable_is_symbol_constant(st, a) &&
+        SymbTable_is_symbol_constant(st, b)) {
+      return (a == b) ? Expr_true() : Expr_false();
+    }
+
+    /* TRUE = B --------> B */
+    if (Expr_is_true(a)) {
+      tb = TypeChecker_get_expression_type(tc, b, Nil);
+      if (SymbType_is_boolean(tb)) {
+        return b;
+      }
+    }
+    /* A = TRUE --------> A */
+    else if (Expr_is_true(b)) {
+      ta = TypeChecker_get_expression_type(tc, a, Nil);
+      if (SymbType_is_boolean(ta)) {
+        return a;
+      }
+    }
+    /* FALSE = B --------> !B */
+    else if (Expr_is_false(a)) {
+      tb = TypeChecker_get_expression_type(tc, b, Nil);
+      if (SymbType_is_boolean(tb)) {
+        return Expr_not(b);
+      }
+    }
+    /* A = FALSE --------> !A */
+    else if (Expr_is_false(b)) {
+      ta = TypeChecker_get_expression_type(tc, a, Nil);
+      if (SymbType_is_boolean(ta)) {
+        return Expr_not(a);
+      }
+    }
+  }
+
+#ifndef DISABLE_EXPR_POINTERS_ORDERING
+  /* no simplification is possible, remember ordering */
+  if (a > b) {
+    return EXPR( find_node(EQUAL, NODE_PTR(b), NODE_PTR(a)) );
+  }
+#endif
+
+  return EXPR( find_node(EQUAL, NODE_PTR(a), NODE_PTR(b)) );
+}
@@ -197,6 +197,7 @@ EXTERN Expr_ptr Expr_function ARGS((const Expr_ptr name,
 EXTERN Expr_ptr Expr_resolve ARGS((SymbTable_ptr st,
                                    int type, Expr_ptr left, Expr_ptr right));
 EXTERN Expr_ptr Expr_simplify ARGS((SymbTable_ptr st, Expr_ptr expr));
+EXTERN node_ptr Expr_get_lookup_key ARGS((const Expr_ptr expr));
 
 EXTERN boolean Expr_is_timed ARGS((Expr_ptr expr, hash_ptr cache));
 
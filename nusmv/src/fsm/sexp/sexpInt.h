@@ -50,10 +50,8 @@ EXTERN FILE* nusmv_stderr;
 EXTERN FILE* nusmv_stdout;
 EXTERN int yylineno;
 
-#ifdef SYMB_TABLE_STATIC
 EXTERN void fsm_sexp_expr_init ARGS((void));
 EXTERN void fsm_sexp_expr_quit ARGS((void));
-#endif
 
 #endif /* __FSM_SEXP_SEXP_INT__H */
 
@@ -43,6 +43,7 @@
 #include "mcInt.h" 
 #include "parser/symbols.h"
 #include "utils/error.h"
+#include "utils/Profile.h"
 
 static char rcsid[] UTIL_UNUSED = "$Id: mcEval.c,v 1.3.6.9.4.1.6.2 2007-03-20 19:30:11 nusmv Exp $";
 
@@ -109,7 +110,9 @@ bdd_ptr eval_ctl_spec(BddFsm_ptr fsm, BddEnc_ptr enc,
 
   if (n == Nil) return(bdd_true(dd_manager));
   yylineno = node_get_lineno(n);
+  Profile_begin("eval_ctl_spec");
   res = eval_ctl_spec_recur(fsm, enc, n, context);
+  Profile_end("eval_ctl_spec");
   yylineno = temp;
   return(res);
 }
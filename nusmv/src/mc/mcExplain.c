@@ -49,6 +49,7 @@ To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
 #include "utils/assoc.h"
 #include "fsm/bdd/FairnessList.h"
 #include "utils/error.h"
+#include "utils/Profile.h"
 #include "utils/utils_io.h" /* for indent_node */
 #include "compile/symb_table/ResolveSymbol.h"
 
@@ -133,7 +134,13 @@ mc_explain_debug_check_not_empty_state ARGS((BddFsm_ptr fsm,
 node_ptr explain(BddFsm_ptr fsm, BddEnc_ptr enc,
                  node_ptr path, node_ptr spec_formula, node_ptr context)
 {
-  return explain_recur(fsm, enc, path, spec_formula, context);
+  node_ptr res;
+
+  Profile_begin("explain");
+  res = explain_recur(fsm, enc, path, spec_formula, context);
+  Profile_end("explain");
+
+  return res;
 }
 
 /*--------------------------------------------------------------------------*/
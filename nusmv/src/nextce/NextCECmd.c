@@ -10,22 +10,29 @@
 #include "trace/TraceManager.h"
 #include "trace/pkg_trace.h"
 #include "trace/plugins/TraceExplainer.h"
+#include "trace/plugins/TraceXmlDumper.h"
 #include "parser/symbols.h"
 #include "node/node.h"
 #include "ltl/ltl.h"
 
 /* Used in debug/error printouts */
 extern FILE * nusmv_stderr;
+extern FILE * nusmv_stdout;
 /**
  * This structure contains the options passed as command line arguments.
  */
 typedef struct {
 	int prop_num;
+	/* compute_all only: prefix of the XML files counter examples are
+	 * written to, and the number of files written so far */
+	const char * xml_prefix;
+	int n_dumped;
 } options_t;
 
 /* Forward declarations: */
 static Expr_ptr generate_state_eq(Trace_ptr trace, TraceIter iter);
 static Expr_ptr get_inv(Prop_ptr prop);
+static void dump_ce_to_xml(Prop_ptr prop, options_t * options);
 
 /**
  * Debug function to display in a human-readable way the command line options
@@ -36,6 +43,8 @@ static Expr_ptr get_inv(Prop_ptr prop);
 void debug_show_options(const char * fname, const options_t *options) {
 	nextce_debug(5, "%s: Showing options:", fname);
 	nextce_debug(5, "%s: \tprop_num: %d", fname, options->prop_num);
+	nextce_debug(5, "%s: \txml_prefix: %s", fname,
+			options->xml_prefix ? options->xml_prefix : "(none)");
 }
 
 /**
@@ -777,10 +786,16 @@ int resetceDo(const options_t * options) {
  * @return 1
  */
 int NextCEUsage(const char * name) {
-	fprintf(nusmv_stderr, "Usage: %s [-h] [ [ -n index ] | [ -P name ] ]\n", name);
+	boolean compute_all = (strcmp(name, "compute_all") == 0);
+	fprintf(nusmv_stderr, "Usage: %s [-h] [ [ -n index ] | [ -P name ] ]%s\n",
+			name, compute_all ? " [-o prefix]" : "");
 	fprintf(nusmv_stderr, "  -h \t\tPrints this message\n");
 	fprintf(nusmv_stderr, "  -n \t\tDisplay next counter example for property numbered 'index'\n");
 	fprintf(nusmv_stderr, "  -P \t\tDisplay next counter example for property named 'name'\n");
+	if (compute_all) {
+		fprintf(nusmv_stderr, "  -o \t\tWrite each counter example to the XML file 'prefix<N>.xml'\n"
+				"     \t\tas soon as it is found\n");
+	}
 	return 1;
 }
 
@@ -799,10 +814,17 @@ int populateOptions(options_t * options, const char * name, int argc, char ** ar
 	int c;
 	nextce_debug(5, "%s: Enter", fname); 
 	util_getopt_reset();
-	while ((c = util_getopt(argc, argv, "hn:P:")) != EOF) {
+	while ((c = util_getopt(argc, argv, "hn:P:o:")) != EOF) {
 		switch (c) {
 		case 'h':
 			return NextCEUsage(name);
+		case 'o':
+			if ((strcmp(name, "compute_all") != 0) ||
+					(options->xml_prefix != NULL)) {
+				return NextCEUsage(name);
+			}
+			options->xml_prefix = util_optarg;
+			break;
 		case 'n':
 			if (options->prop_num != -1) {
 				return NextCEUsage(name);
@@ -898,9 +920,56 @@ void compuateAllDoOne(Prop_ptr prop, options_t * options) {
 	int rc;
 	do {
 		rc = displayNextCE(prop, options);
+		if ((rc != 0) && (options->xml_prefix != NULL)) {
+			dump_ce_to_xml(prop, options);
+		}
 	} while (rc != 0);
 }
 
+/**
+ * Write the last counter example found for the given property to the XML
+ * file prefix<N>.xml, where N counts the files written by the command.
+ * Counter examples are written as soon as they are found, so that a long
+ * compute_all session can be inspected (or interrupted) without losing the
+ * counter examples found so far.
+ * @param prop The property whose last counter example to write
+ * @param options The command line options structure
+ */
+static void dump_ce_to_xml(Prop_ptr prop, options_t * options) {
+	static const char * fname = __func__;
+	Trace_ptr trace = get_ce(prop);
+	TracePlugin_ptr dumper;
+	TraceOpt_ptr trace_opt;
+	char * filename;
+	FILE * out;
+
+	filename = ALLOC(char, strlen(options->xml_prefix) + 16);
+	sprintf(filename, "%s%d.xml", options->xml_prefix, ++options->n_dumped);
+	nextce_debug(5, "%s: Writing counter example to %s", fname, filename);
+
+	out = fopen(filename, "w");
+	if (out == NULL) {
+		fprintf(nusmv_stderr, "Unable to open file \"%s\" for writing.\n",
+				filename);
+		FREE(filename);
+		return;
+	}
+
+	trace_opt = TraceOpt_create_from_env(OptsHandler_get_instance());
+	TraceOpt_set_output_stream(trace_opt, out);
+	dumper = TRACE_PLUGIN(TraceXmlDumper_create());
+
+	TracePlugin_action(dumper, trace, trace_opt);
+
+	Object_destroy(OBJECT(dumper), NULL);
+	TraceOpt_destroy(trace_opt);
+	fclose(out);
+
+	fprintf(nusmv_stdout, "Counter example %d written to file \"%s\"\n",
+			options->n_dumped, filename);
+	FREE(filename);
+}
+
 /**
  * Select a property according to the command line arguments (1 by name, 1 by
  * number/index, or all properties), and display all its counter examples
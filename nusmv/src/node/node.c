@@ -209,40 +209,12 @@ void node_show_profile_stats(FILE* out)
 ******************************************************************************/
 void free_node(node_ptr node)
 {
-  const unsigned int csize = node_mgr->nodelist_size;
   /* Check whether the node is in the hash. If it is, it should not
      be freed. */
 
   /*if (node->locked) return; */ /* hashed */
 
-  {
-    node_ptr * nodelist;
-    node_ptr looking;
-    unsigned int pos;
-
-    nodelist = node_mgr->nodelist;
-
-    pos = node_hash_fun(node) % csize;
-    looking = nodelist[pos];
-    while ((node_ptr) NULL != looking) {
-      if (node == looking) return;
-#ifdef DEBUG_FREE_NODE
-      /* This tests that entries in the hash position have not
-         been changed.  It might be the case that this test fails
-         if an entry was previously changed by calling setcar or
-         setcdr that should be not used with hashed nodes. */
-      nusmv_assert(node_hash_fun(looking) % csize == pos);
-#endif
-
-#if INSERT_NODE_SORTED
-      /* if sorted, we can exploit the ordering to decide that a
-         node cannot be in the list */
-      if (0 > node_cmp_fun(node, looking)) break; /* found limit */
-#endif
-
-      looking = looking->link;
-    }
-  }
+  if (node_is_hashed(node)) return;
 
   /*
     The node is not in the hash, so it can be freed.
@@ -354,6 +326,54 @@ node_ptr find_node(int type, node_ptr left, node_ptr right)
   return insert_node(&node);
 }
 
+/**Function********************************************************************
+
+  Synopsis           [Checks whether a node is stored in the <tt>node</tt>
+  hash]
+
+  Description        [Returns true if node has been returned by
+  find_node, false if it has been created by new_node (and can then be
+  freed and its address reused). The <tt>node</tt> hash is not
+  changed.]
+
+  SideEffects        [None]
+
+  SeeAlso            [find_node, free_node]
+
+******************************************************************************/
+boolean node_is_hashed(node_ptr node)
+{
+  const unsigned int csize = node_mgr->nodelist_size;
+  node_ptr * nodelist;
+  node_ptr looking;
+  unsigned int pos;
+
+  nodelist = node_mgr->nodelist;
+
+  pos = node_hash_fun(node) % csize;
+  looking = nodelist[pos];
+  while ((node_ptr) NULL != looking) {
+    if (node == looking) return true;
+#ifdef DEBUG_FREE_NODE
+    /* This tests that entries in the hash position have not
+       been changed.  It might be the case that this test fails
+       if an entry was previously changed by calling setcar or
+       setcdr that should be not used with hashed nodes. */
+    nusmv_assert(node_hash_fun(looking) % csize == pos);
+#endif
+
+#if INSERT_NODE_SORTED
+    /* if sorted, we can exploit the ordering to decide that a
+       node cannot be in the list */
+    if (0 > node_cmp_fun(node, looking)) break; /* found limit */
+#endif
+
+    looking = looking->link;
+  }
+
+  return false;
+}
+
 /**Function********************************************************************
 
   Synopsis           [Search the <tt>node</tt> hash for a given node.]
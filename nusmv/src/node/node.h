@@ -208,6 +208,7 @@ EXTERN void node_pkg_init ARGS((void));
 EXTERN void node_pkg_quit ARGS((void));
 
 EXTERN void free_node ARGS((node_ptr));
+EXTERN boolean node_is_hashed ARGS((node_ptr));
 EXTERN void swap_nodes ARGS((node_ptr *, node_ptr *));
 EXTERN int node_is_failure ARGS((node_ptr node));
 EXTERN int node_is_leaf ARGS((node_ptr node));
@@ -86,9 +86,13 @@
 #if NUSMV_HAVE_SOLVER_ZCHAFF
 #define DEFAULT_SAT_SOLVER        "zchaff"
 #else
+#if NUSMV_HAVE_SOLVER_CDCL
+#define DEFAULT_SAT_SOLVER        "Cdcl"
+#else
 #define DEFAULT_SAT_SOLVER        (char*)NULL
 #endif
 #endif
+#endif
 
 #define OPT_USER_POV_NULL_STRING  "" /* user pov of the null string */
 
@@ -103,6 +107,12 @@
 
 #define DEFAULT_BDD_ENCODE_WORD_BITS true
 
+#define DEFAULT_BDD_COMPACTION false
+
+#define DEFAULT_SEXP2BDD_CACHE_SIZE 0
+
+#define DEFAULT_SEXP2BDD_CACHE_SHARED_ONLY false
+
 typedef enum {
   FORWARD,
   BACKWARD,
@@ -350,10 +360,26 @@ EXTERN void set_rbc_inlining_lazy ARGS((OptsHandler_ptr opt));
 EXTERN void unset_rbc_inlining_lazy ARGS((OptsHandler_ptr opt));
 EXTERN boolean opt_rbc_inlining_lazy ARGS((OptsHandler_ptr opt));
 
+EXTERN void set_rbc_rewriting ARGS((OptsHandler_ptr opt));
+EXTERN void unset_rbc_rewriting ARGS((OptsHandler_ptr opt));
+EXTERN boolean opt_rbc_rewriting ARGS((OptsHandler_ptr opt));
+
 EXTERN void set_use_coi_size_sorting ARGS((OptsHandler_ptr opt));
 EXTERN void unset_use_coi_size_sorting ARGS((OptsHandler_ptr opt));
 EXTERN boolean opt_use_coi_size_sorting ARGS((OptsHandler_ptr opt));
 
+EXTERN void set_bdd_compaction ARGS((OptsHandler_ptr opt));
+EXTERN void unset_bdd_compaction ARGS((OptsHandler_ptr opt));
+EXTERN boolean opt_bdd_compaction ARGS((OptsHandler_ptr opt));
+
+EXTERN void set_sexp2bdd_cache_size ARGS((OptsHandler_ptr opt, int size));
+EXTERN void reset_sexp2bdd_cache_size ARGS((OptsHandler_ptr opt));
+EXTERN int get_sexp2bdd_cache_size ARGS((OptsHandler_ptr opt));
+
+EXTERN void set_sexp2bdd_cache_shared_only ARGS((OptsHandler_ptr opt));
+EXTERN void unset_sexp2bdd_cache_shared_only ARGS((OptsHandler_ptr opt));
+EXTERN boolean opt_sexp2bdd_cache_shared_only ARGS((OptsHandler_ptr opt));
+
 EXTERN void opt_disable_syntactic_checks ARGS((OptsHandler_ptr opt));
 EXTERN void opt_enable_syntactic_checks ARGS((OptsHandler_ptr opt));
 EXTERN boolean opt_syntactic_checks_disabled ARGS((OptsHandler_ptr opt));
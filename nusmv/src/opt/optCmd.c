@@ -549,6 +549,10 @@ void init_options()
                                        opt_rbc_inlining_lazy_trigger);
   nusmv_assert(res);
 
+  res = OptsHandler_register_bool_option(opts, RBC_REWRITING,
+                                         false, true);
+  nusmv_assert(res);
+
 #endif
 
   res = OptsHandler_register_option(opts, A_SAT_SOLVER,
@@ -673,6 +677,19 @@ void init_options()
                                          DEFAULT_USE_COI_SIZE_SORTING, true);
   nusmv_assert(res);
 
+  res = OptsHandler_register_bool_option(opts, BDD_COMPACTION,
+                                         DEFAULT_BDD_COMPACTION, true);
+  nusmv_assert(res);
+
+  res = OptsHandler_register_int_option(opts, SEXP2BDD_CACHE_SIZE,
+                                        DEFAULT_SEXP2BDD_CACHE_SIZE, true);
+  nusmv_assert(res);
+
+  res = OptsHandler_register_bool_option(opts, SEXP2BDD_CACHE_SHARED_ONLY,
+                                         DEFAULT_SEXP2BDD_CACHE_SHARED_ONLY,
+                                         true);
+  nusmv_assert(res);
+
   res = OptsHandler_register_bool_option(opts, DISABLE_SYNTACTIC_CHECKS,
                                          false, true);
   nusmv_assert(res);
@@ -1711,6 +1728,23 @@ boolean opt_rbc_inlining_lazy(OptsHandler_ptr opt)
   return OptsHandler_get_bool_option_value(opt, RBC_INLINING_LAZY);
 }
 
+void set_rbc_rewriting(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt, RBC_REWRITING, true);
+  nusmv_assert(res);
+}
+
+void unset_rbc_rewriting(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt, RBC_REWRITING, false);
+  nusmv_assert(res);
+}
+
+boolean opt_rbc_rewriting(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_bool_option_value(opt, RBC_REWRITING);
+}
+
 void set_show_defines_in_traces (OptsHandler_ptr opt)
 {
   boolean res = OptsHandler_set_bool_option_value(opt, SHOW_DEFINES_IN_TRACES,
@@ -1963,6 +1997,66 @@ boolean opt_use_coi_size_sorting(OptsHandler_ptr opt)
   return OptsHandler_get_bool_option_value(opt, USE_COI_SIZE_SORTING);
 }
 
+void set_bdd_compaction(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt, BDD_COMPACTION, true);
+  nusmv_assert(res);
+}
+
+void unset_bdd_compaction(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt, BDD_COMPACTION, false);
+  nusmv_assert(res);
+}
+
+boolean opt_bdd_compaction(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_bool_option_value(opt, BDD_COMPACTION);
+}
+
+/* the budget (in ADD nodes) of the sexp2bdd evaluation cache. A non
+   positive value means the cache is unbounded */
+void set_sexp2bdd_cache_size(OptsHandler_ptr opt, int size)
+{
+  boolean res = OptsHandler_set_int_option_value(opt, SEXP2BDD_CACHE_SIZE,
+                                                 size);
+  nusmv_assert(res);
+}
+
+void reset_sexp2bdd_cache_size(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_reset_option_value(opt, SEXP2BDD_CACHE_SIZE);
+  nusmv_assert(res);
+}
+
+int get_sexp2bdd_cache_size(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_int_option_value(opt, SEXP2BDD_CACHE_SIZE);
+}
+
+/* keeps in the sexp2bdd evaluation cache only expressions which are
+   evaluated more than once */
+void set_sexp2bdd_cache_shared_only(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt,
+                                                  SEXP2BDD_CACHE_SHARED_ONLY,
+                                                  true);
+  nusmv_assert(res);
+}
+
+void unset_sexp2bdd_cache_shared_only(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_set_bool_option_value(opt,
+                                                  SEXP2BDD_CACHE_SHARED_ONLY,
+                                                  false);
+  nusmv_assert(res);
+}
+
+boolean opt_sexp2bdd_cache_shared_only(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_bool_option_value(opt, SEXP2BDD_CACHE_SHARED_ONLY);
+}
+
 
 void opt_disable_syntactic_checks(OptsHandler_ptr opt)
 {
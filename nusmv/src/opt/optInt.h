@@ -140,6 +140,7 @@
 #define SYMB_INLINING "sexp_inlining"
 #define RBC_INLINING "rbc_inlining"
 #define RBC_INLINING_LAZY "rbc_inlining_lazy"
+#define RBC_REWRITING "rbc_rewriting"
 
 #define SHOW_DEFINES_IN_TRACES "traces_show_defines"
 #define SHOW_DEFINES_WITH_NEXT "traces_show_defines_with_next"
@@ -155,6 +156,9 @@
 #define OREG_JUSTICE_EMPTINESS_BDD_ALGORITHM    \
   "oreg_justice_emptiness_bdd_algorithm"
 #define USE_COI_SIZE_SORTING "use_coi_size_sorting"
+#define BDD_COMPACTION "bdd_compaction"
+#define SEXP2BDD_CACHE_SIZE "sexp2bdd_cache_size"
+#define SEXP2BDD_CACHE_SHARED_ONLY "sexp2bdd_cache_shared_only"
 #define BATCH "batch"
 #define QUIET_MODE "quiet_mode"
 #define DISABLE_SYNTACTIC_CHECKS "disable_syntactic_checks"
@@ -943,11 +943,21 @@ void Prop_apply_coi_for_bdd(Prop_ptr self, FsmBuilder_ptr helper)
     applied = true;
   }
 
-  /* bdd fsm */
+  /* bdd fsm. When the scalar fsm is the one of the cone, its
+     transition relation can be assembled out of the atoms of the
+     variables shared by all the cones */
   if (bdd_fsm == BDD_FSM(NULL)) {
-    bdd_fsm = FsmBuilder_create_bdd_fsm(helper, Enc_get_bdd_encoding(),
-                                        scalar_fsm,
+    if (applied) {
+      bdd_fsm = FsmBuilder_create_bdd_fsm_of_cone(helper,
+                                        Enc_get_bdd_encoding(),
+                                        mainFlatHierarchy, scalar_fsm,
                                         get_partition_method(OptsHandler_get_instance()));
+    }
+    else {
+      bdd_fsm = FsmBuilder_create_bdd_fsm(helper, Enc_get_bdd_encoding(),
+                                          scalar_fsm,
+                                          get_partition_method(OptsHandler_get_instance()));
+    }
     prop_set_bdd_fsm(self, bdd_fsm, false); /* does not dup */
     applied = true;
   }
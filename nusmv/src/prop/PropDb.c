@@ -71,6 +71,22 @@ static char rcsid[] UTIL_UNUSED = "$Id: $";
 /* Structure declarations                                                    */
 /*---------------------------------------------------------------------------*/
 
+/**Struct**********************************************************************
+
+  Synopsis    [A property with its cone, as sorted by
+  PropDb_get_ordered_properties]
+
+  Description [entry is the (property . cone) couple returned to the
+  caller, card the cardinality of the cone and index the position of
+  the property within the database.]
+
+******************************************************************************/
+typedef struct PropDbConeEntry_TAG {
+  node_ptr entry;
+  int card;
+  int index;
+} PropDbConeEntry;
+
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
@@ -93,6 +109,9 @@ static char rcsid[] UTIL_UNUSED = "$Id: $";
 
 static void prop_db_finalize ARGS((Object_ptr object, void* dummy));
 
+static int
+prop_db_cone_entry_compare ARGS((const void* a, const void* b));
+
 static int
 prop_db_prop_parse_from_arg_and_add ARGS((PropDb_ptr self,
                                           SymbTable_ptr symb_table,
@@ -1208,7 +1227,7 @@ NodeList_ptr PropDb_get_ordered_properties(const PropDb_ptr self,
 {
   SymbTable_ptr symb_table;
   NodeList_ptr res;
-  int i;
+  int i, size;
 
   PROP_DB_CHECK_INSTANCE(self);
 
@@ -1219,27 +1238,26 @@ NodeList_ptr PropDb_get_ordered_properties(const PropDb_ptr self,
     fprintf(nusmv_stderr, "Ordering properties by COI size\n");
   }
 
-  for (i = 0; i < PropDb_get_size(self); ++i) {
-    Prop_ptr prop = PropDb_get_prop_at_index(self, i);
-    Set_t cone = Prop_compute_cone(prop, hierarchy, symb_table);
-    int card = Set_GiveCardinality(cone);
-    boolean inserted = false;
-    /* Order insert into the list */
-    node_ptr new_entry = cons(NODE_PTR(prop), NODE_PTR(cone));
-
-    ListIter_ptr iter;
-    NODE_LIST_FOREACH(res, iter) {
-      node_ptr entry = NodeList_get_elem_at(res, iter);
-      Set_t entry_cone = (Set_t)cdr(entry);
-
-      if (Set_GiveCardinality(entry_cone) > card) {
-        NodeList_insert_before(res, iter, new_entry);
-        inserted = true;
-        break;
-      }
+  /* cones are all computed first, then sorted by size. Ties keep
+     the order of the database */
+  size = PropDb_get_size(self);
+  if (size > 0) {
+    PropDbConeEntry* entries = ALLOC(PropDbConeEntry, size);
+    nusmv_assert((PropDbConeEntry*) NULL != entries);
+
+    for (i = 0; i < size; ++i) {
+      Prop_ptr prop = PropDb_get_prop_at_index(self, i);
+      Set_t cone = Prop_compute_cone(prop, hierarchy, symb_table);
+
+      entries[i].entry = cons(NODE_PTR(prop), NODE_PTR(cone));
+      entries[i].card = Set_GiveCardinality(cone);
+      entries[i].index = i;
     }
 
-    if (!inserted) NodeList_append(res, new_entry);
+    qsort(entries, size, sizeof(PropDbConeEntry), prop_db_cone_entry_compare);
+
+    for (i = 0; i < size; ++i) NodeList_append(res, entries[i].entry);
+    FREE(entries);
   }
 
   if (opt_verbose_level_ge(OptsHandler_get_instance(), 2)) {
@@ -1569,6 +1587,28 @@ static void prop_db_finalize(Object_ptr object, void* dummy)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Compares two cone entries for sorting]
+
+  Description [Entries are ordered by cone size, then by position
+  within the database]
+
+  SideEffects []
+
+  SeeAlso     [PropDb_get_ordered_properties]
+
+******************************************************************************/
+static int prop_db_cone_entry_compare(const void* a, const void* b)
+{
+  const PropDbConeEntry* e1 = (const PropDbConeEntry*) a;
+  const PropDbConeEntry* e2 = (const PropDbConeEntry*) b;
+
+  if (e1->card != e2->card) return (e1->card < e2->card) ? -1 : 1;
+  return e1->index - e2->index;
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Add a property to the database from an arg structure
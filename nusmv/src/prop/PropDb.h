@@ -187,6 +187,18 @@ PropDb_ordered_verify_all_type ARGS((const PropDb_ptr self,
                                      const FlatHierarchy_ptr hierarchy,
                                      const Prop_Type type));
 
+EXTERN void
+PropDb_scheduled_verify_all_type ARGS((const PropDb_ptr self,
+                                       const FlatHierarchy_ptr hierarchy,
+                                       const Prop_Type type,
+                                       const int slice));
+
+EXTERN void
+PropDb_parallel_verify_all_type ARGS((const PropDb_ptr self,
+                                      const FlatHierarchy_ptr hierarchy,
+                                      const Prop_Type type,
+                                      const int jobs));
+
 EXTERN void PropDb_verify_prop_at_index ARGS((const PropDb_ptr self,
                                               const int index));
 
@@ -54,6 +54,7 @@
 #include "enc/enc.h"
 #include "mc/mc.h"
 
+#include "utils/ucmd.h"
 #include "utils/error.h" /* for CATCH */
 
 
@@ -696,7 +697,7 @@ static int UsageAddProperty()
   or a newly specified property]
 
   CommandArguments   [\[-h\] \[-n number | -P "name"\] | \[(-c | -l | -i | -s | -q )
-  \[-p "formula \[IN context\]"\]\] ]
+  \[-p "formula \[IN context\]"\]\] | \[-S \[-T seconds\]\] | \[-j jobs\] ]
 
   CommandDescription [
   Checks the specified property taken from the property list, or adds
@@ -727,6 +728,29 @@ static int UsageAddProperty()
        <dd> Checks the <tt>formula</tt> specified on the command-line. <BR>
             <tt>context</tt> is the module instance name which the variables
             in <tt>formula</tt> must be evaluated in.
+    <dt> <tt>-S</tt>
+       <dd> Schedules the properties (of the given type, if any) over
+            the available engines. Properties are sorted by an
+            estimate of their cost, based on the size of their cone
+            of influence, on the size of the BDDs of the transition
+            relation of the cone and on their kind. When BMC has been
+            set up, invariants and LTL properties are first given to
+            simulation and to bounded model checking, then invariants
+            to k-induction and to IC3, each attempt being run by a
+            separate process for a limited time. What remains
+            unresolved is verified with BDDs. A line is printed for
+            every resolved property, and a summary table at the end.
+    <dt> <tt>-T seconds</tt>
+       <dd> Sets the time slice of the quick engines when scheduling
+            properties (default 2). Proving engines are given four
+            time slices.
+    <dt> <tt>-j jobs</tt>
+       <dd> Verifies the properties (of the given type, if any) with
+            <tt>jobs</tt> worker processes, which are forked after
+            the model has been built and share it with NuSMV. Each
+            worker takes the properties to verify from a common queue.
+            Results, traces and outputs are reported in the order the
+            properties would be verified sequentially.
   </dl>
   If no property has been specified via <tt>-n</tt> or <tt>-p</tt> or <tt>-P</tt>,
   then all the properties (of a given type) in the property list will be
@@ -744,13 +768,48 @@ int CommandCheckProperty (int argc, char **argv)
   Prop_Type pt = Prop_NoType;
   char* formula = NIL(char);
   char* formula_name = NIL(char);
+  boolean scheduled = false;
+  int slice = -1;
+  int jobs = -1;
 
   util_getopt_reset();
-  while((c = util_getopt(argc, argv, "hn:p:clisqP:")) != EOF){
+  while((c = util_getopt(argc, argv, "hn:p:clisqP:ST:j:")) != EOF){
     switch(c){
     case 'h': return(UsageCheckProperty());
+    case 'j':
+      {
+        if (jobs != -1) return(UsageCheckProperty());
+        if (prop_no != -1 || formula != NIL(char)) {
+          return(UsageCheckProperty());
+        }
+        if (util_str2int(util_optarg, &jobs) != 0 || jobs <= 0) {
+          fprintf(nusmv_stderr,
+                  "Error: \"%s\" is not a valid number of jobs\n", util_optarg);
+          return(1);
+        }
+        break;
+      }
+    case 'S':
+      {
+        if (prop_no != -1 || formula != NIL(char)) {
+          return(UsageCheckProperty());
+        }
+        scheduled = true;
+        break;
+      }
+    case 'T':
+      {
+        if (slice != -1) return(UsageCheckProperty());
+        if (util_str2int(util_optarg, &slice) != 0 || slice <= 0) {
+          fprintf(nusmv_stderr,
+                  "Error: \"%s\" is not a valid time slice\n", util_optarg);
+          return(1);
+        }
+        break;
+      }
     case 'n':
       {
+        if (scheduled || jobs != -1) return(UsageCheckProperty());
         if (pt != Prop_NoType) return(UsageCheckProperty());
         if (formula != NIL(char)) return(UsageCheckProperty());
         if (prop_no != -1) return(UsageCheckProperty());
@@ -768,6 +827,7 @@ int CommandCheckProperty (int argc, char **argv)
         if (formula != NIL(char)) return UsageCheckProperty();
         if (prop_no != -1) return UsageCheckProperty();
         if (formula_name != NIL(char)) return UsageCheckProperty();
+        if (scheduled || jobs != -1) return(UsageCheckProperty());
 
         formula_name = util_strsav(util_optarg);
 
@@ -787,6 +847,7 @@ int CommandCheckProperty (int argc, char **argv)
         if (prop_no != -1) return(UsageCheckProperty());
         if (formula != NIL(char)) return(UsageCheckProperty());
         if (formula_name != NIL(char)) return UsageCheckProperty();
+        if (scheduled || jobs != -1) return(UsageCheckProperty());
 
         formula = util_strsav(util_optarg);
         break;
@@ -836,10 +897,35 @@ int CommandCheckProperty (int argc, char **argv)
     }
   }
   if (argc != util_optind) return(UsageCheckProperty());
+  if (slice != -1 && !scheduled) return(UsageCheckProperty());
+  if (scheduled && jobs != -1) return(UsageCheckProperty());
 
   /* command hierarchy control */
   if (Compile_check_if_model_was_built(nusmv_stderr, false)) return 1;
 
+  if (scheduled) {
+    CATCH {
+      PropDb_scheduled_verify_all_type(PropPkg_get_prop_database(),
+                                       mainFlatHierarchy, pt,
+                                       (slice != -1) ? slice : 2);
+    }
+    FAIL {
+      return(1);
+    }
+    return(0);
+  }
+
+  if (jobs != -1) {
+    CATCH {
+      PropDb_parallel_verify_all_type(PropPkg_get_prop_database(),
+                                      mainFlatHierarchy, pt, jobs);
+    }
+    FAIL {
+      return(1);
+    }
+    return(0);
+  }
+
   if (pt != Prop_NoType) {
     if (formula == NIL(char)) {
       CATCH {
@@ -889,7 +975,8 @@ int CommandCheckProperty (int argc, char **argv)
 static int UsageCheckProperty()
 {
   fprintf(nusmv_stderr, "usage: check_property [-h]\n" \
-          "       [-n number |  -P \"name\"] | [-c | -l | -i | -s | -q [-p \"formula\"]]\n");
+          "       [-n number |  -P \"name\"] | [-c | -l | -i | -s | -q [-p \"formula\"]]\n" \
+          "       [-S [-T seconds] | -j jobs]\n");
   fprintf(nusmv_stderr, "  -h \t\t Prints the command usage.\n");
   fprintf(nusmv_stderr, "  -n number \t Checks property number.\n");
   fprintf(nusmv_stderr, "  -P \"name\" \t Checks property name.\n");
@@ -898,6 +985,9 @@ static int UsageCheckProperty()
   fprintf(nusmv_stderr, "  -i \t\t Checks INVAR properties.\n");
   fprintf(nusmv_stderr, "  -s \t\t Checks PSL properties.\n");
   fprintf(nusmv_stderr, "  -q \t\t Checks COMPUTE properties.\n");
+  fprintf(nusmv_stderr, "  -S \t\t Schedules the properties over the available engines.\n");
+  fprintf(nusmv_stderr, "  -T seconds \t Sets the time slice of scheduled engines.\n");
+  fprintf(nusmv_stderr, "  -j jobs \t Verifies the properties with jobs worker processes.\n");
   fprintf(nusmv_stderr, "  -p \"formula\"\t Checks the given formula.\n");
   return(1);
 }
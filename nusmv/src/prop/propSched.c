@@ -0,0 +1,1563 @@
+/**CFile***********************************************************************
+
+  FileName    [propSched.c]
+
+  PackageName [prop]
+
+  Synopsis    [Scheduled verification of the properties of a PropDb]
+
+  Description [Properties are sorted by an estimate of their cost, and
+  are first given to the quick engines (simulation and bounded model
+  checking), then to the engines which can prove them (induction and
+  IC3), every attempt lasting at most a time slice. The properties
+  which are still unresolved are eventually verified by the BDD based
+  engines.
+
+  Properties can also be verified in parallel, as they would be by
+  PropDb_verify_all, by a pool of worker processes taking them from a
+  shared queue.
+
+  Time sliced attempts and workers are run by child processes, which
+  inherit the encodings and the FSMs of the parent. A child sends back
+  the status of the properties it resolved and the traces it built as
+  XML, along with what it printed.]
+
+  SeeAlso     [PropDb.c]
+
+  Author      [Marco Roveri, Roberto Cavada]
+
+  Copyright   [
+  This file is part of the ``prop'' package of NuSMV version 2.
+  Copyright (C) 2010 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+  Revision    [$Id: $]
+
+******************************************************************************/
+
+#if HAVE_CONFIG_H
+#include "nusmv-config.h"
+#endif
+
+#include "PropDb.h"
+#include "Prop.h"
+#include "propInt.h"
+#include "propPkg.h"
+
+#include "bmc/bmc.h"
+#include "bmc/bmcBitSim.h"
+#include "compile/compile.h"
+#include "compile/symb_table/SymbTable.h"
+#include "enc/enc.h"
+#include "trace/pkg_trace.h"
+#include "trace/TraceManager.h"
+#include "trace/loaders/TraceLoader.h"
+#include "trace/loaders/TraceXmlLoader.h"
+#include "utils/utils.h"
+#include "utils/array.h"
+#include "utils/WorkerPool.h"
+
+/* children send their traces as XML, which the parent must load */
+#if NUSMV_HAVE_LIBEXPAT
+# define PROP_SCHED_HAVE_CHILDREN 1
+#else
+# define PROP_SCHED_HAVE_CHILDREN 0
+#endif
+
+static char rcsid[] UTIL_UNUSED = "$Id: $";
+
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* the time slice of the proving engines is this many time slices */
+#define PROP_SCHED_PROVE_SLICES 4
+
+/* the plugin children print traces with, see TraceManager_init_plugins */
+#define PROP_SCHED_XML_PLUGIN 4
+
+/* the symbols trace languages are made of */
+#define PROP_SCHED_SYMBOLS STT_ALL
+
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/**Enum************************************************************************
+
+  Synopsis    [The engines the scheduler can run]
+
+  Description [Engines are listed in the order they are tried]
+
+******************************************************************************/
+typedef enum PropSchedEngine_TAG {
+  PROP_SCHED_NONE,
+  PROP_SCHED_SIM,
+  PROP_SCHED_BMC,
+  PROP_SCHED_INDUCTION,
+  PROP_SCHED_IC3,
+  PROP_SCHED_BDD
+} PropSchedEngine;
+
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [A property being scheduled]
+
+  Description [trans_size is -1 when the BDD model is not available.
+  engine is the engine which resolved the property, and time the
+  time spent on the property so far, in milliseconds.]
+
+******************************************************************************/
+typedef struct PropSchedEntry_TAG {
+  Prop_ptr prop;
+  int card;
+  int trans_size;
+  double cost;
+  int index;
+  PropSchedEngine engine;
+  long time;
+} PropSchedEntry;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [The report a child sends back for an attempt]
+
+  Description [The report is followed by the answers, then by the
+  traces, then by the text the attempt wrote on the output and on
+  the error streams. An answer is sent for every property whose
+  status, number or trace changed.]
+
+******************************************************************************/
+typedef struct PropSchedReport_TAG {
+  int answers;
+  int traces;
+  long time;
+  long out_size;
+  long err_size;
+} PropSchedReport;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [The outcome of an attempt for a property]
+
+  Description [index is the position of the property within the
+  database, trace the id of its trace within the child]
+
+******************************************************************************/
+typedef struct PropSchedAnswer_TAG {
+  int index;
+  int status;
+  int number;
+  int trace;
+} PropSchedAnswer;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [A trace built by an attempt]
+
+  Description [The header is followed by the positions within the
+  symbol table of the symbols of the language of the trace, then by
+  the XML representation of the trace. As the child prints its traces
+  with the XML plugin, the same representation is found within the
+  text it printed.]
+
+******************************************************************************/
+typedef struct PropSchedTrace_TAG {
+  int id;
+  int symbols;
+  long xml_size;
+} PropSchedTrace;
+
+
+/**Struct**********************************************************************
+
+  Synopsis    [What the child of an attempt is given]
+
+  Description [prop is NULL when the engine works on all the
+  properties at once]
+
+******************************************************************************/
+typedef struct PropSchedJob_TAG {
+  PropDb_ptr db;
+  PropSchedEngine engine;
+  Prop_ptr prop;
+} PropSchedJob;
+
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static Prop_ptr*
+prop_sched_get_queue ARGS((const PropDb_ptr self,
+                           const FlatHierarchy_ptr hierarchy,
+                           const Prop_Type type, int* size));
+
+static void prop_sched_complete ARGS((const PropDb_ptr self, Prop_ptr prop,
+                                      boolean done, char* report,
+                                      long size));
+
+static PropSchedEntry*
+prop_sched_get_entries ARGS((const PropDb_ptr self,
+                             const FlatHierarchy_ptr hierarchy,
+                             const Prop_Type type, int* size));
+
+static int prop_sched_entry_compare ARGS((const void* a, const void* b));
+
+static double prop_sched_get_type_weight ARGS((const Prop_Type type));
+
+static const char* prop_sched_engine_to_string ARGS((PropSchedEngine engine));
+
+static boolean prop_sched_is_sat_available ARGS((boolean forced));
+
+static void prop_sched_print_header ARGS((FILE* out));
+
+static void prop_sched_print_entry ARGS((FILE* out,
+                                         const PropSchedEntry* entry));
+
+static void prop_sched_run_engine ARGS((PropSchedEngine engine,
+                                        Prop_ptr prop));
+
+#if PROP_SCHED_HAVE_CHILDREN
+static boolean prop_sched_attempt ARGS((const PropDb_ptr self,
+                                        PropSchedEngine engine,
+                                        Prop_ptr prop, long slice,
+                                        long* time));
+
+static int prop_sched_run_workers ARGS((const PropDb_ptr self,
+                                        Prop_ptr* queue, int size,
+                                        int jobs, char** reports,
+                                        long* sizes, boolean* done));
+
+static int prop_sched_child ARGS((int worker, int jobs, int fd,
+                                  void* arg));
+
+static int prop_sched_worker ARGS((int worker, int jobs, int reports,
+                                   void* arg));
+
+static char* prop_sched_run_job ARGS((const PropDb_ptr self,
+                                      PropSchedEngine engine,
+                                      Prop_ptr prop, long* size));
+
+static int prop_sched_apply_report ARGS((const PropDb_ptr self,
+                                         const char* data, long size,
+                                         boolean quiet));
+
+static void prop_sched_print_text ARGS((const char* text, long size,
+                                        const char** xmls,
+                                        const long* xml_sizes,
+                                        const int* ids, int traces));
+
+static Trace_ptr prop_sched_load_trace ARGS((const char* xml, long size,
+                                             NodeList_ptr symbols));
+
+static boolean prop_sched_take ARGS((const char** data, const char* end,
+                                     void* buf, size_t bytes));
+#endif
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [Verifies all properties of a given type, scheduling
+  them over the available engines]
+
+  Description        [The unchecked properties of the given type (all of
+  them if type is Prop_NoType) are sorted by an estimate of their
+  cost, which grows with the size of their cone of influence, with
+  the size of the BDDs of the transition relation of the cone and
+  with the kind of the property (invariants are the cheapest, then
+  CTL and COMPUTE, then LTL and PSL properties).
+
+  When BMC has been set up, invariants are first looked for violations
+  by bit-parallel simulation, then invariants and LTL properties are
+  given to bounded model checking up to bmc_length. Invariants which
+  are still unresolved are then given to k-induction and to IC3. Each
+  of these attempts is run by a child process, which is killed after
+  slice seconds (the proving engines are given
+  PROP_SCHED_PROVE_SLICES slices). The properties which are still
+  unresolved are eventually verified by the BDD based engines, to
+  completion.
+
+  A line is printed whenever a property is resolved, and a summary
+  table of all the scheduled properties at the end.
+
+  Traces are sent back by children as XML, so their symbols hidden by
+  the traces hiding prefix are not part of the traces the parent
+  registers. If processes cannot be forked only the BDD based engines
+  are used.]
+
+  SideEffects        [The status and the trace of the properties are
+  set]
+
+  SeeAlso            [PropDb_ordered_verify_all_type]
+
+******************************************************************************/
+void PropDb_scheduled_verify_all_type(const PropDb_ptr self,
+                                      const FlatHierarchy_ptr hierarchy,
+                                      const Prop_Type type,
+                                      const int slice)
+{
+  PropSchedEntry* entries;
+  int size, i;
+  boolean sat;
+  long quick_slice = 1000L * (long) slice;
+
+  PROP_DB_CHECK_INSTANCE(self);
+  nusmv_assert(slice > 0);
+
+  entries = prop_sched_get_entries(self, hierarchy, type, &size);
+  if (0 == size) {
+    FREE(entries);
+    return;
+  }
+
+  fprintf(nusmv_stdout, "-- scheduling %d propert%s, time slice %d s\n",
+          size, (1 == size) ? "y" : "ies", slice);
+  prop_sched_print_header(nusmv_stdout);
+
+#if PROP_SCHED_HAVE_CHILDREN
+  sat = prop_sched_is_sat_available(false);
+
+  /* simulation looks for violations of all the invariants at once */
+  if (prop_sched_is_sat_available(true) &&
+      ((Prop_NoType == type) || (Prop_Invar == type))) {
+    long time = 0;
+
+    if (prop_sched_attempt(self, PROP_SCHED_SIM, PROP(NULL),
+                           quick_slice, &time)) {
+      for (i = 0; i < size; ++i) {
+        if (Prop_Invar != Prop_get_type(entries[i].prop)) continue;
+
+        entries[i].time += time;
+        if (Prop_Unchecked != Prop_get_status(entries[i].prop)) {
+          entries[i].engine = PROP_SCHED_SIM;
+          prop_sched_print_entry(nusmv_stdout, entries + i);
+        }
+      }
+    }
+  }
+
+  /* quick engines first, then the proving ones */
+  if (sat) {
+    static const PropSchedEngine engines[] = {
+      PROP_SCHED_BMC, PROP_SCHED_INDUCTION, PROP_SCHED_IC3
+    };
+    int e;
+
+    for (e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e) {
+      long engine_slice = (PROP_SCHED_BMC == engines[e]) ?
+        quick_slice : PROP_SCHED_PROVE_SLICES * quick_slice;
+
+      for (i = 0; i < size; ++i) {
+        Prop_ptr prop = entries[i].prop;
+        long time = 0;
+
+        if (Prop_Unchecked != Prop_get_status(prop)) continue;
+        if (Prop_Invar != Prop_get_type(prop) &&
+            !(Prop_Ltl == Prop_get_type(prop) &&
+              PROP_SCHED_BMC == engines[e])) continue;
+
+        prop_sched_attempt(self, engines[e], prop, engine_slice, &time);
+        entries[i].time += time;
+
+        if (Prop_Unchecked != Prop_get_status(prop)) {
+          entries[i].engine = engines[e];
+          prop_sched_print_entry(nusmv_stdout, entries + i);
+        }
+      }
+    }
+  }
+#endif
+
+  /* what is left is verified to completion */
+  for (i = 0; i < size; ++i) {
+    Prop_ptr prop = entries[i].prop;
+    long start;
+
+    if (Prop_Unchecked != Prop_get_status(prop)) continue;
+
+    start = util_cpu_time();
+    Prop_verify(prop);
+    entries[i].time += util_cpu_time() - start;
+
+    if (Prop_Unchecked != Prop_get_status(prop)) {
+      entries[i].engine = PROP_SCHED_BDD;
+      prop_sched_print_entry(nusmv_stdout, entries + i);
+    }
+  }
+
+  fprintf(nusmv_stdout, "-- scheduling summary\n");
+  prop_sched_print_header(nusmv_stdout);
+  for (i = 0; i < size; ++i) prop_sched_print_entry(nusmv_stdout, entries + i);
+
+  FREE(entries);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Verifies all properties of a given type, using jobs
+  worker processes]
+
+  Description        [The unchecked properties of the given type (all of
+  them if type is Prop_NoType) are verified in the same order and
+  with the same engines as PropDb_verify_all_type (or
+  PropDb_ordered_verify_all_type when properties are sorted by COI
+  size) would, but by a pool of jobs worker processes forked after the
+  model has been built. Workers inherit the encodings and the FSMs of
+  the parent, take properties from a shared queue and send back their
+  status and their traces as XML.
+
+  The results and the outputs are applied and printed in the order the
+  properties would be verified sequentially, and the parent registers
+  the traces, so that the outcome is the same as the sequential
+  verification (but for the symbols hidden by the traces hiding
+  prefix, which are not part of the traces). The properties which
+  cannot be given to a worker are verified by the parent.]
+
+  SideEffects        [The status and the trace of the properties are
+  set]
+
+  SeeAlso            [PropDb_verify_all_type, PropDb_ordered_verify_all_type]
+
+******************************************************************************/
+void PropDb_parallel_verify_all_type(const PropDb_ptr self,
+                                     const FlatHierarchy_ptr hierarchy,
+                                     const Prop_Type type,
+                                     const int jobs)
+{
+  Prop_ptr* queue;
+  char** reports;
+  long* report_sizes;
+  boolean* done;
+  int size, applied, i;
+
+  PROP_DB_CHECK_INSTANCE(self);
+  nusmv_assert(jobs > 0);
+
+  queue = prop_sched_get_queue(self, hierarchy, type, &size);
+
+  reports = ALLOC(char*, size + 1);
+  report_sizes = ALLOC(long, size + 1);
+  done = ALLOC(boolean, size + 1);
+  for (i = 0; i < size; ++i) {
+    reports[i] = (char*) NULL;
+    report_sizes[i] = 0;
+    done[i] = false;
+  }
+
+  applied = 0;
+#if PROP_SCHED_HAVE_CHILDREN
+  if (jobs > 1 && size > 1) {
+    applied = prop_sched_run_workers(self, queue, size, jobs,
+                                     reports, report_sizes, done);
+  }
+#endif
+
+  /* what the workers could not take is verified here */
+  for (; applied < size; ++applied) {
+    prop_sched_complete(self, queue[applied], done[applied],
+                        reports[applied], report_sizes[applied]);
+  }
+
+  FREE(done);
+  FREE(report_sizes);
+  FREE(reports);
+  FREE(queue);
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the unchecked properties of the given type, in
+  the order they are verified sequentially]
+
+  Description [See PropDb_verify_all and PropDb_ordered_verify_all.
+  The number of returned properties is written in size. Returned array
+  must be freed by the caller.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static Prop_ptr* prop_sched_get_queue(const PropDb_ptr self,
+                                      const FlatHierarchy_ptr hierarchy,
+                                      const Prop_Type type, int* size)
+{
+  Prop_ptr* res;
+
+  res = ALLOC(Prop_ptr, PropDb_get_size(self) + 1);
+  nusmv_assert((Prop_ptr*) NULL != res);
+
+  *size = 0;
+  if (opt_use_coi_size_sorting(OptsHandler_get_instance())) {
+    NodeList_ptr list = PropDb_get_ordered_properties(self, hierarchy);
+    ListIter_ptr iter;
+
+    NODE_LIST_FOREACH(list, iter) {
+      node_ptr couple = NodeList_get_elem_at(list, iter);
+      Prop_ptr prop = PROP(car(couple));
+
+      if (((Prop_NoType == type) || (Prop_get_type(prop) == type)) &&
+          Prop_Unchecked == Prop_get_status(prop)) {
+        res[(*size)++] = prop;
+      }
+
+      Set_ReleaseSet((Set_t) cdr(couple));
+      free_node(couple);
+    }
+
+    NodeList_destroy(list);
+  }
+  else {
+    /* the same order of prop_db_verify_all */
+    static const Prop_Type types[] = {
+      Prop_Ctl, Prop_Compute, Prop_Ltl, Prop_Psl, Prop_Invar
+    };
+    int t, i;
+
+    for (t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+      if ((Prop_NoType != type) && (types[t] != type)) continue;
+
+      for (i = 0; i < PropDb_get_size(self); ++i) {
+        Prop_ptr prop = PropDb_get_prop_at_index(self, i);
+
+        if (Prop_get_type(prop) == types[t] &&
+            Prop_Unchecked == Prop_get_status(prop)) {
+          res[(*size)++] = prop;
+        }
+      }
+    }
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Completes the verification of a property of the queue]
+
+  Description [If done is false the property is verified here,
+  otherwise the report a worker built for it (if any) is applied.]
+
+  SideEffects []
+
+  SeeAlso     [PropDb_parallel_verify_all_type]
+
+******************************************************************************/
+static void prop_sched_complete(const PropDb_ptr self, Prop_ptr prop,
+                                boolean done, char* report, long size)
+{
+  if (!done) Prop_verify(prop);
+#if PROP_SCHED_HAVE_CHILDREN
+  else if ((char*) NULL != report) {
+    prop_sched_apply_report(self, report, size, false);
+    FREE(report);
+  }
+#endif
+  else {
+    fflush(nusmv_stdout);
+    fprintf(nusmv_stderr,
+            "Error: the worker verifying property %d terminated "
+            "unexpectedly\n", Prop_get_index(prop));
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the unchecked properties of the given type,
+  sorted by cost]
+
+  Description [The number of returned entries is written in size.
+  Returned array must be freed by the caller.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static PropSchedEntry* prop_sched_get_entries(const PropDb_ptr self,
+                                              const FlatHierarchy_ptr hierarchy,
+                                              const Prop_Type type,
+                                              int* size)
+{
+  SymbTable_ptr symb_table = FlatHierarchy_get_symb_table(hierarchy);
+  boolean bdd = cmp_struct_get_build_model(cmps);
+  PropSchedEntry* res;
+  int i;
+
+  res = ALLOC(PropSchedEntry, PropDb_get_size(self) + 1);
+  nusmv_assert((PropSchedEntry*) NULL != res);
+
+  *size = 0;
+  for (i = 0; i < PropDb_get_size(self); ++i) {
+    Prop_ptr prop = PropDb_get_prop_at_index(self, i);
+    PropSchedEntry* entry;
+    Set_t cone;
+
+    if ((Prop_NoType != type) && (Prop_get_type(prop) != type)) continue;
+    if (Prop_Unchecked != Prop_get_status(prop)) continue;
+
+    entry = res + *size;
+    cone = Prop_compute_cone(prop, hierarchy, symb_table);
+
+    entry->prop = prop;
+    entry->card = Set_GiveCardinality(cone);
+    entry->trans_size = bdd ?
+      FsmBuilder_get_trans_size_of_vars(global_fsm_builder,
+                                        Enc_get_bdd_encoding(),
+                                        hierarchy, cone) : -1;
+    entry->cost = prop_sched_get_type_weight(Prop_get_type(prop)) *
+      (double) (entry->card + ((entry->trans_size > 0) ? entry->trans_size : 0));
+    entry->index = i;
+    entry->engine = PROP_SCHED_NONE;
+    entry->time = 0;
+
+    Set_ReleaseSet(cone);
+    ++(*size);
+  }
+
+  qsort(res, *size, sizeof(PropSchedEntry), prop_sched_entry_compare);
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Compares two entries for sorting]
+
+  Description [Entries are ordered by cost, then by position within
+  the database]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int prop_sched_entry_compare(const void* a, const void* b)
+{
+  const PropSchedEntry* e1 = (const PropSchedEntry*) a;
+  const PropSchedEntry* e2 = (const PropSchedEntry*) b;
+
+  if (e1->cost != e2->cost) return (e1->cost < e2->cost) ? -1 : 1;
+  return e1->index - e2->index;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns how much the kind of a property weights on its
+  cost]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static double prop_sched_get_type_weight(const Prop_Type type)
+{
+  switch (type) {
+  case Prop_Invar: return 1.0;
+  case Prop_Ctl:
+  case Prop_Compute: return 2.0;
+  case Prop_Ltl:
+  case Prop_Psl: return 4.0;
+  default: return 1.0;
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the name of an engine]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static const char* prop_sched_engine_to_string(PropSchedEngine engine)
+{
+  switch (engine) {
+  case PROP_SCHED_NONE: return "-";
+  case PROP_SCHED_SIM: return "sim";
+  case PROP_SCHED_BMC: return "bmc";
+  case PROP_SCHED_INDUCTION: return "induction";
+  case PROP_SCHED_IC3: return "ic3";
+  case PROP_SCHED_BDD: return "bdd";
+  default: error_unreachable_code();
+  }
+
+  return "";
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether the SAT based engines can be run]
+
+  Description [See Bmc_check_if_model_was_built, which however prints
+  error messages. When forced is true, the master BE FSM is required
+  to be built]
+
+  SideEffects []
+
+  SeeAlso     [Bmc_check_if_model_was_built]
+
+******************************************************************************/
+static boolean prop_sched_is_sat_available(boolean forced)
+{
+  if (cmp_struct_get_bmc_setup(cmps)) return true;
+
+  return !forced && cmp_struct_get_bmc_init(cmps) &&
+    opt_cone_of_influence(OptsHandler_get_instance());
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Prints the header of the scheduling table]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [prop_sched_print_entry]
+
+******************************************************************************/
+static void prop_sched_print_header(FILE* out)
+{
+  fprintf(out, "-- %5s %-12s %6s %8s %10s %-10s %-10s %9s\n",
+          "#", "type", "cone", "trans", "cost", "engine", "status",
+          "time (s)");
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Prints a row of the scheduling table]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [prop_sched_print_header]
+
+******************************************************************************/
+static void prop_sched_print_entry(FILE* out, const PropSchedEntry* entry)
+{
+  fprintf(out, "-- %5d %-12s %6d ", entry->index,
+          PropType_to_string(Prop_get_type(entry->prop)), entry->card);
+
+  if (entry->trans_size < 0) fprintf(out, "%8s ", "-");
+  else fprintf(out, "%8d ", entry->trans_size);
+
+  fprintf(out, "%10.0f %-10s %-10s %9.2f\n", entry->cost,
+          prop_sched_engine_to_string(entry->engine),
+          Prop_get_status_as_string(entry->prop),
+          (double) entry->time / 1000.0);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Runs an engine on a property]
+
+  Description [Simulation ignores the property, and is run on all the
+  invariants.]
+
+  SideEffects [The status and the trace of the property are set]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void prop_sched_run_engine(PropSchedEngine engine, Prop_ptr prop)
+{
+  OptsHandler_ptr opts = OptsHandler_get_instance();
+  int k = get_bmc_pb_length(opts);
+
+  switch (engine) {
+  case PROP_SCHED_SIM:
+    Bmc_BitSimulate(PropDb_master_get_be_fsm(PropPkg_get_prop_database()),
+                    get_default_simulation_steps(opts), 1);
+    break;
+
+  case PROP_SCHED_BMC:
+    if (Prop_Ltl == Prop_get_type(prop)) {
+      Bmc_GenSolveLtl(prop, k,
+                      Bmc_Utils_ConvertLoopFromString(get_bmc_pb_loop(opts),
+                                                      NULL),
+                      true, /* iterate on k */
+                      true, /* solve */
+                      BMC_DUMP_NONE, (const char*) NULL);
+    }
+    else {
+#if NUSMV_HAVE_INCREMENTAL_SAT
+      Bmc_GenSolveInvarFalsification(prop, k);
+#else
+      Bmc_GenSolveInvar_EenSorensson(prop, k, BMC_DUMP_NONE,
+                                     (const char*) NULL, false);
+#endif
+    }
+    break;
+
+  case PROP_SCHED_INDUCTION:
+    Bmc_GenSolveInvar_EenSorensson(prop, k, BMC_DUMP_NONE,
+                                   (const char*) NULL, false);
+    break;
+
+  case PROP_SCHED_IC3:
+    Bmc_GenSolveInvarIc3(prop, k, (const char*) NULL);
+    break;
+
+  case PROP_SCHED_BDD:
+    Prop_verify(prop);
+    break;
+
+  default: error_unreachable_code();
+  }
+}
+
+
+#if PROP_SCHED_HAVE_CHILDREN
+
+/**Function********************************************************************
+
+  Synopsis    [Runs an engine on a property within a child process]
+
+  Description [The child is killed if it does not answer within slice
+  milliseconds. The time the attempt took is written in time.
+  Returns true if the report of the child was received, in which case
+  the properties it resolved are updated, and the traces it built are
+  registered.
+
+  What the attempt printed is printed only if it resolved some
+  property, or if verbose is enabled.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean prop_sched_attempt(const PropDb_ptr self,
+                                  PropSchedEngine engine,
+                                  Prop_ptr prop, long slice, long* time)
+{
+  PropSchedJob job;
+  WorkerPool_ptr pool;
+  long size = -1;
+  char* data = (char*) NULL;
+  boolean res = false;
+
+  job.db = self;
+  job.engine = engine;
+  job.prop = prop;
+
+  pool = WorkerPool_create(1, false, prop_sched_child, &job);
+  if (!WorkerPool_is_running(pool, 0)) {
+    WorkerPool_destroy(pool);
+    *time = 0;
+    return false;
+  }
+
+  *time = slice;
+
+  /* once started, the report is read to its end */
+  if (0 == WorkerPool_wait_any(pool, slice) &&
+      WorkerPool_receive(pool, 0, &size, sizeof(size)) &&
+      size >= (long) sizeof(PropSchedReport)) {
+    data = ALLOC(char, size);
+    if (!WorkerPool_receive(pool, 0, data, size)) {
+      FREE(data);
+      data = (char*) NULL;
+    }
+  }
+
+  WorkerPool_destroy(pool);
+
+  if ((char*) NULL != data) {
+    PropSchedReport report;
+
+    memcpy(&report, data, sizeof(report));
+    *time = report.time;
+
+    res = true;
+    if (0 == prop_sched_apply_report(self, data, size, true) &&
+        opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+      fflush(nusmv_stdout);
+      fprintf(nusmv_stderr, "-- %s did not resolve the propert%s\n",
+              prop_sched_engine_to_string(engine),
+              (PROP(NULL) == prop) ? "ies" : "y");
+    }
+
+    FREE(data);
+  }
+  else if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    fflush(nusmv_stdout);
+    fprintf(nusmv_stderr, "-- %s did not answer within %.2f s\n",
+            prop_sched_engine_to_string(engine), (double) slice / 1000.0);
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Verifies the properties of the queue by a pool of worker
+  processes]
+
+  Description [At most jobs workers are forked, each taking the
+  properties of the queue one at a time. reports, sizes and done are
+  filled with what workers send back (reports of workers which
+  terminated unexpectedly are NULL), and reports are applied as soon
+  as all the properties preceding them in the queue are done. Returns
+  the number of properties which were completed, the remaining ones
+  having not been taken by any worker.]
+
+  SideEffects []
+
+  SeeAlso     [prop_sched_worker]
+
+******************************************************************************/
+static int prop_sched_run_workers(const PropDb_ptr self, Prop_ptr* queue,
+                                  int size, int jobs, char** reports,
+                                  long* sizes, boolean* done)
+{
+  int workers = (jobs < size) ? jobs : size;
+  WorkerPool_ptr pool = WorkerPool_create(workers, true, prop_sched_worker,
+                                          self);
+  int* busy = ALLOC(int, workers);
+  int next = 0;
+  int applied = 0;
+  int w;
+
+  for (w = 0; w < workers; ++w) busy[w] = -1;
+
+  while (applied < size) {
+    long report_size = -1;
+    int pos;
+
+    /* idle workers are given the next property, or released */
+    for (w = 0; w < workers; ++w) {
+      if (busy[w] >= 0 || !WorkerPool_is_running(pool, w)) continue;
+
+      if (next < size) {
+        int index = Prop_get_index(queue[next]);
+
+        if (WorkerPool_send(pool, w, &index, sizeof(index))) {
+          busy[w] = next++;
+        }
+      }
+      else WorkerPool_release(pool, w);
+    }
+
+    /* no worker is left */
+    w = WorkerPool_wait_any(pool, -1);
+    if (w < 0) break;
+
+    pos = busy[w];
+    busy[w] = -1;
+    if (pos < 0) {
+      WorkerPool_release(pool, w);
+      continue;
+    }
+
+    /* a worker which fails to send its report is released */
+    if (WorkerPool_receive(pool, w, &report_size, sizeof(report_size))) {
+      if (report_size >= (long) sizeof(PropSchedReport)) {
+        reports[pos] = ALLOC(char, report_size);
+
+        if (WorkerPool_receive(pool, w, reports[pos], report_size)) {
+          sizes[pos] = report_size;
+        }
+        else {
+          FREE(reports[pos]);
+          reports[pos] = (char*) NULL;
+        }
+      }
+      else if (0 != report_size) WorkerPool_release(pool, w);
+    }
+
+    done[pos] = true;
+
+    /* reports are applied in the order properties are in the queue */
+    while (applied < size && done[applied]) {
+      prop_sched_complete(self, queue[applied], true,
+                          reports[applied], sizes[applied]);
+      reports[applied] = (char*) NULL;
+      ++applied;
+    }
+  }
+
+  WorkerPool_destroy(pool);
+  FREE(busy);
+
+  return applied;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [The body of the child of an attempt]
+
+  Description [Runs the engine of the job given as arg on its
+  property, then writes the report on fd as the size of the report
+  followed by the report itself. Returns the exit status of the
+  child.]
+
+  SideEffects []
+
+  SeeAlso     [prop_sched_attempt, prop_sched_run_job]
+
+******************************************************************************/
+static int prop_sched_child(int worker, int jobs, int fd, void* arg)
+{
+  PropSchedJob* job = (PropSchedJob*) arg;
+  long size;
+  char* data = prop_sched_run_job(job->db, job->engine, job->prop, &size);
+  boolean sent = ((char*) NULL != data) &&
+    WorkerPool_write_exactly(fd, &size, sizeof(size)) &&
+    WorkerPool_write_exactly(fd, data, size);
+
+  return sent ? 0 : 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [The body of a worker process]
+
+  Description [Repeatedly reads from jobs the position within the
+  database given as arg of a property, verifies the property and
+  writes the report on reports, as the size of the report followed by
+  the report itself. A size of zero is written if the report could not
+  be built. The worker terminates when jobs is closed. Returns the exit
+  status of the worker.]
+
+  SideEffects []
+
+  SeeAlso     [PropDb_parallel_verify_all_type, prop_sched_run_job]
+
+******************************************************************************/
+static int prop_sched_worker(int worker, int jobs, int reports, void* arg)
+{
+  PropDb_ptr self = PROP_DB(arg);
+  int index;
+
+  while (WorkerPool_read_exactly(jobs, &index, sizeof(index))) {
+    long size = 0;
+    char* data = (char*) NULL;
+
+    if (0 <= index && index < PropDb_get_size(self)) {
+      data = prop_sched_run_job(self, PROP_SCHED_BDD,
+                                PropDb_get_prop_at_index(self, index), &size);
+    }
+    if ((char*) NULL == data) size = 0;
+
+    if (!WorkerPool_write_exactly(reports, &size, sizeof(size)) ||
+        (size > 0 && !WorkerPool_write_exactly(reports, data, size))) {
+      return 1;
+    }
+    if ((char*) NULL != data) FREE(data);
+  }
+
+  return 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Runs an engine on a property, and builds the report of
+  the run]
+
+  Description [The output of the engine is captured, and traces are
+  printed as XML. The size of the report is written in size. Returns
+  NULL if the report could not be built, otherwise the returned
+  buffer must be freed by the caller.]
+
+  SideEffects [Output streams are restored, but the default plugin of
+  the trace manager is left to the XML one]
+
+  SeeAlso     [prop_sched_apply_report]
+
+******************************************************************************/
+static char* prop_sched_run_job(const PropDb_ptr self,
+                                PropSchedEngine engine,
+                                Prop_ptr prop, long* data_size)
+{
+  TraceManager_ptr tm = TracePkg_get_global_trace_manager();
+  SymbTable_ptr st = Compile_get_global_symb_table();
+  FILE* out = WorkerPool_open_capture();
+  FILE* err = WorkerPool_open_capture();
+  FILE* report_file = WorkerPool_open_capture();
+  FILE* old_out = nusmv_stdout;
+  FILE* old_err = nusmv_stderr;
+  int size = PropDb_get_size(self);
+  Prop_Status* statuses;
+  int* numbers;
+  int* traces;
+  int first_trace, i;
+  PropSchedReport report;
+  char* out_text;
+  char* err_text;
+  char* data;
+
+  if (NIL(FILE) == out || NIL(FILE) == err || NIL(FILE) == report_file) {
+    if (NIL(FILE) != out) fclose(out);
+    if (NIL(FILE) != err) fclose(err);
+    if (NIL(FILE) != report_file) fclose(report_file);
+    return (char*) NULL;
+  }
+
+  statuses = ALLOC(Prop_Status, size + 1);
+  numbers = ALLOC(int, size + 1);
+  traces = ALLOC(int, size + 1);
+  for (i = 0; i < size; ++i) {
+    Prop_ptr p = PropDb_get_prop_at_index(self, i);
+    statuses[i] = Prop_get_status(p);
+    numbers[i] = Prop_get_number(p);
+    traces[i] = Prop_get_trace(p);
+  }
+  first_trace = TraceManager_get_size(tm);
+
+  /* everything the engine prints is captured, traces as XML */
+  nusmv_stdout = out;
+  nusmv_stderr = err;
+  TraceManager_set_default_plugin(tm, PROP_SCHED_XML_PLUGIN);
+
+  report.time = util_cpu_time();
+  CATCH {
+    prop_sched_run_engine(engine, prop);
+  }
+  FAIL {
+    fprintf(nusmv_stderr, "-- %s failed\n",
+            prop_sched_engine_to_string(engine));
+  }
+  report.time = util_cpu_time() - report.time;
+
+  out_text = WorkerPool_read_capture(out, &report.out_size);
+  err_text = WorkerPool_read_capture(err, &report.err_size);
+
+  report.answers = 0;
+  for (i = 0; i < size; ++i) {
+    Prop_ptr p = PropDb_get_prop_at_index(self, i);
+    if (statuses[i] != Prop_get_status(p) ||
+        numbers[i] != Prop_get_number(p) ||
+        traces[i] != Prop_get_trace(p)) ++report.answers;
+  }
+  report.traces = TraceManager_get_size(tm) - first_trace;
+
+  fwrite(&report, sizeof(report), 1, report_file);
+
+  for (i = 0; i < size; ++i) {
+    Prop_ptr p = PropDb_get_prop_at_index(self, i);
+    PropSchedAnswer answer;
+
+    if (statuses[i] == Prop_get_status(p) &&
+        numbers[i] == Prop_get_number(p) &&
+        traces[i] == Prop_get_trace(p)) continue;
+
+    answer.index = i;
+    answer.status = (int) Prop_get_status(p);
+    answer.number = Prop_get_number(p);
+    answer.trace = Prop_get_trace(p);
+    fwrite(&answer, sizeof(answer), 1, report_file);
+  }
+
+  if (report.traces > 0) {
+    hash_ptr positions = new_assoc();
+    SymbTableIter iter;
+    int pos = 0;
+
+    SYMB_TABLE_FOREACH(st, iter, PROP_SCHED_SYMBOLS) {
+      insert_assoc(positions, SymbTable_iter_get_symbol(st, &iter),
+                   PTR_FROM_INT(node_ptr, ++pos));
+    }
+
+    for (i = first_trace; i < TraceManager_get_size(tm); ++i) {
+      Trace_ptr trace = TraceManager_get_trace_at_index(tm, i);
+      NodeList_ptr symbols = Trace_get_symbols(trace);
+      PropSchedTrace header;
+      ListIter_ptr liter;
+      char* xml;
+
+      /* the same representation the trace was printed with */
+      nusmv_stdout = out;
+      TraceManager_execute_plugin(tm, TRACE_OPT(NULL),
+                                  PROP_SCHED_XML_PLUGIN, i);
+      xml = WorkerPool_read_capture(out, &header.xml_size);
+
+      header.id = Trace_get_id(trace);
+      header.symbols = 0;
+      NODE_LIST_FOREACH(symbols, liter) {
+        if (Nil != find_assoc(positions,
+                              NodeList_get_elem_at(symbols, liter))) {
+          ++header.symbols;
+        }
+      }
+
+      fwrite(&header, sizeof(header), 1, report_file);
+      NODE_LIST_FOREACH(symbols, liter) {
+        node_ptr p = find_assoc(positions,
+                                NodeList_get_elem_at(symbols, liter));
+        if (Nil != p) {
+          int position = PTR_TO_INT(p) - 1;
+          fwrite(&position, sizeof(position), 1, report_file);
+        }
+      }
+      fwrite(xml, 1, header.xml_size, report_file);
+      FREE(xml);
+    }
+
+    free_assoc(positions);
+  }
+
+  fwrite(out_text, 1, report.out_size, report_file);
+  fwrite(err_text, 1, report.err_size, report_file);
+
+  data = WorkerPool_read_capture(report_file, data_size);
+
+  nusmv_stdout = old_out;
+  nusmv_stderr = old_err;
+
+  fclose(report_file);
+  fclose(err);
+  fclose(out);
+  FREE(err_text);
+  FREE(out_text);
+  FREE(traces);
+  FREE(numbers);
+  FREE(statuses);
+
+  return data;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Applies the report of a child]
+
+  Description [The traces of the report are loaded and registered,
+  then what the child printed is printed, and the properties the child
+  resolved are updated. If quiet is true, the output of a child which
+  resolved nothing is printed only when verbose is enabled. Returns
+  the number of properties which were updated.]
+
+  SideEffects []
+
+  SeeAlso     [prop_sched_child]
+
+******************************************************************************/
+static int prop_sched_apply_report(const PropDb_ptr self,
+                                   const char* data, long size,
+                                   boolean quiet)
+{
+  TraceManager_ptr tm = TracePkg_get_global_trace_manager();
+  SymbTable_ptr st = Compile_get_global_symb_table();
+  const char* end = data + size;
+  PropSchedReport report;
+  PropSchedAnswer* answers;
+  const char** xmls;
+  long* xml_sizes;
+  int* child_ids;
+  int* ids;
+  array_t* symbols = (array_t*) NULL;
+  int i, res = 0;
+
+  prop_sched_take(&data, end, &report, sizeof(report));
+  if (report.answers < 0 || report.traces < 0) return 0;
+
+  answers = ALLOC(PropSchedAnswer, report.answers + 1);
+  xmls = ALLOC(const char*, report.traces + 1);
+  xml_sizes = ALLOC(long, report.traces + 1);
+  child_ids = ALLOC(int, report.traces + 1);
+  ids = ALLOC(int, report.traces + 1);
+
+  for (i = 0; i < report.answers; ++i) {
+    if (!prop_sched_take(&data, end, answers + i, sizeof(PropSchedAnswer))) {
+      report.answers = i;
+      report.traces = 0;
+      break;
+    }
+  }
+
+  /* the languages of the traces are rebuilt out of the positions of
+     their symbols within the symbol table */
+  if (report.traces > 0) {
+    SymbTableIter iter;
+
+    symbols = array_alloc(node_ptr, 0);
+    SYMB_TABLE_FOREACH(st, iter, PROP_SCHED_SYMBOLS) {
+      array_insert_last(node_ptr, symbols, SymbTable_iter_get_symbol(st, &iter));
+    }
+  }
+
+  for (i = 0; i < report.traces; ++i) {
+    PropSchedTrace header;
+    NodeList_ptr language;
+    Trace_ptr trace;
+    int j;
+
+    if (!prop_sched_take(&data, end, &header, sizeof(header)) ||
+        header.symbols < 0 || header.xml_size < 0) {
+      report.traces = i;
+      break;
+    }
+
+    language = NodeList_create();
+    for (j = 0; j < header.symbols; ++j) {
+      int position;
+      if (prop_sched_take(&data, end, &position, sizeof(position)) &&
+          0 <= position && position < array_n(symbols)) {
+        NodeList_append(language, array_fetch(node_ptr, symbols, position));
+      }
+    }
+
+    if (data + header.xml_size > end) {
+      NodeList_destroy(language);
+      report.traces = i;
+      break;
+    }
+
+    xmls[i] = data;
+    xml_sizes[i] = header.xml_size;
+    child_ids[i] = header.id;
+    data += header.xml_size;
+
+    trace = prop_sched_load_trace(xmls[i], xml_sizes[i], language);
+    ids[i] = (TRACE(NULL) != trace) ?
+      TraceManager_register_trace(tm, trace) + 1 : 0;
+
+    NodeList_destroy(language);
+  }
+
+  if (report.out_size >= 0 && report.err_size >= 0 &&
+      data + report.out_size + report.err_size <= end) {
+    fflush(nusmv_stdout);
+    fwrite(data + report.out_size, 1, report.err_size, nusmv_stderr);
+
+    /* what is printed by an attempt which resolved nothing is noise */
+    if (!quiet || report.answers > 0 ||
+        opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+      prop_sched_print_text(data, report.out_size, xmls, xml_sizes, ids,
+                            report.traces);
+    }
+  }
+
+  for (i = 0; i < report.answers; ++i) {
+    Prop_ptr prop;
+    int j;
+
+    if (answers[i].index < 0 || answers[i].index >= PropDb_get_size(self)) {
+      continue;
+    }
+
+    prop = PropDb_get_prop_at_index(self, answers[i].index);
+    Prop_set_status(prop, (Prop_Status) answers[i].status);
+    Prop_set_number(prop, answers[i].number);
+
+    /* traces which were not built by the child keep their id */
+    for (j = 0; j < report.traces; ++j) {
+      if (child_ids[j] == answers[i].trace) {
+        answers[i].trace = ids[j];
+        break;
+      }
+    }
+    Prop_set_trace(prop, answers[i].trace);
+    ++res;
+  }
+
+  if ((array_t*) NULL != symbols) array_free(symbols);
+  FREE(ids);
+  FREE(child_ids);
+  FREE(xml_sizes);
+  FREE(xmls);
+  FREE(answers);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Prints the output of a child]
+
+  Description [The traces the child printed as XML are printed again
+  with the default plugin, as the traces registered by the parent
+  with the given ids.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void prop_sched_print_text(const char* text, long size,
+                                  const char** xmls, const long* xml_sizes,
+                                  const int* ids, int traces)
+{
+  TraceManager_ptr tm = TracePkg_get_global_trace_manager();
+  boolean* printed = ALLOC(boolean, traces + 1);
+  long start = 0;
+  long i = 0;
+  int j;
+
+  for (j = 0; j < traces; ++j) printed[j] = false;
+
+  while (i < size) {
+    boolean found = false;
+
+    /* traces are looked for at the beginning of lines */
+    if (i == 0 || text[i - 1] == '\n') {
+      for (j = 0; j < traces; ++j) {
+        if (!printed[j] && 0 < ids[j] && xml_sizes[j] > 0 &&
+            i + xml_sizes[j] <= size &&
+            0 == memcmp(text + i, xmls[j], xml_sizes[j])) {
+          found = true;
+          break;
+        }
+      }
+    }
+
+    if (found) {
+      fwrite(text + start, 1, i - start, nusmv_stdout);
+      TraceManager_execute_plugin(tm, TRACE_OPT(NULL),
+                                  TRACE_MANAGER_DEFAULT_PLUGIN, ids[j] - 1);
+      printed[j] = true;
+      i += xml_sizes[j];
+      start = i;
+    }
+    else ++i;
+  }
+
+  fwrite(text + start, 1, size - start, nusmv_stdout);
+  FREE(printed);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Loads a trace out of its XML representation]
+
+  Description [The trace is given the language made of symbols.
+  Returns NULL if the trace cannot be loaded.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static Trace_ptr prop_sched_load_trace(const char* xml, long size,
+                                       NodeList_ptr symbols)
+{
+  char* name = Utils_get_temp_filename_in_dir((const char*) NULL,
+                                              "NuSMVXXXXXX");
+  Trace_ptr res = TRACE(NULL);
+  FILE* file;
+
+  if ((char*) NULL == name) return TRACE(NULL);
+
+  file = fopen(name, "w");
+  if (NIL(FILE) != file) {
+    boolean written = (fwrite(xml, 1, size, file) == (size_t) size);
+
+    if (0 == fclose(file) && written) {
+      TraceXmlLoader_ptr loader = TraceXmlLoader_create(name, false, false);
+
+      res = TraceLoader_load_trace(TRACE_LOADER(loader),
+                                   Compile_get_global_symb_table(), symbols);
+      Object_destroy(OBJECT(loader), NULL);
+    }
+  }
+
+  remove(name);
+  FREE(name);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Copies bytes bytes out of a report, advancing *data]
+
+  Description [Returns false if the report ends before]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean prop_sched_take(const char** data, const char* end,
+                               void* buf, size_t bytes)
+{
+  if (*data + bytes > end) return false;
+
+  memcpy(buf, *data, bytes);
+  *data += bytes;
+  return true;
+}
+
+#endif /* PROP_SCHED_HAVE_CHILDREN */
@@ -102,12 +102,39 @@ typedef enum Rbc_Bool {
   RBC_TRUE = 0
 } Rbc_Bool_c;
 
+/**Enum**********************************************************************
+  Synopsis      [Which clauses a CNF conversion has to emit.]
+  Description   [The RBC manager remembers the nodes whose clauses have
+                 already been emitted into a (single) incremental SAT
+                 solver. RBC_CNF_EMIT_ALL ignores those markers,
+                 RBC_CNF_EMIT_NEW skips the marked nodes and
+                 RBC_CNF_EMIT_NEW_MARK in addition marks the nodes
+                 whose clauses are emitted.]
+  SeeAlso       [Rbc_Convert2CnfSink, Rbc_ResetCnfEmitted]
+******************************************************************************/
+typedef enum Rbc_CnfEmitMode_TAG {
+  RBC_CNF_EMIT_ALL = 0,
+  RBC_CNF_EMIT_NEW,
+  RBC_CNF_EMIT_NEW_MARK
+} Rbc_CnfEmitMode;
+
 typedef struct RbcManager Rbc_Manager_t;
+typedef struct RbcShiftTemplate Rbc_ShiftTemplate_t;
+typedef struct RbcSim Rbc_Sim_t;
 typedef Dag_Vertex_t      Rbc_t;
 typedef Dag_DfsFunctions_t RbcDfsFunctions_t;
 typedef void (*Rbc_ProcPtr_t)();
 typedef int (*Rbc_IntPtr_t)();
 
+/* Receives the clauses produced by the CNF conversion: 'clause' holds
+   'size' literals, and is not terminated by 0. It is valid only for the
+   duration of the call. */
+typedef void (*Rbc_ClauseSink_t) ARGS((void* data, const int* clause,
+                                       int size));
+
+/* Returns true only if the two formulas are equivalent (see Rbc_Sweep) */
+typedef boolean (*Rbc_EquivProver_t) ARGS((Rbc_t* a, Rbc_t* b, void* data));
+
 /*---------------------------------------------------------------------------*/
 /* Structure declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -128,6 +155,13 @@ struct RbcDfsFunctions {
 #define RBC_INVALID_SUBST_VALUE \
    INT_MAX
 
+/* The number of 64-bit words evaluated at once by Rbc_SimRun */
+#if defined(__AVX2__)
+#define RBC_SIM_WORDS 4
+#else
+#define RBC_SIM_WORDS 1
+#endif
+
 /**AutomaticStart*************************************************************/
 
 /*---------------------------------------------------------------------------*/
@@ -141,8 +175,19 @@ EXTERN int Rbc_Convert2Cnf
 ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f, int polarity,
       Slist_ptr clauses, Slist_ptr vars, int* literalAssignedToWholeFormula));
 
+EXTERN int Rbc_Convert2CnfSink
+ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f, int polarity,
+      Rbc_CnfEmitMode mode, Rbc_ClauseSink_t sink, void* sinkData,
+      Slist_ptr vars, int* literalAssignedToWholeFormula));
+
+EXTERN void Rbc_ResetCnfEmitted ARGS((Rbc_Manager_t* rbcManager));
+EXTERN void Rbc_GetCnfStats ARGS((Rbc_Manager_t* rbcManager,
+                                  int* clauses, int* reused));
+
 EXTERN int Rbc_CnfVar2RbcIndex ARGS((Rbc_Manager_t* rbcManager, int cnfVar));
+EXTERN Rbc_t* Rbc_CnfVar2Rbc ARGS((Rbc_Manager_t* rbcManager, int cnfVar));
 EXTERN int Rbc_RbcIndex2CnfVar ARGS((Rbc_Manager_t* rbcManager, int rbcIndex));
+EXTERN int Rbc_NewCnfVar ARGS((Rbc_Manager_t* rbcManager));
 
 EXTERN Rbc_t* Rbc_GetOne ARGS((Rbc_Manager_t* rbcManager));
 EXTERN Rbc_t* Rbc_GetZero ARGS((Rbc_Manager_t* rbcManager));
@@ -205,12 +250,44 @@ EXTERN Rbc_t* Rbc_Shift ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f, int shift));
 EXTERN Rbc_t*
 Rbc_LogicalShift ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f,
                        int shift, const int* log2phy, const int* phy2log));
+EXTERN Rbc_ShiftTemplate_t*
+Rbc_ShiftTemplateCreate ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f,
+                              const int* phy2log));
+EXTERN void Rbc_ShiftTemplateDestroy ARGS((Rbc_ShiftTemplate_t* tmpl));
+EXTERN int Rbc_ShiftTemplateGetSize ARGS((const Rbc_ShiftTemplate_t* tmpl));
+EXTERN Rbc_t*
+Rbc_ShiftTemplateApply ARGS((Rbc_Manager_t* rbcManager,
+                             Rbc_ShiftTemplate_t* tmpl, int shift,
+                             const int* log2phy));
+EXTERN Rbc_t*
+Rbc_ShiftTemplateApplySubst ARGS((Rbc_Manager_t* rbcManager,
+                                  Rbc_ShiftTemplate_t* tmpl, int* subst,
+                                  const int* log2phy));
+
 EXTERN Rbc_t*
 Rbc_SubstRbc ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f, Rbc_t** substRbc));
 
 EXTERN Rbc_t*
 Rbc_LogicalSubstRbc ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f,
                           Rbc_t** substRbc, int* phy2log));
+
+EXTERN Rbc_t* Rbc_Rewrite ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f));
+
+EXTERN void
+Rbc_Sweep ARGS((Rbc_Manager_t* rbcManager, Rbc_t** roots, int num,
+                int words, Rbc_EquivProver_t prover, void* proverData,
+                int* merged));
+
+EXTERN Rbc_Sim_t*
+Rbc_SimCreate ARGS((Rbc_Manager_t* rbcManager, Rbc_t** roots, int num));
+EXTERN void Rbc_SimDestroy ARGS((Rbc_Sim_t* sim));
+EXTERN int Rbc_SimGetSize ARGS((const Rbc_Sim_t* sim));
+EXTERN void Rbc_SimRun ARGS((Rbc_Sim_t* sim, const unsigned long long* vars,
+                             unsigned long long* out));
+EXTERN Rbc_t*
+Rbc_ExtractDefinitions ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f,
+                             const int* vars, int num, Rbc_t** defs));
+
 EXTERN void
 Rbc_PrintStats ARGS((Rbc_Manager_t* rbcManager, int clustSz, FILE* outFile));
 
@@ -9,6 +9,7 @@
   Description [External functions included in this module:
                 <ul>
                 <li> <b>Rbc_Convert2Cnf()</b>
+                <li> <b>Rbc_Convert2CnfSink()</b>
                 <li> <b>Rbc_CnfVar2RbcIndex()</b>
                 <li> <b>Rbc_RbcIndex2CnfVar()</b>
                 <li> <b>Rbc_CnfConversionAlgorithm2Str()</b>
@@ -71,10 +72,24 @@ static char rcsid[] UTIL_UNUSED = "$Id: rbcCnf.c,v 1.3.6.3.2.5.2.5.4.7 2010-02-1
 /* Stucture declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/**Struct**********************************************************************
+  Synopsis      [Sink wrapper counting the clauses of a conversion.]
+  Description   [Forwards every clause to the user's sink, and accounts
+                 it in the statistics of the RBC manager.]
+  SeeAlso       [Rbc_Convert2CnfSink]
+******************************************************************************/
+struct CnfSinkCounter {
+  Rbc_Manager_t* rbcManager;
+  Rbc_ClauseSink_t sink;
+  void* sinkData;
+};
+
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
 
+typedef struct CnfSinkCounter CnfSinkCounter_t;
+
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -90,6 +105,9 @@ static char rcsid[] UTIL_UNUSED = "$Id: rbcCnf.c,v 1.3.6.3.2.5.2.5.4.7 2010-02-1
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 
+static void CnfListSink(void* clauses, const int* clause, int size);
+static void CnfCountingSink(void* data, const int* clause, int size);
+
 /**AutomaticEnd***************************************************************/
 
 
@@ -124,6 +142,48 @@ int Rbc_Convert2Cnf(Rbc_Manager_t* rbcManager, Rbc_t* f,
                     int polarity, Slist_ptr clauses, Slist_ptr vars,
                     int* literalAssignedToWholeFormula)
 {
+  return Rbc_Convert2CnfSink(rbcManager, f, polarity, RBC_CNF_EMIT_ALL,
+                             CnfListSink, (void*) clauses, vars,
+                             literalAssignedToWholeFormula);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Translates the rbc into the corresponding (equisatisfiable)
+               set of clauses, handing each clause to a sink.]
+
+  Description [Same as Rbc_Convert2Cnf, but instead of being collected
+               into a list, every clause is passed to `sink' (along with
+               `sinkData') as soon as it is generated, from a buffer
+               that is reused for the next clause. This allows the
+               clauses to be loaded into a SAT solver without keeping
+               the whole CNF in memory.
+               `vars' may be NULL if the variables are not needed.
+               If `f' is false the sink receives the empty clause only,
+               if `f' is true the sink is not called at all.
+
+               `mode' allows an incremental SAT solver to be fed only
+               with the clauses of the nodes it has not received yet
+               (see Rbc_CnfEmitMode): the sub-graph below a node whose
+               clauses have already been emitted is not visited again,
+               and only its CNF variable is used. The compact
+               conversion marks a node for the polarities its CNF
+               variable has been given a definition for, the Tseitin
+               conversion for both of them.]
+
+  SideEffects [`vars' and '*literalAssignedToWholeFormula' are filled up.
+               Fields inside rbcManager might change]
+
+  SeeAlso     [Rbc_Convert2Cnf]
+
+******************************************************************************/
+int Rbc_Convert2CnfSink(Rbc_Manager_t* rbcManager, Rbc_t* f,
+                        int polarity, Rbc_CnfEmitMode mode,
+                        Rbc_ClauseSink_t sink, void* sinkData,
+                        Slist_ptr vars, int* literalAssignedToWholeFormula)
+{
+  CnfSinkCounter_t counter;
   int result;
   int i, maxVar;
 
@@ -134,10 +194,8 @@ int Rbc_Convert2Cnf(Rbc_Manager_t* rbcManager, Rbc_t* f,
     return 0;
   }
   if (f == Rbc_GetZero(rbcManager)) {
-    /* The empty clause: 0 is used as clause terminator */
-    int * fClause = ALLOC(int, 1);
-    fClause[0] = 0;
-    Slist_push(clauses, (void*) fClause);
+    /* The empty clause */
+    sink(sinkData, (const int*) NULL, 0);
     return 0;
   }
 
@@ -158,16 +216,21 @@ int Rbc_Convert2Cnf(Rbc_Manager_t* rbcManager, Rbc_t* f,
   /* Cleaning the user fields. */
   Dag_Dfs(f, &dag_DfsClean, NIL(char));
 
+  counter.rbcManager = rbcManager;
+  counter.sink = sink;
+  counter.sinkData = sinkData;
 
   /*     [MR2??]: moved up passign argument to the functions */
   switch(get_rbc2cnf_algorithm(OptsHandler_get_instance())) {
   case RBC_TSEITIN_CONVERSION:
-    result = Rbc_Convert2CnfSimple(rbcManager, f, clauses, vars,
+    result = Rbc_Convert2CnfSimple(rbcManager, f, mode,
+                                   CnfCountingSink, (void*) &counter, vars,
                                    literalAssignedToWholeFormula);
     break;
   case RBC_SHERIDAN_CONVERSION:
-    result = Rbc_Convert2CnfCompact(rbcManager, f, polarity, clauses, vars,
-                                    literalAssignedToWholeFormula);
+    result = Rbc_Convert2CnfCompact(rbcManager, f, polarity, mode,
+                                    CnfCountingSink, (void*) &counter,
+                                    vars, literalAssignedToWholeFormula);
     break;
   default:
     fprintf(nusmv_stderr, 
@@ -181,6 +244,50 @@ int Rbc_Convert2Cnf(Rbc_Manager_t* rbcManager, Rbc_t* f,
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Forgets which nodes have had their clauses emitted]
+
+  Description [To be called whenever the incremental SAT solver fed
+               with RBC_CNF_EMIT_NEW_MARK conversions is discarded, or
+               before starting to feed a new one.]
+
+  SideEffects [The emitted markers of rbcManager are cleared]
+
+  SeeAlso     [Rbc_Convert2CnfSink]
+
+******************************************************************************/
+void Rbc_ResetCnfEmitted(Rbc_Manager_t* rbcManager)
+{
+  if ((hash_ptr) NULL != rbcManager->cnfEmitted) {
+    clear_assoc(rbcManager->cnfEmitted);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the statistics of the CNF conversions]
+
+  Description [`*clauses' is set to the number of clauses emitted by
+               all the conversions performed so far, `*reused' to the
+               number of nodes whose clauses were not emitted again
+               because already marked. Both are cumulative: the
+               difference of two readings gives the figures of the
+               conversions performed in between.]
+
+  SideEffects [*clauses and *reused are set]
+
+  SeeAlso     [Rbc_Convert2CnfSink]
+
+******************************************************************************/
+void Rbc_GetCnfStats(Rbc_Manager_t* rbcManager, int* clauses, int* reused)
+{
+  *clauses = rbcManager->stats[RBCCNFCLAUSE_NO];
+  *reused = rbcManager->stats[RBCCNFREUSE_NO];
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Returns the RBC index corresponding to a particular CNF var]
@@ -219,6 +326,62 @@ int Rbc_CnfVar2RbcIndex(Rbc_Manager_t* rbcManager, int cnfVar)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Returns the RBC node corresponding to a particular CNF var]
+
+  Description [Differently from Rbc_CnfVar2RbcIndex, internal nodes
+  are returned as well: the CNF variable of an internal node is
+  equivalent to the node in every model of the CNF it has been
+  introduced by. Returns NIL if the CNF variable is unknown, or if it
+  is a dummy variable introduced by rbcCnfCompact, which has no
+  corresponding node.]
+
+  SideEffects []
+
+  SeeAlso     [Rbc_CnfVar2RbcIndex]
+
+******************************************************************************/
+Rbc_t* Rbc_CnfVar2Rbc(Rbc_Manager_t* rbcManager, int cnfVar)
+{
+  Rbc_t* rbcNode;
+
+  rbcNode = (Rbc_t*) find_assoc(rbcManager->cnfVar2rbcNode_model,
+                                NODE_FROM_INT(cnfVar));
+
+  if ((Rbc_t*) NULL == rbcNode) {
+    rbcNode = (Rbc_t*) find_assoc(rbcManager->cnfVar2rbcNode_cnf,
+                                NODE_FROM_INT(cnfVar));
+  }
+
+  if ((Rbc_t*) NULL == rbcNode || Dag_VertexGetRef(rbcNode) == RBCDUMMY) {
+    return NIL(Rbc_t);
+  }
+
+  return rbcNode;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Allocates a CNF variable which is not associated to any
+  RBC node]
+
+  Description [The variable is never used by the conversions. This is
+  meant for the activation literals of the clauses a caller adds to a
+  SAT solver by itself.]
+
+  SideEffects [The maximum CNF variable of the manager is increased]
+
+  SeeAlso     [Rbc_Convert2Cnf]
+
+******************************************************************************/
+int Rbc_NewCnfVar(Rbc_Manager_t* rbcManager)
+{
+  return ++(rbcManager->maxCnfVariable);
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Returns the associated CNF variable of a given RBC index]
@@ -387,3 +550,47 @@ const char * Rbc_CnfGetValidRbc2CnfAlgorithms() {
 /*---------------------------------------------------------------------------*/
 /* Definition of static functions                                            */
 /*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [The sink used by Rbc_Convert2Cnf]
+
+  Description [Copies the clause and pushes it into the list
+               `clauses'. Clauses in the list are terminated by 0.]
+
+  SideEffects [`clauses' is filled up]
+
+  SeeAlso     [Rbc_Convert2Cnf]
+
+******************************************************************************/
+static void CnfListSink(void* clauses, const int* clause, int size)
+{
+  int* cl = ALLOC(int, size + 1);
+  nusmv_assert((int*) NULL != cl);
+
+  if (size > 0) memcpy(cl, clause, size * sizeof(int));
+  /* Clauses are terminated by the literal 0 */
+  cl[size] = 0;
+
+  Slist_push((Slist_ptr) clauses, (void*) cl);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [The sink used by Rbc_Convert2CnfSink to count the clauses]
+
+  Description [Accounts the clause and forwards it to the user's sink]
+
+  SideEffects [The statistics of the RBC manager are updated]
+
+  SeeAlso     [Rbc_Convert2CnfSink]
+
+******************************************************************************/
+static void CnfCountingSink(void* data, const int* clause, int size)
+{
+  CnfSinkCounter_t* counter = (CnfSinkCounter_t*) data;
+
+  ++(counter->rbcManager->stats[RBCCNFCLAUSE_NO]);
+  counter->sink(counter->sinkData, clause, size);
+}
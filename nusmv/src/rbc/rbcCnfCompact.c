@@ -65,9 +65,14 @@ static char rcsid[] UTIL_UNUSED = "$Id: rbcCnfCompact.c,v 1.1.4.7 2010-02-18 10:
 ******************************************************************************/
 struct CnfCompactDfsData {
   Rbc_Manager_t*  rbcManager;
+  Rbc_CnfEmitMode mode;       /* Whether emitted markers are used */
   int             maxVar;     /* Maximum variable index so far */
   clause_graph    clauses;    /* List of clauses generated so far */
-  Slist_ptr       vars;       /* List of variables used so far */
+  Rbc_ClauseSink_t sink;      /* Receives the extracted clauses */
+  void*           sinkData;   /* Passed to sink */
+  int*            clause;     /* Buffer for the extracted clauses */
+  int             clauseSize; /* Size of clause */
+  Slist_ptr       vars;       /* List of variables used so far (or NULL) */
   clause_graph    posClauses; /* Current clause list for positive polarity */
   clause_graph    negClauses; /* Current clause list for negative polarity */
   int             pol;        /* Current polarity */
@@ -83,6 +88,8 @@ struct CnfCompactDfsNode {
   int                  negRef;     /* Number of negative polarity references */
   int                  posRef;     /* Number of negative polarity references */
   boolean              unseen;     /* Whether this node has been processed */
+  int                  reused;     /* Polarities already emitted, for which */
+                                   /* the CNF variable is used as it is */
   clause_graph         posClauses; /* Result of pos conversion at this node */
   clause_graph         negClauses; /* Result of neg conversion at this node */
   clause_graph         ifClauses;  /* Result of pos conversion for IF branch */
@@ -120,6 +127,8 @@ static int CnfCompactSet(Rbc_t* f, char* cnfData, nusmv_ptrint sign);
 static void CnfCompactFirst(Rbc_t* f, char* cnfData, nusmv_ptrint sign);
 static void CnfCompactBack(Rbc_t* f, char* cnfData, nusmv_ptrint sign);
 static void CnfCompactLast(Rbc_t* f, char* cnfData, nusmv_ptrint sign);
+static void CnfCompactReused(Rbc_t* f, CnfCompactDfsData_t* cd,
+                             CnfCompactDfsNode_t* nd);
 
 static int CnfCompactCleanSet(Rbc_t* f, char* cnfData, nusmv_ptrint sign);
 static void CnfCompactCleanFirst(Rbc_t* f, char* cnfData, nusmv_ptrint sign);
@@ -152,29 +161,36 @@ static void CnfCompactCommit(void* data, int* cl, int size);
   Synopsis    [Translates the rbc into the corresponding (equisatisfiable)
                set of clauses.]
 
-  Description [Given `rbcManager' and `f', `clauses' is filled with the
+  Description [Given `rbcManager' and `f', `sink' is given the
                disjunctions corresponding to the rbc nodes according to
                the 'compact' algorithm by Dan Sheridan.
                `vars' is filled with the variables that occurred in `f'
-               (original or model variables). It is user's responsibility
-               to create `clauses' and `vars' *before* calling the function.
+               (original or model variables), unless it is NULL. It is
+               user's responsibility to create `vars' *before* calling
+               the function.
                New variables are added by the conversion: the maximum
                index (the last added variable) is returned by the function.
                The function returns 0 when `f' is true or false. 'polarity'
                defines whether 'f' has to be true, false, or either (1, -1
                or 0 respectively). If 'polarity' is 1/-1 then only the
                clauses representing the true/false RBC are returned. Otherwise,
-               both sets are returned.]
+               both sets are returned.
+               Unless `mode' is RBC_CNF_EMIT_ALL, a node reached only
+               with polarities already marked as emitted is not
+               converted again, its CNF variable being used instead.
+               With RBC_CNF_EMIT_NEW_MARK the polarities renamed with
+               the CNF variable of a node are marked as emitted.]
 
-  SideEffects [`clauses' and `vars' are filled up. `clauses' is the empty
-               list if `f' was true, and contains a single empty clause if
-               `f' was false.]
+  SideEffects [`vars' is filled up. Constants are handled by the caller
+               (see Rbc_Convert2CnfSink).]
 
   SeeAlso     []
 
 ******************************************************************************/
 int Rbc_Convert2CnfCompact(Rbc_Manager_t* rbcManager, Rbc_t* f,
-                           int polarity, Slist_ptr clauses, Slist_ptr vars,
+                           int polarity, Rbc_CnfEmitMode mode,
+                           Rbc_ClauseSink_t sink, void* sinkData,
+                           Slist_ptr vars,
                            int* literalAssignedToWholeFormula)
 {
   Dag_DfsFunctions_t  cnfFunctions;
@@ -186,7 +202,12 @@ int Rbc_Convert2CnfCompact(Rbc_Manager_t* rbcManager, Rbc_t* f,
 
   /* Setting up the DFS data. */
   cnfData.rbcManager = rbcManager;
+  cnfData.mode       = mode;
   cnfData.clauses    = NULL;
+  cnfData.sink       = sink;
+  cnfData.sinkData   = sinkData;
+  cnfData.clauseSize = 16;
+  cnfData.clause     = ALLOC(int, cnfData.clauseSize);
   cnfData.vars       = vars;
   cnfData.posClauses = NULL;
   cnfData.negClauses = NULL;
@@ -233,8 +254,9 @@ int Rbc_Convert2CnfCompact(Rbc_Manager_t* rbcManager, Rbc_t* f,
   *literalAssignedToWholeFormula = renamed;
 
   Clg_Extract(cnfData.clauses, CLG_NUSMV,
-              (Clg_Commit) CnfCompactCommit, (void*) &(clauses));
+              (Clg_Commit) CnfCompactCommit, (void*) &cnfData);
   Clg_Free(cnfData.clauses);
+  FREE(cnfData.clause);
 
 
   /* Clean the graph of the allocated data */
@@ -271,6 +293,47 @@ static int CnfCompactPolSet(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
   CnfCompactDfsData_t* cd = (CnfCompactDfsData_t*)cnfData;
   CnfCompactDfsNode_t* nd = (CnfCompactDfsNode_t*)(f->gRef);
 
+  /* Nodes whose clauses have already been emitted for all the
+     polarities required by this reference are not converted again:
+     the reference is not counted, and recorded in nd->reused */
+  if ((cd->mode != RBC_CNF_EMIT_ALL) && (f->symbol != RBCVAR)) {
+    int required;
+
+    if (cd->zeroiff) required = RBC_CNF_EMITTED_BOTH;
+    else {
+      required = 0;
+      if (cd->pol >= 0) {
+        required |= (sign ? RBC_CNF_EMITTED_NEG : RBC_CNF_EMITTED_POS);
+      }
+      if (cd->pol <= 0) {
+        required |= (sign ? RBC_CNF_EMITTED_POS : RBC_CNF_EMITTED_NEG);
+      }
+    }
+
+    if ((required & ~NODE_TO_INT(find_assoc(cd->rbcManager->cnfEmitted,
+                                            (node_ptr) f))) == 0) {
+      if (nd == NULL) {
+        nd = ALLOC(CnfCompactDfsNode_t, 1);
+        f->gRef = (char*) nd;
+
+        nd->posRef = 0;
+        nd->negRef = 0;
+        nd->posClauses = NULL;
+        nd->negClauses = NULL;
+        nd->ifClauses = NULL;
+        nd->unseen = true;
+        nd->reused = 0;
+
+        /* As if first seen in a normal visit */
+        f->iRef = (f->symbol == RBCIFF) ? 0 : (sign ? -(cd->pol) : cd->pol);
+      }
+
+      if (nd->reused == 0) ++(cd->rbcManager->stats[RBCCNFREUSE_NO]);
+      nd->reused |= required;
+      return 1; /* Don't visit */
+    }
+  }
+
   /* This function is called to decide whether to continue down the
      current route. If we get here, and it is a node that has already
      been seen with the current polarity, we still want to update the
@@ -291,6 +354,7 @@ static int CnfCompactPolSet(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
     nd->negClauses = NULL;
     nd->ifClauses = NULL;
     nd->unseen = true;
+    nd->reused = 0;
 
     result = -1; /* unconditionally visit this node */
 
@@ -473,7 +537,12 @@ static int CnfCompactSet(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
      structures. */
 
   if (nd->unseen) {
-    return -1; /* Visit the node */
+    if ((nd->posRef > 0) || (nd->negRef > 0)) {
+      return -1; /* Visit the node */
+    }
+
+    /* Only referenced with polarities already emitted */
+    CnfCompactReused(f, cd, nd);
   }
 
   /* Point to the results from this clause so that they can be used by
@@ -593,7 +662,9 @@ static void CnfCompactLast(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
   switch (f->symbol) {
   case RBCVAR:
     /* Fill in vars list */
-    Slist_push(cd->vars, PTR_FROM_INT(void*, cnfVar));
+    if (cd->vars != (Slist_ptr) NULL) {
+      Slist_push(cd->vars, PTR_FROM_INT(void*, cnfVar));
+    }
 
     resultPos = Clg_Lit(cnfVar);
     resultNeg = Clg_Lit(-cnfVar);
@@ -684,6 +755,26 @@ static void CnfCompactLast(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
   nusmv_assert((nd->posRef) == 0 || Clg_Size(resultPos) > 0);
   nusmv_assert((nd->negRef) == 0 || Clg_Size(resultNeg) > 0);
 
+  if (cd->mode == RBC_CNF_EMIT_NEW_MARK) {
+    int emitted = 0;
+
+    if ((nd->posRef) > 1) emitted |= RBC_CNF_EMITTED_POS;
+    if ((nd->negRef) > 1) emitted |= RBC_CNF_EMITTED_NEG;
+    if ((emitted != 0) && (f->symbol != RBCVAR)) {
+      emitted |= NODE_TO_INT(find_assoc(cd->rbcManager->cnfEmitted,
+                                        (node_ptr) f));
+      insert_assoc(cd->rbcManager->cnfEmitted, (node_ptr) f,
+                   NODE_FROM_INT(emitted));
+    }
+  }
+
+  /* The polarities already emitted are represented by the CNF variable */
+  if (nd->reused != 0) {
+    cnfVar = Rbc_get_node_cnf(cd->rbcManager, f, &(cd->maxVar));
+    if (nd->reused & RBC_CNF_EMITTED_POS) resultPos = Clg_Lit(cnfVar);
+    if (nd->reused & RBC_CNF_EMITTED_NEG) resultNeg = Clg_Lit(-cnfVar);
+  }
+
   /* Pass these results back up the graph */
   if (sign) {
     cd->posClauses = nd->negClauses = resultNeg;
@@ -703,6 +794,33 @@ static void CnfCompactLast(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 
 
 
+/**Function********************************************************************
+
+  Synopsis    [Sets the results of a node that is not converted again.]
+
+  Description [The node is referenced only with polarities whose clauses
+               have already been emitted: its CNF variable stands for
+               them.]
+
+  SideEffects [None]
+
+  SeeAlso     [CnfCompactPolSet]
+
+******************************************************************************/
+static void CnfCompactReused(Rbc_t* f, CnfCompactDfsData_t* cd,
+                             CnfCompactDfsNode_t* nd)
+{
+  int cnfVar = Rbc_get_node_cnf(cd->rbcManager, f, &(cd->maxVar));
+
+  nusmv_assert(nd->reused != 0);
+
+  if (nd->reused & RBC_CNF_EMITTED_POS) nd->posClauses = Clg_Lit(cnfVar);
+  if (nd->reused & RBC_CNF_EMITTED_NEG) nd->negClauses = Clg_Lit(-cnfVar);
+
+  nd->unseen = false;
+} /* End of CnfCompactReused. */
+
+
 /**Function********************************************************************
 
   Synopsis    [Dfs Set for cleaning.]
@@ -717,6 +835,9 @@ static void CnfCompactLast(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 static int CnfCompactCleanSet(Dag_Vertex_t* f, char* cleanData,
                               nusmv_ptrint sign)
 {
+  /* Nodes below a reused one may have not been reached at all */
+  if (f->gRef == NIL(char)) return 1;
+
   /* All the nodes are visited once and only once. */
   return 0;
 } /* End of CleanSet. */
@@ -898,7 +1019,8 @@ static inline int testSizes(clause_graph left, clause_graph right)
 
   Synopsis    [Extracts the cnf from the CLG]
 
-  Description []
+  Description [The clause is copied into the buffer of the DFS data,
+               dropping duplicate literals, and handed to the sink]
 
   SideEffects [None]
 
@@ -908,19 +1030,20 @@ static inline int testSizes(clause_graph left, clause_graph right)
 static void CnfCompactCommit(void* data, int* cl, int size)
 {
   if (1 <= size) {
-    int i;
-    Slist_ptr* clauses = (Slist_ptr*)data;
-    int * clause = (int *)NULL;
+    int i, j, n;
+    CnfCompactDfsData_t* cd = (CnfCompactDfsData_t*) data;
 
-    clause = ALLOC(int, size+1);
-    nusmv_assert((int *)NULL != clause);
+    if (cd->clauseSize < size) {
+      cd->clauseSize = size;
+      cd->clause = REALLOC(int, cd->clause, cd->clauseSize);
+    }
 
+    n = 0;
     for(i = size; i > 0; i--) {
-      clause[size - i] = cl[i-1];
+      for (j = 0; j < n && cd->clause[j] != cl[i-1]; ++j);
+      if (j == n) cd->clause[n++] = cl[i-1];
     }
-    /* Clauses are terminated by the literal 0 */
-    clause[size] = 0;
 
-    Slist_push(*clauses, (void*)clause);
+    cd->sink(cd->sinkData, cd->clause, n);
   }
 }
@@ -66,7 +66,9 @@ static char rcsid[] UTIL_UNUSED = "$Id: rbcCnfSimple.c,v 1.1.4.7 2010-02-18 10:0
 ******************************************************************************/
 struct CnfDfsData {
   Rbc_Manager_t* rbcManager;
-  Slist_ptr clauses;
+  Rbc_CnfEmitMode mode;
+  Rbc_ClauseSink_t sink;
+  void* sinkData;
   Slist_ptr vars;
   int result;
 };
@@ -88,6 +90,10 @@ typedef struct CnfDfsData CnfDfsData_t;
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+/* The CNF literal of a son of a vertex already visited by the DFS */
+#define CNF_SON_LITERAL(son) \
+  (RbcIsSet(son) ? -(RbcGetRef(son)->iRef) : RbcGetRef(son)->iRef)
+
 
 /**AutomaticStart*************************************************************/
 
@@ -114,7 +120,7 @@ static lsGeneric SwapSign(lsGeneric data);
   Synopsis    [Translates the rbc into the corresponding (equisatisfiable)
                set of clauses.]
 
-  Description [Given `rbcManager' and `f', `clauses' is filled with the
+  Description [Given `rbcManager' and `f', `sink' is given the
                disjunctions corresponding to the rbc nodes according to
                the rules:
 
@@ -130,27 +136,33 @@ static lsGeneric SwapSign(lsGeneric data);
 
                `vars' is filled with the variables that occurred in `f'
                (original or model variables converted into corresponding CNF
-               variables). It is user's responsibility
-               to create `clauses' and `vars' *before* calling the function.
+               variables), unless it is NULL. It is user's responsibility
+               to create `vars' *before* calling the function.
                New variables are added by the conversion: the maximum
                index is returned by the function.
+               Unless `mode' is RBC_CNF_EMIT_ALL, the nodes already
+               marked as emitted are not converted again (nor are
+               their sons), and with RBC_CNF_EMIT_NEW_MARK the
+               converted nodes are marked.
                The literal associated to 'f' is assigned to parameter
                *literalAssignedToWholeFormula (it may be negative).
                Special case - A CONSTANT (this is consistent with description
                  of Be_Cnf_ptr): if the formula is a constant
                  then *literalAssignedToWholeFormula will be INT_MAX
                  and the return value will 0.
-                 if formula is true, `clauses' is the empty list,
-                 if formula is false, `clauses' contains a single empty clause.]
+                 Constants are handled by the caller (see
+                 Rbc_Convert2CnfSink).]
 
-  SideEffects [`clauses', `vars' and '*literalAssignedToWholeFormula'
+  SideEffects [`vars' and '*literalAssignedToWholeFormula'
               are filled up. Fields inside rbcManager might change ]
 
   SeeAlso     []
 
 ******************************************************************************/
 int Rbc_Convert2CnfSimple(Rbc_Manager_t* rbcManager, Rbc_t* f,
-                          Slist_ptr clauses, Slist_ptr vars,
+                          Rbc_CnfEmitMode mode,
+                          Rbc_ClauseSink_t sink, void* sinkData,
+                          Slist_ptr vars,
                           int* literalAssignedToWholeFormula)
 {
   Dag_DfsFunctions_t cnfFunctions;
@@ -167,7 +179,9 @@ int Rbc_Convert2CnfSimple(Rbc_Manager_t* rbcManager, Rbc_t* f,
 
   /* Setting up the DFS data. */
   cnfData.rbcManager = rbcManager;
-  cnfData.clauses    = clauses;
+  cnfData.mode       = mode;
+  cnfData.sink       = sink;
+  cnfData.sinkData   = sinkData;
   cnfData.vars       = vars;
   cnfData.result     = 0;
 
@@ -190,7 +204,9 @@ int Rbc_Convert2CnfSimple(Rbc_Manager_t* rbcManager, Rbc_t* f,
 
   Synopsis    [Dfs Set for CNF conversion.]
 
-  Description [Dfs Set for CNF conversion.]
+  Description [Dfs Set for CNF conversion. A node whose clauses have
+               already been emitted is not visited: its CNF variable is
+               taken from the manager.]
 
   SideEffects [None]
 
@@ -201,6 +217,18 @@ static int CnfSet(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 {
   CnfDfsData_t* cd = (CnfDfsData_t*)cnfData;
 
+  /* iRef is zeroed by the cleaning DFS, until the node is converted */
+  if ((cd->mode != RBC_CNF_EMIT_ALL) && (f->iRef == 0) &&
+      (RBC_CNF_EMITTED_BOTH ==
+       NODE_TO_INT(find_assoc(cd->rbcManager->cnfEmitted, (node_ptr) f)))) {
+    f->iRef = Rbc_get_node_cnf(cd->rbcManager, f,
+                               &cd->rbcManager->maxCnfVariable);
+    ++(cd->rbcManager->stats[RBCCNFREUSE_NO]);
+
+    cd->result = (sign != 0 ? -1 * (f->iRef) : f->iRef);
+    return 1;
+  }
+
   /* Set the current integer reference as result. */
   cd->result = (sign != 0 ? -1 * (f->iRef) : f->iRef);
 
@@ -222,10 +250,7 @@ static int CnfSet(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 ******************************************************************************/
 static void CnfFirst(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 {
-  if (f->symbol != RBCVAR) {
-    /* Create a temporary list (use vertex's own general reference). */
-    f->gRef = (char*) lsCreate();
-  }
+  return;
 } /* End of CnfFirst. */
 
 
@@ -243,14 +268,7 @@ static void CnfFirst(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 static void
 CnfBack(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 {
-  CnfDfsData_t * cd   = (CnfDfsData_t*)cnfData;
-
-  /* Get the current result and add it (negated) to the temporary list. */
-  (void) lsNewEnd((lsList)(f->gRef),
-                  PTR_FROM_INT(lsGeneric, -1 * (cd->result)), LS_NH);
-
   return;
-
 } /* End of CnfBack. */
 
 
@@ -258,7 +276,10 @@ CnfBack(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 
   Synopsis    [Dfs LastVisit for CNF conversion.]
 
-  Description [Dfs LastVisit for CNF conversion.]
+  Description [Dfs LastVisit for CNF conversion. The sons have all been
+               visited already, so their CNF variables are found in their
+               iRef field. Clauses are built into a small buffer on the
+               stack, and handed to the sink.]
 
   SideEffects [None]
 
@@ -267,12 +288,7 @@ CnfBack(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 ******************************************************************************/
 static void CnfLast(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
 {
-  lsGen     gen;
-  nusmv_ptrint s;
-  int pol;
-
   CnfDfsData_t* cd = (CnfDfsData_t*) cnfData;
-  lsList sons = (lsList) (f->gRef);
 
   int cnfVar = Rbc_get_node_cnf(cd->rbcManager, f,
                                 &cd->rbcManager->maxCnfVariable);
@@ -281,164 +297,96 @@ static void CnfLast(Rbc_t* f, char* cnfData, nusmv_ptrint sign)
   if (f->symbol == RBCVAR) {
 
     /* Fill in the list of 'original' model vars converted into CNF vars */
-    Slist_push(cd->vars, PTR_FROM_INT(void*, cnfVar));
+    if (cd->vars != (Slist_ptr) NULL) {
+      Slist_push(cd->vars, PTR_FROM_INT(void*, cnfVar));
+    }
   }
   else {
+    /* Sons have at most three literals: a clause has at most four */
+    int cl[4];
+    int s1, s2;
+
+    nusmv_assert(f->numSons <= 3);
 
     /* Generate and append clauses. */
     if (f->symbol == RBCAND) {
+      unsigned i;
       int j = 0;
-      int clause_size = lsLength(sons) + 2;
-      int * tmpCl1 = (int *)NULL;
-      int * tmpCl2 = (int *)NULL;
-
-      /* Compute the binary clauses {-f s_i} */
-      /* Compute the clause {f -s_1 -s_2} */
-      tmpCl1 = ALLOC(int, clause_size);
-      gen = lsStart(sons);
-      while (lsNext(gen, (lsGeneric*) &s, LS_NH) == LS_OK) {
-        tmpCl1[j++] = (int)s;
-        tmpCl2      = ALLOC(int, 3);
-        tmpCl2[0]   = -1 * cnfVar;
-        tmpCl2[1]   = -1 * (int)s;
-        tmpCl2[2]   = 0;
-        /* Add the binary clauses {-f s_i} */
-        Slist_push(cd->clauses, (void*)tmpCl2);
-        tmpCl2      = (int *)NULL; /* to avoid possible problems */
+
+      /* The binary clauses {-f s_i} */
+      for (i = 0; i < f->numSons; ++i) {
+        cl[0] = -1 * cnfVar;
+        cl[1] = CNF_SON_LITERAL(f->outList[i]);
+        cd->sink(cd->sinkData, cl, 2);
       }
-      lsFinish(gen);
-      tmpCl1[j++] = cnfVar;
-      tmpCl1[j++] = 0;
-      nusmv_assert(j == clause_size);
-      /* Add the clause {f -s_1 -s_2} */
-      Slist_push(cd->clauses, (void*)tmpCl1);
 
-      lsDestroy(sons, NULL);
+      /* The clause {f -s_1 -s_2} */
+      for (i = 0; i < f->numSons; ++i) {
+        cl[j++] = -1 * CNF_SON_LITERAL(f->outList[i]);
+      }
+      cl[j++] = cnfVar;
+      cd->sink(cd->sinkData, cl, j);
 
     } else if (f->symbol == RBCIFF) {
-      int i;
-      int * tmpCl1 = (int *)NULL;
-      int * tmpCl2 = (int *)NULL;
-      int clause_size = lsLength(sons) + 2;
-
-      /* Compute clause {-f s_1 -s_2} */
-      tmpCl1 = ALLOC(int, clause_size);
-      i = 0;
-      tmpCl1[i++] = -1 * cnfVar;
-      pol = -1;
-      gen = lsStart(sons);
-      while (lsNext(gen, (lsGeneric*) &s, LS_NH) == LS_OK) {
-        tmpCl1[i++] = (int) s * pol;
-        pol *= -1;
-      }
-      lsFinish(gen);
-      tmpCl1[i++] = 0;
-      nusmv_assert(i == clause_size);
-      /* Add the clause {-f s_1 -s_2} */
-      Slist_push(cd->clauses, (void*)tmpCl1);
-
-      /* Compute clause {-f -s_1 s_2} */
-      tmpCl1 = ALLOC(int, clause_size);
-      i = 0;
-      tmpCl1[i++] = -1 * cnfVar;
-      pol = 1;
-      gen = lsStart(sons);
-      while (lsNext(gen, (lsGeneric*) &s, LS_NH) == LS_OK) {
-        tmpCl1[i++] = pol * (int) s;
-        pol *= -1;
-      }
-      lsFinish(gen);
-      tmpCl1[i++] = 0;
-      nusmv_assert(i == clause_size);
-      /* Add the clause {-f -s_1 s_2} */
-      Slist_push(cd->clauses, (void*)tmpCl1);
-
-      /* Compute clause {f s_1 s_2} */
-      /* Compute clause {f -s_1 -s_2} */
-      tmpCl1 = ALLOC(int, clause_size);
-      tmpCl2 = ALLOC(int, clause_size);
-      i = 0;
-      gen = lsStart(sons);
-      while (lsNext(gen, (lsGeneric*) &s, LS_NH) == LS_OK) {
-        tmpCl1[i] = -1 * (int)s;
-        tmpCl2[i] =      (int)s;
-        i++;
-      }
-      lsFinish(gen);
-      tmpCl1[i] = cnfVar;
-      tmpCl2[i] = cnfVar;
-      i++;
-      tmpCl1[i] = 0;
-      tmpCl2[i] = 0;
-      i++;
-      nusmv_assert(i == clause_size);
-
-      /* Add the clause {f s_1 s_2} */
-      Slist_push(cd->clauses, (void*)tmpCl1);
-      /* Add the clause {f -s_1 -s_2} */
-      Slist_push(cd->clauses, (void*)tmpCl2);
-
-      lsDestroy(sons, NULL);
+      nusmv_assert(f->numSons == 2);
+      s1 = CNF_SON_LITERAL(f->outList[0]);
+      s2 = CNF_SON_LITERAL(f->outList[1]);
+
+      /* The clause {-f s_1 -s_2} */
+      cl[0] = -1 * cnfVar; cl[1] = s1; cl[2] = -1 * s2;
+      cd->sink(cd->sinkData, cl, 3);
+
+      /* The clause {-f -s_1 s_2} */
+      cl[0] = -1 * cnfVar; cl[1] = -1 * s1; cl[2] = s2;
+      cd->sink(cd->sinkData, cl, 3);
+
+      /* The clause {f s_1 s_2} */
+      cl[0] = s1; cl[1] = s2; cl[2] = cnfVar;
+      cd->sink(cd->sinkData, cl, 3);
+
+      /* The clause {f -s_1 -s_2} */
+      cl[0] = -1 * s1; cl[1] = -1 * s2; cl[2] = cnfVar;
+      cd->sink(cd->sinkData, cl, 3);
 
     } else if (f->symbol == RBCITE) {
-      int * tmpCl = (int *)NULL;
-      nusmv_ptrint i, t, e;
-
-      gen = lsStart(sons);
-      /* Should have three children */
-      if(lsNext(gen, (lsGeneric*) &i, LS_NH) != LS_OK) error_unreachable_code();
-      if(lsNext(gen, (lsGeneric*) &t, LS_NH) != LS_OK) error_unreachable_code();
-      if(lsNext(gen, (lsGeneric*) &e, LS_NH) != LS_OK) error_unreachable_code();
-      lsFinish(gen);
-
-      /* Compute the clause {-f -i t} */
-      tmpCl = ALLOC(int, 4);
-      tmpCl[0] = -1 * cnfVar;
-      tmpCl[1] = (int)i;
-      tmpCl[2] = -1 * (int)t;
-      tmpCl[3] = 0;
-      /* Add the clause {-f -i t} */
-      Slist_push(cd->clauses, (void*) tmpCl);
-
-      /* Compute the clause {-f i e} */
-      tmpCl = ALLOC(int, 4);
-      tmpCl[0] = -1 * cnfVar;
-      tmpCl[1] = -1 * (int)i;
-      tmpCl[2] = -1 * (int)e;
-      tmpCl[3] = 0;
-      /* Add the clause {-f i e} */
-      Slist_push(cd->clauses, (void*) tmpCl);
-
-      /* Compute the clause {f -i -t} */
-      tmpCl = ALLOC(int, 4);
-      tmpCl[0] = cnfVar;
-      tmpCl[1] = (int)i;
-      tmpCl[2] = (int)t;
-      tmpCl[3] = 0;
-      /* Add the clause {f -i -t} */
-      Slist_push(cd->clauses, (void*) tmpCl);
-
-      /* Compute the clause {f i -e} */
-      tmpCl = ALLOC(int, 4);
-      tmpCl[0] = cnfVar;
-      tmpCl[1] = -1 * (int)i;
-      tmpCl[2] = (int)e;
-      tmpCl[3] = 0;
-      /* Add the clause {f i -e} */
-      Slist_push(cd->clauses, (void*) tmpCl);
-
-      lsDestroy(sons, NULL);
+      int e;
+
+      nusmv_assert(f->numSons == 3);
+      s1 = CNF_SON_LITERAL(f->outList[0]); /* if */
+      s2 = CNF_SON_LITERAL(f->outList[1]); /* then */
+      e  = CNF_SON_LITERAL(f->outList[2]); /* else */
+
+      /* The clause {-f -i t} */
+      cl[0] = -1 * cnfVar; cl[1] = -1 * s1; cl[2] = s2;
+      cd->sink(cd->sinkData, cl, 3);
+
+      /* The clause {-f i e} */
+      cl[0] = -1 * cnfVar; cl[1] = s1; cl[2] = e;
+      cd->sink(cd->sinkData, cl, 3);
+
+      /* The clause {f -i -t} */
+      cl[0] = cnfVar; cl[1] = -1 * s1; cl[2] = -1 * s2;
+      cd->sink(cd->sinkData, cl, 3);
+
+      /* The clause {f i -e} */
+      cl[0] = cnfVar; cl[1] = s1; cl[2] = -1 * e;
+      cd->sink(cd->sinkData, cl, 3);
     }
     else
       internal_error("CnfLast: unkown RBC symbol");
 
   }
 
+  if ((cd->mode == RBC_CNF_EMIT_NEW_MARK) && (f->symbol != RBCVAR)) {
+    /* Tseitin clauses define the node in both the polarities */
+    insert_assoc(cd->rbcManager->cnfEmitted, (node_ptr) f,
+                 NODE_FROM_INT(RBC_CNF_EMITTED_BOTH));
+  }
+
   /* Adjust the sign of the result. */
   cd->result = (sign != 0 ? -1 * (f->iRef) : f->iRef);
 
   return;
-
 } /* End of CnfLast. */
 
 
@@ -74,7 +74,14 @@
 
 /* Rbc statistics. */
 #define RBCVAR_NO   (int)  0  /* How many variables. */
-#define RBCMAX_STAT (int)  1
+#define RBCCNFCLAUSE_NO (int) 1 /* How many clauses emitted by conversions. */
+#define RBCCNFREUSE_NO  (int) 2 /* How many nodes reused as already emitted. */
+#define RBCMAX_STAT (int)  3
+
+/* Polarities of the clauses emitted for a node (see cnfEmitted) */
+#define RBC_CNF_EMITTED_POS  1
+#define RBC_CNF_EMITTED_NEG  2
+#define RBC_CNF_EMITTED_BOTH (RBC_CNF_EMITTED_POS | RBC_CNF_EMITTED_NEG)
 
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
@@ -101,6 +108,9 @@
                       It is set during the first invocation of Rbc_Convert2Cnf;
                  <li> maxCnfVariable is maximal variable used in CNF formula,
                       used to generate new unique CNF variables.
+                 <li> cnfEmitted: RBC node -> polarities whose clauses
+                      have already been emitted into the incremental SAT
+                      solver being fed (see Rbc_CnfEmitMode);
                  <li> stats, for bookkeeping.
                  </ul>]
   SeeAlso       []
@@ -122,6 +132,8 @@ struct RbcManager {
   int maxUnchangedRbcVariable;
   int maxCnfVariable;
 
+  hash_ptr cnfEmitted;
+
   int stats[RBCMAX_STAT];
 };
 
@@ -192,12 +204,16 @@ EXTERN FILE* nusmv_stdout;
 /*---------------------------------------------------------------------------*/
 
 int Rbc_Convert2CnfSimple ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f,
-                                Slist_ptr clauses, Slist_ptr vars,
+                                Rbc_CnfEmitMode mode,
+                                Rbc_ClauseSink_t sink, void* sinkData,
+                                Slist_ptr vars,
                                 int* literalAssignedToWholeFormula));
 
 int Rbc_Convert2CnfCompact ARGS((Rbc_Manager_t* rbcManager, Rbc_t* f,
                                  int polarity,
-                                 Slist_ptr clauses, Slist_ptr vars,
+                                 Rbc_CnfEmitMode mode,
+                                 Rbc_ClauseSink_t sink, void* sinkData,
+                                 Slist_ptr vars,
                                  int* literalAssignedToWholeFormula));
 
 int Rbc_get_node_cnf ARGS((Rbc_Manager_t* rbcm, Rbc_t* f, int* maxvar));
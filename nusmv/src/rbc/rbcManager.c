@@ -143,6 +143,8 @@ Rbc_ManagerAlloc(
   rbcManager -> maxUnchangedRbcVariable = 0;
   rbcManager -> maxCnfVariable = 0;
 
+  rbcManager -> cnfEmitted = new_assoc();
+
   /* Initialize varTable. */
   for (i = 0; i < varCapacity; i++) {
     rbcManager -> varTable[i] = NIL(Rbc_t);
@@ -265,6 +267,8 @@ Rbc_ManagerFree(
   free_assoc(rbcManager -> cnfVar2rbcNode_model);
   free_assoc(rbcManager -> cnfVar2rbcNode_cnf);
 
+  free_assoc(rbcManager -> cnfEmitted);
+
   /* Free the rbc itself.  */
   FREE(rbcManager);
 
@@ -303,6 +307,9 @@ Rbc_ManagerReset(
     clear_assoc(rbcManager -> cnfVar2rbcNode_cnf);
   }
 
+  /* CNF variables are lost, so are the clauses defining them */
+  Rbc_ResetCnfEmitted(rbcManager);
+
   return;
 
 } /* End of Rbc_ManagerFree. */
@@ -0,0 +1,1214 @@
+/**CFile***********************************************************************
+
+  FileName    [rbcRewrite.c]
+
+  PackageName [rbc]
+
+  Synopsis    [Structural rewriting of formulas.]
+
+  Description [External functions included in this module:
+    <ul>
+    <li> <b>Rbc_Rewrite()</b> Balances and locally rewrites a formula
+    </ul>
+
+  The formula is flattened in topological order and rebuilt in the
+  spirit of the balancing and rewriting of And-Inverter Graphs:
+    <ul>
+    <li> every vertex is given up to RBC_REWRITE_MAX_CUTS cuts of at
+         most RBC_REWRITE_MAX_LEAVES leaves, each one with the truth
+         table of the vertex in terms of its leaves. The cone of the
+         vertex within a cut is replaced by a cheaper implementation of
+         the truth table, when the implementation needs less vertices
+         than those which the replacement frees (i.e. the maximum
+         fanout-free cone of the vertex within the cut);
+    <li> the trees of conjunctions which are not shared are collected
+         into n-ary conjunctions, and rebuilt as balanced trees
+         pairing first the operands with the lowest depth. Duplicated
+         operands are dropped, complementary operands yield falsity.
+    </ul>
+
+  The implementation of a truth table is a factoring over the
+  connectives of the rbc (conjunctions, coimplications and
+  if-then-else's) found by Shannon expansion on the cheapest top
+  variable. Costs and expansions are computed lazily, and shared by
+  all the managers.
+
+  The rewritten formula is built by means of the usual constructors,
+  so it undergoes structural hashing and the simplifications they
+  perform.]
+
+  SeeAlso     [rbcFormula.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``rbc'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#include "rbc/rbcInt.h"
+
+#include "utils/error.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: rbcRewrite.c,v 1.1.2.1 2011-03-01 10:00:00 nusmv Exp $";
+
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* The maximum number of leaves of a cut */
+#define RBC_REWRITE_MAX_LEAVES 4
+
+/* The maximum number of non trivial cuts kept for a vertex */
+#define RBC_REWRITE_MAX_CUTS 8
+
+/* The number of integers describing a flattened vertex */
+#define RBC_REWRITE_FIELDS 4
+
+/* The truth table of the constant true over RBC_REWRITE_MAX_LEAVES
+   variables */
+#define RBC_REWRITE_TT_ONE 0xFFFF
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/**Enum************************************************************************
+
+  Synopsis    [The ways a truth table is expanded on its top variable v]
+
+  Description [f0 and f1 are the negative and positive cofactors of the
+               truth table wrt v.]
+
+******************************************************************************/
+typedef enum RewriteFactor_TAG {
+  REWRITE_AND_POS,  /* f0 is false: v & f1 */
+  REWRITE_OR_NEG,   /* f0 is true: !v | f1 */
+  REWRITE_AND_NEG,  /* f1 is false: !v & f0 */
+  REWRITE_OR_POS,   /* f1 is true: v | f0 */
+  REWRITE_IFF,      /* f0 is !f1: v <-> f1 */
+  REWRITE_ITE       /* otherwise: v ? f1 : f0 */
+} RewriteFactor;
+
+/*---------------------------------------------------------------------------*/
+/* Stucture declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+  Synopsis      [A cut of a vertex.]
+  Description   [leaves are the positions of the leaves in the flattened
+                 formula, in increasing order. tt is the truth table of
+                 the vertex in terms of the leaves, the i-th leaf being
+                 the i-th variable of the table.]
+  SeeAlso       []
+******************************************************************************/
+struct RewriteCut {
+  int          leaves[RBC_REWRITE_MAX_LEAVES];
+  int          size;
+  unsigned int tt;
+};
+
+/**Struct**********************************************************************
+  Synopsis      [An operand of a balanced conjunction.]
+  Description   [key makes the order of the operands deterministic.]
+  SeeAlso       []
+******************************************************************************/
+struct RewriteOperand {
+  Rbc_t* f;
+  int    level;
+  int    key;
+};
+
+typedef struct RewriteCut     RewriteCut_t;
+typedef struct RewriteOperand RewriteOperand_t;
+
+/**Struct**********************************************************************
+  Synopsis      [Data of a rewriting.]
+  Description   [The vertices of the formula are stored in topological
+                 order (sons first) into nodes, RBC_REWRITE_FIELDS
+                 integers per vertex: the symbol, followed by the
+                 references to the sons. A reference is the position of
+                 the son shifted left by one, with the sign of the edge
+                 in the lowest bit. vertices keeps the original
+                 vertices, refs their fanout (the root counting as a
+                 reference), best the cut chosen for their
+                 replacement (with a negative size if none), results
+                 the rewritten vertices and levels their depth. leaves
+                 and stack are scratch memory to collect the operands
+                 of conjunctions.]
+  SeeAlso       []
+******************************************************************************/
+struct RewriteData {
+  Rbc_Manager_t* rbcManager;
+  int            size;
+  int            capacity;
+  int          * nodes;
+  Rbc_t       ** vertices;
+  int            root;
+
+  int          * refs;
+  RewriteCut_t * best;
+  Rbc_t       ** results;
+  int          * levels;
+
+  int          * leaves;
+  int            leavesSize;
+  int            leavesCapacity;
+  int          * stack;
+  int            stackCapacity;
+};
+
+typedef struct RewriteData RewriteData_t;
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* Truth tables of the variables */
+static const unsigned int rewrite_var_tt[RBC_REWRITE_MAX_LEAVES] =
+  { 0xAAAA, 0xCCCC, 0xF0F0, 0xFF00 };
+
+/* Costs of the truth tables, plus one (zero if not computed yet) */
+static unsigned char rewrite_cost[RBC_REWRITE_TT_ONE + 1];
+
+/* Expansions of the truth tables: top variable times 8 plus factor */
+static unsigned char rewrite_expansion[RBC_REWRITE_TT_ONE + 1];
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+#define REWRITE_NODE(rd, i) ((rd)->nodes + RBC_REWRITE_FIELDS * (i))
+
+#define REWRITE_IS_GATE(symbol) \
+  ((symbol) == RBCAND || (symbol) == RBCIFF || (symbol) == RBCITE)
+
+#define REWRITE_RESULT(rd, ref)                                         \
+  RbcId((rd)->results[(ref) >> 1], (((ref) & 1) ? RBC_FALSE : RBC_TRUE))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static int RewriteSet(Rbc_t * f, char * rewriteData, nusmv_ptrint sign);
+static void RewriteFirst(Rbc_t * f, char * rewriteData, nusmv_ptrint sign);
+static void RewriteBack(Rbc_t * f, char * rewriteData, nusmv_ptrint sign);
+static void RewriteLast(Rbc_t * f, char * rewriteData, nusmv_ptrint sign);
+static int rewrite_num_sons(int symbol);
+static void rewrite_choose_cuts(RewriteData_t * rd);
+static int rewrite_enumerate_cuts(RewriteData_t * rd, int i,
+                                  RewriteCut_t ** cuts, int * numCuts,
+                                  RewriteCut_t * res);
+static boolean rewrite_merge_leaves(const RewriteCut_t * a,
+                                    const RewriteCut_t * b,
+                                    RewriteCut_t * res);
+static unsigned int rewrite_tt_expand(unsigned int tt,
+                                      const RewriteCut_t * from,
+                                      const RewriteCut_t * to);
+static int rewrite_cone_deref(RewriteData_t * rd, int i,
+                              const RewriteCut_t * cut);
+static void rewrite_cone_ref(RewriteData_t * rd, int i,
+                             const RewriteCut_t * cut);
+static boolean rewrite_is_leaf(const RewriteCut_t * cut, int i);
+static unsigned int rewrite_cofactor(unsigned int tt, int v, int phase);
+static int rewrite_tt_cost(unsigned int tt);
+static Rbc_t* rewrite_tt_build(Rbc_Manager_t * rbcManager, unsigned int tt,
+                               Rbc_t ** leaves);
+static void rewrite_collect_conjuncts(RewriteData_t * rd, int i);
+static void rewrite_mark_needed(RewriteData_t * rd, char * needed);
+static void rewrite_build(RewriteData_t * rd, const char * needed);
+static Rbc_t* rewrite_balance(RewriteData_t * rd, int i, int * level);
+static int rewrite_operand_ptr_cmp(const void * a, const void * b);
+static int rewrite_operand_level_cmp(const void * a, const void * b);
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of external functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Balances and locally rewrites a formula.]
+
+  Description [Returns a formula equivalent to f, built on the same
+               variables, whose cones of at most four inputs have been
+               replaced by cheaper implementations and whose unshared
+               trees of conjunctions have been balanced. See the
+               description of the module for the details.]
+
+  SideEffects [The user fields of the vertices of f are changed]
+
+  SeeAlso     []
+
+******************************************************************************/
+Rbc_t* Rbc_Rewrite(Rbc_Manager_t* rbcManager, Rbc_t* f)
+{
+  Dag_DfsFunctions_t rewriteFunctions;
+  RewriteData_t      rd;
+  char             * needed;
+  Rbc_t            * res;
+  int                i, j;
+
+  /* Nothing to rewrite in constants and variables. */
+  if (!REWRITE_IS_GATE(RbcGetRef(f) -> symbol)) return f;
+
+  rd.rbcManager     = rbcManager;
+  rd.size           = 0;
+  rd.capacity       = 16;
+  rd.nodes          = ALLOC(int, RBC_REWRITE_FIELDS * rd.capacity);
+  rd.vertices       = ALLOC(Rbc_t*, rd.capacity);
+  rd.leavesSize     = 0;
+  rd.leavesCapacity = 16;
+  rd.leaves         = ALLOC(int, rd.leavesCapacity);
+  rd.stackCapacity  = 16;
+  rd.stack          = ALLOC(int, rd.stackCapacity);
+
+  /* Setting up the DFS. */
+  rewriteFunctions.Set        = RewriteSet;
+  rewriteFunctions.FirstVisit = RewriteFirst;
+  rewriteFunctions.BackVisit  = RewriteBack;
+  rewriteFunctions.LastVisit  = RewriteLast;
+
+  /* Flattening f: every vertex gets its position in iRef. */
+  Dag_Dfs(f, &rewriteFunctions, (char*)(&rd));
+  rd.root = (RbcGetRef(f) -> iRef << 1) | (RbcIsSet(f) ? 1 : 0);
+
+  /* Counting the fanouts. */
+  rd.refs = ALLOC(int, rd.size);
+  for (i = 0; i < rd.size; ++i) rd.refs[i] = 0;
+  for (i = 0; i < rd.size; ++i) {
+    const int* node = REWRITE_NODE(&rd, i);
+    for (j = 0; j < rewrite_num_sons(node[0]); ++j) {
+      ++(rd.refs[node[j + 1] >> 1]);
+    }
+  }
+  ++(rd.refs[rd.root >> 1]);
+
+  rd.best = ALLOC(RewriteCut_t, rd.size);
+  rewrite_choose_cuts(&rd);
+
+  needed = ALLOC(char, rd.size);
+  rewrite_mark_needed(&rd, needed);
+
+  rd.results = ALLOC(Rbc_t*, rd.size);
+  rd.levels = ALLOC(int, rd.size);
+  rewrite_build(&rd, needed);
+
+  res = REWRITE_RESULT(&rd, rd.root);
+
+  FREE(rd.levels);
+  FREE(rd.results);
+  FREE(needed);
+  FREE(rd.best);
+  FREE(rd.refs);
+  FREE(rd.stack);
+  FREE(rd.leaves);
+  FREE(rd.vertices);
+  FREE(rd.nodes);
+
+  return res;
+} /* End of Rbc_Rewrite. */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs Set for rewriting.]
+
+  Description [Dfs Set for rewriting.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int RewriteSet(Rbc_t* f, char* rewriteData, nusmv_ptrint sign)
+{
+  /* All nodes should be visited once and only once. */
+  return (0);
+} /* End of RewriteSet. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs FirstVisit for rewriting.]
+
+  Description [Dfs FirstVisit for rewriting.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void RewriteFirst(Rbc_t* f, char* rewriteData, nusmv_ptrint sign)
+{
+  return;
+} /* End of RewriteFirst. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs BackVisit for rewriting.]
+
+  Description [Dfs BackVisit for rewriting.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void RewriteBack(Rbc_t* f, char* rewriteData, nusmv_ptrint sign)
+{
+  return;
+} /* End of RewriteBack. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs LastVisit for rewriting.]
+
+  Description [Appends the vertex to the flattened formula. The sons
+               have all been visited already, so their positions are
+               found in their iRef field.]
+
+  SideEffects [The iRef field of f is set to its position]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void RewriteLast(Rbc_t* f, char* rewriteData, nusmv_ptrint sign)
+{
+  RewriteData_t* rd = (RewriteData_t*)rewriteData;
+  int          * node;
+  unsigned       i;
+
+  if (rd -> size == rd -> capacity) {
+    rd -> capacity *= 2;
+    rd -> nodes = REALLOC(int, rd -> nodes,
+                          RBC_REWRITE_FIELDS * rd -> capacity);
+    rd -> vertices = REALLOC(Rbc_t*, rd -> vertices, rd -> capacity);
+  }
+
+  node = REWRITE_NODE(rd, rd -> size);
+  node[0] = f -> symbol;
+
+  if (REWRITE_IS_GATE(f -> symbol)) {
+    nusmv_assert(f -> numSons < RBC_REWRITE_FIELDS);
+    for (i = 0; i < f -> numSons; ++i) {
+      Rbc_t* son = f -> outList[i];
+      node[i + 1] = (RbcGetRef(son) -> iRef << 1) | (RbcIsSet(son) ? 1 : 0);
+    }
+  }
+
+  rd -> vertices[rd -> size] = f;
+  f -> iRef = (rd -> size)++;
+
+  return;
+} /* End of RewriteLast. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of sons of a vertex with the given
+               symbol.]
+
+  Description [Returns the number of sons of a vertex with the given
+               symbol.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int rewrite_num_sons(int symbol)
+{
+  switch (symbol) {
+  case RBCAND:
+  case RBCIFF: return 2;
+  case RBCITE: return 3;
+  default: return 0;
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Chooses the cut every vertex is replaced through.]
+
+  Description [Cuts are computed bottom-up from the cuts of the sons,
+               and dropped as soon as all the fathers of their vertex
+               have been processed. The cut of a vertex which frees the
+               largest number of vertices is stored into best,
+               provided that this number is positive.]
+
+  SideEffects [best is filled]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void rewrite_choose_cuts(RewriteData_t* rd)
+{
+  RewriteCut_t** cuts = ALLOC(RewriteCut_t*, rd -> size);
+  int* numCuts = ALLOC(int, rd -> size);
+  int* pending = ALLOC(int, rd -> size);
+  int i, j;
+
+  for (i = 0; i < rd -> size; ++i) pending[i] = rd -> refs[i];
+  --(pending[rd -> root >> 1]);
+
+  for (i = 0; i < rd -> size; ++i) {
+    const int* node = REWRITE_NODE(rd, i);
+    RewriteCut_t* res = ALLOC(RewriteCut_t, RBC_REWRITE_MAX_CUTS + 1);
+    int gain = 0;
+
+    rd -> best[i].size = -1;
+    cuts[i] = res;
+
+    if (node[0] == RBCTOP) {
+      /* the constant has the empty cut only */
+      res[0].size = 0;
+      res[0].tt = RBC_REWRITE_TT_ONE;
+      numCuts[i] = 1;
+      continue;
+    }
+
+    /* the trivial cut always comes first */
+    res[0].leaves[0] = i;
+    res[0].size = 1;
+    res[0].tt = rewrite_var_tt[0];
+    numCuts[i] = 1;
+    if (node[0] == RBCVAR) continue;
+
+    numCuts[i] += rewrite_enumerate_cuts(rd, i, cuts, numCuts, res + 1);
+
+    for (j = 1; j < numCuts[i]; ++j) {
+      int freed = rewrite_cone_deref(rd, i, res + j);
+      int cost = rewrite_tt_cost(res[j].tt);
+
+      rewrite_cone_ref(rd, i, res + j);
+      if (freed - cost > gain) {
+        gain = freed - cost;
+        rd -> best[i] = res[j];
+      }
+    }
+
+    for (j = 0; j < rewrite_num_sons(node[0]); ++j) {
+      int son = node[j + 1] >> 1;
+      if (--(pending[son]) == 0) FREE(cuts[son]);
+    }
+  }
+
+  for (i = 0; i < rd -> size; ++i) {
+    if (pending[i] > 0 || i == (rd -> root >> 1)) FREE(cuts[i]);
+  }
+
+  FREE(pending);
+  FREE(numCuts);
+  FREE(cuts);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Enumerates the non trivial cuts of a gate.]
+
+  Description [Merges the cuts of the sons of the i-th vertex, and
+               stores at most RBC_REWRITE_MAX_CUTS distinct results
+               into res. Returns the number of stored cuts.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int rewrite_enumerate_cuts(RewriteData_t* rd, int i,
+                                  RewriteCut_t** cuts, int* numCuts,
+                                  RewriteCut_t* res)
+{
+  const int* node = REWRITE_NODE(rd, i);
+  const int numSons = rewrite_num_sons(node[0]);
+  RewriteCut_t empty;
+  RewriteCut_t* sonCuts[3];
+  int sonNumCuts[3];
+  int a, b, c, k, num = 0;
+
+  empty.size = 0;
+  empty.tt = RBC_REWRITE_TT_ONE;
+  for (k = 0; k < 3; ++k) {
+    if (k < numSons) {
+      sonCuts[k] = cuts[node[k + 1] >> 1];
+      sonNumCuts[k] = numCuts[node[k + 1] >> 1];
+    }
+    else {
+      sonCuts[k] = &empty;
+      sonNumCuts[k] = 1;
+    }
+  }
+
+  for (a = 0; a < sonNumCuts[0]; ++a) {
+    for (b = 0; b < sonNumCuts[1]; ++b) {
+      for (c = 0; c < sonNumCuts[2]; ++c) {
+        const RewriteCut_t* sons[3];
+        unsigned int tts[3];
+        RewriteCut_t ab, cut;
+        boolean dup = false;
+
+        sons[0] = sonCuts[0] + a;
+        sons[1] = sonCuts[1] + b;
+        sons[2] = sonCuts[2] + c;
+
+        if (!rewrite_merge_leaves(sons[0], sons[1], &ab) ||
+            !rewrite_merge_leaves(&ab, sons[2], &cut)) continue;
+
+        /* cuts with the same leaves have the same truth table */
+        for (k = 0; k < num && !dup; ++k) {
+          dup = (res[k].size == cut.size) &&
+            (memcmp(res[k].leaves, cut.leaves, cut.size * sizeof(int)) == 0);
+        }
+        if (dup) continue;
+
+        for (k = 0; k < numSons; ++k) {
+          tts[k] = rewrite_tt_expand(sons[k] -> tt, sons[k], &cut);
+          if (node[k + 1] & 1) tts[k] = ~tts[k] & RBC_REWRITE_TT_ONE;
+        }
+
+        switch (node[0]) {
+        case RBCAND: cut.tt = tts[0] & tts[1]; break;
+        case RBCIFF: cut.tt = ~(tts[0] ^ tts[1]) & RBC_REWRITE_TT_ONE; break;
+        case RBCITE: cut.tt = (tts[0] & tts[1]) | (~tts[0] & tts[2]); break;
+        default: internal_error("rewrite_enumerate_cuts: unknown RBC symbol");
+        }
+        cut.tt &= RBC_REWRITE_TT_ONE;
+
+        res[num++] = cut;
+        if (num == RBC_REWRITE_MAX_CUTS) return num;
+      }
+    }
+  }
+
+  return num;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Merges the leaves of two cuts.]
+
+  Description [Returns false if the union has too many leaves.]
+
+  SideEffects [The leaves of res are set]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean rewrite_merge_leaves(const RewriteCut_t* a,
+                                    const RewriteCut_t* b,
+                                    RewriteCut_t* res)
+{
+  int i = 0, j = 0, k = 0;
+
+  while (i < a -> size || j < b -> size) {
+    int leaf;
+
+    if (j == b -> size ||
+        (i < a -> size && a -> leaves[i] < b -> leaves[j])) {
+      leaf = a -> leaves[i++];
+    }
+    else if (i == a -> size || b -> leaves[j] < a -> leaves[i]) {
+      leaf = b -> leaves[j++];
+    }
+    else {
+      leaf = a -> leaves[i++];
+      ++j;
+    }
+
+    if (k == RBC_REWRITE_MAX_LEAVES) return false;
+    res -> leaves[k++] = leaf;
+  }
+
+  res -> size = k;
+  return true;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Expresses the truth table of a cut in terms of the leaves
+               of a larger cut.]
+
+  Description [The leaves of from must be a subset of the leaves of
+               to.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static unsigned int rewrite_tt_expand(unsigned int tt,
+                                      const RewriteCut_t* from,
+                                      const RewriteCut_t* to)
+{
+  int pos[RBC_REWRITE_MAX_LEAVES];
+  unsigned int res = 0;
+  int i, j, m;
+
+  for (i = 0, j = 0; i < from -> size; ++i) {
+    while (to -> leaves[j] != from -> leaves[i]) ++j;
+    pos[i] = j;
+  }
+
+  for (m = 0; m < (1 << RBC_REWRITE_MAX_LEAVES); ++m) {
+    int n = 0;
+    for (i = 0; i < from -> size; ++i) n |= ((m >> pos[i]) & 1) << i;
+    if ((tt >> n) & 1) res |= 1 << m;
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of vertices of the maximum fanout-free
+               cone of the i-th vertex within the given cut.]
+
+  Description [The fanouts of the cone are decremented, and must be
+               restored by rewrite_cone_ref.]
+
+  SideEffects [refs is changed]
+
+  SeeAlso     [rewrite_cone_ref]
+
+******************************************************************************/
+static int rewrite_cone_deref(RewriteData_t* rd, int i,
+                              const RewriteCut_t* cut)
+{
+  const int* node = REWRITE_NODE(rd, i);
+  int j, count = 1;
+
+  for (j = 0; j < rewrite_num_sons(node[0]); ++j) {
+    int son = node[j + 1] >> 1;
+
+    if (rewrite_is_leaf(cut, son) ||
+        !REWRITE_IS_GATE(REWRITE_NODE(rd, son)[0])) continue;
+    if (--(rd -> refs[son]) == 0) count += rewrite_cone_deref(rd, son, cut);
+  }
+
+  return count;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Restores the fanouts decremented by rewrite_cone_deref.]
+
+  Description [Restores the fanouts decremented by rewrite_cone_deref.]
+
+  SideEffects [refs is changed]
+
+  SeeAlso     [rewrite_cone_deref]
+
+******************************************************************************/
+static void rewrite_cone_ref(RewriteData_t* rd, int i,
+                             const RewriteCut_t* cut)
+{
+  const int* node = REWRITE_NODE(rd, i);
+  int j;
+
+  for (j = 0; j < rewrite_num_sons(node[0]); ++j) {
+    int son = node[j + 1] >> 1;
+
+    if (rewrite_is_leaf(cut, son) ||
+        !REWRITE_IS_GATE(REWRITE_NODE(rd, son)[0])) continue;
+    if ((rd -> refs[son])++ == 0) rewrite_cone_ref(rd, son, cut);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether the i-th vertex is a leaf of the cut.]
+
+  Description [Checks whether the i-th vertex is a leaf of the cut.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean rewrite_is_leaf(const RewriteCut_t* cut, int i)
+{
+  int j;
+
+  for (j = 0; j < cut -> size; ++j) {
+    if (cut -> leaves[j] == i) return true;
+  }
+  return false;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns a cofactor of a truth table.]
+
+  Description [The result does not depend on the v-th variable.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static unsigned int rewrite_cofactor(unsigned int tt, int v, int phase)
+{
+  const int shift = 1 << v;
+
+  if (phase) {
+    tt &= rewrite_var_tt[v];
+    return tt | (tt >> shift);
+  }
+
+  tt &= ~rewrite_var_tt[v] & RBC_REWRITE_TT_ONE;
+  return (tt | (tt << shift)) & RBC_REWRITE_TT_ONE;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of gates needed to implement a truth
+               table.]
+
+  Description [Constants, variables and negated variables cost
+               nothing. Any other function is expanded on each of the
+               variables it depends on, and the cheapest expansion is
+               recorded into rewrite_expansion. The results are
+               memoized into rewrite_cost.]
+
+  SideEffects [rewrite_cost and rewrite_expansion are filled]
+
+  SeeAlso     [rewrite_tt_build]
+
+******************************************************************************/
+static int rewrite_tt_cost(unsigned int tt)
+{
+  int best = -1;
+  int v;
+
+  if (rewrite_cost[tt] != 0) return rewrite_cost[tt] - 1;
+
+  if (tt == 0 || tt == RBC_REWRITE_TT_ONE) best = 0;
+  for (v = 0; v < RBC_REWRITE_MAX_LEAVES && best != 0; ++v) {
+    if (tt == rewrite_var_tt[v] ||
+        tt == (~rewrite_var_tt[v] & RBC_REWRITE_TT_ONE)) best = 0;
+  }
+
+  for (v = 0; v < RBC_REWRITE_MAX_LEAVES && best != 0; ++v) {
+    const unsigned int f0 = rewrite_cofactor(tt, v, 0);
+    const unsigned int f1 = rewrite_cofactor(tt, v, 1);
+    RewriteFactor factor;
+    int cost;
+
+    if (f0 == f1) continue; /* tt does not depend on v */
+
+    if (f0 == 0) {
+      factor = REWRITE_AND_POS;
+      cost = 1 + rewrite_tt_cost(f1);
+    }
+    else if (f0 == RBC_REWRITE_TT_ONE) {
+      factor = REWRITE_OR_NEG;
+      cost = 1 + rewrite_tt_cost(f1);
+    }
+    else if (f1 == 0) {
+      factor = REWRITE_AND_NEG;
+      cost = 1 + rewrite_tt_cost(f0);
+    }
+    else if (f1 == RBC_REWRITE_TT_ONE) {
+      factor = REWRITE_OR_POS;
+      cost = 1 + rewrite_tt_cost(f0);
+    }
+    else if (f0 == (~f1 & RBC_REWRITE_TT_ONE)) {
+      factor = REWRITE_IFF;
+      cost = 1 + rewrite_tt_cost(f1);
+    }
+    else {
+      factor = REWRITE_ITE;
+      cost = 1 + rewrite_tt_cost(f0) + rewrite_tt_cost(f1);
+    }
+
+    if (best < 0 || cost < best) {
+      best = cost;
+      rewrite_expansion[tt] = (unsigned char) (v * 8 + factor);
+    }
+  }
+
+  nusmv_assert(best >= 0);
+  rewrite_cost[tt] = (unsigned char) (best + 1);
+  return best;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Builds the implementation of a truth table.]
+
+  Description [The i-th variable of the truth table is leaves[i].]
+
+  SideEffects [None]
+
+  SeeAlso     [rewrite_tt_cost]
+
+******************************************************************************/
+static Rbc_t* rewrite_tt_build(Rbc_Manager_t* rbcManager, unsigned int tt,
+                               Rbc_t** leaves)
+{
+  unsigned int f0, f1;
+  Rbc_t* x;
+  int v;
+
+  if (tt == 0) return rbcManager -> zero;
+  if (tt == RBC_REWRITE_TT_ONE) return rbcManager -> one;
+  for (v = 0; v < RBC_REWRITE_MAX_LEAVES; ++v) {
+    if (tt == rewrite_var_tt[v]) return leaves[v];
+    if (tt == (~rewrite_var_tt[v] & RBC_REWRITE_TT_ONE)) {
+      return Rbc_MakeNot(rbcManager, leaves[v]);
+    }
+  }
+
+  (void) rewrite_tt_cost(tt);
+  v = rewrite_expansion[tt] / 8;
+  x = leaves[v];
+  f0 = rewrite_cofactor(tt, v, 0);
+  f1 = rewrite_cofactor(tt, v, 1);
+
+  switch ((RewriteFactor) (rewrite_expansion[tt] % 8)) {
+  case REWRITE_AND_POS:
+    return Rbc_MakeAnd(rbcManager, x,
+                       rewrite_tt_build(rbcManager, f1, leaves), RBC_TRUE);
+  case REWRITE_OR_NEG:
+    return Rbc_MakeOr(rbcManager, Rbc_MakeNot(rbcManager, x),
+                      rewrite_tt_build(rbcManager, f1, leaves), RBC_TRUE);
+  case REWRITE_AND_NEG:
+    return Rbc_MakeAnd(rbcManager, Rbc_MakeNot(rbcManager, x),
+                       rewrite_tt_build(rbcManager, f0, leaves), RBC_TRUE);
+  case REWRITE_OR_POS:
+    return Rbc_MakeOr(rbcManager, x,
+                      rewrite_tt_build(rbcManager, f0, leaves), RBC_TRUE);
+  case REWRITE_IFF:
+    return Rbc_MakeIff(rbcManager, x,
+                       rewrite_tt_build(rbcManager, f1, leaves), RBC_TRUE);
+  case REWRITE_ITE:
+    return Rbc_MakeIte(rbcManager, x,
+                       rewrite_tt_build(rbcManager, f1, leaves),
+                       rewrite_tt_build(rbcManager, f0, leaves), RBC_TRUE);
+  default:
+    internal_error("rewrite_tt_build: unknown expansion");
+  }
+
+  return (Rbc_t*) NULL;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Collects the operands of the tree of conjunctions rooted
+               at the i-th vertex.]
+
+  Description [The tree goes through the positive edges to conjunctions
+               with a single father which are not replaced through a
+               cut. The references to the operands are stored into
+               leaves.]
+
+  SideEffects [leaves is filled]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void rewrite_collect_conjuncts(RewriteData_t* rd, int i)
+{
+  int top = 0;
+
+  rd -> leavesSize = 0;
+  rd -> stack[top++] = REWRITE_NODE(rd, i)[2];
+  rd -> stack[top++] = REWRITE_NODE(rd, i)[1];
+
+  while (top > 0) {
+    const int ref = rd -> stack[--top];
+    const int son = ref >> 1;
+
+    if (((ref & 1) == 0) && (REWRITE_NODE(rd, son)[0] == RBCAND) &&
+        (rd -> refs[son] == 1) && (rd -> best[son].size < 0)) {
+      if (top + 2 > rd -> stackCapacity) {
+        rd -> stackCapacity *= 2;
+        rd -> stack = REALLOC(int, rd -> stack, rd -> stackCapacity);
+      }
+      rd -> stack[top++] = REWRITE_NODE(rd, son)[2];
+      rd -> stack[top++] = REWRITE_NODE(rd, son)[1];
+    }
+    else {
+      if (rd -> leavesSize == rd -> leavesCapacity) {
+        rd -> leavesCapacity *= 2;
+        rd -> leaves = REALLOC(int, rd -> leaves, rd -> leavesCapacity);
+      }
+      rd -> leaves[(rd -> leavesSize)++] = ref;
+    }
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Marks the vertices whose rewriting is needed to build the
+               result.]
+
+  Description [Vertices are visited top-down. A needed vertex needs the
+               leaves of its cut if it has one, the operands of its tree
+               of conjunctions if it is a conjunction, its sons
+               otherwise.]
+
+  SideEffects [needed is filled]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void rewrite_mark_needed(RewriteData_t* rd, char* needed)
+{
+  int i, j;
+
+  for (i = 0; i < rd -> size; ++i) needed[i] = 0;
+  needed[rd -> root >> 1] = 1;
+
+  for (i = rd -> size - 1; i >= 0; --i) {
+    const int* node = REWRITE_NODE(rd, i);
+
+    if (!needed[i]) continue;
+
+    if (rd -> best[i].size >= 0) {
+      for (j = 0; j < rd -> best[i].size; ++j) {
+        needed[rd -> best[i].leaves[j]] = 1;
+      }
+    }
+    else if (node[0] == RBCAND) {
+      rewrite_collect_conjuncts(rd, i);
+      for (j = 0; j < rd -> leavesSize; ++j) needed[rd -> leaves[j] >> 1] = 1;
+    }
+    else {
+      for (j = 0; j < rewrite_num_sons(node[0]); ++j) {
+        needed[node[j + 1] >> 1] = 1;
+      }
+    }
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Builds the rewriting of the needed vertices.]
+
+  Description [Vertices are built bottom-up, so that the results of
+               their leaves, operands or sons are already available.]
+
+  SideEffects [results and levels are filled]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void rewrite_build(RewriteData_t* rd, const char* needed)
+{
+  Rbc_Manager_t* rbcManager = rd -> rbcManager;
+  int i, j;
+
+  for (i = 0; i < rd -> size; ++i) {
+    const int* node = REWRITE_NODE(rd, i);
+    const RewriteCut_t* cut = rd -> best + i;
+
+    rd -> results[i] = (Rbc_t*) NULL;
+    rd -> levels[i] = 0;
+    if (!needed[i]) continue;
+
+    if (!REWRITE_IS_GATE(node[0])) {
+      rd -> results[i] = rd -> vertices[i];
+    }
+    else if (cut -> size >= 0) {
+      Rbc_t* leaves[RBC_REWRITE_MAX_LEAVES];
+      int level = 0;
+
+      for (j = 0; j < cut -> size; ++j) {
+        leaves[j] = rd -> results[cut -> leaves[j]];
+        level = MAX(level, rd -> levels[cut -> leaves[j]]);
+      }
+      rd -> results[i] = rewrite_tt_build(rbcManager, cut -> tt, leaves);
+      rd -> levels[i] = level + rewrite_tt_cost(cut -> tt);
+    }
+    else if (node[0] == RBCAND) {
+      rd -> results[i] = rewrite_balance(rd, i, rd -> levels + i);
+    }
+    else {
+      int level = 0;
+
+      for (j = 0; j < rewrite_num_sons(node[0]); ++j) {
+        level = MAX(level, rd -> levels[node[j + 1] >> 1]);
+      }
+      rd -> levels[i] = level + 1;
+
+      if (node[0] == RBCIFF) {
+        rd -> results[i] =
+          Rbc_MakeIff(rbcManager, REWRITE_RESULT(rd, node[1]),
+                      REWRITE_RESULT(rd, node[2]), RBC_TRUE);
+      }
+      else {
+        rd -> results[i] =
+          Rbc_MakeIte(rbcManager, REWRITE_RESULT(rd, node[1]),
+                      REWRITE_RESULT(rd, node[2]),
+                      REWRITE_RESULT(rd, node[3]), RBC_TRUE);
+      }
+    }
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Builds the balanced tree of conjunctions rooted at the
+               i-th vertex.]
+
+  Description [The depth of the result is stored into level.]
+
+  SideEffects [None]
+
+  SeeAlso     [rewrite_collect_conjuncts]
+
+******************************************************************************/
+static Rbc_t* rewrite_balance(RewriteData_t* rd, int i, int* level)
+{
+  Rbc_Manager_t* rbcManager = rd -> rbcManager;
+  RewriteOperand_t* ops;
+  Rbc_t* res;
+  int j, n;
+
+  rewrite_collect_conjuncts(rd, i);
+  ops = ALLOC(RewriteOperand_t, rd -> leavesSize);
+
+  for (j = 0; j < rd -> leavesSize; ++j) {
+    ops[j].f = REWRITE_RESULT(rd, rd -> leaves[j]);
+    ops[j].level = rd -> levels[rd -> leaves[j] >> 1];
+    ops[j].key = rd -> leaves[j];
+  }
+
+  /* Drops duplicated operands and truth, detects complementary ones. */
+  qsort(ops, rd -> leavesSize, sizeof(RewriteOperand_t),
+        rewrite_operand_ptr_cmp);
+  for (j = 0, n = 0; j < rd -> leavesSize; ++j) {
+    if (ops[j].f == rbcManager -> one) continue;
+    if (ops[j].f == rbcManager -> zero ||
+        (n > 0 && RbcGetRef(ops[n - 1].f) == RbcGetRef(ops[j].f) &&
+         ops[n - 1].f != ops[j].f)) {
+      FREE(ops);
+      *level = 0;
+      return rbcManager -> zero;
+    }
+    if (n == 0 || ops[n - 1].f != ops[j].f) ops[n++] = ops[j];
+  }
+
+  /* Pairs the two shallowest operands, until one is left. */
+  qsort(ops, n, sizeof(RewriteOperand_t), rewrite_operand_level_cmp);
+  while (n > 1) {
+    RewriteOperand_t op;
+
+    op.f = Rbc_MakeAnd(rbcManager, ops[n - 2].f, ops[n - 1].f, RBC_TRUE);
+    op.level = MAX(ops[n - 2].level, ops[n - 1].level) + 1;
+    op.key = ops[n - 2].key;
+    n -= 2;
+
+    for (j = n; j > 0 && ops[j - 1].level < op.level; --j) {
+      ops[j] = ops[j - 1];
+    }
+    ops[j] = op;
+    ++n;
+  }
+
+  if (n == 0) {
+    res = rbcManager -> one;
+    *level = 0;
+  }
+  else {
+    res = ops[0].f;
+    *level = ops[0].level;
+  }
+
+  FREE(ops);
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Orders operands by their formula.]
+
+  Description [A formula and its negation are adjacent. Ties are
+               broken on the position in the formula.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int rewrite_operand_ptr_cmp(const void* a, const void* b)
+{
+  const nusmv_ptruint fa = (nusmv_ptruint) ((const RewriteOperand_t*) a)->f;
+  const nusmv_ptruint fb = (nusmv_ptruint) ((const RewriteOperand_t*) b)->f;
+
+  if (fa < fb) return -1;
+  if (fa > fb) return 1;
+  return ((const RewriteOperand_t*) a)->key - ((const RewriteOperand_t*) b)->key;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Orders operands by decreasing depth.]
+
+  Description [Ties are broken on the position in the formula, for the
+               result not to depend on the addresses of the vertices.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int rewrite_operand_level_cmp(const void* a, const void* b)
+{
+  const RewriteOperand_t* oa = (const RewriteOperand_t*) a;
+  const RewriteOperand_t* ob = (const RewriteOperand_t*) b;
+
+  if (oa -> level != ob -> level) return ob -> level - oa -> level;
+  return oa -> key - ob -> key;
+}
@@ -0,0 +1,728 @@
+/**CFile***********************************************************************
+
+  FileName    [rbcSim.c]
+
+  PackageName [rbc]
+
+  Synopsis    [Bit-parallel simulation of formulas.]
+
+  Description [External functions included in this module:
+    <ul>
+    <li> <b>Rbc_SimCreate()</b> Compiles a set of formulas
+    <li> <b>Rbc_SimDestroy()</b> Frees a compiled set of formulas
+    <li> <b>Rbc_SimGetSize()</b> Returns the number of instructions
+    <li> <b>Rbc_SimRun()</b> Evaluates a compiled set of formulas
+    <li> <b>Rbc_ExtractDefinitions()</b> Extracts the functional
+         definitions of variables from a formula
+    </ul>
+
+  The formulas are linearized once, in the order the DFS leaves the
+  vertices (sons first), into a flat array of instructions. Evaluating
+  them is then a single loop over the array, which computes
+  RBC_SIM_WORDS words (64 patterns each) of every vertex at a time, and
+  never looks at the DAG again.
+
+  Rbc_ExtractDefinitions splits a relation, such as the transition
+  relation of a model, into functions computing some of its variables
+  and a residual constraint, so that the relation can be simulated
+  forward: the definitions give the values of the defined variables,
+  the remaining ones are chosen at random and the constraint filters
+  the patterns which are not consistent with the relation.]
+
+  SeeAlso     [rbcSweep.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``rbc'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#include "rbc/rbcInt.h"
+
+#include "utils/error.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: rbcSim.c,v 1.1.2.1 2011-03-08 10:00:00 nusmv Exp $";
+
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* The number of integers describing an instruction */
+#define RBC_SIM_FIELDS 4
+
+/*---------------------------------------------------------------------------*/
+/* Stucture declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+  Synopsis      [A compiled set of formulas.]
+  Description   [code holds RBC_SIM_FIELDS integers per instruction: the
+                 symbol of the vertex, followed either by the index of
+                 the variable (RBCVAR) or by the references to the sons.
+                 A reference is the position of the son shifted left by
+                 one, with the sign of the edge in the lowest bit. roots
+                 holds the references to the compiled formulas, values
+                 the RBC_SIM_WORDS words of every instruction.]
+  SeeAlso       []
+******************************************************************************/
+struct RbcSim {
+  int                 size;
+  int                 capacity;
+  int               * code;
+  int                 numRoots;
+  int               * roots;
+  unsigned long long* values;
+};
+
+/**Struct**********************************************************************
+  Synopsis      [Data of a definitions extraction.]
+  Description   [vars are the num definable variables, positions maps
+                 every variable index to its position in vars (-1 if it
+                 is not definable), found is set by the support check.]
+  SeeAlso       []
+******************************************************************************/
+struct SimDefData {
+  const int * vars;
+  int         num;
+  int       * positions;
+  int         size;
+  boolean     found;
+};
+
+typedef struct SimDefData SimDefData_t;
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+#define SIM_CODE(sim, i) ((sim)->code + RBC_SIM_FIELDS * (i))
+
+#define SIM_VALUE(sim, ref) ((sim)->values + RBC_SIM_WORDS * ((ref) >> 1))
+
+#define SIM_MASK(ref) (((ref) & 1) ? ~0ULL : 0ULL)
+
+#define SIM_REF(f)                                                      \
+  (((RbcGetRef(f) -> iRef - 1) << 1) | (RbcIsSet(f) ? 1 : 0))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static int SimSet(Rbc_t * f, char * simData, nusmv_ptrint sign);
+static void SimFirst(Rbc_t * f, char * simData, nusmv_ptrint sign);
+static void SimBack(Rbc_t * f, char * simData, nusmv_ptrint sign);
+static void SimLast(Rbc_t * f, char * simData, nusmv_ptrint sign);
+static int DefSet(Rbc_t * f, char * defData, nusmv_ptrint sign);
+static void DefFirst(Rbc_t * f, char * defData, nusmv_ptrint sign);
+static void DefBack(Rbc_t * f, char * defData, nusmv_ptrint sign);
+static void DefLast(Rbc_t * f, char * defData, nusmv_ptrint sign);
+static Rbc_t *
+sim_extract(Rbc_Manager_t * rbcManager, SimDefData_t * dd, Rbc_t * f,
+            Rbc_t ** defs);
+static int sim_definable_var(SimDefData_t * dd, Rbc_t * f, Rbc_t ** defs);
+static boolean sim_depends_on_definable(SimDefData_t * dd, Rbc_t * f);
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of external functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Compiles a set of formulas for bit-parallel simulation.]
+
+  Description [The num formulas in roots are linearized into a flat
+               array of instructions, which can be evaluated by
+               Rbc_SimRun as many times as needed. The returned
+               structure must be freed with Rbc_SimDestroy.]
+
+  SideEffects [The user fields of the vertices of the formulas are
+               changed]
+
+  SeeAlso     [Rbc_SimRun, Rbc_SimDestroy]
+
+******************************************************************************/
+Rbc_Sim_t* Rbc_SimCreate(Rbc_Manager_t* rbcManager, Rbc_t** roots, int num)
+{
+  Dag_DfsFunctions_t simFunctions;
+  Rbc_Sim_t* sim = ALLOC(Rbc_Sim_t, 1);
+  int k;
+
+  nusmv_assert(sim != (Rbc_Sim_t*) NULL);
+
+  sim -> size     = 0;
+  sim -> capacity = 16;
+  sim -> code     = ALLOC(int, RBC_SIM_FIELDS * sim -> capacity);
+  sim -> numRoots = num;
+  sim -> roots    = ALLOC(int, (num > 0) ? num : 1);
+
+  /* Setting up the DFS. */
+  simFunctions.Set        = SimSet;
+  simFunctions.FirstVisit = SimFirst;
+  simFunctions.BackVisit  = SimBack;
+  simFunctions.LastVisit  = SimLast;
+
+  /* Linearizing the formulas: every vertex gets its position plus one
+     in iRef, which is zero for the vertices not linearized yet. */
+  for (k = 0; k < num; ++k) Dag_Dfs(roots[k], &dag_DfsClean, NIL(char));
+  for (k = 0; k < num; ++k) {
+    Dag_Dfs(roots[k], &simFunctions, (char*)sim);
+    sim -> roots[k] = SIM_REF(roots[k]);
+  }
+
+  sim -> values = ALLOC(unsigned long long,
+                        RBC_SIM_WORDS * ((sim -> size > 0) ? sim -> size : 1));
+
+  return sim;
+} /* End of Rbc_SimCreate. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Frees a compiled set of formulas.]
+
+  Description [Frees a compiled set of formulas.]
+
+  SideEffects [None]
+
+  SeeAlso     [Rbc_SimCreate]
+
+******************************************************************************/
+void Rbc_SimDestroy(Rbc_Sim_t* sim)
+{
+  FREE(sim -> values);
+  FREE(sim -> roots);
+  FREE(sim -> code);
+  FREE(sim);
+} /* End of Rbc_SimDestroy. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of instructions of a compiled set of
+               formulas.]
+
+  Description [Returns the number of instructions of a compiled set of
+               formulas.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+int Rbc_SimGetSize(const Rbc_Sim_t* sim)
+{
+  return sim -> size;
+} /* End of Rbc_SimGetSize. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Evaluates a compiled set of formulas.]
+
+  Description [vars holds RBC_SIM_WORDS words for every variable index
+               (the words of the variable of index i start at
+               vars[i * RBC_SIM_WORDS]), and must cover all the
+               variables of the formulas. The RBC_SIM_WORDS words of the
+               k-th formula are stored at out[k * RBC_SIM_WORDS].]
+
+  SideEffects [out is filled]
+
+  SeeAlso     [Rbc_SimCreate]
+
+******************************************************************************/
+void Rbc_SimRun(Rbc_Sim_t* sim, const unsigned long long* vars,
+                unsigned long long* out)
+{
+  unsigned long long* val = sim -> values;
+  const int* code = sim -> code;
+  int i, k, w;
+
+  for (i = 0; i < sim -> size; ++i, code += RBC_SIM_FIELDS,
+         val += RBC_SIM_WORDS) {
+    switch (code[0]) {
+    case RBCTOP:
+      for (w = 0; w < RBC_SIM_WORDS; ++w) val[w] = ~0ULL;
+      break;
+
+    case RBCVAR: {
+      const unsigned long long* v = vars + RBC_SIM_WORDS * code[1];
+      for (w = 0; w < RBC_SIM_WORDS; ++w) val[w] = v[w];
+      break;
+    }
+
+    case RBCAND: {
+      const unsigned long long* a = SIM_VALUE(sim, code[1]);
+      const unsigned long long* b = SIM_VALUE(sim, code[2]);
+      const unsigned long long ma = SIM_MASK(code[1]);
+      const unsigned long long mb = SIM_MASK(code[2]);
+      for (w = 0; w < RBC_SIM_WORDS; ++w) val[w] = (a[w] ^ ma) & (b[w] ^ mb);
+      break;
+    }
+
+    case RBCIFF: {
+      const unsigned long long* a = SIM_VALUE(sim, code[1]);
+      const unsigned long long* b = SIM_VALUE(sim, code[2]);
+      const unsigned long long m = ~(SIM_MASK(code[1]) ^ SIM_MASK(code[2]));
+      for (w = 0; w < RBC_SIM_WORDS; ++w) val[w] = a[w] ^ b[w] ^ m;
+      break;
+    }
+
+    case RBCITE: {
+      const unsigned long long* c = SIM_VALUE(sim, code[1]);
+      const unsigned long long* t = SIM_VALUE(sim, code[2]);
+      const unsigned long long* e = SIM_VALUE(sim, code[3]);
+      const unsigned long long mc = SIM_MASK(code[1]);
+      const unsigned long long mt = SIM_MASK(code[2]);
+      const unsigned long long me = SIM_MASK(code[3]);
+      for (w = 0; w < RBC_SIM_WORDS; ++w) {
+        const unsigned long long cw = c[w] ^ mc;
+        val[w] = (cw & (t[w] ^ mt)) | (~cw & (e[w] ^ me));
+      }
+      break;
+    }
+
+    default:
+      internal_error("Rbc_SimRun: unknown RBC symbol");
+    }
+  }
+
+  for (k = 0; k < sim -> numRoots; ++k) {
+    const unsigned long long* r = SIM_VALUE(sim, sim -> roots[k]);
+    const unsigned long long m = SIM_MASK(sim -> roots[k]);
+    for (w = 0; w < RBC_SIM_WORDS; ++w) out[RBC_SIM_WORDS * k + w] = r[w] ^ m;
+  }
+} /* End of Rbc_SimRun. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Extracts the functional definitions of variables from a
+               formula.]
+
+  Description [f is seen as the conjunction of its top-level conjuncts.
+               Every conjunct of the form v, !v or (v <-> g), where v is
+               one of the num variables whose indices are in vars, v has
+               not been defined by a previous conjunct and g depends on
+               none of the variables in vars, defines v: the function of
+               v (the constant, or g) is stored in defs at the position
+               of v in vars. The other positions of defs are set to
+               NIL(Rbc_t). f is equivalent to the returned formula (the
+               conjunction of the remaining conjuncts) in conjunction
+               with the definitions. Conjuncts of the form ITE(c, t, e),
+               such as the ones coming from case expressions, are split
+               recursively when c depends on none of the variables in
+               vars.]
+
+  SideEffects [defs is filled. The user fields of the vertices of f are
+               changed]
+
+  SeeAlso     [Rbc_SimCreate]
+
+******************************************************************************/
+Rbc_t* Rbc_ExtractDefinitions(Rbc_Manager_t* rbcManager, Rbc_t* f,
+                              const int* vars, int num, Rbc_t** defs)
+{
+  SimDefData_t dd;
+  Rbc_t* rest;
+  int i;
+
+  dd.vars = vars;
+  dd.num = num;
+  dd.size = Rbc_ManagerCapacity(rbcManager);
+  dd.positions = ALLOC(int, dd.size > 0 ? dd.size : 1);
+  for (i = 0; i < dd.size; ++i) dd.positions[i] = -1;
+  for (i = 0; i < num; ++i) {
+    nusmv_assert(vars[i] >= 0 && vars[i] < dd.size);
+    dd.positions[vars[i]] = i;
+    defs[i] = NIL(Rbc_t);
+  }
+
+  rest = sim_extract(rbcManager, &dd, f, defs);
+
+  FREE(dd.positions);
+
+  return rest;
+} /* End of Rbc_ExtractDefinitions. */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs Set for compiling.]
+
+  Description [Skips the vertices linearized by the DFS of a previous
+               formula.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int SimSet(Rbc_t* f, char* simData, nusmv_ptrint sign)
+{
+  return (f -> iRef != 0) ? 1 : 0;
+} /* End of SimSet. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs FirstVisit for compiling.]
+
+  Description [Dfs FirstVisit for compiling.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void SimFirst(Rbc_t* f, char* simData, nusmv_ptrint sign)
+{
+  return;
+} /* End of SimFirst. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs BackVisit for compiling.]
+
+  Description [Dfs BackVisit for compiling.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void SimBack(Rbc_t* f, char* simData, nusmv_ptrint sign)
+{
+  return;
+} /* End of SimBack. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs LastVisit for compiling.]
+
+  Description [Appends the instruction of the vertex. The sons have all
+               been linearized already, so their positions are found in
+               their iRef field.]
+
+  SideEffects [The iRef field of f is set to its position plus one]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void SimLast(Rbc_t* f, char* simData, nusmv_ptrint sign)
+{
+  Rbc_Sim_t* sim = (Rbc_Sim_t*)simData;
+  int      * code;
+  unsigned   i;
+
+  if (sim -> size == sim -> capacity) {
+    sim -> capacity *= 2;
+    sim -> code = REALLOC(int, sim -> code, RBC_SIM_FIELDS * sim -> capacity);
+  }
+
+  code = SIM_CODE(sim, sim -> size);
+  code[0] = f -> symbol;
+
+  if (f -> symbol == RBCVAR) {
+    code[1] = PTR_TO_INT(f -> data);
+  }
+  else if (f -> symbol != RBCTOP) {
+    nusmv_assert(f -> numSons < RBC_SIM_FIELDS);
+    for (i = 0; i < f -> numSons; ++i) code[i + 1] = SIM_REF(f -> outList[i]);
+  }
+
+  f -> iRef = ++(sim -> size);
+
+  return;
+} /* End of SimLast. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs Set for the support check.]
+
+  Description [Stops the visit as soon as a definable variable has been
+               found.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int DefSet(Rbc_t* f, char* defData, nusmv_ptrint sign)
+{
+  return ((SimDefData_t*)defData) -> found ? 1 : 0;
+} /* End of DefSet. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs FirstVisit for the support check.]
+
+  Description [Dfs FirstVisit for the support check.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void DefFirst(Rbc_t* f, char* defData, nusmv_ptrint sign)
+{
+  return;
+} /* End of DefFirst. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs BackVisit for the support check.]
+
+  Description [Dfs BackVisit for the support check.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void DefBack(Rbc_t* f, char* defData, nusmv_ptrint sign)
+{
+  return;
+} /* End of DefBack. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs LastVisit for the support check.]
+
+  Description [Records whether the vertex is a definable variable.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void DefLast(Rbc_t* f, char* defData, nusmv_ptrint sign)
+{
+  SimDefData_t* dd = (SimDefData_t*)defData;
+
+  if (f -> symbol == RBCVAR) {
+    const int idx = PTR_TO_INT(f -> data);
+    if (idx < dd -> size && dd -> positions[idx] >= 0) dd -> found = true;
+  }
+} /* End of DefLast. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Extracts the definitions from a formula.]
+
+  Description [Does the job of Rbc_ExtractDefinitions, on the positions
+               of defs which are still NIL(Rbc_t). A conjunct of the
+               form ITE(c, t, e), where c depends on no definable
+               variable, is split as well: the definitions extracted
+               from both t and e are merged into ITE(c, dt, de), the
+               ones extracted from a single branch are put back into
+               it.]
+
+  SideEffects [defs is filled]
+
+  SeeAlso     [Rbc_ExtractDefinitions]
+
+******************************************************************************/
+static Rbc_t* sim_extract(Rbc_Manager_t* rbcManager, SimDefData_t* dd,
+                          Rbc_t* f, Rbc_t** defs)
+{
+  Rbc_t* rest = rbcManager -> one;
+  Rbc_t** stack;
+  int sp, stackSize;
+
+  /* the top-level conjuncts are visited left to right */
+  stackSize = 16;
+  stack = ALLOC(Rbc_t*, stackSize);
+  sp = 0;
+  stack[sp++] = f;
+  while (sp > 0) {
+    Rbc_t* c = stack[--sp];
+    Rbc_t* ref = RbcGetRef(c);
+
+    if (ref -> symbol == RBCAND && !RbcIsSet(c)) {
+      if (sp + 2 > stackSize) {
+        stackSize *= 2;
+        stack = REALLOC(Rbc_t*, stack, stackSize);
+      }
+      stack[sp++] = ref -> outList[1];
+      stack[sp++] = ref -> outList[0];
+      continue;
+    }
+
+    if (c == rbcManager -> one) continue;
+
+    if (ref -> symbol == RBCVAR) {
+      const int pos = sim_definable_var(dd, c, defs);
+      if (pos >= 0) {
+        defs[pos] = RbcIsSet(c) ? rbcManager -> zero : rbcManager -> one;
+        continue;
+      }
+    }
+    else if (ref -> symbol == RBCIFF) {
+      boolean done = false;
+      int s;
+
+      for (s = 0; s < 2 && !done; ++s) {
+        Rbc_t* v = ref -> outList[s];
+        Rbc_t* g = ref -> outList[1 - s];
+        const int pos = sim_definable_var(dd, v, defs);
+
+        if (pos >= 0 && !sim_depends_on_definable(dd, g)) {
+          /* c is (v <-> g), or its negation */
+          defs[pos] = RbcId(g, ((RbcIsSet(v) != RbcIsSet(c)) ?
+                                RBC_FALSE : RBC_TRUE));
+          done = true;
+        }
+      }
+      if (done) continue;
+    }
+    else if (ref -> symbol == RBCITE &&
+             !sim_depends_on_definable(dd, ref -> outList[0])) {
+      /* the sign of c is pushed into the branches */
+      const Rbc_Bool_c sign = RbcIsSet(c) ? RBC_FALSE : RBC_TRUE;
+      Rbc_t** defsT = ALLOC(Rbc_t*, dd -> num + 1);
+      Rbc_t** defsE = ALLOC(Rbc_t*, dd -> num + 1);
+      Rbc_t* restT;
+      Rbc_t* restE;
+      int i;
+
+      for (i = 0; i < dd -> num; ++i) defsT[i] = defsE[i] = defs[i];
+      restT = sim_extract(rbcManager, dd,
+                          RbcId(ref -> outList[1], sign), defsT);
+      restE = sim_extract(rbcManager, dd,
+                          RbcId(ref -> outList[2], sign), defsE);
+
+      for (i = 0; i < dd -> num; ++i) {
+        Rbc_t* v;
+
+        if (defs[i] != NIL(Rbc_t)) continue;
+
+        if (defsT[i] != NIL(Rbc_t) && defsE[i] != NIL(Rbc_t)) {
+          defs[i] = Rbc_MakeIte(rbcManager, ref -> outList[0],
+                                defsT[i], defsE[i], RBC_TRUE);
+          continue;
+        }
+
+        v = Rbc_GetIthVar(rbcManager, dd -> vars[i]);
+        if (defsT[i] != NIL(Rbc_t)) {
+          restT = Rbc_MakeAnd(rbcManager, restT,
+                    Rbc_MakeIff(rbcManager, v, defsT[i], RBC_TRUE),
+                    RBC_TRUE);
+        }
+        else if (defsE[i] != NIL(Rbc_t)) {
+          restE = Rbc_MakeAnd(rbcManager, restE,
+                    Rbc_MakeIff(rbcManager, v, defsE[i], RBC_TRUE),
+                    RBC_TRUE);
+        }
+      }
+      FREE(defsE);
+      FREE(defsT);
+
+      c = Rbc_MakeIte(rbcManager, ref -> outList[0], restT, restE, RBC_TRUE);
+    }
+
+    rest = Rbc_MakeAnd(rbcManager, rest, c, RBC_TRUE);
+  }
+
+  FREE(stack);
+
+  return rest;
+} /* End of sim_extract. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the position of a definable variable not defined
+               yet.]
+
+  Description [Returns -1 if f is not a variable, or is not definable,
+               or has been defined already.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int sim_definable_var(SimDefData_t* dd, Rbc_t* f, Rbc_t** defs)
+{
+  Rbc_t* ref = RbcGetRef(f);
+  int idx, pos;
+
+  if (ref -> symbol != RBCVAR) return -1;
+
+  idx = PTR_TO_INT(ref -> data);
+  if (idx >= dd -> size) return -1;
+
+  pos = dd -> positions[idx];
+  if (pos < 0 || defs[pos] != NIL(Rbc_t)) return -1;
+
+  return pos;
+} /* End of sim_definable_var. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether a formula depends on a definable
+               variable.]
+
+  Description [Checks whether a formula depends on a definable
+               variable.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean sim_depends_on_definable(SimDefData_t* dd, Rbc_t* f)
+{
+  Dag_DfsFunctions_t defFunctions;
+
+  defFunctions.Set        = DefSet;
+  defFunctions.FirstVisit = DefFirst;
+  defFunctions.BackVisit  = DefBack;
+  defFunctions.LastVisit  = DefLast;
+
+  dd -> found = false;
+  Dag_Dfs(f, &defFunctions, (char*)dd);
+
+  return dd -> found;
+} /* End of sim_depends_on_definable. */
@@ -11,6 +11,8 @@
     <li> <b>Rbc_Subst()</b> Substitute variables with variables
     <li> <b>Rbc_Shift()</b> Shift the variables along an offset 
     <li> <b>Rbc_SubstRbc()</b> Substitute variables with formulas
+    <li> <b>Rbc_ShiftTemplateCreate()</b> Flatten a formula for repeated
+         shifting
     </ul>]
     
   SeeAlso     []
@@ -102,9 +104,41 @@ struct SubstRbcDfsData {
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
 
+/**Struct**********************************************************************
+  Synopsis      [A formula flattened for repeated shifting.]
+  Description   [The vertices of the formula are stored in topological
+                 order (sons first) into nodes, RBC_TEMPLATE_FIELDS
+                 integers per vertex: the symbol, followed by the
+                 logical index of the variable for RBCVAR vertices, or
+                 by the references to the sons for the other
+                 vertices. A reference is the position of the son in
+                 the array shifted left by one, with the sign of the
+                 edge in the lowest bit. results is used as scratch
+                 memory while the template is applied.]
+  SeeAlso       []
+******************************************************************************/
+struct RbcShiftTemplate {
+  int     size;
+  int     capacity;
+  int   * nodes;
+  int     root;
+  Rbc_t** results;
+};
+
+/**Struct**********************************************************************
+  Synopsis      [Data passing in template-DFS.]
+  Description   [Data passing in template-DFS.]
+  SeeAlso       []
+******************************************************************************/
+struct TemplateDfsData {
+  Rbc_ShiftTemplate_t* tmpl;
+  const int          * phy2log;
+};
+
 typedef struct SubstDfsData     SubstDfsData_t;
 typedef struct ShiftDfsData     ShiftDfsData_t;
 typedef struct SubstRbcDfsData  SubstRbcDfsData_t;
+typedef struct TemplateDfsData  TemplateDfsData_t;
 
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
@@ -115,6 +149,11 @@ typedef struct SubstRbcDfsData  SubstRbcDfsData_t;
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+#define RBC_TEMPLATE_FIELDS 4
+
+#define RBC_TEMPLATE_REF(tmpl, ref)                                     \
+  RbcId((tmpl)->results[(ref) >> 1], (((ref) & 1) ? RBC_FALSE : RBC_TRUE))
+
 
 /**AutomaticStart*************************************************************/
 
@@ -138,6 +177,13 @@ static void SubstRbcBack(Rbc_t * f, char * SubstRbcData, nusmv_ptrint sign);
 static void SubstRbcLast(Rbc_t * f, char * SubstRbcData, nusmv_ptrint sign);
 static void LogicalSubstRbcLast(Rbc_t * f, char * SubstRbcData, 
         nusmv_ptrint sign);
+static int TemplateSet(Rbc_t * f, char * templateData, nusmv_ptrint sign);
+static void TemplateFirst(Rbc_t * f, char * templateData, nusmv_ptrint sign);
+static void TemplateBack(Rbc_t * f, char * templateData, nusmv_ptrint sign);
+static void TemplateLast(Rbc_t * f, char * templateData, nusmv_ptrint sign);
+static Rbc_t* ShiftTemplateApply(Rbc_Manager_t * rbcManager,
+                                 Rbc_ShiftTemplate_t * tmpl, int shift,
+                                 int * subst, const int * log2phy);
 
 /**AutomaticEnd***************************************************************/
 
@@ -524,10 +570,313 @@ Rbc_t* Rbc_LogicalSubstRbc(Rbc_Manager_t* rbcManager,
 } /* End of Rbc_SubstRbc. */
 
 
+/**Function********************************************************************
+
+  Synopsis    [Flattens the rbc F(X) into a template for repeated
+               logical shifting and substitution.]
+
+  Description [The formula is visited once, and its vertices are stored
+               into a flat array in topological order, with the
+               variables taken at LOGICAL level through phy2log. The
+               template can then be applied with
+               Rbc_ShiftTemplateApply or Rbc_ShiftTemplateApplySubst
+               any number of times: every application is a linear
+               sweep over the array, with no DFS, no cleaning of the
+               dag and no temporary allocation.
+
+               The template does not refer to the vertices of f, but
+               it depends on the logical level: it must be destroyed
+               when phy2log changes.]
+
+  SideEffects [The user fields of the vertices of f are changed]
+
+  SeeAlso     [Rbc_LogicalShift, Rbc_ShiftTemplateDestroy]
+
+******************************************************************************/
+Rbc_ShiftTemplate_t* Rbc_ShiftTemplateCreate(Rbc_Manager_t* rbcManager,
+                                             Rbc_t* f, const int* phy2log)
+{
+  Dag_DfsFunctions_t  templateFunctions;
+  TemplateDfsData_t   templateData;
+  Rbc_ShiftTemplate_t* tmpl = ALLOC(Rbc_ShiftTemplate_t, 1);
+  nusmv_assert(tmpl != (Rbc_ShiftTemplate_t*) NULL);
+
+  tmpl->size = 0;
+  tmpl->capacity = 16;
+  tmpl->nodes = ALLOC(int, RBC_TEMPLATE_FIELDS * tmpl->capacity);
+  tmpl->results = (Rbc_t**) NULL;
+
+  /* Setting up the DFS. */
+  templateFunctions.Set        = TemplateSet;
+  templateFunctions.FirstVisit = TemplateFirst;
+  templateFunctions.BackVisit  = TemplateBack;
+  templateFunctions.LastVisit  = TemplateLast;
+
+  /* Setting up the DFS data. */
+  templateData.tmpl    = tmpl;
+  templateData.phy2log = phy2log;
+
+  /* Calling DFS on f: every vertex gets its position in iRef. */
+  Dag_Dfs(f, &templateFunctions, (char*)(&templateData));
+
+  tmpl->root = (RbcGetRef(f)->iRef << 1) | (RbcIsSet(f) ? 1 : 0);
+  tmpl->results = ALLOC(Rbc_t*, tmpl->size);
+
+  return tmpl;
+} /* End of Rbc_ShiftTemplateCreate. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Destroys a template.]
+
+  Description [Destroys a template.]
+
+  SideEffects [None]
+
+  SeeAlso     [Rbc_ShiftTemplateCreate]
+
+******************************************************************************/
+void Rbc_ShiftTemplateDestroy(Rbc_ShiftTemplate_t* tmpl)
+{
+  FREE(tmpl->results);
+  FREE(tmpl->nodes);
+  FREE(tmpl);
+} /* End of Rbc_ShiftTemplateDestroy. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of vertices of a template.]
+
+  Description [Returns the number of vertices of a template.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+int Rbc_ShiftTemplateGetSize(const Rbc_ShiftTemplate_t* tmpl)
+{
+  return tmpl->size;
+} /* End of Rbc_ShiftTemplateGetSize. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Builds F(X') from the template of F(X), X' being X shifted
+               by a certain amount at logical level.]
+
+  Description [Same as Rbc_LogicalShift on the formula the template has
+               been created from, with the same phy2log.]
+
+  SideEffects [None]
+
+  SeeAlso     [Rbc_LogicalShift, Rbc_ShiftTemplateCreate]
+
+******************************************************************************/
+Rbc_t* Rbc_ShiftTemplateApply(Rbc_Manager_t* rbcManager,
+                              Rbc_ShiftTemplate_t* tmpl,
+                              int shift, const int* log2phy)
+{
+  return ShiftTemplateApply(rbcManager, tmpl, shift, (int*) NULL, log2phy);
+} /* End of Rbc_ShiftTemplateApply. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Builds F(Y) from the template of F(X), where Y is given by
+               a substitution at logical level.]
+
+  Description [Same as Rbc_LogicalSubst on the formula the template has
+               been created from, with the same phy2log.]
+
+  SideEffects [None]
+
+  SeeAlso     [Rbc_LogicalSubst, Rbc_ShiftTemplateCreate]
+
+******************************************************************************/
+Rbc_t* Rbc_ShiftTemplateApplySubst(Rbc_Manager_t* rbcManager,
+                                   Rbc_ShiftTemplate_t* tmpl,
+                                   int* subst, const int* log2phy)
+{
+  return ShiftTemplateApply(rbcManager, tmpl, 0, subst, log2phy);
+} /* End of Rbc_ShiftTemplateApplySubst. */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of static functions                                            */
 /*---------------------------------------------------------------------------*/
 
+/**Function********************************************************************
+
+  Synopsis    [Dfs Set for templates.]
+
+  Description [Dfs Set for templates.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int TemplateSet(Rbc_t* f, char* templateData, nusmv_ptrint sign)
+{
+  /* All nodes should be visited once and only once. */
+  return (0);
+} /* End of TemplateSet. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs FirstVisit for templates.]
+
+  Description [Dfs FirstVisit for templates.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void TemplateFirst(Rbc_t* f, char* templateData, nusmv_ptrint sign)
+{
+  return;
+} /* End of TemplateFirst. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs BackVisit for templates.]
+
+  Description [Dfs BackVisit for templates.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void TemplateBack(Rbc_t* f, char* templateData, nusmv_ptrint sign)
+{
+  return;
+} /* End of TemplateBack. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs LastVisit for templates.]
+
+  Description [Appends the vertex to the template. The sons have all
+               been visited already, so their positions are found in
+               their iRef field.]
+
+  SideEffects [The iRef field of f is set to its position]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void TemplateLast(Rbc_t* f, char* templateData, nusmv_ptrint sign)
+{
+  TemplateDfsData_t  * td   = (TemplateDfsData_t*)templateData;
+  Rbc_ShiftTemplate_t* tmpl = td -> tmpl;
+  int                * node;
+  unsigned             i;
+
+  if (tmpl -> size == tmpl -> capacity) {
+    tmpl -> capacity *= 2;
+    tmpl -> nodes = REALLOC(int, tmpl -> nodes,
+                            RBC_TEMPLATE_FIELDS * tmpl -> capacity);
+  }
+
+  node = tmpl -> nodes + RBC_TEMPLATE_FIELDS * tmpl -> size;
+  node[0] = f -> symbol;
+
+  if (f -> symbol == RBCVAR) {
+    node[1] = td -> phy2log[PTR_TO_INT(f -> data)];
+  }
+  else if (f -> symbol != RBCTOP) {
+    nusmv_assert(f -> numSons < RBC_TEMPLATE_FIELDS);
+    for (i = 0; i < f -> numSons; ++i) {
+      Rbc_t* son = f -> outList[i];
+      node[i + 1] = (RbcGetRef(son) -> iRef << 1) | (RbcIsSet(son) ? 1 : 0);
+    }
+  }
+
+  f -> iRef = (tmpl -> size)++;
+
+  return;
+} /* End of TemplateLast. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Applies a template.]
+
+  Description [Variables are shifted by shift if subst is NULL,
+               substituted through subst otherwise.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static Rbc_t* ShiftTemplateApply(Rbc_Manager_t* rbcManager,
+                                 Rbc_ShiftTemplate_t* tmpl, int shift,
+                                 int* subst, const int* log2phy)
+{
+  int i;
+
+  for (i = 0; i < tmpl -> size; ++i) {
+    const int* node = tmpl -> nodes + RBC_TEMPLATE_FIELDS * i;
+
+    switch (node[0]) {
+    case RBCTOP:
+      tmpl -> results[i] = rbcManager -> one;
+      break;
+
+    case RBCVAR:
+      {
+        int idx;
+
+        if (subst == (int*) NULL) idx = node[1] + shift;
+        else {
+          idx = subst[node[1]];
+          if (RBC_INVALID_SUBST_VALUE == idx) {
+            internal_error("%s: Tried to substitute an invalid index",
+                           __func__);
+          }
+        }
+        tmpl -> results[i] = Rbc_GetIthVar(rbcManager, log2phy[idx]);
+        break;
+      }
+
+    /* Substitutions may trigger simplifications. */
+    case RBCAND:
+      tmpl -> results[i] =
+        Rbc_MakeAnd(rbcManager, RBC_TEMPLATE_REF(tmpl, node[1]),
+                    RBC_TEMPLATE_REF(tmpl, node[2]), RBC_TRUE);
+      break;
+
+    case RBCIFF:
+      tmpl -> results[i] =
+        Rbc_MakeIff(rbcManager, RBC_TEMPLATE_REF(tmpl, node[1]),
+                    RBC_TEMPLATE_REF(tmpl, node[2]), RBC_TRUE);
+      break;
+
+    case RBCITE:
+      tmpl -> results[i] =
+        Rbc_MakeIte(rbcManager, RBC_TEMPLATE_REF(tmpl, node[1]),
+                    RBC_TEMPLATE_REF(tmpl, node[2]),
+                    RBC_TEMPLATE_REF(tmpl, node[3]), RBC_TRUE);
+      break;
+
+    default:
+      internal_error("ShiftTemplateApply: unknown RBC symbol");
+    }
+  }
+
+  return RBC_TEMPLATE_REF(tmpl, tmpl -> root);
+} /* End of ShiftTemplateApply. */
+
+
 /**Function********************************************************************
 
   Synopsis    [Dfs Set for substitution.]
@@ -0,0 +1,582 @@
+/**CFile***********************************************************************
+
+  FileName    [rbcSweep.c]
+
+  PackageName [rbc]
+
+  Synopsis    [SAT sweeping of formulas.]
+
+  Description [External functions included in this module:
+    <ul>
+    <li> <b>Rbc_Sweep()</b> Merges the functionally equivalent vertices
+         of a set of formulas
+    </ul>
+
+  The formulas are flattened in topological order, and every vertex is
+  simulated on 64 random patterns per word of simulation. Vertices
+  whose simulation is the same, or the complement, are candidate
+  equivalences. The formulas are then rebuilt bottom-up: every rebuilt
+  vertex is compared with the vertices of its class which have been
+  rebuilt before, and replaced by the first one the prover given by the
+  caller shows to be equivalent (or complementary). Vertices which
+  simulate to a constant are compared with the constant first.
+
+  Since the sons of a vertex are replaced by their representatives
+  before the vertex itself is compared, the prover always works on
+  formulas whose equivalent sub-formulas have already been merged.
+
+  Counterexamples of the prover are not given back to the simulation:
+  a vertex which is not merged becomes a further representative of its
+  class, and at most RBC_SWEEP_MAX_TRIES representatives are tried for
+  each vertex.]
+
+  SeeAlso     [rbcRewrite.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``rbc'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#include "rbc/rbcInt.h"
+
+#include "utils/error.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: rbcSweep.c,v 1.1.2.1 2011-03-01 10:00:00 nusmv Exp $";
+
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* The number of integers describing a flattened vertex */
+#define RBC_SWEEP_FIELDS 4
+
+/* The maximum number of representatives a vertex is compared with */
+#define RBC_SWEEP_MAX_TRIES 3
+
+/* The seed of the random simulation */
+#define RBC_SWEEP_SEED 0x9E3779B97F4A7C15ULL
+
+/*---------------------------------------------------------------------------*/
+/* Stucture declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+  Synopsis      [Data of a sweeping.]
+  Description   [The vertices of the formulas are stored in topological
+                 order (sons first) into nodes, RBC_SWEEP_FIELDS integers
+                 per vertex: the symbol, followed by the references to
+                 the sons. A reference is the position of the son shifted
+                 left by one, with the sign of the edge in the lowest
+                 bit. vertices keeps the original vertices, sims their
+                 simulation (words integers per vertex), results the
+                 rebuilt vertices.
+
+                 Classes are chained lists of the vertices which are
+                 representatives of a simulation, hashed into buckets
+                 (numBuckets is a power of two). Simulations are
+                 normalized so that their first bit is zero, phases
+                 tells whether the simulation of a vertex has been
+                 complemented to this purpose.]
+  SeeAlso       []
+******************************************************************************/
+struct SweepData {
+  Rbc_Manager_t     * rbcManager;
+  int                 size;
+  int                 capacity;
+  int               * nodes;
+  Rbc_t            ** vertices;
+
+  int                 words;
+  unsigned long long* sims;
+  char              * phases;
+  Rbc_t            ** results;
+
+  int               * buckets;
+  int                 numBuckets;
+  int               * next;
+};
+
+typedef struct SweepData SweepData_t;
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+#define SWEEP_NODE(sd, i) ((sd)->nodes + RBC_SWEEP_FIELDS * (i))
+
+#define SWEEP_SIM(sd, i) ((sd)->sims + (sd)->words * (i))
+
+#define SWEEP_RESULT(sd, ref)                                           \
+  RbcId((sd)->results[(ref) >> 1], (((ref) & 1) ? RBC_FALSE : RBC_TRUE))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static int SweepSet(Rbc_t * f, char * sweepData, nusmv_ptrint sign);
+static void SweepFirst(Rbc_t * f, char * sweepData, nusmv_ptrint sign);
+static void SweepBack(Rbc_t * f, char * sweepData, nusmv_ptrint sign);
+static void SweepLast(Rbc_t * f, char * sweepData, nusmv_ptrint sign);
+static void sweep_simulate(SweepData_t * sd);
+static unsigned long long sweep_random(unsigned long long * state);
+static int sweep_bucket(SweepData_t * sd, int i);
+static boolean sweep_same_sim(SweepData_t * sd, int i, int j);
+static boolean sweep_is_const_sim(SweepData_t * sd, int i);
+static Rbc_t* sweep_rebuild(SweepData_t * sd, int i);
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of external functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Merges the functionally equivalent vertices of a set of
+               formulas.]
+
+  Description [Each of the num formulas in roots is replaced by an
+               equivalent formula, in which the vertices the prover has
+               shown to be equivalent (or complementary) are merged.
+               prover(a, b, proverData) must return true only if a and b
+               are equivalent. words is the number of 64-bit words of
+               random simulation used to find the candidate
+               equivalences. If merged is not NULL, the number of merged
+               vertices is stored into it. See the description of the
+               module for the details.]
+
+  SideEffects [roots is changed. The user fields of the vertices of the
+               formulas are changed]
+
+  SeeAlso     []
+
+******************************************************************************/
+void Rbc_Sweep(Rbc_Manager_t* rbcManager, Rbc_t** roots, int num,
+               int words, Rbc_EquivProver_t prover, void* proverData,
+               int* merged)
+{
+  Dag_DfsFunctions_t sweepFunctions;
+  SweepData_t        sd;
+  int              * rootRefs;
+  int                i, k, count = 0;
+
+  nusmv_assert(words > 0);
+
+  sd.rbcManager = rbcManager;
+  sd.size       = 0;
+  sd.capacity   = 16;
+  sd.nodes      = ALLOC(int, RBC_SWEEP_FIELDS * sd.capacity);
+  sd.vertices   = ALLOC(Rbc_t*, sd.capacity);
+  sd.words      = words;
+
+  /* Setting up the DFS. */
+  sweepFunctions.Set        = SweepSet;
+  sweepFunctions.FirstVisit = SweepFirst;
+  sweepFunctions.BackVisit  = SweepBack;
+  sweepFunctions.LastVisit  = SweepLast;
+
+  /* Flattening the formulas: every vertex gets its position plus one in
+     iRef, which is zero for the vertices not flattened yet. */
+  for (k = 0; k < num; ++k) Dag_Dfs(roots[k], &dag_DfsClean, NIL(char));
+  for (k = 0; k < num; ++k) Dag_Dfs(roots[k], &sweepFunctions, (char*)(&sd));
+
+  /* The prover may convert formulas, and change iRef. */
+  rootRefs = ALLOC(int, num);
+  for (k = 0; k < num; ++k) {
+    rootRefs[k] = ((RbcGetRef(roots[k]) -> iRef - 1) << 1) |
+      (RbcIsSet(roots[k]) ? 1 : 0);
+  }
+
+  sd.sims = ALLOC(unsigned long long, sd.words * sd.size);
+  sd.phases = ALLOC(char, sd.size);
+  sweep_simulate(&sd);
+
+  for (sd.numBuckets = 1; sd.numBuckets < 2 * sd.size; sd.numBuckets <<= 1);
+  sd.buckets = ALLOC(int, sd.numBuckets);
+  for (i = 0; i < sd.numBuckets; ++i) sd.buckets[i] = -1;
+  sd.next = ALLOC(int, sd.size);
+  sd.results = ALLOC(Rbc_t*, sd.size);
+
+  for (i = 0; i < sd.size; ++i) {
+    const int symbol = SWEEP_NODE(&sd, i)[0];
+    Rbc_t* res;
+    int b, j, tries = 0;
+    boolean found = false;
+
+    if (symbol == RBCTOP) {
+      sd.results[i] = sd.vertices[i];
+      continue;
+    }
+
+    b = sweep_bucket(&sd, i);
+
+    /* variables can only be representatives */
+    if (symbol == RBCVAR) {
+      sd.results[i] = sd.vertices[i];
+      sd.next[i] = sd.buckets[b];
+      sd.buckets[b] = i;
+      continue;
+    }
+
+    res = sweep_rebuild(&sd, i);
+    sd.results[i] = res;
+    if (RbcGetRef(res) -> symbol == RBCTOP) continue;
+
+    if (sweep_is_const_sim(&sd, i)) {
+      Rbc_t* cnst = sd.phases[i] ? rbcManager -> one : rbcManager -> zero;
+
+      ++tries;
+      if (prover(res, cnst, proverData)) {
+        sd.results[i] = cnst;
+        ++count;
+        continue;
+      }
+    }
+
+    for (j = sd.buckets[b]; j >= 0 && !found && tries < RBC_SWEEP_MAX_TRIES;
+         j = sd.next[j]) {
+      Rbc_t* cand;
+
+      if (!sweep_same_sim(&sd, i, j)) continue;
+
+      cand = RbcId(sd.results[j],
+                   ((sd.phases[i] != sd.phases[j]) ? RBC_FALSE : RBC_TRUE));
+      /* the rebuilding may have merged them already */
+      if (cand != res) {
+        ++tries;
+        if (!prover(res, cand, proverData)) continue;
+        ++count;
+      }
+
+      sd.results[i] = cand;
+      found = true;
+    }
+
+    if (!found) {
+      sd.next[i] = sd.buckets[b];
+      sd.buckets[b] = i;
+    }
+  }
+
+  for (k = 0; k < num; ++k) roots[k] = SWEEP_RESULT(&sd, rootRefs[k]);
+  if (merged != (int*) NULL) *merged = count;
+
+  FREE(sd.results);
+  FREE(sd.next);
+  FREE(sd.buckets);
+  FREE(sd.phases);
+  FREE(sd.sims);
+  FREE(rootRefs);
+  FREE(sd.vertices);
+  FREE(sd.nodes);
+} /* End of Rbc_Sweep. */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs Set for sweeping.]
+
+  Description [Skips the vertices flattened by the DFS of a previous
+               formula.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int SweepSet(Rbc_t* f, char* sweepData, nusmv_ptrint sign)
+{
+  return (f -> iRef != 0) ? 1 : 0;
+} /* End of SweepSet. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs FirstVisit for sweeping.]
+
+  Description [Dfs FirstVisit for sweeping.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void SweepFirst(Rbc_t* f, char* sweepData, nusmv_ptrint sign)
+{
+  return;
+} /* End of SweepFirst. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs BackVisit for sweeping.]
+
+  Description [Dfs BackVisit for sweeping.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void SweepBack(Rbc_t* f, char* sweepData, nusmv_ptrint sign)
+{
+  return;
+} /* End of SweepBack. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Dfs LastVisit for sweeping.]
+
+  Description [Appends the vertex to the flattened formulas. The sons
+               have all been visited already, so their positions are
+               found in their iRef field.]
+
+  SideEffects [The iRef field of f is set to its position plus one]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void SweepLast(Rbc_t* f, char* sweepData, nusmv_ptrint sign)
+{
+  SweepData_t* sd = (SweepData_t*)sweepData;
+  int        * node;
+  unsigned     i;
+
+  if (sd -> size == sd -> capacity) {
+    sd -> capacity *= 2;
+    sd -> nodes = REALLOC(int, sd -> nodes,
+                          RBC_SWEEP_FIELDS * sd -> capacity);
+    sd -> vertices = REALLOC(Rbc_t*, sd -> vertices, sd -> capacity);
+  }
+
+  node = SWEEP_NODE(sd, sd -> size);
+  node[0] = f -> symbol;
+
+  if (f -> symbol != RBCVAR && f -> symbol != RBCTOP) {
+    nusmv_assert(f -> numSons < RBC_SWEEP_FIELDS);
+    for (i = 0; i < f -> numSons; ++i) {
+      Rbc_t* son = f -> outList[i];
+      node[i + 1] =
+        ((RbcGetRef(son) -> iRef - 1) << 1) | (RbcIsSet(son) ? 1 : 0);
+    }
+  }
+
+  sd -> vertices[sd -> size] = f;
+  f -> iRef = ++(sd -> size);
+
+  return;
+} /* End of SweepLast. */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Simulates the flattened formulas.]
+
+  Description [Variables get random values, the same ones at every
+               sweeping. The simulations are normalized afterwards.]
+
+  SideEffects [sims and phases are filled]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void sweep_simulate(SweepData_t* sd)
+{
+  unsigned long long state = RBC_SWEEP_SEED;
+  int i, w;
+
+  for (i = 0; i < sd -> size; ++i) {
+    const int* node = SWEEP_NODE(sd, i);
+    unsigned long long* sim = SWEEP_SIM(sd, i);
+    const unsigned long long* s[3];
+    unsigned long long m[3];
+    unsigned k;
+
+    if (node[0] != RBCVAR && node[0] != RBCTOP) {
+      for (k = 0; k < sd -> vertices[i] -> numSons; ++k) {
+        s[k] = SWEEP_SIM(sd, node[k + 1] >> 1);
+        m[k] = (node[k + 1] & 1) ? ~0ULL : 0ULL;
+      }
+    }
+
+    for (w = 0; w < sd -> words; ++w) {
+      switch (node[0]) {
+      case RBCTOP: sim[w] = ~0ULL; break;
+      case RBCVAR: sim[w] = sweep_random(&state); break;
+      case RBCAND: sim[w] = (s[0][w] ^ m[0]) & (s[1][w] ^ m[1]); break;
+      case RBCIFF: sim[w] = ~((s[0][w] ^ m[0]) ^ (s[1][w] ^ m[1])); break;
+      case RBCITE:
+        sim[w] = ((s[0][w] ^ m[0]) & (s[1][w] ^ m[1])) |
+          (~(s[0][w] ^ m[0]) & (s[2][w] ^ m[2]));
+        break;
+      default: internal_error("sweep_simulate: unknown RBC symbol");
+      }
+    }
+  }
+
+  /* Normalization: sons have been simulated, so it can be done now */
+  for (i = 0; i < sd -> size; ++i) {
+    unsigned long long* sim = SWEEP_SIM(sd, i);
+
+    sd -> phases[i] = (char) (sim[0] & 1);
+    if (sd -> phases[i]) {
+      for (w = 0; w < sd -> words; ++w) sim[w] = ~sim[w];
+    }
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the next pseudo-random number.]
+
+  Description [xorshift64*]
+
+  SideEffects [state is updated]
+
+  SeeAlso     []
+
+******************************************************************************/
+static unsigned long long sweep_random(unsigned long long* state)
+{
+  *state ^= *state >> 12;
+  *state ^= *state << 25;
+  *state ^= *state >> 27;
+  return *state * 2685821657736338717ULL;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the bucket of the simulation of a vertex.]
+
+  Description [Returns the bucket of the simulation of a vertex.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static int sweep_bucket(SweepData_t* sd, int i)
+{
+  const unsigned long long* sim = SWEEP_SIM(sd, i);
+  unsigned long long h = 0;
+  int w;
+
+  for (w = 0; w < sd -> words; ++w) {
+    h = (h ^ sim[w]) * 0x100000001B3ULL;
+    h ^= h >> 29;
+  }
+
+  return (int) (h & (unsigned long long) (sd -> numBuckets - 1));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether two vertices have the same normalized
+               simulation.]
+
+  Description [Checks whether two vertices have the same normalized
+               simulation.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean sweep_same_sim(SweepData_t* sd, int i, int j)
+{
+  return memcmp(SWEEP_SIM(sd, i), SWEEP_SIM(sd, j),
+                sd -> words * sizeof(unsigned long long)) == 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether a vertex simulates to a constant.]
+
+  Description [The constant is given by the phase of the vertex.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean sweep_is_const_sim(SweepData_t* sd, int i)
+{
+  const unsigned long long* sim = SWEEP_SIM(sd, i);
+  int w;
+
+  for (w = 0; w < sd -> words; ++w) {
+    if (sim[w] != 0ULL) return false;
+  }
+  return true;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Rebuilds a vertex on the results of its sons.]
+
+  Description [Rebuilds a vertex on the results of its sons.]
+
+  SideEffects [None]
+
+  SeeAlso     []
+
+******************************************************************************/
+static Rbc_t* sweep_rebuild(SweepData_t* sd, int i)
+{
+  const int* node = SWEEP_NODE(sd, i);
+
+  switch (node[0]) {
+  case RBCAND:
+    return Rbc_MakeAnd(sd -> rbcManager, SWEEP_RESULT(sd, node[1]),
+                       SWEEP_RESULT(sd, node[2]), RBC_TRUE);
+  case RBCIFF:
+    return Rbc_MakeIff(sd -> rbcManager, SWEEP_RESULT(sd, node[1]),
+                       SWEEP_RESULT(sd, node[2]), RBC_TRUE);
+  case RBCITE:
+    return Rbc_MakeIte(sd -> rbcManager, SWEEP_RESULT(sd, node[1]),
+                       SWEEP_RESULT(sd, node[2]),
+                       SWEEP_RESULT(sd, node[3]), RBC_TRUE);
+  default:
+    internal_error("sweep_rebuild: unknown RBC symbol");
+  }
+
+  return (Rbc_t*) NULL;
+}
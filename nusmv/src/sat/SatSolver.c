@@ -41,15 +41,37 @@
 #include "satInt.h" /* just for 'options' */
 #include "SatSolver_private.h"
 #include "utils/error.h"
+#include "utils/Profile.h"
 
 /*---------------------------------------------------------------------------*/
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [The data of the clause sink used by SatSolver_add_be]
+
+  Description []
+
+  SeeAlso     [SatSolver_add_be]
+
+******************************************************************************/
+typedef struct SatSolverClauseSink_TAG
+{
+  SatSolver_ptr solver;
+  SatSolverGroup group;
+} SatSolverClauseSink;
+
 /*---------------------------------------------------------------------------*/
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 static void sat_solver_finalize ARGS((Object_ptr object, void *dummy));
+static void sat_solver_clause_sink ARGS((void* data, const int* clause,
+                                         int size));
 
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
@@ -140,6 +162,101 @@ SatSolver_add(const SatSolver_ptr self, const Be_Cnf_ptr cnfProb,
   self->add(self, cnfProb, group);
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Converts a BE into CNF and adds it to a group]
+
+  Description [Same as converting prob with Be_ConvertToCnf and adding
+  the result with SatSolver_add, but the clauses are loaded into the
+  solver while they are generated, so the CNF is never kept in memory.
+
+  The returned Be_Cnf does not contain the clauses, and cannot be
+  dumped. It is meant to be given to SatSolver_set_polarity. The
+  caller is responsible for deleting it (via Be_Cnf_Delete).]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_add, Be_ConvertToCnfSink]
+
+******************************************************************************/
+Be_Cnf_ptr
+SatSolver_add_be(const SatSolver_ptr self, Be_Manager_ptr be_mgr,
+                 be_ptr prob, int polarity, SatSolverGroup group)
+{
+  SatSolverClauseSink sink;
+
+  SAT_SOLVER_CHECK_INSTANCE(self);
+
+  sink.solver = self;
+  sink.group = group;
+
+  /* constants are not passed to the sink, and are not added to the
+     solver as SatSolver_add does (see SatSolver_set_polarity) */
+  return Be_ConvertToCnfSink(be_mgr, prob, polarity, BE_CNF_EMIT_ALL,
+                             sat_solver_clause_sink, (void*) &sink);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Converts a BE into CNF and adds to a group the clauses
+  the solver has not received yet]
+
+  Description [Same as SatSolver_add_be, but the clauses of the
+  sub-formulae of prob that have already been added to the permanent
+  group of this solver are not converted again. The clauses added to
+  the permanent group are recorded in the BE manager, the ones added
+  to any other group are not, as the group may be destroyed.
+
+  The records refer to a single solver: they must be cleared with
+  Be_ResetCnfEmitted before feeding another solver this way, and when
+  this solver is destroyed.]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_add_be, Be_ResetCnfEmitted]
+
+******************************************************************************/
+Be_Cnf_ptr
+SatSolver_add_be_new(const SatSolver_ptr self, Be_Manager_ptr be_mgr,
+                     be_ptr prob, int polarity, SatSolverGroup group)
+{
+  SatSolverClauseSink sink;
+  Be_CnfEmitMode mode;
+
+  SAT_SOLVER_CHECK_INSTANCE(self);
+
+  sink.solver = self;
+  sink.group = group;
+
+  mode = (group == SatSolver_get_permanent_group(self)) ?
+    BE_CNF_EMIT_NEW_MARK : BE_CNF_EMIT_NEW;
+
+  return Be_ConvertToCnfSink(be_mgr, prob, polarity, mode,
+                             sat_solver_clause_sink, (void*) &sink);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Adds a single clause to a group]
+
+  Description [The clause is made of the 'size' CNF literals of
+  'clause'. This is meant for clauses which are not built from BEs,
+  like the ones over the activation literals allocated with
+  Be_NewCnfVar.]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_add_be, Be_NewCnfVar]
+
+******************************************************************************/
+void
+SatSolver_add_clause(const SatSolver_ptr self, const int* clause, int size,
+                     SatSolverGroup group)
+{
+  SAT_SOLVER_CHECK_INSTANCE(self);
+  self->add_clause(self, clause, size, group);
+}
+
 /**Function*********************************************************************
 
   Synopsis    [Sets the polarity of a CNF formula in a group]
@@ -285,7 +402,11 @@ SatSolverResult SatSolver_solve_all_groups(const SatSolver_ptr self)
   if (0 != Olist_get_size(self->unsatisfiableGroups)) {
     result = SAT_SOLVER_UNSATISFIABLE_PROBLEM;
   }
-  else result = self->solve_all_groups(self);
+  else {
+    Profile_begin("sat_solve");
+    result = self->solve_all_groups(self);
+    Profile_end("sat_solve");
+  }
 
   self->solvingTime = util_cpu_time() - self->solvingTime;
 
@@ -318,8 +439,10 @@ SatSolverResult SatSolver_solve_all_groups_assume(const SatSolver_ptr self,
   SAT_SOLVER_CHECK_INSTANCE(self);
 
   /* destroy the model of previous solving */
-  Slist_destroy(self->model);
-  self->model = (Slist_ptr)NULL;
+  if ((Slist_ptr)NULL != self->model) {
+    Slist_destroy(self->model);
+    self->model = (Slist_ptr)NULL;
+  }
 
   if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
     fprintf(nusmv_stderr, "Invoking solver '%s'...\n",
@@ -328,7 +451,9 @@ SatSolverResult SatSolver_solve_all_groups_assume(const SatSolver_ptr self,
 
   self->solvingTime = util_cpu_time();
 
+  Profile_begin("sat_solve");
   result = self->solve_all_groups_assume(self, assumptions);
+  Profile_end("sat_solve");
 
   self->solvingTime = util_cpu_time() - self->solvingTime;
 
@@ -358,11 +483,8 @@ Slist_ptr SatSolver_get_conflicts(const SatSolver_ptr self)
 {
   SAT_SOLVER_CHECK_INSTANCE(self);
 
-  if ((Slist_ptr)NULL == self->conflicts) {
-    self->conflicts = self->get_conflicts(self);
-  }
-
-  return self->conflicts;
+  /* the list belongs to the solver, which renews it at every solving */
+  return self->get_conflicts(self);
 }
 
 /**Function********************************************************************
@@ -464,6 +586,30 @@ int SatSolver_get_polarity_mode(const SatSolver_ptr self)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Returns the CNF literals the solver has proved to be
+  implied by the added formulas]
+
+  Description [The literals are the ones fixed at the top level, so
+  they hold in every model of the formulas added so far in any group,
+  and can be safely added as unit clauses to the permanent group of a
+  solver containing (at least) the same formulas. Solvers which do not
+  expose their top level assignment return an empty list. The
+  returned list belongs to the caller.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+Slist_ptr SatSolver_get_fixed_literals(const SatSolver_ptr self)
+{
+  SAT_SOLVER_CHECK_INSTANCE(self);
+  return self->get_fixed_literals(self);
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Returns the name of the solver]
@@ -574,6 +720,25 @@ void sat_solver_add(const SatSolver_ptr self,
   error_unreachable_code(); /* Pure Virtual Member Function */
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Pure virtual function, adds a clause to a group]
+
+  Description [It is a pure virtual function and SatSolver is an abstract
+  base class. Every derived class must ovewrwrite this function.]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_add_be]
+
+******************************************************************************/
+void sat_solver_add_clause(const SatSolver_ptr self,
+                           const int* clause, int size,
+                           SatSolverGroup group)
+{
+  error_unreachable_code(); /* Pure Virtual Member Function */
+}
+
 /**Function********************************************************************
 
   Synopsis    [Pure virtual function, sets the polarity of a formula ]
@@ -753,6 +918,25 @@ int sat_solver_get_polarity_mode(const SatSolver_ptr self)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Virtual function, returns the literals fixed at the top
+  level]
+
+  Description [The default implementation knows nothing about the top
+  level assignment of the solver, and returns an empty list.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+Slist_ptr sat_solver_get_fixed_literals(const SatSolver_ptr self)
+{
+  return Slist_create();
+}
+
+
 /**Function********************************************************************
 
   Synopsis    []
@@ -857,6 +1041,7 @@ void sat_solver_init(SatSolver_ptr self, const char* name)
 
   OVERRIDE(Object, finalize) = sat_solver_finalize;
   OVERRIDE(SatSolver, add) = sat_solver_add;
+  OVERRIDE(SatSolver, add_clause) = sat_solver_add_clause;
   OVERRIDE(SatSolver, set_polarity) = sat_solver_set_polarity;
   OVERRIDE(SatSolver, solve_all_groups) = sat_solver_solve_all_groups;
   OVERRIDE(SatSolver, solve_all_groups_assume) =
@@ -867,6 +1052,7 @@ void sat_solver_init(SatSolver_ptr self, const char* name)
   OVERRIDE(SatSolver, set_random_mode) = sat_solver_set_random_mode;
   OVERRIDE(SatSolver, set_polarity_mode) = sat_solver_set_polarity_mode;
   OVERRIDE(SatSolver, get_polarity_mode) = sat_solver_get_polarity_mode;
+  OVERRIDE(SatSolver, get_fixed_literals) = sat_solver_get_fixed_literals;
   OVERRIDE(SatSolver, curr_itp_group) = sat_solver_curr_itp_group;
   OVERRIDE(SatSolver, new_itp_group) = sat_solver_new_itp_group;
   OVERRIDE(SatSolver, extract_interpolant) = sat_solver_extract_interpolant;
@@ -940,3 +1126,22 @@ static void sat_solver_finalize(Object_ptr object, void* dummy)
   sat_solver_deinit(self);
   error_unreachable_code();
 }
+
+
+/**Function********************************************************************
+
+  Synopsis    [The clause sink of SatSolver_add_be]
+
+  Description [Adds the clause to the solver and group given in data]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_add_be]
+
+******************************************************************************/
+static void sat_solver_clause_sink(void* data, const int* clause, int size)
+{
+  SatSolverClauseSink* sink = (SatSolverClauseSink*) data;
+
+  sink->solver->add_clause(sink->solver, clause, size, sink->group);
+}
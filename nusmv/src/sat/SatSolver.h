@@ -114,6 +114,21 @@ SatSolver_add ARGS((const SatSolver_ptr self,
                     const Be_Cnf_ptr cnfProb,
                     SatSolverGroup group));
 
+EXTERN Be_Cnf_ptr
+SatSolver_add_be ARGS((const SatSolver_ptr self,
+                       Be_Manager_ptr be_mgr, be_ptr prob, int polarity,
+                       SatSolverGroup group));
+
+EXTERN Be_Cnf_ptr
+SatSolver_add_be_new ARGS((const SatSolver_ptr self,
+                           Be_Manager_ptr be_mgr, be_ptr prob, int polarity,
+                           SatSolverGroup group));
+
+EXTERN void
+SatSolver_add_clause ARGS((const SatSolver_ptr self,
+                           const int* clause, int size,
+                           SatSolverGroup group));
+
 EXTERN VIRTUAL void
 SatSolver_set_polarity ARGS((const SatSolver_ptr self,
                              const Be_Cnf_ptr cnfProb,
@@ -151,6 +166,9 @@ SatSolver_set_polarity_mode ARGS((SatSolver_ptr self, int mode));
 EXTERN VIRTUAL int
 SatSolver_get_polarity_mode ARGS((const SatSolver_ptr self));
 
+EXTERN VIRTUAL Slist_ptr
+SatSolver_get_fixed_literals ARGS((const SatSolver_ptr self));
+
 EXTERN const char*
 SatSolver_get_name ARGS((const SatSolver_ptr self));
 
@@ -89,6 +89,11 @@ typedef struct SatSolver_TAG
                        const Be_Cnf_ptr cnfProb,
                        SatSolverGroup group);
 
+  /* adds a single clause of 'size' CNF literals in the solver */
+  VIRTUAL void (*add_clause) (const SatSolver_ptr self,
+                              const int* clause, int size,
+                              SatSolverGroup group);
+
   /* sets the polarity of a formula in a group */
   VIRTUAL void (*set_polarity) (const SatSolver_ptr self,
                                 const Be_Cnf_ptr cnfProb,
@@ -125,6 +130,9 @@ typedef struct SatSolver_TAG
   VIRTUAL void (*set_polarity_mode) (SatSolver_ptr self, int mode);
   VIRTUAL int  (*get_polarity_mode) (const SatSolver_ptr self);
 
+  /* returns the literals fixed at the top level, if the solver knows them */
+  VIRTUAL Slist_ptr (*get_fixed_literals) (const SatSolver_ptr self);
+
   /* Interpolation groups management */
   VIRTUAL SatSolverItpGroup (*curr_itp_group) (SatSolver_ptr self);
   VIRTUAL SatSolverItpGroup (*new_itp_group) (SatSolver_ptr self);
@@ -149,6 +157,10 @@ void sat_solver_add ARGS((const SatSolver_ptr self,
                           const Be_Cnf_ptr cnfClause,
                           SatSolverGroup group));
 
+void sat_solver_add_clause ARGS((const SatSolver_ptr self,
+                                 const int* clause, int size,
+                                 SatSolverGroup group));
+
 void sat_solver_set_polarity ARGS((const SatSolver_ptr self,
                                    const Be_Cnf_ptr cnfClause,
                                    int polarity,
@@ -172,6 +184,8 @@ void sat_solver_set_random_mode ARGS((SatSolver_ptr self, double seed));
 void sat_solver_set_polarity_mode ARGS((SatSolver_ptr self, int mode));
 int  sat_solver_get_polarity_mode ARGS((const SatSolver_ptr self));
 
+Slist_ptr sat_solver_get_fixed_literals ARGS((const SatSolver_ptr self));
+
 
 /**AutomaticEnd***************************************************************/
 
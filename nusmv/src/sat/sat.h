@@ -61,6 +61,8 @@
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
+typedef struct SatSolveJob_TAG* SatSolveJob_ptr;
+#define SAT_SOLVE_JOB(x) ((SatSolveJob_ptr) x)
 
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
@@ -87,7 +89,8 @@
 #error /* macro NUSMV_HAVE_INCREMENTAL_SAT must not be defined at this point */
 #endif
 
-#if NUSMV_HAVE_SOLVER_MINISAT || NUSMV_HAVE_SOLVER_ZCHAFF
+#if NUSMV_HAVE_SOLVER_MINISAT || NUSMV_HAVE_SOLVER_ZCHAFF || \
+    NUSMV_HAVE_SOLVER_CDCL
 #define NUSMV_HAVE_INCREMENTAL_SAT 1
 #else
 #define NUSMV_HAVE_INCREMENTAL_SAT 0
@@ -107,6 +110,25 @@ EXTERN const char* Sat_NormalizeSatSolverName ARGS((const char* solverName));
 EXTERN void Sat_PrintAvailableSolvers ARGS((FILE* file));
 EXTERN char* Sat_GetAvailableSolversString ARGS((void));
 
+EXTERN SatSolverResult
+Sat_PortfolioSolveAllGroups ARGS((SatIncSolver_ptr solver, int size,
+                                  boolean share_units));
+EXTERN SatSolverResult
+Sat_PortfolioSolveWithoutGroups ARGS((SatIncSolver_ptr solver,
+                                      Olist_ptr groups, int size,
+                                      boolean share_units));
+EXTERN void Sat_PortfolioPrintStats ARGS((FILE* file));
+EXTERN void Sat_PortfolioResetStats ARGS((void));
+
+EXTERN SatSolveJob_ptr Sat_SolveJobStart ARGS((SatSolver_ptr solver));
+EXTERN SatSolveJob_ptr Sat_SolveJobWaitAny ARGS((SatSolveJob_ptr* jobs,
+                                                 int size));
+EXTERN boolean Sat_SolveJobIsDone ARGS((const SatSolveJob_ptr job));
+EXTERN SatSolverResult
+Sat_SolveJobGetResult ARGS((const SatSolveJob_ptr job));
+EXTERN SatSolver_ptr Sat_SolveJobGetSolver ARGS((const SatSolveJob_ptr job));
+EXTERN void Sat_SolveJobDestroy ARGS((SatSolveJob_ptr job));
+
 
 /* ====================================================================== */
 
@@ -0,0 +1,894 @@
+/**CFile***********************************************************************
+
+  FileName    [satPortfolio.c]
+
+  PackageName [sat]
+
+  Synopsis    [Portfolio and background solving of SAT problems]
+
+  Description [A portfolio races several differently configured copies
+  of the same incremental solver on the same problem, and takes the
+  answer of the first copy which terminates.
+
+  Every copy is a child process forked from the current one, so it
+  inherits the whole state of the solver (clauses, groups, learnt
+  clauses) at no cost. The copies differ in the polarity mode and the
+  random seed of the solver. The winning copy sends back to the parent
+  the result, its solving time, the model (if any) and, when unit
+  sharing is enabled, the literals it fixed at the top level: these are
+  implied by the clauses of the solver, so the parent adds them to its
+  permanent group, and every copy forked for the next problems starts
+  from them. The parent never solves by itself, but its clause database
+  always grows exactly as it would without the portfolio.
+
+  When fork is not available, or the portfolio has one copy only, the
+  problem is solved by the solver itself as usual.
+
+  A solve job runs a single solver in a child process in the same way,
+  so that several independent problems can be solved at the same time:
+  the parent waits for any of the jobs to finish, and the answer is
+  installed into the solver of the job, as if the solver had been
+  invoked in the parent.]
+
+  SeeAlso     [SatIncSolver.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``sat'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "satInt.h"
+#include "SatIncSolver_private.h"
+#include "utils/error.h"
+#include "utils/Profile.h"
+#include "utils/WorkerPool.h"
+
+#include <string.h>
+
+static char rcsid[] UTIL_UNUSED = "$Id: satPortfolio.c,v 1.1.2.1 2011-03-01 10:00:00 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* The polarity modes, same values of the MiniSat ones */
+#define SAT_PORTFOLIO_POLARITY_TRUE  0
+#define SAT_PORTFOLIO_POLARITY_FALSE 1
+
+/* Configurations from this index on use random polarity */
+#define SAT_PORTFOLIO_FIRST_RANDOM_CONFIG 3
+
+/* Statistics are kept for this many configurations at most */
+#define SAT_PORTFOLIO_MAX_STATS 64
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+typedef SatSolverResult (*SatPortfolioSolveFn)(SatIncSolver_ptr solver,
+                                               Olist_ptr groups);
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [The answer sent by a copy to the parent]
+
+  Description [The header is followed by modelSize model literals and
+  by unitsSize fixed literals.]
+
+******************************************************************************/
+typedef struct SatPortfolioAnswer_TAG {
+  int result;
+  long time;
+  int modelSize;
+  int unitsSize;
+} SatPortfolioAnswer;
+
+/**Struct**********************************************************************
+
+  Synopsis    [What the copies of a race are given]
+
+  Description [A NULL solve function stands for
+  SatSolver_solve_all_groups, as used by solve jobs.]
+
+******************************************************************************/
+typedef struct SatPortfolioRace_TAG {
+  SatIncSolver_ptr solver;
+  SatPortfolioSolveFn solve;
+  Olist_ptr groups;
+  boolean share_units;
+} SatPortfolioRace;
+
+/**Struct**********************************************************************
+
+  Synopsis    [A solver running in background]
+
+  Description [pool is NULL once the child has been reaped, or if the
+  problem has been solved in the current process]
+
+******************************************************************************/
+typedef struct SatSolveJob_TAG {
+  SatSolver_ptr solver;
+  WorkerPool_ptr pool;
+  boolean done;
+  SatSolverResult result;
+} SatSolveJob;
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/**Variable********************************************************************
+
+  Synopsis    [Races won and solving time of every configuration]
+
+  Description [Indexed by configuration, the last entry collects all
+  the configurations beyond it.]
+
+******************************************************************************/
+static long sat_portfolio_wins[SAT_PORTFOLIO_MAX_STATS];
+static long sat_portfolio_time[SAT_PORTFOLIO_MAX_STATS];
+static long sat_portfolio_races = 0;
+static long sat_portfolio_shared_units = 0;
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static SatSolverResult
+sat_portfolio_solve ARGS((SatIncSolver_ptr solver,
+                          SatPortfolioSolveFn solve, Olist_ptr groups,
+                          int size, boolean share_units));
+
+static SatSolverResult
+sat_portfolio_solve_all_groups ARGS((SatIncSolver_ptr solver,
+                                     Olist_ptr groups));
+
+static SatSolverResult
+sat_portfolio_solve_without_groups ARGS((SatIncSolver_ptr solver,
+                                         Olist_ptr groups));
+
+static void sat_portfolio_diversify ARGS((SatSolver_ptr solver, int config));
+
+static void sat_portfolio_config_name ARGS((int config, char* buf, int size));
+
+static void sat_portfolio_add_units ARGS((SatSolver_ptr solver,
+                                          int* units, int size));
+
+static SatSolverResult
+sat_portfolio_race ARGS((SatIncSolver_ptr solver,
+                         SatPortfolioSolveFn solve, Olist_ptr groups,
+                         int size, boolean share_units, int* winner));
+
+static int sat_portfolio_child ARGS((int config, int jobs, int fd,
+                                     void* arg));
+
+static void sat_solve_job_receive ARGS((SatSolveJob_ptr job));
+
+static void sat_solve_job_reap ARGS((SatSolveJob_ptr job));
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Solves all the groups of the solver with a portfolio of
+  size copies]
+
+  Description [Behaves as SatSolver_solve_all_groups. If size is 1 or
+  less the solver is invoked directly. If share_units is true, the
+  literals fixed by the winning copy are added to the permanent group
+  of the solver.]
+
+  SideEffects [The model and solving time of the solver are set]
+
+  SeeAlso     [SatSolver_solve_all_groups]
+
+******************************************************************************/
+SatSolverResult Sat_PortfolioSolveAllGroups(SatIncSolver_ptr solver,
+                                            int size, boolean share_units)
+{
+  SAT_INC_SOLVER_CHECK_INSTANCE(solver);
+
+  if (size <= 1) {
+    return SatSolver_solve_all_groups(SAT_SOLVER(solver));
+  }
+
+  return sat_portfolio_solve(solver, sat_portfolio_solve_all_groups,
+                             (Olist_ptr) NULL, size, share_units);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Solves the groups of the solver but the given ones with a
+  portfolio of size copies]
+
+  Description [Behaves as SatIncSolver_solve_without_groups. If size
+  is 1 or less the solver is invoked directly.]
+
+  SideEffects [The model and solving time of the solver are set]
+
+  SeeAlso     [SatIncSolver_solve_without_groups]
+
+******************************************************************************/
+SatSolverResult Sat_PortfolioSolveWithoutGroups(SatIncSolver_ptr solver,
+                                                Olist_ptr groups, int size,
+                                                boolean share_units)
+{
+  SAT_INC_SOLVER_CHECK_INSTANCE(solver);
+
+  if (size <= 1) {
+    return SatIncSolver_solve_without_groups(solver, groups);
+  }
+
+  return sat_portfolio_solve(solver, sat_portfolio_solve_without_groups,
+                             groups, size, share_units);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Prints the races won and the solving time of every
+  configuration of the portfolio]
+
+  Description [Nothing is printed if no race has been run since the
+  last reset.]
+
+  SideEffects []
+
+  SeeAlso     [Sat_PortfolioResetStats]
+
+******************************************************************************/
+void Sat_PortfolioPrintStats(FILE* file)
+{
+  int i;
+
+  if (sat_portfolio_races == 0) return;
+
+  fprintf(file, "Portfolio: %ld races, %ld shared units\n",
+          sat_portfolio_races, sat_portfolio_shared_units);
+  fprintf(file, "  %-18s %8s %12s\n", "configuration", "won", "time (s)");
+
+  for (i = 0; i < SAT_PORTFOLIO_MAX_STATS; ++i) {
+    char name[32];
+
+    if (sat_portfolio_wins[i] == 0) continue;
+
+    if (i == SAT_PORTFOLIO_MAX_STATS - 1) {
+      snprintf(name, sizeof(name), "others");
+    }
+    else sat_portfolio_config_name(i, name, sizeof(name));
+
+    fprintf(file, "  %-18s %8ld %12.3f\n", name, sat_portfolio_wins[i],
+            sat_portfolio_time[i] / 1000.0);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Resets the statistics of the portfolio]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Sat_PortfolioPrintStats]
+
+******************************************************************************/
+void Sat_PortfolioResetStats()
+{
+  memset(sat_portfolio_wins, 0, sizeof(sat_portfolio_wins));
+  memset(sat_portfolio_time, 0, sizeof(sat_portfolio_time));
+  sat_portfolio_races = 0;
+  sat_portfolio_shared_units = 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Starts solving all the groups of the given solver in
+  background]
+
+  Description [The solver is run in a child process. Use
+  Sat_SolveJobWaitAny to get the answer: the model and the solving
+  time are then installed into the solver. The solver must not be
+  used until the job is done, and must be destroyed by the caller
+  after the job. When fork is not available or fails, the problem is
+  solved before returning.]
+
+  SideEffects [Pending output is flushed]
+
+  SeeAlso     [Sat_SolveJobWaitAny, Sat_SolveJobDestroy]
+
+******************************************************************************/
+SatSolveJob_ptr Sat_SolveJobStart(SatSolver_ptr solver)
+{
+  SatSolveJob_ptr self = ALLOC(SatSolveJob, 1);
+  nusmv_assert(SAT_SOLVE_JOB(NULL) != self);
+
+  SAT_SOLVER_CHECK_INSTANCE(solver);
+
+  self->solver = solver;
+  self->pool = WORKER_POOL(NULL);
+  self->done = false;
+  self->result = SAT_SOLVER_INTERNAL_ERROR;
+
+  /* destroy the model of previous solving */
+  if ((Slist_ptr) NULL != solver->model) Slist_destroy(solver->model);
+  solver->model = (Slist_ptr) NULL;
+
+  {
+    SatPortfolioRace race;
+
+    race.solver = SAT_INC_SOLVER(solver);
+    race.solve = (SatPortfolioSolveFn) NULL;
+    race.groups = (Olist_ptr) NULL;
+    race.share_units = false;
+
+    self->pool = WorkerPool_create(1, false, sat_portfolio_child, &race);
+  }
+
+  if (!WorkerPool_is_running(self->pool, 0)) {
+    sat_solve_job_reap(self);
+    self->result = SatSolver_solve_all_groups(solver);
+    self->done = true;
+  }
+
+  return self;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Waits for any of the given jobs to be done]
+
+  Description [Returns a job among the given ones which got done while
+  waiting, or NULL if all the jobs were already done. NULL entries
+  of the array are ignored. A job whose process terminates without
+  answering is done with SAT_SOLVER_INTERNAL_ERROR as result.]
+
+  SideEffects [The answer is installed into the solver of the job]
+
+  SeeAlso     [Sat_SolveJobStart]
+
+******************************************************************************/
+SatSolveJob_ptr Sat_SolveJobWaitAny(SatSolveJob_ptr* jobs, int size)
+{
+  WorkerPool_ptr* pools = ALLOC(WorkerPool_ptr, size + 1);
+  boolean pending = false;
+  int worker, i;
+
+  for (i = 0; i < size; ++i) {
+    pools[i] = WORKER_POOL(NULL);
+    if (SAT_SOLVE_JOB(NULL) != jobs[i] && !jobs[i]->done) {
+      pools[i] = jobs[i]->pool;
+      pending = true;
+    }
+  }
+
+  i = WorkerPool_wait_any_of(pools, size, -1, &worker);
+  FREE(pools);
+
+  if (i < 0) {
+    if (pending) internal_error("Sat_SolveJobWaitAny: wait failed");
+    return SAT_SOLVE_JOB(NULL);
+  }
+
+  sat_solve_job_receive(jobs[i]);
+  return jobs[i];
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns true if the answer of the job is available]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+boolean Sat_SolveJobIsDone(const SatSolveJob_ptr self)
+{
+  return self->done;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the result of a job which is done]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Sat_SolveJobIsDone]
+
+******************************************************************************/
+SatSolverResult Sat_SolveJobGetResult(const SatSolveJob_ptr self)
+{
+  nusmv_assert(self->done);
+  return self->result;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the solver of the job]
+
+  Description [The solver is owned by the caller of Sat_SolveJobStart]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+SatSolver_ptr Sat_SolveJobGetSolver(const SatSolveJob_ptr self)
+{
+  return self->solver;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Destroys a job, killing it if it is still running]
+
+  Description [The solver of the job is not destroyed]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void Sat_SolveJobDestroy(SatSolveJob_ptr self)
+{
+  sat_solve_job_reap(self);
+  FREE(self);
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Runs a race and installs its answer into the solver]
+
+  Description [Falls back to the solver itself if no copy could
+  answer.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static SatSolverResult
+sat_portfolio_solve(SatIncSolver_ptr solver, SatPortfolioSolveFn solve,
+                    Olist_ptr groups, int size, boolean share_units)
+{
+  SatSolver_ptr self = SAT_SOLVER(solver);
+  SatSolverResult result = SAT_SOLVER_INTERNAL_ERROR;
+  int winner = -1;
+
+  /* destroy the model of previous solving */
+  if ((Slist_ptr) NULL != self->model) Slist_destroy(self->model);
+  self->model = (Slist_ptr) NULL;
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    fprintf(nusmv_stderr, "Invoking a portfolio of %d '%s' solvers...\n",
+            size, SatSolver_get_name(self));
+  }
+
+  /* we have unsatisfiable formulas in some groups */
+  if (solve == sat_portfolio_solve_all_groups &&
+      0 != Olist_get_size(self->unsatisfiableGroups)) {
+    self->solvingTime = 0;
+    return SAT_SOLVER_UNSATISFIABLE_PROBLEM;
+  }
+
+  Profile_begin("sat_solve");
+  result = sat_portfolio_race(solver, solve, groups, size, share_units,
+                              &winner);
+  Profile_end("sat_solve");
+
+  if (winner < 0) {
+    /* no copy could give an answer: solve as usual */
+    if (solve == sat_portfolio_solve_all_groups) {
+      return SatSolver_solve_all_groups(self);
+    }
+    return SatIncSolver_solve_without_groups(solver, groups);
+  }
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
+    char name[32];
+    sat_portfolio_config_name(winner, name, sizeof(name));
+    fprintf(nusmv_stderr, "Portfolio configuration '%s' answered first "
+            "after %f secs \n", name,
+            SatSolver_get_last_solving_time(self)/1000.0);
+  }
+
+  return result;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Solves all the groups, as seen by a copy]
+
+  Description [The unsatisfiable groups have been already checked]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static SatSolverResult
+sat_portfolio_solve_all_groups(SatIncSolver_ptr solver, Olist_ptr groups)
+{
+  return SAT_SOLVER(solver)->solve_all_groups(SAT_SOLVER(solver));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Solves the groups but the given ones, as seen by a copy]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static SatSolverResult
+sat_portfolio_solve_without_groups(SatIncSolver_ptr solver, Olist_ptr groups)
+{
+  return solver->solve_without_groups(solver, groups);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Sets the solver up as the given configuration]
+
+  Description [Configuration 0 keeps the settings of the solver,
+  configurations 1 and 2 prefer the false and the true polarity
+  respectively, other configurations use random polarity, each with its
+  own seed. zchaff has no polarity modes, so all its copies run with
+  the same settings.]
+
+  SideEffects []
+
+  SeeAlso     [sat_portfolio_config_name]
+
+******************************************************************************/
+static void sat_portfolio_diversify(SatSolver_ptr solver, int config)
+{
+  if (strcasecmp(SatSolver_get_name(solver), "ZChaff") == 0) return;
+
+  switch (config) {
+  case 0: break;
+  case 1:
+    SatSolver_set_polarity_mode(solver, SAT_PORTFOLIO_POLARITY_FALSE);
+    break;
+  case 2:
+    SatSolver_set_polarity_mode(solver, SAT_PORTFOLIO_POLARITY_TRUE);
+    break;
+  default:
+    SatSolver_set_random_mode(solver,
+              (double) (config - SAT_PORTFOLIO_FIRST_RANDOM_CONFIG + 1));
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Writes the name of a configuration into buf]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [sat_portfolio_diversify]
+
+******************************************************************************/
+static void sat_portfolio_config_name(int config, char* buf, int size)
+{
+  int chars;
+
+  switch (config) {
+  case 0: chars = snprintf(buf, size, "default"); break;
+  case 1: chars = snprintf(buf, size, "polarity-false"); break;
+  case 2: chars = snprintf(buf, size, "polarity-true"); break;
+  default:
+    chars = snprintf(buf, size, "random-seed-%d",
+                     config - SAT_PORTFOLIO_FIRST_RANDOM_CONFIG + 1);
+  }
+
+  SNPRINTF_CHECK(chars, size);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Adds the given literals to the permanent group of the
+  solver as unit clauses]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void sat_portfolio_add_units(SatSolver_ptr solver,
+                                    int* units, int size)
+{
+  Be_Cnf_ptr cnf = Be_Cnf_Create((be_ptr) NULL);
+  int i;
+
+  for (i = 0; i < size; ++i) {
+    Be_Cnf_SetFormulaLiteral(cnf, units[i]);
+    SatSolver_set_polarity(solver, cnf, 1,
+                           SatSolver_get_permanent_group(solver));
+  }
+
+  Be_Cnf_Delete(cnf);
+  sat_portfolio_shared_units += size;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Forks the copies and waits for the first answer]
+
+  Description [Returns the result of the first copy answering, and its
+  configuration in winner. The other copies are killed. winner is set to
+  -1 if no copy answered.]
+
+  SideEffects [The model, the solving time and (possibly) the permanent
+  group of the solver are updated]
+
+  SeeAlso     []
+
+******************************************************************************/
+static SatSolverResult
+sat_portfolio_race(SatIncSolver_ptr solver, SatPortfolioSolveFn solve,
+                   Olist_ptr groups, int size, boolean share_units,
+                   int* winner)
+{
+  SatSolver_ptr self = SAT_SOLVER(solver);
+  SatSolverResult result = SAT_SOLVER_INTERNAL_ERROR;
+  SatPortfolioRace race;
+  WorkerPool_ptr pool;
+
+  *winner = -1;
+
+  race.solver = solver;
+  race.solve = solve;
+  race.groups = groups;
+  race.share_units = share_units;
+
+  pool = WorkerPool_create(size, false, sat_portfolio_child, &race);
+
+  while (*winner < 0) {
+    SatPortfolioAnswer answer;
+    int* lits;
+    int i = WorkerPool_wait_any(pool, -1);
+
+    if (i < 0) break;
+
+    /* a copy which terminates without a complete answer is out */
+    if (!WorkerPool_receive(pool, i, &answer, sizeof(answer))) continue;
+
+    lits = ALLOC(int, answer.modelSize + answer.unitsSize + 1);
+    if (!WorkerPool_receive(pool, i, lits,
+               sizeof(int) * (answer.modelSize + answer.unitsSize))) {
+      FREE(lits);
+      continue;
+    }
+
+    *winner = i;
+    result = (SatSolverResult) answer.result;
+    self->solvingTime = answer.time;
+
+    if (result == SAT_SOLVER_SATISFIABLE_PROBLEM) {
+      int j;
+
+      /* the copy sent the literals in list order */
+      self->model = Slist_create();
+      for (j = answer.modelSize - 1; j >= 0; --j) {
+        Slist_push(self->model, PTR_FROM_INT(void*, lits[j]));
+      }
+    }
+
+    if (answer.unitsSize > 0) {
+      sat_portfolio_add_units(self, lits + answer.modelSize,
+                              answer.unitsSize);
+    }
+
+    FREE(lits);
+  }
+
+  WorkerPool_destroy(pool);
+
+  if (*winner >= 0) {
+    int entry = *winner < SAT_PORTFOLIO_MAX_STATS ?
+      *winner : SAT_PORTFOLIO_MAX_STATS - 1;
+
+    sat_portfolio_wins[entry] += 1;
+    sat_portfolio_time[entry] += self->solvingTime;
+    sat_portfolio_races += 1;
+  }
+
+  return result;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [The body of a copy of the portfolio]
+
+  Description [Solves the problem of the race given as arg with the
+  given configuration, and sends the answer through fd. Returns the
+  exit status of the copy.]
+
+  SideEffects []
+
+  SeeAlso     [sat_portfolio_race, Sat_SolveJobStart]
+
+******************************************************************************/
+static int sat_portfolio_child(int config, int jobs, int fd, void* arg)
+{
+  SatPortfolioRace* race = (SatPortfolioRace*) arg;
+  SatSolver_ptr self = SAT_SOLVER(race->solver);
+  SatPortfolioAnswer answer;
+  Slist_ptr model = (Slist_ptr) NULL;
+  Slist_ptr units = (Slist_ptr) NULL;
+  int* lits;
+  int n = 0;
+  Siter iter;
+
+  sat_portfolio_diversify(self, config);
+
+  answer.time = util_cpu_time();
+  if ((SatPortfolioSolveFn) NULL != race->solve) {
+    answer.result = (int) race->solve(race->solver, race->groups);
+  }
+  else answer.result = (int) SatSolver_solve_all_groups(self);
+  answer.time = util_cpu_time() - answer.time;
+
+  answer.modelSize = 0;
+  if (answer.result == SAT_SOLVER_SATISFIABLE_PROBLEM) {
+    model = SatSolver_get_model(self);
+    answer.modelSize = Slist_get_size(model);
+  }
+
+  answer.unitsSize = 0;
+  if (race->share_units) {
+    units = SatSolver_get_fixed_literals(self);
+    answer.unitsSize = Slist_get_size(units);
+  }
+
+  lits = ALLOC(int, answer.modelSize + answer.unitsSize + 1);
+  if ((Slist_ptr) NULL != model) {
+    SLIST_FOREACH(model, iter) lits[n++] = PTR_TO_INT(Siter_element(iter));
+  }
+  if ((Slist_ptr) NULL != units) {
+    SLIST_FOREACH(units, iter) lits[n++] = PTR_TO_INT(Siter_element(iter));
+  }
+
+  if (WorkerPool_write_exactly(fd, &answer, sizeof(answer))) {
+    WorkerPool_write_exactly(fd, lits, sizeof(int) * n);
+  }
+
+  return 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the answer of a job and installs it into its solver]
+
+  Description []
+
+  SideEffects [The job is done]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void sat_solve_job_receive(SatSolveJob_ptr self)
+{
+  SatPortfolioAnswer answer;
+
+  self->done = true;
+  self->result = SAT_SOLVER_INTERNAL_ERROR;
+
+  if (WorkerPool_receive(self->pool, 0, &answer, sizeof(answer))) {
+    int* lits = ALLOC(int, answer.modelSize + answer.unitsSize + 1);
+
+    if (WorkerPool_receive(self->pool, 0, lits, sizeof(int) *
+                           (answer.modelSize + answer.unitsSize))) {
+      SatSolver_ptr solver = self->solver;
+
+      self->result = (SatSolverResult) answer.result;
+      solver->solvingTime = answer.time;
+
+      if (self->result == SAT_SOLVER_SATISFIABLE_PROBLEM) {
+        int j;
+
+        /* the child sent the literals in list order */
+        solver->model = Slist_create();
+        for (j = answer.modelSize - 1; j >= 0; --j) {
+          Slist_push(solver->model, PTR_FROM_INT(void*, lits[j]));
+        }
+      }
+    }
+
+    FREE(lits);
+  }
+
+  sat_solve_job_reap(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Releases the process and the pipe of a job]
+
+  Description [The process is killed if it is still running]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void sat_solve_job_reap(SatSolveJob_ptr self)
+{
+  if (WORKER_POOL(NULL) != self->pool) WorkerPool_destroy(self->pool);
+  self->pool = WORKER_POOL(NULL);
+}
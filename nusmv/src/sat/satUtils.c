@@ -54,6 +54,10 @@
 #include "solvers/SatMinisat.h"
 #endif
 
+#if NUSMV_HAVE_SOLVER_CDCL
+#include "solvers/SatCdcl.h"
+#endif
+
 #include <string.h>
 
 /*---------------------------------------------------------------------------*/
@@ -62,6 +66,7 @@
 
 #define ZCHAFF_NAME  "ZChaff"
 #define MINISAT_NAME "MiniSat"
+#define CDCL_NAME    "Cdcl"
 
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
@@ -94,6 +99,13 @@ static const char* sat_solver_names[] = {
   MINISAT_NAME
 #endif
 #endif
+#if NUSMV_HAVE_SOLVER_CDCL
+#if NUSMV_HAVE_SOLVER_ZCHAFF || NUSMV_HAVE_SOLVER_MINISAT
+  ,CDCL_NAME
+#else
+  CDCL_NAME
+#endif
+#endif
 };
 
 static char rcsid[] UTIL_UNUSED = "$Id: satUtils.c,v 1.3.4.2.2.4.2.3 2005-11-16 12:04:43 nusmv Exp $";
@@ -155,6 +167,10 @@ SatSolver_ptr Sat_CreateNonIncSolver(const char* satSolver)
   } else if (strcasecmp(MINISAT_NAME, satSolver) == 0) {
 # if NUSMV_HAVE_SOLVER_MINISAT
     solver = SAT_SOLVER(SatMinisat_create(MINISAT_NAME, false)); /* no proof logging */
+# endif
+  } else if (strcasecmp(CDCL_NAME, satSolver) == 0) {
+# if NUSMV_HAVE_SOLVER_CDCL
+    solver = SAT_SOLVER(SatCdcl_create(CDCL_NAME, false));
 # endif
   }
 
@@ -206,6 +222,11 @@ SatSolver_ptr Sat_CreateNonIncProofSolver(const char* satSolver)
 # if NUSMV_HAVE_SOLVER_MINISAT
     solver = SAT_SOLVER(SatMinisat_create(MINISAT_NAME, true));
 # endif
+
+  } else if (strcasecmp(CDCL_NAME, satSolver) == 0) {
+# if NUSMV_HAVE_SOLVER_CDCL
+    solver = SAT_SOLVER(SatCdcl_create(CDCL_NAME, true));
+# endif
   }
 
   if (opt_verbose_level_gt(OptsHandler_get_instance(), 0)) {
@@ -252,6 +273,10 @@ SatIncSolver_ptr Sat_CreateIncSolver(const char* satSolver)
   } else if (strcasecmp(MINISAT_NAME, satSolver) == 0) {
 # if NUSMV_HAVE_SOLVER_MINISAT
     solver = SAT_INC_SOLVER(SatMinisat_create(MINISAT_NAME, false));
+# endif
+  } else if (strcasecmp(CDCL_NAME, satSolver) == 0) {
+# if NUSMV_HAVE_SOLVER_CDCL
+    solver = SAT_INC_SOLVER(SatCdcl_create(CDCL_NAME, false));
 # endif
   }
 
@@ -300,6 +325,10 @@ SatIncSolver_ptr Sat_CreateIncProofSolver(const char* satSolver)
   } else if (strcasecmp(MINISAT_NAME, satSolver) == 0) {
 # if NUSMV_HAVE_SOLVER_MINISAT
     solver = SAT_INC_SOLVER(SatMinisat_create(MINISAT_NAME, true));
+# endif
+  } else if (strcasecmp(CDCL_NAME, satSolver) == 0) {
+# if NUSMV_HAVE_SOLVER_CDCL
+    solver = SAT_INC_SOLVER(SatCdcl_create(CDCL_NAME, true));
 # endif
   }
 
@@ -0,0 +1,1141 @@
+/**CFile***********************************************************************
+
+  FileName    [SatCdcl.c]
+
+  PackageName [SatCdcl]
+
+  Synopsis    [Routines related to SatCdcl object.]
+
+  Description [ This file contains the definition of \"SatCdcl\" class,
+  the SatIncSolver built on the in-tree CDCL engine. Like SatMinisat,
+  the solver contains its own coding of variables, so input variables
+  may be in any range from 1 .. INT_MAX, with possible holes in the
+  range.
+
+  Group Control:
+   Every group has its ID, which is an usual internal variable. If a
+   formula is added to a permanent group, then its clauses are just
+   added to the engine. Otherwise the positive literal of the group ID
+   is added to every clause of the formula. Solving the groups assumes
+   the negative literals of their IDs, so that no clause is ever
+   deleted when groups are switched on and off, and learnt clauses are
+   kept across solvings. To destroy a group, a unit clause with the
+   positive literal of the group ID is added: all the clauses of the
+   group become satisfied and are removed by the engine at the next
+   simplification. To move a group to the permanent group, a unit
+   clause with the negative literal of the group ID is added.]
+
+  SeeAlso     [SatMinisat.c cdclSolver.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``sat'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "SatCdcl_private.h"
+#include "utils/error.h"
+#include "sat/satInt.h" /* for options and nusmv_stderr */
+
+static char rcsid[] UTIL_UNUSED = "$Id: SatCdcl.c,v 1.1.2.1 2011-03-01 10:00:00 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* The file is compiled only if the in-tree solver is enabled               */
+/*---------------------------------------------------------------------------*/
+#if NUSMV_HAVE_SOLVER_CDCL
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+static void sat_cdcl_finalize ARGS((Object_ptr object, void *dummy));
+static SatSolverResult sat_cdcl_solve ARGS((SatCdcl_ptr self,
+                                            int* assumptions,
+                                            int numberOfAssumptions));
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of external functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Creates a Cdcl SAT solver and initializes it.]
+
+  Description [The first parameter is the name of the solver. If
+  enable_proof_logging is true, the engine records the proof of
+  unsatisfiability, and interpolants can be extracted with
+  SatSolver_extract_interpolant.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+SatCdcl_ptr SatCdcl_create(const char* name, boolean enable_proof_logging)
+{
+  SatCdcl_ptr self = ALLOC(SatCdcl, 1);
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  sat_cdcl_init(self, name, enable_proof_logging);
+  return self;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Destroys an instance of a Cdcl SAT solver]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void SatCdcl_destroy (SatCdcl_ptr self)
+{
+  SatSolver_destroy(SAT_SOLVER(self));
+}
+
+/* ---------------------------------------------------------------------- */
+/* Private Methods                                                        */
+/* ---------------------------------------------------------------------- */
+
+/**Function********************************************************************
+
+  Synopsis    [Convert a cnf literal into an internal literal used by the
+  engine]
+
+  Description [The literal may not be 0 (because 0 cannot have sign).
+  If necessary a new internal variable is created.]
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_cdclLiteral2cnfLiteral]
+
+******************************************************************************/
+int sat_cdcl_cnfLiteral2cdclLiteral(SatCdcl_ptr self, int cnfLiteral)
+{
+  int cnfVar = abs(cnfLiteral);
+  int cdclVar;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+  nusmv_assert(cnfVar > 0);
+
+  cdclVar = NODE_TO_INT(find_assoc(self->cnfVar2cdclVar,
+                                   NODE_FROM_INT(cnfVar)));
+
+  if (0 == cdclVar) {
+    /* create a new internal var and associate with cnf */
+    cdclVar = Cdcl_New_Variable(self->cdclSolver);
+
+    insert_assoc(self->cnfVar2cdclVar,
+                 NODE_FROM_INT(cnfVar), NODE_FROM_INT(cdclVar));
+
+    insert_assoc(self->cdclVar2cnfVar,
+                 NODE_FROM_INT(cdclVar), NODE_FROM_INT(cnfVar));
+  }
+
+  return cnfLiteral > 0 ? cdclVar : - cdclVar;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Convert an internal literal into a cnf literal]
+
+  Description [The variable in the literal has to be created by
+  sat_cdcl_cnfLiteral2cdclLiteral only. Group IDs are converted into 0.]
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_cnfLiteral2cdclLiteral]
+
+******************************************************************************/
+int sat_cdcl_cdclLiteral2cnfLiteral(SatCdcl_ptr self, int cdclLiteral)
+{
+  int cdclVar = abs(cdclLiteral);
+  int cnfVar = NODE_TO_INT(find_assoc(self->cdclVar2cnfVar,
+                                      NODE_FROM_INT(cdclVar)));
+
+  return cdclLiteral > 0 ? cnfVar : - cnfVar;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Adds a clause to the solver database.]
+
+  Description [converts all CNF literals into the internal literals,
+  adds a group id to every clause (if group is not permament) and then add
+  obtained clauses to the engine]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void sat_cdcl_add(const SatSolver_ptr solver,
+                  const Be_Cnf_ptr cnfProb,
+                  SatSolverGroup group)
+{
+  Siter genClause;
+
+  SAT_CDCL_CHECK_INSTANCE(solver);
+
+  SLIST_FOREACH (Be_Cnf_GetClausesList(cnfProb), genClause) {
+    int* clause = (int*) Siter_element(genClause);
+    int size;
+
+    for (size = 0; clause[size] != 0; ++size);
+    sat_cdcl_add_clause(solver, clause, size, group);
+  }
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Adds a single clause to the solver database.]
+
+  Description [converts the 'size' CNF literals of the clause into the
+  internal literals, adds the group id (if group is not permament) and
+  then adds the obtained clause to the engine]
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_add]
+
+******************************************************************************/
+void sat_cdcl_add_clause(const SatSolver_ptr solver,
+                         const int* clause, int size,
+                         SatSolverGroup group)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  int i;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  if (self->cdclClauseSize <= size + 1) {
+    sat_cdcl_enlarge_cdclClause(self, size + 2);
+  }
+
+  for (i = 0; i < size; ++i) {
+    self->cdclClause[i] = sat_cdcl_cnfLiteral2cdclLiteral(self, clause[i]);
+  }
+
+  if (SatSolver_get_permanent_group(SAT_SOLVER(self)) != group) {
+    /* add group id to the clause */
+    self->cdclClause[size] = group;
+    ++size;
+  }
+
+  /* as with minisat, the engine remembers by itself that an
+     unsatisfiable clause has been added */
+  Cdcl_Add_Clause(self->cdclSolver, self->cdclClause, size);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Sets the polarity of the formula.]
+
+  Description [Sets the polarity of the formula.
+  Polarity 1 means the formula is considered as positive, and -1 means
+  the negation of the formula will be solved.
+  A unit clause of the literal (with sign equal to polarity)
+  corresponding to the given CNF formula is added to the solve.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void sat_cdcl_set_polarity(const SatSolver_ptr solver,
+                           const Be_Cnf_ptr cnfProb,
+                           int polarity,
+                           SatSolverGroup group)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  int cdclClause[2];
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  if (Be_Cnf_GetFormulaLiteral(cnfProb) == INT_MAX) {
+    /* special case, we have added the constant false */
+    nusmv_assert(SAT_SOLVER(self)->interpolation);
+
+    /* check that we are actually adding the constant false
+       (see SatSolver.c, SatSolver_set_polarity) */
+    nusmv_assert(
+      (Slist_get_size(Be_Cnf_GetClausesList(cnfProb)) == 0 ? 1 : -1) *
+      polarity != 1);
+
+    if (SatSolver_get_permanent_group(SAT_SOLVER(self)) == group) {
+      /* add the empty clause */
+      Cdcl_Add_Clause(self->cdclSolver, cdclClause, 0);
+    }
+    else {
+      cdclClause[0] = group;
+      Cdcl_Add_Clause(self->cdclSolver, cdclClause, 1);
+    }
+    return;
+  }
+
+  cdclClause[0] = sat_cdcl_cnfLiteral2cdclLiteral(self,
+                      polarity * Be_Cnf_GetFormulaLiteral(cnfProb));
+
+  if (SatSolver_get_permanent_group(SAT_SOLVER(self)) == group) {
+    Cdcl_Add_Clause(self->cdclSolver, cdclClause, 1);
+  }
+  else { /* add group id to clause to controle the CNF formula */
+    cdclClause[1] = group;
+    Cdcl_Add_Clause(self->cdclSolver, cdclClause, 2);
+  }
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Sets preferred variables in the solver]
+
+  Description [Sets preferred variables in the solver. A preferred variable is
+               split upon with priority, with respect to non-preferedd ones.]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_clear_preferred_variables]
+
+******************************************************************************/
+void sat_cdcl_set_preferred_variables(const SatSolver_ptr solver,
+                                      const Slist_ptr cnfVars)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  Siter genVar;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  SLIST_FOREACH (cnfVars, genVar) {
+    nusmv_ptrint cnfVar = (nusmv_ptrint) Siter_element(genVar);
+    int cdclVar;
+
+    nusmv_assert(((int) cnfVar) > 0);
+
+    cdclVar = NODE_TO_INT(find_assoc(self->cnfVar2cdclVar,
+                                     NODE_FROM_INT((int) cnfVar)));
+    /* skip var, if not existing */
+    if (0 != cdclVar) {
+      Cdcl_Set_Preferred_Variable(self->cdclSolver, cdclVar);
+    }
+  }
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Clears preferred variables in the solver]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_set_preferred_variables]
+
+******************************************************************************/
+void sat_cdcl_clear_preferred_variables(const SatSolver_ptr solver)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  Cdcl_Clear_Preferred_Variables(self->cdclSolver);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Tries to solve all added formulas]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+SatSolverResult sat_cdcl_solve_all_groups(const SatSolver_ptr solver)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  return sat_cdcl_solve_groups(SAT_INC_SOLVER(self),
+                               SAT_SOLVER(self)->existingGroups);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Solves the permanent group under set of assumptions]
+
+  Description [Obtain set of conflicting assumptions with
+  sat_cdcl_get_conflicts]
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_get_conflicts, sat_cdcl_make_conflicts]
+
+******************************************************************************/
+SatSolverResult
+sat_cdcl_solve_permanent_group_assume(const SatSolver_ptr sol,
+                                      const Slist_ptr assumptions)
+{
+  SatCdcl_ptr self = SAT_CDCL(sol);
+  SatSolver_ptr solver;
+  SatSolverResult result;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  solver = SAT_SOLVER(self);
+
+  /* destroy the model of previous solving */
+  if ((Slist_ptr)NULL != solver->model) {
+    Slist_destroy(solver->model);
+    solver->model = (Slist_ptr)NULL;
+  }
+
+  /* destroy the conflict of previous solving */
+  if ((Slist_ptr)NULL != self->conflict) {
+    Slist_destroy(self->conflict);
+    self->conflict = (Slist_ptr)NULL;
+  }
+
+  if (Olist_contains(solver->unsatisfiableGroups,
+                     (void*)SatSolver_get_permanent_group(solver))) {
+    /* no assumptions needed to obtain conflict => remains empty */
+    result = SAT_SOLVER_UNSATISFIABLE_PROBLEM;
+  }
+  else {
+    int numberOfAssumptions = Slist_get_size(assumptions);
+    int* lits = ALLOC(int, numberOfAssumptions + 1);
+    Siter gen;
+
+    numberOfAssumptions = 0;
+    SLIST_FOREACH (assumptions, gen) {
+      lits[numberOfAssumptions] =
+        sat_cdcl_cnfLiteral2cdclLiteral(self,
+                                        PTR_TO_INT(Siter_element(gen)));
+      ++numberOfAssumptions;
+    }
+
+    result = sat_cdcl_solve(self, lits, numberOfAssumptions);
+    FREE(lits);
+  }
+
+  return result;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Returns set of conflicting assumptions]
+
+  Description [Only use with sat_cdcl_solve_permanent_group_assume]
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_solve_permanent_group_assume,
+  sat_cdcl_make_conflicts]
+
+******************************************************************************/
+Slist_ptr sat_cdcl_get_conflicts(const SatSolver_ptr solver)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  if ((Slist_ptr)NULL == self->conflict) {
+    self->conflict = sat_cdcl_make_conflicts(self);
+  }
+
+  return self->conflict;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [This function creates a model (in the original CNF variables)]
+
+  Description [The previous invocation of SAT_Solve should have been successful]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+Slist_ptr sat_cdcl_make_model(const SatSolver_ptr solver)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  Slist_ptr model;
+  int varNumber;
+  int index;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+  /* a model is created only if there is no model */
+  nusmv_assert((Slist_ptr)NULL == SAT_SOLVER(self)->model);
+
+  model = Slist_create();
+  varNumber = Cdcl_Nof_Variables(self->cdclSolver);
+
+  for (index = 1; index <= varNumber; ++index) {
+    int cnfLiteral = sat_cdcl_cdclLiteral2cnfLiteral(self, index);
+
+    /* group ids have no associated cnf variable */
+    if (cnfLiteral > 0) {
+      switch (Cdcl_Get_Value(self->cdclSolver, index)) {
+
+      case 0: /* negative polarity => change the polarity of CNF var */
+        cnfLiteral = -cnfLiteral;
+      case 1:  /* positive polarity => do nothing */
+        Slist_push(model, PTR_FROM_INT(void*, cnfLiteral));
+        break;
+
+      case -1: break; /* does not store unassigned vars */
+      default:
+        error_unreachable_code(); /* no other values should be provided */
+      }
+    }
+  }
+
+  return model;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Converts an internal variable index into a cnf literal]
+
+  Description [The index is 0-based, as with minisat]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int sat_cdcl_get_cnf_var(const SatSolver_ptr solver, int var)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  return sat_cdcl_cdclLiteral2cnfLiteral(self, 1 + var);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Creates a new group and returns its ID ]
+
+  Description [Adds the group at the END of the existing groups list]
+
+  SideEffects []
+
+  SeeAlso     [SatIncSolver_destroy_group,
+  SatIncSolver_move_to_permanent_and_destroy_group]
+
+******************************************************************************/
+SatSolverGroup sat_cdcl_create_group(const SatIncSolver_ptr solver)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  int newGroup;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  newGroup = Cdcl_New_Variable(self->cdclSolver);
+  Olist_append(SAT_SOLVER(self)->existingGroups,
+               PTR_FROM_INT(void*, newGroup));
+  return newGroup;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Destroy an existing group (which has been returned by
+  SatIncSolver_create_group) and all formulas in it. ]
+
+  Description [Just adds to the solver a unit clause with positive literal
+  of a variable with index equal to group id. The clauses of the group,
+  being satisfied, are removed by the engine at the next
+  simplification.]
+
+  SideEffects []
+
+  SeeAlso     [SatIncSolver_create_group]
+
+******************************************************************************/
+void sat_cdcl_destroy_group(const SatIncSolver_ptr solver,
+                            SatSolverGroup group)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  int cdclClause[1];
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+  /* it should not be a permanent group */
+  nusmv_assert(SatSolver_get_permanent_group(SAT_SOLVER(self)) != group);
+  /* the group should exist */
+  nusmv_assert(Olist_contains(SAT_SOLVER(self)->existingGroups,
+                              (void*)group));
+
+  /* delete the group from the lists */
+  Olist_remove(SAT_SOLVER(self)->existingGroups, (void*)group);
+  Olist_remove(SAT_SOLVER(self)->unsatisfiableGroups, (void*)group);
+
+  cdclClause[0] = group;
+  Cdcl_Add_Clause(self->cdclSolver, cdclClause, 1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Moves all formulas from a group into the permanent group of
+  the solver and then destroy the given group.]
+
+  Description [just adds to the engine a unit clause with negative literal
+  of a variable with index equal to group id]
+
+  SideEffects []
+
+  SeeAlso     [SatIncSolver_create_group, SatSolver_get_permanent_group]
+
+******************************************************************************/
+void sat_cdcl_move_to_permanent_and_destroy_group(const SatIncSolver_ptr solver,
+                                                  SatSolverGroup group)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SatSolverGroup permanentGroup;
+  int cdclClause[1];
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  permanentGroup = SatSolver_get_permanent_group(SAT_SOLVER(self));
+
+  /* it should not be a permanent group */
+  nusmv_assert(permanentGroup != group);
+  /* the group should exist */
+  nusmv_assert(Olist_contains(SAT_SOLVER(self)->existingGroups,
+                              (void*)group));
+
+  /* if the group is unsatisfiable, make the permanent group unsatisfiable */
+  if (Olist_contains(SAT_SOLVER(self)->unsatisfiableGroups, (void*)group) &&
+      ! Olist_contains(SAT_SOLVER(self)->unsatisfiableGroups,
+                       (void*)permanentGroup)) {
+    Olist_prepend(SAT_SOLVER(self)->unsatisfiableGroups,
+                  (void*)permanentGroup);
+  }
+
+  /* delete the group from the lists */
+  Olist_remove(SAT_SOLVER(self)->existingGroups, (void*)group);
+  Olist_remove(SAT_SOLVER(self)->unsatisfiableGroups, (void*)group);
+
+  cdclClause[0] = -group;
+  Cdcl_Add_Clause(self->cdclSolver, cdclClause, 1);
+  Cdcl_Simplify(self->cdclSolver);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Tries to solve formulas from the groups in the list.]
+
+  Description [The permanent group is automatically added to the list.
+  Returns a flag whether the solving was successful. If it was successful only
+  then SatSolver_get_model may be invoked to obtain the model ]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+SatSolverResult sat_cdcl_solve_groups(const SatIncSolver_ptr solver,
+                                      const Olist_ptr groups)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SatSolverGroup permanentGroup;
+  SatSolverResult result;
+  int* assumptions;
+  int numberOfGroups;
+  Oiter gen;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  permanentGroup = SatSolver_get_permanent_group(SAT_SOLVER(self));
+
+  /* if the permanent group is unsatisfiable => return.
+   We check it here because the input list may not contain permanent group */
+  if (Olist_contains(SAT_SOLVER(self)->unsatisfiableGroups,
+                     (void*)permanentGroup)) {
+    return SAT_SOLVER_UNSATISFIABLE_PROBLEM;
+  }
+
+  assumptions = ALLOC(int, Olist_get_size(groups) + 1);
+  numberOfGroups = 0;
+  OLIST_FOREACH(groups, gen) {
+    SatSolverGroup aGroup = (SatSolverGroup) Oiter_element(gen);
+
+    /* the group exists */
+    nusmv_assert(Olist_contains(SAT_SOLVER(self)->existingGroups,
+                                (void*)aGroup));
+
+    /* the group is unsatisfiable => exit */
+    if (Olist_contains(SAT_SOLVER(self)->unsatisfiableGroups,
+                       (void*)aGroup)) {
+      FREE(assumptions);
+      return SAT_SOLVER_UNSATISFIABLE_PROBLEM;
+    }
+
+    /* add negated literal of group id to the assumptions (if this is not
+       a permanent group) */
+    if (permanentGroup != aGroup) {
+      assumptions[numberOfGroups] = -aGroup;
+      ++numberOfGroups;
+    }
+  }
+
+  result = sat_cdcl_solve(self, assumptions, numberOfGroups);
+  FREE(assumptions);
+
+  return result;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Tries to solve formulas in groups belonging to the solver
+  except the groups in the list.]
+
+  Description [The permanent group must not be in the list.
+  Returns a flag whether the solving was successful. If it was successful only
+  then SatSolver_get_model may be invoked to obtain the model ]
+
+  SideEffects []
+
+  SeeAlso     [SatSolverResult,SatSolver_get_permanent_group,
+  SatIncSolver_create_group, SatSolver_get_model]
+
+******************************************************************************/
+SatSolverResult sat_cdcl_solve_without_groups(const SatIncSolver_ptr solver,
+                                              const Olist_ptr groups)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SatSolverResult result;
+  Olist_ptr includeGroups;
+  Oiter gen;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+  nusmv_assert(!Olist_contains(groups,
+                 (void*)SatSolver_get_permanent_group(SAT_SOLVER(self))));
+
+  /* create a list of all groups except the groups in the list */
+  includeGroups = Olist_create();
+  OLIST_FOREACH(SAT_SOLVER(self)->existingGroups, gen) {
+    SatSolverGroup aGroup = (SatSolverGroup) Oiter_element(gen);
+    if (!Olist_contains(groups, (void*)aGroup)) {
+      Olist_append(includeGroups, (void*)aGroup);
+    }
+  }
+
+  result = sat_cdcl_solve_groups(solver, includeGroups);
+  Olist_destroy(includeGroups);
+
+  return result;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Obtains the set of conflicting assumptions from the engine]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_solve_permanent_group_assume,
+  sat_cdcl_get_conflicts]
+
+******************************************************************************/
+Slist_ptr sat_cdcl_make_conflicts(const SatCdcl_ptr self)
+{
+  Slist_ptr conflict;
+  int litNumber;
+  int* lits;
+  int index;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+  /* a conflict is created only if there is no conflict */
+  nusmv_assert((Slist_ptr)NULL == self->conflict);
+
+  conflict = Slist_create();
+  litNumber = Cdcl_Get_Nof_Conflict_Lits(self->cdclSolver);
+  lits = ALLOC(int, litNumber + 1);
+  nusmv_assert((int*) NULL != lits);
+  Cdcl_Get_Conflict_Lits(self->cdclSolver, lits);
+
+  for (index = 0; index < litNumber; ++index) {
+    int cnfLiteral = sat_cdcl_cdclLiteral2cnfLiteral(self, lits[index]);
+    Slist_push(conflict, PTR_FROM_INT(void*, cnfLiteral));
+  }
+
+  FREE(lits);
+
+  return conflict;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Sets random polarity mode if seed is not zero, otherwise
+  sets default non-random polarity mode.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void sat_cdcl_set_random_mode(SatSolver_ptr solver, double seed)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  if (seed == 0) {
+    sat_cdcl_set_polarity_mode(solver, cdcl_polarity_user);
+  }
+  else {
+    Cdcl_Set_Random_Seed(self->cdclSolver, seed);
+    sat_cdcl_set_polarity_mode(solver, cdcl_polarity_rnd);
+  }
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Sets polarity mode accordingly to the passed value.]
+
+  Description [The values are the same of the MiniSat ones]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void sat_cdcl_set_polarity_mode(SatSolver_ptr solver, int mode)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  Cdcl_Set_Polarity_Mode(self->cdclSolver, mode);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Returns currently set polarity mode.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int sat_cdcl_get_polarity_mode(const SatSolver_ptr solver)
+{
+  const SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  return Cdcl_Get_Polarity_Mode(self->cdclSolver);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the cnf literals fixed at the top level by the
+  engine]
+
+  Description [Literals of group ids are not returned.]
+
+  SideEffects []
+
+  SeeAlso     [SatSolver_get_fixed_literals]
+
+******************************************************************************/
+Slist_ptr sat_cdcl_get_fixed_literals(const SatSolver_ptr solver)
+{
+  const SatCdcl_ptr self = SAT_CDCL(solver);
+  Slist_ptr fixed;
+  int litNumber;
+  int* lits;
+  int index;
+
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  fixed = Slist_create();
+  litNumber = Cdcl_Get_Nof_Fixed_Lits(self->cdclSolver);
+  lits = ALLOC(int, litNumber + 1);
+  nusmv_assert((int*) NULL != lits);
+  Cdcl_Get_Fixed_Lits(self->cdclSolver, lits);
+
+  for (index = 0; index < litNumber; ++index) {
+    int cnfLiteral = sat_cdcl_cdclLiteral2cnfLiteral(self, lits[index]);
+    if (0 != cnfLiteral) Slist_push(fixed, PTR_FROM_INT(void*, cnfLiteral));
+  }
+
+  FREE(lits);
+
+  return fixed;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the current interpolation group]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_new_itp_group]
+
+******************************************************************************/
+SatSolverItpGroup sat_cdcl_curr_itp_group(const SatSolver_ptr solver)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  return self->cdcl_itp_group;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Opens a new interpolation group and returns it]
+
+  Description [The clauses added from now on belong to the new group]
+
+  SideEffects []
+
+  SeeAlso     [sat_cdcl_curr_itp_group]
+
+******************************************************************************/
+SatSolverItpGroup sat_cdcl_new_itp_group(const SatSolver_ptr solver)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  self->cdcl_itp_group += 1;
+  Cdcl_Set_Proof_Group(self->cdclSolver, (int) self->cdcl_itp_group);
+  return self->cdcl_itp_group;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Extracts an interpolant from the proof of unsatisfiability]
+
+  Description [The solver must have been created with proof logging
+  enabled, and the last solving must have found the permanent group
+  unsatisfiable. As with minisat, the variables are passed to the
+  make_var callback as internal indices, to be converted with
+  SatSolver_get_cnf_var.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Interpolate]
+
+******************************************************************************/
+Term sat_cdcl_extract_interpolant(const SatSolver_ptr solver,
+                                  int nof_ga_groups,
+                                  SatSolverItpGroup* ga_groups,
+                                  TermFactoryCallbacks_ptr callbacks,
+                                  TermFactoryCallbacksUserData_ptr user_data)
+{
+  SatCdcl_ptr self = SAT_CDCL(solver);
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  return Cdcl_Interpolate(self->cdclSolver, nof_ga_groups, ga_groups,
+                          callbacks, user_data);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Enlarge cdclClause, adapt cdclClauseSize]
+
+  Description [Enlarges cdclClause until it has at least size minSize.]
+
+  SideEffects [cdclClause might be reallocated, cdclClauseSize
+               changes value.]
+
+  SeeAlso     [sat_cdcl_add]
+
+******************************************************************************/
+void sat_cdcl_enlarge_cdclClause(const SatCdcl_ptr self, unsigned int minSize)
+{
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  while (self->cdclClauseSize < minSize) {
+    self->cdclClauseSize = self->cdclClauseSize * 2 + 1;
+    self->cdclClause = REALLOC(int, self->cdclClause, self->cdclClauseSize);
+    nusmv_assert(self->cdclClause != (int*) NULL);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Initializer, De-initializer, Finalizer                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Initializes Sat Cdcl object.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void sat_cdcl_init(SatCdcl_ptr self, const char* name,
+                   boolean enable_proof_logging)
+{
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  sat_inc_solver_init(SAT_INC_SOLVER(self), name);
+
+  OVERRIDE(Object, finalize) = sat_cdcl_finalize;
+
+  OVERRIDE(SatSolver, add) = sat_cdcl_add;
+  OVERRIDE(SatSolver, add_clause) = sat_cdcl_add_clause;
+  OVERRIDE(SatSolver, set_polarity) = sat_cdcl_set_polarity;
+  OVERRIDE(SatSolver, set_preferred_variables) =
+    sat_cdcl_set_preferred_variables;
+  OVERRIDE(SatSolver, clear_preferred_variables) =
+    sat_cdcl_clear_preferred_variables;
+  OVERRIDE(SatSolver, solve_all_groups) = sat_cdcl_solve_all_groups;
+  OVERRIDE(SatSolver, solve_all_groups_assume) =
+    sat_cdcl_solve_permanent_group_assume;
+
+  OVERRIDE(SatSolver, make_model) = sat_cdcl_make_model;
+  OVERRIDE(SatSolver, get_cnf_var) = sat_cdcl_get_cnf_var;
+  OVERRIDE(SatSolver, get_conflicts) = sat_cdcl_get_conflicts;
+
+  OVERRIDE(SatIncSolver, create_group) = sat_cdcl_create_group;
+  OVERRIDE(SatIncSolver, destroy_group) = sat_cdcl_destroy_group;
+  OVERRIDE(SatIncSolver, move_to_permanent_and_destroy_group)
+    = sat_cdcl_move_to_permanent_and_destroy_group;
+  OVERRIDE(SatIncSolver, solve_groups) = sat_cdcl_solve_groups;
+  OVERRIDE(SatIncSolver, solve_without_groups)
+    = sat_cdcl_solve_without_groups;
+
+  OVERRIDE(SatSolver, set_random_mode) = sat_cdcl_set_random_mode;
+  OVERRIDE(SatSolver, set_polarity_mode) = sat_cdcl_set_polarity_mode;
+  OVERRIDE(SatSolver, get_polarity_mode) = sat_cdcl_get_polarity_mode;
+  OVERRIDE(SatSolver, get_fixed_literals) = sat_cdcl_get_fixed_literals;
+
+  OVERRIDE(SatSolver, curr_itp_group) = sat_cdcl_curr_itp_group;
+  OVERRIDE(SatSolver, new_itp_group) = sat_cdcl_new_itp_group;
+  OVERRIDE(SatSolver, extract_interpolant) = sat_cdcl_extract_interpolant;
+
+  self->cdclSolver = Cdcl_Create(enable_proof_logging);
+  self->cdcl_itp_group = 0;
+
+  /* the exisiting (-1) permanent group is OK, since the engine always
+     deals with variables greater then 0 */
+
+  self->cnfVar2cdclVar = new_assoc();
+  self->cdclVar2cnfVar = new_assoc();
+
+  self->conflict = (Slist_ptr) NULL;
+
+  self->cdclClauseSize = 10;
+  self->cdclClause = ALLOC(int, self->cdclClauseSize);
+  nusmv_assert(self->cdclClause != (int*) NULL);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Deinitializes SatCdcl object.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void sat_cdcl_deinit(SatCdcl_ptr self)
+{
+  SAT_CDCL_CHECK_INSTANCE(self);
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 1)) {
+    Cdcl_Print_Stats(self->cdclSolver, nusmv_stderr);
+  }
+
+  FREE(self->cdclClause);
+
+  if ((Slist_ptr) NULL != self->conflict) Slist_destroy(self->conflict);
+
+  free_assoc(self->cnfVar2cdclVar);
+  free_assoc(self->cdclVar2cnfVar);
+
+  Cdcl_Delete(self->cdclSolver);
+
+  sat_solver_deinit(SAT_SOLVER(self));
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Finalize method of SatCdcl class.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void sat_cdcl_finalize(Object_ptr object, void* dummy)
+{
+  SatCdcl_ptr self = SAT_CDCL(object);
+  sat_cdcl_deinit(self);
+  FREE(self);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Calls the engine under the given assumptions]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static SatSolverResult sat_cdcl_solve(SatCdcl_ptr self, int* assumptions,
+                                      int numberOfAssumptions)
+{
+  if (1 == Cdcl_Solve_Assume(self->cdclSolver, numberOfAssumptions,
+                             assumptions)) {
+    return SAT_SOLVER_SATISFIABLE_PROBLEM;
+  }
+  return SAT_SOLVER_UNSATISFIABLE_PROBLEM;
+}
+
+#endif /* NUSMV_HAVE_SOLVER_CDCL */
@@ -0,0 +1,85 @@
+/**CHeaderFile*****************************************************************
+
+  FileName    [SatCdcl.h]
+
+  PackageName [SatCdcl]
+
+  Synopsis    [The header file for the SatCdcl class.]
+
+  Description [SatCdcl is an incremental SAT solver built on the
+  in-tree CDCL engine (see cdclSolver.h), that needs no external
+  library. SatCdcl inherits the SatIncSolver (interface) class]
+
+  SeeAlso     [SatMinisat.h]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``sat'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+  Revision    [$Id: SatCdcl.h,v 1.1.2.1 2011-03-01 10:00:00 nusmv Exp $]
+
+******************************************************************************/
+
+#ifndef __SAT_SOLVER_SAT_CDCL__H
+#define __SAT_SOLVER_SAT_CDCL__H
+
+#include "sat/SatIncSolver.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+typedef struct SatCdcl_TAG* SatCdcl_ptr;
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define SAT_CDCL(x)                             \
+  ((SatCdcl_ptr) x)
+
+#define SAT_CDCL_CHECK_INSTANCE(x)                      \
+  (nusmv_assert(SAT_CDCL(x) != SAT_CDCL(NULL)))
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* SatCdcl Constructor/Destructors */
+EXTERN SatCdcl_ptr SatCdcl_create ARGS((const char* name,
+                                        boolean enable_proof_logging));
+EXTERN void SatCdcl_destroy ARGS((SatCdcl_ptr self));
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __SAT_SOLVER_SAT_CDCL__H */
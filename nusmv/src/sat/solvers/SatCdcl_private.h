@@ -0,0 +1,184 @@
+/**CFile***********************************************************************
+
+  FileName    [SatCdcl_private.h]
+
+  PackageName [SatCdcl]
+
+  Synopsis    [The private interface of class SatCdcl]
+
+  Description [Private definition to be used by derived classes]
+
+  SeeAlso     []
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``sat'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+  Revision    [$Id: SatCdcl_private.h,v 1.1.2.1 2011-03-01 10:00:00 nusmv Exp $]
+
+******************************************************************************/
+#ifndef __SAT_CDCL_PRIVATE__H
+#define __SAT_CDCL_PRIVATE__H
+
+#include "SatCdcl.h"
+#include "cdclSolver.h"
+
+#include "sat/SatIncSolver_private.h"
+#include "utils/assoc.h"
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+/**Struct**********************************************************************
+
+  Synopsis    [SatCdcl Class]
+
+  Description [Groups are implemented by activation literals: every
+  non-permanent group is an internal variable, whose positive literal
+  is added to each clause of the group. Solving a set of groups means
+  assuming the negated literals of the groups. Destroying a group
+  asserts its literal, which satisfies all its clauses: those are
+  then removed from the clause database by the inprocessing of the
+  engine.]
+
+  SeeAlso     []
+
+*******************************************************************************/
+typedef struct SatCdcl_TAG
+{
+  INHERITS_FROM(SatIncSolver);
+
+  Cdcl_ptr cdclSolver; /* actual instance of the engine */
+  /* All input variables are represented by the internal ones inside the
+     SatCdcl. Bellow two hash table perform the convertion in both ways */
+  hash_ptr cnfVar2cdclVar; /* converts CNF variable to internal variable */
+  hash_ptr cdclVar2cnfVar; /* converts internal variable into CNF variable */
+
+  /* contains set of conflicting assumptions after using
+     sat_cdcl_solve_permanent_group_assume */
+  Slist_ptr conflict;
+
+  /* a buffer for the clauses passed to the engine */
+  int* cdclClause;
+  unsigned int cdclClauseSize;
+
+  /* the current interpolation group */
+  SatSolverItpGroup cdcl_itp_group;
+} SatCdcl;
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+void sat_cdcl_init ARGS((SatCdcl_ptr self, const char* name,
+                         boolean enable_proof_logging));
+void sat_cdcl_deinit ARGS((SatCdcl_ptr self));
+
+int sat_cdcl_cnfLiteral2cdclLiteral ARGS((SatCdcl_ptr self, int cnfLiteral));
+int sat_cdcl_cdclLiteral2cnfLiteral ARGS((SatCdcl_ptr self, int cdclLiteral));
+
+/* virtual function from SatSolver */
+void sat_cdcl_add ARGS((const SatSolver_ptr self,
+                        const Be_Cnf_ptr cnfProb,
+                        SatSolverGroup group));
+
+void sat_cdcl_add_clause ARGS((const SatSolver_ptr self,
+                               const int* clause, int size,
+                               SatSolverGroup group));
+
+void sat_cdcl_set_polarity ARGS((const SatSolver_ptr self,
+                                 const Be_Cnf_ptr cnfProb,
+                                 int polarity,
+                                 SatSolverGroup group));
+
+void sat_cdcl_set_preferred_variables ARGS((const SatSolver_ptr self,
+                                            const Slist_ptr cnfVars));
+
+void sat_cdcl_clear_preferred_variables ARGS((const SatSolver_ptr self));
+
+SatSolverResult sat_cdcl_solve_all_groups ARGS((const SatSolver_ptr self));
+
+SatSolverResult
+sat_cdcl_solve_permanent_group_assume ARGS((const SatSolver_ptr self,
+                                            Slist_ptr assumption));
+
+Slist_ptr sat_cdcl_get_conflicts ARGS((const SatSolver_ptr));
+
+Slist_ptr sat_cdcl_make_model ARGS((const SatSolver_ptr self));
+
+int sat_cdcl_get_cnf_var ARGS((const SatSolver_ptr self, int var));
+
+/* virtual functions from SatIncSolver */
+SatSolverGroup
+sat_cdcl_create_group ARGS((const SatIncSolver_ptr self));
+
+void
+sat_cdcl_destroy_group ARGS((const SatIncSolver_ptr self,
+                             SatSolverGroup group));
+
+void
+sat_cdcl_move_to_permanent_and_destroy_group
+                                ARGS((const SatIncSolver_ptr self,
+                                      SatSolverGroup group));
+SatSolverResult
+sat_cdcl_solve_groups ARGS((const SatIncSolver_ptr self,
+                            const Olist_ptr groups));
+
+SatSolverResult
+sat_cdcl_solve_without_groups ARGS((const SatIncSolver_ptr self,
+                                    const Olist_ptr groups));
+
+/* the assumptions/conflict interface */
+Slist_ptr sat_cdcl_make_conflicts ARGS((const SatCdcl_ptr self));
+
+void sat_cdcl_enlarge_cdclClause ARGS((const SatCdcl_ptr self,
+                                       unsigned int minSize));
+
+/* polarity mode */
+void sat_cdcl_set_random_mode ARGS((SatSolver_ptr self, double seed));
+void sat_cdcl_set_polarity_mode ARGS((SatSolver_ptr self, int mode));
+int  sat_cdcl_get_polarity_mode ARGS((const SatSolver_ptr self));
+
+Slist_ptr sat_cdcl_get_fixed_literals ARGS((const SatSolver_ptr self));
+
+SatSolverItpGroup sat_cdcl_curr_itp_group ARGS((const SatSolver_ptr self));
+
+SatSolverItpGroup sat_cdcl_new_itp_group ARGS((const SatSolver_ptr self));
+
+Term
+sat_cdcl_extract_interpolant ARGS((const SatSolver_ptr self,
+                                   int nof_ga_groups,
+                                   SatSolverItpGroup* ga_groups,
+                                   TermFactoryCallbacks_ptr callbacks,
+                                   TermFactoryCallbacksUserData_ptr user_data));
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __SAT_CDCL_PRIVATE__H */
@@ -214,57 +214,67 @@ void sat_minisat_add(const SatSolver_ptr solver,
                      const Be_Cnf_ptr cnfProb,
                      SatSolverGroup group)
 {
-  SatMinisat_ptr self = SAT_MINISAT(solver);
-
   int * clause = (int *)NULL;
   Siter genClause;
-  int* minisatClause;
 
-  /* just for efficiency */
-  const int groupIsNotPermanent =
-    SatSolver_get_permanent_group(SAT_SOLVER(self)) != group;
+  SAT_MINISAT_CHECK_INSTANCE(solver);
 
+  SLIST_FOREACH (Be_Cnf_GetClausesList(cnfProb), genClause) {
+    clause = (int*) Siter_element(genClause);
 
-  SAT_MINISAT_CHECK_INSTANCE(self);
+    sat_minisat_add_clause(solver, clause, _get_clause_size(clause), group);
+  } /* while() */
+}
 
-  minisatClause = sat_minisat_get_minisatClause(self);
+/**Function********************************************************************
 
-  SLIST_FOREACH (Be_Cnf_GetClausesList(cnfProb), genClause) {
-    clause = (int*) Siter_element(genClause);
+  Synopsis    [Adds a single clause to the solver database.]
 
-    int literal, i;
-    int clause_size = _get_clause_size(clause);
-    int literalNumber = 0;
+  Description [converts the 'size' CNF literals of the clause into the
+  internal literals, adds the group id (if group is not permament) and
+  then adds the obtained clause to actual Minisat]
 
-    if (sat_minisat_get_minisatClauseSize(self) - 4 <= clause_size) {
-      sat_minisat_enlarge_minisatClause(self, clause_size + 5);
-      minisatClause = sat_minisat_get_minisatClause(self);
-    }
-    i = 0;
-    while (clause[i] != 0) {
-      literal = clause[i];
-      minisatClause[literalNumber]
-        = sat_minisat_cnfLiteral2minisatLiteral(self, literal);
-      ++literalNumber;
-      i++;
-    }
+  SideEffects []
 
-    if (groupIsNotPermanent) { /* add group id to the clause */
-      minisatClause[literalNumber] = group;
-      ++literalNumber;
-    }
+  SeeAlso     [sat_minisat_add]
+
+******************************************************************************/
+void sat_minisat_add_clause(const SatSolver_ptr solver,
+                            const int* clause, int size,
+                            SatSolverGroup group)
+{
+  SatMinisat_ptr self = SAT_MINISAT(solver);
+
+  int* minisatClause;
+  int literalNumber;
+
+  SAT_MINISAT_CHECK_INSTANCE(self);
+
+  if (sat_minisat_get_minisatClauseSize(self) - 4 <= size) {
+    sat_minisat_enlarge_minisatClause(self, size + 5);
+  }
+  minisatClause = sat_minisat_get_minisatClause(self);
+
+  for (literalNumber = 0; literalNumber < size; ++literalNumber) {
+    minisatClause[literalNumber]
+      = sat_minisat_cnfLiteral2minisatLiteral(self, clause[literalNumber]);
+  }
+
+  if (SatSolver_get_permanent_group(SAT_SOLVER(self)) != group) {
+    /* add group id to the clause */
+    minisatClause[literalNumber] = group;
+    ++literalNumber;
+  }
 #ifdef MINISAT_WITH_PROOF_LOGGING
-    /* add to real minisat */
-    MiniSat_Add_Clause(self->minisatSolver, minisatClause,
-                       literalNumber, SatSolver_curr_itp_group(solver));
+  /* add to real minisat */
+  MiniSat_Add_Clause(self->minisatSolver, minisatClause,
+                     literalNumber, SatSolver_curr_itp_group(solver));
 #else
-    MiniSat_Add_Clause(self->minisatSolver, minisatClause,
-                       literalNumber);
+  MiniSat_Add_Clause(self->minisatSolver, minisatClause,
+                     literalNumber);
 #endif
-    /* with the new interface of minisat there is not reason to remember
-       that an unsatisfiable clause has been added to the solver */
-
-  } /* while() */
+  /* with the new interface of minisat there is not reason to remember
+     that an unsatisfiable clause has been added to the solver */
 }
 
 /**Function********************************************************************
@@ -460,12 +470,16 @@ sat_minisat_solve_permanent_group_assume(const SatSolver_ptr sol,
   solver = SAT_SOLVER(self);
 
   /* destroy the model of previous solving */
-  Slist_destroy(solver->model);
-  solver->model = (Slist_ptr)NULL;
+  if ((Slist_ptr)NULL != solver->model) {
+    Slist_destroy(solver->model);
+    solver->model = (Slist_ptr)NULL;
+  }
 
   /* destroy the conflict of previous solving */
-  Slist_destroy(self->conflict);
-  self->conflict = (Slist_ptr)NULL;
+  if ((Slist_ptr)NULL != self->conflict) {
+    Slist_destroy(self->conflict);
+    self->conflict = (Slist_ptr)NULL;
+  }
 
   permanentGroup = SatSolver_get_permanent_group(solver);
 
@@ -1107,6 +1121,7 @@ void sat_minisat_init(SatMinisat_ptr self, const char* name,
   OVERRIDE(Object, finalize) = sat_minisat_finalize;
 
   OVERRIDE(SatSolver, add) = sat_minisat_add;
+  OVERRIDE(SatSolver, add_clause) = sat_minisat_add_clause;
   OVERRIDE(SatSolver, set_polarity) = sat_minisat_set_polarity;
   OVERRIDE(SatSolver, set_preferred_variables) =
     sat_minisat_set_preferred_variables;
@@ -107,6 +107,10 @@ void sat_minisat_add ARGS((const SatSolver_ptr self,
                            const Be_Cnf_ptr cnfProb,
                            SatSolverGroup group));
 
+void sat_minisat_add_clause ARGS((const SatSolver_ptr self,
+                                  const int* clause, int size,
+                                  SatSolverGroup group));
+
 void sat_minisat_set_polarity ARGS((const SatSolver_ptr self,
                                     const Be_Cnf_ptr cnfProb,
                                     int polarity,
@@ -221,49 +221,60 @@ void sat_zchaff_add(const SatSolver_ptr solver,
                     const Be_Cnf_ptr cnfProb,
                     SatSolverGroup group)
 {
-  SatZchaff_ptr self = SAT_ZCHAFF(solver);
-
   int * clause = (int *)NULL;
   Siter iterClause;
-  int literal;
+
+  SAT_ZCHAFF_CHECK_INSTANCE(solver);
+
+  SLIST_FOREACH(Be_Cnf_GetClausesList(cnfProb), iterClause) {
+    clause = (int*)Siter_element(iterClause);
+
+    sat_zchaff_add_clause(solver, clause, _get_clause_size(clause), group);
+  }
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Adds a single clause to the solver database.]
+
+  Description [converts the 'size' CNF literals of the clause into
+  ZChaff's literals, adds the group id (if group is not permament) and
+  then adds the obtained clause to actual ZChaff]
+
+  SideEffects []
+
+  SeeAlso     [sat_zchaff_add]
+
+******************************************************************************/
+void sat_zchaff_add_clause(const SatSolver_ptr solver,
+                           const int* clause, int size,
+                           SatSolverGroup group)
+{
+  SatZchaff_ptr self = SAT_ZCHAFF(solver);
+
   int literalNumber;
-  int clause_lenght;
 
   /* buffer to hold zchaff's clauses. I think a usual clause will be
    2-4 literal and in any case it will not be more then 1000 literal
    (there is an assertion to check it) */
   static int zchaffClause[1000];
-  /* just for efficiency */
-  const int groupIsNotPermanent =
-    SatSolver_get_permanent_group(SAT_SOLVER(self)) != group;
-
 
   SAT_ZCHAFF_CHECK_INSTANCE(self);
 
-  SLIST_FOREACH(Be_Cnf_GetClausesList(cnfProb), iterClause) {
-    clause = (int*)Siter_element(iterClause);
-
-    int i = 0;
-    literalNumber = 0;
-    clause_lenght = _get_clause_size(clause);
-
-    nusmv_assert(1000 > clause_lenght); /* see zchaffClause above */
+  nusmv_assert(1000 > size); /* see zchaffClause above */
 
-    while (clause[i] != 0) {
-      literal = clause[i];
-      zchaffClause[literalNumber] =
-        sat_zchaff_cnfLiteral2zchaffLiteral(self, literal);
-      ++literalNumber;
-      i++;
-    }
+  for (literalNumber = 0; literalNumber < size; ++literalNumber) {
+    zchaffClause[literalNumber] =
+      sat_zchaff_cnfLiteral2zchaffLiteral(self, clause[literalNumber]);
+  }
 
-    if (groupIsNotPermanent) { /* add literal with group id the the clause */
-        zchaffClause[literalNumber] = group*2;
-        ++literalNumber;
-      }
-    /* add to real zchaff group 0 (real permanent one) */
-    SAT_AddClause(self->zchaffSolver, zchaffClause, literalNumber, 0);
+  if (SatSolver_get_permanent_group(SAT_SOLVER(self)) != group) {
+    /* add literal with group id the the clause */
+    zchaffClause[literalNumber] = group*2;
+    ++literalNumber;
   }
+  /* add to real zchaff group 0 (real permanent one) */
+  SAT_AddClause(self->zchaffSolver, zchaffClause, literalNumber, 0);
 }
 
 /**Function********************************************************************
@@ -756,6 +767,7 @@ void sat_zchaff_init(SatZchaff_ptr self, const char* name)
   OVERRIDE(Object, finalize) = sat_zchaff_finalize;
 
   OVERRIDE(SatSolver, add) = sat_zchaff_add;
+  OVERRIDE(SatSolver, add_clause) = sat_zchaff_add_clause;
   OVERRIDE(SatSolver, set_polarity) = sat_zchaff_set_polarity;
   OVERRIDE(SatSolver, set_preferred_variables) =
     sat_zchaff_set_preferred_variables;
@@ -0,0 +1,2567 @@
+/**CFile***********************************************************************
+
+  FileName    [cdclSolver.c]
+
+  PackageName [sat.solvers]
+
+  Synopsis    [The in-tree CDCL SAT engine]
+
+  Description [A conflict-driven clause-learning SAT solver written for
+  incremental use from the BMC algorithms. The main ingredients are:
+
+  <ul>
+  <li> two watched literals with blocking literals;
+  <li> VSIDS decision heuristic with phase saving, and an optional
+       list of preferred variables that are decided first;
+  <li> first-UIP conflict analysis with recursive minimization of the
+       learnt clause;
+  <li> learnt clause database reduction driven by the LBD (number of
+       distinct decision levels) of the clauses: clauses with LBD not
+       greater than 2 are never removed, clauses that took part in a
+       conflict since the last reduction survive one more round;
+  <li> restarts triggered by comparing a fast and a slow moving
+       average of the LBD of learnt clauses. A restart backtracks to
+       the last assumption level only, so that the (possibly long)
+       prefix of assumptions used to activate groups is not propagated
+       again at every restart;
+  <li> inprocessing between calls to Cdcl_Solve_Assume: satisfied
+       clauses are removed and false literals are stripped at level 0
+       (this is what actually frees the clauses of destroyed groups),
+       and learnt clauses with a small LBD are vivified;
+  <li> optional logging of the resolution proof of the empty clause,
+       from which interpolants are extracted (see Cdcl_Interpolate).
+  </ul>
+
+  Clauses are stored contiguously in an arena of integers and are
+  referred to by their offset in the arena. Internal literals are
+  encoded as 2*var+sign, with variables starting from 0.
+
+  When proof logging is enabled every clause of the arena refers to
+  the record of its derivation in the proof. The proof is a sequence
+  of records, each identified by its offset: an original record holds
+  the interpolation group and the literals of an added clause, a
+  derived record holds a chain of resolutions, i.e. a first
+  antecedent followed by pairs (pivot variable, antecedent). Units
+  fixed at level 0 are resolved away explicitly, so every record only
+  refers to records preceding it. Learnt clause minimization and
+  vivification are disabled when logging, as they do not produce
+  resolution chains.]
+
+  SeeAlso     [cdclSolver.h SatCdcl.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``sat'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#include "cdclSolver.h"
+#include "utils/error.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static char rcsid[] UTIL_UNUSED = "$Id: cdclSolver.c,v 1.1.2.1 2011-03-01 10:00:00 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+#define CDCL_NO_CLAUSE (-1)
+
+/* the clause header is made of the size, the flags and the proof id */
+#define CDCL_HEADER_SIZE 3
+
+#define CDCL_FLAG_LEARNT  0x1
+#define CDCL_FLAG_DELETED 0x2
+#define CDCL_FLAG_USED    0x4
+#define CDCL_LBD_SHIFT    8
+
+/* learnt clauses whose LBD is not greater than this are never removed */
+#define CDCL_GLUE_LBD 2
+
+/* search parameters */
+#define CDCL_VAR_DECAY          0.95
+#define CDCL_RESTART_MIN        50
+#define CDCL_RESTART_MARGIN     1.25
+#define CDCL_EMA_FAST           (1.0 / 32.0)
+#define CDCL_EMA_SLOW           (1.0 / 4096.0)
+#define CDCL_REDUCE_FIRST       2000
+#define CDCL_REDUCE_INC         300
+
+/* inprocessing parameters */
+#define CDCL_VIVIFY_INTERVAL    2000
+#define CDCL_VIVIFY_MAX_LBD     8
+#define CDCL_VIVIFY_MIN_EFFORT  10000
+#define CDCL_VIVIFY_EFFORT      10 /* percent of the search propagations */
+
+/* the kinds of proof records, and the mark used when visiting them */
+#define CDCL_PROOF_ORIGINAL 0
+#define CDCL_PROOF_DERIVED  1
+#define CDCL_PROOF_MARK     0x100
+#define CDCL_NO_PROOF       (-1)
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+typedef struct CdclVec_TAG {
+  int* data;
+  int size;
+  int cap;
+} CdclVec;
+
+typedef struct CdclWatch_TAG {
+  int cref;     /* the watching clause */
+  int blocker;  /* a literal of the clause, if true the clause is skipped */
+} CdclWatch;
+
+typedef struct CdclWatchList_TAG {
+  CdclWatch* data;
+  int size;
+  int cap;
+} CdclWatchList;
+
+typedef struct CdclReduceEntry_TAG {
+  int lbd;
+  int size;
+  int cref;
+} CdclReduceEntry;
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [The CDCL solver]
+
+  Description [Per-variable arrays are sized by cap_vars, per-literal
+  arrays by twice that.]
+
+******************************************************************************/
+typedef struct Cdcl_TAG {
+  int nvars;
+  int cap_vars;
+
+  /* assignment */
+  signed char* value;     /* per literal: 1 true, -1 false, 0 unassigned */
+  int* level;
+  int* reason;
+  int* trail;
+  int trail_size;
+  int qhead;
+  CdclVec trail_lim;
+
+  /* decision heuristic */
+  double* activity;
+  double var_inc;
+  int* heap;
+  int heap_size;
+  int* heap_index;        /* position in the heap, -1 if not in the heap */
+  signed char* phase;     /* saved phase: 1 means negative */
+  CdclVec preferred;
+  int polarity_mode;
+  double random_seed;
+
+  /* clause database */
+  CdclVec arena;
+  int wasted;
+  CdclVec clauses;
+  CdclVec learnts;
+  CdclWatchList* watches; /* watches[l]: clauses watching literal l */
+  boolean ok;
+
+  /* incremental interface */
+  CdclVec assumptions;
+  CdclVec conflict;       /* failed assumptions, internal literals */
+  signed char* model;
+  int model_size;
+
+  /* restarts and reductions */
+  double lbd_fast;
+  double lbd_slow;
+  long conflicts_since_restart;
+  long next_reduce;
+  long next_vivify;
+  long vivify_props;      /* propagations at the end of the last vivify */
+  int simp_trail;
+
+  /* proof logging */
+  boolean proof_logging;
+  int proof_group;        /* interpolation group of the added clauses */
+  CdclVec proof;
+  int* unit_proof;        /* per variable: proof of the unit at level 0 */
+  int empty_proof;        /* proof of the empty clause, if derived */
+  CdclVec chain;          /* the resolution chain being recorded */
+
+  /* scratch data */
+  char* seen;
+  int* level_stamp;
+  int stamp;
+  CdclVec learnt;
+  CdclVec stack;
+  CdclVec to_clear;
+
+  /* statistics */
+  long solves;
+  long conflicts;
+  long decisions;
+  long propagations;
+  long restarts;
+  long reductions;
+  long removed;
+  long vivified;
+} Cdcl;
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+#define CDCL_LIT(var, neg) (((var) << 1) | (neg))
+#define CDCL_VAR(lit)      ((lit) >> 1)
+#define CDCL_SIGN(lit)     ((lit) & 1)
+#define CDCL_NEG(lit)      ((lit) ^ 1)
+
+#define CDCL_SIZE(s, cr)   ((s)->arena.data[(cr)])
+#define CDCL_FLAGS(s, cr)  ((s)->arena.data[(cr) + 1])
+#define CDCL_LITS(s, cr)   ((s)->arena.data + (cr) + CDCL_HEADER_SIZE)
+#define CDCL_PROOF(s, cr)  ((s)->arena.data[(cr) + 2])
+#define CDCL_LBD(s, cr)    (CDCL_FLAGS(s, cr) >> CDCL_LBD_SHIFT)
+
+#define CDCL_IS_LEARNT(s, cr)  ((CDCL_FLAGS(s, cr) & CDCL_FLAG_LEARNT) != 0)
+#define CDCL_IS_DELETED(s, cr) ((CDCL_FLAGS(s, cr) & CDCL_FLAG_DELETED) != 0)
+
+#define CDCL_DECISION_LEVEL(s) ((s)->trail_lim.size)
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void cdcl_vec_push ARGS((CdclVec* vec, int elem));
+static void cdcl_vec_free ARGS((CdclVec* vec));
+static void cdcl_watch_push ARGS((CdclWatchList* ws, int cref, int blocker));
+static void cdcl_watch_remove ARGS((CdclWatchList* ws, int cref));
+
+static int cdcl_ext_to_lit ARGS((Cdcl_ptr self, int ext));
+static int cdcl_lit_to_ext ARGS((int lit));
+static double cdcl_drand ARGS((double* seed));
+
+static void cdcl_heap_up ARGS((Cdcl_ptr self, int pos));
+static void cdcl_heap_down ARGS((Cdcl_ptr self, int pos));
+static void cdcl_heap_insert ARGS((Cdcl_ptr self, int var));
+static int cdcl_heap_pop ARGS((Cdcl_ptr self));
+static void cdcl_bump_var ARGS((Cdcl_ptr self, int var));
+
+static int cdcl_alloc_clause ARGS((Cdcl_ptr self, const int* lits, int size,
+                                   boolean learnt, int lbd, int proof));
+static void cdcl_attach ARGS((Cdcl_ptr self, int cref));
+static void cdcl_detach ARGS((Cdcl_ptr self, int cref));
+static void cdcl_delete ARGS((Cdcl_ptr self, int cref));
+static boolean cdcl_locked ARGS((Cdcl_ptr self, int cref));
+
+static void cdcl_enqueue ARGS((Cdcl_ptr self, int lit, int reason));
+static void cdcl_new_decision_level ARGS((Cdcl_ptr self));
+static void cdcl_cancel_until ARGS((Cdcl_ptr self, int level));
+static int cdcl_propagate ARGS((Cdcl_ptr self));
+
+static int cdcl_compute_lbd ARGS((Cdcl_ptr self, const int* lits, int size));
+static void cdcl_analyze ARGS((Cdcl_ptr self, int confl,
+                               int* out_btlevel, int* out_lbd,
+                               int* out_proof));
+static boolean cdcl_lit_redundant ARGS((Cdcl_ptr self, int lit,
+                                        unsigned int abstract_levels));
+static void cdcl_analyze_final ARGS((Cdcl_ptr self, int lit));
+
+static int cdcl_pick_branch ARGS((Cdcl_ptr self));
+static boolean cdcl_should_restart ARGS((Cdcl_ptr self));
+static void cdcl_reduce_db ARGS((Cdcl_ptr self));
+static int cdcl_reduce_compare ARGS((const void* a, const void* b));
+static void cdcl_clean_watches ARGS((Cdcl_ptr self));
+static void cdcl_remove_satisfied ARGS((Cdcl_ptr self, CdclVec* crefs));
+static void cdcl_garbage_collect ARGS((Cdcl_ptr self));
+static void cdcl_vivify ARGS((Cdcl_ptr self));
+static int cdcl_search ARGS((Cdcl_ptr self));
+
+static int cdcl_proof_original ARGS((Cdcl_ptr self, const int* lits,
+                                     int size));
+static void cdcl_proof_begin ARGS((Cdcl_ptr self, int id));
+static void cdcl_proof_resolve ARGS((Cdcl_ptr self, int var, int id));
+static int cdcl_proof_end ARGS((Cdcl_ptr self));
+static void cdcl_proof_unit ARGS((Cdcl_ptr self, int var, int cref));
+static void cdcl_proof_empty ARGS((Cdcl_ptr self, int cref));
+static int cdcl_proof_record_size ARGS((Cdcl_ptr self, int id));
+static boolean cdcl_proof_in_groups ARGS((int group, int num_groups,
+                                          const SatSolverItpGroup* groups));
+static int cdcl_proof_index ARGS((const CdclVec* ids, int id));
+static int cdcl_int_compare ARGS((const void* a, const void* b));
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Creates an empty solver]
+
+  Description [If enable_proof_logging is true, the solver records the
+  proof of unsatisfiability used by Cdcl_Interpolate.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Delete]
+
+******************************************************************************/
+Cdcl_ptr Cdcl_Create(boolean enable_proof_logging)
+{
+  Cdcl_ptr self = ALLOC(Cdcl, 1);
+  nusmv_assert((Cdcl_ptr) NULL != self);
+
+  memset(self, 0, sizeof(Cdcl));
+
+  self->var_inc = 1.0;
+  self->polarity_mode = cdcl_polarity_user;
+  self->random_seed = 91648253;
+  self->ok = true;
+  self->next_reduce = CDCL_REDUCE_FIRST;
+  self->next_vivify = CDCL_VIVIFY_INTERVAL;
+  self->simp_trail = -1;
+  self->proof_logging = enable_proof_logging;
+  self->empty_proof = CDCL_NO_PROOF;
+
+  return self;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Destroys a solver]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Create]
+
+******************************************************************************/
+void Cdcl_Delete(Cdcl_ptr self)
+{
+  int i;
+
+  for (i = 0; i < 2 * self->cap_vars; ++i) FREE(self->watches[i].data);
+  FREE(self->watches);
+
+  FREE(self->value);
+  FREE(self->level);
+  FREE(self->reason);
+  FREE(self->trail);
+  FREE(self->activity);
+  FREE(self->heap);
+  FREE(self->heap_index);
+  FREE(self->phase);
+  FREE(self->model);
+  FREE(self->seen);
+  FREE(self->level_stamp);
+  FREE(self->unit_proof);
+
+  cdcl_vec_free(&self->trail_lim);
+  cdcl_vec_free(&self->preferred);
+  cdcl_vec_free(&self->arena);
+  cdcl_vec_free(&self->clauses);
+  cdcl_vec_free(&self->learnts);
+  cdcl_vec_free(&self->assumptions);
+  cdcl_vec_free(&self->conflict);
+  cdcl_vec_free(&self->learnt);
+  cdcl_vec_free(&self->stack);
+  cdcl_vec_free(&self->to_clear);
+  cdcl_vec_free(&self->proof);
+  cdcl_vec_free(&self->chain);
+
+  FREE(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of variables]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Cdcl_Nof_Variables(Cdcl_ptr self)
+{
+  return self->nvars;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of (original and learnt) clauses]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Cdcl_Nof_Clauses(Cdcl_ptr self)
+{
+  return self->clauses.size + self->learnts.size;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Creates a new variable, and returns its index]
+
+  Description [Variables are numbered from 1]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Cdcl_New_Variable(Cdcl_ptr self)
+{
+  int var = self->nvars;
+
+  if (self->nvars == self->cap_vars) {
+    int cap = self->cap_vars * 2 + 16;
+    int i;
+
+    self->value = REALLOC(signed char, self->value, 2 * cap);
+    self->watches = REALLOC(CdclWatchList, self->watches, 2 * cap);
+    for (i = 2 * self->cap_vars; i < 2 * cap; ++i) {
+      self->watches[i].data = (CdclWatch*) NULL;
+      self->watches[i].size = self->watches[i].cap = 0;
+    }
+    self->level = REALLOC(int, self->level, cap);
+    self->reason = REALLOC(int, self->reason, cap);
+    self->trail = REALLOC(int, self->trail, cap);
+    self->activity = REALLOC(double, self->activity, cap);
+    self->heap = REALLOC(int, self->heap, cap);
+    self->heap_index = REALLOC(int, self->heap_index, cap);
+    self->phase = REALLOC(signed char, self->phase, cap);
+    self->seen = REALLOC(char, self->seen, cap);
+    self->level_stamp = REALLOC(int, self->level_stamp, cap + 1);
+    self->unit_proof = REALLOC(int, self->unit_proof, cap);
+    for (i = self->cap_vars; i <= cap; ++i) self->level_stamp[i] = 0;
+
+    self->cap_vars = cap;
+  }
+
+  self->value[CDCL_LIT(var, 0)] = 0;
+  self->value[CDCL_LIT(var, 1)] = 0;
+  self->level[var] = 0;
+  self->reason[var] = CDCL_NO_CLAUSE;
+  self->activity[var] = 0.0;
+  self->phase[var] = 1;
+  self->seen[var] = 0;
+  self->heap_index[var] = -1;
+  self->unit_proof[var] = CDCL_NO_PROOF;
+  self->nvars += 1;
+
+  cdcl_heap_insert(self, var);
+
+  return self->nvars;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Adds a clause]
+
+  Description [The clause is an array of num_lits literals over
+  existing variables. Returns 0 if the solver is found to be
+  unsatisfiable independently of any assumption, 1 otherwise. When
+  logging the proof, the clause belongs to the current interpolation
+  group.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Set_Proof_Group]
+
+******************************************************************************/
+int Cdcl_Add_Clause(Cdcl_ptr self, int* lits, int num_lits)
+{
+  int i, j;
+  int proof = CDCL_NO_PROOF;
+  CdclVec* c = &self->learnt;
+
+  nusmv_assert(CDCL_DECISION_LEVEL(self) == 0);
+  if (!self->ok) return 0;
+
+  /* normalizes the clause: sorts it, removes duplicates and false
+     literals, and skips it if satisfied or tautological */
+  c->size = 0;
+  for (i = 0; i < num_lits; ++i) {
+    cdcl_vec_push(c, cdcl_ext_to_lit(self, lits[i]));
+  }
+  for (i = 1; i < c->size; ++i) {
+    int lit = c->data[i];
+    for (j = i; j > 0 && c->data[j - 1] > lit; --j) c->data[j] = c->data[j - 1];
+    c->data[j] = lit;
+  }
+
+  for (i = j = 0; i < c->size; ++i) {
+    int lit = c->data[i];
+    if (self->value[lit] == 1) return 1;
+    if (j > 0 && c->data[j - 1] == CDCL_NEG(lit)) return 1;
+    if (j > 0 && c->data[j - 1] == lit) continue;
+    c->data[j++] = lit;
+  }
+  c->size = j;
+
+  /* the original clause is recorded before the false literals are
+     removed, since these are resolved with their units */
+  if (self->proof_logging) {
+    cdcl_proof_begin(self, cdcl_proof_original(self, c->data, c->size));
+  }
+  for (i = j = 0; i < c->size; ++i) {
+    int lit = c->data[i];
+    if (self->value[lit] == -1) {
+      if (self->proof_logging) {
+        cdcl_proof_resolve(self, CDCL_VAR(lit),
+                           self->unit_proof[CDCL_VAR(lit)]);
+      }
+    }
+    else c->data[j++] = lit;
+  }
+  c->size = j;
+  if (self->proof_logging) proof = cdcl_proof_end(self);
+
+  if (c->size == 0) {
+    self->ok = false;
+    self->empty_proof = proof;
+  }
+  else if (c->size == 1) {
+    int confl;
+
+    cdcl_enqueue(self, c->data[0], CDCL_NO_CLAUSE);
+    self->unit_proof[CDCL_VAR(c->data[0])] = proof;
+    confl = cdcl_propagate(self);
+    if (confl != CDCL_NO_CLAUSE) {
+      cdcl_proof_empty(self, confl);
+      self->ok = false;
+    }
+  }
+  else {
+    int cref = cdcl_alloc_clause(self, c->data, c->size, false, 0, proof);
+    cdcl_vec_push(&self->clauses, cref);
+    cdcl_attach(self, cref);
+  }
+
+  return self->ok ? 1 : 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Solves the problem under the given assumptions]
+
+  Description [Returns 1 if satisfiable, 0 otherwise. In the former
+  case the model can be read with Cdcl_Get_Value, in the latter the
+  failed assumptions with Cdcl_Get_Conflict_Lits. The conflict is
+  empty when the problem is unsatisfiable regardless of the
+  assumptions.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Cdcl_Solve_Assume(Cdcl_ptr self, int num_assumed, const int* assumed)
+{
+  int i, res;
+
+  self->model_size = 0;
+  self->conflict.size = 0;
+  self->solves += 1;
+
+  if (!Cdcl_Simplify(self)) return 0;
+
+  if (!self->proof_logging && self->conflicts >= self->next_vivify) {
+    cdcl_vivify(self);
+    if (!Cdcl_Simplify(self)) return 0;
+    self->next_vivify = self->conflicts + CDCL_VIVIFY_INTERVAL;
+  }
+
+  self->assumptions.size = 0;
+  for (i = 0; i < num_assumed; ++i) {
+    cdcl_vec_push(&self->assumptions, cdcl_ext_to_lit(self, assumed[i]));
+  }
+
+  res = cdcl_search(self);
+  cdcl_cancel_until(self, 0);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Simplifies the clause database at level 0]
+
+  Description [Removes satisfied clauses and false literals. Returns 0
+  if the problem has been found unsatisfiable, 1 otherwise.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Cdcl_Simplify(Cdcl_ptr self)
+{
+  int i, confl;
+
+  nusmv_assert(CDCL_DECISION_LEVEL(self) == 0);
+
+  if (!self->ok) return 0;
+  confl = cdcl_propagate(self);
+  if (confl != CDCL_NO_CLAUSE) {
+    cdcl_proof_empty(self, confl);
+    self->ok = false;
+    return 0;
+  }
+
+  if (self->trail_size != self->simp_trail) {
+    /* reasons at level 0 are never used, and are going to be removed
+       as satisfied clauses */
+    for (i = 0; i < self->trail_size; ++i) {
+      self->reason[CDCL_VAR(self->trail[i])] = CDCL_NO_CLAUSE;
+    }
+
+    cdcl_remove_satisfied(self, &self->learnts);
+    cdcl_remove_satisfied(self, &self->clauses);
+    cdcl_clean_watches(self);
+
+    self->simp_trail = self->trail_size;
+  }
+
+  if (self->wasted > self->arena.size / 2) cdcl_garbage_collect(self);
+
+  return 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the value of a variable in the last model]
+
+  Description [Returns 1 if true, 0 if false, -1 if not assigned (or
+  if there is no model).]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Cdcl_Get_Value(Cdcl_ptr self, int var)
+{
+  if (var < 1 || var > self->model_size) return -1;
+
+  switch (self->model[var - 1]) {
+  case 1: return 1;
+  case -1: return 0;
+  default: return -1;
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of failed assumptions]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Get_Conflict_Lits]
+
+******************************************************************************/
+int Cdcl_Get_Nof_Conflict_Lits(Cdcl_ptr self)
+{
+  return self->conflict.size;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Copies the failed assumptions into lits]
+
+  Description [lits must be large enough to contain
+  Cdcl_Get_Nof_Conflict_Lits literals. The failed assumptions are a
+  subset of the assumptions of the last call to Cdcl_Solve_Assume that
+  is inconsistent with the clauses.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Get_Nof_Conflict_Lits]
+
+******************************************************************************/
+void Cdcl_Get_Conflict_Lits(Cdcl_ptr self, int* lits)
+{
+  int i;
+
+  for (i = 0; i < self->conflict.size; ++i) {
+    lits[i] = cdcl_lit_to_ext(self->conflict.data[i]);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of literals fixed at level 0]
+
+  Description [Returns 0 if the problem is known to be unsatisfiable.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Get_Fixed_Lits]
+
+******************************************************************************/
+int Cdcl_Get_Nof_Fixed_Lits(Cdcl_ptr self)
+{
+  nusmv_assert(CDCL_DECISION_LEVEL(self) == 0);
+  return self->ok ? self->trail_size : 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Copies the literals fixed at level 0 into lits]
+
+  Description [lits must be large enough to contain
+  Cdcl_Get_Nof_Fixed_Lits literals. Every fixed literal is implied by
+  the clauses added so far, regardless of any assumption.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Get_Nof_Fixed_Lits]
+
+******************************************************************************/
+void Cdcl_Get_Fixed_Lits(Cdcl_ptr self, int* lits)
+{
+  int i;
+
+  for (i = 0; i < Cdcl_Get_Nof_Fixed_Lits(self); ++i) {
+    lits[i] = cdcl_lit_to_ext(self->trail[i]);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Marks a variable as preferred]
+
+  Description [Unassigned preferred variables are decided before any
+  other variable, in the order they have been given.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void Cdcl_Set_Preferred_Variable(Cdcl_ptr self, int var)
+{
+  nusmv_assert(var >= 1 && var <= self->nvars);
+  cdcl_vec_push(&self->preferred, var - 1);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Clears the list of preferred variables]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void Cdcl_Clear_Preferred_Variables(Cdcl_ptr self)
+{
+  self->preferred.size = 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Sets the polarity mode]
+
+  Description [cdcl_polarity_true and cdcl_polarity_false always decide
+  positively resp. negatively; cdcl_polarity_user (the default) uses
+  the saved phase of the variable; cdcl_polarity_rnd decides randomly.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void Cdcl_Set_Polarity_Mode(Cdcl_ptr self, int mode)
+{
+  nusmv_assert(mode >= cdcl_polarity_true && mode <= cdcl_polarity_rnd);
+  self->polarity_mode = mode;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the polarity mode]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int Cdcl_Get_Polarity_Mode(Cdcl_ptr self)
+{
+  return self->polarity_mode;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Sets the seed used by the random polarity mode]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void Cdcl_Set_Random_Seed(Cdcl_ptr self, double seed)
+{
+  self->random_seed = seed;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Sets the interpolation group of the clauses added from now
+  on]
+
+  Description [Only meaningful when logging the proof. Clauses are in
+  group 0 until this is called.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Interpolate]
+
+******************************************************************************/
+void Cdcl_Set_Proof_Group(Cdcl_ptr self, int group)
+{
+  self->proof_group = group;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Computes an interpolant from the proof of
+  unsatisfiability]
+
+  Description [The solver must have been created with proof logging
+  enabled, and must have been found unsatisfiable regardless of any
+  assumption. A is made of the clauses belonging to the num_groups
+  given interpolation groups, B of all the other clauses. The result
+  is McMillan's interpolant: a formula implied by A, inconsistent with
+  B, and built on the variables occurring in both A and B only. It is
+  built through the given callbacks, to which variables are passed as
+  0-based internal indices.
+
+  Partial interpolants are associated to the records of the proof the
+  empty clause depends on: an original clause of A gets the
+  disjunction of its literals occurring in B, a clause of B gets true,
+  and a resolution step conjoins the partial interpolants when the
+  pivot occurs in B, and disjoins them otherwise.]
+
+  SideEffects []
+
+  SeeAlso     [Cdcl_Set_Proof_Group]
+
+******************************************************************************/
+Term Cdcl_Interpolate(Cdcl_ptr self, int num_groups,
+                      const SatSolverItpGroup* groups,
+                      TermFactoryCallbacks_ptr callbacks,
+                      TermFactoryCallbacksUserData_ptr user_data)
+{
+  CdclVec needed;
+  char* in_b;
+  Term* itp;
+  Term res;
+  int id, i, n;
+
+  nusmv_assert(self->proof_logging);
+  nusmv_assert(!self->ok && self->empty_proof != CDCL_NO_PROOF);
+
+  /* the variables occurring in B */
+  in_b = ALLOC(char, self->nvars + 1);
+  memset(in_b, 0, self->nvars + 1);
+  for (id = 0; id < self->proof.size; id += cdcl_proof_record_size(self, id)) {
+    const int* r = self->proof.data + id;
+
+    if (r[0] == CDCL_PROOF_ORIGINAL &&
+        !cdcl_proof_in_groups(r[1], num_groups, groups)) {
+      for (i = 0; i < r[2]; ++i) in_b[CDCL_VAR(r[3 + i])] = 1;
+    }
+  }
+
+  /* the records the empty clause depends on, each preceded by its
+     antecedents once sorted */
+  needed.data = (int*) NULL;
+  needed.size = needed.cap = 0;
+  self->stack.size = 0;
+  cdcl_vec_push(&self->stack, self->empty_proof);
+  self->proof.data[self->empty_proof] |= CDCL_PROOF_MARK;
+  while (self->stack.size > 0) {
+    const int* r;
+
+    id = self->stack.data[--self->stack.size];
+    cdcl_vec_push(&needed, id);
+    r = self->proof.data + id;
+    if ((r[0] & ~CDCL_PROOF_MARK) != CDCL_PROOF_DERIVED) continue;
+
+    for (i = 0; i <= r[1]; ++i) {
+      int ante = r[2 + 2 * i];
+      if ((self->proof.data[ante] & CDCL_PROOF_MARK) == 0) {
+        self->proof.data[ante] |= CDCL_PROOF_MARK;
+        cdcl_vec_push(&self->stack, ante);
+      }
+    }
+  }
+  qsort(needed.data, needed.size, sizeof(int), cdcl_int_compare);
+
+  itp = ALLOC(Term, needed.size);
+  for (n = 0; n < needed.size; ++n) {
+    const int* r;
+    Term t;
+
+    id = needed.data[n];
+    self->proof.data[id] &= ~CDCL_PROOF_MARK;
+    r = self->proof.data + id;
+
+    if (r[0] == CDCL_PROOF_ORIGINAL) {
+      if (cdcl_proof_in_groups(r[1], num_groups, groups)) {
+        t = callbacks->make_false(user_data);
+        for (i = 0; i < r[2]; ++i) {
+          int lit = r[3 + i];
+          Term v;
+
+          if (!in_b[CDCL_VAR(lit)]) continue;
+          v = callbacks->make_var(CDCL_VAR(lit), user_data);
+          if (CDCL_SIGN(lit)) v = callbacks->make_not(v, user_data);
+          t = callbacks->make_or(t, v, user_data);
+        }
+      }
+      else t = callbacks->make_true(user_data);
+    }
+    else {
+      t = itp[cdcl_proof_index(&needed, r[2])];
+      for (i = 1; i <= r[1]; ++i) {
+        Term ante = itp[cdcl_proof_index(&needed, r[2 + 2 * i])];
+
+        if (in_b[r[1 + 2 * i]]) t = callbacks->make_and(t, ante, user_data);
+        else t = callbacks->make_or(t, ante, user_data);
+      }
+    }
+    itp[n] = t;
+  }
+
+  /* the empty clause is the last record it depends on */
+  res = itp[needed.size - 1];
+
+  FREE(itp);
+  cdcl_vec_free(&needed);
+  FREE(in_b);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Prints the search statistics]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void Cdcl_Print_Stats(Cdcl_ptr self, FILE* file)
+{
+  fprintf(file, "CDCL: %d vars, %d clauses, %d learnts\n",
+          self->nvars, self->clauses.size, self->learnts.size);
+  fprintf(file, "CDCL: %ld solves, %ld conflicts, %ld decisions, "
+          "%ld propagations\n", self->solves, self->conflicts,
+          self->decisions, self->propagations);
+  fprintf(file, "CDCL: %ld restarts, %ld reductions, %ld clauses removed, "
+          "%ld literals vivified\n", self->restarts, self->reductions,
+          self->removed, self->vivified);
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Appends an element to a vector]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_vec_push(CdclVec* vec, int elem)
+{
+  if (vec->size == vec->cap) {
+    vec->cap = vec->cap * 2 + 8;
+    vec->data = REALLOC(int, vec->data, vec->cap);
+    nusmv_assert((int*) NULL != vec->data);
+  }
+  vec->data[vec->size++] = elem;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Frees the memory of a vector]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_vec_free(CdclVec* vec)
+{
+  FREE(vec->data);
+  vec->size = vec->cap = 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Appends a watch to a watch list]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_watch_push(CdclWatchList* ws, int cref, int blocker)
+{
+  if (ws->size == ws->cap) {
+    ws->cap = ws->cap * 2 + 4;
+    ws->data = REALLOC(CdclWatch, ws->data, ws->cap);
+    nusmv_assert((CdclWatch*) NULL != ws->data);
+  }
+  ws->data[ws->size].cref = cref;
+  ws->data[ws->size].blocker = blocker;
+  ws->size += 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Removes the watch of the given clause from a watch list]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_watch_remove(CdclWatchList* ws, int cref)
+{
+  int i;
+
+  for (i = 0; i < ws->size; ++i) {
+    if (ws->data[i].cref == cref) {
+      for (; i < ws->size - 1; ++i) ws->data[i] = ws->data[i + 1];
+      ws->size -= 1;
+      return;
+    }
+  }
+  error_unreachable_code();
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Converts an external literal into an internal one]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_ext_to_lit(Cdcl_ptr self, int ext)
+{
+  int var = abs(ext) - 1;
+
+  nusmv_assert(var >= 0 && var < self->nvars);
+  return CDCL_LIT(var, ext < 0 ? 1 : 0);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Converts an internal literal into an external one]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_lit_to_ext(int lit)
+{
+  return CDCL_SIGN(lit) ? -(CDCL_VAR(lit) + 1) : (CDCL_VAR(lit) + 1);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns a random number in [0, 1), updating the seed]
+
+  Description [The same generator used by MiniSat]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static double cdcl_drand(double* seed)
+{
+  int q;
+
+  *seed *= 1389796;
+  q = (int) (*seed / 2147483647);
+  *seed -= (double) q * 2147483647;
+  return *seed / 2147483647;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Moves the heap element at pos up to its place]
+
+  Description [The heap is a max-heap over the variable activities]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_heap_up(Cdcl_ptr self, int pos)
+{
+  int var = self->heap[pos];
+
+  while (pos > 0) {
+    int parent = (pos - 1) >> 1;
+    if (self->activity[self->heap[parent]] >= self->activity[var]) break;
+    self->heap[pos] = self->heap[parent];
+    self->heap_index[self->heap[pos]] = pos;
+    pos = parent;
+  }
+  self->heap[pos] = var;
+  self->heap_index[var] = pos;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Moves the heap element at pos down to its place]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_heap_down(Cdcl_ptr self, int pos)
+{
+  int var = self->heap[pos];
+
+  for (;;) {
+    int child = 2 * pos + 1;
+    if (child >= self->heap_size) break;
+    if (child + 1 < self->heap_size &&
+        self->activity[self->heap[child + 1]] >
+        self->activity[self->heap[child]]) {
+      child += 1;
+    }
+    if (self->activity[self->heap[child]] <= self->activity[var]) break;
+    self->heap[pos] = self->heap[child];
+    self->heap_index[self->heap[pos]] = pos;
+    pos = child;
+  }
+  self->heap[pos] = var;
+  self->heap_index[var] = pos;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Inserts a variable into the heap, if not already there]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_heap_insert(Cdcl_ptr self, int var)
+{
+  if (self->heap_index[var] >= 0) return;
+
+  self->heap[self->heap_size] = var;
+  self->heap_index[var] = self->heap_size;
+  self->heap_size += 1;
+  cdcl_heap_up(self, self->heap_size - 1);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Removes and returns the most active variable]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_heap_pop(Cdcl_ptr self)
+{
+  int var = self->heap[0];
+
+  self->heap_size -= 1;
+  self->heap_index[var] = -1;
+  if (self->heap_size > 0) {
+    self->heap[0] = self->heap[self->heap_size];
+    self->heap_index[self->heap[0]] = 0;
+    cdcl_heap_down(self, 0);
+  }
+  return var;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Bumps the activity of a variable]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_bump_var(Cdcl_ptr self, int var)
+{
+  self->activity[var] += self->var_inc;
+
+  if (self->activity[var] > 1e100) {
+    int i;
+    for (i = 0; i < self->nvars; ++i) self->activity[i] *= 1e-100;
+    self->var_inc *= 1e-100;
+  }
+
+  if (self->heap_index[var] >= 0) cdcl_heap_up(self, self->heap_index[var]);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Stores a clause in the arena, returning its reference]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_alloc_clause(Cdcl_ptr self, const int* lits, int size,
+                             boolean learnt, int lbd, int proof)
+{
+  int cref = self->arena.size;
+  int i;
+
+  cdcl_vec_push(&self->arena, size);
+  cdcl_vec_push(&self->arena, (lbd << CDCL_LBD_SHIFT) |
+                (learnt ? CDCL_FLAG_LEARNT : 0));
+  cdcl_vec_push(&self->arena, proof);
+  for (i = 0; i < size; ++i) cdcl_vec_push(&self->arena, lits[i]);
+
+  return cref;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Watches the first two literals of a clause]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_attach(Cdcl_ptr self, int cref)
+{
+  int* c = CDCL_LITS(self, cref);
+
+  nusmv_assert(CDCL_SIZE(self, cref) >= 2);
+  cdcl_watch_push(&self->watches[c[0]], cref, c[1]);
+  cdcl_watch_push(&self->watches[c[1]], cref, c[0]);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Removes the watches of a clause]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_detach(Cdcl_ptr self, int cref)
+{
+  int* c = CDCL_LITS(self, cref);
+
+  cdcl_watch_remove(&self->watches[c[0]], cref);
+  cdcl_watch_remove(&self->watches[c[1]], cref);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Marks a clause as deleted]
+
+  Description [The watches of the clause are not removed: this is
+  done by cdcl_clean_watches.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_delete(Cdcl_ptr self, int cref)
+{
+  CDCL_FLAGS(self, cref) |= CDCL_FLAG_DELETED;
+  self->wasted += CDCL_HEADER_SIZE + CDCL_SIZE(self, cref);
+  self->removed += 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether a clause is the reason of an assignment]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean cdcl_locked(Cdcl_ptr self, int cref)
+{
+  int lit = CDCL_LITS(self, cref)[0];
+
+  return self->value[lit] == 1 && self->reason[CDCL_VAR(lit)] == cref;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Assigns a literal at the current decision level]
+
+  Description [When logging the proof, the units implied at level 0
+  get their proof from the reason.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_enqueue(Cdcl_ptr self, int lit, int reason)
+{
+  int var = CDCL_VAR(lit);
+
+  nusmv_assert(self->value[lit] == 0);
+  self->value[lit] = 1;
+  self->value[CDCL_NEG(lit)] = -1;
+  self->level[var] = CDCL_DECISION_LEVEL(self);
+  self->reason[var] = reason;
+  self->trail[self->trail_size++] = lit;
+
+  if (self->proof_logging && reason != CDCL_NO_CLAUSE &&
+      CDCL_DECISION_LEVEL(self) == 0) {
+    cdcl_proof_unit(self, var, reason);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Opens a new decision level]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_new_decision_level(Cdcl_ptr self)
+{
+  cdcl_vec_push(&self->trail_lim, self->trail_size);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Backtracks to the given decision level]
+
+  Description [The phases of the unassigned variables are saved]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_cancel_until(Cdcl_ptr self, int level)
+{
+  int i;
+
+  if (CDCL_DECISION_LEVEL(self) <= level) return;
+
+  for (i = self->trail_size - 1; i >= self->trail_lim.data[level]; --i) {
+    int lit = self->trail[i];
+    int var = CDCL_VAR(lit);
+
+    self->value[lit] = 0;
+    self->value[CDCL_NEG(lit)] = 0;
+    self->reason[var] = CDCL_NO_CLAUSE;
+    self->phase[var] = CDCL_SIGN(lit);
+    cdcl_heap_insert(self, var);
+  }
+
+  self->trail_size = self->trail_lim.data[level];
+  self->qhead = self->trail_size;
+  self->trail_lim.size = level;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Unit propagation]
+
+  Description [Returns the conflicting clause, or CDCL_NO_CLAUSE]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_propagate(Cdcl_ptr self)
+{
+  int confl = CDCL_NO_CLAUSE;
+
+  while (self->qhead < self->trail_size) {
+    int false_lit = CDCL_NEG(self->trail[self->qhead++]);
+    CdclWatchList* ws = &self->watches[false_lit];
+    CdclWatch* w = ws->data;
+    int n = ws->size;
+    int i = 0, j = 0;
+
+    self->propagations += 1;
+
+    while (i < n) {
+      int blocker = w[i].blocker;
+      int cref, first, size, k;
+      int* c;
+
+      if (self->value[blocker] == 1) {
+        w[j++] = w[i++];
+        continue;
+      }
+
+      cref = w[i].cref;
+      c = CDCL_LITS(self, cref);
+      if (c[0] == false_lit) {
+        c[0] = c[1];
+        c[1] = false_lit;
+      }
+      i += 1;
+
+      first = c[0];
+      if (first != blocker && self->value[first] == 1) {
+        w[j].cref = cref;
+        w[j].blocker = first;
+        j += 1;
+        continue;
+      }
+
+      /* looks for a new literal to watch */
+      size = CDCL_SIZE(self, cref);
+      for (k = 2; k < size; ++k) {
+        if (self->value[c[k]] != -1) {
+          c[1] = c[k];
+          c[k] = false_lit;
+          cdcl_watch_push(&self->watches[c[1]], cref, first);
+          break;
+        }
+      }
+      if (k < size) continue;
+
+      /* the clause is unit or conflicting */
+      w[j].cref = cref;
+      w[j].blocker = first;
+      j += 1;
+
+      if (self->value[first] == -1) {
+        confl = cref;
+        self->qhead = self->trail_size;
+        while (i < n) w[j++] = w[i++];
+      }
+      else cdcl_enqueue(self, first, cref);
+    }
+
+    ws->size = j;
+    if (confl != CDCL_NO_CLAUSE) break;
+  }
+
+  return confl;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Computes the number of distinct decision levels in a
+  clause]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_compute_lbd(Cdcl_ptr self, const int* lits, int size)
+{
+  int i, lbd = 0;
+
+  self->stamp += 1;
+  for (i = 0; i < size; ++i) {
+    int lev = self->level[CDCL_VAR(lits[i])];
+    if (self->level_stamp[lev] != self->stamp) {
+      self->level_stamp[lev] = self->stamp;
+      lbd += 1;
+    }
+  }
+  return lbd;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [First-UIP conflict analysis]
+
+  Description [Fills self->learnt with the learnt clause, whose first
+  literal is the asserting one and whose second literal (if any) has
+  the highest level among the others. When logging the proof, the
+  proof of the learnt clause is stored in out_proof: literals fixed at
+  level 0 are collected in self->stack, and resolved away with their
+  units at the end.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_analyze(Cdcl_ptr self, int confl,
+                         int* out_btlevel, int* out_lbd, int* out_proof)
+{
+  CdclVec* learnt = &self->learnt;
+  int path = 0;
+  int lit = -1;
+  int idx = self->trail_size - 1;
+  unsigned int abstract_levels = 0;
+  int i, j;
+
+  learnt->size = 0;
+  cdcl_vec_push(learnt, -1); /* room for the asserting literal */
+
+  if (self->proof_logging) {
+    cdcl_proof_begin(self, CDCL_PROOF(self, confl));
+    self->stack.size = 0;
+  }
+
+  do {
+    int* c = CDCL_LITS(self, confl);
+    int size = CDCL_SIZE(self, confl);
+    int k;
+
+    if (self->proof_logging && lit != -1) {
+      cdcl_proof_resolve(self, CDCL_VAR(lit), CDCL_PROOF(self, confl));
+    }
+
+    if (CDCL_IS_LEARNT(self, confl)) {
+      CDCL_FLAGS(self, confl) |= CDCL_FLAG_USED;
+      if (CDCL_LBD(self, confl) > CDCL_GLUE_LBD) {
+        int lbd = cdcl_compute_lbd(self, c, size);
+        if (lbd < CDCL_LBD(self, confl)) {
+          CDCL_FLAGS(self, confl) =
+            (CDCL_FLAGS(self, confl) & ((1 << CDCL_LBD_SHIFT) - 1)) |
+            (lbd << CDCL_LBD_SHIFT);
+        }
+      }
+    }
+
+    for (k = (lit == -1) ? 0 : 1; k < size; ++k) {
+      int q = c[k];
+      int var = CDCL_VAR(q);
+
+      if (self->seen[var]) continue;
+      if (self->level[var] > 0) {
+        cdcl_bump_var(self, var);
+        self->seen[var] = 1;
+        if (self->level[var] >= CDCL_DECISION_LEVEL(self)) path += 1;
+        else cdcl_vec_push(learnt, q);
+      }
+      else if (self->proof_logging) {
+        self->seen[var] = 1;
+        cdcl_vec_push(&self->stack, var);
+      }
+    }
+
+    /* next literal to look at */
+    while (!self->seen[CDCL_VAR(self->trail[idx])]) --idx;
+    lit = self->trail[idx];
+    idx -= 1;
+    confl = self->reason[CDCL_VAR(lit)];
+    self->seen[CDCL_VAR(lit)] = 0;
+    path -= 1;
+  } while (path > 0);
+
+  learnt->data[0] = CDCL_NEG(lit);
+
+  if (self->proof_logging) {
+    for (i = 0; i < self->stack.size; ++i) {
+      int var = self->stack.data[i];
+      cdcl_proof_resolve(self, var, self->unit_proof[var]);
+      self->seen[var] = 0;
+    }
+    *out_proof = cdcl_proof_end(self);
+  }
+  else *out_proof = CDCL_NO_PROOF;
+
+  /* recursive minimization, which is not a resolution chain and is
+     then skipped when logging the proof */
+  self->to_clear.size = 0;
+  for (i = 0; i < learnt->size; ++i) {
+    cdcl_vec_push(&self->to_clear, learnt->data[i]);
+  }
+  if (!self->proof_logging) {
+    for (i = 1; i < learnt->size; ++i) {
+      abstract_levels |= 1U << (self->level[CDCL_VAR(learnt->data[i])] & 31);
+    }
+    for (i = j = 1; i < learnt->size; ++i) {
+      int q = learnt->data[i];
+      if (self->reason[CDCL_VAR(q)] == CDCL_NO_CLAUSE ||
+          !cdcl_lit_redundant(self, q, abstract_levels)) {
+        learnt->data[j++] = q;
+      }
+    }
+    learnt->size = j;
+  }
+  for (i = 0; i < self->to_clear.size; ++i) {
+    self->seen[CDCL_VAR(self->to_clear.data[i])] = 0;
+  }
+
+  /* backtracking level */
+  if (learnt->size == 1) *out_btlevel = 0;
+  else {
+    int max = 1;
+    int tmp;
+
+    for (i = 2; i < learnt->size; ++i) {
+      if (self->level[CDCL_VAR(learnt->data[i])] >
+          self->level[CDCL_VAR(learnt->data[max])]) {
+        max = i;
+      }
+    }
+    tmp = learnt->data[max];
+    learnt->data[max] = learnt->data[1];
+    learnt->data[1] = tmp;
+    *out_btlevel = self->level[CDCL_VAR(tmp)];
+  }
+
+  *out_lbd = cdcl_compute_lbd(self, learnt->data, learnt->size);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether a literal of the learnt clause is implied
+  by the others]
+
+  Description [abstract_levels is an abstraction of the levels of the
+  learnt clause, used to abort early.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean cdcl_lit_redundant(Cdcl_ptr self, int lit,
+                                  unsigned int abstract_levels)
+{
+  int top = self->to_clear.size;
+
+  self->stack.size = 0;
+  cdcl_vec_push(&self->stack, lit);
+
+  while (self->stack.size > 0) {
+    int cref = self->reason[CDCL_VAR(self->stack.data[--self->stack.size])];
+    int* c = CDCL_LITS(self, cref);
+    int size = CDCL_SIZE(self, cref);
+    int k;
+
+    for (k = 1; k < size; ++k) {
+      int q = c[k];
+      int var = CDCL_VAR(q);
+
+      if (!self->seen[var] && self->level[var] > 0) {
+        if (self->reason[var] != CDCL_NO_CLAUSE &&
+            ((1U << (self->level[var] & 31)) & abstract_levels) != 0) {
+          self->seen[var] = 1;
+          cdcl_vec_push(&self->stack, q);
+          cdcl_vec_push(&self->to_clear, q);
+        }
+        else {
+          int i;
+          for (i = top; i < self->to_clear.size; ++i) {
+            self->seen[CDCL_VAR(self->to_clear.data[i])] = 0;
+          }
+          self->to_clear.size = top;
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Computes the set of assumptions responsible for the
+  given assumption to be false]
+
+  Description [lit is the failed assumption. The result is stored in
+  self->conflict.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_analyze_final(Cdcl_ptr self, int lit)
+{
+  int i;
+
+  self->conflict.size = 0;
+  cdcl_vec_push(&self->conflict, lit);
+
+  if (CDCL_DECISION_LEVEL(self) == 0) return;
+
+  self->seen[CDCL_VAR(lit)] = 1;
+  for (i = self->trail_size - 1; i >= self->trail_lim.data[0]; --i) {
+    int var = CDCL_VAR(self->trail[i]);
+
+    if (!self->seen[var]) continue;
+
+    if (self->reason[var] == CDCL_NO_CLAUSE) {
+      /* a decision, i.e. an assumption */
+      cdcl_vec_push(&self->conflict, self->trail[i]);
+    }
+    else {
+      int* c = CDCL_LITS(self, self->reason[var]);
+      int size = CDCL_SIZE(self, self->reason[var]);
+      int k;
+
+      for (k = 1; k < size; ++k) {
+        if (self->level[CDCL_VAR(c[k])] > 0) self->seen[CDCL_VAR(c[k])] = 1;
+      }
+    }
+    self->seen[var] = 0;
+  }
+  self->seen[CDCL_VAR(lit)] = 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Picks the next decision literal]
+
+  Description [Returns -1 if all variables are assigned]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_pick_branch(Cdcl_ptr self)
+{
+  int var = -1;
+  int i;
+
+  for (i = 0; i < self->preferred.size; ++i) {
+    int pv = self->preferred.data[i];
+    if (self->value[CDCL_LIT(pv, 0)] == 0) {
+      var = pv;
+      break;
+    }
+  }
+
+  while (var == -1) {
+    if (self->heap_size == 0) return -1;
+    var = cdcl_heap_pop(self);
+    if (self->value[CDCL_LIT(var, 0)] != 0) var = -1;
+  }
+
+  switch (self->polarity_mode) {
+  case cdcl_polarity_true: return CDCL_LIT(var, 0);
+  case cdcl_polarity_false: return CDCL_LIT(var, 1);
+  case cdcl_polarity_rnd:
+    return CDCL_LIT(var, cdcl_drand(&self->random_seed) < 0.5 ? 1 : 0);
+  default: return CDCL_LIT(var, self->phase[var]);
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Decides whether to restart]
+
+  Description [A restart is triggered when the recent learnt clauses
+  are of worse quality (higher LBD) than the average.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean cdcl_should_restart(Cdcl_ptr self)
+{
+  return self->conflicts_since_restart >= CDCL_RESTART_MIN &&
+    self->lbd_fast > CDCL_RESTART_MARGIN * self->lbd_slow;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Orders the reduction candidates, worst first]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_reduce_compare(const void* a, const void* b)
+{
+  const CdclReduceEntry* ea = (const CdclReduceEntry*) a;
+  const CdclReduceEntry* eb = (const CdclReduceEntry*) b;
+
+  if (ea->lbd != eb->lbd) return eb->lbd - ea->lbd;
+  if (ea->size != eb->size) return eb->size - ea->size;
+  return ea->cref - eb->cref;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Removes half of the learnt clauses]
+
+  Description [Glue clauses, reasons and clauses used since the last
+  reduction are kept.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_reduce_db(Cdcl_ptr self)
+{
+  CdclReduceEntry* cands = ALLOC(CdclReduceEntry, self->learnts.size + 1);
+  int ncands = 0;
+  int i, j;
+
+  self->reductions += 1;
+
+  for (i = 0; i < self->learnts.size; ++i) {
+    int cref = self->learnts.data[i];
+
+    if (CDCL_FLAGS(self, cref) & CDCL_FLAG_USED) {
+      CDCL_FLAGS(self, cref) &= ~CDCL_FLAG_USED;
+      continue;
+    }
+    if (CDCL_LBD(self, cref) <= CDCL_GLUE_LBD || cdcl_locked(self, cref)) {
+      continue;
+    }
+    cands[ncands].lbd = CDCL_LBD(self, cref);
+    cands[ncands].size = CDCL_SIZE(self, cref);
+    cands[ncands].cref = cref;
+    ncands += 1;
+  }
+
+  qsort(cands, ncands, sizeof(CdclReduceEntry), cdcl_reduce_compare);
+  for (i = 0; i < ncands / 2; ++i) cdcl_delete(self, cands[i].cref);
+  FREE(cands);
+
+  for (i = j = 0; i < self->learnts.size; ++i) {
+    int cref = self->learnts.data[i];
+    if (!CDCL_IS_DELETED(self, cref)) self->learnts.data[j++] = cref;
+  }
+  self->learnts.size = j;
+
+  cdcl_clean_watches(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Removes the watches of deleted clauses]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_clean_watches(Cdcl_ptr self)
+{
+  int l;
+
+  for (l = 0; l < 2 * self->nvars; ++l) {
+    CdclWatchList* ws = &self->watches[l];
+    int i, j;
+
+    for (i = j = 0; i < ws->size; ++i) {
+      if (!CDCL_IS_DELETED(self, ws->data[i].cref)) ws->data[j++] = ws->data[i];
+    }
+    ws->size = j;
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Deletes satisfied clauses and strips false literals]
+
+  Description [To be called at level 0 after propagation, when the
+  watched literals of non-satisfied clauses are unassigned.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_remove_satisfied(Cdcl_ptr self, CdclVec* crefs)
+{
+  int i, j;
+
+  for (i = j = 0; i < crefs->size; ++i) {
+    int cref = crefs->data[i];
+    int* c = CDCL_LITS(self, cref);
+    int size = CDCL_SIZE(self, cref);
+    boolean sat = false;
+    int k;
+
+    for (k = 0; k < size && !sat; ++k) sat = (self->value[c[k]] == 1);
+    if (sat) {
+      cdcl_delete(self, cref);
+      continue;
+    }
+
+    if (self->proof_logging) cdcl_proof_begin(self, CDCL_PROOF(self, cref));
+    for (k = 2; k < size; ) {
+      if (self->value[c[k]] == -1) {
+        if (self->proof_logging) {
+          cdcl_proof_resolve(self, CDCL_VAR(c[k]),
+                             self->unit_proof[CDCL_VAR(c[k])]);
+        }
+        c[k] = c[--size];
+        self->wasted += 1;
+      }
+      else ++k;
+    }
+    CDCL_SIZE(self, cref) = size;
+    if (self->proof_logging) CDCL_PROOF(self, cref) = cdcl_proof_end(self);
+    crefs->data[j++] = cref;
+  }
+  crefs->size = j;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Compacts the clause arena]
+
+  Description [To be called at level 0. Watches are rebuilt.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_garbage_collect(Cdcl_ptr self)
+{
+  CdclVec old = self->arena;
+  CdclVec* lists[2];
+  int l, n;
+
+  nusmv_assert(CDCL_DECISION_LEVEL(self) == 0);
+
+  self->arena.data = (int*) NULL;
+  self->arena.size = self->arena.cap = 0;
+  self->wasted = 0;
+
+  for (l = 0; l < 2 * self->nvars; ++l) self->watches[l].size = 0;
+
+  lists[0] = &self->clauses;
+  lists[1] = &self->learnts;
+  for (n = 0; n < 2; ++n) {
+    int i;
+    for (i = 0; i < lists[n]->size; ++i) {
+      int cref = lists[n]->data[i];
+      int ncref = cdcl_alloc_clause(self, old.data + cref + CDCL_HEADER_SIZE,
+                                    old.data[cref], false, 0,
+                                    old.data[cref + 2]);
+      CDCL_FLAGS(self, ncref) = old.data[cref + 1];
+      lists[n]->data[i] = ncref;
+      cdcl_attach(self, ncref);
+    }
+  }
+
+  cdcl_vec_free(&old);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Vivifies the learnt clauses with small LBD]
+
+  Description [For each clause, the negations of its literals are
+  propagated in turn: literals found false can be removed, and the
+  clause can be cut after the first conflict or true literal. To be
+  called at level 0. The effort is bounded by a fraction of the
+  propagations done in search.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_vivify(Cdcl_ptr self)
+{
+  long budget = (self->propagations - self->vivify_props) *
+    CDCL_VIVIFY_EFFORT / 100;
+  long limit;
+  int i, j;
+
+  if (budget < CDCL_VIVIFY_MIN_EFFORT) budget = CDCL_VIVIFY_MIN_EFFORT;
+  limit = self->propagations + budget;
+
+  for (i = 0; i < self->learnts.size && self->ok; ++i) {
+    int cref = self->learnts.data[i];
+    int size = CDCL_SIZE(self, cref);
+    int new_size = 0;
+    boolean satisfied = false;
+    int k;
+
+    if (self->propagations > limit) break;
+    if (CDCL_IS_DELETED(self, cref) || size <= 2 ||
+        CDCL_LBD(self, cref) > CDCL_VIVIFY_MAX_LBD) {
+      continue;
+    }
+
+    cdcl_detach(self, cref);
+
+    for (k = 0; k < size; ++k) {
+      int lit = CDCL_LITS(self, cref)[k];
+
+      if (self->value[lit] == 1) {
+        if (self->level[CDCL_VAR(lit)] == 0) satisfied = true;
+        else CDCL_LITS(self, cref)[new_size++] = lit;
+        break;
+      }
+      if (self->value[lit] == -1) continue; /* implied false: dropped */
+
+      CDCL_LITS(self, cref)[new_size++] = lit;
+      cdcl_new_decision_level(self);
+      cdcl_enqueue(self, CDCL_NEG(lit), CDCL_NO_CLAUSE);
+      if (cdcl_propagate(self) != CDCL_NO_CLAUSE) break;
+    }
+    cdcl_cancel_until(self, 0);
+
+    if (new_size == 0 && !satisfied) {
+      /* all the literals are false at level 0 */
+      self->ok = false;
+      break;
+    }
+
+    if (satisfied || new_size == 1) {
+      /* the clause has to be removed, possibly leaving a unit */
+      CDCL_SIZE(self, cref) = size;
+      cdcl_delete(self, cref);
+      if (!satisfied) {
+        int unit = CDCL_LITS(self, cref)[0];
+        if (self->value[unit] == 0) {
+          cdcl_enqueue(self, unit, CDCL_NO_CLAUSE);
+          if (cdcl_propagate(self) != CDCL_NO_CLAUSE) self->ok = false;
+        }
+        else if (self->value[unit] == -1) self->ok = false;
+      }
+      self->vivified += size - new_size;
+      continue;
+    }
+
+    if (new_size < size) {
+      self->vivified += size - new_size;
+      self->wasted += size - new_size;
+      CDCL_SIZE(self, cref) = new_size;
+      if (CDCL_LBD(self, cref) >= new_size) {
+        CDCL_FLAGS(self, cref) =
+          (CDCL_FLAGS(self, cref) & ((1 << CDCL_LBD_SHIFT) - 1)) |
+          ((new_size - 1) << CDCL_LBD_SHIFT);
+      }
+    }
+    cdcl_attach(self, cref);
+  }
+
+  for (i = j = 0; i < self->learnts.size; ++i) {
+    int cref = self->learnts.data[i];
+    if (!CDCL_IS_DELETED(self, cref)) self->learnts.data[j++] = cref;
+  }
+  self->learnts.size = j;
+
+  self->vivify_props = self->propagations;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [The CDCL search loop]
+
+  Description [Returns 1 if a model has been found, 0 if the problem is
+  unsatisfiable under the current assumptions.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_search(Cdcl_ptr self)
+{
+  for (;;) {
+    int confl = cdcl_propagate(self);
+
+    if (confl != CDCL_NO_CLAUSE) {
+      int btlevel, lbd, proof;
+
+      self->conflicts += 1;
+      self->conflicts_since_restart += 1;
+
+      if (CDCL_DECISION_LEVEL(self) == 0) {
+        cdcl_proof_empty(self, confl);
+        self->ok = false;
+        return 0;
+      }
+
+      cdcl_analyze(self, confl, &btlevel, &lbd, &proof);
+
+      if (self->conflicts == 1) self->lbd_fast = self->lbd_slow = lbd;
+      self->lbd_fast += CDCL_EMA_FAST * (lbd - self->lbd_fast);
+      self->lbd_slow += CDCL_EMA_SLOW * (lbd - self->lbd_slow);
+
+      cdcl_cancel_until(self, btlevel);
+      if (self->learnt.size == 1) {
+        cdcl_enqueue(self, self->learnt.data[0], CDCL_NO_CLAUSE);
+        self->unit_proof[CDCL_VAR(self->learnt.data[0])] = proof;
+      }
+      else {
+        int cref = cdcl_alloc_clause(self, self->learnt.data,
+                                     self->learnt.size, true, lbd, proof);
+        cdcl_vec_push(&self->learnts, cref);
+        cdcl_attach(self, cref);
+        cdcl_enqueue(self, self->learnt.data[0], cref);
+      }
+
+      self->var_inc /= CDCL_VAR_DECAY;
+    }
+    else {
+      int next = -1;
+
+      if (cdcl_should_restart(self)) {
+        /* the assumption levels are kept */
+        int level = self->assumptions.size;
+        if (level > CDCL_DECISION_LEVEL(self)) level = CDCL_DECISION_LEVEL(self);
+        self->restarts += 1;
+        self->conflicts_since_restart = 0;
+        cdcl_cancel_until(self, level);
+        continue;
+      }
+
+      if (self->conflicts >= self->next_reduce) {
+        cdcl_reduce_db(self);
+        self->next_reduce = self->conflicts + CDCL_REDUCE_FIRST +
+          CDCL_REDUCE_INC * self->reductions;
+      }
+
+      while (CDCL_DECISION_LEVEL(self) < self->assumptions.size) {
+        int lit = self->assumptions.data[CDCL_DECISION_LEVEL(self)];
+
+        if (self->value[lit] == 1) {
+          /* already satisfied: a dummy level is opened */
+          cdcl_new_decision_level(self);
+        }
+        else if (self->value[lit] == -1) {
+          cdcl_analyze_final(self, lit);
+          return 0;
+        }
+        else {
+          next = lit;
+          break;
+        }
+      }
+
+      if (next == -1) {
+        self->decisions += 1;
+        next = cdcl_pick_branch(self);
+
+        if (next == -1) {
+          /* all variables are assigned: a model is found */
+          int var;
+
+          self->model = REALLOC(signed char, self->model, self->nvars);
+          for (var = 0; var < self->nvars; ++var) {
+            self->model[var] = self->value[CDCL_LIT(var, 0)];
+          }
+          self->model_size = self->nvars;
+          return 1;
+        }
+      }
+
+      cdcl_new_decision_level(self);
+      cdcl_enqueue(self, next, CDCL_NO_CLAUSE);
+    }
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Appends an original clause to the proof]
+
+  Description [Returns the id of the record. The clause belongs to the
+  current interpolation group.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_proof_original(Cdcl_ptr self, const int* lits, int size)
+{
+  int id = self->proof.size;
+  int i;
+
+  cdcl_vec_push(&self->proof, CDCL_PROOF_ORIGINAL);
+  cdcl_vec_push(&self->proof, self->proof_group);
+  cdcl_vec_push(&self->proof, size);
+  for (i = 0; i < size; ++i) cdcl_vec_push(&self->proof, lits[i]);
+
+  return id;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Starts a resolution chain from the given record]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [cdcl_proof_resolve, cdcl_proof_end]
+
+******************************************************************************/
+static void cdcl_proof_begin(Cdcl_ptr self, int id)
+{
+  nusmv_assert(id != CDCL_NO_PROOF);
+
+  self->chain.size = 0;
+  cdcl_vec_push(&self->chain, id);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Resolves the current chain with the given record on var]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [cdcl_proof_begin, cdcl_proof_end]
+
+******************************************************************************/
+static void cdcl_proof_resolve(Cdcl_ptr self, int var, int id)
+{
+  nusmv_assert(id != CDCL_NO_PROOF);
+
+  cdcl_vec_push(&self->chain, var);
+  cdcl_vec_push(&self->chain, id);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Closes the current chain, returning its id]
+
+  Description [A chain without resolutions is the record it starts
+  from, no new record is appended.]
+
+  SideEffects []
+
+  SeeAlso     [cdcl_proof_begin, cdcl_proof_resolve]
+
+******************************************************************************/
+static int cdcl_proof_end(Cdcl_ptr self)
+{
+  int id;
+  int i;
+
+  if (self->chain.size == 1) return self->chain.data[0];
+
+  id = self->proof.size;
+  cdcl_vec_push(&self->proof, CDCL_PROOF_DERIVED);
+  cdcl_vec_push(&self->proof, (self->chain.size - 1) / 2);
+  for (i = 0; i < self->chain.size; ++i) {
+    cdcl_vec_push(&self->proof, self->chain.data[i]);
+  }
+
+  return id;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Records the proof of a unit implied at level 0]
+
+  Description [cref is the reason of var, whose other literals are all
+  false at level 0.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_proof_unit(Cdcl_ptr self, int var, int cref)
+{
+  int* c = CDCL_LITS(self, cref);
+  int size = CDCL_SIZE(self, cref);
+  int k;
+
+  cdcl_proof_begin(self, CDCL_PROOF(self, cref));
+  for (k = 0; k < size; ++k) {
+    int v = CDCL_VAR(c[k]);
+    if (v != var) cdcl_proof_resolve(self, v, self->unit_proof[v]);
+  }
+  self->unit_proof[var] = cdcl_proof_end(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Records the proof of the empty clause]
+
+  Description [cref is a clause conflicting at level 0. Nothing is done
+  if the proof is not being logged.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void cdcl_proof_empty(Cdcl_ptr self, int cref)
+{
+  int* c;
+  int size;
+  int k;
+
+  if (!self->proof_logging) return;
+
+  c = CDCL_LITS(self, cref);
+  size = CDCL_SIZE(self, cref);
+  cdcl_proof_begin(self, CDCL_PROOF(self, cref));
+  for (k = 0; k < size; ++k) {
+    cdcl_proof_resolve(self, CDCL_VAR(c[k]), self->unit_proof[CDCL_VAR(c[k])]);
+  }
+  self->empty_proof = cdcl_proof_end(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of integers taken by a proof record]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_proof_record_size(Cdcl_ptr self, int id)
+{
+  const int* r = self->proof.data + id;
+
+  if ((r[0] & ~CDCL_PROOF_MARK) == CDCL_PROOF_ORIGINAL) return 3 + r[2];
+  return 3 + 2 * r[1];
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks whether an interpolation group is among the given
+  ones]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean cdcl_proof_in_groups(int group, int num_groups,
+                                    const SatSolverItpGroup* groups)
+{
+  int i;
+
+  for (i = 0; i < num_groups; ++i) {
+    if (groups[i] == group) return true;
+  }
+  return false;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the position of id in the sorted vector ids]
+
+  Description [id must be in the vector]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_proof_index(const CdclVec* ids, int id)
+{
+  int lo = 0, hi = ids->size - 1;
+
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (ids->data[mid] < id) lo = mid + 1;
+    else hi = mid;
+  }
+  nusmv_assert(ids->data[lo] == id);
+  return lo;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Orders integers increasingly]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static int cdcl_int_compare(const void* a, const void* b)
+{
+  int ia = *(const int*) a;
+  int ib = *(const int*) b;
+
+  return (ia > ib) - (ia < ib);
+}
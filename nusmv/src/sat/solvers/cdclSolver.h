@@ -0,0 +1,109 @@
+/**CHeaderFile*****************************************************************
+
+  FileName    [cdclSolver.h]
+
+  PackageName [sat.solvers]
+
+  Synopsis    [The interface of the in-tree CDCL SAT engine]
+
+  Description [A self-contained conflict-driven clause-learning SAT
+  solver, used by the SatCdcl class. The interface follows the C
+  interface of the patched MiniSat shipped with NuSMV: variables are
+  positive integers starting from 1, and literals are non-zero
+  integers whose sign gives the polarity.
+
+  The engine is meant to be used incrementally: clauses can be added
+  between calls to Cdcl_Solve_Assume, and learnt clauses are kept
+  across calls. Search is performed under a set of assumption
+  literals, and when the problem is unsatisfiable under them the
+  subset of assumptions responsible for the conflict can be
+  retrieved.]
+
+  SeeAlso     [cdclSolver.c SatCdcl.h]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``sat'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#ifndef __SAT_SOLVERS_CDCL_SOLVER__H
+#define __SAT_SOLVERS_CDCL_SOLVER__H
+
+#include "utils/utils.h"
+#include "sat/SatSolver.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* The polarity modes, same values of the MiniSat ones */
+enum { cdcl_polarity_true = 0, cdcl_polarity_false = 1,
+       cdcl_polarity_user = 2, cdcl_polarity_rnd = 3 };
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+typedef struct Cdcl_TAG* Cdcl_ptr;
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+EXTERN Cdcl_ptr Cdcl_Create ARGS((boolean enable_proof_logging));
+EXTERN void Cdcl_Delete ARGS((Cdcl_ptr self));
+
+EXTERN int Cdcl_Nof_Variables ARGS((Cdcl_ptr self));
+EXTERN int Cdcl_Nof_Clauses ARGS((Cdcl_ptr self));
+EXTERN int Cdcl_New_Variable ARGS((Cdcl_ptr self));
+
+EXTERN int Cdcl_Add_Clause ARGS((Cdcl_ptr self, int* lits, int num_lits));
+EXTERN int Cdcl_Solve_Assume ARGS((Cdcl_ptr self,
+                                   int num_assumed, const int* assumed));
+EXTERN int Cdcl_Simplify ARGS((Cdcl_ptr self));
+
+EXTERN int Cdcl_Get_Value ARGS((Cdcl_ptr self, int var));
+EXTERN int Cdcl_Get_Nof_Conflict_Lits ARGS((Cdcl_ptr self));
+EXTERN void Cdcl_Get_Conflict_Lits ARGS((Cdcl_ptr self, int* lits));
+EXTERN int Cdcl_Get_Nof_Fixed_Lits ARGS((Cdcl_ptr self));
+EXTERN void Cdcl_Get_Fixed_Lits ARGS((Cdcl_ptr self, int* lits));
+
+EXTERN void Cdcl_Set_Preferred_Variable ARGS((Cdcl_ptr self, int var));
+EXTERN void Cdcl_Clear_Preferred_Variables ARGS((Cdcl_ptr self));
+
+EXTERN void Cdcl_Set_Polarity_Mode ARGS((Cdcl_ptr self, int mode));
+EXTERN int Cdcl_Get_Polarity_Mode ARGS((Cdcl_ptr self));
+EXTERN void Cdcl_Set_Random_Seed ARGS((Cdcl_ptr self, double seed));
+
+EXTERN void Cdcl_Set_Proof_Group ARGS((Cdcl_ptr self, int group));
+EXTERN Term
+Cdcl_Interpolate ARGS((Cdcl_ptr self, int num_groups,
+                       const SatSolverItpGroup* groups,
+                       TermFactoryCallbacks_ptr callbacks,
+                       TermFactoryCallbacksUserData_ptr user_data));
+
+EXTERN void Cdcl_Print_Stats ARGS((Cdcl_ptr self, FILE* file));
+
+#endif /* __SAT_SOLVERS_CDCL_SOLVER__H */
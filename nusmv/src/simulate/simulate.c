@@ -111,6 +111,11 @@ static void simulate_choose_next ARGS((BddFsm_ptr fsm,
                                        bdd_ptr* which_input,
                                        bdd_ptr* which_state));
 
+static boolean simulate_step ARGS((BddFsm_ptr fsm, bdd_ptr constraint,
+                                   boolean time_shift, Simulation_Mode mode,
+                                   int display_all, bdd_ptr current_state,
+                                   int i, bdd_ptr* input, bdd_ptr* state));
+
 #if NUSMV_HAVE_SIGNAL_H
 static void simulate_sigterm ARGS((int));
 #endif
@@ -137,73 +142,21 @@ node_ptr Simulate_MultipleSteps(BddFsm_ptr fsm, bdd_ptr constraint,
 {
   BddEnc_ptr enc = BddFsm_get_bdd_encoding(fsm);
   DdManager* dd = BddEnc_get_dd_manager(enc);
-  bdd_ptr next_constraint;
   bdd_ptr current_state;
   bdd_ptr input;
   bdd_ptr state;
-  bdd_ptr mask;
   node_ptr result = Nil;
   int i = 1;
 
   current_state = current_state_bdd_get();
   /* we append the current state in first position of the trace */
   result = cons((node_ptr) current_state, result);
-  mask = BddEnc_get_state_frozen_vars_mask_bdd(Enc_get_bdd_encoding());
   while (i <= n) {
-    bdd_ptr next_constr_set = (bdd_ptr)NULL;
-
-    if (opt_verbose_level_gt(OptsHandler_get_instance(), 1)) {
-      switch (mode) {
-      case Interactive:
-        fprintf(nusmv_stderr,
-                "********  Interactive mode Simulation step %d  *********\n",i);
-        break;
-      case Random:
-        fprintf(nusmv_stderr,
-                "**********  Random mode Simulation step %d  **********\n",i);
-        break;
-      case Deterministic:
-        fprintf(nusmv_stderr,
-                "*******  Deterministic mode Simulation step %d  *******\n",i);
-        break;
-      }
-    }
-
-    /* if time shifting is enabled, perform current -> next time shift
-       on state vars, leave constraint as it is otherwise */
-    if (time_shift) {
-      next_constraint = BddEnc_state_var_to_next_state_var(enc, constraint);
-    }
-    else {
-      next_constraint = bdd_dup(constraint);
-    }
-    next_constr_set = BddFsm_get_constrained_forward_image(fsm, current_state, next_constraint);
-    bdd_free(dd, next_constraint);
-
-    bdd_and_accumulate(dd, &next_constr_set, mask);
-
-    if (bdd_is_false(dd, next_constr_set)) {
-      fprintf(nusmv_stderr, "No future state exists");
-      fprintf(nusmv_stderr, (llength(result) == 1 ? ": trace not built.\n" : "."));
-      fprintf(nusmv_stderr, "Simulation stopped at step %d.\n", i);
-      bdd_free(dd, next_constr_set);
+    if (!simulate_step(fsm, constraint, time_shift, mode, display_all,
+                       current_state, i, &input, &state)) {
       result = reverse(result);
       /* We don't free the current_state variable because the
          list "result" must contain referenced states */
-      return(result);
-    }
-
-    Simulate_ChooseOneStateInput(fsm,
-                                 current_state, next_constr_set,
-                                 mode, display_all,
-                                 &input, &state);
-
-    if (state == (bdd_ptr) NULL || bdd_is_false(dd, state)) {
-      fprintf(nusmv_stderr,
-        "\nCan't find a future state. Simulation stopped at step %d.\n", i);
-      if (state != (bdd_ptr) NULL) { bdd_free(dd, state); }
-      bdd_free(dd, next_constr_set);
-      result = reverse(result);
       return result;
     }
 
@@ -221,7 +174,6 @@ node_ptr Simulate_MultipleSteps(BddFsm_ptr fsm, bdd_ptr constraint,
        must contain referenced states: they will be freed after their insertion
        in the traces_hash table */
     i++;
-    bdd_free(dd, next_constr_set);
     current_state = state;
   }
 
@@ -229,6 +181,87 @@ node_ptr Simulate_MultipleSteps(BddFsm_ptr fsm, bdd_ptr constraint,
   return result;
 }
 
+
+/**Function********************************************************************
+
+  Synopsis           [Multiple step simulation written to a XML file]
+
+  Description        [Performs the same simulation of
+  Simulate_MultipleSteps, but instead of returning the list of the
+  states each step is written to the given XML dumper as soon as it is
+  chosen, and then forgotten. The current state is written as the first
+  step. The memory used does not depend on the number of steps.
+
+  The output stream, as well as the other dump options, are taken from
+  opt. The number of performed steps is returned, and the last state
+  reached (referenced) is stored in last_state.]
+
+  SideEffects        []
+
+  SeeAlso            [Simulate_MultipleSteps, TraceXmlDumper_stream_begin]
+
+******************************************************************************/
+int Simulate_MultipleStepsToXml(BddFsm_ptr fsm, bdd_ptr constraint,
+                                boolean time_shift, Simulation_Mode mode,
+                                int n, int display_all,
+                                NodeList_ptr symbols,
+                                TraceXmlDumper_ptr dumper, TraceOpt_ptr opt,
+                                bdd_ptr* last_state)
+{
+  BddEnc_ptr enc = BddFsm_get_bdd_encoding(fsm);
+  SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(enc));
+  DdManager* dd = BddEnc_get_dd_manager(enc);
+  bdd_ptr current_state;
+  Trace_ptr window;
+  node_ptr path;
+  int i = 1;
+
+  current_state = current_state_bdd_get();
+
+  /* the current state is the first step. Window traces share the
+     symbol table of the encoding, they live only for one step */
+  window = Trace_create(st, "Simulation Trace", TRACE_TYPE_SIMULATION,
+                        symbols, true);
+  path = cons((node_ptr) current_state, Nil);
+  Mc_fill_trace_from_bdd_state_input_list(enc, window, path);
+  free_list(path);
+
+  TraceXmlDumper_stream_begin(dumper, window, opt);
+  TraceXmlDumper_stream_step(dumper, window, Trace_first_iter(window));
+  Trace_destroy(window);
+
+  while (i <= n) {
+    bdd_ptr input;
+    bdd_ptr state;
+
+    if (!simulate_step(fsm, constraint, time_shift, mode, display_all,
+                       current_state, i, &input, &state)) break;
+
+    if (input == (bdd_ptr) NULL) input = bdd_true(dd); /* there are no inputs */
+
+    window = Trace_create(st, "Simulation Trace", TRACE_TYPE_SIMULATION,
+                          symbols, true);
+    path = cons((node_ptr) current_state,
+                cons((node_ptr) input, cons((node_ptr) state, Nil)));
+    Mc_fill_trace_from_bdd_state_input_list(enc, window, path);
+    free_list(path);
+
+    TraceXmlDumper_stream_step(dumper, window, Trace_last_iter(window));
+    Trace_destroy(window);
+
+    bdd_free(dd, input);
+    bdd_free(dd, current_state);
+    current_state = state;
+    i++;
+  }
+
+  TraceXmlDumper_stream_end(dumper);
+
+  *last_state = current_state;
+  return i - 1;
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Chooses one state among future states]
@@ -527,6 +560,91 @@ list_contains_next_var(const SymbTable_ptr st, const NodeList_ptr vars)
   return res;
 }
 
+/**Function********************************************************************
+
+  Synopsis           [Performs the i-th step of a simulation]
+
+  Description        [Chooses the next state (and input) from the given
+  current state according to the picking policy. Returns false, after
+  reporting the reason to the user, if no next state can be chosen.
+  Otherwise the chosen input (possibly NULL if there are no inputs) and
+  state are returned referenced.]
+
+  SideEffects        []
+
+  SeeAlso            [Simulate_MultipleSteps]
+
+******************************************************************************/
+static boolean simulate_step(BddFsm_ptr fsm, bdd_ptr constraint,
+                             boolean time_shift, Simulation_Mode mode,
+                             int display_all, bdd_ptr current_state,
+                             int i, bdd_ptr* input, bdd_ptr* state)
+{
+  BddEnc_ptr enc = BddFsm_get_bdd_encoding(fsm);
+  DdManager* dd = BddEnc_get_dd_manager(enc);
+  bdd_ptr next_constraint;
+  bdd_ptr next_constr_set;
+  bdd_ptr mask;
+
+  mask = BddEnc_get_state_frozen_vars_mask_bdd(Enc_get_bdd_encoding());
+
+  if (opt_verbose_level_gt(OptsHandler_get_instance(), 1)) {
+    switch (mode) {
+    case Interactive:
+      fprintf(nusmv_stderr,
+              "********  Interactive mode Simulation step %d  *********\n",i);
+      break;
+    case Random:
+      fprintf(nusmv_stderr,
+              "**********  Random mode Simulation step %d  **********\n",i);
+      break;
+    case Deterministic:
+      fprintf(nusmv_stderr,
+              "*******  Deterministic mode Simulation step %d  *******\n",i);
+      break;
+    }
+  }
+
+  /* if time shifting is enabled, perform current -> next time shift
+     on state vars, leave constraint as it is otherwise */
+  if (time_shift) {
+    next_constraint = BddEnc_state_var_to_next_state_var(enc, constraint);
+  }
+  else {
+    next_constraint = bdd_dup(constraint);
+  }
+  next_constr_set = BddFsm_get_constrained_forward_image(fsm, current_state,
+                                                         next_constraint);
+  bdd_free(dd, next_constraint);
+
+  bdd_and_accumulate(dd, &next_constr_set, mask);
+
+  if (bdd_is_false(dd, next_constr_set)) {
+    fprintf(nusmv_stderr, "No future state exists");
+    fprintf(nusmv_stderr, (i == 1 ? ": trace not built.\n" : "."));
+    fprintf(nusmv_stderr, "Simulation stopped at step %d.\n", i);
+    bdd_free(dd, next_constr_set);
+    return false;
+  }
+
+  Simulate_ChooseOneStateInput(fsm,
+                               current_state, next_constr_set,
+                               mode, display_all,
+                               input, state);
+  bdd_free(dd, next_constr_set);
+
+  if (*state == (bdd_ptr) NULL || bdd_is_false(dd, *state)) {
+    fprintf(nusmv_stderr,
+            "\nCan't find a future state. Simulation stopped at step %d.\n", i);
+    if (*state != (bdd_ptr) NULL) { bdd_free(dd, *state); }
+    if (*input != (bdd_ptr) NULL) { bdd_free(dd, *input); }
+    return false;
+  }
+
+  return true;
+}
+
+
 /**Function********************************************************************
 
   Synopsis           []
@@ -49,6 +49,8 @@
 #include "dd/dd.h"
 #include "fsm/bdd/BddFsm.h"
 #include "node/node.h"
+#include "trace/TraceOpt.h"
+#include "trace/plugins/TraceXmlDumper.h"
 
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
@@ -75,6 +77,12 @@ EXTERN node_ptr
 Simulate_MultipleSteps ARGS((BddFsm_ptr, bdd_ptr, boolean,
                              Simulation_Mode, int, int));
 
+EXTERN int
+Simulate_MultipleStepsToXml ARGS((BddFsm_ptr, bdd_ptr, boolean,
+                                  Simulation_Mode, int, int, NodeList_ptr,
+                                  TraceXmlDumper_ptr, TraceOpt_ptr,
+                                  bdd_ptr*));
+
 EXTERN void store_and_print_trace ARGS((node_ptr, boolean, int));
 
 #endif /* __SIMULATE_H__ */
@@ -53,6 +53,8 @@
 #include "trace/pkg_trace.h"
 #include "cmd/cmd.h"
 #include "utils/ucmd.h"
+#include "bmc/bmcCmd.h" /* for Bmc_check_if_model_was_built */
+#include "bmc/bmcBitSim.h"
 
 static char rcsid[] UTIL_UNUSED = "$Id: simulateCmd.c,v 1.14.2.26.4.8.4.15 2010-02-23 07:06:22 nusmv Exp $";
 
@@ -111,6 +113,11 @@ simulate_extend_print_curr_trace ARGS((BddEnc_ptr enc, node_ptr fragment,
                                        boolean only_changes,
                                        NodeList_ptr symbols));
 
+static int simulate_to_xml_file ARGS((BddFsm_ptr fsm, bdd_ptr constraints,
+                                      boolean time_shift,
+                                      Simulation_Mode mode, int steps,
+                                      int display_all, NodeList_ptr symbols,
+                                      const char* xml_file));
 static void current_state_label_reset ARGS((void));
 static void current_state_bdd_free ARGS((void));
 
@@ -383,6 +390,7 @@ static int UsagePickState () {
 
   CommandArguments   [\[-h\] \[-p | -v\] \[-r | -i \[-a\]\]
   [\[-c "constraints"\] | \[-t "constraints"\] ] \[-k steps\]
+  \[-e engine \[-n passes\]\] \[-o filename\]
   ]
 
   CommandDescription [
@@ -452,6 +460,30 @@ static int UsagePickState () {
        this is the case in which simulation stops in an intermediate
        step because it may not exist any future state satisfying those
        constraints.
+    <dt> <tt>-e engine</tt>
+       <dd> Selects the simulation engine: <tt>bdd</tt> (the default)
+       or <tt>bitsim</tt>. The <tt>bitsim</tt> engine does not use the
+       current state: it compiles the boolean encoding of the model
+       (the model must have been set up for BMC) and simulates many
+       random runs of at most <tt>steps</tt> steps from random initial
+       states at the same time. The unchecked invariants
+       (<tt>INVARSPEC</tt>) are checked on all the reached states, and
+       the violated ones are reported false together with a
+       counterexample. The runs are not stored as traces, and the
+       options -p, -v, -i, -a, -c and -t cannot be used.
+    <dt> <tt>-n passes</tt>
+       <dd> Number of passes of the <tt>bitsim</tt> engine, each of them
+       simulating a new set of random runs (default is 1).
+    <dt> <tt>-o filename</tt>
+       <dd> Writes the simulated steps, starting from the current state,
+       to <tt>filename</tt> in XML format as soon as they are chosen,
+       instead of storing them into a trace. The memory used does not
+       depend on the number of steps, so this is meant for very long
+       simulations. The last simulated state becomes the current state,
+       and it is stored as the first state of a new trace. The written
+       file can be read or executed one step at a time with
+       <tt>read_trace -c</tt> or <tt>read_trace -x</tt>. This option
+       cannot be used with -p and -v.
     </dl> ]
 
 ******************************************************************************/
@@ -469,14 +501,37 @@ int CommandSimulate(int argc, char **argv)
   int steps = get_default_simulation_steps(OptsHandler_get_instance());
   Simulation_Mode mode = Deterministic;
   boolean k_specified = false;
+  boolean bitsim = false;
+  int passes = -1;
 
   /* the string of constraint to parsificate */
   char* strConstr = NIL(char);
+  char* xml_file = NIL(char);
 
   util_getopt_reset();
-  while((c = util_getopt(argc,argv,"t:c:hpvriak:")) != EOF){
+  while((c = util_getopt(argc,argv,"t:c:hpvriak:e:n:o:")) != EOF){
     switch(c){
     case 'h': return UsageSimulate();
+    case 'o':
+      if (NIL(char) != xml_file) return UsageSimulate();
+      xml_file = util_optarg;
+      break;
+    case 'e':
+      if (strcmp(util_optarg, "bitsim") == 0) bitsim = true;
+      else if (strcmp(util_optarg, "bdd") == 0) bitsim = false;
+      else {
+        fprintf(nusmv_stderr, "Unknown simulation engine \"%s\".\n",
+                util_optarg);
+        return 1;
+      }
+      break;
+    case 'n':
+      if (passes >= 0) return UsageSimulate();
+      if (util_str2int(util_optarg, &passes) != 0 || passes < 0) {
+        error_invalid_number(util_optarg);
+        return 1;
+      }
+      break;
     case 'p':
       if (printrace == true) return UsageSimulate();
       printrace = true;
@@ -579,6 +634,20 @@ int CommandSimulate(int argc, char **argv)
     return UsageSimulate();
   }
 
+  if (NIL(char) != xml_file && printrace) return UsageSimulate();
+
+  if (bitsim) {
+    if (printrace || mode == Interactive || display_all ||
+        isconstraint || NIL(char) != xml_file) return UsageSimulate();
+
+    if (Bmc_check_if_model_was_built(nusmv_stderr, true)) return 1;
+
+    return Bmc_BitSimulate(
+               PropDb_master_get_be_fsm(PropPkg_get_prop_database()),
+               steps, (passes >= 0) ? passes : 1);
+  }
+  else if (passes >= 0) return UsageSimulate();
+
   /* pre-conditions */
   if (Compile_check_if_model_was_built(nusmv_stderr, true)) return 1;
 
@@ -619,6 +688,15 @@ int CommandSimulate(int argc, char **argv)
              TraceLabel_get_trace(curr_lbl) + 1,
              TraceLabel_get_state(curr_lbl) + 1);
 
+    if (NIL(char) != xml_file) {
+      int res = simulate_to_xml_file(fsm, bdd_constraints, time_shift, mode,
+                                     steps, display_all,
+                                     SexpFsm_get_symbols_list(sexp_fsm),
+                                     xml_file);
+      bdd_free(dd, bdd_constraints);
+      return res;
+    }
+
     /* Important: the simulation ALWAYS starts from the current selected state */
     current_trace = Simulate_MultipleSteps(fsm, bdd_constraints, time_shift,
                                            mode, steps, display_all);
@@ -664,7 +742,8 @@ int CommandSimulate(int argc, char **argv)
 static int UsageSimulate(){
   fprintf(nusmv_stderr,
           "usage: simulate [-h] [-p | -v] [-r | -i [-a]] [[-c \"constr\"] "
-          "| [-t \"constr\"]] [-k steps]\n");
+          "| [-t \"constr\"]] [-k steps]\n"
+          "                [-e engine [-n passes]] [-o file]\n");
   fprintf(nusmv_stderr, "  -h \t\tPrints the command usage.\n");
   fprintf(nusmv_stderr, "  -p \t\tPrints current generated trace (only changed variables).\n");
   fprintf(nusmv_stderr, "  -v \t\tVerbosely prints current generated trace (all variables).\n");
@@ -677,6 +756,12 @@ static int UsageSimulate(){
   fprintf(nusmv_stderr, "  -t \"constr\"\tSets constraint (next expression) for the next steps.\n");
   fprintf(nusmv_stderr, "  -k <length> \tSpecifies the simulation length\n"
           "\t\tto be used when generating the simulated problem.\n");
+  fprintf(nusmv_stderr, "  -e <engine> \tSpecifies the simulation engine: "
+          "bdd (default) or bitsim.\n");
+  fprintf(nusmv_stderr, "  -n <passes> \tSpecifies the number of passes "
+          "of the bitsim engine.\n");
+  fprintf(nusmv_stderr, "  -o <file> \tWrites the simulated steps to the "
+          "given XML file,\n\t\tinstead of storing them in a trace.\n");
   return 1;
 }
 
@@ -1037,3 +1122,73 @@ static void simulate_extend_print_curr_trace(BddEnc_ptr enc,
 
   return ;
 }
+
+
+/**Function********************************************************************
+
+  Synopsis     [Performs a simulation writing the steps to a XML file]
+
+  Description  [The simulation starts from the current state. The last
+                simulated state becomes the current state, and it is
+                stored as the first state of a new simulation trace.
+                Returns 0 on success, 1 if the file cannot be opened.]
+
+  SideEffects  [A new trace is registered]
+
+  SeeAlso      [Simulate_MultipleStepsToXml]
+
+******************************************************************************/
+static int simulate_to_xml_file(BddFsm_ptr fsm, bdd_ptr constraints,
+                                boolean time_shift, Simulation_Mode mode,
+                                int steps, int display_all,
+                                NodeList_ptr symbols, const char* xml_file)
+{
+  BddEnc_ptr enc = BddFsm_get_bdd_encoding(fsm);
+  DdManager* dd = BddEnc_get_dd_manager(enc);
+  TraceManager_ptr gtm = TracePkg_get_global_trace_manager();
+  TraceXmlDumper_ptr dumper;
+  TraceOpt_ptr trace_opt;
+  bdd_ptr last_state;
+  FILE* out;
+  int n_steps;
+
+  out = fopen(xml_file, "w");
+  if (NIL(FILE) == out) {
+    fprintf(nusmv_stderr, "Unable to open file \"%s\" for writing.\n",
+            xml_file);
+    return 1;
+  }
+
+  trace_opt = TraceOpt_create_from_env(OptsHandler_get_instance());
+  TraceOpt_set_output_stream(trace_opt, out);
+  dumper = TraceXmlDumper_create();
+
+  n_steps = Simulate_MultipleStepsToXml(fsm, constraints, time_shift, mode,
+                                        steps, display_all, symbols,
+                                        dumper, trace_opt, &last_state);
+
+  Object_destroy(OBJECT(dumper), NULL);
+  TraceOpt_destroy(trace_opt);
+  fclose(out);
+
+  fprintf(nusmv_stdout, "%d simulation steps written to file \"%s\".\n",
+          n_steps, xml_file);
+
+  { /* the last state starts a new simulation trace */
+    SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(enc));
+    Trace_ptr trace;
+    int trace_id;
+
+    trace = Trace_create(st, "Simulation Trace", TRACE_TYPE_SIMULATION,
+                         symbols, false);
+    Mc_trace_step_put_state_from_bdd(trace, Trace_first_iter(trace),
+                                     enc, last_state);
+
+    trace_id = TraceManager_register_trace(gtm, trace);
+    TraceManager_set_current_trace_number(gtm, trace_id);
+    current_state_set(last_state, TraceLabel_create(trace_id, 0));
+  }
+
+  bdd_free(dd, last_state);
+  return 0;
+}
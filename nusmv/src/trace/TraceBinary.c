@@ -0,0 +1,238 @@
+/**CFile***********************************************************************
+
+  FileName    [TraceBinary.c]
+
+  PackageName [trace]
+
+  Synopsis    [Low level routines of the Trace binary format]
+
+  Description [Routines shared by the binary trace dumper and
+  loader. See TraceBinary.h for a description of the format.]
+
+  SeeAlso     [TraceBinary.h]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``trace'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+#if NUSMV_HAVE_CONFIG
+# include "nusmv-config.h"
+#endif
+
+#include "TraceBinary.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: $";
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* longest string accepted while reading, to protect against corrupted
+   files */
+#define TRACE_BINARY_MAX_STRING_LEN  0x100000 /* 1 Mbyte */
+
+/*---------------------------------------------------------------------------*/
+/* Definition of external functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [Writes the magic string and the format version]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            [TraceBinary_read_header]
+
+******************************************************************************/
+void TraceBinary_write_header(FILE* out)
+{
+  fwrite(TRACE_BINARY_MAGIC, sizeof(char), TRACE_BINARY_MAGIC_LEN, out);
+  TraceBinary_write_uint(out, TRACE_BINARY_VERSION);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Reads the magic string and the format version]
+
+  Description        [Returns true iff the stream begins with a binary
+  trace of a supported version]
+
+  SideEffects        []
+
+  SeeAlso            [TraceBinary_write_header]
+
+******************************************************************************/
+boolean TraceBinary_read_header(FILE* in)
+{
+  char magic[TRACE_BINARY_MAGIC_LEN];
+  unsigned long version;
+
+  if (TRACE_BINARY_MAGIC_LEN !=
+      fread(magic, sizeof(char), TRACE_BINARY_MAGIC_LEN, in)) return false;
+
+  if (0 != memcmp(magic, TRACE_BINARY_MAGIC, TRACE_BINARY_MAGIC_LEN)) {
+    return false;
+  }
+
+  return TraceBinary_read_uint(in, &version) &&
+    (TRACE_BINARY_VERSION == version);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Checks whether a file contains a binary trace]
+
+  Description        [Only the magic string is checked]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+boolean TraceBinary_is_binary_file(const char* filename)
+{
+  char magic[TRACE_BINARY_MAGIC_LEN];
+  boolean res = false;
+  FILE* in = fopen(filename, "rb");
+
+  if (NIL(FILE) != in) {
+    res = (TRACE_BINARY_MAGIC_LEN ==
+           fread(magic, sizeof(char), TRACE_BINARY_MAGIC_LEN, in)) &&
+      (0 == memcmp(magic, TRACE_BINARY_MAGIC, TRACE_BINARY_MAGIC_LEN));
+    fclose(in);
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Writes an unsigned integer]
+
+  Description        [Seven bits per byte, least significant first]
+
+  SideEffects        []
+
+  SeeAlso            [TraceBinary_read_uint]
+
+******************************************************************************/
+void TraceBinary_write_uint(FILE* out, unsigned long n)
+{
+  while (n >= 0x80) {
+    putc((int) ((n & 0x7f) | 0x80), out);
+    n >>= 7;
+  }
+  putc((int) n, out);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Reads an unsigned integer]
+
+  Description        [Returns false at end of file, or if the encoded
+  integer does not fit an unsigned long]
+
+  SideEffects        [The read integer is stored in n]
+
+  SeeAlso            [TraceBinary_write_uint]
+
+******************************************************************************/
+boolean TraceBinary_read_uint(FILE* in, unsigned long* n)
+{
+  unsigned long res = 0;
+  unsigned shift = 0;
+  int c;
+
+  do {
+    c = getc(in);
+    if (EOF == c || shift >= 8 * sizeof(unsigned long)) return false;
+
+    res |= ((unsigned long) (c & 0x7f)) << shift;
+    shift += 7;
+  } while (c & 0x80);
+
+  *n = res;
+  return true;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Writes a string]
+
+  Description        [The length is written first]
+
+  SideEffects        []
+
+  SeeAlso            [TraceBinary_read_string]
+
+******************************************************************************/
+void TraceBinary_write_string(FILE* out, const char* str)
+{
+  size_t len = strlen(str);
+
+  TraceBinary_write_uint(out, len);
+  fwrite(str, sizeof(char), len, out);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Reads a string]
+
+  Description        [Returns a newly allocated string that must be freed
+  by the caller, or NULL if the string could not be read]
+
+  SideEffects        []
+
+  SeeAlso            [TraceBinary_write_string]
+
+******************************************************************************/
+char* TraceBinary_read_string(FILE* in)
+{
+  unsigned long len;
+  char* res;
+
+  if (!TraceBinary_read_uint(in, &len) ||
+      len > TRACE_BINARY_MAX_STRING_LEN) return NIL(char);
+
+  res = ALLOC(char, len + 1);
+  nusmv_assert(NIL(char) != res);
+
+  if (len != fread(res, sizeof(char), len, in)) {
+    FREE(res);
+    return NIL(char);
+  }
+
+  res[len] = '\0';
+  return res;
+}
@@ -0,0 +1,105 @@
+/**CHeaderFile*****************************************************************
+
+  FileName    [TraceBinary.h]
+
+  PackageName [trace]
+
+  Synopsis    [The Trace binary format header]
+
+  Description [A trace in binary format is a sequence of unsigned
+  integers, each written in the variable length little-endian base 128
+  encoding (7 bits per byte, the most significant bit of a byte is set
+  when more bytes follow). Strings are written as their length
+  followed by their characters. A file is made of:
+
+  <dl>
+  <dt> header
+     <dd> the magic string TRACE_BINARY_MAGIC, the format version, the
+     trace type (plus one, so that TRACE_TYPE_UNSPECIFIED is zero) and
+     the trace description.
+  <dt> symbols
+     <dd> the number of symbols, followed by the name of each
+     symbol. Symbols are afterwards referred to by their index in this
+     table.
+  <dt> steps
+     <dd> the number of steps, followed by the steps. A step begins with
+     the number of symbols whose value differs from the one they have
+     in the previous step (all the symbols are unassigned before the
+     first step), shifted left by one bit, the lowest bit being set
+     when the step is a loopback. Then, for each changed symbol in
+     increasing index order, the distance from the previous changed
+     symbol (minus one) and the code of the new value.
+  </dl>
+
+  Values are encoded as a dictionary that grows while the file is
+  read: code 0 stands for no value, codes 1..N for the values seen so
+  far, and code N+1 introduces a new value, whose textual
+  representation follows as a string.]
+
+  SeeAlso     [TraceBinaryDumper, TraceBinaryLoader]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``trace'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+#ifndef __TRACE_BINARY__H
+#define __TRACE_BINARY__H
+
+#include "utils/utils.h"
+
+#include <stdio.h>
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+#define TRACE_BINARY_MAGIC         "NuSMVtrb"
+#define TRACE_BINARY_MAGIC_LEN     8
+#define TRACE_BINARY_VERSION       1
+
+/* value codes */
+#define TRACE_BINARY_NO_VALUE      0
+
+
+/**AutomaticStart*************************************************************/
+
+/**AutomaticEnd***************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+void TraceBinary_write_header ARGS((FILE* out));
+boolean TraceBinary_read_header ARGS((FILE* in));
+boolean TraceBinary_is_binary_file ARGS((const char* filename));
+
+void TraceBinary_write_uint ARGS((FILE* out, unsigned long n));
+boolean TraceBinary_read_uint ARGS((FILE* in, unsigned long* n));
+
+void TraceBinary_write_string ARGS((FILE* out, const char* str));
+char* TraceBinary_read_string ARGS((FILE* in));
+
+#endif /* __TRACE_BINARY__H */
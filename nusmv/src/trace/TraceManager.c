@@ -55,6 +55,7 @@
 #include "trace/plugins/TraceTable.h"
 #include "trace/plugins/TraceCompact.h"
 #include "trace/plugins/TraceXmlDumper.h"
+#include "trace/plugins/TraceBinaryDumper.h"
 
 /* executors */
 #include "trace/exec/BaseTraceExecutor.h"
@@ -1157,6 +1158,10 @@ void TraceManager_init_plugins(TraceManager_ptr self)
   plugin = TRACE_PLUGIN(TraceCompact_create());
   TraceManager_register_plugin(self, plugin);
 
+  /* 6. TRACE BINARY DUMP PLUGIN */
+  plugin = TRACE_PLUGIN(TraceBinaryDumper_create());
+  TraceManager_register_plugin(self, plugin);
+
   self->internal_plugins_num = TraceManager_get_plugin_size(self);
 }
 
@@ -92,6 +92,9 @@ EXTERN FILE* nusmv_stderr;
 /* non-descriptive description ;) */
 #define TRACE_DEFAULT_DESC "<generic trace>"
 
+/* dictionaries of columns up to this size are searched linearly */
+#define TRACE_COLUMN_LINEAR_DICT 8
+
 /**AutomaticStart*************************************************************/
 
 /*---------------------------------------------------------------------------*/
@@ -113,69 +116,6 @@ trace_set_language ARGS((Trace_ptr self, SymbTable_ptr st,
 static inline node_ptr*
 trace_frozen_frame_get_base ARGS((const TraceFrozenFrame_ptr frame));
 
-static inline node_ptr*
-trace_var_frame_get_state_base ARGS((const TraceVarFrame_ptr frame));
-
-static inline void
-trace_var_frame_set_state_base ARGS((const TraceVarFrame_ptr frame,
-                                     node_ptr* base));
-static inline node_ptr*
-trace_var_frame_get_input_base ARGS((const TraceVarFrame_ptr frame));
-
-static inline void
-trace_var_frame_set_input_base ARGS((const TraceVarFrame_ptr frame,
-                                     node_ptr* base));
-
-static inline node_ptr*
-trace_define_frame_get_state_base ARGS((const TraceDefineFrame_ptr frame));
-
-static inline void
-trace_define_frame_set_state_base ARGS((TraceDefineFrame_ptr frame,
-                                        node_ptr* base));
-
-static inline node_ptr*
-trace_define_frame_get_input_base ARGS((const TraceDefineFrame_ptr frame));
-
-static inline void
-trace_define_frame_set_input_base ARGS((TraceDefineFrame_ptr frame,
-                                        node_ptr* base));
-
-static inline node_ptr*
-trace_define_frame_get_state_input_base ARGS((const TraceDefineFrame_ptr frame));
-
-static inline void
-trace_define_frame_set_state_input_base ARGS((TraceDefineFrame_ptr frame,
-                                              node_ptr* base));
-
-static inline node_ptr*
-trace_define_frame_get_next_base ARGS((const TraceDefineFrame_ptr frame));
-
-static inline void
-trace_define_frame_set_next_base ARGS((TraceDefineFrame_ptr frame,
-                                       node_ptr* base));
-
-static inline node_ptr*
-trace_define_frame_get_state_next_base ARGS((const TraceDefineFrame_ptr frame));
-
-static inline void
-trace_define_frame_set_state_next_base ARGS((TraceDefineFrame_ptr frame,
-                                             node_ptr* base));
-
-static inline node_ptr*
-trace_define_frame_get_input_next_base ARGS((const TraceDefineFrame_ptr frame));
-
-static inline void
-trace_define_frame_set_input_next_base ARGS((TraceDefineFrame_ptr frame,
-                                             node_ptr* base));
-
-static inline node_ptr*
-trace_define_frame_get_state_input_next_base
-ARGS((const TraceDefineFrame_ptr frame));
-
-static inline void
-trace_define_frame_set_state_input_next_base
-ARGS((TraceDefineFrame_ptr frame, node_ptr* base));
-
 static inline unsigned
 trace_get_n_state_vars ARGS((const Trace_ptr self));
 
@@ -203,11 +143,8 @@ trace_get_n_state_next_defines ARGS((const Trace_ptr self));
 static inline unsigned
 trace_get_n_input_next_defines ARGS((const Trace_ptr self));
 
-static inline void
-trace_set_first_frame ARGS((Trace_ptr self, TraceVarFrame_ptr var_frame));
-
-static inline void
-trace_set_last_frame ARGS((Trace_ptr self, TraceVarFrame_ptr var_frame));
+static inline TraceVarFrame_ptr
+trace_get_frame ARGS((const Trace_ptr self, unsigned index));
 
 static inline TraceFrozenFrame_ptr
 trace_get_frozen_frame ARGS((Trace_ptr self));
@@ -226,35 +163,55 @@ static inline TraceVarFrame_ptr
 trace_var_frame_create ARGS((Trace_ptr self));
 
 static inline void
-trace_var_frame_destroy ARGS((TraceVarFrame_ptr frame));
+trace_destroy_storage ARGS((Trace_ptr self));
+
+static inline node_ptr*
+trace_iter_get_section_base ARGS((Trace_ptr trace, TraceIter iter,
+                                  TraceSection sect_type, boolean create));
 
-static inline TraceDefineFrame_ptr
-trace_define_frame_create ARGS((Trace_ptr self));
+static inline boolean
+trace_iter_has_section ARGS((Trace_ptr trace, TraceIter iter,
+                             TraceSection section));
+
+static inline node_ptr
+trace_iter_get_section_value ARGS((Trace_ptr trace, TraceIter iter,
+                                   TraceSection section, unsigned offset));
 
 static inline void
-trace_define_frame_destroy ARGS((TraceDefineFrame_ptr def_frame));
+trace_iter_copy_var_values ARGS((Trace_ptr dst, TraceIter dst_iter,
+                                 Trace_ptr src, TraceIter src_iter));
 
 static inline void
-trace_var_frame_set_prev ARGS((TraceVarFrame_ptr frame, TraceVarFrame_ptr prev));
+trace_iter_copy_define_values ARGS((Trace_ptr dst, TraceIter dst_iter,
+                                    Trace_ptr src, TraceIter src_iter));
 
-static inline TraceVarFrame_ptr
-trace_var_frame_get_prev ARGS((TraceVarFrame_ptr frame));
+/* value columns */
+static inline TraceColumn_ptr
+trace_get_column ARGS((const Trace_ptr self, TraceSection section,
+                       unsigned offset));
 
-static inline void
-trace_var_frame_set_next ARGS((TraceVarFrame_ptr frame, TraceVarFrame_ptr next));
+static inline TraceColumn_ptr
+trace_get_define_column ARGS((Trace_ptr self, TraceSection section,
+                              unsigned offset, boolean create));
 
-static inline TraceVarFrame_ptr
-trace_var_frame_get_next ARGS((TraceVarFrame_ptr frame));
+static TraceColumn_ptr trace_columns_create ARGS((unsigned n_columns));
+
+static void trace_columns_destroy ARGS((TraceColumn_ptr columns,
+                                        unsigned n_columns));
 
-static inline TraceDefineFrame_ptr
-trace_var_frame_get_fwd_define_frame ARGS((TraceVarFrame_ptr var_frame));
+static inline unsigned
+trace_column_get_code ARGS((const TraceColumn_ptr self, unsigned index));
 
-static inline TraceDefineFrame_ptr
-trace_var_frame_get_bwd_define_frame ARGS((TraceVarFrame_ptr var_frame));
+static inline node_ptr
+trace_column_get_value ARGS((const TraceColumn_ptr self, unsigned index));
 
-static inline node_ptr*
-trace_iter_get_section_base ARGS((Trace_ptr trace, TraceIter iter,
-                                  TraceSection sect_type, boolean create));
+static void trace_column_put_value ARGS((TraceColumn_ptr self, unsigned index,
+                                         node_ptr value));
+
+static unsigned trace_column_encode ARGS((TraceColumn_ptr self,
+                                          node_ptr value));
+
+static void trace_column_widen ARGS((TraceColumn_ptr self));
 
 /* lookup management */
 static inline void
@@ -278,35 +235,6 @@ trace_dispose_lookup_cache ARGS((Trace_ptr self));
 static inline void
 trace_print_alloc_stats ARGS((Trace_ptr self));
 
-/* frames internals */
-static inline TraceDefineFrame_ptr
-trace_var_frame_get_fwd_define_frame ARGS((TraceVarFrame_ptr var_frame));
-
-static inline TraceDefineFrame_ptr
-trace_var_frame_get_bwd_define_frame ARGS((TraceVarFrame_ptr var_frame));
-
-static inline void
-trace_var_frame_set_fwd_define_frame ARGS((TraceVarFrame_ptr var_frame,
-                                           TraceDefineFrame_ptr def_frame));
-
-static inline void
-trace_var_frame_set_bwd_define_frame ARGS((TraceVarFrame_ptr var_frame,
-                                           TraceDefineFrame_ptr def_frame));
-
-static inline TraceVarFrame_ptr
-trace_var_frame_get_next_frame ARGS((TraceVarFrame_ptr var_frame));
-
-static inline TraceVarFrame_ptr
-trace_var_frame_get_prev_frame ARGS((TraceVarFrame_ptr var_frame));
-
-static inline void
-trace_var_frame_set_next_frame ARGS((TraceVarFrame_ptr var_frame,
-                                     TraceVarFrame_ptr next_frame));
-
-static inline void
-trace_var_frame_set_prev_frame ARGS((TraceVarFrame_ptr var_frame,
-                                     TraceVarFrame_ptr prev_frame));
-
 /* internal getters/setters */
 static inline void
 trace_inc_n_section_symbols ARGS((Trace_ptr self,
@@ -360,9 +288,6 @@ trace_frozen_frame_init ARGS((TraceFrozenFrame_ptr self));
 static inline void
 trace_var_frame_init ARGS((TraceVarFrame_ptr self));
 
-static inline void
-trace_define_frame_init ARGS((TraceDefineFrame_ptr self));
-
 static inline node_ptr*
 trace_setup_section_storage ARGS((unsigned n_symbs));
 
@@ -372,6 +297,10 @@ trace_copy_section_storage ARGS((node_ptr* dest, node_ptr* src,
 static inline int
 trace_compare_section_storage ARGS((node_ptr* dest, node_ptr* src,
                                     unsigned n_symbs));
+static inline int
+trace_compare_var_values ARGS((Trace_ptr self, TraceIter step,
+                               Trace_ptr other, TraceIter other_step,
+                               TraceSection section));
 
 
 
@@ -409,23 +338,15 @@ trace_create (SymbTable_ptr st, const char* desc,
   } /* 0 */
 
   { /* phase 1: initial frame setup */
-    TraceDefineFrame_ptr define_frame;
-    TraceVarFrame_ptr initial_frame;
-
     /* setup frozen frame */
     trace_set_frozen_frame(res, trace_frozen_frame_create(res));
 
-    /* assign the first and final frame to the initial var frame */
-    initial_frame = trace_var_frame_create(res);
-
-    trace_set_first_frame(res, initial_frame);
-    trace_set_last_frame(res, initial_frame);
+    /* setup value columns */
+    res->state_columns = trace_columns_create(trace_get_n_state_vars(res));
+    res->input_columns = trace_columns_create(trace_get_n_input_vars(res));
 
-    /* setup  define frame for initial var frame */
-    define_frame = trace_define_frame_create(res);
-    trace_var_frame_set_fwd_define_frame(initial_frame, define_frame);
-    trace_var_frame_set_bwd_define_frame(initial_frame,
-                                         TRACE_DEFINE_FRAME(NULL));
+    /* initial var frame */
+    (void) trace_var_frame_create(res);
   }
 
   return res;
@@ -435,31 +356,8 @@ trace_create (SymbTable_ptr st, const char* desc,
 void
 trace_destroy(Trace_ptr self)
 {
-  TraceVarFrame_ptr var_frame = TRACE_VAR_FRAME(trace_last_iter(self));
-  TraceVarFrame_ptr prev_var_frame;
-
-  /* destroying the trace backwards may improve performance w.r.t. OS
-     caching */
-  while (TRACE_END_ITER != TRACE_ITER(var_frame)) {
-    TraceDefineFrame_ptr def_frame =
-      trace_var_frame_get_fwd_define_frame(var_frame);
-
-    /* forward frames always exist by construction */
-    CHECK(TRACE_DEFINE_FRAME(NULL) != def_frame);
-    trace_define_frame_destroy(def_frame);
-
-    prev_var_frame = var_frame->prev_frame;
-    trace_var_frame_destroy(var_frame);
-
-    -- (self->length);
-    var_frame = prev_var_frame;
-  }
-
-  /* make sure all the frames have been freed */
-  CHECK(~0 == self->length);
-
-  /* destroy frozen frame */
-  trace_frozen_frame_destroy(trace_get_frozen_frame(self));
+  /* destroy frames and values */
+  trace_destroy_storage(self);
 
   /* get rid of extra lookup info */
   trace_dispose_lookup_cache(self);
@@ -504,23 +402,15 @@ trace_copy_ex (Trace_ptr self, TraceIter from_here, TraceIter until_here,
   } /* 0 */
 
   { /* phase 1: initial frame setup */
-    TraceDefineFrame_ptr define_frame;
-    TraceVarFrame_ptr initial_frame;
-
     /* setup frozen frame */
     trace_set_frozen_frame(res, trace_frozen_frame_create(res));
 
-    /* assign the first and final frame to the initial var frame */
-    initial_frame = trace_var_frame_create(res);
-
-    trace_set_first_frame(res, initial_frame);
-    trace_set_last_frame(res, initial_frame);
+    /* setup value columns */
+    res->state_columns = trace_columns_create(trace_get_n_state_vars(res));
+    res->input_columns = trace_columns_create(trace_get_n_input_vars(res));
 
-    /* setup  define frame for initial var frame */
-    define_frame = trace_define_frame_create(res);
-    trace_var_frame_set_fwd_define_frame(initial_frame, define_frame);
-    trace_var_frame_set_bwd_define_frame(initial_frame,
-                                         TRACE_DEFINE_FRAME(NULL));
+    /* initial var frame */
+    (void) trace_var_frame_create(res);
   }
 
   /* phase 3: copy frozen data */
@@ -532,7 +422,7 @@ trace_copy_ex (Trace_ptr self, TraceIter from_here, TraceIter until_here,
                                trace_get_n_frozen_vars(res));
   }
 
-  /* phase 4: copy var and define frame data until given iterator */
+  /* phase 4: copy var and define values until given iterator */
   {
     TraceIter src_iter = from_here; 
     if (!src_iter) {
@@ -541,22 +431,10 @@ trace_copy_ex (Trace_ptr self, TraceIter from_here, TraceIter until_here,
     TraceIter dst_iter = trace_first_iter(res);
 
     while (TRACE_END_ITER != src_iter) {
-      unsigned section;
-      node_ptr* src_base;
-
       /* frozenvars have already been copied above */
-      for (section = TRACE_SECTION_STATE_VAR;
-           section < TRACE_SECTION_END; ++ section ) {
-
-        src_base = trace_iter_get_section_base(self, src_iter, section, false);
+      trace_iter_copy_var_values(res, dst_iter, self, src_iter);
+      trace_iter_copy_define_values(res, dst_iter, self, src_iter);
 
-        if ((node_ptr*)(NULL) != src_base) {
-          trace_copy_section_storage(trace_iter_get_section_base(res, dst_iter,
-                                                                 section, true),
-                                     src_base,
-                                     trace_get_n_section_symbols(self, section));
-        }
-      }
       if (src_iter == until_here) break; /* up to (included) until_here */
       src_iter = trace_iter_get_next(src_iter);
 
@@ -681,24 +559,22 @@ trace_concat (Trace_ptr self, Trace_ptr* other)
     }
   } /* merge frontier state */
 
-  /* phase 4: consume "other" trace, link its data to self */
+  /* phase 4: consume "other" trace, append its data to self. Values
+     are re-encoded into the columns of self */
   {
-    TraceIter lhs_link = trace_last_iter(self);
-    TraceIter rhs_link = trace_iter_get_next(trace_first_iter(*other));
-
-    trace_var_frame_set_next(lhs_link, TRACE_VAR_FRAME(rhs_link));
-    if (TRACE_END_ITER != rhs_link) {
-      TraceIter rhs_last_iter = trace_last_iter(*other);
-      trace_set_last_frame(self, TRACE_VAR_FRAME(rhs_last_iter));
-      self->length += (*other)->length;
-
-      trace_var_frame_set_prev(rhs_link, TRACE_VAR_FRAME(lhs_link));
-      trace_var_frame_set_bwd_define_frame(rhs_link,
-                trace_var_frame_get_fwd_define_frame(TRACE_VAR_FRAME(lhs_link)));
+    TraceIter rhs = trace_iter_get_next(trace_first_iter(*other));
+
+    while (TRACE_END_ITER != rhs) {
+      TraceIter lhs = trace_append_step(self);
+
+      trace_iter_copy_var_values(self, lhs, *other, rhs);
+      trace_iter_copy_define_values(self, lhs, *other, rhs);
+
+      rhs = trace_iter_get_next(rhs);
     }
 
-    /* dispose first var frame for other */
-    trace_var_frame_destroy(TRACE_VAR_FRAME(trace_first_iter(*other)));
+    /* dispose frames and values for other */
+    trace_destroy_storage(*other);
 
     if (!((*other)->is_volatile)) {
       SymbTable_destroy(trace_get_symb_table(*other));
@@ -719,13 +595,18 @@ trace_concat (Trace_ptr self, Trace_ptr* other)
 TraceIter
 trace_iter_get_next(const TraceIter iter)
 {
-  return TRACE_ITER( TRACE_VAR_FRAME(iter) -> next_frame );
+  Trace_ptr trace = TRACE_VAR_FRAME(iter)->trace;
+
+  if (iter->index == trace_get_length(trace)) return TRACE_END_ITER;
+  return TRACE_ITER(trace_get_frame(trace, iter->index + 1));
 }
 
 TraceIter
 trace_iter_get_prev(const TraceIter iter)
 {
-  return TRACE_ITER( TRACE_VAR_FRAME(iter) -> prev_frame );
+  if (0 == iter->index) return TRACE_END_ITER;
+  return TRACE_ITER(trace_get_frame(TRACE_VAR_FRAME(iter)->trace,
+                                    iter->index - 1));
 }
 
 /* step iterator factory */
@@ -744,9 +625,7 @@ trace_step_iter (const Trace_ptr trace, const TraceIter step,
   /* pick first non empty section */
   res.section = TRACE_SECTION_FROZEN_VAR; do {
     if ((0 != (res.type & (1 << res.section))) &&
-        (node_ptr*)(NULL) != \
-        trace_iter_get_section_base(res.trace, res.step,
-                                    res.section, false)) {
+        trace_iter_has_section(res.trace, res.step, res.section)) {
       /* found section, return */
       break;
     }
@@ -783,43 +662,40 @@ trace_symbols_iter (const Trace_ptr trace, TraceIteratorType iter_type)
 } /* trace_symbols_iter */
 
 
-/* DANGER: hazardous area */
 boolean
 trace_step_iter_fetch (TraceStepIter* iter,
                        node_ptr* symb_name, node_ptr* symb_value)
 {
-  node_ptr* base;
   node_ptr value = Nil;
 
   while(true) {
+    unsigned n_symbs;
+
     /* end of iteration? */
     if (TRACE_SECTION_END == iter->section) return false;
 
-    base = trace_iter_get_section_base(iter->trace, iter->step,
-                                       iter->section, false);
-    CHECK((node_ptr*)(NULL) != base);
+    CHECK(trace_iter_has_section(iter->trace, iter->step, iter->section));
 
-    /* run through the value vector until a non-Nil node is
-       encountered, this cycle is guaranteed to terminate due to
-       sentinel nodes */
-    while (Nil == value) {
-      value = *(base + iter->cursor) ;
+    /* run through the values of the section until a non-Nil node is
+       encountered */
+    n_symbs = trace_get_n_section_symbols(iter->trace, iter->section);
+    while (Nil == value && iter->cursor < n_symbs) {
+      value = trace_iter_get_section_value(iter->trace, iter->step,
+                                           iter->section, iter->cursor);
       ++ (iter->cursor);
     }
 
     /* found value, yield assignment */
-    if (FAILURE != node_get_type(value)) break;
+    if (Nil != value) break;
 
     /* get next non-empty section */
     while (TRACE_SECTION_END != iter->section) {
       ++ (iter->section);
       if ((0 != (iter->type & (1 << iter->section))) &&
-          (node_ptr*)(NULL) !=  \
-          trace_iter_get_section_base(iter->trace, iter->step,
-                                      iter->section, false)) {
+          trace_iter_has_section(iter->trace, iter->step, iter->section)) {
 
         /* found section, resume iteration */
-        iter->cursor = 0; value = Nil;
+        iter->cursor = 0;
         break;
       }
     }
@@ -896,12 +772,6 @@ trace_var_frame_init(TraceVarFrame_ptr self)
   memset(self, 0, sizeof(struct TraceVarFrame_TAG));
 }
 
-static inline void
-trace_define_frame_init(TraceDefineFrame_ptr self)
-{
-  memset(self, 0, sizeof(struct TraceDefineFrame_TAG));
-}
-
 /* trace metadata getters/setters */
 static inline void
 trace_reset_length(const Trace_ptr self)
@@ -1165,55 +1035,30 @@ trace_is_volatile(const Trace_ptr self)
 /* horizontal iterators */
 TraceIter trace_first_iter(const Trace_ptr self)
 {
-  return TRACE_ITER(self->first_frame);
+  return TRACE_ITER(trace_get_frame(self, 0));
 }
 
 
-/* efficiently retrieves ith iter (bi-directional search) */
+/* retrieves ith iter in constant time. TRACE_END_ITER is returned
+   for any i past the last step */
 TraceIter trace_ith_iter(const Trace_ptr self, unsigned i)
 {
-  unsigned fwd_distance = i - 1;
-  unsigned bwd_distance = 1 + trace_get_length(self) - i;
-  TraceIter res;
-
   nusmv_assert(i > 0);
 
-  if (fwd_distance < bwd_distance) {
-    res = trace_first_iter(self);
-    while (0 != fwd_distance) {
-      CHECK(TRACE_END_ITER != res);
-      res = trace_iter_get_next(res);
-      -- fwd_distance;
-    }
-  }
-  else { /* bwd_distance <= fwd_distance */
-    res = trace_last_iter(self);
-    while (0 != bwd_distance) {
-      CHECK(TRACE_END_ITER != res);
-      res = trace_iter_get_prev(res);
-      -- bwd_distance;
-    }
-  }
-
-  return res;
+  if (i > 1 + trace_get_length(self)) return TRACE_END_ITER;
+  return TRACE_ITER(trace_get_frame(self, i - 1));
 } /* trace_ith_iter */
 
 /* iter -> i (dual of the previous) */
 unsigned trace_iter_i(const Trace_ptr self, TraceIter iter)
 {
-  unsigned  i = 1;
-  TraceIter step = trace_first_iter(self);
-  while  (step != iter) {
-    ++ i;
-    step = trace_iter_get_next(step);
-  }
-
-  return i;
+  CHECK(TRACE_VAR_FRAME(iter)->trace == self);
+  return 1 + TRACE_VAR_FRAME(iter)->index;
 }
 
 TraceIter trace_last_iter(const Trace_ptr self)
 {
-  return TRACE_ITER(self->last_frame);
+  return TRACE_ITER(trace_get_frame(self, trace_get_length(self)));
 }
 
 /* frames management */
@@ -1229,79 +1074,63 @@ trace_set_frozen_frame(Trace_ptr self, TraceFrozenFrame_ptr frozen_frame)
   self->frozen_frame = frozen_frame;
 }
 
-static inline void
-trace_set_first_frame(Trace_ptr self, TraceVarFrame_ptr var_frame)
-{
-  self->first_frame = var_frame;
-}
-
-static inline void
-trace_set_last_frame(Trace_ptr self, TraceVarFrame_ptr var_frame)
+/* the frame of the index-th step (from 0) */
+static inline TraceVarFrame_ptr
+trace_get_frame(const Trace_ptr self, unsigned index)
 {
-  self->last_frame = var_frame;
+  CHECK(index <= trace_get_length(self));
+  return self->frame_chunks[index >> TRACE_CHUNK_BITS] +
+    (index & (TRACE_CHUNK_SIZE - 1));
 }
 
 /* frame constructors/destructors */
+
+/* Takes the frame of the step following the last one from the chunks
+   of self, allocating a new chunk when needed. The length of self is
+   not changed. */
 static TraceVarFrame_ptr
 trace_var_frame_create (Trace_ptr self)
 {
-  TraceVarFrame_ptr res = ALLOC(TraceVarFrame, 1);
-  TRACE_VAR_FRAME_CHECK_INSTANCE(res);
-  trace_var_frame_init(res);
-
-  trace_var_frame_set_state_base(res,
-     trace_setup_section_storage(trace_get_n_state_vars(self)));
+  unsigned index = (0 == self->n_frame_chunks) ? 0 : 1 + trace_get_length(self);
+  unsigned chunk = index >> TRACE_CHUNK_BITS;
+  TraceVarFrame_ptr res;
 
-  trace_var_frame_set_input_base(res,
-     trace_setup_section_storage(trace_get_n_input_vars(self)));
+  if (chunk == self->n_frame_chunks) {
+    self->n_frame_chunks += 1;
+    self->frame_chunks = REALLOC(TraceVarFrame_ptr, self->frame_chunks,
+                                 self->n_frame_chunks);
+    self->frame_chunks[chunk] = ALLOC(TraceVarFrame, TRACE_CHUNK_SIZE);
+    nusmv_assert(TRACE_VAR_FRAME(NULL) != self->frame_chunks[chunk]);
+  }
 
-  trace_var_frame_set_fwd_define_frame(res, TRACE_DEFINE_FRAME(NULL));
-  trace_var_frame_set_bwd_define_frame(res, TRACE_DEFINE_FRAME(NULL));
+  res = self->frame_chunks[chunk] + (index & (TRACE_CHUNK_SIZE - 1));
+  trace_var_frame_init(res);
 
-  trace_var_frame_set_next_frame(res, TRACE_VAR_FRAME(NULL));
-  trace_var_frame_set_prev_frame(res, TRACE_VAR_FRAME(NULL));
+  res->trace = self;
+  res->index = index;
 
   return res;
 }
 
+/* disposes frames, frozen frame and value columns */
 static inline void
-trace_var_frame_destroy(TraceVarFrame_ptr var_frame)
-{
-  TRACE_VAR_FRAME_CHECK_INSTANCE(var_frame);
-
-  CHECK((node_ptr*)(NULL) != var_frame->state_values);
-  FREE(var_frame->state_values);
-
-  CHECK((node_ptr*)(NULL) != var_frame->input_values);
-  FREE(var_frame->input_values);
-
-  FREE(var_frame);
-}
-
-TraceDefineFrame_ptr
-trace_define_frame_create (Trace_ptr self)
+trace_destroy_storage(Trace_ptr self)
 {
-  TraceDefineFrame_ptr res = ALLOC(TraceDefineFrame, 1);
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(res);
+  unsigned i;
 
-  memset(res, 0, sizeof(TraceDefineFrame));
-  return res;
-}
+  for (i = 0; i < self->n_frame_chunks; ++i) FREE(self->frame_chunks[i]);
+  FREE(self->frame_chunks);
+  self->n_frame_chunks = 0;
 
-static inline void
-trace_define_frame_destroy(TraceDefineFrame_ptr def_frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(def_frame);
+  trace_columns_destroy(self->state_columns, trace_get_n_state_vars(self));
+  trace_columns_destroy(self->input_columns, trace_get_n_input_vars(self));
 
-  if ((node_ptr*)(NULL) != def_frame->s_values) { FREE(def_frame->s_values); }
-  if ((node_ptr*)(NULL) != def_frame->i_values) { FREE(def_frame->i_values); }
-  if ((node_ptr*)(NULL) != def_frame->si_values) { FREE(def_frame->si_values); }
-  if ((node_ptr*)(NULL) != def_frame->n_values) { FREE(def_frame->n_values); }
-  if ((node_ptr*)(NULL) != def_frame->sn_values) { FREE(def_frame->sn_values); }
-  if ((node_ptr*)(NULL) != def_frame->in_values) { FREE(def_frame->in_values); }
-  if ((node_ptr*)(NULL) != def_frame->sin_values) { FREE(def_frame->sin_values);}
+  for (i = TRACE_SECTION_STATE_DEFINE; i < TRACE_SECTION_END; ++i) {
+    trace_columns_destroy(self->define_columns[i],
+                          trace_get_n_section_symbols(self, i));
+  }
 
-  FREE(def_frame);
+  trace_frozen_frame_destroy(trace_get_frozen_frame(self));
 }
 
 static TraceFrozenFrame_ptr
@@ -1330,28 +1159,74 @@ trace_frozen_frame_destroy(TraceFrozenFrame_ptr frozen_frame)
 
 TraceIter trace_append_step(Trace_ptr self)
 {
-  TraceVarFrame_ptr var_frame = trace_var_frame_create(self);
-  TraceVarFrame_ptr last_frame = TRACE_VAR_FRAME(trace_last_iter(self));
-
   CHECK(trace_is_thawed(self));
 
-  trace_var_frame_set_prev(var_frame, last_frame);
-  if (TRACE_VAR_FRAME(NULL) != last_frame) {
-    trace_var_frame_set_next(last_frame, var_frame);
-    trace_var_frame_set_bwd_define_frame(var_frame,
-              trace_var_frame_get_fwd_define_frame(last_frame));
-  }
-
-  trace_var_frame_set_fwd_define_frame(var_frame,
-                                       trace_define_frame_create(self));
+  (void) trace_var_frame_create(self);
 
   /* update trace info */
   trace_inc_length(self);
-  trace_set_last_frame(self, var_frame);
+
+  /* the last step gets a successor */
+  trace_set_eval_step(self, TRACE_END_ITER);
 
   return trace_last_iter(self);
 }
 
+/* Removes the first n_steps steps of a thawed trace, the remaining
+   steps are moved to the front. This is used to slide a window of
+   bounded size over a trace that is being streamed: the frame chunks
+   already allocated are reused, so the storage of the trace does not
+   grow with the number of steps that have been dropped. */
+void trace_drop_first_steps(Trace_ptr self, unsigned n_steps)
+{
+  unsigned length = trace_get_length(self);
+  unsigned i;
+
+  CHECK(trace_is_thawed(self));
+  nusmv_assert(n_steps <= length);
+
+  if (0 == n_steps) return;
+
+  trace_set_eval_step(self, TRACE_END_ITER);
+
+  for (i = 0; i <= length; ++i) {
+    TraceVarFrame_ptr frame = trace_get_frame(self, i);
+
+    if (i + n_steps <= length) {
+      TraceVarFrame_ptr src = trace_get_frame(self, i + n_steps);
+
+      trace_iter_copy_var_values(self, TRACE_ITER(frame),
+                                 self, TRACE_ITER(src));
+      trace_iter_copy_define_values(self, TRACE_ITER(frame),
+                                    self, TRACE_ITER(src));
+
+      frame->loopback = src->loopback;
+    }
+    else { /* a dropped frame, its storage is released */
+      unsigned section, j;
+
+      for (j = 0; j < trace_get_n_state_vars(self); ++j) {
+        trace_column_put_value(self->state_columns + j, i, Nil);
+      }
+      for (j = 0; j < trace_get_n_input_vars(self); ++j) {
+        trace_column_put_value(self->input_columns + j, i, Nil);
+      }
+      for (section = TRACE_SECTION_STATE_DEFINE;
+           section < TRACE_SECTION_END; ++section) {
+        if (TRACE_COLUMN(NULL) == self->define_columns[section]) continue;
+
+        for (j = 0; j < trace_get_n_section_symbols(self, section); ++j) {
+          trace_column_put_value(self->define_columns[section] + j, i, Nil);
+        }
+      }
+
+      frame->loopback = false;
+    }
+  }
+
+  self->length -= n_steps;
+} /* trace_drop_first_steps */
+
 boolean
 trace_symbol_in_language (Trace_ptr self, node_ptr symb)
 {
@@ -1379,8 +1254,6 @@ trace_symbol_is_assigned (Trace_ptr self, TraceIter step, node_ptr symb)
 {
   TraceSection section;
   unsigned offset;
-  node_ptr value;
-  node_ptr *base;
   boolean hit;
 
   hit = trace_symbol_fwd_lookup(self, symb, &section, &offset);
@@ -1389,11 +1262,7 @@ trace_symbol_is_assigned (Trace_ptr self, TraceIter step, node_ptr symb)
                    __FILE__, __LINE__, __func__, sprint_node(symb));
   }
 
-  base = trace_iter_get_section_base(self, step, section, false);
-  if ((node_ptr*)(NULL) == base) return false;
-
-  value = *(base + offset);
-  return (Nil != value);
+  return (Nil != trace_iter_get_section_value(self, step, section, offset));
 }
 
 /* exported loopback predicate */
@@ -1420,18 +1289,19 @@ boolean
 trace_step_test_loopback(Trace_ptr self, const TraceIter step)
 {
   unsigned nvars = trace_get_n_state_vars(self);
+  unsigned last = trace_get_length(self);
+  unsigned i;
+
+  /* perform low level full comparison of the codes (within a trace
+     codes identify values), only state vars are relevant w.r.t.
+     loopback calculation */
+  for (i = 0; i < nvars; ++i) {
+    TraceColumn_ptr column = self->state_columns + i;
+    if (trace_column_get_code(column, step->index) !=
+        trace_column_get_code(column, last)) return false;
+  }
 
-  node_ptr* step_base ;
-  node_ptr* last_base ;
-
-  step_base = trace_var_frame_get_state_base(TRACE_VAR_FRAME(step));
-
-  last_base = \
-    trace_var_frame_get_state_base(TRACE_VAR_FRAME(trace_last_iter(self)));
-
-  /* perform low level full comparison, only state vars are relevant
-     w.r.t. loopback calculation */
-  return (0 == trace_compare_section_storage(step_base, last_base, nvars));
+  return true;
 } /* trace_step_test_loopback */
 
 void trace_step_force_loopback (const Trace_ptr self, TraceIter step)
@@ -1509,19 +1379,13 @@ boolean trace_equals(const Trace_ptr self, const Trace_ptr other)
 
   while (TRACE_END_ITER != self_step) {
 
-    if (0 != trace_compare_section_storage(
-                  trace_var_frame_get_input_base(TRACE_VAR_FRAME(self_step)),
-                  trace_var_frame_get_input_base(TRACE_VAR_FRAME(other_step)),
-                  trace_get_n_input_vars(self))) {
-
+    if (0 != trace_compare_var_values(self, self_step, other, other_step,
+                                      TRACE_SECTION_INPUT_VAR)) {
       return false;
     }
 
-    if (0 != trace_compare_section_storage(
-                  trace_var_frame_get_state_base(TRACE_VAR_FRAME(self_step)),
-                  trace_var_frame_get_state_base(TRACE_VAR_FRAME(other_step)),
-                  trace_get_n_state_vars(self))) {
-
+    if (0 != trace_compare_var_values(self, self_step, other, other_step,
+                                      TRACE_SECTION_STATE_VAR)) {
       return false;
     }
 
@@ -1574,17 +1438,33 @@ boolean  trace_step_put_value(Trace_ptr self, TraceIter step,
   SymbTable_ptr symb_table = Trace_get_symb_table(self);
 
   if (trace_symbol_fwd_lookup(self, symb, &section, &offset)) {
-    node_ptr* base;
-    node_ptr* addr;
+    TraceColumn_ptr column = TRACE_COLUMN(NULL);
+    node_ptr* addr = (node_ptr*)(NULL);
 
     /* when trace is frozen only defines are allowed */
     CHECK(section >= TRACE_SECTION_STATE_DEFINE || trace_is_thawed(self));
 
-    base = trace_iter_get_section_base(self, step, section, true);
-    CHECK((node_ptr*)(NULL) != base); /* base is non NULL */
+    if (TRACE_SECTION_FROZEN_VAR == section) {
+      node_ptr* base = trace_iter_get_section_base(self, step, section, true);
+      CHECK((node_ptr*)(NULL) != base); /* base is non NULL */
+
+      addr = base + offset;
+      CHECK(Nil == *addr || *addr == value); /* value is blank or matching */
+    }
+    else {
+      column = (section < TRACE_SECTION_STATE_DEFINE)
+        ? trace_get_column(self, section, offset)
+        : trace_get_define_column(self, section, offset, true);
+
+      /* value is blank or matching */
+      CHECK(Nil == trace_column_get_value(column, step->index) ||
+            trace_column_get_value(column, step->index) == value);
+    }
 
-    addr = base + offset;
-    CHECK(Nil == *addr || *addr == value); /* value is blank or matching */
+    /* values of defines depend on vars values */
+    if (section < TRACE_SECTION_STATE_DEFINE) {
+      trace_set_eval_step(self, TRACE_END_ITER);
+    }
 
     res = (TypeChecker_is_expression_wellformed(            \
     SymbTable_get_type_checker(trace_get_symb_table(self)), \
@@ -1602,7 +1482,10 @@ boolean  trace_step_put_value(Trace_ptr self, TraceIter step,
 #endif
 
     /* write data */
-    (*addr) = value;
+    if (TRACE_COLUMN(NULL) != column) {
+      trace_column_put_value(column, step->index, value);
+    }
+    else (*addr) = value;
   } /* lookup miss, value is ignored */
 
   return res;
@@ -1618,12 +1501,7 @@ trace_step_get_value(Trace_ptr self, TraceIter step, node_ptr symb)
   unsigned offset;
 
   if (trace_symbol_fwd_lookup(self, symb, &section, &offset)) {
-    node_ptr* base;
-
-    base = trace_iter_get_section_base(self, step, section, false);
-    if ((node_ptr*)(NULL) == base) return Nil; /* sect not allocated */
-
-    return *(base + offset);
+    return trace_iter_get_section_value(self, step, section, offset);
   }
 
   /* symbol not in language */
@@ -1632,6 +1510,49 @@ trace_step_get_value(Trace_ptr self, TraceIter step, node_ptr symb)
   return Nil;
 } /* trace_step_get_value */
 
+/* raw value of the offset-th define of the given section at the given
+   step: Nil if it has not been evaluated yet, a FAILURE node if its
+   evaluation failed. See trace_step_fetch_value */
+node_ptr
+trace_step_get_define_value(Trace_ptr self, TraceIter step,
+                            TraceSection section, unsigned offset)
+{
+  TraceColumn_ptr column = \
+    trace_get_define_column(self, section, offset, false);
+
+  CHECK(TRACE_END_ITER != step);
+  if (TRACE_COLUMN(NULL) == column) return Nil;
+
+  return trace_column_get_value(column, step->index);
+}
+
+/* stores the evaluated value of the offset-th define of the given
+   section at the given step. Being the result of an evaluation, value
+   is not type checked. A FAILURE node records a failed evaluation */
+void
+trace_step_cache_define_value(Trace_ptr self, TraceIter step,
+                              TraceSection section, unsigned offset,
+                              node_ptr value)
+{
+  CHECK(TRACE_END_ITER != step && Nil != value);
+  trace_column_put_value(trace_get_define_column(self, section, offset, true),
+                         step->index, value);
+}
+
+/* step the context of the defines evaluator is built upon, see
+   traceEval.c. TRACE_END_ITER when the context is no longer valid */
+TraceIter
+trace_get_eval_step(const Trace_ptr self)
+{
+  return self->eval_step;
+}
+
+void
+trace_set_eval_step(Trace_ptr self, TraceIter step)
+{
+  self->eval_step = step;
+}
+
 
 /* low-level storage functions */
 static inline node_ptr*
@@ -1844,281 +1765,362 @@ trace_compare_section_storage(node_ptr* dest, node_ptr* src,
   return memcmp(dest, src, n_symbs * sizeof(node_ptr));
 }
 
-/* var frames getters/setters */
-static inline void
-trace_var_frame_set_prev (TraceVarFrame_ptr frame, TraceVarFrame_ptr prev)
+/* low level addressing base getter given (trace, iter, section)
+   coordinates. Only frozen vars are stored by base, the values of
+   state and input vars and defines are stored by column */
+static inline node_ptr*
+trace_iter_get_section_base(Trace_ptr trace, TraceIter iter,
+                            TraceSection section, boolean create)
 {
-  frame->prev_frame = prev;
-}
+  if (TRACE_SECTION_FROZEN_VAR == section) {
+    CHECK( (node_ptr*) NULL !=                                          \
+           trace_frozen_frame_get_base(trace_get_frozen_frame(trace)) );
+    return trace_frozen_frame_get_base(trace_get_frozen_frame(trace));
+  }
 
-static inline TraceVarFrame_ptr
-trace_var_frame_get_prev (TraceVarFrame_ptr frame)
-{
-  return frame->prev_frame;
-}
+  internal_error("%s:%d:%s: no base for section (%d)",
+                 __FILE__, __LINE__, __func__, section);
 
-static inline void
-trace_var_frame_set_next (TraceVarFrame_ptr frame, TraceVarFrame_ptr next)
-{
-  frame->next_frame = next;
-}
+  /* unreachable */
+  error_unreachable_code();
+  return (node_ptr*) (NULL);
+} /* trace_iter_get_section_base */
 
-static inline TraceVarFrame_ptr
-trace_var_frame_get_next (TraceVarFrame_ptr frame)
+/* true iff the given section has storage at the given step */
+static inline boolean
+trace_iter_has_section(Trace_ptr trace, TraceIter iter, TraceSection section)
 {
-  return frame->next_frame;
-}
+  switch (section) {
+  case TRACE_SECTION_FROZEN_VAR:
+  case TRACE_SECTION_STATE_VAR:
+  case TRACE_SECTION_INPUT_VAR:
+    return true;
 
-static inline TraceDefineFrame_ptr
-trace_var_frame_get_fwd_define_frame(TraceVarFrame_ptr var_frame)
-{
-  return var_frame->fwd_define_frame;
+  case TRACE_SECTION_END: return false;
+
+  case TRACE_SECTION_STATE_DEFINE:
+    return TRACE_COLUMN(NULL) != trace->define_columns[section];
+
+  default: /* transitional defines have no value in the first step */
+    return TRACE_COLUMN(NULL) != trace->define_columns[section] &&
+      0 != TRACE_VAR_FRAME(iter)->index;
+  }
 }
 
-static inline TraceDefineFrame_ptr
-trace_var_frame_get_bwd_define_frame(TraceVarFrame_ptr var_frame)
+/* value of the offset-th symbol of the given section at the given
+   step, Nil if unassigned. Defines which could not be evaluated are
+   unassigned as well */
+static inline node_ptr
+trace_iter_get_section_value(Trace_ptr trace, TraceIter iter,
+                             TraceSection section, unsigned offset)
 {
-  return var_frame->bwd_define_frame;
+  TraceColumn_ptr column;
+  node_ptr res;
+
+  if (TRACE_SECTION_FROZEN_VAR == section) {
+    return *(trace_iter_get_section_base(trace, iter, section, false) + offset);
+  }
+
+  CHECK( TRACE_END_ITER != iter );
+  if (TRACE_SECTION_STATE_VAR == section ||
+      TRACE_SECTION_INPUT_VAR == section) {
+    return trace_column_get_value(trace_get_column(trace, section, offset),
+                                  TRACE_VAR_FRAME(iter)->index);
+  }
+
+  column = trace_get_define_column(trace, section, offset, false);
+  if (TRACE_COLUMN(NULL) == column) return Nil; /* sect not allocated */
+
+  res = trace_column_get_value(column, TRACE_VAR_FRAME(iter)->index);
+  return (Nil != res && FAILURE == node_get_type(res)) ? Nil : res;
 }
 
+/* copies the values of state and input vars from a step of src to a
+   step of dst. Traces must have the same language */
 static inline void
-trace_var_frame_set_fwd_define_frame(TraceVarFrame_ptr var_frame,
-                                     TraceDefineFrame_ptr def_frame)
+trace_iter_copy_var_values(Trace_ptr dst, TraceIter dst_iter,
+                           Trace_ptr src, TraceIter src_iter)
 {
-  var_frame->fwd_define_frame  = def_frame;
+  unsigned i;
+
+  for (i = 0; i < trace_get_n_state_vars(src); ++i) {
+    trace_column_put_value(dst->state_columns + i, dst_iter->index,
+         trace_column_get_value(src->state_columns + i, src_iter->index));
+  }
+
+  for (i = 0; i < trace_get_n_input_vars(src); ++i) {
+    trace_column_put_value(dst->input_columns + i, dst_iter->index,
+         trace_column_get_value(src->input_columns + i, src_iter->index));
+  }
 }
 
+/* copies the values of defines from a step of src to a step of
+   dst. Traces must have the same language. Transitional defines have
+   no value in the first step of dst */
 static inline void
-trace_var_frame_set_bwd_define_frame(TraceVarFrame_ptr var_frame,
-                                     TraceDefineFrame_ptr def_frame)
+trace_iter_copy_define_values(Trace_ptr dst, TraceIter dst_iter,
+                              Trace_ptr src, TraceIter src_iter)
 {
-  var_frame->bwd_define_frame = def_frame;
-}
+  unsigned section, i;
 
-static inline TraceVarFrame_ptr
-trace_var_frame_get_next_frame(TraceVarFrame_ptr var_frame)
-{
-  return var_frame->next_frame;
-}
+  for (section = TRACE_SECTION_STATE_DEFINE;
+       section < TRACE_SECTION_END; ++section) {
+    unsigned n = trace_get_n_section_symbols(src, section);
+    boolean blank = (TRACE_SECTION_STATE_DEFINE != section &&
+                     0 == dst_iter->index);
 
-static inline TraceVarFrame_ptr
-trace_var_frame_get_prev_frame(TraceVarFrame_ptr var_frame)
-{
-  return var_frame->prev_frame;
+    if (TRACE_COLUMN(NULL) == src->define_columns[section] &&
+        TRACE_COLUMN(NULL) == dst->define_columns[section]) continue;
+
+    for (i = 0; i < n; ++i) {
+      node_ptr value = (blank ||
+                        TRACE_COLUMN(NULL) == src->define_columns[section])
+        ? Nil
+        : trace_column_get_value(src->define_columns[section] + i,
+                                 src_iter->index);
+
+      if (Nil == value &&
+          TRACE_COLUMN(NULL) == dst->define_columns[section]) continue;
+
+      trace_column_put_value(trace_get_define_column(dst, section, i, true),
+                             dst_iter->index, value);
+    }
+  }
 }
 
-static inline void
-trace_var_frame_set_next_frame(TraceVarFrame_ptr var_frame,
-                               TraceVarFrame_ptr next_frame)
-{
-  var_frame->next_frame = next_frame;
+/* compares the values of the vars of a section (state or input) at
+   the given steps of two traces with the same language. Returns 0 iff
+   they are equal */
+static inline int
+trace_compare_var_values(Trace_ptr self, TraceIter step,
+                         Trace_ptr other, TraceIter other_step,
+                         TraceSection section)
+{
+  unsigned n = trace_get_n_section_symbols(self, section);
+  unsigned i;
+
+  for (i = 0; i < n; ++i) {
+    if (trace_column_get_value(trace_get_column(self, section, i),
+                               step->index) !=
+        trace_column_get_value(trace_get_column(other, section, i),
+                               other_step->index)) return 1;
+  }
+
+  return 0;
 }
 
-static inline void
-trace_var_frame_set_prev_frame(TraceVarFrame_ptr var_frame,
-                               TraceVarFrame_ptr prev_frame)
+/* value columns */
+static inline TraceColumn_ptr
+trace_get_column(const Trace_ptr self, TraceSection section, unsigned offset)
 {
-  var_frame->prev_frame = prev_frame;
+  CHECK(offset < trace_get_n_section_symbols(self, section));
+
+  if (TRACE_SECTION_STATE_VAR == section) return self->state_columns + offset;
+
+  CHECK(TRACE_SECTION_INPUT_VAR == section);
+  return self->input_columns + offset;
 }
 
-/* low level addressing base getter given (trace, iter, section)
-   coordinates.  If section is not found and create to true, section
-   is created on demand and base address returned (this applies to
-   define sections only). */
-static inline node_ptr*
-trace_iter_get_section_base(Trace_ptr trace, TraceIter iter,
-                            TraceSection section, boolean create)
+/* the column of the offset-th define of the given section. The
+   columns of a section are allocated on first assignment to any of
+   its defines when create is true, NULL is returned otherwise */
+static inline TraceColumn_ptr
+trace_get_define_column(Trace_ptr self, TraceSection section,
+                        unsigned offset, boolean create)
 {
-  switch (section) {
+  CHECK(TRACE_SECTION_STATE_DEFINE <= section && section < TRACE_SECTION_END);
+  CHECK(offset < trace_get_n_section_symbols(self, section));
 
-  case TRACE_SECTION_FROZEN_VAR:
-    CHECK( (node_ptr*) NULL !=                                          \
-           trace_frozen_frame_get_base(trace_get_frozen_frame(trace)) );
-    return trace_frozen_frame_get_base(trace_get_frozen_frame(trace));
+  if (TRACE_COLUMN(NULL) == self->define_columns[section]) {
+    if (!create) return TRACE_COLUMN(NULL);
 
-  case TRACE_SECTION_STATE_VAR:
-    CHECK( TRACE_END_ITER != iter );
-    CHECK( (node_ptr*) NULL !=                                          \
-           trace_var_frame_get_state_base(TRACE_VAR_FRAME(iter)) );
-    return trace_var_frame_get_state_base(TRACE_VAR_FRAME(iter));
+    self->define_columns[section] = \
+      trace_columns_create(trace_get_n_section_symbols(self, section));
+  }
 
-  case TRACE_SECTION_INPUT_VAR:
-    CHECK( TRACE_END_ITER != iter );
-    CHECK( (node_ptr*) NULL !=                                          \
-           trace_var_frame_get_input_base(TRACE_VAR_FRAME(iter)) );
-    return trace_var_frame_get_input_base(TRACE_VAR_FRAME(iter));
+  return self->define_columns[section] + offset;
+}
 
-  case TRACE_SECTION_STATE_DEFINE:
-    {
-      TraceVarFrame_ptr vframe;
-      TraceDefineFrame_ptr dframe;
-      node_ptr* res;
+static TraceColumn_ptr trace_columns_create(unsigned n_columns)
+{
+  TraceColumn_ptr res;
+  unsigned i;
 
-      vframe = TRACE_VAR_FRAME(iter);
-      CHECK (TRACE_VAR_FRAME(NULL) != vframe);
+  if (0 == n_columns) return TRACE_COLUMN(NULL);
 
-      dframe  = trace_var_frame_get_fwd_define_frame(vframe);
-      CHECK (TRACE_DEFINE_FRAME(NULL) != dframe);
+  res = ALLOC(TraceColumn, n_columns);
+  nusmv_assert(TRACE_COLUMN(NULL) != res);
+  memset(res, 0, n_columns * sizeof(TraceColumn));
 
-      res = trace_define_frame_get_state_base(dframe);
-      if ((node_ptr*)(NULL) == res && create) {
-        res =  trace_setup_section_storage(trace_get_n_state_defines(trace));
-        trace_define_frame_set_state_base(dframe, res);
-      }
+  for (i = 0; i < n_columns; ++i) {
+    res[i].width = 1;
 
-      return res;
-    }
+    /* code 0 is the unassigned value */
+    res[i].dict_capacity = TRACE_COLUMN_LINEAR_DICT;
+    res[i].dict = ALLOC(node_ptr, res[i].dict_capacity);
+    res[i].dict[0] = Nil;
+    res[i].dict_size = 1;
+  }
 
-  case TRACE_SECTION_INPUT_DEFINE:
-    {
-      TraceVarFrame_ptr vframe;
-      TraceDefineFrame_ptr dframe;
-      node_ptr* res;
+  return res;
+}
 
-      vframe = TRACE_VAR_FRAME(iter);
-      CHECK (TRACE_VAR_FRAME(NULL) != vframe);
+static void trace_columns_destroy(TraceColumn_ptr columns, unsigned n_columns)
+{
+  unsigned i, j;
 
-      dframe  = trace_var_frame_get_bwd_define_frame(vframe);
-      if (TRACE_DEFINE_FRAME(NULL) == dframe) {
-        return (node_ptr*)(NULL);
-      }
-      res = trace_define_frame_get_input_base(dframe);
-      if ((node_ptr*)(NULL) == res && create) {
-        res =  trace_setup_section_storage(trace_get_n_input_defines(trace));
-        trace_define_frame_set_input_base(dframe, res);
-      }
+  if (TRACE_COLUMN(NULL) == columns) return;
+
+  for (i = 0; i < n_columns; ++i) {
+    TraceColumn_ptr column = columns + i;
 
-      return res;
+    for (j = 0; j < column->n_chunks; ++j) {
+      if ((void*)(NULL) != column->chunks[j]) FREE(column->chunks[j]);
     }
+    if ((void**)(NULL) != column->chunks) FREE(column->chunks);
 
-  case TRACE_SECTION_STATE_INPUT_DEFINE:
-    {
-      TraceVarFrame_ptr vframe;
-      TraceDefineFrame_ptr dframe;
-      node_ptr* res;
+    if ((hash_ptr)(NULL) != column->value2code) {
+      free_assoc(column->value2code);
+    }
+    FREE(column->dict);
+  }
 
-      vframe = TRACE_VAR_FRAME(iter);
-      CHECK (TRACE_VAR_FRAME(NULL) != vframe);
+  FREE(columns);
+}
 
-      dframe  = trace_var_frame_get_bwd_define_frame(vframe);
-      if (TRACE_DEFINE_FRAME(NULL) == dframe) {
-        return (node_ptr*)(NULL);
-      }
+static inline unsigned
+trace_column_get_code(const TraceColumn_ptr self, unsigned index)
+{
+  unsigned chunk = index >> TRACE_CHUNK_BITS;
+  unsigned pos = index & (TRACE_CHUNK_SIZE - 1);
+  void* codes;
 
-      res = trace_define_frame_get_state_input_base(dframe);
-      if ((node_ptr*)(NULL) == res && create) {
-        res =  \
-          trace_setup_section_storage(trace_get_n_state_input_defines(trace));
-        trace_define_frame_set_state_input_base(dframe, res);
-      }
+  if (chunk >= self->n_chunks) return 0;
+  codes = self->chunks[chunk];
+  if ((void*)(NULL) == codes) return 0;
 
-      return res;
-    }
+  switch (self->width) {
+  case 1: return ((uint8_t*) codes)[pos];
+  case 2: return ((uint16_t*) codes)[pos];
+  default: return ((uint32_t*) codes)[pos];
+  }
+}
 
-  case TRACE_SECTION_NEXT_DEFINE:
-    {
-      TraceVarFrame_ptr vframe;
-      TraceDefineFrame_ptr dframe;
-      node_ptr* res;
+static inline node_ptr
+trace_column_get_value(const TraceColumn_ptr self, unsigned index)
+{
+  return self->dict[trace_column_get_code(self, index)];
+}
 
-      vframe = TRACE_VAR_FRAME(iter);
-      CHECK (TRACE_VAR_FRAME(NULL) != vframe);
+static void trace_column_put_value(TraceColumn_ptr self, unsigned index,
+                                   node_ptr value)
+{
+  unsigned chunk = index >> TRACE_CHUNK_BITS;
+  unsigned pos = index & (TRACE_CHUNK_SIZE - 1);
+  unsigned code = trace_column_encode(self, value);
+  void* codes;
 
-      dframe  = trace_var_frame_get_bwd_define_frame(vframe);
-      if (TRACE_DEFINE_FRAME(NULL) == dframe) {
-        return (node_ptr*)(NULL);
-      }
+  if (chunk >= self->n_chunks) {
+    unsigned i;
 
-      res = trace_define_frame_get_next_base(dframe);
-      if ((node_ptr*)(NULL) == res && create) {
-        res =  trace_setup_section_storage(trace_get_n_next_defines(trace));
-        trace_define_frame_set_next_base(dframe, res);
-      }
+    /* unassigned chunk */
+    if (0 == code) return;
 
-      return res;
-    }
+    self->chunks = REALLOC(void*, self->chunks, chunk + 1);
+    for (i = self->n_chunks; i <= chunk; ++i) self->chunks[i] = (void*)(NULL);
+    self->n_chunks = chunk + 1;
+  }
 
-  case TRACE_SECTION_STATE_NEXT_DEFINE:
-    {
-      TraceVarFrame_ptr vframe;
-      TraceDefineFrame_ptr dframe;
-      node_ptr* res;
+  codes = self->chunks[chunk];
+  if ((void*)(NULL) == codes) {
+    if (0 == code) return;
 
-      vframe = TRACE_VAR_FRAME(iter);
-      CHECK (TRACE_VAR_FRAME(NULL) != vframe);
+    codes = ALLOC(char, TRACE_CHUNK_SIZE * self->width);
+    nusmv_assert((void*)(NULL) != codes);
+    memset(codes, 0, TRACE_CHUNK_SIZE * self->width);
+    self->chunks[chunk] = codes;
+  }
 
-      dframe  = trace_var_frame_get_bwd_define_frame(vframe);
-      if (TRACE_DEFINE_FRAME(NULL) == dframe) {
-        return (node_ptr*)(NULL);
-      }
+  switch (self->width) {
+  case 1: ((uint8_t*) codes)[pos] = (uint8_t) code; break;
+  case 2: ((uint16_t*) codes)[pos] = (uint16_t) code; break;
+  default: ((uint32_t*) codes)[pos] = (uint32_t) code; break;
+  }
+}
 
-      res = trace_define_frame_get_state_next_base(dframe);
-      if ((node_ptr*)(NULL) == res && create) {
-        res =  \
-          trace_setup_section_storage(trace_get_n_state_next_defines(trace));
-        trace_define_frame_set_state_next_base(dframe, res);
-      }
+/* the code of the given value, which is added to the dictionary if
+   needed. The column is widened when the code does not fit */
+static unsigned trace_column_encode(TraceColumn_ptr self, node_ptr value)
+{
+  unsigned code;
 
-      return res;
-    }
+  if (Nil == value) return 0;
 
-  case TRACE_SECTION_INPUT_NEXT_DEFINE:
-    {
-      TraceVarFrame_ptr vframe;
-      TraceDefineFrame_ptr dframe;
-      node_ptr* res;
+  if ((hash_ptr)(NULL) != self->value2code) {
+    code = NODE_TO_INT(find_assoc(self->value2code, value));
+    if (0 != code) return code;
+  }
+  else {
+    for (code = 1; code < self->dict_size; ++code) {
+      if (self->dict[code] == value) return code;
+    }
+  }
 
-      vframe = TRACE_VAR_FRAME(iter);
-      CHECK (TRACE_VAR_FRAME(NULL) != vframe);
+  /* new value */
+  code = self->dict_size;
 
-      dframe  = trace_var_frame_get_bwd_define_frame(vframe);
-      if (TRACE_DEFINE_FRAME(NULL) == dframe) {
-        return (node_ptr*)(NULL);
-      }
+  if (self->dict_size == self->dict_capacity) {
+    self->dict_capacity *= 2;
+    self->dict = REALLOC(node_ptr, self->dict, self->dict_capacity);
+  }
+  self->dict[self->dict_size++] = value;
 
-      res = trace_define_frame_get_input_next_base(dframe);
-      if ((node_ptr*)(NULL) == res && create) {
-        res =  \
-          trace_setup_section_storage(trace_get_n_input_next_defines(trace));
-        trace_define_frame_set_input_next_base(dframe, res);
-      }
+  if ((hash_ptr)(NULL) != self->value2code) {
+    insert_assoc(self->value2code, value, NODE_FROM_INT(code));
+  }
+  else if (self->dict_size > TRACE_COLUMN_LINEAR_DICT) {
+    unsigned i;
 
-      return res;
+    self->value2code = new_assoc();
+    for (i = 1; i < self->dict_size; ++i) {
+      insert_assoc(self->value2code, self->dict[i], NODE_FROM_INT(i));
     }
+  }
 
-  case TRACE_SECTION_STATE_INPUT_NEXT_DEFINE:
-    {
-      TraceVarFrame_ptr vframe;
-      TraceDefineFrame_ptr dframe;
-      node_ptr* res;
+  if ((1 == self->width && code > UINT8_MAX) ||
+      (2 == self->width && code > UINT16_MAX)) {
+    trace_column_widen(self);
+  }
 
-      vframe = TRACE_VAR_FRAME(iter);
-      CHECK (TRACE_VAR_FRAME(NULL) != vframe);
+  return code;
+}
 
-      dframe  = trace_var_frame_get_bwd_define_frame(vframe);
-      if (TRACE_DEFINE_FRAME(NULL) == dframe) {
-        return (node_ptr*)(NULL);
-      }
+/* doubles the width of the codes of the column */
+static void trace_column_widen(TraceColumn_ptr self)
+{
+  unsigned width = 2 * self->width;
+  unsigned i, j;
 
-      res = trace_define_frame_get_state_input_next_base(dframe);
-      if ((node_ptr*)(NULL) == res && create) {
-        res =  \
-          trace_setup_section_storage(
-                                    trace_get_n_state_input_next_defines(trace));
-        trace_define_frame_set_state_input_next_base(dframe, res);
-      }
+  for (i = 0; i < self->n_chunks; ++i) {
+    void* codes = self->chunks[i];
+    void* wide;
 
-      return res;
+    if ((void*)(NULL) == codes) continue;
+
+    wide = ALLOC(char, TRACE_CHUNK_SIZE * width);
+    nusmv_assert((void*)(NULL) != wide);
+
+    for (j = 0; j < TRACE_CHUNK_SIZE; ++j) {
+      if (2 == width) ((uint16_t*) wide)[j] = ((uint8_t*) codes)[j];
+      else ((uint32_t*) wide)[j] = ((uint16_t*) codes)[j];
     }
 
-  default: internal_error("%s:%d:%s: invalid section (%d)",
-                          __FILE__, __LINE__, __func__, section);
-  } /* of switch */
+    FREE(codes);
+    self->chunks[i] = wide;
+  }
 
-  /* unreachable */
-  error_unreachable_code();
-  return (node_ptr*) (NULL);
-} /* trace_iter_get_section_base */
+  self->width = width;
+}
 
 static inline void
 trace_setup_lookup_cache(Trace_ptr self)
@@ -2360,143 +2362,6 @@ trace_frozen_frame_get_base (const TraceFrozenFrame_ptr frame)
   return frame->frozen_values;
 }
 
-/* var frame base getters/setters */
-static inline node_ptr*
-trace_var_frame_get_state_base (const TraceVarFrame_ptr frame)
-{
-  TRACE_VAR_FRAME_CHECK_INSTANCE(frame);
-  return frame->state_values;
-}
-
-static inline void
-trace_var_frame_set_state_base (const TraceVarFrame_ptr frame,
-                                node_ptr* base)
-{
-  TRACE_VAR_FRAME_CHECK_INSTANCE(frame);
-  frame->state_values = base;
-}
-
-static inline node_ptr*
-trace_var_frame_get_input_base (const TraceVarFrame_ptr frame)
-{
-  TRACE_VAR_FRAME_CHECK_INSTANCE(frame);
-  return frame->input_values;
-}
-
-static inline void
-trace_var_frame_set_input_base (const TraceVarFrame_ptr frame,
-                                node_ptr* base)
-{
-  TRACE_VAR_FRAME_CHECK_INSTANCE(frame);
-  frame->input_values = base;
-}
-
-/* defines frame base getters/setters */
-static inline node_ptr*
-trace_define_frame_get_state_base (const TraceDefineFrame_ptr frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  return frame->s_values;
-}
-
-static inline void
-trace_define_frame_set_state_base (TraceDefineFrame_ptr frame,
-                                   node_ptr* base)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  frame->s_values = base;
-}
-
-static inline node_ptr*
-trace_define_frame_get_input_base (const TraceDefineFrame_ptr frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  return frame->i_values;
-}
-
-static inline void
-trace_define_frame_set_input_base (TraceDefineFrame_ptr frame,
-                                   node_ptr* base)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  frame->i_values = base;
-}
-
-static inline node_ptr*
-trace_define_frame_get_state_input_base (const TraceDefineFrame_ptr frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  return frame->si_values;
-}
-
-static inline void
-trace_define_frame_set_state_input_base (TraceDefineFrame_ptr frame,
-                                         node_ptr* base)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  frame->si_values = base;
-}
-
-static inline node_ptr*
-trace_define_frame_get_next_base (const TraceDefineFrame_ptr frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  return frame->n_values;
-}
-
-static inline void
-trace_define_frame_set_next_base (TraceDefineFrame_ptr frame,
-                                  node_ptr* base)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  frame->n_values = base;
-}
-
-static inline node_ptr*
-trace_define_frame_get_state_next_base (const TraceDefineFrame_ptr frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  return frame->sn_values;
-}
-
-static inline void
-trace_define_frame_set_state_next_base (TraceDefineFrame_ptr frame,
-                                        node_ptr* base)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  frame->sn_values = base;
-}
-
-static inline node_ptr*
-trace_define_frame_get_input_next_base (const TraceDefineFrame_ptr frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  return frame->in_values;
-}
-
-static inline void
-trace_define_frame_set_input_next_base (TraceDefineFrame_ptr frame,
-                                        node_ptr* base)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  frame->in_values = base;
-}
-
-static inline node_ptr*
-trace_define_frame_get_state_input_next_base (const TraceDefineFrame_ptr frame)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  return frame->sin_values;
-}
-
-static inline void
-trace_define_frame_set_state_input_next_base (const TraceDefineFrame_ptr frame,
-                                              node_ptr* base)
-{
-  TRACE_DEFINE_FRAME_CHECK_INSTANCE(frame);
-  frame->sin_values = base;
-}
-
 boolean
 trace_is_complete_vars (const Trace_ptr self, const NodeList_ptr vars,
                         FILE* report_stream)
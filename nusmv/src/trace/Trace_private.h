@@ -68,7 +68,9 @@ typedef enum TraceSection_TAG {
 /*  frames */
 typedef struct TraceFrozenFrame_TAG* TraceFrozenFrame_ptr;
 typedef struct TraceVarFrame_TAG* TraceVarFrame_ptr;
-typedef struct TraceDefineFrame_TAG* TraceDefineFrame_ptr;
+
+/* value columns */
+typedef struct TraceColumn_TAG* TraceColumn_ptr;
 
 
 
@@ -89,14 +91,24 @@ typedef struct TraceDefineFrame_TAG* TraceDefineFrame_ptr;
             <dd>  Diameter of the trace. (i.e. the number of transitions)
         <dt><code>type</code>
             <dd>  Type of the trace.
-        <dt><code>first_step</code>
-            <dd>  Pointer to the first step of the doubly linked list of
-            TraceSteps.
-        <dt><code>last_node</code>
-        <dd> Pointer to the last node of the doubly linked list of
-            TraceSteps.
-        <dt><code>defines_evaluated</code>
-            <dd>  Internal index used to perform lazy evaluation of defines.
+        <dt><code>frame_chunks</code>
+            <dd>  The var frames of the steps, allocated by chunks of
+            TRACE_CHUNK_SIZE frames. The i-th step (starting from 0) is
+            frame i % TRACE_CHUNK_SIZE of chunk i / TRACE_CHUNK_SIZE,
+            so that any step is reached in constant time.
+        <dt><code>state_columns, input_columns</code>
+            <dd>  The values of state and input variables, one column
+            per variable (see TraceColumn).
+        <dt><code>define_columns</code>
+            <dd>  The values of defines, one array of columns per
+            define section, allocated on the first assignment to a
+            define of the section. Defines are evaluated lazily, on
+            first access (see trace_step_fetch_value). The value of
+            a transitional define at step i is the one taken on the
+            transition from step i-1 to step i.
+        <dt><code>eval_step</code>
+            <dd>  The step the context of the defines evaluator has
+            been built upon, TRACE_END_ITER if none.
         <dt><code>symb2index</code>
             <dd>  Symbol to index hash table for fast look-up.
     </dl>
@@ -122,9 +134,17 @@ typedef struct Trace_TAG
   NodeList_ptr sf_vars;
   NodeList_ptr i_vars;
 
-  /* first and last frame */
-  TraceVarFrame_ptr first_frame;
-  TraceVarFrame_ptr last_frame;
+  /* var frames, by chunks */
+  TraceVarFrame_ptr* frame_chunks;
+  unsigned n_frame_chunks;
+
+  /* values of state and input vars, by column */
+  TraceColumn_ptr state_columns;
+  TraceColumn_ptr input_columns;
+
+  /* values of defines, by section and column (first sections unused) */
+  TraceColumn_ptr define_columns[TRACE_SECTION_END];
+  TraceIter eval_step;
 
   /* Keep frozenvars separated */
   TraceFrozenFrame_ptr frozen_frame;
@@ -144,19 +164,11 @@ typedef struct Trace_TAG
 typedef struct TraceVarFrame_TAG
 {
   /* metadata */
-  node_ptr* state_values;
-  node_ptr* input_values;
+  Trace_ptr trace;
+  unsigned index; /* position of the step in the trace, from 0 */
 
   /* for frozen traces only */
   boolean loopback;
-
-  /* Defines frames */
-  TraceDefineFrame_ptr fwd_define_frame;
-  TraceDefineFrame_ptr bwd_define_frame;
-
-  /* doubly linked list */
-  TraceVarFrame_ptr next_frame;
-  TraceVarFrame_ptr prev_frame;
 } TraceVarFrame;
 
 typedef struct TraceFrozenFrame_TAG
@@ -165,16 +177,30 @@ typedef struct TraceFrozenFrame_TAG
   /* unsigned n_frozen_values; */
 } TraceFrozenFrame;
 
-typedef struct TraceDefineFrame_TAG
+
+/**Struct**********************************************************************
+
+  Synopsis    [The values of a variable along a trace]
+
+  Description [Values are dictionary encoded: the column stores for
+  each step the code of the value, which indexes dict. Code 0 stands
+  for an unassigned value. Codes take width bytes (1, 2 or 4), the
+  least width which fits the values met so far, and are stored by
+  chunks of TRACE_CHUNK_SIZE steps. Chunks are allocated on the first
+  assignment within them.]
+
+******************************************************************************/
+typedef struct TraceColumn_TAG
 {
-  node_ptr* s_values;
-  node_ptr* i_values;
-  node_ptr* si_values;
-  node_ptr* n_values;
-  node_ptr* sn_values;
-  node_ptr* in_values;
-  node_ptr* sin_values;
-} TraceDefineFrame;
+  node_ptr* dict;
+  unsigned dict_size;
+  unsigned dict_capacity;
+  hash_ptr value2code; /* built when dict grows beyond a few values */
+
+  unsigned width;
+  void** chunks;
+  unsigned n_chunks;
+} TraceColumn;
 
 
 /*---------------------------------------------------------------------------*/
@@ -195,18 +221,19 @@ typedef struct TraceDefineFrame_TAG
 #define TRACE_VAR_FRAME(x) \
   ((TraceVarFrame_ptr) x)
 
-#define TRACE_DEFINE_FRAME(x) \
-  ((TraceDefineFrame_ptr) x)
-
 #define TRACE_FROZEN_FRAME(x) \
   ((TraceFrozenFrame_ptr) x)
 
+#define TRACE_COLUMN(x) \
+  ((TraceColumn_ptr) x)
+
+/* number of steps in a chunk of frames or column codes (a power of 2) */
+#define TRACE_CHUNK_BITS 10
+#define TRACE_CHUNK_SIZE (1 << TRACE_CHUNK_BITS)
+
 #define TRACE_VAR_FRAME_CHECK_INSTANCE(x) \
   (nusmv_assert(TRACE_VAR_FRAME(x) != TRACE_VAR_FRAME(NULL)))
 
-#define TRACE_DEFINE_FRAME_CHECK_INSTANCE(x) \
-  (nusmv_assert(TRACE_DEFINE_FRAME(x) != TRACE_DEFINE_FRAME(NULL)))
-
 #define TRACE_FROZEN_FRAME_CHECK_INSTANCE(x) \
   (nusmv_assert(TRACE_FROZEN_FRAME(x) != TRACE_FROZEN_FRAME(NULL)))
 
@@ -234,6 +261,10 @@ EXTERN Trace_ptr
 trace_copy ARGS((Trace_ptr self, TraceIter until_here,
                  boolean is_volatile));
 
+EXTERN Trace_ptr
+trace_copy_ex ARGS((Trace_ptr self, TraceIter from_here,
+                    TraceIter until_here, boolean is_volatile));
+
 EXTERN boolean
 trace_is_volatile ARGS((const Trace_ptr self));
 
@@ -257,6 +288,9 @@ trace_symbol_bwd_lookup ARGS((Trace_ptr self, TraceSection section,
 EXTERN TraceIter
 trace_append_step ARGS((Trace_ptr self));
 
+EXTERN void
+trace_drop_first_steps ARGS((Trace_ptr self, unsigned n_steps));
+
 EXTERN boolean
 trace_step_is_loopback ARGS((const Trace_ptr self, const TraceIter step));
 
@@ -299,6 +333,21 @@ EXTERN node_ptr
 trace_step_get_value ARGS((const Trace_ptr self, const TraceIter step,
                            const node_ptr symb));
 
+EXTERN node_ptr
+trace_step_get_define_value ARGS((Trace_ptr self, TraceIter step,
+                                  TraceSection section, unsigned offset));
+
+EXTERN void
+trace_step_cache_define_value ARGS((Trace_ptr self, TraceIter step,
+                                    TraceSection section, unsigned offset,
+                                    node_ptr value));
+
+EXTERN TraceIter
+trace_get_eval_step ARGS((const Trace_ptr self));
+
+EXTERN void
+trace_set_eval_step ARGS((Trace_ptr self, TraceIter step));
+
 EXTERN boolean
 trace_is_complete_vars ARGS((const Trace_ptr self, const NodeList_ptr vars,
                              FILE* report_stream));
@@ -393,6 +442,10 @@ trace_set_desc ARGS((Trace_ptr self, const char* desc));
 EXTERN void
 trace_step_evaluate_defines ARGS((Trace_ptr self, const TraceIter step));
 
+EXTERN node_ptr
+trace_step_fetch_value ARGS((Trace_ptr self, const TraceIter step,
+                             const node_ptr symb));
+
 EXTERN boolean
 trace_step_check_defines ARGS((Trace_ptr self, const TraceIter step,
                                NodeList_ptr failures));
@@ -159,6 +159,63 @@ void BaseEvaluator_set_context(BaseEvaluator_ptr self,
 
   self->st = st;
   self->env = env;
+  self->lookup = (BaseEvaluatorLookup)(NULL);
+  self->lookup_arg = (void*)(NULL);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Initializes the evaluator in compiled mode]
+
+  Description [Like BaseEvaluator_set_context, but no environment is
+  needed: identifiers are bound to their values by calling lookup
+  (with arg) the first time they are met, so that the values of the
+  variables can be read straight from where they are stored instead
+  of being collected into an environment beforehand. Values are
+  memoized until the context is set again, the lookup must not change
+  its answers meanwhile]
+
+  SideEffects [The internal cache of the evaluator is cleared]
+
+  SeeAlso     [BaseEvaluator_set_context, BaseEvaluator_evaluate]
+
+******************************************************************************/
+void BaseEvaluator_set_compiled_context(BaseEvaluator_ptr self,
+                                        const SymbTable_ptr st,
+                                        BaseEvaluatorLookup lookup,
+                                        void* arg)
+{
+  BASE_EVALUATOR_CHECK_INSTANCE(self);
+  nusmv_assert((BaseEvaluatorLookup)(NULL) != lookup);
+
+  BaseEvaluator_set_context(self, st, (hash_ptr)(NULL));
+
+  self->lookup = lookup;
+  self->lookup_arg = arg;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Checks the current context of the evaluator]
+
+  Description [Returns true iff the evaluator is in compiled mode with
+  the given lookup function and argument, i.e. the values memoized
+  since the context was set are still available]
+
+  SideEffects []
+
+  SeeAlso     [BaseEvaluator_set_compiled_context]
+
+******************************************************************************/
+boolean BaseEvaluator_has_compiled_context(const BaseEvaluator_ptr self,
+                                           BaseEvaluatorLookup lookup,
+                                           void* arg)
+{
+  BASE_EVALUATOR_CHECK_INSTANCE(self);
+
+  return (lookup == self->lookup) && (arg == self->lookup_arg);
 }
 
 
@@ -167,14 +224,15 @@ void BaseEvaluator_set_context(BaseEvaluator_ptr self,
   Synopsis    [Evaluates given constant expression]
 
   Description [Evaluates a constant expression within context given
-  using BaseEvaluator_set_context. Returns a constant which is the
+  using BaseEvaluator_set_context or
+  BaseEvaluator_set_compiled_context. Returns a constant which is the
   result of the evaluation of the expression. A FAILURE node is
   returned if result could not be computed (e.g. no assignment for an
   identifier could be found in the environment)]
 
   SideEffects []
 
-  SeeAlso     [BaseEvaluator_set_context]
+  SeeAlso     [BaseEvaluator_set_context, BaseEvaluator_set_compiled_context]
 
 ******************************************************************************/
 Expr_ptr BaseEvaluator_evaluate(BaseEvaluator_ptr self,
@@ -182,7 +240,8 @@ Expr_ptr BaseEvaluator_evaluate(BaseEvaluator_ptr self,
 {
   BASE_EVALUATOR_CHECK_INSTANCE(self);
   SYMB_TABLE_CHECK_INSTANCE(self->st);
-  nusmv_assert((hash_ptr)(NULL) != self->env);
+  nusmv_assert((hash_ptr)(NULL) != self->env ||
+               (BaseEvaluatorLookup)(NULL) != self->lookup);
 
   return base_evaluator_eval_recur(self, const_expr, false);
 }
@@ -209,6 +268,9 @@ void base_evaluator_init(BaseEvaluator_ptr self)
 
   /* members initialization */
   self->cache = (hash_ptr)(NULL);
+  self->env = (hash_ptr)(NULL);
+  self->lookup = (BaseEvaluatorLookup)(NULL);
+  self->lookup_arg = (void*)(NULL);
 
   /* virtual methods settings */
   OVERRIDE(Object, finalize) = base_evaluator_finalize;
@@ -305,7 +367,9 @@ static Expr_ptr base_evaluator_eval_recur(BaseEvaluator_ptr self,
   case ATOM:
   case DOT:
     {
-      res = find_assoc(env, key);
+      res = ((BaseEvaluatorLookup)(NULL) != self->lookup)
+        ? self->lookup(self->lookup_arg, key)
+        : find_assoc(env, key);
       if (Nil == res) {
         const char* fail_msg = "Uknown symbol: '%s'";
         res = base_evaluator_make_failure(fail_msg, key);
@@ -59,6 +59,18 @@
 typedef struct BaseEvaluator_TAG*  BaseEvaluator_ptr;
 
 
+/**Type***********************************************************************
+
+  Synopsis    [Identifiers lookup function of the compiled mode]
+
+  Description [Returns the value of the given identifier, which may be
+  wrapped in a NEXT, or Nil if no value is available. arg is the
+  argument given to BaseEvaluator_set_compiled_context]
+
+******************************************************************************/
+typedef Expr_ptr (*BaseEvaluatorLookup) ARGS((void* arg, node_ptr symb));
+
+
 /**Macros**********************************************************************
 
   Synopsis    [To cast and check instances of class BaseEvaluator]
@@ -89,6 +101,17 @@ EXTERN void BaseEvaluator_set_context ARGS((BaseEvaluator_ptr self,
                                             const SymbTable_ptr st,
                                             const hash_ptr env));
 
+EXTERN void
+BaseEvaluator_set_compiled_context ARGS((BaseEvaluator_ptr self,
+                                         const SymbTable_ptr st,
+                                         BaseEvaluatorLookup lookup,
+                                         void* arg));
+
+EXTERN boolean
+BaseEvaluator_has_compiled_context ARGS((const BaseEvaluator_ptr self,
+                                         BaseEvaluatorLookup lookup,
+                                         void* arg));
+
 EXTERN Expr_ptr BaseEvaluator_evaluate ARGS((BaseEvaluator_ptr self,
                                              Expr_ptr const_expr));
 
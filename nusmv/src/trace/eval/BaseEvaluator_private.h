@@ -70,6 +70,10 @@ typedef struct BaseEvaluator_TAG
   hash_ptr env;
   hash_ptr cache;
 
+  /* compiled mode: identifiers are resolved by lookup */
+  BaseEvaluatorLookup lookup;
+  void* lookup_arg;
+
   /* -------------------------------------------------- */
   /*                  Virtual methods                   */
   /* -------------------------------------------------- */
@@ -45,6 +45,12 @@
 
 #include "trace/pkg_trace.h"
 #include "utils/utils.h"
+#include "utils/WordNumber.h"
+#include "enc/base/BoolEncClient.h"
+#include "enc/bool/BoolEnc.h"
+#include "compile/symb_table/SymbTable.h"
+#include "fsm/sexp/Expr.h"
+#include "parser/symbols.h"
 
 #include "opt/opt.h"
 
@@ -55,6 +61,16 @@ static char rcsid[] UTIL_UNUSED = "$Id: $";
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/**Constant********************************************************************
+
+  Synopsis    [Maximum number of memoized forward images]
+
+  Description [When the cache of forward images is full it is flushed
+  completely.]
+
+******************************************************************************/
+#define BDD_COMPLETE_TRACE_EXECUTOR_MAX_IMAGES (1 << 16)
+
 /*---------------------------------------------------------------------------*/
 /* Structure declarations                                                    */
 /*---------------------------------------------------------------------------*/
@@ -86,6 +102,46 @@ static boolean
 bdd_complete_trace_executor_execute ARGS((const CompleteTraceExecutor_ptr self,
                                           const Trace_ptr trace, int* n_steps));
 
+static bdd_ptr
+bdd_complete_trace_executor_fetch ARGS((BDDCompleteTraceExecutor_ptr self,
+                                        Trace_ptr trace, TraceIter step,
+                                        TraceIteratorType iter_type));
+
+static bdd_ptr
+bdd_complete_trace_executor_get_assignment ARGS((BDDCompleteTraceExecutor_ptr self,
+                                                 SymbTable_ptr st,
+                                                 node_ptr var, node_ptr val));
+
+static bdd_ptr
+bdd_complete_trace_executor_encode_assignment ARGS((BDDCompleteTraceExecutor_ptr self,
+                                                    SymbTable_ptr st,
+                                                    node_ptr var, node_ptr val));
+
+static boolean
+bdd_complete_trace_executor_encode_path ARGS((BDDCompleteTraceExecutor_ptr self,
+                                              node_ptr enc, node_ptr val,
+                                              bdd_ptr* cube));
+
+static bdd_ptr
+bdd_complete_trace_executor_literal ARGS((BDDCompleteTraceExecutor_ptr self,
+                                          node_ptr bit, boolean value));
+
+static BddStates
+bdd_complete_trace_executor_get_image ARGS((BDDCompleteTraceExecutor_ptr self,
+                                            BddStates from_state,
+                                            BddStatesInputsNexts constraints));
+
+static void
+bdd_complete_trace_executor_flush_images ARGS((BDDCompleteTraceExecutor_ptr self));
+
+static enum st_retval
+bdd_complete_trace_executor_free_image ARGS((char* key, char* data,
+                                             char* arg));
+
+static enum st_retval
+bdd_complete_trace_executor_free_assignment ARGS((char* key, char* data,
+                                                  char* arg));
+
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -131,6 +187,89 @@ void BDDCompleteTraceExecutor_destroy(BDDCompleteTraceExecutor_ptr self)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis           [Executes a single step of a trace using BDDs]
+
+  Description        [If is_initial is true the state of the given step
+  is tested for being an initial state of the fsm, otherwise the
+  transition from the state of the previous step of the trace to the
+  state of the given step is tested for compatibility with the model,
+  under the inputs and combinatorials of the given step. This allows
+  traces to be executed piecewise, e.g. while they are read from a
+  file. The state and input variables of the involved steps must all be
+  assigned.
+
+  Returns true iff the step is compatible with the model.]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+boolean
+BDDCompleteTraceExecutor_execute_step(const BDDCompleteTraceExecutor_ptr self,
+                                      const Trace_ptr trace,
+                                      const TraceIter step,
+                                      boolean is_initial)
+{
+  DdManager* dd;
+  BddStates trace_state;
+  boolean res;
+
+  BDD_COMPLETE_TRACE_EXECUTOR_CHECK_INSTANCE(self);
+  TRACE_CHECK_INSTANCE(trace);
+  nusmv_assert(TRACE_END_ITER != step);
+
+  dd = BddEnc_get_dd_manager(self->enc);
+
+  trace_state = bdd_complete_trace_executor_fetch(self, trace, step,
+                                                  TRACE_ITER_SF_SYMBOLS);
+
+  if (is_initial) {
+    bdd_ptr init_bdd = BddFsm_get_init(self->fsm);
+    bdd_ptr invar_bdd = BddFsm_get_state_constraints(self->fsm);
+
+    bdd_and_accumulate(dd, &init_bdd, invar_bdd);
+    res = bdd_entailed(dd, trace_state, init_bdd);
+
+    bdd_free(dd, invar_bdd);
+    bdd_free(dd, init_bdd);
+  }
+  else {
+    TraceIter prev = TraceIter_get_prev(step);
+    BddStates from_state;
+    BddStatesInputsNexts constraints;
+    BddStatesInputsNexts next_combo;
+    BddStates forward_states;
+
+    nusmv_assert(TRACE_END_ITER != prev);
+
+    from_state = bdd_complete_trace_executor_fetch(self, trace, prev,
+                                                   TRACE_ITER_SF_SYMBOLS);
+    constraints = bdd_complete_trace_executor_fetch(self, trace, step,
+                                                    TRACE_ITER_I_SYMBOLS);
+    next_combo = bdd_complete_trace_executor_fetch(self, trace, step,
+                                                   TRACE_ITER_COMBINATORIAL);
+    bdd_and_accumulate(dd, &constraints, next_combo);
+
+    forward_states =
+      bdd_complete_trace_executor_get_image(self, from_state, constraints);
+
+    /* test whether the constrained image entails the next state */
+    res = bdd_entailed(dd, trace_state, forward_states);
+
+    bdd_free(dd, forward_states);
+    bdd_free(dd, next_combo);
+    bdd_free(dd, constraints);
+    bdd_free(dd, from_state);
+  }
+
+  bdd_free(dd, trace_state);
+  return res;
+}
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -155,6 +294,9 @@ void bdd_complete_trace_executor_init(BDDCompleteTraceExecutor_ptr self,
   /* members initialization */
   self->fsm = fsm;
   self->enc = enc;
+  self->assignments = new_assoc();
+  self->images = new_assoc();
+  self->images_count = 0;
 
   /* virtual methods settings */
   OVERRIDE(Object, finalize) = bdd_complete_trace_executor_finalize;
@@ -178,6 +320,13 @@ void bdd_complete_trace_executor_init(BDDCompleteTraceExecutor_ptr self,
 void bdd_complete_trace_executor_deinit(BDDCompleteTraceExecutor_ptr self)
 {
   /* members deinitialization */
+  bdd_complete_trace_executor_flush_images(self);
+  free_assoc(self->images);
+
+  clear_assoc_and_free_entries_arg(self->assignments,
+                                   bdd_complete_trace_executor_free_assignment,
+                                   (char*) BddEnc_get_dd_manager(self->enc));
+  free_assoc(self->assignments);
 
   /* base class deinitialization */
   complete_trace_executor_deinit(COMPLETE_TRACE_EXECUTOR(self));
@@ -261,8 +410,8 @@ bdd_complete_trace_executor_execute(const CompleteTraceExecutor_ptr complete_exe
 
   /* the set of initial states for the trace consists of just one
      state under the assumption that the trace is complete */
-  trace_state = TraceUtils_fetch_as_bdd(trace, step,
-                                        TRACE_ITER_SF_SYMBOLS, self->enc);
+  trace_state = bdd_complete_trace_executor_fetch(self, trace, step,
+                                                  TRACE_ITER_SF_SYMBOLS);
 
   /* 1- Check Start State */
   {
@@ -293,15 +442,15 @@ bdd_complete_trace_executor_execute(const CompleteTraceExecutor_ptr complete_exe
 
           /* fetch next bdds from trace */
           next_input = \
-            TraceUtils_fetch_as_bdd(trace, step,
-                                    TRACE_ITER_I_SYMBOLS, self->enc);
+            bdd_complete_trace_executor_fetch(self, trace, step,
+                                              TRACE_ITER_I_SYMBOLS);
 
           next_combo =  \
-            TraceUtils_fetch_as_bdd(trace, step, TRACE_ITER_COMBINATORIAL,
-                                    self->enc);
+            bdd_complete_trace_executor_fetch(self, trace, step,
+                                              TRACE_ITER_COMBINATORIAL);
           next_state = \
-            TraceUtils_fetch_as_bdd(trace, step, TRACE_ITER_SF_SYMBOLS,
-                                    self->enc);
+            bdd_complete_trace_executor_fetch(self, trace, step,
+                                              TRACE_ITER_SF_SYMBOLS);
 
           if (0 < BaseTraceExecutor_get_verbosity(executor)) {
             fprintf(BaseTraceExecutor_get_output_stream(executor),
@@ -314,8 +463,8 @@ bdd_complete_trace_executor_execute(const CompleteTraceExecutor_ptr complete_exe
             bdd_and_accumulate(dd, &constraints, next_combo);
 
             forward_states =
-              BddFsm_get_sins_constrained_forward_image(self->fsm, from_state,
-                                                        constraints);
+              bdd_complete_trace_executor_get_image(self, from_state,
+                                                    constraints);
             bdd_free(dd, constraints);
           }
 
@@ -392,5 +541,318 @@ bdd_complete_trace_executor_execute(const CompleteTraceExecutor_ptr complete_exe
   }
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Builds the bdd of the assignments in (trace, step) to a
+  set of symbols]
+
+  Description [Same as TraceUtils_fetch_as_bdd, but the bdd of every
+  assignment is taken from the cache of self, where it is built
+  directly from the boolean encoding of the variable. Returned bdd is
+  referenced.]
+
+  SideEffects [The cache of assignments is updated]
+
+  SeeAlso     [TraceUtils_fetch_as_bdd]
+
+******************************************************************************/
+static bdd_ptr
+bdd_complete_trace_executor_fetch(BDDCompleteTraceExecutor_ptr self,
+                                  Trace_ptr trace, TraceIter step,
+                                  TraceIteratorType iter_type)
+{
+  DdManager* dd = BddEnc_get_dd_manager(self->enc);
+  SymbTable_ptr st = Trace_get_symb_table(trace);
+  TraceStepIter iter;
+  node_ptr var, val;
+
+  bdd_ptr res = bdd_true(dd);
+  TRACE_STEP_FOREACH(trace, step, iter_type, iter, var, val) {
+    bdd_and_accumulate(dd, &res,
+       bdd_complete_trace_executor_get_assignment(self, st, var, val));
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the bdd of the assignment var := val]
+
+  Description [Variables are encoded bit by bit without building and
+  evaluating any expression. Defines, and variables with no boolean
+  encoding, are evaluated by the encoder instead. Returned bdd belongs
+  to the cache of self and must not be freed.]
+
+  SideEffects [The cache of assignments is updated]
+
+  SeeAlso     []
+
+******************************************************************************/
+static bdd_ptr
+bdd_complete_trace_executor_get_assignment(BDDCompleteTraceExecutor_ptr self,
+                                           SymbTable_ptr st,
+                                           node_ptr var, node_ptr val)
+{
+  node_ptr key = find_node(EQUAL, var, val);
+  bdd_ptr res = (bdd_ptr) find_assoc(self->assignments, key);
+
+  if ((bdd_ptr) NULL != res) return res; /* hit */
+
+  if (SymbTable_is_symbol_var(st, var)) {
+    res = bdd_complete_trace_executor_encode_assignment(self, st, var, val);
+  }
+
+  if ((bdd_ptr) NULL == res) {
+    res = BddEnc_expr_to_bdd(self->enc, Expr_equal(var, val, st), Nil);
+  }
+
+  insert_assoc(self->assignments, key, (node_ptr) res);
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Builds the bdd of var := val from the boolean encoding
+  of var]
+
+  Description [Boolean, enumerative and word variables are
+  supported. NULL is returned for any other variable, or if val cannot
+  be found in the encoding. Returned bdd is referenced.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static bdd_ptr
+bdd_complete_trace_executor_encode_assignment(BDDCompleteTraceExecutor_ptr self,
+                                              SymbTable_ptr st,
+                                              node_ptr var, node_ptr val)
+{
+  DdManager* dd = BddEnc_get_dd_manager(self->enc);
+  BoolEnc_ptr bool_enc = BoolEncClient_get_bool_enc(BOOL_ENC_CLIENT(self->enc));
+  SymbType_ptr type = SymbTable_get_var_type(st, var);
+  bdd_ptr res = (bdd_ptr) NULL;
+
+  if (SymbType_is_boolean(type)) {
+    if (TRUEEXP == node_get_type(val) || FALSEEXP == node_get_type(val)) {
+      res = bdd_complete_trace_executor_literal(self, var,
+                                                TRUEEXP == node_get_type(val));
+    }
+  }
+  else if (SymbType_is_enum(type)) {
+    res = bdd_true(dd);
+    if (!bdd_complete_trace_executor_encode_path(self,
+                          BoolEnc_get_var_encoding(bool_enc, var), val, &res)) {
+      bdd_free(dd, res);
+      res = (bdd_ptr) NULL;
+    }
+  }
+  else if (SymbType_is_word(type) &&
+           (NUMBER_UNSIGNED_WORD == node_get_type(val) ||
+            NUMBER_SIGNED_WORD == node_get_type(val))) {
+    WordNumber_ptr word = WORD_NUMBER(car(val));
+    node_ptr enc = BoolEnc_get_var_encoding(bool_enc, var);
+    int bit = WordNumber_get_width(word) - 1;
+    node_ptr iter;
+
+    nusmv_assert(UNSIGNED_WORD == node_get_type(enc));
+
+    /* bits are listed from the highest one */
+    res = bdd_true(dd);
+    for (iter = car(enc); Nil != iter; iter = cdr(iter), --bit) {
+      bdd_ptr literal =
+        bdd_complete_trace_executor_literal(self, car(iter),
+                                            WordNumber_get_bit(word, bit));
+      bdd_and_accumulate(dd, &res, literal);
+      bdd_free(dd, literal);
+    }
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Searches val among the leaves of the given encoding]
+
+  Description [If val is found, the literals of the bits along the
+  path leading to it are conjoined to *cube and true is
+  returned. Bits which are not on the path are left unconstrained, as
+  in the evaluation of var = val.]
+
+  SideEffects [*cube is updated]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean
+bdd_complete_trace_executor_encode_path(BDDCompleteTraceExecutor_ptr self,
+                                        node_ptr enc, node_ptr val,
+                                        bdd_ptr* cube)
+{
+  DdManager* dd = BddEnc_get_dd_manager(self->enc);
+  boolean branch;
+
+  if (IFTHENELSE != node_get_type(enc)) return enc == val;
+
+  if (bdd_complete_trace_executor_encode_path(self, cdar(enc), val, cube)) {
+    branch = true; /* 'then' */
+  }
+  else if (bdd_complete_trace_executor_encode_path(self, cdr(enc), val,
+                                                   cube)) {
+    branch = false; /* 'else' */
+  }
+  else return false;
+
+  {
+    bdd_ptr literal =
+      bdd_complete_trace_executor_literal(self, caar(enc), branch);
+    bdd_and_accumulate(dd, cube, literal);
+    bdd_free(dd, literal);
+  }
+
+  return true;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the bdd of the given bit, or of its negation]
+
+  Description [Returned bdd is referenced]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static bdd_ptr
+bdd_complete_trace_executor_literal(BDDCompleteTraceExecutor_ptr self,
+                                    node_ptr bit, boolean value)
+{
+  DdManager* dd = BddEnc_get_dd_manager(self->enc);
+  bdd_ptr res =
+    bdd_new_var_with_index(dd, BddEnc_get_var_index_from_name(self->enc, bit));
+
+  if (!value) {
+    bdd_ptr tmp = bdd_not(dd, res);
+    bdd_free(dd, res);
+    res = tmp;
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Computes the forward image of from_state under the given
+  constraints]
+
+  Description [Images are memoized across steps and traces, so that
+  traces sharing transitions compute them only once. Returned bdd is
+  referenced.]
+
+  SideEffects [The cache of images is updated]
+
+  SeeAlso     []
+
+******************************************************************************/
+static BddStates
+bdd_complete_trace_executor_get_image(BDDCompleteTraceExecutor_ptr self,
+                                      BddStates from_state,
+                                      BddStatesInputsNexts constraints)
+{
+  node_ptr key = find_node(CONS, (node_ptr) from_state, (node_ptr) constraints);
+  BddStates image = (BddStates) find_assoc(self->images, key);
+
+  if ((BddStates) NULL == image) {
+    if (BDD_COMPLETE_TRACE_EXECUTOR_MAX_IMAGES <= self->images_count) {
+      bdd_complete_trace_executor_flush_images(self);
+    }
+
+    image = BddFsm_get_sins_constrained_forward_image(self->fsm, from_state,
+                                                      constraints);
+
+    /* the key bdds are kept alive as long as the entry is */
+    (void) bdd_dup(from_state);
+    (void) bdd_dup(constraints);
+    insert_assoc(self->images, key, (node_ptr) image);
+    ++ self->images_count;
+  }
+
+  return bdd_dup(image);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Empties the cache of images]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void
+bdd_complete_trace_executor_flush_images(BDDCompleteTraceExecutor_ptr self)
+{
+  clear_assoc_and_free_entries_arg(self->images,
+                                   bdd_complete_trace_executor_free_image,
+                                   (char*) BddEnc_get_dd_manager(self->enc));
+  self->images_count = 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Frees an entry of the cache of images]
+
+  Description [arg is the dd manager]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static enum st_retval
+bdd_complete_trace_executor_free_image(char* key, char* data, char* arg)
+{
+  DdManager* dd = (DdManager*) arg;
+
+  bdd_free(dd, (bdd_ptr) car((node_ptr) key));
+  bdd_free(dd, (bdd_ptr) cdr((node_ptr) key));
+  bdd_free(dd, (bdd_ptr) data);
+
+  return ST_DELETE;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Frees an entry of the cache of assignments]
+
+  Description [arg is the dd manager]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static enum st_retval
+bdd_complete_trace_executor_free_assignment(char* key, char* data, char* arg)
+{
+  bdd_free((DdManager*) arg, (bdd_ptr) data);
+
+  return ST_DELETE;
+}
+
 /**AutomaticEnd***************************************************************/
 
@@ -88,6 +88,12 @@ EXTERN BDDCompleteTraceExecutor_ptr
 BDDCompleteTraceExecutor_create ARGS((const BddFsm_ptr fsm,
                                       const BddEnc_ptr enc));
 
+EXTERN boolean
+BDDCompleteTraceExecutor_execute_step ARGS((const BDDCompleteTraceExecutor_ptr self,
+                                            const Trace_ptr trace,
+                                            const TraceIter step,
+                                            boolean is_initial));
+
 /**AutomaticEnd***************************************************************/
 
 
@@ -49,6 +49,7 @@
 #include "CompleteTraceExecutor.h" /* fix this */
 #include "CompleteTraceExecutor_private.h" /* fix this */
 #include "utils/utils.h"
+#include "utils/assoc.h"
 
 
 /**Struct**********************************************************************
@@ -72,6 +73,15 @@ typedef struct BDDCompleteTraceExecutor_TAG
   BddFsm_ptr fsm;
   BddEnc_ptr enc;
 
+  /* (var, value) -> bdd of the assignment, built from the encoding */
+  hash_ptr assignments;
+
+  /* (state, constraints) -> constrained forward image. Shared by all
+     the traces executed with this instance, it is bounded by
+     BDD_COMPLETE_TRACE_EXECUTOR_MAX_IMAGES entries */
+  hash_ptr images;
+  int images_count;
+
   /* -------------------------------------------------- */
   /*                  Virtual methods                   */
   /* -------------------------------------------------- */
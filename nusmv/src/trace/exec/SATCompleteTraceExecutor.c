@@ -483,8 +483,8 @@ bmc_add_be_into_solver_positively(SatSolver_ptr solver, SatSolverGroup group,
   Be_Cnf_ptr cnf;
 
   /* We force inclusion of the conjunct set to guarantee soundness */
-  cnf = Be_ConvertToCnf(be_mgr, Bmc_Utils_apply_inlining4inc(be_mgr, prob), 1);
-  SatSolver_add(solver, cnf, group);
+  cnf = SatSolver_add_be(solver, be_mgr,
+                         Bmc_Utils_apply_inlining4inc(be_mgr, prob), 1, group);
   SatSolver_set_polarity(solver, cnf, 1, group);
 
   Be_Cnf_Delete(cnf);
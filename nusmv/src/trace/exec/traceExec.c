@@ -39,6 +39,10 @@
   To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
 
 ******************************************************************************/
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
 #include "pkg_trace.h"
 #include "pkg_traceInt.h"
 
@@ -48,15 +52,67 @@
 #include "bmc/bmc.h"
 #include "Trace.h"
 #include "traceExec.h"
+#include "BaseTraceExecutor.h"
+#include "utils/utils.h"
+#include "utils/WorkerPool.h"
 
 static char rcsid[] UTIL_UNUSED = "$Id: traceExec.c,v 1.1.2.28 2010-02-12 16:25:47 nusmv Exp $";
 
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [The answer a worker sends for each executed trace]
+
+  Description [The answer is followed by the text the execution wrote
+  on the output and on the error streams.]
+
+******************************************************************************/
+typedef struct TraceExecAnswer_TAG {
+  int index;
+  int result;
+  long time;
+  long out_size;
+  long err_size;
+} TraceExecAnswer;
+
+/**Struct**********************************************************************
+
+  Synopsis    [What the workers are given]
+
+  Description [Worker w executes the traces w, w + workers, ...]
+
+******************************************************************************/
+typedef struct TraceExecBatch_TAG {
+  const Trace_ptr* traces;
+  int count;
+  CompleteTraceExecutor_ptr executor;
+  int workers;
+} TraceExecBatch;
+
+
 /**AutomaticStart*************************************************************/
 
 /*---------------------------------------------------------------------------*/
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 
+static int trace_exec_timed ARGS((const Trace_ptr trace,
+                                  const CompleteTraceExecutor_ptr executor,
+                                  long* time));
+
+static void trace_exec_print_time ARGS((const Trace_ptr trace,
+                                        const CompleteTraceExecutor_ptr executor,
+                                        long time));
+
+static int trace_exec_parallel ARGS((const Trace_ptr* traces, int count,
+                                     const CompleteTraceExecutor_ptr executor,
+                                     int jobs));
+
+static int trace_exec_worker ARGS((int first, int jobs, int fd, void* arg));
+
 /**AutomaticEnd***************************************************************/
 
 
@@ -109,6 +165,53 @@ int Trace_execute_trace(const Trace_ptr trace,
 }
 
 
+/**Function********************************************************************
+
+  Synopsis           [Complete re-execution of a batch of traces]
+
+  Description [The given traces are executed in order with the given
+  executor, and the time each execution took is reported. Execution
+  stops at the first trace which is not compatible with the model.
+
+  If jobs is greater than 1, traces are spread over that many worker
+  processes. The output of every trace is still printed in order, as
+  in a sequential execution. All the traces executed by a worker share
+  the same executor instance, and therefore its caches. Traces are
+  executed sequentially if no worker process can be started.
+
+  Returns 0 if all the traces are executed successfully, and 1
+  otherwise.]
+
+  SideEffects        [None]
+
+  SeeAlso            [Trace_execute_trace]
+
+******************************************************************************/
+int Trace_execute_traces(const Trace_ptr* traces, int count,
+                         const CompleteTraceExecutor_ptr executor, int jobs)
+{
+  int i;
+
+  COMPLETE_TRACE_EXECUTOR_CHECK_INSTANCE(executor);
+
+  if (jobs > count) jobs = count;
+  if (jobs > 1) {
+    int res = trace_exec_parallel(traces, count, executor, jobs);
+    if (res >= 0) return res;
+  }
+
+  for (i = 0; i < count; ++i) {
+    long time;
+    int res = trace_exec_timed(traces[i], executor, &time);
+
+    trace_exec_print_time(traces[i], executor, time);
+    if (0 != res) return res;
+  }
+
+  return 0;
+}
+
+
 /**Function********************************************************************
 
   Synopsis           [Partial trace re-execution and fill-in]
@@ -163,3 +266,218 @@ int Trace_execute_partial_trace(const Trace_ptr trace,
 }
 
 
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Executes a trace, measuring the time it takes]
+
+  Description [The cpu time spent, in milliseconds, is written in
+  *time. Returns the result of Trace_execute_trace.]
+
+  SideEffects []
+
+  SeeAlso     [Trace_execute_trace]
+
+******************************************************************************/
+static int trace_exec_timed(const Trace_ptr trace,
+                            const CompleteTraceExecutor_ptr executor,
+                            long* time)
+{
+  int res;
+
+  *time = util_cpu_time();
+  res = Trace_execute_trace(trace, executor);
+  *time = util_cpu_time() - *time;
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reports the execution time of a trace]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void trace_exec_print_time(const Trace_ptr trace,
+                                  const CompleteTraceExecutor_ptr executor,
+                                  long time)
+{
+  fprintf(BaseTraceExecutor_get_output_stream(BASE_TRACE_EXECUTOR(executor)),
+          "Trace %d executed in %.3f seconds.\n",
+          Trace_get_id(trace), (double) time / 1000.0);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Executes the traces with jobs worker processes]
+
+  Description [Worker w executes traces w, w + jobs, w + 2*jobs,
+  ... Answers are printed in trace order as soon as all the previous
+  ones are available. When a trace fails, or a worker terminates
+  without answering, the remaining workers are killed. Returns -1 if
+  no worker could be started, in which case nothing is executed.]
+
+  SideEffects []
+
+  SeeAlso     [Trace_execute_traces]
+
+******************************************************************************/
+static int trace_exec_parallel(const Trace_ptr* traces, int count,
+                               const CompleteTraceExecutor_ptr executor,
+                               int jobs)
+{
+  BaseTraceExecutor_ptr base = BASE_TRACE_EXECUTOR(executor);
+  FILE* out = BaseTraceExecutor_get_output_stream(base);
+  FILE* err = BaseTraceExecutor_get_error_stream(base);
+  TraceExecAnswer* answers;
+  char** outs; /* output, then errors */
+  TraceExecBatch batch;
+  WorkerPool_ptr pool;
+  int next = 0; /* next trace to be printed */
+  int res = 0;
+  int i;
+
+  batch.traces = traces;
+  batch.count = count;
+  batch.executor = executor;
+  batch.workers = jobs;
+
+  pool = WorkerPool_create(jobs, false, trace_exec_worker, &batch);
+
+  for (i = 0; i < jobs && !WorkerPool_is_running(pool, i); ++i);
+  if (i == jobs) {
+    WorkerPool_destroy(pool);
+    return -1;
+  }
+
+  answers = ALLOC(TraceExecAnswer, count);
+  outs = ALLOC(char*, count);
+  for (i = 0; i < count; ++i) {
+    answers[i].index = -1; /* not answered yet */
+    outs[i] = (char*) NULL;
+  }
+
+  while (next < count && 0 == res) {
+    TraceExecAnswer answer;
+    char* text;
+    int w;
+
+    /* the worker of the next trace to be printed has gone */
+    if (answers[next].index < 0 && !WorkerPool_is_running(pool, next % jobs)) {
+      fprintf(err, "Error: trace %d could not be executed.\n",
+              Trace_get_id(traces[next]));
+      res = 1;
+      break;
+    }
+
+    w = WorkerPool_wait_any(pool, -1);
+    if (w < 0) break;
+
+    if (!WorkerPool_receive(pool, w, &answer, sizeof(answer))) continue;
+    if (answer.index < 0 || answer.index >= count ||
+        answer.out_size < 0 || answer.err_size < 0) {
+      WorkerPool_release(pool, w);
+      continue;
+    }
+
+    text = ALLOC(char, answer.out_size + answer.err_size + 1);
+    if (!WorkerPool_receive(pool, w, text,
+                            answer.out_size + answer.err_size)) {
+      FREE(text);
+      continue;
+    }
+
+    answers[answer.index] = answer;
+    outs[answer.index] = text;
+
+    /* prints all the answers which are now in order */
+    while (next < count && answers[next].index >= 0 && 0 == res) {
+      fwrite(outs[next] + answers[next].out_size, 1,
+             answers[next].err_size, err);
+      fwrite(outs[next], 1, answers[next].out_size, out);
+      trace_exec_print_time(traces[next], executor, answers[next].time);
+      res = answers[next].result;
+      ++next;
+    }
+  }
+
+  if (next < count && 0 == res) res = 1;
+
+  WorkerPool_destroy(pool);
+
+  for (i = 0; i < count; ++i) {
+    if ((char*) NULL != outs[i]) FREE(outs[i]);
+  }
+
+  FREE(outs);
+  FREE(answers);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [The body of a worker process]
+
+  Description [Executes the traces first, first + workers, ... of the
+  batch given as arg, writing an answer for each one on fd. The output
+  of the executions is captured and sent along with the answers.
+  Returns the exit status of the worker.]
+
+  SideEffects []
+
+  SeeAlso     [trace_exec_parallel]
+
+******************************************************************************/
+static int trace_exec_worker(int first, int jobs, int fd, void* arg)
+{
+  TraceExecBatch* batch = (TraceExecBatch*) arg;
+  BaseTraceExecutor_ptr base = BASE_TRACE_EXECUTOR(batch->executor);
+  FILE* out = WorkerPool_open_capture();
+  FILE* err = WorkerPool_open_capture();
+  int i;
+
+  if (NIL(FILE) == out || NIL(FILE) == err) return 1;
+
+  /* everything the execution prints is captured */
+  BaseTraceExecutor_set_output_stream(base, out);
+  BaseTraceExecutor_set_error_stream(base, err);
+  nusmv_stdout = out;
+  nusmv_stderr = err;
+
+  for (i = first; i < batch->count; i += batch->workers) {
+    TraceExecAnswer answer;
+    char* out_text;
+    char* err_text;
+    boolean sent;
+
+    answer.index = i;
+    answer.result = trace_exec_timed(batch->traces[i], batch->executor,
+                                     &answer.time);
+
+    out_text = WorkerPool_read_capture(out, &answer.out_size);
+    err_text = WorkerPool_read_capture(err, &answer.err_size);
+
+    sent = WorkerPool_write_exactly(fd, &answer, sizeof(answer)) &&
+      WorkerPool_write_exactly(fd, out_text, answer.out_size) &&
+      WorkerPool_write_exactly(fd, err_text, answer.err_size);
+
+    FREE(err_text);
+    FREE(out_text);
+
+    if (!sent || 0 != answer.result) break;
+  }
+
+  return 0;
+}
@@ -0,0 +1,491 @@
+/**CFile***********************************************************************
+
+  FileName    [TraceBinaryLoader.c]
+
+  PackageName [trace.loaders]
+
+  Synopsis    [Routines related to TraceBinaryLoader class]
+
+  Description [ This file contains the definition of TraceBinaryLoader
+  class, that reads back the traces written by the TraceBinaryDumper
+  plugin.
+
+  Every distinct value is parsed only once, when it is first met in
+  the file, and symbols are looked up by name, so that loading a trace
+  costs about the same as building it.]
+
+  SeeAlso     [TraceBinary.h, TraceBinaryDumper]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``trace.loaders'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "utils/defs.h"
+
+#include "TraceBinaryLoader.h"
+#include "TraceBinaryLoader_private.h"
+#include "Trace_private.h"
+#include "TraceBinary.h"
+
+#include "parser/parser.h"
+#include "parser/symbols.h"
+#include "fsm/sexp/Expr.h"
+#include "utils/ustring.h"
+
+#include <stdio.h>
+
+static char rcsid[] UTIL_UNUSED = "$Id: $";
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void trace_binary_loader_finalize ARGS((Object_ptr object,
+                                               void* dummy));
+
+static Trace_ptr trace_binary_loader_read ARGS((TraceBinaryLoader_ptr self,
+                                                FILE* stream,
+                                                const SymbTable_ptr st,
+                                                const NodeList_ptr symbols));
+
+static boolean
+trace_binary_loader_read_symbols ARGS((TraceBinaryLoader_ptr self,
+                                       FILE* stream, Trace_ptr trace,
+                                       node_ptr** symbs,
+                                       unsigned long* n_symbs));
+
+static boolean
+trace_binary_loader_read_value ARGS((TraceBinaryLoader_ptr self,
+                                     FILE* stream, const SymbTable_ptr st,
+                                     array_t* values, node_ptr* value));
+
+/*---------------------------------------------------------------------------*/
+/* Definition of external functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Constructor]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+TraceBinaryLoader_ptr TraceBinaryLoader_create(const char* filename,
+                                           boolean halt_on_undefined_symbols)
+{
+  TraceBinaryLoader_ptr self = ALLOC(TraceBinaryLoader, 1);
+
+  TRACE_BINARY_LOADER_CHECK_INSTANCE(self);
+
+  trace_binary_loader_init(self, filename, halt_on_undefined_symbols);
+  return self;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/*     Protected Methods                                                  */
+/* ---------------------------------------------------------------------- */
+
+/**Function********************************************************************
+
+  Synopsis    [Initializes the loader]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void trace_binary_loader_init(TraceBinaryLoader_ptr self,
+                              const char* filename,
+                              boolean halt_on_undefined_symbols)
+{
+  trace_loader_init(TRACE_LOADER(self), "TRACE BINARY LOADER");
+
+  self->filename = util_strsav((char*) filename);
+  self->halt_on_undefined_symbols = halt_on_undefined_symbols;
+
+  /* virtual methods overriding: */
+  OVERRIDE(Object, finalize) = trace_binary_loader_finalize;
+  OVERRIDE(TraceLoader, load) = trace_binary_loader_load;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Deallocates internal structures]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void trace_binary_loader_deinit(TraceBinaryLoader_ptr self)
+{
+  FREE(self->filename);
+
+  trace_loader_deinit(TRACE_LOADER(self));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Read the trace from the binary file]
+
+  Description [Returns a valid frozen trace, or NULL if the file could
+  not be read]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+Trace_ptr trace_binary_loader_load(TraceLoader_ptr loader,
+                                   const SymbTable_ptr st,
+                                   const NodeList_ptr symbols)
+{
+  const TraceBinaryLoader_ptr self = TRACE_BINARY_LOADER(loader);
+  Trace_ptr res = TRACE(NULL);
+  FILE* stream;
+
+  stream = fopen(self->filename, "rb");
+  if (NIL(FILE) == stream) {
+    fprintf(loader->err, "Unable to open file '%s'\n", self->filename);
+    return TRACE(NULL);
+  }
+
+  CATCH {
+    res = trace_binary_loader_read(self, stream, st, symbols);
+  }
+  /* catch any error silently */
+  FAIL { res = TRACE(NULL); }
+
+  fclose(stream);
+
+  /* traces produced by the binary trace loader are frozen */
+  nusmv_assert(TRACE(NULL) == res || trace_is_frozen(res));
+
+  return res;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/*     Private Methods                                                    */
+/* ---------------------------------------------------------------------- */
+
+/**Function********************************************************************
+
+  Synopsis    [Virtual destructor]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void trace_binary_loader_finalize(Object_ptr object, void* dummy)
+{
+  TraceBinaryLoader_ptr self = TRACE_BINARY_LOADER(object);
+
+  trace_binary_loader_deinit(self);
+  FREE(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the trace from the given stream]
+
+  Description [Values are accumulated step after step as the file
+  only holds the changed ones, and all the known values are put in
+  each step. Returns NULL if the file is not a valid binary trace.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static Trace_ptr trace_binary_loader_read(TraceBinaryLoader_ptr self,
+                                          FILE* stream,
+                                          const SymbTable_ptr st,
+                                          const NodeList_ptr symbols)
+{
+  const TraceLoader_ptr loader = TRACE_LOADER(self);
+  Trace_ptr trace = TRACE(NULL);
+  NodeList_ptr loopbacks = NODE_LIST(NULL);
+  array_t* values = (array_t*)(NULL);
+  node_ptr* symbs = (node_ptr*)(NULL);
+  node_ptr* curr = (node_ptr*)(NULL);
+  boolean* frozen = (boolean*)(NULL);
+  unsigned long type, n_symbs, n_steps, i, k;
+  char* desc;
+  boolean ok = false;
+
+  if (!TraceBinary_read_header(stream)) {
+    fprintf(loader->err, "File '%s' is not a binary trace of version %d\n",
+            self->filename, TRACE_BINARY_VERSION);
+    return TRACE(NULL);
+  }
+
+  if (!TraceBinary_read_uint(stream, &type) || TRACE_TYPE_END < type) {
+    goto leave;
+  }
+
+  desc = TraceBinary_read_string(stream);
+  if (NIL(char) == desc) goto leave;
+
+  /* creates a new trace, and prepares internal structures */
+  trace = trace_create(st, desc, ((TraceType) type) - 1, symbols, false);
+  FREE(desc);
+
+  if (!trace_binary_loader_read_symbols(self, stream, trace,
+                                        &symbs, &n_symbs)) goto leave;
+
+  curr = ALLOC(node_ptr, n_symbs + 1);
+  frozen = ALLOC(boolean, n_symbs + 1);
+  nusmv_assert((node_ptr*)(NULL) != curr && (boolean*)(NULL) != frozen);
+
+  for (i = 0; i < n_symbs; ++ i) {
+    curr[i] = Nil;
+    frozen[i] = (Nil != symbs[i]) &&
+      (SYMBOL_FROZEN_VAR == trace_symbol_get_category(trace, symbs[i]));
+  }
+
+  values = array_alloc(node_ptr, 16);
+  loopbacks = NodeList_create();
+
+  if (!TraceBinary_read_uint(stream, &n_steps) || 0 == n_steps) goto leave;
+
+  for (k = 0; k < n_steps; ++ k) {
+    TraceIter step = (0 == k)
+      ? trace_first_iter(trace) : trace_append_step(trace);
+    unsigned long header, n_changed, j;
+    long idx = -1;
+
+    if (!TraceBinary_read_uint(stream, &header)) goto leave;
+
+    if (header & 1) NodeList_append(loopbacks, NODE_FROM_INT(k + 1));
+
+    n_changed = header >> 1;
+    for (j = 0; j < n_changed; ++ j) {
+      unsigned long gap;
+
+      if (!TraceBinary_read_uint(stream, &gap)) goto leave;
+
+      idx += gap + 1;
+      if (idx >= (long) n_symbs) goto leave;
+
+      if (!trace_binary_loader_read_value(self, stream, st, values,
+                                          &curr[idx])) goto leave;
+    }
+
+    for (i = 0; i < n_symbs; ++ i) {
+      /* frozen variables are assigned once for all the steps */
+      if (Nil == symbs[i] || Nil == curr[i] || (frozen[i] && 0 < k)) {
+        continue;
+      }
+
+      if (!trace_step_put_value(trace, step, symbs[i], curr[i])) {
+        fprintf(loader->err, "At step %lu: invalid value '", k + 1);
+        print_node(loader->err, curr[i]);
+        fprintf(loader->err, "' for symbol '");
+        print_node(loader->err, symbs[i]);
+        fprintf(loader->err, "'\n");
+        goto leave;
+      }
+    }
+  }
+
+  { /* store loopback information into the new trace and freeze it */
+    ListIter_ptr liter;
+
+    Trace_freeze(trace); /* loopbacks can be added only to frozen traces */
+    NODE_LIST_FOREACH(loopbacks, liter) {
+      TraceIter loop_iter = trace_ith_iter(trace,
+                         NODE_TO_INT(NodeList_get_elem_at(loopbacks, liter)));
+
+      Trace_step_force_loopback(trace, loop_iter);
+    }
+  }
+
+  ok = true;
+
+ leave:
+  if (!ok) {
+    fprintf(loader->err, "File '%s' is not a valid binary trace\n",
+            self->filename);
+    if (TRACE(NULL) != trace) { trace_destroy(trace); trace = TRACE(NULL); }
+  }
+
+  if (NODE_LIST(NULL) != loopbacks) NodeList_destroy(loopbacks);
+  if ((array_t*)(NULL) != values) array_free(values);
+  if ((boolean*)(NULL) != frozen) FREE(frozen);
+  if ((node_ptr*)(NULL) != curr) FREE(curr);
+  if ((node_ptr*)(NULL) != symbs) FREE(symbs);
+
+  return trace;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the symbols table]
+
+  Description [Symbols are given by name, and are looked up among the
+  variables of the trace language. Symbols that are not found are
+  reported and mapped to Nil, and make loading fail if undefined
+  symbols are not allowed.]
+
+  SideEffects [The symbols are returned in the newly allocated array
+  symbs, that must be freed by the caller, of size n_symbs]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean
+trace_binary_loader_read_symbols(TraceBinaryLoader_ptr self,
+                                 FILE* stream, Trace_ptr trace,
+                                 node_ptr** symbs, unsigned long* n_symbs)
+{
+  const TraceLoader_ptr loader = TRACE_LOADER(self);
+  TraceSymbolsIter sym_iter;
+  hash_ptr by_name;
+  node_ptr symb;
+  unsigned long i;
+  boolean res = true;
+
+  *symbs = (node_ptr*)(NULL);
+  if (!TraceBinary_read_uint(stream, n_symbs)) return false;
+
+  /* variables of the language, indexed by their name */
+  by_name = new_assoc();
+  TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_ALL_VARS, sym_iter, symb) {
+    char* name = sprint_node(symb);
+    insert_assoc(by_name, NODE_PTR(find_string(name)), symb);
+    FREE(name);
+  }
+
+  *symbs = ALLOC(node_ptr, *n_symbs + 1);
+  nusmv_assert((node_ptr*)(NULL) != *symbs);
+
+  for (i = 0; i < *n_symbs; ++ i) {
+    char* name = TraceBinary_read_string(stream);
+
+    if (NIL(char) == name) { res = false; break; }
+
+    (*symbs)[i] = find_assoc(by_name, NODE_PTR(find_string(name)));
+    if (Nil == (*symbs)[i]) {
+      fprintf(loader->err, "%s: undefined symbol '%s'\n",
+              self->halt_on_undefined_symbols ? "Error" : "Warning", name);
+
+      if (self->halt_on_undefined_symbols) res = false;
+    }
+    FREE(name);
+  }
+
+  free_assoc(by_name);
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the code of a value]
+
+  Description [New values are parsed and added to the values
+  dictionary. Returns false if the code is not valid or the value
+  cannot be parsed.]
+
+  SideEffects [The read value is stored in value]
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean
+trace_binary_loader_read_value(TraceBinaryLoader_ptr self, FILE* stream,
+                               const SymbTable_ptr st, array_t* values,
+                               node_ptr* value)
+{
+  const TraceLoader_ptr loader = TRACE_LOADER(self);
+  unsigned long code;
+  node_ptr parsed;
+  char* repr;
+  char* expr;
+
+  if (!TraceBinary_read_uint(stream, &code)) return false;
+
+  if (TRACE_BINARY_NO_VALUE == code) { *value = Nil; return true; }
+
+  if (code <= (unsigned long) array_n(values)) {
+    *value = array_fetch(node_ptr, values, code - 1);
+    return true;
+  }
+
+  /* a new value must have the next code */
+  if (code != (unsigned long) array_n(values) + 1) return false;
+
+  repr = TraceBinary_read_string(stream);
+  if (NIL(char) == repr) return false;
+
+  /* sets of values are given as comma separated lists */
+  expr = ALLOC(char, strlen(repr) + 5);
+  nusmv_assert(NIL(char) != expr);
+  sprintf(expr, (NIL(char) != strchr(repr, ',')) ? "{ %s }" : "%s", repr);
+
+  *value = Nil;
+  if (0 == Parser_ReadSimpExprFromString(expr, &parsed)) {
+    /* here Compile_FlattenSexp is given no context, as values are
+       already flattened. Values are then simplified, so that
+       e.g. negative numbers are constants, as defines are evaluated
+       from variables values (the binary format holds no define) */
+    *value = Expr_simplify(st, node_normalize(
+                         Compile_FlattenSexp(st, cdar(parsed), Nil)));
+    free_node(parsed);
+  }
+  else {
+    fprintf(loader->err, "Unable to parse value '%s'\n", repr);
+  }
+
+  FREE(expr);
+  FREE(repr);
+
+  if (Nil == *value) return false;
+
+  array_insert_last(node_ptr, values, *value);
+  return true;
+}
@@ -0,0 +1,93 @@
+/**CHeaderFile*****************************************************************
+
+  FileName    [TraceBinaryLoader_private.h]
+
+  PackageName [trace.loaders]
+
+  Synopsis    [The private header file for the TraceBinaryLoader class]
+
+  Description []
+
+  SeeAlso     []
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``trace.loaders'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+#ifndef __TRACE_BINARY_LOADER_PRIVATE__H
+#define __TRACE_BINARY_LOADER_PRIVATE__H
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "pkg_traceInt.h"
+#include "TraceLoader_private.h"
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [This is the binary loader plugin class]
+
+  Description [See TraceBinary.h for a description of the format]
+
+  SeeAlso     []
+
+******************************************************************************/
+typedef struct TraceBinaryLoader_TAG
+{
+  INHERITS_FROM(TraceLoader);
+
+  char* filename;
+
+  /* If true loading halts when encounters undefined symbols */
+  boolean halt_on_undefined_symbols;
+
+} TraceBinaryLoader;
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+void trace_binary_loader_init ARGS((TraceBinaryLoader_ptr self,
+                                    const char* filename,
+                                    boolean halt_on_undefined_symbols));
+
+void trace_binary_loader_deinit ARGS((TraceBinaryLoader_ptr self));
+
+Trace_ptr trace_binary_loader_load ARGS((TraceLoader_ptr loader,
+                                         const SymbTable_ptr st,
+                                         const NodeList_ptr symbols));
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __TRACE_BINARY_LOADER_PRIVATE__H */
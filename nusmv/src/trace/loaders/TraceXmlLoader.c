@@ -123,6 +123,12 @@ trace_xml_loader_flatten_symbol ARGS((node_ptr symbol));
 
 static void trace_xml_loader_store_loopbacks ARGS((TraceXmlLoader_ptr self));
 
+static boolean trace_xml_loader_parse ARGS((TraceXmlLoader_ptr self,
+                                            FILE* stream));
+
+static boolean trace_xml_loader_visit_steps ARGS((TraceXmlLoader_ptr self,
+                                                  boolean all));
+
 /**Function********************************************************************
 
   Synopsis    [Constructor]
@@ -148,6 +154,73 @@ TraceXmlLoader_ptr TraceXmlLoader_create(const char* xml_filename,
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Reads the trace from the XML file one step at a time]
+
+  Description [The trace is parsed as by TraceLoader_load_trace, but it
+  is never stored as a whole: every step is given to the visitor as
+  soon as it is complete, together with the trace under construction,
+  and then dropped. The trace given to the visitor always contains the
+  visited step and the step preceding it (if any), so that the
+  transition leading to the step can be inspected. The memory used
+  does not depend on the length of the trace.
+
+  Loopback information found in the file is ignored. The visitor
+  returns false to stop loading.
+
+  Returns the number of visited steps, or -1 if the file could not be
+  read or parsed, or the visitor stopped loading.]
+
+  SideEffects []
+
+  SeeAlso     [TraceLoader_load_trace]
+
+******************************************************************************/
+int TraceXmlLoader_stream_trace(TraceXmlLoader_ptr self,
+                                const SymbTable_ptr st,
+                                const NodeList_ptr symbols,
+                                TraceXmlLoader_StepVisitor visitor,
+                                void* arg)
+{
+  int res = -1;
+  FILE* stream;
+
+  TRACE_XML_LOADER_CHECK_INSTANCE(self);
+  nusmv_assert(TRACE(NULL) == self->trace);
+  nusmv_assert((TraceXmlLoader_StepVisitor)(NULL) != visitor);
+
+  stream = fopen(self->xml_filename, "rt");
+  if (NIL(FILE) == stream) return -1;
+
+  trace_xml_loader_prepare(self, st, symbols);
+  self->step_visitor = visitor;
+  self->visitor_arg = arg;
+
+  CATCH {
+    /* visits the steps left in the trace */
+    if (trace_xml_loader_parse(self, stream) &&
+        trace_xml_loader_visit_steps(self, true)) {
+      res = (int) self->visited_time;
+    }
+  }
+  FAIL { res = -1; }
+
+  if (TRACE(NULL) != self->trace) {
+    trace_destroy(self->trace);
+    self->trace = TRACE(NULL);
+  }
+
+  self->step_visitor = (TraceXmlLoader_StepVisitor)(NULL);
+  self->visitor_arg = NULL;
+
+  trace_xml_loader_reset(self);
+  fclose(stream);
+
+  return res;
+}
+
+
 /* ---------------------------------------------------------------------- */
 /*   Protected Methods                                                    */
 /* ---------------------------------------------------------------------- */
@@ -193,6 +266,8 @@ void trace_xml_loader_init(TraceXmlLoader_ptr self,
   self->nusmv_input_file = NIL(char);
   self->parser = (XML_Parser)(NULL);
   self->trace = TRACE(NULL);
+  self->step_visitor = (TraceXmlLoader_StepVisitor)(NULL);
+  self->visitor_arg = NULL;
 
   /* storing data from constructor parameters */
   self->xml_filename = ALLOC(char, strlen(xml_filename) + 1);
@@ -256,48 +331,13 @@ Trace_ptr trace_xml_loader_load(TraceLoader_ptr loader,
     trace_xml_loader_prepare(self, st, symbols);
 
     CATCH {
-      /* parses the XML file */
-      do {
-        size_t len;
-        boolean ok;
-
-        /* read one chunk of data */
-        len = fread(self->stream_buf, sizeof(char), EXPAT_BUFSIZE, stream);
-
-        if (ferror(stream)) {
-          fprintf(loader->err,
-                  "I/O Error occurred while reading file '%s'\n",
-                  self->xml_filename);
-
-          trace_destroy(self->trace); self->trace = TRACE(NULL);
-          break;
-        }
-
-        /* done with I/O, launches the parser */
-        CATCH {
-          ok = (XML_Parse(self->parser, self->stream_buf, len, len == 0) \
-                && (!self->parse_error));
-        }
-        FAIL { ok = false; }
-
-        if (!ok) {
-          const char* msg = XML_ErrorString(XML_GetErrorCode(self->parser));
-
-          /* an error occurred */
-          if (msg != (const char*) NULL) {
-            fprintf(loader->err, "At line %d: '%s'\n",
-                    (int)(XML_GetCurrentLineNumber(self->parser)), msg);
-          }
-
-          trace_destroy(self->trace); self->trace = TRACE(NULL);
-          break;
-        }
-      } while (!feof(stream));
-
       /* store loopback information into the new trace and freeze it */
-      if (TRACE(NULL) != self->trace) {
+      if (trace_xml_loader_parse(self, stream)) {
         trace_xml_loader_store_loopbacks(self);
       }
+      else {
+        trace_destroy(self->trace); self->trace = TRACE(NULL);
+      }
     }
 
     /* catch any error silently */
@@ -322,6 +362,107 @@ Trace_ptr trace_xml_loader_load(TraceLoader_ptr loader,
 /* ---------------------------------------------------------------------- */
 
 
+/**Function********************************************************************
+
+  Synopsis    [Parses the XML file]
+
+  Description [Feeds the parser with the contents of stream. Returns
+  false if an I/O error or a parse error occurred.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean trace_xml_loader_parse(TraceXmlLoader_ptr self, FILE* stream)
+{
+  const TraceLoader_ptr loader = TRACE_LOADER(self);
+
+  do {
+    size_t len;
+    boolean ok;
+
+    /* read one chunk of data */
+    len = fread(self->stream_buf, sizeof(char), EXPAT_BUFSIZE, stream);
+
+    if (ferror(stream)) {
+      fprintf(loader->err,
+              "I/O Error occurred while reading file '%s'\n",
+              self->xml_filename);
+      return false;
+    }
+
+    /* done with I/O, launches the parser */
+    CATCH {
+      ok = (XML_Parse(self->parser, self->stream_buf, len, len == 0) \
+            && (!self->parse_error));
+    }
+    FAIL { ok = false; }
+
+    if (!ok) {
+      const char* msg = XML_ErrorString(XML_GetErrorCode(self->parser));
+
+      /* an error occurred */
+      if (msg != (const char*) NULL) {
+        fprintf(loader->err, "At line %d: '%s'\n",
+                (int)(XML_GetCurrentLineNumber(self->parser)), msg);
+      }
+      return false;
+    }
+  } while (!feof(stream));
+
+  return true;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Gives the complete steps to the visitor in streaming mode]
+
+  Description [A step can still receive values as long as the
+  parser has not gone past the following one (see the time adjusting
+  in trace_xml_load_put_expr), so all the steps but the last two are
+  visited, or all of them if all is true. The visited steps but the
+  last one are then dropped from the trace.
+
+  Returns false if the visitor stopped loading.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static boolean trace_xml_loader_visit_steps(TraceXmlLoader_ptr self,
+                                            boolean all)
+{
+  int limit = all
+    ? (int) (self->first_time + Trace_get_length(self->trace))
+    : (int) self->last_time - 2;
+
+  while ((int) self->visited_time < limit) {
+    unsigned time = self->visited_time + 1;
+    TraceIter step = trace_ith_iter(self->trace, 1 + time - self->first_time);
+
+    if (!self->step_visitor(self->trace, step, time, self->visitor_arg)) {
+      return false;
+    }
+    self->visited_time = time;
+  }
+
+  /* keeps the last visited step, the predecessor of the next one */
+  if (self->visited_time > self->first_time) {
+    unsigned n_steps = self->visited_time - self->first_time;
+
+    trace_drop_first_steps(self->trace, n_steps);
+    self->first_time += n_steps;
+    self->step = trace_ith_iter(self->trace,
+                                1 + self->last_time - self->first_time);
+  }
+
+  return true;
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Virtual destructor]
@@ -382,6 +523,8 @@ static void trace_xml_loader_prepare(TraceXmlLoader_ptr self,
 
   self->step = trace_first_iter(self->trace);
   self->last_time = 1; /* initial time */
+  self->first_time = 1;
+  self->visited_time = 0;
   self->requires_value = false;
   self->all_wrong_symbols = new_assoc();
   self->loopback_states = NodeList_create();
@@ -582,6 +725,12 @@ trace_xml_loader_tag_begin(TraceXmlLoader_ptr self,
       ? trace_iter_get_next(self->step)
       : trace_append_step(self->trace);
   }
+
+  /* streaming mode */
+  if (((TraceXmlLoader_StepVisitor)(NULL) != self->step_visitor) &&
+      !self->parse_error) {
+    if (!trace_xml_loader_visit_steps(self, false)) self->parse_error = true;
+  }
 } /* trace_xml_loader_tag_begin */
 
 
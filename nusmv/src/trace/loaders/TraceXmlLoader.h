@@ -51,6 +51,14 @@
 /*---------------------------------------------------------------------------*/
 typedef struct TraceXmlLoader_TAG* TraceXmlLoader_ptr;
 
+/* The visitor of the steps of a streamed trace. It receives the
+   trace under construction, one of its steps and the time of the
+   step in the XML file, and returns false to stop loading */
+typedef boolean (*TraceXmlLoader_StepVisitor) ARGS((Trace_ptr trace,
+                                                    TraceIter step,
+                                                    unsigned time,
+                                                    void* arg));
+
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -74,6 +82,13 @@ TraceXmlLoader_create ARGS((const char* xml_filename,
                             boolean halt_on_undefined_symbols,
                             boolean halt_on_wrong_section));
 
+EXTERN int
+TraceXmlLoader_stream_trace ARGS((TraceXmlLoader_ptr self,
+                                  const SymbTable_ptr st,
+                                  const NodeList_ptr symbols,
+                                  TraceXmlLoader_StepVisitor visitor,
+                                  void* arg));
+
 /**AutomaticEnd***************************************************************/
 
 #endif /* __TRACE_XML__H */
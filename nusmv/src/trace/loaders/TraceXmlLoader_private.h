@@ -111,6 +111,14 @@ typedef struct TraceXmlLoader_TAG
 
   NodeList_ptr loopback_states;
 
+  /* streaming mode: complete steps are given to step_visitor and
+     then dropped from the trace under construction, that keeps only
+     the steps from time first_time on */
+  TraceXmlLoader_StepVisitor step_visitor;
+  void* visitor_arg;
+  unsigned first_time;
+  unsigned visited_time; /* time of the last visited step */
+
   /* a hash table to remember already reported
      undeclared/wrongly-places symbols to avoid reporting them many
      times (this is meaningless if it is not an error to find such
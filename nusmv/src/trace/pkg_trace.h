@@ -97,6 +97,10 @@ TracePkg_execution_engine_from_string ARGS((const char* name));
 EXTERN int
 Trace_execute_trace ARGS((Trace_ptr trace, CompleteTraceExecutor_ptr exec_info));
 
+EXTERN int
+Trace_execute_traces ARGS((const Trace_ptr* traces, int count,
+                           CompleteTraceExecutor_ptr exec_info, int jobs));
+
 EXTERN int
 Trace_execute_partial_trace ARGS((Trace_ptr trace,
                                   PartialTraceExecutor_ptr exec_info,
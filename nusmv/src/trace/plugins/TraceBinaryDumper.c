@@ -0,0 +1,363 @@
+/**CFile***********************************************************************
+
+  FileName    [TraceBinaryDumper.c]
+
+  PackageName [trace.plugins]
+
+  Synopsis    [Routines related to TraceBinaryDumper class]
+
+  Description [ This file contains the definition of TraceBinaryDumper
+  class. The dumper writes a compact binary representation of the
+  trace, where each step only holds the variables whose value changed
+  with respect to the previous step, and values are shared through a
+  dictionary. Such a representation is typically much smaller and
+  faster to read back than the XML one.]
+
+  SeeAlso     [TraceBinary.h, TraceBinaryLoader]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``trace.plugins'' package of NuSMV version 2.
+  Copyright (C) 2011 FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#include "TraceBinaryDumper.h"
+#include "TraceBinaryDumper_private.h"
+#include "trace/Trace_private.h"
+#include "trace/TraceBinary.h"
+
+#include "compile/symb_table/SymbTable.h"
+#include "parser/symbols.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: $";
+
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void trace_binary_dumper_finalize ARGS((Object_ptr object, void* dummy));
+
+static char*
+trace_binary_dumper_value_to_string ARGS((TracePlugin_ptr self,
+                                          node_ptr value));
+
+static void
+trace_binary_dumper_write_value ARGS((TracePlugin_ptr self, node_ptr value,
+                                      hash_ptr codes, unsigned long* n_codes));
+
+/*---------------------------------------------------------------------------*/
+/* Definition of external functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Action method associated with TraceBinaryDumper class.]
+
+  Description [ Given trace is written into the file pointed by
+  given additional parameter. Only variables are written, as defines
+  can be evaluated again when the trace is read. ]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int trace_binary_dumper_action(TracePlugin_ptr self)
+{
+  const Trace_ptr trace = self->trace;
+  FILE* out = TraceOpt_output_stream(self->opt);
+  TraceSymbolsIter sym_iter;
+  TraceIter start_iter;
+  TraceIter stop_iter;
+  TraceIter step;
+  node_ptr symb;
+  node_ptr* symbols;
+  node_ptr* values;
+  unsigned* changed;
+  unsigned n_symbols, n_steps, i;
+  unsigned long n_codes;
+  hash_ptr codes;
+
+  start_iter = (0 != TraceOpt_from_here(self->opt))
+    ? trace_ith_iter(trace, TraceOpt_from_here(self->opt))
+    : trace_first_iter(trace);
+
+  /* safe way to skip one more step */
+  stop_iter =
+    (0 != TraceOpt_to_here(self->opt))
+    ? trace_ith_iter(trace, 1 + TraceOpt_to_here(self->opt))
+    : TRACE_END_ITER;
+
+  /* the symbols table: visible variables only */
+  n_symbols = 0;
+  TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_ALL_VARS, sym_iter, symb) {
+    if (trace_plugin_is_visible_symbol(self, symb)) ++ n_symbols;
+  }
+
+  symbols = ALLOC(node_ptr, n_symbols + 1);
+  values = ALLOC(node_ptr, n_symbols + 1);
+  changed = ALLOC(unsigned, n_symbols + 1);
+  nusmv_assert((node_ptr*)(NULL) != symbols &&
+               (node_ptr*)(NULL) != values && (unsigned*)(NULL) != changed);
+
+  i = 0;
+  TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_ALL_VARS, sym_iter, symb) {
+    if (trace_plugin_is_visible_symbol(self, symb)) {
+      symbols[i] = symb; values[i] = Nil; ++ i;
+    }
+  }
+
+  n_steps = 0;
+  for (step = start_iter; stop_iter != step; step = TraceIter_get_next(step)) {
+    ++ n_steps;
+  }
+
+  /* header */
+  TraceBinary_write_header(out);
+  TraceBinary_write_uint(out, (unsigned long) (Trace_get_type(trace) + 1));
+  TraceBinary_write_string(out, Trace_get_desc(trace));
+
+  TraceBinary_write_uint(out, n_symbols);
+  for (i = 0; i < n_symbols; ++ i) {
+    char* name = trace_binary_dumper_value_to_string(self, symbols[i]);
+    TraceBinary_write_string(out, name);
+    FREE(name);
+  }
+
+  /* steps, as differences from the previous one */
+  codes = new_assoc();
+  n_codes = 0;
+
+  TraceBinary_write_uint(out, n_steps);
+  for (step = start_iter; stop_iter != step; step = TraceIter_get_next(step)) {
+    unsigned n_changed = 0;
+    unsigned j;
+    int last;
+
+    for (i = 0; i < n_symbols; ++ i) {
+      node_ptr value = Trace_step_get_value(trace, step, symbols[i]);
+
+      if (value != values[i]) {
+        values[i] = value;
+        changed[n_changed ++] = i;
+      }
+    }
+
+    TraceBinary_write_uint(out, ((unsigned long) n_changed) << 1 |
+                           (Trace_step_is_loopback(trace, step) ? 1 : 0));
+
+    last = -1;
+    for (j = 0; j < n_changed; ++ j) {
+      TraceBinary_write_uint(out, changed[j] - last - 1);
+      trace_binary_dumper_write_value(self, values[changed[j]],
+                                      codes, &n_codes);
+      last = changed[j];
+    }
+  }
+
+  free_assoc(codes);
+  FREE(changed);
+  FREE(values);
+  FREE(symbols);
+
+  return 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Creates a binary Plugin for dumping and initializes it.]
+
+  Description [Binary plugin constructor. Using this plugin, a trace can
+               be dumped to file in a compact binary format]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+TraceBinaryDumper_ptr TraceBinaryDumper_create()
+{
+  TraceBinaryDumper_ptr self = ALLOC(TraceBinaryDumper, 1);
+
+  TRACE_BINARY_DUMPER_CHECK_INSTANCE(self);
+
+  trace_binary_dumper_init(self);
+  return self;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/*     Protected Methods                                                  */
+/* ---------------------------------------------------------------------- */
+
+/**Function********************************************************************
+
+  Synopsis    [Class initializer]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void trace_binary_dumper_init(TraceBinaryDumper_ptr self)
+{
+  trace_plugin_init(TRACE_PLUGIN(self),"TRACE BINARY DUMP PLUGIN");
+
+  /* virtual methods overriding: */
+  OVERRIDE(Object, finalize) = trace_binary_dumper_finalize;
+  OVERRIDE(TracePlugin, action) = trace_binary_dumper_action;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Deinitializes the TraceBinaryDumper Plugin object.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void trace_binary_dumper_deinit(TraceBinaryDumper_ptr self)
+{
+  trace_plugin_deinit(TRACE_PLUGIN(self));
+}
+
+
+
+/* ---------------------------------------------------------------------- */
+/*     Private Methods                                                    */
+/* ---------------------------------------------------------------------- */
+
+
+/**Function********************************************************************
+
+  Synopsis    [Plugin finalize method.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static void trace_binary_dumper_finalize(Object_ptr object, void* dummy)
+{
+  TraceBinaryDumper_ptr self = TRACE_BINARY_DUMPER(object);
+
+  trace_binary_dumper_deinit(self);
+  FREE(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Textual representation of a symbol or a value]
+
+  Description [Obfuscation is applied if required. The elements of a
+  set of values are separated by commas, as in the XML representation.
+  The returned string must be freed by the caller.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static char* trace_binary_dumper_value_to_string(TracePlugin_ptr self,
+                                                 node_ptr value)
+{
+  const SymbTable_ptr st = trace_get_symb_table(self->trace);
+  node_ptr elem = (UNION == node_get_type(value)) ? car(value) : value;
+  char* elem_repr;
+  char* res;
+
+  elem_repr = sprint_node((hash_ptr)(NULL) != self->obfuscation_map
+                          ? Compile_obfuscate_expression(st, elem,
+                                                   self->obfuscation_map)
+                          : elem);
+
+  if (UNION != node_get_type(value)) return elem_repr;
+
+  { /* sets are flattened into a comma separated list */
+    char* tail_repr = trace_binary_dumper_value_to_string(self, cdr(value));
+
+    res = ALLOC(char, strlen(elem_repr) + strlen(tail_repr) + 3);
+    nusmv_assert(NIL(char) != res);
+    sprintf(res, "%s, %s", elem_repr, tail_repr);
+
+    FREE(tail_repr);
+    FREE(elem_repr);
+  }
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Writes the code of a value]
+
+  Description [Values are written in full only the first time they are
+  met, and are referred to by their code afterwards (see
+  TraceBinary.h)]
+
+  SideEffects [codes and n_codes are updated when a new value is met]
+
+  SeeAlso     []
+
+******************************************************************************/
+static void trace_binary_dumper_write_value(TracePlugin_ptr self,
+                                            node_ptr value, hash_ptr codes,
+                                            unsigned long* n_codes)
+{
+  FILE* out = TraceOpt_output_stream(self->opt);
+  node_ptr code;
+
+  if (Nil == value) {
+    TraceBinary_write_uint(out, TRACE_BINARY_NO_VALUE);
+    return;
+  }
+
+  code = find_assoc(codes, value);
+  if (Nil != code) {
+    TraceBinary_write_uint(out, (unsigned long) NODE_TO_INT(code));
+  }
+  else {
+    char* repr = trace_binary_dumper_value_to_string(self, value);
+
+    ++ (*n_codes);
+    insert_assoc(codes, value, NODE_FROM_INT(*n_codes));
+
+    TraceBinary_write_uint(out, *n_codes);
+    TraceBinary_write_string(out, repr);
+    FREE(repr);
+  }
+}
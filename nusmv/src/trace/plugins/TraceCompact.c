@@ -209,13 +209,8 @@ int trace_compact_action(const TracePlugin_ptr plugin)
 
     fprintf(out, "Step%d\t", i);
 
-    /* lazy defines evaluation */
-    if (TraceOpt_show_defines(plugin->opt)) {
-      trace_step_evaluate_defines(trace, step);
-    }
-
     TRACE_SYMBOLS_FOREACH (trace, input_iter_type, sym_iter, sym) {
-      node_ptr val = Trace_step_get_value(trace, step, sym);
+      node_ptr val = trace_step_fetch_value(trace, step, sym);
 
       if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
       else { fprintf(out, "-"); }
@@ -224,7 +219,7 @@ int trace_compact_action(const TracePlugin_ptr plugin)
     }
     
     TRACE_SYMBOLS_FOREACH(trace, state_iter_type, sym_iter, sym) {
-      node_ptr val = Trace_step_get_value(trace, step, sym);
+      node_ptr val = trace_step_fetch_value(trace, step, sym);
       
       if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
       else { fprintf(out, "-"); }
@@ -233,7 +228,7 @@ int trace_compact_action(const TracePlugin_ptr plugin)
     }
 
     TRACE_SYMBOLS_FOREACH(trace, combo_iter_type, sym_iter, sym) {
-      node_ptr val = Trace_step_get_value(trace, step, sym);
+      node_ptr val = trace_step_fetch_value(trace, step, sym);
       
       if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
       else { fprintf(out, "-"); }
@@ -204,22 +204,22 @@ int trace_explainer_action(const TracePlugin_ptr self)
 
   i = MAX(1, TraceOpt_from_here(self->opt)); step = start_iter;
   while (stop_iter != step) {
-    TraceStepIter iter;
+    TraceSymbolsIter iter;
     node_ptr symb;
     node_ptr val;
 
     boolean input_header = false;
 
-    /* lazy defines evaluation */
-    if (TraceOpt_show_defines(self->opt)) {
-      trace_step_evaluate_defines(trace, step);
-    }
+    /* defines are evaluated lazily, only when visible */
 
     /* COMBINATORIAL SECTION (optional) */
-    TRACE_STEP_FOREACH(trace, step, combo_iter_type, iter, symb, val) {
+    TRACE_SYMBOLS_FOREACH(trace, combo_iter_type, iter, symb) {
       /* skip non-visible symbols */
       if (!trace_plugin_is_visible_symbol(self, symb)) continue;
 
+      val = trace_step_fetch_value(trace, step, symb);
+      if (Nil == val) continue;
+
       /* if required, print only symbols with changed values */
       if (TRACE_EXPLAINER(self)->changes_only) {
         if (val == find_assoc(changed_states, symb)) { continue; }
@@ -230,13 +230,20 @@ int trace_explainer_action(const TracePlugin_ptr self)
     } /* foreach SI_DEFINES */
 
     /* INPUT SECTION (optional) */
-    TRACE_STEP_FOREACH(trace, step, input_iter_type, iter, symb, val) {
+    TRACE_SYMBOLS_FOREACH(trace, input_iter_type, iter, symb) {
+      boolean visible = trace_plugin_is_visible_symbol(self, symb);
+
+      /* non-visible defines are not evaluated */
+      val = visible ? trace_step_fetch_value(trace, step, symb)
+        : trace_step_get_value(trace, step, symb);
+      if (Nil == val) continue;
+
       if (false == input_header) {
         fprintf(out, "-> Input: %d.%d <-\n", Trace_get_id(trace), i);
         input_header = true;
       }
       /* skip non-visible symbols */
-      if (!trace_plugin_is_visible_symbol(self, symb)) continue;
+      if (!visible) continue;
 
       /* if required, print only symbols with changed values */
       if (TRACE_EXPLAINER(self)->changes_only) {
@@ -253,10 +260,13 @@ int trace_explainer_action(const TracePlugin_ptr self)
 
     /* STATE SECTION (mandatory) */
     fprintf(out, "-> State: %d.%d <-\n", Trace_get_id(trace), i);
-    TRACE_STEP_FOREACH(trace, step, state_iter_type, iter, symb, val) {
+    TRACE_SYMBOLS_FOREACH(trace, state_iter_type, iter, symb) {
       /* skip non-visible symbols */
       if (!trace_plugin_is_visible_symbol(self, symb)) continue;
 
+      val = trace_step_fetch_value(trace, step, symb);
+      if (Nil == val) continue;
+
       /* if required, print only symbols with changed values */
       if (TRACE_EXPLAINER(self)->changes_only) {
         if (val == find_assoc(changed_states, symb)) { continue; }
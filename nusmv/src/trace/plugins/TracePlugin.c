@@ -61,10 +61,6 @@ static char rcsid[] UTIL_UNUSED = "$Id: TracePlugin.c,v 1.1.2.9.4.1.6.3 2010-02-
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 static void trace_plugin_finalize ARGS((Object_ptr object, void *dummy));
-static void trace_plugin_prepare_action ARGS((TracePlugin_ptr self,
-                                              Trace_ptr trace,
-                                              TraceOpt_ptr opt));
-static void trace_plugin_cleanup_action ARGS((TracePlugin_ptr self));
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -353,8 +349,20 @@ boolean trace_plugin_is_visible_symbol(TracePlugin_ptr self, node_ptr symb)
   return res;
 }
 
-static void trace_plugin_prepare_action(TracePlugin_ptr self, Trace_ptr trace,
-                                        TraceOpt_ptr opt)
+/**Function********************************************************************
+
+  Synopsis    [Sets up the plugin for an action on the given trace]
+
+  Description [Called by TracePlugin_action before the action is
+  performed. Must be paired with trace_plugin_cleanup_action]
+
+  SideEffects []
+
+  SeeAlso     [trace_plugin_cleanup_action]
+
+******************************************************************************/
+void trace_plugin_prepare_action(TracePlugin_ptr self, Trace_ptr trace,
+                                 TraceOpt_ptr opt)
 {
   /* 1. setup visibility map */
   nusmv_assert((hash_ptr)(NULL) == self->visibility_map);
@@ -375,7 +383,18 @@ static void trace_plugin_prepare_action(TracePlugin_ptr self, Trace_ptr trace,
   self->opt = opt;
 }
 
-static void trace_plugin_cleanup_action(TracePlugin_ptr self)
+/**Function********************************************************************
+
+  Synopsis    [Cleans up the plugin after an action]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [trace_plugin_prepare_action]
+
+******************************************************************************/
+void trace_plugin_cleanup_action(TracePlugin_ptr self)
 {
   /* 1. dispose visibility map */
   nusmv_assert((hash_ptr)(NULL) != self->visibility_map);
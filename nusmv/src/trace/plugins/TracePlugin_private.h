@@ -137,6 +137,12 @@ EXTERN void trace_plugin_deinit ARGS((TracePlugin_ptr self));
 
 EXTERN int trace_plugin_action ARGS((const TracePlugin_ptr self));
 
+EXTERN void trace_plugin_prepare_action ARGS((TracePlugin_ptr self,
+                                              Trace_ptr trace,
+                                              TraceOpt_ptr opt));
+
+EXTERN void trace_plugin_cleanup_action ARGS((TracePlugin_ptr self));
+
 /**AutomaticEnd***************************************************************/
 
 #endif /* __TRACE_PLUGIN_PRIVATE__H */
@@ -70,6 +70,9 @@ static int trace_table_print_row_style ARGS((const TraceTable_ptr self));
 
 static int trace_table_print_column_style ARGS((const TraceTable_ptr self));
 
+static node_ptr trace_table_get_value ARGS((const TracePlugin_ptr plugin,
+                                            TraceIter step, node_ptr sym));
+
 /*---------------------------------------------------------------------------*/
 /* Definition of external functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -263,11 +266,6 @@ trace_table_print_column_style(const TraceTable_ptr self)
   i = MAX(1, TraceOpt_from_here(plugin->opt)); step = start_iter;
   while (stop_iter != step) {
 
-    /* lazy defines evaluation */
-    if (TraceOpt_show_defines(plugin->opt)) {
-      trace_step_evaluate_defines(trace, step);
-    }
-
     /* skip COMBO and INPUT on the first step */
     if (Trace_first_iter(trace) != step) {
       fprintf(out, "C%d\t", i);
@@ -277,7 +275,7 @@ trace_table_print_column_style(const TraceTable_ptr self)
         /* skip non-visible symbols */
         if (!trace_plugin_is_visible_symbol(plugin, sym)) continue;
 
-        node_ptr val = Trace_step_get_value(trace, step, sym);
+        node_ptr val = trace_table_get_value(plugin, step, sym);
 
         if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
         else { fprintf(out, "-"); }
@@ -293,7 +291,7 @@ trace_table_print_column_style(const TraceTable_ptr self)
         /* skip non-visible symbols */
         if (!trace_plugin_is_visible_symbol(plugin, sym)) continue;
 
-        node_ptr val = Trace_step_get_value(trace, step, sym);
+        node_ptr val = trace_table_get_value(plugin, step, sym);
 
         if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
         else { fprintf(out, "-"); }
@@ -308,7 +306,7 @@ trace_table_print_column_style(const TraceTable_ptr self)
       /* skip non-visible symbols */
       if (!trace_plugin_is_visible_symbol(plugin, sym)) continue;
 
-      node_ptr val = Trace_step_get_value(trace, step, sym);
+      node_ptr val = trace_table_get_value(plugin, step, sym);
 
       if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
       else { fprintf(out, "-"); }
@@ -368,11 +366,6 @@ trace_table_print_row_style(const TraceTable_ptr self)
   i = MAX(1, TraceOpt_from_here(plugin->opt)); step = start_iter;
   while (stop_iter != step) {
 
-    /* lazy defines evaluation */
-    if (TraceOpt_show_defines(plugin->opt)) {
-      trace_step_evaluate_defines(trace, step);
-    }
-
     /* skip COMBO and INPUT on the first step */
     if (Trace_first_iter(trace) != step) {
       fprintf(out, "C%d\t", i);
@@ -394,7 +387,7 @@ trace_table_print_row_style(const TraceTable_ptr self)
 
     step = start_iter;
     while (stop_iter != step) {
-      node_ptr val = Trace_step_get_value(trace, step, sym);
+      node_ptr val = trace_table_get_value(plugin, step, sym);
     
       if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
       else { fprintf(out, "-"); }
@@ -418,7 +411,7 @@ trace_table_print_row_style(const TraceTable_ptr self)
 
     step = TraceIter_get_next(start_iter);
     while (stop_iter != step) {
-      node_ptr val = Trace_step_get_value(trace, step, sym);
+      node_ptr val = trace_table_get_value(plugin, step, sym);
     
       fprintf(out, "-\t");
       if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
@@ -442,7 +435,7 @@ trace_table_print_row_style(const TraceTable_ptr self)
 
     step = TraceIter_get_next(start_iter);
     while (stop_iter != step) {
-      node_ptr val = Trace_step_get_value(trace, step, sym);
+      node_ptr val = trace_table_get_value(plugin, step, sym);
     
       fprintf(out, "-\t-\t");
       if (Nil != val) { TracePlugin_print_symbol(plugin, val); }
@@ -460,6 +453,27 @@ trace_table_print_row_style(const TraceTable_ptr self)
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Returns the value of a symbol at the given step]
+
+  Description [If defines are shown, their values are evaluated on
+  first access]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+static node_ptr trace_table_get_value(const TracePlugin_ptr plugin,
+                                      TraceIter step, node_ptr sym)
+{
+  return TraceOpt_show_defines(plugin->opt)
+    ? trace_step_fetch_value(plugin->trace, step, sym)
+    : Trace_step_get_value(plugin->trace, step, sym);
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Trace Table finalize method.]
@@ -91,22 +91,13 @@ static void trace_xml_dumper_finalize ARGS((Object_ptr object, void* dummy));
 ******************************************************************************/
 int trace_xml_dumper_action(TracePlugin_ptr self)
 {
+  const TraceXmlDumper_ptr dumper = TRACE_XML_DUMPER(self);
   const Trace_ptr trace = self->trace;
   TraceIter start_iter;
   TraceIter stop_iter;
   TraceIter step;
-  TraceIteratorType input_iter_type;
-  TraceIteratorType state_iter_type;
-  TraceIteratorType combo_iter_type;
   int i;
 
-  NodeList_ptr loops = NodeList_create(); /* contains loops information */
-  ListIter_ptr loops_iter;
-
-  FILE* out = TraceOpt_output_stream(self->opt);
-
-  boolean first_node = true;
-
   start_iter = (0 != TraceOpt_from_here(self->opt))
     ? trace_ith_iter(trace, TraceOpt_from_here(self->opt))
     : trace_first_iter(trace);
@@ -117,121 +108,112 @@ int trace_xml_dumper_action(TracePlugin_ptr self)
     ? trace_ith_iter(trace, 1 + TraceOpt_to_here(self->opt))
     : TRACE_END_ITER;
 
-  input_iter_type = TraceOpt_show_defines(self->opt)
-    ? TRACE_ITER_I_SYMBOLS : TRACE_ITER_I_VARS;
+  trace_xml_dumper_print_header(dumper);
 
-  state_iter_type = TraceOpt_show_defines(self->opt)
-    ? TRACE_ITER_SF_SYMBOLS : TRACE_ITER_SF_VARS;
+  i = MAX(1, TraceOpt_from_here(self->opt)); step = start_iter;
+  while (stop_iter != step) {
+    if (Trace_step_is_loopback(trace, step)) {
+      NodeList_append(dumper->loops, NODE_FROM_INT(i));
+    }
 
-  combo_iter_type = TraceOpt_show_defines(self->opt)
-    ? TRACE_ITER_COMBINATORIAL : TRACE_ITER_NONE;
+    trace_xml_dumper_print_step(dumper, step, i);
 
-  fprintf(out,"%s\n", TRACE_XML_VERSION_INFO_STRING);
-  fprintf(out,"<%s type=\"%d\" desc=\"%s\" >\n",
-          TRACE_XML_CNTX_TAG_STRING, Trace_get_type(trace),
-          Trace_get_desc(trace));
+    ++ i; step = TraceIter_get_next(step);
+  } /* TRACE_FOR_EACH */
 
-  first_node = true;
-  i = MAX(1, TraceOpt_from_here(self->opt)); step = start_iter;
-  while (stop_iter != step) {
-    TraceStepIter iter;
-    node_ptr symb, val;
+  trace_xml_dumper_print_footer(dumper);
 
-    boolean combo_header = false;
-    boolean input_header = false;
+  return 0;
+}
 
-    /* lazy defines evaluation */
-    if (TraceOpt_show_defines(self->opt)) {
-      trace_step_evaluate_defines(trace, step);
-    }
 
-    if (Trace_step_is_loopback(trace, step)) {
-      NodeList_append(loops, NODE_FROM_INT(i));
-    }
+/**Function********************************************************************
 
-    TRACE_STEP_FOREACH(trace, step, combo_iter_type, iter, symb, val){
-      /* skip non-visible symbols */
-      if (!trace_plugin_is_visible_symbol(self, symb)) continue;
+  Synopsis    [Starts writing a trace one step at a time]
 
-      if (false == combo_header) {
-        fprintf(out, "\t\t<%s id=\"%d\">\n", TRACE_XML_COMB_TAG_STRING, i);
-        combo_header = true;
-      }
+  Description [Writes the header of the XML representation of the
+  given trace to the output stream of opt. The steps are then written
+  with TraceXmlDumper_stream_step as soon as they are available, and
+  the dump is completed with TraceXmlDumper_stream_end. The dumper
+  keeps no step, so the memory used does not depend on the number of
+  steps written. Options from_here and to_here of opt are ignored.
 
-      TracePlugin_print_assignment(self, symb, val);
-    } /* foreach COMBINATORIAL */
+  The dumper cannot be used for anything else until
+  TraceXmlDumper_stream_end is called.]
 
-    if (combo_header) {
-      fprintf(out, "\t\t</%s>\n", TRACE_XML_COMB_TAG_STRING);
-    }
+  SideEffects []
 
-    TRACE_STEP_FOREACH(trace, step, input_iter_type, iter, symb, val) {
-      /* skip non-visible symbols */
-      if (!trace_plugin_is_visible_symbol(self, symb)) continue;
+  SeeAlso     [TraceXmlDumper_stream_step, TraceXmlDumper_stream_end]
 
-      if (false == input_header) {
-        fprintf(out, "\t\t<%s id=\"%d\">\n", TRACE_XML_INPUT_TAG_STRING, i);
-        input_header = true;
-      }
+******************************************************************************/
+void TraceXmlDumper_stream_begin(TraceXmlDumper_ptr self,
+                                 const Trace_ptr trace,
+                                 const TraceOpt_ptr opt)
+{
+  TRACE_XML_DUMPER_CHECK_INSTANCE(self);
+  TRACE_CHECK_INSTANCE(trace);
+  TRACE_OPT_CHECK_INSTANCE(opt);
 
-      TracePlugin_print_assignment(self, symb, val);
-    } /* foreach INPUT */
+  trace_plugin_prepare_action(TRACE_PLUGIN(self), trace, opt);
+  trace_xml_dumper_print_header(self);
+}
 
-    if (input_header) {
-      fprintf(out, "\t\t</%s>\n", TRACE_XML_INPUT_TAG_STRING);
-    }
 
-    /*   [MP] this representation does not match logical trace definition*/
-    /* </node> */
-    if (!first_node) {
-      fprintf(out, "\t</%s>\n", TRACE_XML_NODE_TAG_STRING);
-    }
+/**Function********************************************************************
 
-    /*   [ATRC]: state and inputs may be dependent each other, so
-                 values chosen her might be not consistent with values chosen
-                 in comb part
-         [ATRC]: Possible solution: use last parameter of BddEnc_assign_symbols */
+  Synopsis    [Writes a step of a streamed trace]
 
-    /* <node> */
-    fprintf(out, "\t<%s>\n", TRACE_XML_NODE_TAG_STRING);  first_node = false;
-    fprintf(out, "\t\t<%s id=\"%d\">\n", TRACE_XML_STATE_TAG_STRING,i);
+  Description [Steps are numbered in the order they are written. The
+  given trace may differ from the one given to
+  TraceXmlDumper_stream_begin (e.g. it may be a short trace holding only
+  the last steps of a simulation), but it must have the same symbol
+  table and language. Loopback information is not written.]
 
-    TRACE_STEP_FOREACH(trace, step, state_iter_type, iter, symb, val) {
-      /* skip non-visible symbols */
-      if (!trace_plugin_is_visible_symbol(self, symb)) continue;
+  SideEffects []
 
-      TracePlugin_print_assignment(self, symb, val);
-    } /* foreach SF_SYMBOLS */
+  SeeAlso     [TraceXmlDumper_stream_begin]
 
-    fprintf(out, "\t\t</%s>\n", TRACE_XML_STATE_TAG_STRING);
+******************************************************************************/
+void TraceXmlDumper_stream_step(TraceXmlDumper_ptr self,
+                                const Trace_ptr trace,
+                                const TraceIter step)
+{
+  TRACE_XML_DUMPER_CHECK_INSTANCE(self);
+  nusmv_assert(TRACE(NULL) != TRACE_PLUGIN(self)->trace);
+  TRACE_CHECK_INSTANCE(trace);
+  nusmv_assert(Trace_get_symb_table(trace) ==
+               Trace_get_symb_table(TRACE_PLUGIN(self)->trace));
 
-    ++ i; step = TraceIter_get_next(step);
-  } /* TRACE_FOR_EACH */
+  TRACE_PLUGIN(self)->trace = trace;
+  trace_xml_dumper_print_step(self, step, self->n_steps + 1);
+}
 
-  /*     [MP] this representation does not match logical trace definition */
-  /* <node> */
-  fprintf(out,"\t</%s>\n", TRACE_XML_NODE_TAG_STRING);
 
-  /* dumps loop info  */
-  fprintf(out,"\t<%s> ", TRACE_XML_LOOPS_TAG_STRING);
-  loops_iter=NodeList_get_first_iter(loops) ;
-  if (!ListIter_is_end(loops_iter)) {
-    do {
-      fprintf(out, "%d ", NODE_TO_INT(NodeList_get_elem_at(loops, loops_iter)));
+/**Function********************************************************************
 
-      loops_iter = ListIter_get_next(loops_iter);
-      if (ListIter_is_end(loops_iter)) break;
+  Synopsis    [Completes the dump of a streamed trace]
 
-      fprintf(out, ",");
-    } while (true);
-  }
+  Description [Writes the trailer of the XML representation and flushes
+  the output stream]
 
-  fprintf(out,"</%s>\n", TRACE_XML_LOOPS_TAG_STRING);
-  fprintf(out,"</%s>\n", TRACE_XML_CNTX_TAG_STRING);
+  SideEffects []
 
-  NodeList_destroy(loops);
+  SeeAlso     [TraceXmlDumper_stream_begin]
 
-  return 0;
+******************************************************************************/
+void TraceXmlDumper_stream_end(TraceXmlDumper_ptr self)
+{
+  FILE* out;
+
+  TRACE_XML_DUMPER_CHECK_INSTANCE(self);
+  nusmv_assert(TRACE(NULL) != TRACE_PLUGIN(self)->trace);
+
+  out = TraceOpt_output_stream(TRACE_PLUGIN(self)->opt);
+
+  trace_xml_dumper_print_footer(self);
+  fflush(out);
+
+  trace_plugin_cleanup_action(TRACE_PLUGIN(self));
 }
 
 
@@ -291,6 +273,182 @@ void trace_xml_dumper_print_assignment(TracePlugin_ptr self,
 }
 
 
+/**Function********************************************************************
+
+  Synopsis    [Writes the header of the XML representation]
+
+  Description [Also resets the counters of the dump]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void trace_xml_dumper_print_header(TraceXmlDumper_ptr self)
+{
+  const Trace_ptr trace = TRACE_PLUGIN(self)->trace;
+  FILE* out = TraceOpt_output_stream(TRACE_PLUGIN(self)->opt);
+
+  nusmv_assert(NODE_LIST(NULL) == self->loops);
+  self->loops = NodeList_create(); /* contains loops information */
+  self->n_steps = 0;
+
+  fprintf(out,"%s\n", TRACE_XML_VERSION_INFO_STRING);
+  fprintf(out,"<%s type=\"%d\" desc=\"%s\" >\n",
+          TRACE_XML_CNTX_TAG_STRING, Trace_get_type(trace),
+          Trace_get_desc(trace));
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Writes a step of the trace with the given id]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void trace_xml_dumper_print_step(TraceXmlDumper_ptr self,
+                                 TraceIter step, int i)
+{
+  const TracePlugin_ptr plugin = TRACE_PLUGIN(self);
+  const Trace_ptr trace = plugin->trace;
+  FILE* out = TraceOpt_output_stream(plugin->opt);
+  TraceIteratorType input_iter_type;
+  TraceIteratorType state_iter_type;
+  TraceIteratorType combo_iter_type;
+  TraceSymbolsIter iter;
+  node_ptr symb, val;
+
+  boolean combo_header = false;
+  boolean input_header = false;
+
+  input_iter_type = TraceOpt_show_defines(plugin->opt)
+    ? TRACE_ITER_I_SYMBOLS : TRACE_ITER_I_VARS;
+
+  state_iter_type = TraceOpt_show_defines(plugin->opt)
+    ? TRACE_ITER_SF_SYMBOLS : TRACE_ITER_SF_VARS;
+
+  combo_iter_type = TraceOpt_show_defines(plugin->opt)
+    ? TRACE_ITER_COMBINATORIAL : TRACE_ITER_NONE;
+
+  /* defines are evaluated lazily, only when visible */
+  TRACE_SYMBOLS_FOREACH(trace, combo_iter_type, iter, symb) {
+    /* skip non-visible symbols */
+    if (!trace_plugin_is_visible_symbol(plugin, symb)) continue;
+
+    val = trace_step_fetch_value(trace, step, symb);
+    if (Nil == val) continue;
+
+    if (false == combo_header) {
+      fprintf(out, "\t\t<%s id=\"%d\">\n", TRACE_XML_COMB_TAG_STRING, i);
+      combo_header = true;
+    }
+
+    TracePlugin_print_assignment(plugin, symb, val);
+  } /* foreach COMBINATORIAL */
+
+  if (combo_header) {
+    fprintf(out, "\t\t</%s>\n", TRACE_XML_COMB_TAG_STRING);
+  }
+
+  TRACE_SYMBOLS_FOREACH(trace, input_iter_type, iter, symb) {
+    /* skip non-visible symbols */
+    if (!trace_plugin_is_visible_symbol(plugin, symb)) continue;
+
+    val = trace_step_fetch_value(trace, step, symb);
+    if (Nil == val) continue;
+
+    if (false == input_header) {
+      fprintf(out, "\t\t<%s id=\"%d\">\n", TRACE_XML_INPUT_TAG_STRING, i);
+      input_header = true;
+    }
+
+    TracePlugin_print_assignment(plugin, symb, val);
+  } /* foreach INPUT */
+
+  if (input_header) {
+    fprintf(out, "\t\t</%s>\n", TRACE_XML_INPUT_TAG_STRING);
+  }
+
+  /*   [MP] this representation does not match logical trace definition*/
+  /* </node> */
+  if (0 < self->n_steps) {
+    fprintf(out, "\t</%s>\n", TRACE_XML_NODE_TAG_STRING);
+  }
+
+  /*   [ATRC]: state and inputs may be dependent each other, so
+               values chosen her might be not consistent with values chosen
+               in comb part
+       [ATRC]: Possible solution: use last parameter of BddEnc_assign_symbols */
+
+  /* <node> */
+  fprintf(out, "\t<%s>\n", TRACE_XML_NODE_TAG_STRING);
+  fprintf(out, "\t\t<%s id=\"%d\">\n", TRACE_XML_STATE_TAG_STRING,i);
+
+  TRACE_SYMBOLS_FOREACH(trace, state_iter_type, iter, symb) {
+    /* skip non-visible symbols */
+    if (!trace_plugin_is_visible_symbol(plugin, symb)) continue;
+
+    val = trace_step_fetch_value(trace, step, symb);
+    if (Nil == val) continue;
+
+    TracePlugin_print_assignment(plugin, symb, val);
+  } /* foreach SF_SYMBOLS */
+
+  fprintf(out, "\t\t</%s>\n", TRACE_XML_STATE_TAG_STRING);
+
+  ++ self->n_steps;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Writes the trailer of the XML representation]
+
+  Description [Loop information is taken from the loops list, that is
+  disposed]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void trace_xml_dumper_print_footer(TraceXmlDumper_ptr self)
+{
+  FILE* out = TraceOpt_output_stream(TRACE_PLUGIN(self)->opt);
+  ListIter_ptr loops_iter;
+
+  /*     [MP] this representation does not match logical trace definition */
+  /* <node> */
+  fprintf(out,"\t</%s>\n", TRACE_XML_NODE_TAG_STRING);
+
+  /* dumps loop info  */
+  fprintf(out,"\t<%s> ", TRACE_XML_LOOPS_TAG_STRING);
+  loops_iter=NodeList_get_first_iter(self->loops) ;
+  if (!ListIter_is_end(loops_iter)) {
+    do {
+      fprintf(out, "%d ",
+              NODE_TO_INT(NodeList_get_elem_at(self->loops, loops_iter)));
+
+      loops_iter = ListIter_get_next(loops_iter);
+      if (ListIter_is_end(loops_iter)) break;
+
+      fprintf(out, ",");
+    } while (true);
+  }
+
+  fprintf(out,"</%s>\n", TRACE_XML_LOOPS_TAG_STRING);
+  fprintf(out,"</%s>\n", TRACE_XML_CNTX_TAG_STRING);
+
+  NodeList_destroy(self->loops);
+  self->loops = NODE_LIST(NULL);
+}
+
+
 /**Function********************************************************************
 
   Synopsis    [Class initializer]
@@ -306,6 +464,9 @@ void trace_xml_dumper_init(TraceXmlDumper_ptr self)
 {
   trace_plugin_init(TRACE_PLUGIN(self),"TRACE XML DUMP PLUGIN");
 
+  self->loops = NODE_LIST(NULL);
+  self->n_steps = 0;
+
   /* virtual methods overriding: */
   OVERRIDE(Object, finalize) = trace_xml_dumper_finalize;
   OVERRIDE(TracePlugin, action) = trace_xml_dumper_action;
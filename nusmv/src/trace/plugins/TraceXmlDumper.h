@@ -64,6 +64,16 @@ typedef struct TraceXmlDumper_TAG* TraceXmlDumper_ptr;
 
 EXTERN TraceXmlDumper_ptr TraceXmlDumper_create ARGS((void));
 
+EXTERN void TraceXmlDumper_stream_begin ARGS((TraceXmlDumper_ptr self,
+                                              const Trace_ptr trace,
+                                              const TraceOpt_ptr opt));
+
+EXTERN void TraceXmlDumper_stream_step ARGS((TraceXmlDumper_ptr self,
+                                             const Trace_ptr trace,
+                                             const TraceIter step));
+
+EXTERN void TraceXmlDumper_stream_end ARGS((TraceXmlDumper_ptr self));
+
 /**AutomaticEnd***************************************************************/
 
 #endif /* __TRACE_XML_DUMPER__H */
@@ -66,6 +66,10 @@ typedef struct TraceXmlDumper_TAG
 {
   INHERITS_FROM(TracePlugin);
 
+  /* state of the dump in progress */
+  NodeList_ptr loops; /* ids of the loopback steps */
+  int n_steps; /* number of steps written so far */
+
 } TraceXmlDumper;
 
 typedef struct XmlNodes_TAG* XmlNodes_ptr;
@@ -94,5 +98,12 @@ void trace_xml_dumper_init ARGS((TraceXmlDumper_ptr self));
 
 int trace_xml_dumper_action ARGS((TracePlugin_ptr plugin));
 
+void trace_xml_dumper_print_header ARGS((TraceXmlDumper_ptr self));
+
+void trace_xml_dumper_print_step ARGS((TraceXmlDumper_ptr self,
+                                       TraceIter step, int i));
+
+void trace_xml_dumper_print_footer ARGS((TraceXmlDumper_ptr self));
+
 #endif /* __TRACE_XML_DUMPER_PRIVATE__H */
 
@@ -59,10 +59,13 @@
 
 #include "trace/loaders/TraceLoader.h"
 #include "trace/loaders/TraceXmlLoader.h"
+#include "trace/loaders/TraceBinaryLoader.h"
+#include "trace/TraceBinary.h"
 
 #include "trace/exec/BaseTraceExecutor.h"
 #include "trace/exec/CompleteTraceExecutor.h"
 #include "trace/exec/PartialTraceExecutor.h"
+#include "trace/exec/BDDCompleteTraceExecutor.h"
 
 static char rcsid[] UTIL_UNUSED = "$Id: traceCmd.c,v 1.1.2.26.4.6.4.42 2010-03-04 16:58:56 nusmv Exp $";
 
@@ -78,6 +81,28 @@ static int UsageExecutePartialTraces ARGS((void));
 static int
 trace_cmd_parse_slice ARGS((const char* s, int* trace, int* from, int* to));
 
+static boolean
+trace_cmd_check_step ARGS((Trace_ptr trace, TraceIter step, unsigned time,
+                           void* arg));
+
+static boolean
+trace_cmd_execute_step ARGS((Trace_ptr trace, TraceIter step, unsigned time,
+                             void* arg));
+
+static boolean
+trace_cmd_is_step_complete ARGS((Trace_ptr trace, TraceIter step,
+                                 boolean is_initial));
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/* the state of a trace execution performed while reading the trace */
+typedef struct TraceCmdStreamExec_TAG {
+  BDDCompleteTraceExecutor_ptr executor;
+  int verbosity;
+} TraceCmdStreamExec;
+
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -283,9 +308,10 @@ int CommandShowTraces(int argc, char** argv)
   }
   else {
     /* A trace header will be not printed when the plugin is the XML
-       dumper or dynamically registered external plugins: */
+       or the binary dumper or dynamically registered external
+       plugins: */
 
-    boolean print_header =  (plugin_index != 4) &&
+    boolean print_header =  (plugin_index != 4) && (plugin_index != 6) &&
       (TraceManager_is_plugin_internal(global_trace_manager, plugin_index));
 
     set_indent_size(2);
@@ -581,10 +607,18 @@ static int UsageShowPlugins(void)
 
   CommandSynopsis    [Reads the trace from the specified file into the memory]
 
-  CommandArguments   [ \[-h\] | \[-i filename\] | \[-u\] \[-s\] filename]
+  CommandArguments   [ \[-h\] | \[-i filename\] | \[-u\] \[-s\]
+  \[-c | -x \[-v\]\] filename]
 
   CommandDescription [
-  Reads a trace from a specified XML file into the memory.
+  Reads a trace from a specified XML file into the memory. Traces
+  written by the binary dump plugin (see <tt>show_plugins</tt>) are
+  recognized and read as well.
+  <p>
+  With options -c and -x the trace is not stored, but read one step
+  at a time, so that memory usage does not depend on the length of the
+  trace. This is meant for very long traces, e.g. the ones written by
+  <tt>simulate -o</tt>.
   <p>
   Command Options:<p>
   <dl>
@@ -596,6 +630,14 @@ static int UsageShowPlugins(void)
        <dd> Turns 'undefined symbol' error in a warning.
     <dt> <tt>-s</tt>
        <dd> Turns 'wrong section' error in a warning.
+    <dt> <tt>-c</tt>
+       <dd> Checks the trace in the file without storing it.
+    <dt> <tt>-x</tt>
+       <dd> Executes the trace on the BDD model while it is read,
+       without storing it. The trace must be complete. Loopback
+       information is not checked.
+    <dt> <tt>-v</tt>
+       <dd> Verbosely prints execution steps (requires -x).
     <dt> <tt>filename</tt>
        <dd> Specifies the name of the xml trace file to read
     </dl>
@@ -611,9 +653,12 @@ int CommandReadTrace(int argc, char** argv)
   char* filename = NIL(char);
   boolean halt_if_undef = true;
   boolean halt_if_wrong_section = true;
+  boolean check_only = false;
+  boolean execute = false;
+  int verbosity = 0;
 
   util_getopt_reset();
-  while ((c = util_getopt(argc, argv, "husi:")) != EOF) {
+  while ((c = util_getopt(argc, argv, "huscxvi:")) != EOF) {
     switch (c) {
     case 'h':
       res = UsageReadTrace();
@@ -632,6 +677,20 @@ int CommandReadTrace(int argc, char** argv)
       halt_if_wrong_section = false;
       break;
 
+    case 'c':
+      if (execute) { res = UsageReadTrace(); goto leave; }
+      check_only = true;
+      break;
+
+    case 'x':
+      if (check_only) { res = UsageReadTrace(); goto leave; }
+      execute = true;
+      break;
+
+    case 'v':
+      verbosity ++;
+      break;
+
     default:
       UsageReadTrace();
       res = 1;
@@ -639,6 +698,8 @@ int CommandReadTrace(int argc, char** argv)
     }
   }
 
+  if (0 < verbosity && !execute) { res = UsageReadTrace(); goto leave; }
+
   /* -i did not provide a file name. the last argument must be a file name */
   if (NIL(char) == filename) {
     if (argc == util_optind) {
@@ -672,6 +733,43 @@ int CommandReadTrace(int argc, char** argv)
     res = 1; goto leave;
   }
 
+  if (TraceBinary_is_binary_file(filename)) {
+    /* load trace using TraceBinaryLoader */
+    Trace_ptr trace = TRACE(NULL);
+    TraceBinaryLoader_ptr loader;
+
+    SexpFsm_ptr sexp_fsm = \
+      PropDb_master_get_scalar_sexp_fsm(PropPkg_get_prop_database());
+
+    SEXP_FSM_CHECK_INSTANCE(sexp_fsm);
+
+    if (check_only || execute) {
+      fprintf(nusmv_stderr, "Error: options -c and -x are available "
+              "for XML traces only.\n");
+      res = 1; goto leave;
+    }
+
+    loader = TraceBinaryLoader_create(filename, halt_if_undef);
+
+    trace = TraceLoader_load_trace(TRACE_LOADER(loader),
+                                   SexpFsm_get_symb_table(sexp_fsm),
+                                   SexpFsm_get_symbols_list(sexp_fsm));
+
+    Object_destroy(OBJECT(loader), NULL); /* virtual destructor */
+
+    if (TRACE(NULL) == trace) {
+      fprintf(nusmv_stderr,
+              "Unable to load trace from binary File \"%s\".\n", filename);
+      res = 1;
+    }
+    else {
+      fprintf(nusmv_stderr, "Trace is stored at %d index \n",
+              TraceManager_register_trace(global_trace_manager, trace) + 1);
+      res = 0;
+    }
+    goto leave;
+  }
+
 #if NUSMV_HAVE_LIBEXPAT
   {
     /* load trace using TraceXMLLoader */
@@ -686,6 +784,51 @@ int CommandReadTrace(int argc, char** argv)
     TraceXmlLoader_ptr loader = \
       TraceXmlLoader_create(filename, halt_if_undef, halt_if_wrong_section);
 
+    if (check_only || execute) { /* streaming */
+      TraceCmdStreamExec info;
+      int n_states;
+
+      info.executor = BDD_COMPLETE_TRACE_EXECUTOR(
+         TraceManager_get_complete_trace_executor(global_trace_manager,
+                                                  "bdd"));
+      info.verbosity = verbosity;
+
+      if (execute &&
+          BDD_COMPLETE_TRACE_EXECUTOR(NULL) == info.executor) {
+        fprintf(nusmv_stderr, "No valid executor found. "
+                "Model must be built in order to perform trace "
+                "re-execution.\n");
+        Object_destroy(OBJECT(loader), NULL);
+        res = 1; goto leave;
+      }
+
+      n_states = TraceXmlLoader_stream_trace(loader,
+                           SexpFsm_get_symb_table(sexp_fsm),
+                           SexpFsm_get_symbols_list(sexp_fsm),
+                           execute ? trace_cmd_execute_step
+                                   : trace_cmd_check_step,
+                           &info);
+
+      Object_destroy(OBJECT(loader), NULL); /* virtual destructor */
+
+      if (n_states < 0) {
+        if (execute) fprintf(nusmv_stdout, "Trace execution failed!\n");
+        fprintf(nusmv_stderr,
+                "Unable to read trace from XML File \"%s\".\n", filename);
+        res = 1;
+      }
+      else if (execute) {
+        fprintf(nusmv_stdout,
+                "Trace execution completed successfully.\n"
+                "%d steps performed.\n", n_states - 1);
+      }
+      else {
+        fprintf(nusmv_stdout, "Trace in XML File \"%s\" has %d states.\n",
+                filename, n_states);
+      }
+      goto leave;
+    }
+
     trace = TraceLoader_load_trace(TRACE_LOADER(loader),
                                    SexpFsm_get_symb_table(sexp_fsm),
                                    SexpFsm_get_symbols_list(sexp_fsm));
@@ -730,14 +873,19 @@ int CommandReadTrace(int argc, char** argv)
 ******************************************************************************/
 static int UsageReadTrace(void)
 {
-  fprintf(nusmv_stderr, "usage: read_trace [-u] [-s] (-h | file_name | -i file_name)\n"
+  fprintf(nusmv_stderr, "usage: read_trace [-u] [-s] [-c | -x [-v]] "
+          "(-h | file_name | -i file_name)\n"
           "  -h \t Prints the command usage.\n"
           "  -u \t Output a warning instead of an error for every "
           "undefined symbol.\n"
           "  -s \t Output a warning instead of an error for every "
           "symbol placed in \n \t inappropriate trace section.\n"
+          "  -c \t Checks the trace step by step without storing it.\n"
+          "  -x \t Executes the trace step by step on the BDD model "
+          "without storing it.\n"
+          "  -v \t Verbosely prints execution steps (requires -x).\n"
           "  -i file_name  Option -i is deprecated.\n"
-          "  file-name     Trace is read from a given XML file.\n"
+          "  file-name     Trace is read from a given XML or binary file.\n"
           );
 
   return 1;
@@ -754,12 +902,13 @@ static int UsageReadTrace(void)
   CommandSynopsis    [Executes complete traces on the model FSM]
 
   CommandArguments   [\[-h\] \[-v\] \[-m | -o output-file\]
-                      -e engine \[-a | trace_number\]]
+                      -e engine \[-j jobs\] \[-a | trace_number\]]
 
   CommandDescription [Executes traces stored in the Trace Manager.  If
                       no trace is specified, last registered trace is
                       executed. Traces must be complete in order to
-                      perform execution.
+                      perform execution. The time taken by the
+                      execution of each trace is reported.
 
   <p> Command Options:<p>
   <dl>
@@ -775,6 +924,9 @@ static int UsageReadTrace(void)
        <dd> Writes the output generated by the command to <tt>output-file</tt>
     <dt> <tt>-e executor</tt>
        <dd> Selects an executor for trace re-execution.
+    <dt> <tt>-j jobs</tt>
+       <dd> Executes the traces with up to <tt>jobs</tt> worker
+       processes. The output is the same as in a sequential execution.
     <dt> <tt>trace_number</tt>
        <dd> The (ordinal) identifier number of the trace to be printed.
   </dl> ]
@@ -801,13 +953,14 @@ int CommandExecuteTraces(int argc, char** argv)
 
   /* executor params */
   int verbosity = 0;
+  int jobs = 1;
   FILE* output_stream = NIL(FILE);
 
   CompleteTraceExecutor_ptr executor = \
     TraceManager_get_default_complete_trace_executor(global_trace_manager);
 
   util_getopt_reset();
-  while ((c = util_getopt(argc, argv, "hvamo:e:")) != EOF) {
+  while ((c = util_getopt(argc, argv, "hvamo:e:j:")) != EOF) {
     switch (c) {
     case 'h':
       res = UsageExecuteTraces();
@@ -848,6 +1001,14 @@ int CommandExecuteTraces(int argc, char** argv)
       }
       break;
 
+    case 'j':
+      if ((util_str2int(util_optarg, &jobs) != 0) || (jobs < 1)) {
+        fprintf(nusmv_stderr, "Error: \"%s\" is not a valid number of jobs "
+                "(must be a positive integer).\n", util_optarg);
+        res = UsageExecuteTraces(); goto leave;
+      }
+      break;
+
     default:
         res = UsageExecuteTraces();
         goto leave;
@@ -914,18 +1075,19 @@ int CommandExecuteTraces(int argc, char** argv)
     if (all) { first_trace = 1; last_trace = traceno; }
     else { first_trace = trace;  last_trace = trace; }
 
-    /* execute traces */
-    for (trace_iter = first_trace; trace_iter <= last_trace; ++trace_iter) {
-      Trace_ptr trace;
-      int trace_index = trace_iter - 1;
+    { /* execute traces */
+      int count = last_trace - first_trace + 1;
+      Trace_ptr* traces = ALLOC(Trace_ptr, count);
 
-      trace = TraceManager_get_trace_at_index(global_trace_manager,
-                                              trace_index);
+      for (trace_iter = first_trace; trace_iter <= last_trace; ++trace_iter) {
+        traces[trace_iter - first_trace] = \
+          TraceManager_get_trace_at_index(global_trace_manager,
+                                          trace_iter - 1);
+      }
 
       /* run using executor */
-      if (Trace_execute_trace(trace, executor)) {
-        res = 1; goto leave;
-      }
+      res = Trace_execute_traces(traces, count, executor, jobs);
+      FREE(traces);
     }
   }
   else { /*  no valid executor found */
@@ -976,7 +1138,7 @@ static int UsageExecuteTraces ()
 {
   fprintf(nusmv_stderr,
           "usage: execute_traces [-h] [-v] [-m | -o file] " \
-          "[-e engine] [-a | trace_number]\n");
+          "[-e engine] [-j jobs] [-a | trace_number]\n");
 
   fprintf(nusmv_stderr, "  -h \t\tPrints the command usage.\n");
   fprintf(nusmv_stderr,
@@ -1023,6 +1185,9 @@ static int UsageExecuteTraces ()
   }
 
 
+  fprintf(nusmv_stderr,
+          "  -j jobs\tExecutes the traces with up to \"jobs\" worker "
+          "processes.\n");
   fprintf(nusmv_stderr,
           "  trace_number\tThe number of the trace to be executed.\n");
 
@@ -1406,3 +1571,105 @@ trace_cmd_parse_slice(const char* s, int* trace, int* from, int* to)
 } /* trace_cmd_parse_slice */
 
 
+/**Function********************************************************************
+
+  Synopsis           [Step visitor of read_trace -c]
+
+  Description        [Steps are checked by the loader while they are
+  read, nothing else is required]
+
+  SideEffects        []
+
+  SeeAlso            [TraceXmlLoader_stream_trace]
+
+******************************************************************************/
+static boolean trace_cmd_check_step(Trace_ptr trace, TraceIter step,
+                                    unsigned time, void* arg)
+{
+  return true;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Step visitor of read_trace -x]
+
+  Description        [Executes the given step on the BDD model]
+
+  SideEffects        []
+
+  SeeAlso            [TraceXmlLoader_stream_trace,
+  BDDCompleteTraceExecutor_execute_step]
+
+******************************************************************************/
+static boolean trace_cmd_execute_step(Trace_ptr trace, TraceIter step,
+                                      unsigned time, void* arg)
+{
+  TraceCmdStreamExec* info = (TraceCmdStreamExec*) arg;
+  boolean is_initial = (1 == time);
+
+  if (!trace_cmd_is_step_complete(trace, step, is_initial)) {
+    fprintf(nusmv_stderr, "Error: step %d of the trace is not complete.\n",
+            time);
+    return false;
+  }
+
+  if (is_initial) {
+    if (!BDDCompleteTraceExecutor_execute_step(info->executor, trace, step,
+                                               true)) {
+      fprintf(nusmv_stderr, "Error: starting state is not initial state.\n");
+      return false;
+    }
+    return true;
+  }
+
+  if (0 < info->verbosity) {
+    fprintf(nusmv_stdout, "-- executing step %d ... ", time - 1);
+    fflush(nusmv_stdout);
+  }
+
+  if (BDDCompleteTraceExecutor_execute_step(info->executor, trace, step,
+                                            false)) {
+    if (0 < info->verbosity) fprintf(nusmv_stdout, "done\n");
+    return true;
+  }
+
+  if (0 < info->verbosity) fprintf(nusmv_stdout, "failed!\n");
+  return false;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Checks that all the state and input variables of
+  a step are assigned]
+
+  Description        [Inputs are not checked in the initial step]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static boolean
+trace_cmd_is_step_complete(Trace_ptr trace, TraceIter step, boolean is_initial)
+{
+  NodeList_ptr vars;
+  ListIter_ptr iter;
+
+  vars = Trace_get_sf_vars(trace);
+  NODE_LIST_FOREACH(vars, iter) {
+    node_ptr var = NodeList_get_elem_at(vars, iter);
+    if (Nil == Trace_step_get_value(trace, step, var)) return false;
+  }
+
+  if (is_initial) return true;
+
+  vars = Trace_get_i_vars(trace);
+  NODE_LIST_FOREACH(vars, iter) {
+    node_ptr var = NodeList_get_elem_at(vars, iter);
+    if (Nil == Trace_step_get_value(trace, step, var)) return false;
+  }
+
+  return true;
+}
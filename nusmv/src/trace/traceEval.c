@@ -79,6 +79,11 @@ static char rcsid[] UTIL_UNUSED = "$Id: $";
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+/* recorded in place of the value of a define which could not be
+   evaluated, so that evaluation is not attempted again */
+#define TRACE_EVAL_FAILURE \
+  failure_make("define could not be evaluated", FAILURE_UNSPECIFIED, -1)
+
 
 /**AutomaticStart*************************************************************/
 
@@ -89,8 +94,12 @@ static char rcsid[] UTIL_UNUSED = "$Id: $";
 static node_ptr
 trace_make_failure ARGS((const char* tmpl, node_ptr symbol));
 
-static hash_ptr
-trace_eval_make_environment ARGS((Trace_ptr trace, TraceIter step));
+static void
+trace_eval_set_context ARGS((Trace_ptr trace, BaseEvaluator_ptr evaluator,
+                             TraceIter step));
+
+static Expr_ptr
+trace_eval_lookup ARGS((void* arg, node_ptr symb));
 
 /**AutomaticEnd***************************************************************/
 
@@ -119,10 +128,9 @@ boolean trace_step_check_defines(const Trace_ptr trace, const TraceIter step,
         evaluation. Then, in two distinct phases state and
         transitional defines are evaluated. 'State' belong to current
         step, 'transitional' belong to next */
-    hash_ptr env = trace_eval_make_environment(trace, step);
     const SymbTable_ptr st = Trace_get_symb_table(trace);
 
-    BaseEvaluator_set_context(evaluator, st, env);
+    trace_eval_set_context(trace, evaluator, step);
 
     /* 1. state defines */
     TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_S_DEFINES, sym_iter, sym) {
@@ -222,9 +230,6 @@ boolean trace_step_check_defines(const Trace_ptr trace, const TraceIter step,
         }
       }
     }
-
-    /* destroy the environment */
-    free_assoc(env);
   }
 
   return res;
@@ -235,83 +240,115 @@ boolean trace_step_check_defines(const Trace_ptr trace, const TraceIter step,
 
   Synopsis    [Evaluates defines for a trace]
 
-  Description [Evaluates define for a trace, based on assignments to
-               state, frozen and input variables.
+  Description [Evaluates the state defines of the given step and the
+               transitional defines of the next one (if any), based
+               on assignments to state, frozen and input variables.
+               Defines which already have a value are left untouched.
 
-               If a previous value exists for a define, The mismatch
-               is reported to the caller by appending a failure node
-               describing the error to the "failures" list. If
-               "failures" is NULL failures are silently discarded.  If
-               no previous value exists for a given define, assigns
-               the define to the calculated value according to vars
-               assignments. The "failures" list must be either NULL
-               or a valid, empty list.
+               Since trace_step_fetch_value evaluates defines on
+               demand, this is needed only when all the defines of a
+               step are going to be read anyway.]
 
-               0 is returned if no mismatching were detected, 1
-               otherwise ]
+  SideEffects [The trace is filled with defines]
 
-  SideEffects [The trace is filled with defines, failures list is
-               populated as necessary.]
-
-  SeeAlso     []
+  SeeAlso     [trace_step_fetch_value]
 
 ******************************************************************************/
 void trace_step_evaluate_defines(Trace_ptr trace, const TraceIter step)
 {
   TraceSymbolsIter sym_iter;
   node_ptr sym;
-  node_ptr val;
 
-  const BaseEvaluator_ptr evaluator = \
-    TraceManager_get_evaluator(TracePkg_get_global_trace_manager());
-
-  BASE_EVALUATOR_CHECK_INSTANCE(evaluator);
   nusmv_assert(TRACE_END_ITER != step);
 
-  {  /* To evaluate a set of expressions, we first set context for
-        evaluation. Then, in two distinct phases state and
-        transitional defines are evaluated. 'State' belong to current
-        step, 'transitional' belong to next */
-    hash_ptr env = trace_eval_make_environment(trace, step);
-    const SymbTable_ptr st = Trace_get_symb_table(trace);
+  /* 1 . state defines */
+  TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_S_DEFINES, sym_iter, sym) {
+    (void) trace_step_fetch_value(trace, step, sym);
+  }
 
-    BaseEvaluator_set_context(evaluator, st, env);
+  { /* 2. transitional defines (exist only if there's next state) */
+    TraceIter next = trace_iter_get_next(step);
+    if (TRACE_END_ITER != next) {
+      TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_TRANSITIONAL, sym_iter, sym) {
+        (void) trace_step_fetch_value(trace, next, sym);
+      }
+    }
+  }
+} /* trace_step_evaluate_defines */
 
-    /* 1 . state defines */
-    TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_S_DEFINES, sym_iter, sym) {
-      if (Nil == trace_step_get_value(trace, step, sym)) {
 
-        val = BaseEvaluator_evaluate(evaluator,
-                                     SymbTable_get_define_flatten_body(st, sym));
+/**Function********************************************************************
 
-        if (FAILURE != node_get_type(val)) {
-          trace_step_put_value(trace, step, sym, val);
-        }
-      }
-    } /* foreach state define */
+  Synopsis    [Returns the value of a symbol at the given step,
+               evaluating it if it is a define]
 
-    { /* 2. transitional defines (exist only if there's next state) */
-      TraceIter next = trace_iter_get_next(step);
-      if (TRACE_END_ITER != next) {
-        TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_TRANSITIONAL, sym_iter, sym) {
-          if (Nil == trace_step_get_value(trace, next, sym)) {
+  Description [Like trace_step_get_value, but the value of a define
+               which has not been assigned yet is evaluated on first
+               access, based on assignments to state, frozen and input
+               variables, and is cached into the trace. A state define
+               is evaluated in the given step, a transitional define
+               on the transition leading to the given step (thus it
+               has no value in the first step).
 
-            val = BaseEvaluator_evaluate(evaluator,
-                                         SymbTable_get_define_flatten_body(st,
-                                                                           sym));
-            if (FAILURE != node_get_type(val)) {
-              trace_step_put_value(trace, next, sym, val);
-            }
-          }
-        }
-      }
-    } /* foreach transitional define */
+               Evaluation takes place in the compiled mode of the
+               evaluator, which reads the values of the variables
+               straight from the trace. The context of evaluation is
+               kept as long as defines of the same step are fetched,
+               so that subexpressions shared among the defines are
+               evaluated once.
+
+               Nil is returned if the symbol has no value, or if it is
+               a define whose evaluation failed (evaluation is not
+               attempted again in that case).]
+
+  SideEffects [The value of the define is cached into the trace]
+
+  SeeAlso     [trace_step_get_value]
 
-    /* destroy the environment */
-    free_assoc(env);
+******************************************************************************/
+node_ptr trace_step_fetch_value(Trace_ptr trace, const TraceIter step,
+                                const node_ptr symb)
+{
+  TraceSection section;
+  unsigned offset;
+  node_ptr res;
+
+  /* vars, and symbols not in language (which raise an error) */
+  if (!trace_symbol_fwd_lookup(trace, symb, &section, &offset) ||
+      section < TRACE_SECTION_STATE_DEFINE) {
+    return trace_step_get_value(trace, step, symb);
   }
 
-} /* trace_step_evaluate_defines */
+  nusmv_assert(TRACE_END_ITER != step);
+
+  res = trace_step_get_define_value(trace, step, section, offset);
+  if (Nil == res) {
+    const BaseEvaluator_ptr evaluator = \
+      TraceManager_get_evaluator(TracePkg_get_global_trace_manager());
+    const SymbTable_ptr st = Trace_get_symb_table(trace);
+    TraceIter env_step = step;
+
+    BASE_EVALUATOR_CHECK_INSTANCE(evaluator);
+
+    /* transitional defines take their value on the transition
+       leading to step */
+    if (TRACE_SECTION_STATE_DEFINE != section) {
+      env_step = trace_iter_get_prev(step);
+      if (TRACE_END_ITER == env_step) return Nil;
+    }
+
+    trace_eval_set_context(trace, evaluator, env_step);
+    res = BaseEvaluator_evaluate(evaluator,
+                                 SymbTable_get_define_flatten_body(st, symb));
+
+    if (Nil == res || FAILURE == node_get_type(res)) {
+      res = TRACE_EVAL_FAILURE;
+    }
+    trace_step_cache_define_value(trace, step, section, offset, res);
+  }
+
+  return (FAILURE != node_get_type(res)) ? res : Nil;
+} /* trace_step_fetch_value */
 
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
@@ -350,48 +387,78 @@ trace_make_failure(const char* tmpl, node_ptr symbol)
 
 /**Function********************************************************************
 
-  Synopsis [Private service of trace_step_evaluate_defines and
+  Synopsis [Private service of trace_step_fetch_value and
   trace_step_check_defines]
 
-  Description [This function builds a local environment for constant
-  expressions evaluation]
+  Description [Sets the evaluator in compiled mode upon the given step
+  of trace, unless it already is: in that case values memoized by the
+  evaluator are retained. The trace drops its evaluation step whenever
+  the values of its variables change (see trace_set_eval_step)]
 
   SideEffects [none]
 
-  SeeAlso     []
+  SeeAlso     [trace_eval_lookup]
 
 ******************************************************************************/
-static hash_ptr trace_eval_make_environment(Trace_ptr trace, TraceIter step)
+static void trace_eval_set_context(Trace_ptr trace,
+                                   BaseEvaluator_ptr evaluator,
+                                   TraceIter step)
 {
-  hash_ptr res = new_assoc(); /* empty env */
-  TraceIter next_step = TraceIter_get_next(step); /* the next step */
-  TraceSymbolsIter sym_iter;
-  node_ptr sym;
+  nusmv_assert(TRACE_END_ITER != step);
 
-  /* 1. frozen vars always have the same value for x and x' */
-  TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_F_VARS, sym_iter, sym) {
-    insert_assoc(res, sym,
-                 trace_step_get_value(trace, TRACE_END_ITER, sym));
-    insert_assoc(res, find_node(NEXT, sym, Nil),
-                 trace_step_get_value(trace, TRACE_END_ITER, sym));
+  if (step != trace_get_eval_step(trace) ||
+      !BaseEvaluator_has_compiled_context(evaluator, trace_eval_lookup,
+                                          trace)) {
+    BaseEvaluator_set_compiled_context(evaluator, Trace_get_symb_table(trace),
+                                       trace_eval_lookup, trace);
+    trace_set_eval_step(trace, step);
   }
+}
 
-  /* 2. state vars for x and x' (if any) */
-  TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_S_VARS, sym_iter, sym) {
-    insert_assoc(res, sym, trace_step_get_value(trace, step, sym));
-    if (TRACE_END_ITER != next_step) {
-      insert_assoc(res, find_node(NEXT, sym, Nil),
-                   trace_step_get_value(trace, next_step, sym));
-    }
-  }
 
-  /* 3. input vars for i (value is in next step) */
-  TRACE_SYMBOLS_FOREACH(trace, TRACE_ITER_I_VARS, sym_iter, sym) {
-    if (TRACE_END_ITER != next_step) {
-      insert_assoc(res, sym,
-                   trace_step_get_value(trace, next_step, sym));
-    }
+/**Function********************************************************************
+
+  Synopsis [Lookup function of the compiled mode of the evaluator]
+
+  Description [Binds the given identifier to its value in the
+  evaluation step of the trace given as argument. Values of next state
+  vars are taken from the next step, as well as values of input vars,
+  frozen vars have the same value for x and x'. Nil is returned if no
+  value is available]
+
+  SideEffects [none]
+
+  SeeAlso     [trace_eval_set_context]
+
+******************************************************************************/
+static Expr_ptr trace_eval_lookup(void* arg, node_ptr symb)
+{
+  const Trace_ptr trace = TRACE(arg);
+  TraceIter step = trace_get_eval_step(trace);
+  boolean in_next = (NEXT == node_get_type(symb));
+  node_ptr var = in_next ? car(symb) : symb;
+  TraceSection section;
+  unsigned offset;
+
+  nusmv_assert(TRACE_END_ITER != step);
+
+  if (!trace_symbol_fwd_lookup(trace, var, &section, &offset)) return Nil;
+
+  switch (section) {
+  case TRACE_SECTION_FROZEN_VAR:
+    return trace_step_get_value(trace, TRACE_END_ITER, var);
+
+  case TRACE_SECTION_STATE_VAR:
+    if (in_next) step = trace_iter_get_next(step);
+    break;
+
+  case TRACE_SECTION_INPUT_VAR: /* value is in next step */
+    if (in_next) return Nil;
+    step = trace_iter_get_next(step);
+    break;
+
+  default: return Nil; /* flattened define bodies refer to vars only */
   }
 
-  return res;
+  return (TRACE_END_ITER != step) ? trace_step_get_value(trace, step, var) : Nil;
 }
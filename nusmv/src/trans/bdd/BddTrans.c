@@ -252,13 +252,13 @@ BddTrans_ptr BddTrans_create(DdManager* dd_manager,
 
   case TRANS_TYPE_MONOLITHIC:
     trans->forward_trans  = ClusterList_apply_monolithic(clusters_bdd); 
-    trans->backward_trans = ClusterList_copy(trans->forward_trans); 
+    trans->backward_trans = CLUSTER_LIST(NULL); /* copied below */
     break;
 
   case TRANS_TYPE_THRESHOLD:
     trans->forward_trans = ClusterList_apply_threshold(clusters_bdd, 
                                                        cl_options);
-    trans->backward_trans = ClusterList_copy(trans->forward_trans);
+    trans->backward_trans = CLUSTER_LIST(NULL); /* copied below */
     break;
 
   case TRANS_TYPE_IWLS95:
@@ -284,6 +284,13 @@ BddTrans_ptr BddTrans_create(DdManager* dd_manager,
 
   ClusterList_build_schedule(trans->forward_trans, 
                              state_vars_cube, input_vars_cube); 
+
+  /* the backward list is copied only after the forward schedule has
+     been built, so that the copied clusters share the supports
+     memoized while building it */
+  if (trans->backward_trans == CLUSTER_LIST(NULL)) {
+    trans->backward_trans = ClusterList_copy(trans->forward_trans);
+  }
   
   ClusterList_build_schedule(trans->backward_trans, 
                              next_state_vars_cube, input_vars_cube); 
@@ -89,6 +89,12 @@ typedef struct Cluster_TAG
      multiplied in the product (only state vars) */ 
   bdd_ptr ex_state; /* was Ei_State */
 
+  /* The support of curr_cluster, computed on demand. It may be a
+     superset of the actual support when the cluster was obtained by
+     conjoining clusters whose supports were known (see
+     Cluster_set_support) */
+  bdd_ptr support;
+
 /* ---------------------------------------------------------------------- */ 
 /*     Virtual Methods                                                    */
 /* ---------------------------------------------------------------------- */   
@@ -235,6 +241,92 @@ void Cluster_set_trans(Cluster_ptr self, DdManager* dd, bdd_ptr current)
   if (current != (bdd_ptr) NULL) {
     self->curr_cluster = bdd_dup(current);
   }
+
+  /* the memoized support refers to the previous relation */
+  if (self->support != (bdd_ptr) NULL) {
+    bdd_free(dd, self->support);
+    self->support = (bdd_ptr) NULL;
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Returns the support of the transition relation inside
+  the cluster]
+
+  Description        [The support is computed the first time it is
+  required, and then memoized in the cluster until the relation
+  changes. Copies of the cluster share the memoized support. Returned
+  bdd is referenced.]
+
+  SideEffects        [The support is memoized in self]
+
+  SeeAlso            [Cluster_set_support]
+
+******************************************************************************/
+bdd_ptr Cluster_get_support(Cluster_ptr self, DdManager* dd)
+{
+  CLUSTER_CHECK_INSTANCE(self);
+
+  if ((self->support == (bdd_ptr) NULL) &&
+      (self->curr_cluster != (bdd_ptr) NULL)) {
+    self->support = bdd_support(dd, self->curr_cluster);
+  }
+
+  return (self->support != (bdd_ptr) NULL) ? bdd_dup(self->support)
+                                           : (bdd_ptr) NULL;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Tells whether the support of the cluster is already
+  known]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            [Cluster_get_support]
+
+******************************************************************************/
+boolean Cluster_has_support(const Cluster_ptr self)
+{
+  CLUSTER_CHECK_INSTANCE(self);
+  return (self->support != (bdd_ptr) NULL);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Sets the support of the transition relation inside
+  the cluster]
+
+  Description        [The given cube must contain the support of the
+  relation, and it is allowed to be larger: this is the case of a
+  cluster built by conjoining clusters, where the union of their
+  supports is used in place of the support of the conjunction. A
+  larger support only postpones the quantification of some variables
+  in the image computation. Given value will be referenced. To be
+  called after Cluster_set_trans.]
+
+  SideEffects        []
+
+  SeeAlso            [Cluster_get_support]
+
+******************************************************************************/
+void Cluster_set_support(Cluster_ptr self, DdManager* dd, bdd_ptr support)
+{
+  CLUSTER_CHECK_INSTANCE(self);
+
+  if (self->support != (bdd_ptr) NULL) {
+    bdd_free(dd, self->support);
+    self->support = (bdd_ptr) NULL;
+  }
+  if (support != (bdd_ptr) NULL) {
+    self->support = bdd_dup(support);
+  }
 }
 
 /**Function********************************************************************
@@ -421,6 +513,7 @@ static void cluster_init(Cluster_ptr self, DdManager* dd)
   self->curr_cluster    = bdd_true(dd);
   self->ex_state_input  = bdd_true(dd);
   self->ex_state        = bdd_true(dd);
+  self->support         = (bdd_ptr) NULL;
 
   OVERRIDE(Object, finalize) = cluster_finalize;
   OVERRIDE(Object, copy) = cluster_copy; 
@@ -446,6 +539,7 @@ static void cluster_deinit(Cluster_ptr self, DdManager* dd)
   if (self->curr_cluster != (bdd_ptr) NULL) bdd_free(dd, self->curr_cluster);
   if (self->ex_state_input != (bdd_ptr) NULL) bdd_free(dd, self->ex_state_input);
   if (self->ex_state != (bdd_ptr) NULL) bdd_free(dd, self->ex_state);
+  if (self->support != (bdd_ptr) NULL) bdd_free(dd, self->support);
 }
 
 
@@ -514,6 +608,8 @@ static void cluster_copy_aux(const Cluster_ptr self, Cluster_ptr copy)
   copy->curr_cluster = bdd_dup(self->curr_cluster);  
   copy->ex_state_input = bdd_dup(self->ex_state_input); 
   copy->ex_state = bdd_dup(self->ex_state);
+  copy->support = (self->support != (bdd_ptr) NULL) ?
+    bdd_dup(self->support) : (bdd_ptr) NULL;
 }
 
 /**Function********************************************************************
@@ -81,6 +81,14 @@ EXTERN bdd_ptr Cluster_get_trans ARGS((const Cluster_ptr self));
 EXTERN void 
 Cluster_set_trans ARGS((Cluster_ptr self, DdManager* dd, bdd_ptr current));
 
+EXTERN bdd_ptr 
+Cluster_get_support ARGS((Cluster_ptr self, DdManager* dd));
+
+EXTERN boolean Cluster_has_support ARGS((const Cluster_ptr self));
+
+EXTERN void 
+Cluster_set_support ARGS((Cluster_ptr self, DdManager* dd, bdd_ptr support));
+
 EXTERN bdd_ptr 
 Cluster_get_quantification_state_input ARGS((const Cluster_ptr self));
 
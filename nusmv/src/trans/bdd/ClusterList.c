@@ -43,6 +43,7 @@
 #include "utils/error.h"
 
 #include "utils/heap.h"
+#include "utils/Profile.h"
 #include <float.h>
 
 
@@ -829,6 +830,8 @@ ClusterList_apply_iwls95_partition(const ClusterList_ptr self,
   CLUSTER_LIST_CHECK_INSTANCE(self);
   CLUSTER_OPTIONS_CHECK_INSTANCE(cl_options);
 
+  Profile_begin("iwls95_partition");
+
   if (ClusterOptions_is_iwls95_preorder(cl_options)) {
 
     /* (pre)Ordering , clustering, reordering */
@@ -878,6 +881,8 @@ ClusterList_apply_iwls95_partition(const ClusterList_ptr self,
   }
 
   ClusterList_destroy(with_threshold);
+
+  Profile_end("iwls95_partition");
   return result;
 }
 
@@ -1522,7 +1527,7 @@ clusterlist_build_schedule_recur(ClusterList_ptr self,
   }
   else {
     Cluster_ptr C;
-    bdd_ptr si, s, T, supp;
+    bdd_ptr si, s, supp;
     bdd_ptr tacc_s, tacc_si;
 
     clusterlist_build_schedule_recur(self, ClusterListIterator_next(iter),
@@ -1538,15 +1543,14 @@ clusterlist_build_schedule_recur(ClusterList_ptr self,
     Cluster_set_quantification_state_input(C, self->dd, si);
     Cluster_set_quantification_state(C, self->dd, s);
 
-    /* computing the variables to send to upper levels */
-    T = Cluster_get_trans(C);
-    supp = bdd_support(self->dd, T);
+    /* computing the variables to send to upper levels. The support
+       is memoized within the cluster, and shared among its copies */
+    supp = Cluster_get_support(C, self->dd);
 
     *acc_s = bdd_and(self->dd, tacc_s , supp);
     *acc_si = bdd_and(self->dd, tacc_si, supp);
 
     bdd_free(self->dd, supp);
-    bdd_free(self->dd, T);
     bdd_free(self->dd, si);
     bdd_free(self->dd, s);
     bdd_free(self->dd, tacc_s);
@@ -1631,7 +1635,7 @@ cluster_list_apply_threshold(const ClusterList_ptr self, const int threshold,
                              const boolean append)
 {
   ClusterListIterator_ptr iter;
-  bdd_ptr bdd_cluster;
+  bdd_ptr bdd_cluster, cluster_support;
   ClusterList_ptr result;
   boolean is_first_cluster, is_last_cluster;
 
@@ -1642,6 +1646,11 @@ cluster_list_apply_threshold(const ClusterList_ptr self, const int threshold,
   result = ClusterList_create(self->dd);
   bdd_cluster = bdd_true(self->dd);
 
+  /* when the supports of all the accumulated clusters are known,
+     their union is taken as the support of the resulting cluster,
+     instead of computing it again later on */
+  cluster_support = bdd_true(self->dd);
+
   is_first_cluster = true;
 
   iter = ClusterList_begin(self);
@@ -1657,6 +1666,19 @@ cluster_list_apply_threshold(const ClusterList_ptr self, const int threshold,
 
     if (can_accumulate) {
       bdd_and_accumulate(self->dd, &bdd_cluster, bdd_relation);
+
+      if (cluster_support != (bdd_ptr) NULL) {
+        if (Cluster_has_support(cluster)) {
+          bdd_ptr supp = Cluster_get_support(cluster, self->dd);
+          bdd_and_accumulate(self->dd, &cluster_support, supp);
+          bdd_free(self->dd, supp);
+        }
+        else {
+          bdd_free(self->dd, cluster_support);
+          cluster_support = (bdd_ptr) NULL;
+        }
+      }
+
       is_first_cluster = false;
       iter = ClusterListIterator_next(iter);
       is_last_cluster = ClusterListIterator_is_end(iter);
@@ -1664,6 +1686,7 @@ cluster_list_apply_threshold(const ClusterList_ptr self, const int threshold,
     else {
       Cluster_ptr new_cluster = Cluster_create(self->dd);
       Cluster_set_trans(new_cluster, self->dd, bdd_cluster);
+      Cluster_set_support(new_cluster, self->dd, cluster_support);
 
       /* result becomes the owner of new_cluster, so we do not destroy it */
       if (append) ClusterList_append_cluster(result, new_cluster);
@@ -1671,12 +1694,15 @@ cluster_list_apply_threshold(const ClusterList_ptr self, const int threshold,
 
       bdd_free(self->dd, bdd_cluster);
       bdd_cluster = bdd_true(self->dd);
+      if (cluster_support != (bdd_ptr) NULL) bdd_free(self->dd, cluster_support);
+      cluster_support = bdd_true(self->dd);
       is_first_cluster = true;
     }
     if (is_last_cluster) {
       /* collect the clusters set */
       Cluster_ptr new_cluster = Cluster_create(self->dd);
       Cluster_set_trans(new_cluster, self->dd, bdd_cluster);
+      Cluster_set_support(new_cluster, self->dd, cluster_support);
 
       /* result becomes the owner of new_cluster, so we do not destroy it */
       if (append) ClusterList_append_cluster(result, new_cluster);
@@ -1685,6 +1711,7 @@ cluster_list_apply_threshold(const ClusterList_ptr self, const int threshold,
     bdd_free(self->dd, bdd_relation);
   }
   bdd_free(self->dd, bdd_cluster);
+  if (cluster_support != (bdd_ptr) NULL) bdd_free(self->dd, cluster_support);
   return result;
 }
 
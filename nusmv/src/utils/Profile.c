@@ -0,0 +1,634 @@
+/**CFile***********************************************************************
+
+  FileName    [Profile.c]
+
+  PackageName [utils]
+
+  Synopsis    [Per-phase profiling of the main algorithms]
+
+  Description [Phases are opened and closed with Profile_begin and
+  Profile_end, and can be nested. A phase opened while another one is
+  open is accounted under the path of the enclosing phase, while a
+  phase opened again while it is already the innermost one (e.g. a
+  recursive function) is merged into the open one.
+
+  Errors handled with longjmp may leave phases open: when a phase is
+  closed, all the phases opened after it and still open are closed as
+  well.
+
+  Along with the CPU time (measured with a TimerBench), each phase
+  collects the values of the registered probes.]
+
+  SeeAlso     [Profile.h TimerBench.h]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``utils'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#include "utils/Profile.h"
+#include "utils/TimerBench.h"
+#include "utils/error.h"
+#include "st.h"
+
+static char rcsid[] UTIL_UNUSED = "$Id: Profile.c,v 1.1.2.1 2011-03-02 10:12:31 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* maximum number of probes that can be registered */
+#define PROFILE_MAX_PROBES 8
+
+/* maximum nesting of phases. Deeper phases are ignored */
+#define PROFILE_MAX_DEPTH 64
+
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct ProfileProbe_TAG {
+  char* name; /* NULL if the slot is free */
+  ProfileProbeKind kind;
+  ProfileProbeFun fun;
+  ProfileProbeFun fun2;
+  ProfileProbeSetFun set;
+  void* arg;
+} ProfileProbe;
+
+typedef struct ProfileEntry_TAG {
+  char* path;
+  const char* name; /* the last component of path */
+  int depth;
+  TimerBench_ptr timer;
+
+  double values[PROFILE_MAX_PROBES];
+  double values2[PROFILE_MAX_PROBES]; /* denominators of ratio probes */
+  boolean sampled[PROFILE_MAX_PROBES];
+
+  struct ProfileEntry_TAG* next;
+} ProfileEntry;
+
+typedef struct ProfileFrame_TAG {
+  ProfileEntry* entry;
+  int recursion;
+
+  double start[PROFILE_MAX_PROBES];
+  double start2[PROFILE_MAX_PROBES];
+} ProfileFrame;
+
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+static ProfileProbe profile_probes[PROFILE_MAX_PROBES];
+
+static ProfileFrame profile_stack[PROFILE_MAX_DEPTH];
+static int profile_depth = 0;
+static int profile_overflow = 0;
+
+/* path -> entry. Entries are also kept in a list, in creation order */
+static st_table* profile_entries = (st_table*) NULL;
+static ProfileEntry* profile_first = (ProfileEntry*) NULL;
+static ProfileEntry* profile_last = (ProfileEntry*) NULL;
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static ProfileEntry* profile_get_entry ARGS((const char* phase));
+static void profile_close_frame ARGS((void));
+static void profile_free_entries ARGS((void));
+static void profile_print_json_string ARGS((FILE* file, const char* str));
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [Initializes the profiler]
+
+  Description        [Called by Utils_pkg_init]
+
+  SideEffects        []
+
+  SeeAlso            [Profile_quit]
+
+******************************************************************************/
+void Profile_init()
+{
+  if (profile_entries == (st_table*) NULL) {
+    profile_entries = st_init_table(strcmp, st_strhash);
+    nusmv_assert(profile_entries != (st_table*) NULL);
+  }
+  profile_depth = 0;
+  profile_overflow = 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Deinitializes the profiler]
+
+  Description        [All collected data and registered probes are
+  freed]
+
+  SideEffects        []
+
+  SeeAlso            [Profile_init]
+
+******************************************************************************/
+void Profile_quit()
+{
+  int i;
+
+  profile_free_entries();
+  if (profile_entries != (st_table*) NULL) {
+    st_free_table(profile_entries);
+    profile_entries = (st_table*) NULL;
+  }
+
+  for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+    if (profile_probes[i].name != (char*) NULL) {
+      FREE(profile_probes[i].name);
+      profile_probes[i].name = (char*) NULL;
+    }
+    profile_probes[i].fun = (ProfileProbeFun) NULL;
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Opens a phase]
+
+  Description        [The phase is nested into the currently open one,
+  if any. If the innermost open phase has the same name, it is not
+  opened again (recursive phases are merged). Each call must be matched
+  by a call to Profile_end with the same phase name.]
+
+  SideEffects        [Probes of kind PROFILE_PROBE_PEAK are reset]
+
+  SeeAlso            [Profile_end]
+
+******************************************************************************/
+void Profile_begin(const char* phase)
+{
+  ProfileFrame* frame;
+  int i;
+
+  if (profile_entries == (st_table*) NULL) return;
+
+  if (profile_depth > 0 &&
+      strcmp(profile_stack[profile_depth-1].entry->name, phase) == 0) {
+    profile_stack[profile_depth-1].recursion += 1;
+    return;
+  }
+
+  if (profile_overflow > 0 || profile_depth == PROFILE_MAX_DEPTH) {
+    profile_overflow += 1;
+    return;
+  }
+
+  frame = &(profile_stack[profile_depth]);
+  frame->entry = profile_get_entry(phase);
+  frame->recursion = 0;
+  profile_depth += 1;
+
+  for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+    ProfileProbe* probe = &(profile_probes[i]);
+    if (probe->fun == (ProfileProbeFun) NULL) continue;
+
+    frame->start[i] = probe->fun(probe->arg);
+    if (probe->kind == PROFILE_PROBE_RATIO) {
+      frame->start2[i] = probe->fun2(probe->arg);
+    }
+    else if (probe->kind == PROFILE_PROBE_PEAK &&
+             probe->set != (ProfileProbeSetFun) NULL) {
+      probe->set(probe->arg, 0.0);
+    }
+  }
+
+  TimerBench_start(frame->entry->timer);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Closes a phase]
+
+  Description        [The phase must have been opened with
+  Profile_begin. Phases opened after the given one and which are still
+  open (e.g. because of a longjmp) are closed as well. If the phase is
+  not open, nothing happens.]
+
+  SideEffects        []
+
+  SeeAlso            [Profile_begin]
+
+******************************************************************************/
+void Profile_end(const char* phase)
+{
+  int i;
+
+  if (profile_entries == (st_table*) NULL) return;
+
+  if (profile_overflow > 0) {
+    profile_overflow -= 1;
+    return;
+  }
+
+  for (i = profile_depth - 1; i >= 0; --i) {
+    if (strcmp(profile_stack[i].entry->name, phase) == 0) break;
+  }
+  if (i < 0) return; /* not open */
+
+  if (i == profile_depth - 1 && profile_stack[i].recursion > 0) {
+    profile_stack[i].recursion -= 1;
+    return;
+  }
+
+  while (profile_depth > i) profile_close_frame();
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Registers a probe]
+
+  Description        [fun is called with arg when a phase is opened and
+  closed. fun2 is used only by probes of kind PROFILE_PROBE_RATIO,
+  and set only by probes of kind PROFILE_PROBE_PEAK (it can be NULL,
+  in which case the peak is not local to the phase). If a probe with
+  the same name was registered before, it is replaced.]
+
+  SideEffects        []
+
+  SeeAlso            [Profile_unregister_probe]
+
+******************************************************************************/
+void Profile_register_probe(const char* name, ProfileProbeKind kind,
+                            ProfileProbeFun fun, ProfileProbeFun fun2,
+                            ProfileProbeSetFun set, void* arg)
+{
+  int i, slot = -1;
+
+  nusmv_assert(fun != (ProfileProbeFun) NULL);
+  nusmv_assert(kind != PROFILE_PROBE_RATIO || fun2 != (ProfileProbeFun) NULL);
+
+  /* slots of unregistered probes are reused for probes with the same
+     name, so that collected values stay meaningful */
+  for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+    if (profile_probes[i].name == (char*) NULL) {
+      if (slot == -1) slot = i;
+    }
+    else if (strcmp(profile_probes[i].name, name) == 0) {
+      slot = i;
+      break;
+    }
+  }
+  nusmv_assert(slot != -1);
+
+  if (profile_probes[slot].name == (char*) NULL) {
+    profile_probes[slot].name = util_strsav((char*) name);
+  }
+  profile_probes[slot].kind = kind;
+  profile_probes[slot].fun = fun;
+  profile_probes[slot].fun2 = fun2;
+  profile_probes[slot].set = set;
+  profile_probes[slot].arg = arg;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Unregisters a probe]
+
+  Description        [The probe is no longer sampled, but values already
+  collected are kept]
+
+  SideEffects        []
+
+  SeeAlso            [Profile_register_probe]
+
+******************************************************************************/
+void Profile_unregister_probe(const char* name)
+{
+  int i;
+
+  for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+    if (profile_probes[i].name != (char*) NULL &&
+        strcmp(profile_probes[i].name, name) == 0) {
+      profile_probes[i].fun = (ProfileProbeFun) NULL;
+      profile_probes[i].fun2 = (ProfileProbeFun) NULL;
+      profile_probes[i].set = (ProfileProbeSetFun) NULL;
+      profile_probes[i].arg = NULL;
+    }
+  }
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Forgets all the collected data]
+
+  Description        [Phases still open are forgotten as well]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+void Profile_reset()
+{
+  if (profile_entries == (st_table*) NULL) return;
+
+  profile_free_entries();
+  profile_depth = 0;
+  profile_overflow = 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Prints the collected data]
+
+  Description        [Phases are printed in the order they have been
+  opened the first time. Times are in seconds. Probe values not
+  available for a phase are printed as "-" (table format) or omitted
+  (JSON format)]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+void Profile_print(FILE* file, ProfileFormat format)
+{
+  ProfileEntry* entry;
+  int i;
+
+  if (format == PROFILE_FORMAT_JSON) {
+    fprintf(file, "{\n  \"phases\": [");
+
+    for (entry = profile_first; entry != (ProfileEntry*) NULL;
+         entry = entry->next) {
+      fprintf(file, "%s\n    {\"path\": ",
+              (entry == profile_first) ? "" : ",");
+      profile_print_json_string(file, entry->path);
+      fprintf(file, ", \"name\": ");
+      profile_print_json_string(file, entry->name);
+      fprintf(file, ", \"depth\": %d, \"laps\": %ld, \"time\": %.3f",
+              entry->depth, TimerBench_get_laps(entry->timer),
+              TimerBench_get_time(entry->timer) / 1000.0);
+
+      for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+        if (profile_probes[i].name == (char*) NULL ||
+            !entry->sampled[i]) continue;
+
+        fprintf(file, ", ");
+        profile_print_json_string(file, profile_probes[i].name);
+        if (profile_probes[i].kind == PROFILE_PROBE_RATIO) {
+          if (entry->values2[i] > 0) {
+            fprintf(file, ": %.2f", 100.0 * entry->values[i] / entry->values2[i]);
+          }
+          else fprintf(file, ": null");
+        }
+        else fprintf(file, ": %.0f", entry->values[i]);
+      }
+      fprintf(file, "}");
+    }
+
+    fprintf(file, "\n  ]\n}\n");
+    return;
+  }
+
+  /* table */
+  fprintf(file, "%-40s %8s %10s", "Phase", "Laps", "Time (s)");
+  for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+    if (profile_probes[i].name == (char*) NULL) continue;
+    fprintf(file, " %16s", profile_probes[i].name);
+  }
+  fprintf(file, "\n");
+
+  for (entry = profile_first; entry != (ProfileEntry*) NULL;
+       entry = entry->next) {
+    fprintf(file, "%*s%-*s %8ld %10.2f", 2*entry->depth, "",
+            40 - 2*entry->depth, entry->name,
+            TimerBench_get_laps(entry->timer),
+            TimerBench_get_time(entry->timer) / 1000.0);
+
+    for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+      if (profile_probes[i].name == (char*) NULL) continue;
+
+      if (!entry->sampled[i] ||
+          (profile_probes[i].kind == PROFILE_PROBE_RATIO &&
+           entry->values2[i] <= 0)) {
+        fprintf(file, " %16s", "-");
+      }
+      else if (profile_probes[i].kind == PROFILE_PROBE_RATIO) {
+        fprintf(file, " %15.2f%%",
+                100.0 * entry->values[i] / entry->values2[i]);
+      }
+      else fprintf(file, " %16.0f", entry->values[i]);
+    }
+    fprintf(file, "\n");
+  }
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis           [Returns the entry of the given phase, nested into
+  the currently open phase]
+
+  Description        [The entry is created if needed]
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static ProfileEntry* profile_get_entry(const char* phase)
+{
+  ProfileEntry* entry;
+  char* path;
+
+  if (profile_depth > 0) {
+    const char* parent = profile_stack[profile_depth-1].entry->path;
+    path = ALLOC(char, strlen(parent) + strlen(phase) + 2);
+    nusmv_assert(path != (char*) NULL);
+    sprintf(path, "%s/%s", parent, phase);
+  }
+  else path = util_strsav((char*) phase);
+
+  if (st_lookup(profile_entries, path, (char**) &entry)) {
+    FREE(path);
+    return entry;
+  }
+
+  entry = ALLOC(ProfileEntry, 1);
+  nusmv_assert(entry != (ProfileEntry*) NULL);
+  memset(entry, 0, sizeof(ProfileEntry));
+
+  entry->path = path;
+  entry->name = path + strlen(path) - strlen(phase);
+  entry->depth = profile_depth;
+  entry->timer = TimerBench_create(path);
+  entry->next = (ProfileEntry*) NULL;
+
+  st_insert(profile_entries, entry->path, (char*) entry);
+  if (profile_last != (ProfileEntry*) NULL) profile_last->next = entry;
+  else profile_first = entry;
+  profile_last = entry;
+
+  return entry;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Closes the innermost open phase]
+
+  Description        [Probes are sampled and their values accumulated]
+
+  SideEffects        [Probes of kind PROFILE_PROBE_PEAK are restored]
+
+  SeeAlso            []
+
+******************************************************************************/
+static void profile_close_frame()
+{
+  ProfileFrame* frame;
+  ProfileEntry* entry;
+  int i;
+
+  nusmv_assert(profile_depth > 0);
+  frame = &(profile_stack[profile_depth-1]);
+  entry = frame->entry;
+
+  TimerBench_stop(entry->timer);
+
+  for (i = 0; i < PROFILE_MAX_PROBES; ++i) {
+    ProfileProbe* probe = &(profile_probes[i]);
+    double value;
+
+    if (probe->fun == (ProfileProbeFun) NULL) continue;
+
+    value = probe->fun(probe->arg);
+    switch (probe->kind) {
+    case PROFILE_PROBE_DELTA:
+      entry->values[i] += value - frame->start[i];
+      break;
+
+    case PROFILE_PROBE_PEAK:
+      if (value > entry->values[i]) entry->values[i] = value;
+      /* the enclosing phase must see the peak reached so far */
+      if (probe->set != (ProfileProbeSetFun) NULL) {
+        probe->set(probe->arg, (value > frame->start[i]) ?
+                   value : frame->start[i]);
+      }
+      break;
+
+    case PROFILE_PROBE_RATIO:
+      entry->values[i] += value - frame->start[i];
+      entry->values2[i] += probe->fun2(probe->arg) - frame->start2[i];
+      break;
+
+    default:
+      error_unreachable_code();
+    }
+
+    entry->sampled[i] = true;
+  }
+
+  profile_depth -= 1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Frees all the entries]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void profile_free_entries()
+{
+  ProfileEntry* entry = profile_first;
+
+  while (entry != (ProfileEntry*) NULL) {
+    ProfileEntry* next = entry->next;
+
+    st_delete(profile_entries, (char**) &(entry->path), NULL);
+    TimerBench_destroy(entry->timer);
+    FREE(entry->path);
+    FREE(entry);
+    entry = next;
+  }
+
+  profile_first = (ProfileEntry*) NULL;
+  profile_last = (ProfileEntry*) NULL;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis           [Prints the given string as a JSON string]
+
+  Description        []
+
+  SideEffects        []
+
+  SeeAlso            []
+
+******************************************************************************/
+static void profile_print_json_string(FILE* file, const char* str)
+{
+  fputc('"', file);
+  for (; *str != '\0'; ++str) {
+    if (*str == '"' || *str == '\\') fputc('\\', file);
+    fputc(*str, file);
+  }
+  fputc('"', file);
+}
@@ -0,0 +1,98 @@
+/**CHeaderFile*****************************************************************
+
+  FileName    [Profile.h]
+
+  PackageName [utils]
+
+  Synopsis    [Per-phase profiling of the main algorithms]
+
+  Description [Phases are named and nestable. For each phase (identified
+  by its path in the nesting, e.g. "build_model/flatten_hierarchy")
+  the number of laps and the CPU time are collected, along with the
+  values of a set of registered probes, e.g. BDD node counts or cache
+  statistics provided by the dd package.]
+
+  SeeAlso     [Profile.c TimerBench.h]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``utils'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include "utils/utils.h"
+
+/**Enum************************************************************************
+
+  Synopsis    [The kinds of probes]
+
+  Description [PROFILE_PROBE_DELTA accumulates the variation of the
+  probe value within the phase. PROFILE_PROBE_PEAK keeps the maximum
+  value the probe has within the phase: the set function (if given) is
+  used to reset and restore the probe around the phase.
+  PROFILE_PROBE_RATIO shows the ratio (as a percentage) between the
+  variations of the probe value and of the value returned by the
+  second function, e.g. cache hits over cache lookups.]
+
+******************************************************************************/
+typedef enum ProfileProbeKind_TAG {
+  PROFILE_PROBE_DELTA,
+  PROFILE_PROBE_PEAK,
+  PROFILE_PROBE_RATIO
+} ProfileProbeKind;
+
+typedef double (*ProfileProbeFun)(void* arg);
+typedef void (*ProfileProbeSetFun)(void* arg, double value);
+
+/**Enum************************************************************************
+
+  Synopsis    [The output formats of Profile_print]
+
+******************************************************************************/
+typedef enum ProfileFormat_TAG {
+  PROFILE_FORMAT_TABLE,
+  PROFILE_FORMAT_JSON
+} ProfileFormat;
+
+
+EXTERN void Profile_init ARGS((void));
+EXTERN void Profile_quit ARGS((void));
+
+EXTERN void Profile_begin ARGS((const char* phase));
+EXTERN void Profile_end ARGS((const char* phase));
+
+EXTERN void
+Profile_register_probe ARGS((const char* name, ProfileProbeKind kind,
+                             ProfileProbeFun fun, ProfileProbeFun fun2,
+                             ProfileProbeSetFun set, void* arg));
+EXTERN void Profile_unregister_probe ARGS((const char* name));
+
+EXTERN void Profile_reset ARGS((void));
+EXTERN void Profile_print ARGS((FILE* file, ProfileFormat format));
+
+#endif /* __PROFILE_H__ */
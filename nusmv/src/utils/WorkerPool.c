@@ -0,0 +1,635 @@
+/**CFile***********************************************************************
+
+  FileName    [WorkerPool.c]
+
+  PackageName [utils]
+
+  Synopsis    [Implementation of the WorkerPool class]
+
+  Description [Workers are forked when the pool is created, and
+  inherit the whole state of the parent. A worker runs the body
+  function given to the pool, then terminates with _exit, so that no
+  atexit handler or stdio buffer of the parent is run. Pending output
+  is flushed before forking, as it would be written by every worker
+  otherwise.
+
+  The parent waits for answers with WorkerPool_wait_any, and reads
+  them with WorkerPool_receive. A worker which terminates, or whose
+  pipes fail, is released and is no longer waited for. Workers still
+  running when the pool is destroyed are killed.
+
+  While a pool with job pipes exists SIGPIPE is ignored, so that a
+  worker terminating while it is given a job cannot kill the parent.
+
+  The module also provides the helpers workers use to send their
+  answers: reading and writing pipes regardless of interruptions, and
+  capturing what is printed into anonymous temporary files.
+
+  When fork is not available, pools have no running worker.]
+
+  SeeAlso     [WorkerPool.h]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``utils'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "utils/WorkerPool.h"
+#include "utils/error.h"
+
+#if NUSMV_HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
+#if NUSMV_HAVE_UNISTD_H && !defined(__MINGW32__)
+# define WORKER_POOL_HAVE_FORK 1
+# include <errno.h>
+# include <signal.h>
+# include <sys/types.h>
+# include <sys/wait.h>
+# include <sys/select.h>
+#else
+# define WORKER_POOL_HAVE_FORK 0
+#endif
+
+static char rcsid[] UTIL_UNUSED = "$Id: WorkerPool.c,v 1.1.2.1 2011-03-21 10:00:00 nusmv Exp $";
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**Struct**********************************************************************
+
+  Synopsis    [Implementation of the WorkerPool class]
+
+  Description [For every worker, pids holds the process (-1 if fork
+  failed), answers the pipe the worker writes on and jobs the pipe it
+  reads from (-1 if absent). A worker is running until its answers
+  pipe is closed.]
+
+******************************************************************************/
+typedef struct WorkerPool_TAG {
+  int size;
+  boolean with_jobs;
+  int* pids;
+  int* jobs;
+  int* answers;
+} WorkerPool;
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+#if WORKER_POOL_HAVE_FORK
+/* the number of existing pools with job pipes, and the SIGPIPE
+   handler they replaced */
+static int worker_pool_job_pools = 0;
+static void (*worker_pool_pipe_handler) ARGS((int));
+#endif
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+#if WORKER_POOL_HAVE_FORK
+static void worker_pool_fork ARGS((WorkerPool_ptr self, int worker,
+                                   WorkerPoolBody body, void* arg));
+#endif
+
+/**AutomaticEnd***************************************************************/
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**Function********************************************************************
+
+  Synopsis    [Creates a pool of size workers]
+
+  Description [Worker w runs body(w, jobs, answers, arg), where jobs
+  is the pipe the worker reads its jobs from (-1 if with_jobs is
+  false) and answers the pipe the worker writes on. The value
+  returned by body is the exit status of the worker.
+
+  Workers whose fork fails are not running from the beginning, and
+  the pool may have no running worker at all.]
+
+  SideEffects [Pending output is flushed]
+
+  SeeAlso     [WorkerPool_destroy]
+
+******************************************************************************/
+WorkerPool_ptr WorkerPool_create(int size, boolean with_jobs,
+                                 WorkerPoolBody body, void* arg)
+{
+  WorkerPool_ptr self = ALLOC(WorkerPool, 1);
+  int w;
+
+  WORKER_POOL_CHECK_INSTANCE(self);
+  nusmv_assert(size >= 0);
+
+  self->size = size;
+  self->with_jobs = with_jobs;
+  self->pids = ALLOC(int, size + 1);
+  self->jobs = ALLOC(int, size + 1);
+  self->answers = ALLOC(int, size + 1);
+
+  for (w = 0; w < size; ++w) {
+    self->pids[w] = -1;
+    self->jobs[w] = -1;
+    self->answers[w] = -1;
+  }
+
+#if WORKER_POOL_HAVE_FORK
+  if (with_jobs && 0 == worker_pool_job_pools++) {
+    worker_pool_pipe_handler = signal(SIGPIPE, SIG_IGN);
+  }
+
+  /* pending output would be written by every worker otherwise */
+  fflush(NULL);
+
+  for (w = 0; w < size; ++w) worker_pool_fork(self, w, body, arg);
+#endif
+
+  return self;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Destroys the pool]
+
+  Description [Workers which are still alive are killed]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_create]
+
+******************************************************************************/
+void WorkerPool_destroy(WorkerPool_ptr self)
+{
+  int w;
+
+  WORKER_POOL_CHECK_INSTANCE(self);
+
+  for (w = 0; w < self->size; ++w) {
+    WorkerPool_release(self, w);
+
+#if WORKER_POOL_HAVE_FORK
+    if (self->pids[w] > 0) {
+      kill(self->pids[w], SIGKILL);
+      waitpid(self->pids[w], (int*) NULL, 0);
+    }
+#endif
+  }
+
+#if WORKER_POOL_HAVE_FORK
+  if (self->with_jobs && 0 == --worker_pool_job_pools) {
+    signal(SIGPIPE, worker_pool_pipe_handler);
+  }
+#endif
+
+  FREE(self->answers);
+  FREE(self->jobs);
+  FREE(self->pids);
+  FREE(self);
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the number of workers of the pool]
+
+  Description [Workers which are not running are counted as well]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int WorkerPool_get_size(const WorkerPool_ptr self)
+{
+  WORKER_POOL_CHECK_INSTANCE(self);
+  return self->size;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns true if the given worker can still answer]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_release]
+
+******************************************************************************/
+boolean WorkerPool_is_running(const WorkerPool_ptr self, int worker)
+{
+  WORKER_POOL_CHECK_INSTANCE(self);
+  nusmv_assert(0 <= worker && worker < self->size);
+
+  return self->answers[worker] >= 0;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Waits for a worker of the pool to answer]
+
+  Description [See WorkerPool_wait_any_of. Returns the worker, or -1.]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_wait_any_of]
+
+******************************************************************************/
+int WorkerPool_wait_any(WorkerPool_ptr self, long timeout)
+{
+  int worker;
+
+  WORKER_POOL_CHECK_INSTANCE(self);
+
+  if (WorkerPool_wait_any_of(&self, 1, timeout, &worker) < 0) return -1;
+  return worker;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Waits for a worker of any of the given pools to answer]
+
+  Description [Waits at most timeout milliseconds (forever if timeout
+  is negative) until a running worker can be read from, or has
+  terminated. NULL entries of pools are ignored. Returns the index of
+  the pool, and writes the worker in *worker. Returns -1 if no worker
+  is running, on timeout or on failure.]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_receive]
+
+******************************************************************************/
+int WorkerPool_wait_any_of(WorkerPool_ptr* pools, int size, long timeout,
+                           int* worker)
+{
+#if WORKER_POOL_HAVE_FORK
+  struct timeval limit;
+  struct timeval* limit_ptr = (struct timeval*) NULL;
+
+  if (timeout >= 0) {
+    limit.tv_sec = timeout / 1000;
+    limit.tv_usec = (timeout % 1000) * 1000;
+    limit_ptr = &limit;
+  }
+
+  while (true) {
+    fd_set readable;
+    int max_fd = -1;
+    int ready, i, w;
+
+    FD_ZERO(&readable);
+    for (i = 0; i < size; ++i) {
+      if (WORKER_POOL(NULL) == pools[i]) continue;
+
+      for (w = 0; w < pools[i]->size; ++w) {
+        int fd = pools[i]->answers[w];
+
+        if (fd >= 0) {
+          FD_SET(fd, &readable);
+          if (fd > max_fd) max_fd = fd;
+        }
+      }
+    }
+
+    if (max_fd < 0) return -1;
+
+    /* on interruption the remaining time is left in limit */
+    ready = select(max_fd + 1, &readable, NULL, NULL, limit_ptr);
+    if (ready < 0 && errno == EINTR) continue;
+    if (ready <= 0) return -1;
+
+    for (i = 0; i < size; ++i) {
+      if (WORKER_POOL(NULL) == pools[i]) continue;
+
+      for (w = 0; w < pools[i]->size; ++w) {
+        int fd = pools[i]->answers[w];
+
+        if (fd >= 0 && FD_ISSET(fd, &readable)) {
+          *worker = w;
+          return i;
+        }
+      }
+    }
+
+    return -1;
+  }
+#else
+  return -1;
+#endif
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Gives a job to a worker]
+
+  Description [Writes exactly bytes bytes on the jobs pipe of the
+  worker. Returns false on failure, in which case the worker is
+  released.]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_receive]
+
+******************************************************************************/
+boolean WorkerPool_send(WorkerPool_ptr self, int worker,
+                        const void* buf, size_t bytes)
+{
+  WORKER_POOL_CHECK_INSTANCE(self);
+  nusmv_assert(0 <= worker && worker < self->size);
+
+  if (self->jobs[worker] >= 0 &&
+      WorkerPool_write_exactly(self->jobs[worker], buf, bytes)) {
+    return true;
+  }
+
+  WorkerPool_release(self, worker);
+  return false;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reads an answer of a worker]
+
+  Description [Reads exactly bytes bytes from the answers pipe of the
+  worker. Returns false on failure or premature end of file, in which
+  case the worker is released.]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_wait_any]
+
+******************************************************************************/
+boolean WorkerPool_receive(WorkerPool_ptr self, int worker,
+                           void* buf, size_t bytes)
+{
+  WORKER_POOL_CHECK_INSTANCE(self);
+  nusmv_assert(0 <= worker && worker < self->size);
+
+  if (self->answers[worker] >= 0 &&
+      WorkerPool_read_exactly(self->answers[worker], buf, bytes)) {
+    return true;
+  }
+
+  WorkerPool_release(self, worker);
+  return false;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Stops communicating with a worker]
+
+  Description [The pipes of the worker are closed, so a worker waiting
+  for jobs terminates. The worker is no longer running.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+void WorkerPool_release(WorkerPool_ptr self, int worker)
+{
+  WORKER_POOL_CHECK_INSTANCE(self);
+  nusmv_assert(0 <= worker && worker < self->size);
+
+#if WORKER_POOL_HAVE_FORK
+  if (self->jobs[worker] >= 0) close(self->jobs[worker]);
+  if (self->answers[worker] >= 0) close(self->answers[worker]);
+#endif
+
+  self->jobs[worker] = -1;
+  self->answers[worker] = -1;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Writes exactly bytes bytes]
+
+  Description [Returns false on failure]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_read_exactly]
+
+******************************************************************************/
+boolean WorkerPool_write_exactly(int fd, const void* buf, size_t bytes)
+{
+#if WORKER_POOL_HAVE_FORK
+  const char* p = (const char*) buf;
+
+  while (bytes > 0) {
+    ssize_t done = write(fd, p, bytes);
+    if (done < 0 && errno == EINTR) continue;
+    if (done <= 0) return false;
+    p += done;
+    bytes -= done;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Reads exactly bytes bytes]
+
+  Description [Returns false on failure or premature end of file]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_write_exactly]
+
+******************************************************************************/
+boolean WorkerPool_read_exactly(int fd, void* buf, size_t bytes)
+{
+#if WORKER_POOL_HAVE_FORK
+  char* p = (char*) buf;
+
+  while (bytes > 0) {
+    ssize_t done = read(fd, p, bytes);
+    if (done < 0 && errno == EINTR) continue;
+    if (done <= 0) return false;
+    p += done;
+    bytes -= done;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Opens an anonymous temporary file]
+
+  Description [The file is removed as soon as it is opened, so it
+  disappears when the process terminates. Returns NULL on failure.]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_read_capture]
+
+******************************************************************************/
+FILE* WorkerPool_open_capture()
+{
+  char* name = Utils_get_temp_filename_in_dir((const char*) NULL,
+                                              "NuSMVXXXXXX");
+  FILE* res;
+
+  if ((char*) NULL == name) return NIL(FILE);
+
+  res = fopen(name, "w+");
+  remove(name);
+  FREE(name);
+
+  return res;
+}
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the content of the given temporary file, which
+  is then emptied]
+
+  Description [The size of the content is written in *size. Returned
+  buffer must be freed by the caller.]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_open_capture]
+
+******************************************************************************/
+char* WorkerPool_read_capture(FILE* file, long* size)
+{
+  char* res;
+
+  fflush(file);
+  *size = ftell(file);
+  if (*size < 0) *size = 0;
+
+  res = ALLOC(char, *size + 1);
+  rewind(file);
+  *size = (long) fread(res, 1, *size, file);
+
+  rewind(file);
+#if NUSMV_HAVE_UNISTD_H
+  if (ftruncate(fileno(file), 0) != 0) *size = 0;
+#endif
+
+  return res;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+#if WORKER_POOL_HAVE_FORK
+
+/**Function********************************************************************
+
+  Synopsis    [Forks the given worker with its pipes]
+
+  Description [The worker is left not running on failure. The worker
+  process never returns from this function.]
+
+  SideEffects []
+
+  SeeAlso     [WorkerPool_create]
+
+******************************************************************************/
+static void worker_pool_fork(WorkerPool_ptr self, int worker,
+                             WorkerPoolBody body, void* arg)
+{
+  int to_worker[2] = { -1, -1 };
+  int from_worker[2];
+  pid_t pid;
+
+  if (pipe(from_worker) != 0) return;
+  if (self->with_jobs && pipe(to_worker) != 0) {
+    close(from_worker[0]);
+    close(from_worker[1]);
+    return;
+  }
+
+  pid = fork();
+  if (pid == 0) {
+    int w;
+
+    /* pipes of the other workers would keep them alive */
+    for (w = 0; w < worker; ++w) {
+      if (self->jobs[w] >= 0) close(self->jobs[w]);
+      if (self->answers[w] >= 0) close(self->answers[w]);
+    }
+    close(from_worker[0]);
+    if (self->with_jobs) close(to_worker[1]);
+
+    /* no atexit handler or stdio buffer of the parent must be run */
+    _exit(body(worker, to_worker[0], from_worker[1], arg));
+  }
+
+  close(from_worker[1]);
+  if (self->with_jobs) close(to_worker[0]);
+
+  if (pid < 0) {
+    close(from_worker[0]);
+    if (self->with_jobs) close(to_worker[1]);
+    return;
+  }
+
+  self->pids[worker] = (int) pid;
+  self->answers[worker] = from_worker[0];
+  self->jobs[worker] = to_worker[1];
+}
+
+#endif /* WORKER_POOL_HAVE_FORK */
@@ -0,0 +1,96 @@
+/**CHeaderFile*****************************************************************
+
+  FileName    [WorkerPool.h]
+
+  PackageName [utils]
+
+  Synopsis    [Public interface of the WorkerPool class]
+
+  Description [A WorkerPool is a set of child processes (the workers)
+  forked to run a given function. Every worker sends its answers
+  through a pipe, and can optionally be given jobs through a second
+  pipe. See WorkerPool.c for the description.]
+
+  SeeAlso     [WorkerPool.c]
+
+  Author      [NuSMV team]
+
+  Copyright   [
+  This file is part of the ``utils'' package of NuSMV version 2.
+  Copyright (C) 2011 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>. ]
+
+******************************************************************************/
+
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+#include "utils/utils.h"
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+typedef struct WorkerPool_TAG* WorkerPool_ptr;
+
+#define WORKER_POOL(x) \
+         ((WorkerPool_ptr) x)
+
+#define WORKER_POOL_CHECK_INSTANCE(x) \
+         ( nusmv_assert(WORKER_POOL(x) != WORKER_POOL(NULL)) )
+
+/* The body of a worker: jobs is -1 if the pool has no job pipes. The
+   returned value is the exit status of the worker process */
+typedef int (*WorkerPoolBody) ARGS((int worker, int jobs, int answers,
+                                    void* arg));
+
+/* ---------------------------------------------------------------------- */
+/* Public interface                                                       */
+/* ---------------------------------------------------------------------- */
+
+EXTERN WorkerPool_ptr
+WorkerPool_create ARGS((int size, boolean with_jobs,
+                        WorkerPoolBody body, void* arg));
+EXTERN void WorkerPool_destroy ARGS((WorkerPool_ptr self));
+
+EXTERN int WorkerPool_get_size ARGS((const WorkerPool_ptr self));
+EXTERN boolean WorkerPool_is_running ARGS((const WorkerPool_ptr self,
+                                           int worker));
+
+EXTERN int WorkerPool_wait_any ARGS((WorkerPool_ptr self, long timeout));
+EXTERN int WorkerPool_wait_any_of ARGS((WorkerPool_ptr* pools, int size,
+                                        long timeout, int* worker));
+
+EXTERN boolean WorkerPool_send ARGS((WorkerPool_ptr self, int worker,
+                                     const void* buf, size_t bytes));
+EXTERN boolean WorkerPool_receive ARGS((WorkerPool_ptr self, int worker,
+                                        void* buf, size_t bytes));
+EXTERN void WorkerPool_release ARGS((WorkerPool_ptr self, int worker));
+
+EXTERN boolean WorkerPool_write_exactly ARGS((int fd, const void* buf,
+                                              size_t bytes));
+EXTERN boolean WorkerPool_read_exactly ARGS((int fd, void* buf,
+                                             size_t bytes));
+
+EXTERN FILE* WorkerPool_open_capture ARGS((void));
+EXTERN char* WorkerPool_read_capture ARGS((FILE* file, long* size));
+
+#endif /* __WORKER_POOL_H__ */
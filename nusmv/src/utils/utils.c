@@ -62,6 +62,7 @@
 #endif
 
 #include "utils/TimerBench.h"
+#include "utils/Profile.h"
 
 #if NUSMV_HAVE_UNISTD_H
 #include <unistd.h>
@@ -127,6 +128,7 @@ static void hash_timers_insert ARGS((const char* key, TimerBench_ptr val));
 void Utils_pkg_init()
 {
   hash_timers_init();
+  Profile_init();
 }
 
 
@@ -144,6 +146,7 @@ void Utils_pkg_init()
 void Utils_pkg_quit()
 {
   hash_timers_quit_fun(TimerBench_destroy);
+  Profile_quit();
 }
 
 